@@ -121,7 +121,7 @@ Use `cex -D config` to reset all project config flags to defaults
 #define cex$version_major 0
 #define cex$version_minor 18
 #define cex$version_patch 0
-#define cex$version_date "2025-12-03"
+#define cex$version_date "2026-10-19"
 
 
 
@@ -420,7 +420,7 @@ extern const struct _CEX_Error_struct
 #    define __cex__fprintf(stream, prefix, filename, line, func, format, ...)                      \
         cexsp__fprintf(                                                                            \
             stream,                                                                                \
-            "%s ( %s:%d %s() ) " format,                                                           \
+            fmt$("%s ( %s:%d %s() ) " format),                                                     \
             prefix,                                                                                \
             filename,                                                                              \
             line,                                                                                  \
@@ -834,6 +834,28 @@ int __cex_test_uassert_enabled = 1;
 #    define cex$is_freestanding 1
 #endif
 
+#if !cex$is_freestanding && !defined(__EMSCRIPTEN__) &&                                            \
+    (defined(_WIN32) || !(defined(__GLIBC__) && __GLIBC__ == 2 && __GLIBC_MINOR__ < 34))
+// NOTE: glibc < 2.34 requires -lpthread, so bootstrap `cc cex.c` stays single threaded there
+/// Defined if CEX uses native threads (parallel os.fs.walk, io.async workers, cexy, json ndjson)
+#    define CEX_HAS_THREADS 1
+#    ifdef _WIN32
+#        include <windows.h>
+typedef HANDLE _cex_thread_t;
+typedef DWORD(WINAPI* _cex_thread_f)(LPVOID arg);
+/// Thread function definition, must `return 0;`
+#        define _cex_thread_fn(fn_name, arg_name) DWORD WINAPI fn_name(LPVOID arg_name)
+#    else
+#        include <pthread.h>
+typedef pthread_t _cex_thread_t;
+typedef void* (*_cex_thread_f)(void* arg);
+/// Thread function definition, must `return 0;`
+#        define _cex_thread_fn(fn_name, arg_name) void* fn_name(void* arg_name)
+#    endif
+bool _cex_thread_spawn(_cex_thread_t* thread, _cex_thread_f thread_fn, void* arg);
+void _cex_thread_join(_cex_thread_t thread);
+#endif
+
 
 
 /*
@@ -850,6 +872,7 @@ int __cex_test_uassert_enabled = 1;
 
 void _cex_allocator_memscope_cleanup(IAllocator* allc);
 void _cex_allocator_arena_cleanup(IAllocator* allc);
+void _cex_allocator_temp_cleanup(void);
 
 /**
 Mem cheat-sheet
@@ -2219,7 +2242,53 @@ typedef struct cexsp__context
     char tmp[CEX_SPRINTF_MIN];
 } cexsp__context;
 
+#ifndef CEX_SPRINTF_OPS
+#    define CEX_SPRINTF_OPS 12 // max number of conversions in fmt$() pre-parsed format
+#endif
+
+typedef struct cexsp__fmt_op
+{
+    u16 lit_off;  // literal run offset in format
+    u16 lit_len;  // literal run length
+    u16 conv_off; // conversion char offset in format (UINT16_MAX - trailing literal only)
+    u16 flags;
+    u16 fw;
+    i16 pr;
+    u16 star; // 1 - width is `*`, 2 - precision is `*`
+} cexsp__fmt_op;
+
+typedef struct cexsp__fmt
+{
+    char magic[8]; // CEXSP__FMT_MAGIC, allows passing cexsp__fmt* as regular format string
+    const char* format;
+    u32 state;
+    u32 n_ops;
+    cexsp__fmt_op ops[CEX_SPRINTF_OPS];
+} cexsp__fmt;
+
+/**
+Pre-parses literal format string once per call site, and caches result in a static variable.
+The result can be passed as a format into any CEX formatting function (io.printf, str.fmt,
+sbuf.appendf, etc.), which skips format parsing and copies literal runs at once.
+
+Falls back to the regular format if it's too long or has more than CEX_SPRINTF_OPS conversions.
+
+NOTE: result is not a valid C-string, don't pass it to libc printf() or strlen()
+
+```c
+for (u32 i = 0; i < n; i++) {
+    e$ret(sbuf.appendf(&buf, fmt$("item: %05d, name: %S\n"), i, names[i]));
+}
+```
+*/
+#define fmt$(format)                                                                               \
+    ({                                                                                             \
+        static cexsp__fmt cex$tmpname(cexsp_fmt) = { 0 };                                          \
+        cexsp__fmt_compile(&cex$tmpname(cexsp_fmt), "" format "");                                 \
+    })
+
 // clang-format off
+CEXSP__PUBLICDEC char* cexsp__fmt_compile(cexsp__fmt* self, const char* format);
 CEXSP__PUBLICDEF int cexsp__vfprintf(FILE* stream, const char* format, va_list va);
 CEXSP__PUBLICDEF int cexsp__fprintf(FILE* stream, const char* format, ...);
 CEXSP__PUBLICDEC int cexsp__vsnprintf(char* buf, int count, char const* fmt, va_list va);
@@ -2278,6 +2347,14 @@ CEXSP__PUBLICDEC void cexsp__set_separators(char comma, char period);
     ) \
 )(str_or_slice, out_var_ptr)
 
+/// Bulk parses `sep` delimited numbers from slice into `out_arr` (i64* or f64*), up to `out_cap`
+/// items, e.g. str$parse_many(str$s("1,2,3"), ',', buf, arr$len(buf), &n, &consumed)
+#define str$parse_many(str_slice, sep, out_arr, out_cap, out_len, consumed)                        \
+    _Generic((out_arr), \
+        i64*:  str.convert.parse_many_i64, \
+        f64*:  str.convert.parse_many_f64 \
+    )(str_slice, sep, out_arr, out_cap, out_len, consumed)
+
 /**
 
 CEX string principles:
@@ -2351,10 +2428,30 @@ mem$scope(tmem$, _)
     for$each (v, res) {
         io.printf("%s\n", v); // NOTE: strings now cloned and null-terminated
     }
+
+    // NOTE: all tokens share one allocation (starts at res[0])
+    res = str.split_packed("123,456,789", ",", _);
+
+    // Zero-copy split into existing array of slices
+    arr$(str_s) tokens = arr$new(tokens, _);
+    e$ret(str.slice.split_into(str.sstr("123,456,789"), ",", &tokens));
 }
 
 ```
 
+- UTF-8 support
+
+```c
+str_s text = str.sstr("Привет, World!");
+e$ret(str.utf8.validate(text)); // Error.integrity on malformed UTF-8
+
+for$iter (u32, it, str.utf8.iter(text, &it.iterator)) {
+    io.printf("offset: %zu codepoint: U+%04X\n", it.idx.i, it.val);
+}
+char* lower = str.utf8.lower(text, _); // "привет, world!"
+tassert(str.utf8.cmpi(text, str.sstr(lower)) == 0);
+```
+
 - Chaining string operations
 ```c
 
@@ -2448,6 +2545,10 @@ struct __cex_namespace__str
     /// on error, NULL tolerant. Items of array are cloned, so you need free them independently or
     /// better use arena or tmem$. Supports \n or \r\n.
     arr$(char*)     (*split_lines)(char* s, IAllocator allc);
+    /// Splits string using split_by (allows many) chars, all tokens are packed into a single memory
+    /// block, which starts at result[0]. Returns NULL on error, NULL tolerant. Free with
+    /// `mem$free(allc, res[0]); arr$free(res);` when heap allocator is used (only 2 allocations).
+    arr$(char*)     (*split_packed)(char* s, char* split_by, IAllocator allc);
     /// Analog of sprintf() uses CEX sprintf engine. NULL tolerant, overflow safe.
     Exc             (*sprintf)(char* dest, usize dest_len, char* format,...);
     /// Creates string slice of input C string (NULL tolerant, (str_s){0} on error)
@@ -2464,6 +2565,16 @@ struct __cex_namespace__str
     Exception       (*vsprintf)(char* dest, usize dest_len, char* format, va_list va);
 
     struct {
+        /// Parses `sep` (or new line) delimited run of floats from `s` into `out` (up to `out_cap`
+        /// items). Sets `out_len` to number of parsed items, and `consumed` to number of processed bytes of
+        /// `s` (on error it's offset of the first bad token). If out_cap reached, resume parsing from
+        /// str.slice.sub(s, consumed, 0).
+        Exception       (*parse_many_f64)(str_s s, char sep, f64* out, usize out_cap, usize* out_len, usize* consumed);
+        /// Parses `sep` (or new line) delimited run of integers from `s` into `out` (up to `out_cap`
+        /// items). Sets `out_len` to number of parsed items, and `consumed` to number of processed bytes of
+        /// `s` (on error it's offset of the first bad token). If out_cap reached, resume parsing from
+        /// str.slice.sub(s, consumed, 0).
+        Exception       (*parse_many_i64)(str_s s, char sep, i64* out, usize out_cap, usize* out_len, usize* consumed);
         Exception       (*to_f32)(char* s, f32* num);
         Exception       (*to_f32s)(str_s s, f32* num);
         Exception       (*to_f64)(char* s, f64* num);
@@ -2516,6 +2627,9 @@ struct __cex_namespace__str
         str_s           (*remove_suffix)(str_s s, str_s suffix);
         /// Removes white spaces from the end of slice
         str_s           (*rstrip)(str_s s);
+        /// Splits slice into an existing arr$(str_s) (appends), zero-copy, items are slices of `s`.
+        /// Produces the same tokens as str.slice.iter_split(), array is resized at most once.
+        Exception       (*split_into)(str_s s, char* split_by, arr$(str_s)* out_arr);
         /// Checks if slice starts with prefix, returns (str_s){0} on error, NULL tolerant
         bool            (*starts_with)(str_s s, str_s prefix);
         /// Removes white spaces from both ends of slice
@@ -2526,6 +2640,29 @@ struct __cex_namespace__str
         str_s           (*sub)(str_s s, isize start, isize end);
     } slice;
 
+    struct {
+        /// Case insensitive UTF-8 compare (Latin, Greek, Cyrillic, Armenian), returns <0, 0, >0
+        int             (*cmpi)(str_s a, str_s b);
+        /// iterator over UTF-8 codepoints: for$iter (u32, it, str.utf8.iter(s, &it.iterator)) {},
+        /// it.idx.i is a byte offset of codepoint, invalid bytes are returned as U+FFFD.
+        u32             (*iter)(str_s s, cex_iterator_s* iterator);
+        /// Returns number of codepoints in UTF-8 string, or -1 if invalid (NULL tolerant)
+        isize           (*len)(str_s s);
+        /// Returns new lower case UTF-8 string (Latin, Greek, Cyrillic, Armenian), NULL on error,
+        /// invalid UTF-8 bytes are copied as is.
+        char*           (*lower)(str_s s, IAllocator allc);
+        /// Converts UTF-8 into null-terminated UTF-16 (native endian). Pass out=NULL to get required
+        /// length in out_len (excluding null-terminator). Returns Error.integrity on invalid UTF-8,
+        /// Error.overflow if out_cap is not enough.
+        Exception       (*to_utf16)(str_s s, u16* out, usize out_cap, usize* out_len);
+        /// Returns new upper case UTF-8 string (Latin, Greek, Cyrillic, Armenian), NULL on error,
+        /// invalid UTF-8 bytes are copied as is.
+        char*           (*upper)(str_s s, IAllocator allc);
+        /// Validates UTF-8 string, returns Error.integrity on invalid sequence (overlong, surrogates,
+        /// truncated, or > U+10FFFF), has fast path for ASCII text.
+        Exception       (*validate)(str_s s);
+    } utf8;
+
     // clang-format on
 };
 CEX_NAMESPACE struct __cex_namespace__str str;
@@ -2559,6 +2696,30 @@ typedef struct
 static_assert(alignof(sbuf_head_s) == 1, "align");
 static_assert(alignof(sbuf_head_s) == alignof(char), "align");
 //static_assert(sizeof(sbuf_head_s) == 36, "size");
+
+#ifndef CEX_SBUF_ROPE_CHUNK
+#    define CEX_SBUF_ROPE_CHUNK (1024 * 64) // default chunk size of sbuf.rope
+#endif
+
+/// Chunk of sbuf_rope_c (data is always null-terminated at length)
+typedef struct sbuf_rope_chunk_s
+{
+    struct sbuf_rope_chunk_s* next;
+    usize length;
+    usize capacity;
+    char data[];
+} sbuf_rope_chunk_s;
+
+/// Chunked string builder for very large outputs, appends never move existing bytes
+typedef struct sbuf_rope_c
+{
+    sbuf_rope_chunk_s* first;
+    sbuf_rope_chunk_s* last;
+    const Allocator_i* allocator;
+    Exc err;
+    u64 length;
+    usize chunk_size;
+} sbuf_rope_c;
 /**
 
 Dynamic string builder class
@@ -2602,6 +2763,26 @@ sbuf.clear(&s); // reset dynamic string + null term
 sbuf.destroy(&s);
 ```
 
+- Chunked string builder (rope) for very large outputs
+```c
+// NOTE: rope is a list of fixed size chunks, appending never reallocates or moves existing
+// data, length is 64-bit, and it's not limited by 2gb as regular sbuf_c
+sbuf_rope_c r = sbuf.rope.create(0, mem$); // 0 - CEX_SBUF_ROPE_CHUNK default chunk size
+
+sbuf.rope.appendf(&r, "%s, CEX slice: %S\n", "456", str$s("slice"));
+sbuf.rope.append(&r, "some string");
+
+e$ret(sbuf.rope.validate(&r)); // errors are sticky, like in sbuf_c
+
+sbuf.rope.len(&r); // u64 length
+e$ret(sbuf.rope.fwrite(&r, stdout)); // chunk by chunk writing, without copying
+
+// Contiguous null-terminated copy (lazy, rope is merged into single chunk only once)
+char* s = sbuf.rope.flatten(&r);
+
+sbuf.rope.destroy(&r);
+```
+
 - Static buffer backed string
 ```c
 
@@ -2642,11 +2823,38 @@ struct __cex_namespace__sbuf {
     bool            (*isvalid)(sbuf_c* self);
     /// Returns string length from its metadata
     u32             (*len)(sbuf_c* self);
-    /// Shrinks string length to new_length
+    /// Shrinks string length to new_length (fails when new_length > existing length)
     Exc             (*shrink)(sbuf_c* self, usize new_length);
     /// Validate dynamic string state, with detailed Exception
     Exception       (*validate)(sbuf_c* self);
 
+    struct {
+        /// Append string to the rope
+        Exc             (*append)(sbuf_rope_c* self, char* s);
+        /// Append format to the rope (using CEX formatting engine)
+        Exc             (*appendf)(sbuf_rope_c* self, char* format,...);
+        /// Append format va to the rope (using CEX formatting engine)
+        Exc             (*appendfva)(sbuf_rope_c* self, char* format, va_list va);
+        /// Clears rope contents, keeps first chunk allocated
+        void            (*clear)(sbuf_rope_c* self);
+        /// Creates chunked string builder (rope), chunk_size=0 uses CEX_SBUF_ROPE_CHUNK. Nothing is
+        /// allocated until first append.
+        sbuf_rope_c     (*create)(usize chunk_size, IAllocator allocator);
+        /// Destroys the rope and deallocates all chunks
+        void            (*destroy)(sbuf_rope_c* self);
+        /// Returns contiguous null-terminated rope contents, rope is merged into a single chunk (only once,
+        /// until next append). Returns NULL on error.
+        char*           (*flatten)(sbuf_rope_c* self);
+        /// Writes all rope chunks into the stream, without making contiguous copy
+        Exception       (*fwrite)(sbuf_rope_c* self, FILE* stream);
+        /// Iterates over rope chunks as slices: for$iter (str_s, it, sbuf.rope.iter(&r, &it.iterator))
+        str_s           (*iter)(sbuf_rope_c* self, cex_iterator_s* iterator);
+        /// Returns total rope length (64-bit)
+        u64             (*len)(sbuf_rope_c* self);
+        /// Validate rope state, returns sticky error of the last failed operation
+        Exception       (*validate)(sbuf_rope_c* self);
+    } rope;
+
     // clang-format on
 };
 CEX_NAMESPACE struct __cex_namespace__sbuf sbuf;
@@ -2663,6 +2871,86 @@ CEX_NAMESPACE struct __cex_namespace__sbuf sbuf;
 /// Makes string literal with ansi colored test
 #define io$ansi(text, ansi_col) "\033[" ansi_col "m" text "\033[0m"
 
+#ifndef CEX_IO_LINES_BUF
+#    define CEX_IO_LINES_BUF (1024 * 64) // default refill buffer size of io.lines
+#endif
+
+/// Buffered line reader, lines are yielded as slices of internal buffer (see io.lines)
+typedef struct io_lines_c
+{
+    FILE* file;
+    char* buf;
+    usize buf_size;
+    usize start; // beginning of the next line in buf
+    usize scan;  // buf position where next newline search starts
+    usize end;   // end of data in buf
+    u64 n_lines;
+    const Allocator_i* allocator;
+    Exc err;
+    bool eof;
+} io_lines_c;
+
+/// Flags for io.file.mmap()
+typedef struct io_mmap_flags_s
+{
+    u32 is_private : 1;  // if 1 - private copy-on-write mapping (data.buf is writable)
+    u32 sequential : 1;  // if 1 - hints sequential access (aggressive read-ahead)
+    u32 willneed : 1;    // if 1 - hints to prefetch whole file into page cache
+    u32 hugepage : 1;    // if 1 - hints to use transparent huge pages (Linux)
+    u32 no_fallback : 1; // if 1 - returns error if mmap is not supported, instead of reading file
+} io_mmap_flags_s;
+static_assert(sizeof(io_mmap_flags_s) == sizeof(u32), "size?");
+
+/// Memory mapped file (or its in-memory copy), returned by io.file.mmap()
+typedef struct io_mmap_s
+{
+    str_s data;     // file contents, NOT guaranteed to be NUL terminated (use data.len)
+    void* _addr;    // mapping address (NULL for empty file or read fallback)
+    usize _map_len; // mapping length
+    bool _is_copy;  // data.buf is allocated by mem$ (read fallback)
+} io_mmap_s;
+
+/// Operation types of io.async
+typedef enum IOAsyncOp_e
+{
+    IOAsyncOp__nop,
+    IOAsyncOp__open,
+    IOAsyncOp__read,
+    IOAsyncOp__write,
+    IOAsyncOp__fsync,
+    IOAsyncOp__close,
+} IOAsyncOp_e;
+
+/// Options of io.async.create(), zero fields use defaults
+typedef struct io_async_opts_s
+{
+    u32 queue_depth; // max number of queued/in flight operations (default 64, rounded to power of 2)
+    u32 n_threads;   // number of workers of portable thread backend (default 4)
+    u32 n_buffers;   // number of buffers in the pool, see io.async.buf_get() (default 0 - no pool)
+    u32 buf_size;    // size of each pool buffer (default CEX_IO_LINES_BUF)
+    bool no_uring;   // if true - don't use io_uring even if it's available
+    bool no_threads; // if true - portable backend executes operations synchronously in io.async.submit()
+} io_async_opts_s;
+
+/// Completed io.async operation, see io.async.wait()
+typedef struct io_async_cqe_s
+{
+    u64 tag;        // user tag, given at submission
+    isize result;   // file descriptor (open), bytes count (read/write), 0 (fsync/close), -1 on error
+    Exc err;        // operation error or EOK
+    void* buf;      // read/write buffer of the operation
+    IOAsyncOp_e op; // operation type
+} io_async_cqe_s;
+
+/// Asynchronous file IO engine (io_uring on Linux, or worker threads), see io.async
+typedef struct io_async_c
+{
+    void* _impl;
+    char* backend;   // "io_uring", "threads", or "sync"
+    u32 queue_depth; // max number of pending operations
+    u32 n_pending;   // queued/in flight operations, which are not returned by io.async.wait() yet
+} io_async_c;
+
 /**
 Cross-platform IO namespace
 
@@ -2740,6 +3028,61 @@ test$case(test_write_line)
 }
 ```
 
+- Fast line reader (zero-copy lines, no per line allocations)
+
+```c
+test$case(test_lines_iter)
+{
+    FILE* file;
+    e$ret(io.fopen(&file, "tests/data/text_file_line_4095.txt", "r"));
+
+    // NOTE: buf_size=0 - uses CEX_IO_LINES_BUF, lines longer than buffer grow it
+    io_lines_c lr = io.lines.create(file, 0, mem$);
+
+    // `it.val` is valid only until the next iteration, `\r\n` line endings are stripped
+    for$iter (str_s, it, io.lines.iter(&lr, &it.iterator)) {
+        io.printf("line %zu: %S\n", it.idx.i, it.val);
+    }
+    e$ret(io.lines.validate(&lr)); // iter() stops on error, errors are sticky
+
+    io.lines.destroy(&lr); // NOTE: file is not closed by lines reader
+    io.fclose(&file);
+    return EOK;
+}
+```
+
+- Asynchronous batched IO (io_uring on Linux, worker threads elsewhere)
+
+```c
+test$case(test_async_read_many)
+{
+    io_async_c aio;
+    e$ret(io.async.create(&aio, &(io_async_opts_s){ .queue_depth = 64, .n_buffers = 64 }, mem$));
+
+    // Operations are queued and executed in batch after io.async.submit()/io.async.wait()
+    e$ret(io.async.open(&aio, "tests/data/text_file_50b.txt", "r", 1)); // 1 - user tag
+    e$ret(io.async.submit(&aio));
+
+    io_async_cqe_s cqe[16];
+    u32 n_done = 0;
+    e$ret(io.async.wait(&aio, cqe, arr$len(cqe), 1, &n_done));
+    e$ret(cqe[0].err);
+    int fd = cqe[0].result; // open() returns file descriptor
+
+    // Buffer pool (registered in kernel for io_uring backend)
+    char* buf = io.async.buf_get(&aio);
+    e$ret(io.async.read(&aio, fd, buf, 50, 0, 2)); // read 50 bytes at offset 0
+    e$ret(io.async.wait(&aio, cqe, arr$len(cqe), 1, &n_done));
+    tassert_eq(cqe[0].result, 50);
+    io.async.buf_put(&aio, buf);
+
+    e$ret(io.async.close(&aio, fd, 3));
+    e$ret(io.async.wait(&aio, cqe, arr$len(cqe), 1, &n_done));
+    io.async.destroy(&aio); // NOTE: waits for all pending operations
+    return EOK;
+}
+```
+
 - File low-level write/read
 ```c
 
@@ -2806,20 +3149,80 @@ struct __cex_namespace__io {
     int             (*printf)(char* format,...);
     /// Rewind file cursor at the beginning
     void            (*rewind)(FILE* file);
+    /// Writes all `bufs` into file descriptor `fd` (gathered by writev() if supported), partial writes
+    /// are retried until everything is written. Empty buffers are skipped.
+    Exception       (*writev)(int fd, str_s* bufs, usize n_bufs);
+
+    struct {
+        /// Returns free buffer from the pool (opts.buf_size bytes), NULL if pool is empty or exhausted
+        void*           (*buf_get)(io_async_c* self);
+        /// Returns buffer back to the pool
+        void            (*buf_put)(io_async_c* self, void* buf);
+        /// Queues closing of file descriptor
+        Exception       (*close)(io_async_c* self, int fd, u64 tag);
+        /// Creates async IO engine, opts can be NULL (defaults). Uses io_uring on Linux when available,
+        /// otherwise portable worker threads backend. Must be released by io.async.destroy().
+        Exception       (*create)(io_async_c* self, io_async_opts_s* opts, IAllocator allc);
+        /// Destroys async IO engine, waits for completion of all pending operations (results are discarded)
+        void            (*destroy)(io_async_c* self);
+        /// Queues flushing of file data to the storage device
+        Exception       (*fsync)(io_async_c* self, int fd, u64 tag);
+        /// Queues file opening, `mode` is fopen() like ("r", "r+", "w", "w+", "a", "a+", "x" suffix for
+        /// exclusive creation), completion result is file descriptor. Returns Error.try_again if queue is full.
+        Exception       (*open)(io_async_c* self, char* path, char* mode, u64 tag);
+        /// Queues reading of up to `len` bytes at file `offset` ((u64)-1 - current file position) into
+        /// `buf`, completion result is number of bytes read (0 - EOF).
+        Exception       (*read)(io_async_c* self, int fd, void* buf, usize len, u64 offset, u64 tag);
+        /// Submits all queued operations for execution as a single batch (on error, operations which
+        /// were not accepted by the kernel are dropped, and not counted in n_pending)
+        Exception       (*submit)(io_async_c* self);
+        /// Submits queued operations, and waits until at least `min_complete` operations are completed
+        /// (0 - just polls), returns up to `max_cqes` completions into `cqes`, count is set in `n_done`.
+        Exception       (*wait)(io_async_c* self, io_async_cqe_s* cqes, u32 max_cqes, u32 min_complete, u32* n_done);
+        /// Queues writing of `len` bytes from `buf` at file `offset` ((u64)-1 - current file position),
+        /// completion result is number of bytes written. `buf` must be valid until completion.
+        Exception       (*write)(io_async_c* self, int fd, void* buf, usize len, u64 offset, u64 tag);
+    } async;
 
     struct {
         /// Load full contents of the file at `path`, using text mode. Returns NULL on error.
         char*           (*load)(char* path, IAllocator allc);
+        /// Maps full file contents into memory (read-only, or private copy-on-write with flags.is_private),
+        /// flags can be NULL. Falls back to reading the file into mem$ buffer where mmap is not available.
+        /// Result must be released by io.file.munmap().
+        Exception       (*mmap)(char* path, io_mmap_s* out, io_mmap_flags_s* flags);
+        /// Releases memory mapped file, created by io.file.mmap() (safe to call multiple times)
+        void            (*munmap)(io_mmap_s* m);
         /// Reads line from file, allocates result. Returns NULL on error.
         char*           (*readln)(FILE* file, IAllocator allc);
         /// Saves full `contents` in the file at `path`, using text mode.
         Exception       (*save)(char* path, char* contents);
+        /// Atomically replaces file at `path` with concatenation of `parts` (binary mode). Data is written
+        /// into temp file in the same directory and then renamed over `path`, readers never see partial
+        /// contents. is_durable=true also syncs data (and directory) to the storage device before return.
+        Exception       (*save_atomic)(char* path, str_s* parts, usize n_parts, bool is_durable);
         /// Return full file size, always 0 for NULL file or atty
         usize           (*size)(FILE* file);
         /// Writes new line to the file
         Exception       (*writeln)(FILE* file, char* line);
     } file;
 
+    struct {
+        /// Creates buffered line reader for a file, buf_size=0 uses CEX_IO_LINES_BUF. Nothing is allocated
+        /// until the first line read.
+        io_lines_c      (*create)(FILE* file, usize buf_size, IAllocator allocator);
+        /// Destroys line reader buffer (file is not closed)
+        void            (*destroy)(io_lines_c* self);
+        /// Iterates over file lines: for$iter (str_s, it, io.lines.iter(&lr, &it.iterator)), it.val is
+        /// valid until the next iteration. Check io.lines.validate() after the loop for errors.
+        str_s           (*iter)(io_lines_c* self, cex_iterator_s* iterator);
+        /// Reads next line into `line` slice (valid until the next call), returns Error.eof at the end.
+        /// `\r\n` line endings are stripped, line length is not limited by the buffer size.
+        Exception       (*next)(io_lines_c* self, str_s* line);
+        /// Returns sticky error of the line reader, EOK if there was no error (end of file is not an error)
+        Exception       (*validate)(io_lines_c* self);
+    } lines;
+
     // clang-format on
 };
 CEX_NAMESPACE struct __cex_namespace__io io;
@@ -3543,6 +3946,55 @@ typedef struct os_cmd_c
     bool _is_subprocess;
 } os_cmd_c;
 
+/// Options for os.cmd.pool_create()
+typedef struct os_cmd_pool_opts_s
+{
+    u32 n_jobs;       // max number of concurrently running commands (0 - cpu count)
+    bool keep_going;  // if true - keeps launching jobs after failure (default: fail fast)
+    bool keep_output; // if true - captured output is stored in os_cmd_job_s.output
+    bool no_print;    // if true - captured output is not printed to stdout on job completion
+} os_cmd_pool_opts_s;
+
+/// Job record of os_cmd_pool_c (see os_cmd_pool_c.jobs)
+typedef struct os_cmd_job_s
+{
+    char** args;  // NULL terminated copy of command arguments
+    char* output; // combined stdout/stderr (NULL if empty or opts.keep_output is not set)
+    i32 ret_code; // process exit code (128+signal if killed, -1 if not started)
+    Exc err;      // EOK, Error.runtime if ret_code != 0, or launch error
+    bool is_done;
+} os_cmd_job_s;
+
+/// Pool of concurrently running commands with captured output (see os.cmd.pool_create())
+typedef struct os_cmd_pool_c
+{
+    arr$(os_cmd_job_s) jobs; // all jobs in order of os.cmd.pool_add() calls
+    os_cmd_pool_opts_s opts;
+    IAllocator allc;
+    struct _os_cmd_pool_slot_s* _slots; // running children, opts.n_jobs capacity
+    u32 n_running;
+    u32 n_failed;
+    Exc err; // first failure, sticky
+} os_cmd_pool_c;
+
+/// os.cmd.communicate() output callback, called for each chunk of child stdout/stderr data,
+/// returning error kills the child
+typedef Exception os_cmd_data_f(os_cmd_c* cmd, bool is_stderr, str_s data, void* user_ctx);
+
+/// Command I/O record of os.cmd.communicate()
+typedef struct os_cmd_io_s
+{
+    os_cmd_c* cmd;          // command made by os.cmd.create()
+    str_s stdin_data;       // written to child stdin, then stdin is closed
+    sbuf_c* out;            // if not NULL - appends child stdout (or combined stdout/stderr)
+    sbuf_c* err;            // if not NULL - appends child stderr
+    os_cmd_data_f* on_data; // if not NULL - called on each output chunk
+    void* user_ctx;         // on_data user_ctx
+    u32 timeout_ms;         // 0 - no timeout, otherwise child is killed after timeout
+    i32 ret_code;           // (result) child exit code
+    Exc result;             // (result) EOK, Error.runtime (ret_code != 0), Error.timeout, etc.
+} os_cmd_io_s;
+
 /// File stats metadata (cross-platform), returned by os.fs.stats
 typedef struct os_fs_stat_s
 {
@@ -3562,6 +4014,18 @@ static_assert(sizeof(os_fs_stat_s) <= sizeof(u64) * 2, "size?");
 
 typedef Exception os_fs_dir_walk_f(char* path, os_fs_stat_s ftype, void* user_ctx);
 
+/// Options of os.fs.walk()
+typedef struct os_fs_walk_opts_s
+{
+    u32 n_threads;     // number of walker threads (0 - os.platform.cpu_count(), 1 - current thread)
+    bool is_recursive; // walk into sub-directories (symlinks to directories are not followed)
+    bool with_stat;    // fill ftype.size/ftype.mtime (extra stat() call for each entry)
+} os_fs_walk_opts_s;
+
+/// os.fs.walk() callback, `thread_idx` is less than number of threads, and can be used as index of
+/// per-thread contexts in user_ctx
+typedef Exception os_fs_walk_f(char* path, os_fs_stat_s ftype, u32 thread_idx, void* user_ctx);
+
 #define _CexOSPlatformList                                                                         \
     X(linux)                                                                                       \
     X(win)                                                                                         \
@@ -3732,6 +4196,37 @@ mem$scope(tmem$, _)
 }
 ```
 
+- Running commands in parallel (job pool, output of each job is printed at once on completion)
+```c
+mem$scope(tmem$, _)
+{
+    os_cmd_pool_c pool;
+    e$ret(os.cmd.pool_create(&pool, &(os_cmd_pool_opts_s){ .n_jobs = 8 }, _));
+    for$each (src, sources) { // arr$(char*) of .c files
+        char* args[] = { cexy$cc, "-c", src, "-o", str.fmt(_, "%s.o", src), NULL };
+        if (os.cmd.pool_add(&pool, args, arr$len(args))) { break; } // fail fast
+    }
+    Exc err = os.cmd.pool_join(&pool);
+    os.cmd.pool_destroy(&pool);
+    e$ret(err);
+}
+```
+
+- Serving stdin/stdout/stderr of many commands from one thread (no pipe deadlocks)
+```c
+mem$scope(tmem$, _)
+{
+    os_cmd_c cmd = { 0 };
+    char* args[] = { "sort", NULL };
+    e$ret(os.cmd.create(&cmd, args, arr$len(args), NULL));
+
+    sbuf_c out = sbuf.create(1024, _);
+    os_cmd_io_s cio = { .cmd = &cmd, .stdin_data = str$s("b\na\n"), .out = &out, .timeout_ms = 5000 };
+    e$ret(os.cmd.communicate(&cio, 1)); // may pass array of many os_cmd_io_s
+    io.printf("%s", out);
+}
+```
+
 - Getting command output (low level api)
 ```c
 
@@ -3794,7 +4289,11 @@ struct __cex_namespace__os
     f64             (*timer)(void);
 
     struct {
-        /// Creates new os command (use os$cmd() and os$cmd() for easy cases)
+        /// Services stdin/stdout/stderr of many commands (made by os.cmd.create()) from the current thread
+        /// until all of them exit, and joins them (no os.cmd.join() needed). Returns first failed
+        /// ios[i].result. NOTE: don't mix with os.cmd.read_line()/os.cmd.fstdout() buffered reads.
+        Exception       (*communicate)(os_cmd_io_s* ios, u32 ios_len);
+        /// Creates new os command (use os$cmd() and os$cmd() for easy cases). flags can be NULL.
         Exception       (*create)(os_cmd_c* self, char** args, usize args_len, os_cmd_flags_s* flags);
         /// Check if `cmd_exe` program name exists in PATH. cmd_exe can be absolute, or simple command name,
         /// e.g. `cat`
@@ -3812,6 +4311,19 @@ struct __cex_namespace__os
         Exception       (*join)(os_cmd_c* self, u32 timeout_sec, i32* out_ret_code);
         /// Terminates the running process
         Exception       (*kill)(os_cmd_c* self);
+        /// Adds new job to the pool, args are copied and must be NULL terminated (same as os.cmd.run()).
+        /// Blocks while all opts.n_jobs slots are busy. Returns error of the first failed job (without
+        /// launching a new one) unless opts.keep_going is set.
+        Exception       (*pool_add)(os_cmd_pool_c* self, char** args, usize args_len);
+        /// Creates pool of concurrently running commands, opts can be NULL (cpu count jobs, fail fast,
+        /// output printed per job). Job outputs are captured and printed as a whole on job completion,
+        /// so parallel outputs never interleave.
+        Exception       (*pool_create)(os_cmd_pool_c* self, os_cmd_pool_opts_s* opts, IAllocator allc);
+        /// Terminates still running jobs and frees pool resources
+        void            (*pool_destroy)(os_cmd_pool_c* self);
+        /// Waits all running jobs to finish, returns error of the first failed job (check
+        /// os_cmd_pool_c.jobs for individual results)
+        Exception       (*pool_join)(os_cmd_pool_c* self);
         /// Read all output from process stdout, NULL if stdout is not available
         char*           (*read_all)(os_cmd_c* self, IAllocator allc);
         /// Read line from process stdout, NULL if stdout is not available
@@ -3832,11 +4344,15 @@ struct __cex_namespace__os
     struct {
         /// Change current working directory
         Exception       (*chdir)(char* path);
-        /// Copy file
+        /// Copy file (uses copy-on-write clone or in-kernel copy when possible, keeps sparse file holes,
+        /// permissions, and modification time)
         Exception       (*copy)(char* src_path, char* dst_path);
         /// Copy directory recursively
         Exception       (*copy_tree)(char* src_dir, char* dst_dir);
-        /// Iterates over directory (can be recursive) using callback function
+        /// Copy directory recursively using up to `n_threads` parallel file copies (0 - cpu count)
+        Exception       (*copy_tree_parallel)(char* src_dir, char* dst_dir, u32 n_threads);
+        /// Iterates over directory (can be recursive) using callback function. Entry types are taken from
+        /// the directory listing, ftype.size/ftype.mtime are not filled (see os.fs.walk() with_stat option)
         Exception       (*dir_walk)(char* path, bool is_recursive, os_fs_dir_walk_f callback_fn, void* user_ctx);
         /// Finds files in `dir/pattern`, for example "./mydir/*.c" (all c files), if is_recursive=true, all
         /// *.c files found in sub-directories.
@@ -3855,6 +4371,11 @@ struct __cex_namespace__os
         Exception       (*rename)(char* old_path, char* new_path);
         /// Returns cross-platform path stats information (see os_fs_stat_s)
         os_fs_stat_s    (*stat)(char* path);
+        /// Walks directory entries, calling `callback_fn(path, ftype, thread_idx, user_ctx)`, opts can be
+        /// NULL (non-recursive, single threaded). With n_threads != 1 callbacks are called from multiple
+        /// threads (in arbitrary order, directory callback comes before its contents). Entry types are taken
+        /// from the directory listing, set opts.with_stat for ftype.size/ftype.mtime.
+        Exception       (*walk)(char* path, os_fs_walk_opts_s* opts, os_fs_walk_f callback_fn, void* user_ctx);
     } fs;
 
     struct {
@@ -3878,6 +4399,8 @@ struct __cex_namespace__os
         OSArch_e        (*arch_from_str)(char* name);
         /// Converts arch to string
         char*           (*arch_to_str)(OSArch_e platform);
+        /// Returns number of online CPU cores (at least 1)
+        u32             (*cpu_count)(void);
         /// Returns current OS platform, returns enum of OSPlatform__*, e.g. OSPlatform__win,
         /// OSPlatform__linux, OSPlatform__macos, etc..
         OSPlatform_e    (*current)(void);
@@ -5209,6 +5732,16 @@ void _cex__codegen_indent(_cex__codegen_s* cg);
 #        define cexy$src_dir "./src"
 #    endif
 
+#    ifndef cexy$cache_dir
+/// Directory for parsed source cache of help/process/stats, "" - disables cache (may be overridden by user)
+#        define cexy$cache_dir cexy$build_dir "/.cexy_cache"
+#    endif
+
+#    ifndef cexy$parallel_jobs
+/// Number of worker threads for project-wide stats/process, 0 - use all CPU cores (may be overridden by user)
+#        define cexy$parallel_jobs 0
+#    endif
+
 #    ifndef cexy$create_compile_flags
 /// If 1 creates `compile_flags.txt` in project dir at every ./cex run, 0 - ignores creation (default: 1)
 #       define cexy$create_compile_flags 1
@@ -5447,11 +5980,14 @@ See `cex help str.match` for more information about patter syntax.
         "cex test debug tests/test_file.c         - run test via `cexy$debug_cmd` program\n"\
         "cex test clean all                       - delete all test executables in `cexy$build_dir`\n"\
         "cex test clean test/test_file.c          - delete specific test executable\n"\
-        "cex test run tests/test_file.c [--help]  - run test with passing arguments to the test runner program\n"
+        "cex test run tests/test_file.c [--help]  - run test with passing arguments to the test runner program\n"\
+        "cex test run -j16 all                    - build and run tests using up to 16 parallel jobs\n"\
+        "cex test run -j all                      - build and run tests using all CPU cores\n"
 
 
 // clang-format on
-struct __cex_namespace__cexy {
+struct __cex_namespace__cexy
+{
     // Autogenerated by CEX
     // clang-format off
 
@@ -5493,6 +6029,11 @@ struct __cex_namespace__cexy {
     struct {
         char*           (*git_hash)(IAllocator allc);
         Exception       (*git_lib_fetch)(char* git_url, char* git_label, char* out_dir, bool update_existing, bool preserve_dirs, char** repo_paths, usize repo_paths_len);
+        /// Generates JSON decoders/encoders for typedef structs marked by `@json` in docs comment of
+        /// header_file. Output file has <type>_json_decode(jr_c*, <type>*, IAllocator) and
+        /// <type>_json_encode(jw_c*, <type>*) functions, it must be included after lib/json/json.c and
+        /// the header. Supported fields: bool, ints, floats, char*, char[N], str_s, and @json structs.
+        Exception       (*json_codegen)(char* header_file, char* out_file);
         Exception       (*make_compile_flags)(char* flags_file, bool include_cexy_flags, arr$(char*) cc_flags_or_null);
         Exception       (*make_new_project)(char* proj_dir);
         Exception       (*pkgconf)(IAllocator allc, arr$(char*)* out_cc_args, char** pkgconf_args, usize pkgconf_args_len);
@@ -5502,7 +6043,6 @@ struct __cex_namespace__cexy {
 };
 #endif // #if defined(CEX_BUILD)
 CEX_NAMESPACE struct __cex_namespace__cexy cexy;
-
 #endif
 
 
@@ -5570,6 +6110,15 @@ typedef struct cex_token_s
     str_s value;
 } cex_token_s;
 
+/// Lexer state between tokens, allows resuming tokenization without re-lexing the head
+typedef struct cex_token_checkpoint_s
+{
+    u32 offset;      // cursor offset in the content (position before token)
+    u32 line;        // cursor line at offset
+    u32 token_idx;   // index of the next token in the token list
+    i32 scope_depth; // balance of ( [ { minus ) ] } tokens before offset (non folded scopes)
+} cex_token_checkpoint_s;
+
 typedef struct CexParser_c
 {
     char* content;     // full content
@@ -5607,6 +6156,17 @@ struct __cex_namespace__CexParser {
     cex_token_s     (*next_entity)(CexParser_c* lx, arr$(cex_token_s)* children);
     cex_token_s     (*next_token)(CexParser_c* lx);
     void            (*reset)(CexParser_c* lx);
+    /// Moves lexer cursor to `offset` (must be a position between tokens), recalculates line/col
+    void            (*resync)(CexParser_c* lx, u32 offset);
+    /// Re-tokenizes lx content after the edit of the old content, tokens/checkpoints must be created by
+    /// CexParser.tokenize() for old_content. The edit replaced `removed_len` bytes at `edit_offset` by
+    /// `inserted_len` bytes, lx must be created for the new content (can be the same buffer). Only the
+    /// damaged region is re-lexed, unchanged tail tokens are reused (rebased to new content).
+    Exception       (*retokenize)(CexParser_c* lx, char* old_content, u32 edit_offset, u32 removed_len, u32 inserted_len, u32 checkpoint_every, arr$(cex_token_s)* tokens, arr$(cex_token_checkpoint_s)* checkpoints);
+    /// Tokenizes whole lx content into `tokens`, and adds a checkpoint every `checkpoint_every` tokens
+    /// and at the end of content (used by CexParser.retokenize()). On lexing error `tokens` contains
+    /// tokens before error.
+    Exception       (*tokenize)(CexParser_c* lx, u32 checkpoint_every, arr$(cex_token_s)* tokens, arr$(cex_token_checkpoint_s)* checkpoints);
 
     // clang-format on
 };
@@ -5958,6 +6518,32 @@ __cex__panic(void)
 
 #endif
 
+#if defined(CEX_HAS_THREADS)
+/// Starts native thread running `thread_fn(arg)`, returns false on failure
+bool
+_cex_thread_spawn(_cex_thread_t* thread, _cex_thread_f thread_fn, void* arg)
+{
+#    ifdef _WIN32
+    *thread = CreateThread(NULL, 0, thread_fn, arg, 0, NULL);
+    return *thread != NULL;
+#    else
+    return pthread_create(thread, NULL, thread_fn, arg) == 0;
+#    endif
+}
+
+/// Waits for the thread started by _cex_thread_spawn() and releases it
+void
+_cex_thread_join(_cex_thread_t thread)
+{
+#    ifdef _WIN32
+    WaitForSingleObject(thread, INFINITE);
+    CloseHandle(thread);
+#    else
+    pthread_join(thread, NULL);
+#    endif
+}
+#endif
+
 
 
 /*
@@ -5980,10 +6566,10 @@ _cex_allocator_arena_cleanup(IAllocator* allc)
     AllocatorArena.destroy(*allc);
 }
 
-// NOTE: destructor(101) - 101 lowest priority for destructors
-__attribute__((destructor(101))) void
-_cex_global_allocators_destructor()
+void
+_cex_allocator_temp_cleanup(void)
 {
+    // Frees pages of this thread tmem$ instance, must be called by threads before exit
     AllocatorArena_c* allc = (AllocatorArena_c*)tmem$;
     allocator_arena_page_s* page = allc->last_page;
     while (page) {
@@ -5991,6 +6577,15 @@ _cex_global_allocators_destructor()
         mem$free(mem$, page);
         page = tpage;
     }
+    allc->last_page = NULL;
+    allc->used = 0;
+}
+
+// NOTE: destructor(101) - 101 lowest priority for destructors
+__attribute__((destructor(101))) void
+_cex_global_allocators_destructor()
+{
+    _cex_allocator_temp_cleanup();
 }
 
 #endif
@@ -8090,6 +8685,168 @@ cexsp__format_s_check_va_item_string_len(char const* s, u32 limit)
     return (u32)(sn - s);
 }
 
+typedef struct cexsp__spec
+{
+    i32 fw;
+    i32 pr;
+    u32 fl;
+    u32 star; // 1 - width is `*`, 2 - precision is `*`
+} cexsp__spec;
+
+static inline char const*
+cexsp__scan_spec(char const* f, cexsp__spec* spec)
+{
+    i32 fw = 0;
+    i32 pr = -1;
+    u32 fl = 0;
+    u32 star = 0;
+
+    // flags
+    for (;;) {
+        switch (f[0]) {
+            // if we have left justify
+            case '-':
+                fl |= CEXSP__LEFTJUST;
+                ++f;
+                continue;
+            // if we have leading plus
+            case '+':
+                fl |= CEXSP__LEADINGPLUS;
+                ++f;
+                continue;
+            // if we have leading space
+            case ' ':
+                fl |= CEXSP__LEADINGSPACE;
+                ++f;
+                continue;
+            // if we have leading 0x
+            case '#':
+                fl |= CEXSP__LEADING_0X;
+                ++f;
+                continue;
+            // if we have thousand commas
+            case '\'':
+                fl |= CEXSP__TRIPLET_COMMA;
+                ++f;
+                continue;
+            // if we have kilo marker (none->kilo->kibi->jedec)
+            case '$':
+                if (fl & CEXSP__METRIC_SUFFIX) {
+                    if (fl & CEXSP__METRIC_1024) {
+                        fl |= CEXSP__METRIC_JEDEC;
+                    } else {
+                        fl |= CEXSP__METRIC_1024;
+                    }
+                } else {
+                    fl |= CEXSP__METRIC_SUFFIX;
+                }
+                ++f;
+                continue;
+            // if we don't want space between metric suffix and number
+            case '_':
+                fl |= CEXSP__METRIC_NOSPACE;
+                ++f;
+                continue;
+            // if we have leading zero
+            case '0':
+                fl |= CEXSP__LEADINGZERO;
+                ++f;
+                goto flags_done;
+            default:
+                goto flags_done;
+        }
+    }
+flags_done:
+
+    // get the field width
+    if (f[0] == '*') {
+        star |= 1;
+        ++f;
+    } else {
+        while ((f[0] >= '0') && (f[0] <= '9')) {
+            fw = fw * 10 + f[0] - '0';
+            f++;
+        }
+    }
+    // get the precision
+    if (f[0] == '.') {
+        ++f;
+        if (f[0] == '*') {
+            star |= 2;
+            ++f;
+        } else {
+            pr = 0;
+            while ((f[0] >= '0') && (f[0] <= '9')) {
+                pr = pr * 10 + f[0] - '0';
+                f++;
+            }
+        }
+    }
+
+    // handle integer size overrides
+    switch (f[0]) {
+        // are we halfwidth?
+        case 'h':
+            fl |= CEXSP__HALFWIDTH;
+            ++f;
+            if (f[0] == 'h') {
+                ++f; // QUARTERWIDTH
+            }
+            break;
+        // are we 64-bit (unix style)
+        case 'l':
+            // %ld/%lld - is always 64 bits
+            fl |= CEXSP__INTMAX;
+            ++f;
+            if (f[0] == 'l') { ++f; }
+            break;
+        // are we 64-bit on intmax? (c99)
+        case 'j':
+            fl |= (sizeof(intmax_t) == 8) ? CEXSP__INTMAX : 0;
+            ++f;
+            break;
+        // are we 64-bit on size_t or ptrdiff_t? (c99)
+        case 'z':
+            fl |= (sizeof(ptrdiff_t) == 8) ? CEXSP__INTMAX : 0;
+            ++f;
+            break;
+        case 't':
+            fl |= (sizeof(ptrdiff_t) == 8) ? CEXSP__INTMAX : 0;
+            ++f;
+            break;
+        // are we 64-bit (msft style)
+        case 'I':
+            if ((f[1] == '6') && (f[2] == '4')) {
+                fl |= CEXSP__INTMAX;
+                f += 3;
+            } else if ((f[1] == '3') && (f[2] == '2')) {
+                f += 3;
+            } else {
+                fl |= ((sizeof(void*) == 8) ? CEXSP__INTMAX : 0);
+                ++f;
+            }
+            break;
+        default:
+            break;
+    }
+
+    spec->fw = fw;
+    spec->pr = pr;
+    spec->fl = fl;
+    spec->star = star;
+    return f;
+}
+
+#define CEXSP__FMT_MAGIC "\x1f" "cexfmt"
+
+static inline bool
+cexsp__is_fmt_compiled(char const* fmt)
+{
+    // NOTE: short-circuit comparison never reads beyond the terminating zero of regular strings
+    return fmt[0] == '\x1f' && fmt[1] == 'c' && fmt[2] == 'e' && fmt[3] == 'x' && fmt[4] == 'f' &&
+           fmt[5] == 'm' && fmt[6] == 't' && fmt[7] == '\0';
+}
+
 CEXSP__PUBLICDEF int
 cexsp__vsprintfcb(cexsp_callback_f* callback, void* user, char* buf, char const* fmt, va_list va)
 {
@@ -8098,6 +8855,15 @@ cexsp__vsprintfcb(cexsp_callback_f* callback, void* user, char* buf, char const*
     char* bf = buf;
     char const* f;
     int tlen = 0;
+    cexsp__spec spec;
+    const cexsp__fmt* cfmt = NULL;
+    u32 op_idx = 0;
+
+    if (unlikely(cexsp__is_fmt_compiled(fmt))) {
+        // fmt$() pre-parsed format, literal runs and conversion specs are ready to use
+        cfmt = (const cexsp__fmt*)fmt;
+        fmt = cfmt->format;
+    }
 
     f = fmt;
     for (;;) {
@@ -8128,6 +8894,29 @@ cexsp__vsprintfcb(cexsp_callback_f* callback, void* user, char* buf, char const*
         if (cl > lg) cl = lg;                                                                      \
     }
 
+        if (cfmt) {
+            if (op_idx >= cfmt->n_ops) { goto endfmt; }
+            const cexsp__fmt_op* op = &cfmt->ops[op_idx++];
+            char const* lit = fmt + op->lit_off;
+            i32 n = op->lit_len;
+            while (n) {
+                i32 i;
+                cexsp__cb_buf_clamp(i, n);
+                memcpy(bf, lit, i);
+                bf += i;
+                lit += i;
+                n -= i;
+                cexsp__chk_cb_buf(1);
+            }
+            if (op->conv_off == UINT16_MAX) { goto endfmt; }
+            f = fmt + op->conv_off;
+            spec.fw = op->fw;
+            spec.pr = op->pr;
+            spec.fl = op->flags;
+            spec.star = op->star;
+            goto spec_ready;
+        }
+
         // fast copy everything up to the next % (or end of string)
         for (;;) {
             if (f[0] == '%') { goto scandd; }
@@ -8138,142 +8927,16 @@ cexsp__vsprintfcb(cexsp_callback_f* callback, void* user, char* buf, char const*
         }
     scandd:
 
-        ++f;
-
         // ok, we have a percent, read the modifiers first
-        fw = 0;
-        pr = -1;
-        fl = 0;
-        tz = 0;
+        f = cexsp__scan_spec(f + 1, &spec);
 
-        // flags
-        for (;;) {
-            switch (f[0]) {
-                // if we have left justify
-                case '-':
-                    fl |= CEXSP__LEFTJUST;
-                    ++f;
-                    continue;
-                // if we have leading plus
-                case '+':
-                    fl |= CEXSP__LEADINGPLUS;
-                    ++f;
-                    continue;
-                // if we have leading space
-                case ' ':
-                    fl |= CEXSP__LEADINGSPACE;
-                    ++f;
-                    continue;
-                // if we have leading 0x
-                case '#':
-                    fl |= CEXSP__LEADING_0X;
-                    ++f;
-                    continue;
-                // if we have thousand commas
-                case '\'':
-                    fl |= CEXSP__TRIPLET_COMMA;
-                    ++f;
-                    continue;
-                // if we have kilo marker (none->kilo->kibi->jedec)
-                case '$':
-                    if (fl & CEXSP__METRIC_SUFFIX) {
-                        if (fl & CEXSP__METRIC_1024) {
-                            fl |= CEXSP__METRIC_JEDEC;
-                        } else {
-                            fl |= CEXSP__METRIC_1024;
-                        }
-                    } else {
-                        fl |= CEXSP__METRIC_SUFFIX;
-                    }
-                    ++f;
-                    continue;
-                // if we don't want space between metric suffix and number
-                case '_':
-                    fl |= CEXSP__METRIC_NOSPACE;
-                    ++f;
-                    continue;
-                // if we have leading zero
-                case '0':
-                    fl |= CEXSP__LEADINGZERO;
-                    ++f;
-                    goto flags_done;
-                default:
-                    goto flags_done;
-            }
-        }
-    flags_done:
-
-        // get the field width
-        if (f[0] == '*') {
-            fw = va_arg(va, u32);
-            ++f;
-        } else {
-            while ((f[0] >= '0') && (f[0] <= '9')) {
-                fw = fw * 10 + f[0] - '0';
-                f++;
-            }
-        }
-        // get the precision
-        if (f[0] == '.') {
-            ++f;
-            if (f[0] == '*') {
-                pr = va_arg(va, u32);
-                ++f;
-            } else {
-                pr = 0;
-                while ((f[0] >= '0') && (f[0] <= '9')) {
-                    pr = pr * 10 + f[0] - '0';
-                    f++;
-                }
-            }
-        }
-
-        // handle integer size overrides
-        switch (f[0]) {
-            // are we halfwidth?
-            case 'h':
-                fl |= CEXSP__HALFWIDTH;
-                ++f;
-                if (f[0] == 'h') {
-                    ++f; // QUARTERWIDTH
-                }
-                break;
-            // are we 64-bit (unix style)
-            case 'l':
-                // %ld/%lld - is always 64 bits
-                fl |= CEXSP__INTMAX;
-                ++f;
-                if (f[0] == 'l') { ++f; }
-                break;
-            // are we 64-bit on intmax? (c99)
-            case 'j':
-                fl |= (sizeof(intmax_t) == 8) ? CEXSP__INTMAX : 0;
-                ++f;
-                break;
-            // are we 64-bit on size_t or ptrdiff_t? (c99)
-            case 'z':
-                fl |= (sizeof(ptrdiff_t) == 8) ? CEXSP__INTMAX : 0;
-                ++f;
-                break;
-            case 't':
-                fl |= (sizeof(ptrdiff_t) == 8) ? CEXSP__INTMAX : 0;
-                ++f;
-                break;
-            // are we 64-bit (msft style)
-            case 'I':
-                if ((f[1] == '6') && (f[2] == '4')) {
-                    fl |= CEXSP__INTMAX;
-                    f += 3;
-                } else if ((f[1] == '3') && (f[2] == '2')) {
-                    f += 3;
-                } else {
-                    fl |= ((sizeof(void*) == 8) ? CEXSP__INTMAX : 0);
-                    ++f;
-                }
-                break;
-            default:
-                break;
-        }
+    spec_ready:
+        fw = spec.fw;
+        pr = spec.pr;
+        fl = spec.fl;
+        tz = 0;
+        if (spec.star & 1) { fw = va_arg(va, u32); }
+        if (spec.star & 2) { pr = va_arg(va, u32); }
 
         // handle each replacement
         switch (f[0]) {
@@ -9194,6 +9857,73 @@ cexsp__fprintf(FILE* stream, const char* format, ...)
     return result;
 }
 
+CEXSP__PUBLICDEF char*
+cexsp__fmt_compile(cexsp__fmt* self, const char* format)
+{
+    u32 state = __atomic_load_n(&self->state, __ATOMIC_ACQUIRE);
+    if (likely(state == 2)) { return (char*)self; }
+    if (state == 3) { return (char*)format; }
+
+    u32 expected = 0;
+    if (!__atomic_compare_exchange_n(
+            &self->state,
+            &expected,
+            1,
+            false,
+            __ATOMIC_ACQ_REL,
+            __ATOMIC_ACQUIRE
+        )) {
+        // another thread is compiling this format right now, use the slow path this time
+        return (char*)format;
+    }
+
+    // NOTE: states 0 - new, 1 - compiling, 2 - ready, 3 - not supported (regular format fallback)
+    u32 result_state = 3;
+    u32 n_ops = 0;
+    char const* f = format;
+    char const* lit = format;
+    cexsp__spec spec;
+
+    if (format == NULL) { goto end; }
+
+    for (;;) {
+        while (f[0] != '%' && f[0] != '\0') { f++; }
+        if (n_ops >= arr$len(self->ops) || f - format >= UINT16_MAX - 1) { goto end; }
+
+        cexsp__fmt_op* op = &self->ops[n_ops++];
+        op->lit_off = (u16)(lit - format);
+        op->lit_len = (u16)(f - lit);
+        if (f[0] == '\0') {
+            op->conv_off = UINT16_MAX;
+            break;
+        }
+
+        f = cexsp__scan_spec(f + 1, &spec);
+        if (f[0] == '\0' || f - format >= UINT16_MAX - 1 || spec.fw > UINT16_MAX ||
+            spec.pr > INT16_MAX || spec.fl > UINT16_MAX) {
+            // trailing % or odd sizes, let the regular engine handle it
+            goto end;
+        }
+        op->conv_off = (u16)(f - format);
+        op->flags = (u16)spec.fl;
+        op->fw = (u16)spec.fw;
+        op->pr = (i16)spec.pr;
+        op->star = (u16)spec.star;
+
+        f++;
+        lit = f;
+    }
+
+    memcpy(self->magic, CEXSP__FMT_MAGIC, sizeof(self->magic));
+    self->format = format;
+    self->n_ops = n_ops;
+    result_state = 2;
+
+end:
+    __atomic_store_n(&self->state, result_state, __ATOMIC_RELEASE);
+    return (result_state == 2) ? (char*)self : (char*)format;
+}
+
 // =======================================================================
 //   low level float utility functions
 
@@ -9603,7 +10333,7 @@ _cex_str__index(str_s* s, char* c, u8 clen)
 
     if (!_cex_str__isvalid(s)) { return -1; }
 
-    u8 split_by_idx[UINT8_MAX] = { 0 };
+    u8 split_by_idx[UINT8_MAX + 1] = { 0 };
     for (u8 i = 0; i < clen; i++) { split_by_idx[(u8)c[i]] = 1; }
 
     for (usize i = 0; i < s->len; i++) {
@@ -9616,6 +10346,38 @@ _cex_str__index(str_s* s, char* c, u8 clen)
     return result;
 }
 
+static inline void
+_cex_str__split_table(char* split_by, u8 split_by_idx[UINT8_MAX + 1])
+{
+    memset(split_by_idx, 0, UINT8_MAX + 1);
+    for (char* c = split_by; *c; c++) { split_by_idx[(u8)*c] = 1; }
+}
+
+// Counts tokens the same way as str.slice.iter_split() does, and their total length
+static inline usize
+_cex_str__split_count(str_s s, const u8* split_by_idx, usize* out_tokens_len)
+{
+    if (s.len == 0) {
+        *out_tokens_len = 0;
+        return 0;
+    }
+    usize n_sep = 0;
+    for (usize i = 0; i < s.len; i++) { n_sep += split_by_idx[(u8)s.buf[i]]; }
+    *out_tokens_len = s.len - n_sep;
+    return n_sep + 1;
+}
+
+// Returns token starting at *cursor, and moves cursor after the next separator
+static inline str_s
+_cex_str__split_next(str_s s, const u8* split_by_idx, usize* cursor)
+{
+    usize start = *cursor;
+    usize i = start;
+    while (i < s.len && !split_by_idx[(u8)s.buf[i]]) { i++; }
+    *cursor = i + 1;
+    return (str_s){ .buf = s.buf + start, .len = i - start };
+}
+
 /// Creates string slice of input C string (NULL tolerant, (str_s){0} on error)
 static str_s
 cex_str_sstr(char* ccharptr)
@@ -9774,8 +10536,7 @@ cex_str_replace(char* s, char* old_sub, char* new_sub, IAllocator allc)
         current_pos += new_sub_len;
         start = found + old_sub_len;
     }
-    // NOLINTNEXTLINE
-    strcpy(current_pos, start);
+    memcpy(current_pos, start, str_len - (start - s));
     new_str[new_str_len] = '\0';
     return new_str;
 }
@@ -10192,6 +10953,29 @@ cex_str__slice__iter_split(str_s s, char* split_by, cex_iterator_s* iterator)
     }
 }
 
+/// Splits slice into an existing arr$(str_s) (appends), zero-copy, items are slices of `s`.
+/// Produces the same tokens as str.slice.iter_split(), array is resized at most once.
+static Exception
+cex_str__slice__split_into(str_s s, char* split_by, arr$(str_s) * out_arr)
+{
+    if (unlikely(out_arr == NULL || *out_arr == NULL)) { return Error.argument; }
+    if (unlikely(!_cex_str__isvalid(&s) || split_by == NULL)) { return Error.argument; }
+    if (split_by[0] == '\0') { return Error.argument; }
+
+    u8 split_by_idx[UINT8_MAX + 1];
+    _cex_str__split_table(split_by, split_by_idx);
+
+    usize tokens_len = 0;
+    usize n_tokens = _cex_str__split_count(s, split_by_idx, &tokens_len);
+    if (n_tokens == 0) { return EOK; }
+    if (!arr$grow_check(*out_arr, n_tokens)) { return Error.memory; }
+
+    usize cursor = 0;
+    for (usize i = 0; i < n_tokens; i++) {
+        arr$push(*out_arr, _cex_str__split_next(s, split_by_idx, &cursor));
+    }
+    return EOK;
+}
 
 static Exception
 cex_str__to_signed_num(char* self, usize len, i64* num, i64 num_min, i64 num_max)
@@ -10670,6 +11454,220 @@ cex_str__convert__to_u64(char* s, u64* num)
     return cex_str__convert__to_u64s(str.sstr(s), num);
 }
 
+static inline usize
+_cex_str__many_tok_end(char* s, usize i, usize len, char sep)
+{
+    // NOTE: new line always terminates a token (rows of delimited values)
+    for (; i < len; i++) {
+        char c = s[i];
+        if (c == sep || c == '\n') { break; }
+    }
+    return i;
+}
+
+static inline bool
+_cex_str__many_tok_next(char* s, usize* i, usize len, char sep)
+{
+    // Consumes separator after the token, returns false if token is followed by garbage
+    usize j = *i;
+    if (sep != ' ') {
+        while (j < len && s[j] == ' ') { j++; }
+    }
+    if (j < len && s[j] == '\r' && j + 1 < len && s[j + 1] == '\n') { j++; }
+    if (j < len) {
+        if (s[j] != sep && s[j] != '\n') { return false; }
+        j++;
+    }
+    *i = j;
+    return true;
+}
+
+static Exception
+_cex_str__many_tok_slow(char* s, usize* i, usize len, char sep, bool is_float, void* out)
+{
+    // Generic path: hex, overflow checks, nan/inf, long mantissas
+    usize start = *i;
+    usize end = _cex_str__many_tok_end(s, start, len, sep);
+    usize tlen = end - start;
+    if (tlen > 0 && s[end - 1] == '\r') { tlen--; }
+    if (unlikely(tlen == 0)) { return Error.argument; }
+
+    Exc err;
+    if (is_float) {
+        err = cex_str__to_double(s + start, tlen, out, -307, 308);
+    } else {
+        err = cex_str__to_signed_num(s + start, tlen, out, INT64_MIN + 1, INT64_MAX);
+    }
+    if (err) { return err; }
+
+    *i = end;
+    if (end < len) { *i = end + 1; }
+    return EOK;
+}
+
+/// Parses `sep` (or new line) delimited run of integers from `s` into `out` (up to `out_cap`
+/// items). Sets `out_len` to number of parsed items, and `consumed` to number of processed bytes of
+/// `s` (on error it's offset of the first bad token). If out_cap reached, resume parsing from
+/// str.slice.sub(s, consumed, 0).
+static Exception
+cex_str__convert__parse_many_i64(
+    str_s s,
+    char sep,
+    i64* out,
+    usize out_cap,
+    usize* out_len,
+    usize* consumed
+)
+{
+    uassert(out_len != NULL);
+    uassert(consumed != NULL);
+    *out_len = 0;
+    *consumed = 0;
+    if (unlikely(s.buf == NULL || out == NULL)) { return Error.argument; }
+
+    char* b = s.buf;
+    usize len = s.len;
+    usize i = 0;
+    usize n = 0;
+
+    while (i < len && n < out_cap) {
+        usize tok = i;
+        while (i < len && b[i] == ' ') { i++; }
+
+        u64 neg = 0;
+        if (i < len && (b[i] == '-' || b[i] == '+')) {
+            neg = b[i] == '-';
+            i++;
+        }
+
+        // Fast path: up to 18 decimal digits never overflow i64
+        usize d0 = i;
+        u64 acc = 0;
+        u8 d;
+        while (i < len && (d = (u8)(b[i] - '0')) < 10) {
+            acc = acc * 10 + d;
+            i++;
+        }
+        usize ndigits = i - d0;
+
+        if (likely(ndigits > 0 && ndigits <= 18) && _cex_str__many_tok_next(b, &i, len, sep)) {
+            out[n++] = (i64)((acc ^ -neg) + neg);
+        } else {
+            i = tok;
+            Exc err = _cex_str__many_tok_slow(b, &i, len, sep, false, &out[n]);
+            if (unlikely(err != EOK)) {
+                *out_len = n;
+                *consumed = tok;
+                return err;
+            }
+            n++;
+        }
+    }
+
+    *out_len = n;
+    *consumed = i;
+    return EOK;
+}
+
+/// Parses `sep` (or new line) delimited run of floats from `s` into `out` (up to `out_cap`
+/// items). Sets `out_len` to number of parsed items, and `consumed` to number of processed bytes of
+/// `s` (on error it's offset of the first bad token). If out_cap reached, resume parsing from
+/// str.slice.sub(s, consumed, 0).
+static Exception
+cex_str__convert__parse_many_f64(
+    str_s s,
+    char sep,
+    f64* out,
+    usize out_cap,
+    usize* out_len,
+    usize* consumed
+)
+{
+    uassert(out_len != NULL);
+    uassert(consumed != NULL);
+    *out_len = 0;
+    *consumed = 0;
+    if (unlikely(s.buf == NULL || out == NULL)) { return Error.argument; }
+
+    // Exact powers of 10 for fast path (Clinger: mantissa < 2^53 and |exponent| <= 22)
+    static const f64 pow10[] = { 1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                                 1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                                 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+    char* b = s.buf;
+    usize len = s.len;
+    usize i = 0;
+    usize n = 0;
+
+    while (i < len && n < out_cap) {
+        usize tok = i;
+        while (i < len && b[i] == ' ') { i++; }
+
+        bool neg = false;
+        if (i < len && (b[i] == '-' || b[i] == '+')) {
+            neg = b[i] == '-';
+            i++;
+        }
+
+        u64 mant = 0;
+        i32 exp10 = 0;
+        u32 ndigits = 0;
+        u8 d;
+        while (i < len && (d = (u8)(b[i] - '0')) < 10) {
+            mant = mant * 10 + d;
+            ndigits++;
+            i++;
+        }
+        if (i < len && b[i] == '.') {
+            i++;
+            while (i < len && (d = (u8)(b[i] - '0')) < 10) {
+                mant = mant * 10 + d;
+                ndigits++;
+                exp10--;
+                i++;
+            }
+        }
+        bool fast = ndigits > 0 && ndigits <= 15;
+        if (fast && i < len && (b[i] == 'e' || b[i] == 'E')) {
+            i++;
+            i32 esign = 1;
+            if (i < len && (b[i] == '-' || b[i] == '+')) {
+                esign = b[i] == '-' ? -1 : 1;
+                i++;
+            }
+            u32 e = 0;
+            u32 edigits = 0;
+            while (i < len && (d = (u8)(b[i] - '0')) < 10 && edigits < 4) {
+                e = e * 10 + d;
+                edigits++;
+                i++;
+            }
+            fast = edigits > 0 && edigits < 4;
+            exp10 += (i32)e * esign;
+        }
+
+        if (likely(fast && exp10 >= -22 && exp10 <= 22) &&
+            _cex_str__many_tok_next(b, &i, len, sep)) {
+            f64 v = (f64)mant;
+            v = exp10 < 0 ? v / pow10[-exp10] : v * pow10[exp10];
+            out[n++] = neg ? -v : v;
+        } else {
+            i = tok;
+            Exc err = _cex_str__many_tok_slow(b, &i, len, sep, true, &out[n]);
+            if (unlikely(err != EOK)) {
+                *out_len = n;
+                *consumed = tok;
+                return err;
+            }
+            n++;
+        }
+    }
+
+    *out_len = n;
+    *consumed = i;
+    return EOK;
+}
+
 
 static char*
 _cex_str__fmt_callback(char* buf, void* user, u32 len)
@@ -10678,8 +11676,11 @@ _cex_str__fmt_callback(char* buf, void* user, u32 len)
     cexsp__context* ctx = user;
     if (unlikely(ctx->has_error)) { return NULL; }
 
+    // NOTE: the engine writes up to CEX_SPRINTF_MIN bytes into returned buffer before next call,
+    //       and small outputs are kept in ctx->tmp until the final flush
     if (unlikely(
-            len >= CEX_SPRINTF_MIN && (ctx->buf == NULL || ctx->length + len >= ctx->capacity)
+            (ctx->buf == NULL) ? len >= CEX_SPRINTF_MIN - 1
+                               : ctx->length + len + CEX_SPRINTF_MIN >= ctx->capacity
         )) {
 
         if (len > INT32_MAX || ctx->length + len > INT32_MAX) {
@@ -10689,21 +11690,19 @@ _cex_str__fmt_callback(char* buf, void* user, u32 len)
 
         uassert(ctx->allc != NULL);
 
-        if (ctx->buf == NULL) {
-            ctx->buf = mem$calloc(ctx->allc, 1, CEX_SPRINTF_MIN * 2);
-            if (ctx->buf == NULL) {
-                ctx->has_error = true;
-                return NULL;
-            }
-            ctx->capacity = CEX_SPRINTF_MIN * 2;
-        } else {
-            ctx->buf = mem$realloc(ctx->allc, ctx->buf, ctx->capacity + CEX_SPRINTF_MIN * 2);
-            if (ctx->buf == NULL) {
-                ctx->has_error = true;
-                return NULL;
-            }
-            ctx->capacity += CEX_SPRINTF_MIN * 2;
+        u32 new_capacity = ctx->capacity;
+        while (ctx->length + len + CEX_SPRINTF_MIN >= new_capacity) {
+            new_capacity += CEX_SPRINTF_MIN * 2;
+        }
+        char* new_buf = (ctx->buf == NULL)
+                          ? mem$calloc(ctx->allc, 1, new_capacity)
+                          : mem$realloc(ctx->allc, ctx->buf, new_capacity);
+        if (new_buf == NULL) {
+            ctx->has_error = true;
+            return NULL;
         }
+        ctx->buf = new_buf;
+        ctx->capacity = new_capacity;
     }
     ctx->length += len;
 
@@ -10822,17 +11821,60 @@ static arr$(char*) cex_str_split(char* s, char* split_by, IAllocator allc)
 {
     str_s src = cex_str_sstr(s);
     if (src.buf == NULL || split_by == NULL) { return NULL; }
-    arr$(char*) result = arr$new(result, allc);
+
+    u8 split_by_idx[UINT8_MAX + 1];
+    _cex_str__split_table(split_by, split_by_idx);
+    usize tokens_len = 0;
+    usize n_tokens = (split_by[0]) ? _cex_str__split_count(src, split_by_idx, &tokens_len) : 0;
+
+    arr$(char*) result = arr$new(result, allc, .capacity = n_tokens);
     if (result == NULL) { return NULL; }
 
-    for$iter (str_s, it, cex_str__slice__iter_split(src, split_by, &it.iterator)) {
-        char* tok = cex_str__slice__clone(it.val, allc);
+    usize cursor = 0;
+    for (usize i = 0; i < n_tokens; i++) {
+        char* tok = cex_str__slice__clone(_cex_str__split_next(src, split_by_idx, &cursor), allc);
         arr$push(result, tok);
     }
 
     return result;
 }
 
+/// Splits string using split_by (allows many) chars, all tokens are packed into a single memory
+/// block, which starts at result[0]. Returns NULL on error, NULL tolerant. Free with
+/// `mem$free(allc, res[0]); arr$free(res);` when heap allocator is used (only 2 allocations).
+static arr$(char*) cex_str_split_packed(char* s, char* split_by, IAllocator allc)
+{
+    str_s src = cex_str_sstr(s);
+    if (src.buf == NULL || split_by == NULL) { return NULL; }
+
+    u8 split_by_idx[UINT8_MAX + 1];
+    _cex_str__split_table(split_by, split_by_idx);
+    usize tokens_len = 0;
+    usize n_tokens = (split_by[0]) ? _cex_str__split_count(src, split_by_idx, &tokens_len) : 0;
+
+    arr$(char*) result = arr$new(result, allc, .capacity = n_tokens);
+    if (result == NULL) { return NULL; }
+    if (n_tokens == 0) { return result; }
+
+    // every token gets its own null terminator
+    char* block = mem$malloc(allc, tokens_len + n_tokens);
+    if (block == NULL) {
+        arr$free(result);
+        return NULL;
+    }
+
+    usize cursor = 0;
+    for (usize i = 0; i < n_tokens; i++) {
+        str_s tok = _cex_str__split_next(src, split_by_idx, &cursor);
+        memcpy(block, tok.buf, tok.len);
+        block[tok.len] = '\0';
+        arr$push(result, block);
+        block += tok.len + 1;
+    }
+
+    return result;
+}
+
 /// Splits string by lines, result allocated by allc, as dynamic array of cloned lines, Returns NULL
 /// on error, NULL tolerant. Items of array are cloned, so you need free them independently or
 /// better use arena or tmem$. Supports \n or \r\n.
@@ -10840,7 +11882,13 @@ static arr$(char*) cex_str_split_lines(char* s, IAllocator allc)
 {
     uassert(allc != NULL);
     if (s == NULL) { return NULL; }
-    arr$(char*) result = arr$new(result, allc);
+
+    // NOTE: upper bound, \r\n counts twice
+    usize n_lines = 1;
+    for (char* c = s; *c; c++) {
+        n_lines += (*c == '\n' || *c == '\r' || *c == '\v' || *c == '\f');
+    }
+    arr$(char*) result = arr$new(result, allc, .capacity = n_lines);
     if (result == NULL) { return NULL; }
     char c;
     char* line_start = s;
@@ -10884,32 +11932,33 @@ cex_str_join(char** str_arr, usize str_arr_len, char* join_by, IAllocator allc)
     usize jlen = strlen(join_by);
     if (jlen == 0) { return NULL; }
 
-    char* result = NULL;
-    usize cursor = 0;
+    if (str_arr_len == 0) { return NULL; }
+
+    // first pass: exact result size
+    usize total_len = jlen * (str_arr_len - 1);
     for$each (s, str_arr, str_arr_len) {
-        if (s == NULL) {
-            if (result != NULL) { mem$free(allc, result); }
-            return NULL;
-        }
-        usize slen = strlen(s);
-        if (result == NULL) {
-            result = mem$malloc(allc, slen + jlen + 1);
-        } else {
-            result = mem$realloc(allc, result, cursor + slen + jlen + 1);
-        }
-        if (result == NULL) {
-            return NULL; // memory error
-        }
+        if (s == NULL) { return NULL; }
+        total_len += strlen(s);
+    }
 
-        if (cursor > 0) {
+    char* result = mem$malloc(allc, total_len + 1);
+    if (result == NULL) {
+        return NULL; // memory error
+    }
+
+    usize cursor = 0;
+    for (usize i = 0; i < str_arr_len; i++) {
+        if (i > 0) {
             memcpy(&result[cursor], join_by, jlen);
             cursor += jlen;
         }
-
+        char* s = str_arr[i];
+        usize slen = strlen(s);
         memcpy(&result[cursor], s, slen);
         cursor += slen;
     }
-    if (result) { result[cursor] = '\0'; }
+    uassert(cursor == total_len);
+    result[cursor] = '\0';
 
     return result;
 }
@@ -11149,78 +12198,443 @@ cex_str_qscmpi(const void* a, const void* b)
     return _cex_str__tolower((unsigned char)*_a) - _cex_str__tolower((unsigned char)*_b);
 }
 
-const struct __cex_namespace__str str = {
-    // Autogenerated by CEX
-    // clang-format off
+#define _CEX_STR__UTF8_INVALID UINT32_MAX
 
-    .clone = cex_str_clone,
-    .copy = cex_str_copy,
-    .ends_with = cex_str_ends_with,
-    .eq = cex_str_eq,
-    .eqi = cex_str_eqi,
-    .find = cex_str_find,
-    .findr = cex_str_findr,
-    .fmt = cex_str_fmt,
-    .join = cex_str_join,
-    .len = cex_str_len,
-    .lower = cex_str_lower,
-    .match = cex_str_match,
-    .qscmp = cex_str_qscmp,
-    .qscmpi = cex_str_qscmpi,
-    .replace = cex_str_replace,
-    .sbuf = cex_str_sbuf,
-    .split = cex_str_split,
-    .split_lines = cex_str_split_lines,
-    .sprintf = cex_str_sprintf,
-    .sstr = cex_str_sstr,
-    .starts_with = cex_str_starts_with,
-    .sub = cex_str_sub,
-    .upper = cex_str_upper,
-    .vsprintf = cex_str_vsprintf,
+static inline u64
+_cex_str__utf8_load_u64(const char* p)
+{
+    u64 v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+// Decodes a codepoint at s[*i] and advances *i, invalid sequences are skipped by 1 byte and
+// return _CEX_STR__UTF8_INVALID (rejects overlong forms, surrogates, codepoints > U+10FFFF)
+static inline u32
+_cex_str__utf8_decode(const u8* s, usize len, usize* i)
+{
+    usize pos = *i;
+    u8 c = s[pos];
+    if (c < 0x80) {
+        *i = pos + 1;
+        return c;
+    }
+
+    u32 cp;
+    u32 n;
+    if (c >= 0xC2 && c <= 0xDF) {
+        n = 1;
+        cp = c & 0x1F;
+    } else if ((c & 0xF0) == 0xE0) {
+        n = 2;
+        cp = c & 0x0F;
+    } else if (c >= 0xF0 && c <= 0xF4) {
+        n = 3;
+        cp = c & 0x07;
+    } else {
+        goto invalid;
+    }
+    if (len - pos <= n) { goto invalid; }
 
-    .convert = {
-        .to_f32 = cex_str__convert__to_f32,
-        .to_f32s = cex_str__convert__to_f32s,
-        .to_f64 = cex_str__convert__to_f64,
-        .to_f64s = cex_str__convert__to_f64s,
-        .to_i16 = cex_str__convert__to_i16,
-        .to_i16s = cex_str__convert__to_i16s,
-        .to_i32 = cex_str__convert__to_i32,
-        .to_i32s = cex_str__convert__to_i32s,
-        .to_i64 = cex_str__convert__to_i64,
-        .to_i64s = cex_str__convert__to_i64s,
-        .to_i8 = cex_str__convert__to_i8,
-        .to_i8s = cex_str__convert__to_i8s,
-        .to_u16 = cex_str__convert__to_u16,
-        .to_u16s = cex_str__convert__to_u16s,
-        .to_u32 = cex_str__convert__to_u32,
-        .to_u32s = cex_str__convert__to_u32s,
-        .to_u64 = cex_str__convert__to_u64,
-        .to_u64s = cex_str__convert__to_u64s,
-        .to_u8 = cex_str__convert__to_u8,
-        .to_u8s = cex_str__convert__to_u8s,
-    },
+    for (u32 k = 1; k <= n; k++) {
+        u8 b = s[pos + k];
+        if ((b & 0xC0) != 0x80) { goto invalid; }
+        cp = (cp << 6) | (b & 0x3F);
+    }
+    if (n == 2 && (cp < 0x800 || (cp >= 0xD800 && cp <= 0xDFFF))) { goto invalid; }
+    if (n == 3 && (cp < 0x10000 || cp > 0x10FFFF)) { goto invalid; }
 
-    .slice = {
-        .clone = cex_str__slice__clone,
-        .copy = cex_str__slice__copy,
-        .ends_with = cex_str__slice__ends_with,
-        .eq = cex_str__slice__eq,
-        .eqi = cex_str__slice__eqi,
-        .index_of = cex_str__slice__index_of,
-        .iter_split = cex_str__slice__iter_split,
-        .lstrip = cex_str__slice__lstrip,
-        .match = cex_str__slice__match,
-        .qscmp = cex_str__slice__qscmp,
-        .qscmpi = cex_str__slice__qscmpi,
-        .remove_prefix = cex_str__slice__remove_prefix,
+    *i = pos + n + 1;
+    return cp;
+
+invalid:
+    *i = pos + 1;
+    return _CEX_STR__UTF8_INVALID;
+}
+
+static inline usize
+_cex_str__utf8_encode(u32 cp, char* out)
+{
+    if (cp < 0x80) {
+        out[0] = (char)cp;
+        return 1;
+    } else if (cp < 0x800) {
+        out[0] = (char)(0xC0 | (cp >> 6));
+        out[1] = (char)(0x80 | (cp & 0x3F));
+        return 2;
+    } else if (cp < 0x10000) {
+        out[0] = (char)(0xE0 | (cp >> 12));
+        out[1] = (char)(0x80 | ((cp >> 6) & 0x3F));
+        out[2] = (char)(0x80 | (cp & 0x3F));
+        return 3;
+    } else {
+        out[0] = (char)(0xF0 | (cp >> 18));
+        out[1] = (char)(0x80 | ((cp >> 12) & 0x3F));
+        out[2] = (char)(0x80 | ((cp >> 6) & 0x3F));
+        out[3] = (char)(0x80 | (cp & 0x3F));
+        return 4;
+    }
+}
+
+// Simple case mapping for Latin-1, Latin Extended-A, Greek, Cyrillic and Armenian,
+// mapped codepoints always keep the same UTF-8 length.
+static inline u32
+_cex_str__utf8_tolower_cp(u32 c)
+{
+    if (c < 0x80) { return (c >= 'A' && c <= 'Z') ? c + 32 : c; }
+    if (c >= 0xC0 && c <= 0xDE) { return (c != 0xD7) ? c + 32 : c; }
+    if (c >= 0x100 && c <= 0x17E) {
+        if (c == 0x130 || c == 0x131 || c == 0x138 || c == 0x149) { return c; }
+        if (c <= 0x137 || (c >= 0x14A && c <= 0x177)) { return c | 1; }
+        if (c == 0x178) { return 0xFF; }
+        return (c & 1) ? c + 1 : c;
+    }
+    if (c >= 0x386 && c <= 0x38F) {
+        if (c == 0x386) { return 0x3AC; }
+        if (c >= 0x388 && c <= 0x38A) { return c + 37; }
+        if (c == 0x38C) { return 0x3CC; }
+        if (c >= 0x38E) { return c + 63; }
+        return c;
+    }
+    if (c >= 0x391 && c <= 0x3AB) { return (c != 0x3A2) ? c + 32 : c; }
+    if (c >= 0x400 && c <= 0x40F) { return c + 80; }
+    if (c >= 0x410 && c <= 0x42F) { return c + 32; }
+    if (c >= 0x531 && c <= 0x556) { return c + 48; }
+    return c;
+}
+
+static inline u32
+_cex_str__utf8_toupper_cp(u32 c)
+{
+    if (c < 0x80) { return (c >= 'a' && c <= 'z') ? c - 32 : c; }
+    if (c >= 0xE0 && c <= 0xFE) { return (c != 0xF7) ? c - 32 : c; }
+    if (c == 0xFF) { return 0x178; }
+    if (c >= 0x100 && c <= 0x17E) {
+        if (c == 0x130 || c == 0x131 || c == 0x138 || c == 0x149 || c == 0x178) { return c; }
+        if (c <= 0x137 || (c >= 0x14A && c <= 0x177)) { return c & ~1u; }
+        return (c & 1) ? c : c - 1;
+    }
+    if (c == 0x3C2) { return 0x3A3; } // final sigma
+    if (c >= 0x3B1 && c <= 0x3CB) { return c - 32; }
+    if (c >= 0x3AC && c <= 0x3CE) {
+        if (c == 0x3AC) { return 0x386; }
+        if (c <= 0x3AF) { return c - 37; }
+        if (c == 0x3CC) { return 0x38C; }
+        if (c >= 0x3CD) { return c - 63; }
+    }
+    if (c >= 0x430 && c <= 0x44F) { return c - 32; }
+    if (c >= 0x450 && c <= 0x45F) { return c - 80; }
+    if (c >= 0x561 && c <= 0x586) { return c - 48; }
+    return c;
+}
+
+#define _CEX_STR__SWAR_HI 0x8080808080808080ULL
+#define _CEX_STR__SWAR_EACH(b) (0x0101010101010101ULL * (b))
+
+// ASCII only 8-byte word case conversion (all bytes must be < 0x80)
+static inline u64
+_cex_str__swar_case(u64 w, bool to_upper)
+{
+    u8 first = (to_upper) ? 'a' : 'A';
+    u8 last = (to_upper) ? 'z' : 'Z';
+    u64 ge_first = w + _CEX_STR__SWAR_EACH(0x80 - first);
+    u64 gt_last = w + _CEX_STR__SWAR_EACH(0x7F - last);
+    u64 mask = ge_first & ~gt_last & _CEX_STR__SWAR_HI;
+    return w ^ (mask >> 2);
+}
+
+/// Validates UTF-8 string, returns Error.integrity on invalid sequence (overlong, surrogates,
+/// truncated, or > U+10FFFF), has fast path for ASCII text.
+static Exception
+cex_str__utf8__validate(str_s s)
+{
+    if (unlikely(s.buf == NULL)) { return Error.argument; }
+    const u8* b = (const u8*)s.buf;
+    usize i = 0;
+    while (i < s.len) {
+        if (i + 16 <= s.len) {
+            u64 w = _cex_str__utf8_load_u64(s.buf + i) | _cex_str__utf8_load_u64(s.buf + i + 8);
+            if ((w & _CEX_STR__SWAR_HI) == 0) {
+                i += 16;
+                continue;
+            }
+        }
+        if (b[i] < 0x80) {
+            i++;
+            continue;
+        }
+        if (_cex_str__utf8_decode(b, s.len, &i) == _CEX_STR__UTF8_INVALID) {
+            return Error.integrity;
+        }
+    }
+    return EOK;
+}
+
+/// Returns number of codepoints in UTF-8 string, or -1 if invalid (NULL tolerant)
+static isize
+cex_str__utf8__len(str_s s)
+{
+    if (unlikely(s.buf == NULL)) { return -1; }
+    const u8* b = (const u8*)s.buf;
+    usize i = 0;
+    isize n = 0;
+    while (i < s.len) {
+        if (i + 8 <= s.len && (_cex_str__utf8_load_u64(s.buf + i) & _CEX_STR__SWAR_HI) == 0) {
+            i += 8;
+            n += 8;
+            continue;
+        }
+        if (_cex_str__utf8_decode(b, s.len, &i) == _CEX_STR__UTF8_INVALID) { return -1; }
+        n++;
+    }
+    return n;
+}
+
+/// iterator over UTF-8 codepoints: for$iter (u32, it, str.utf8.iter(s, &it.iterator)) {},
+/// it.idx.i is a byte offset of codepoint, invalid bytes are returned as U+FFFD.
+static u32
+cex_str__utf8__iter(str_s s, cex_iterator_s* iterator)
+{
+    uassert(iterator != NULL && "null iterator");
+
+    // temporary struct based on _ctxbuffer
+    struct iter_ctx
+    {
+        usize cursor;
+    }* ctx = (struct iter_ctx*)iterator->_ctx;
+    static_assert(sizeof(*ctx) <= sizeof(iterator->_ctx), "ctx size overflow");
+    static_assert(alignof(struct iter_ctx) <= alignof(usize), "cex_iterator_s _ctx misalign");
+
+    if (unlikely(!iterator->initialized)) {
+        iterator->initialized = 1;
+        ctx->cursor = 0;
+    }
+    if (unlikely(s.buf == NULL || ctx->cursor >= s.len)) {
+        iterator->stopped = 1;
+        return 0;
+    }
+
+    iterator->idx.i = ctx->cursor;
+    u32 cp = _cex_str__utf8_decode((const u8*)s.buf, s.len, &ctx->cursor);
+    return (cp != _CEX_STR__UTF8_INVALID) ? cp : 0xFFFD;
+}
+
+static char*
+_cex_str__utf8_case(str_s s, bool to_upper, IAllocator allc)
+{
+    if (s.buf == NULL) { return NULL; }
+    uassert(s.len < PTRDIFF_MAX);
+
+    char* result = mem$malloc(allc, s.len + 1);
+    if (result == NULL) { return NULL; }
+
+    const u8* b = (const u8*)s.buf;
+    usize i = 0;
+    usize o = 0;
+    while (i < s.len) {
+        if (i + 8 <= s.len) {
+            u64 w = _cex_str__utf8_load_u64(s.buf + i);
+            if ((w & _CEX_STR__SWAR_HI) == 0) {
+                w = _cex_str__swar_case(w, to_upper);
+                memcpy(result + o, &w, sizeof(w));
+                i += 8;
+                o += 8;
+                continue;
+            }
+        }
+        usize start = i;
+        u32 cp = _cex_str__utf8_decode(b, s.len, &i);
+        if (cp == _CEX_STR__UTF8_INVALID) {
+            result[o++] = s.buf[start]; // invalid bytes copied as is
+            continue;
+        }
+        cp = (to_upper) ? _cex_str__utf8_toupper_cp(cp) : _cex_str__utf8_tolower_cp(cp);
+        o += _cex_str__utf8_encode(cp, result + o);
+        uassert(o == i && "case mapping changed utf8 length");
+    }
+    result[o] = '\0';
+    return result;
+}
+
+/// Returns new lower case UTF-8 string (Latin, Greek, Cyrillic, Armenian), NULL on error,
+/// invalid UTF-8 bytes are copied as is.
+static char*
+cex_str__utf8__lower(str_s s, IAllocator allc)
+{
+    return _cex_str__utf8_case(s, false, allc);
+}
+
+/// Returns new upper case UTF-8 string (Latin, Greek, Cyrillic, Armenian), NULL on error,
+/// invalid UTF-8 bytes are copied as is.
+static char*
+cex_str__utf8__upper(str_s s, IAllocator allc)
+{
+    return _cex_str__utf8_case(s, true, allc);
+}
+
+/// Case insensitive UTF-8 compare (Latin, Greek, Cyrillic, Armenian), returns <0, 0, >0
+static int
+cex_str__utf8__cmpi(str_s a, str_s b)
+{
+    if (a.buf == NULL || b.buf == NULL) { return (a.buf != NULL) - (b.buf != NULL); }
+
+    const u8* ab = (const u8*)a.buf;
+    const u8* bb = (const u8*)b.buf;
+    usize i = 0;
+    usize j = 0;
+    while (i < a.len && j < b.len) {
+        if (i == j && i + 8 <= a.len && i + 8 <= b.len) {
+            u64 wa = _cex_str__utf8_load_u64(a.buf + i);
+            u64 wb = _cex_str__utf8_load_u64(b.buf + j);
+            if (((wa | wb) & _CEX_STR__SWAR_HI) == 0 &&
+                _cex_str__swar_case(wa, false) == _cex_str__swar_case(wb, false)) {
+                i += 8;
+                j += 8;
+                continue;
+            }
+        }
+        usize ia = i;
+        usize jb = j;
+        u32 ca = _cex_str__utf8_decode(ab, a.len, &i);
+        u32 cb = _cex_str__utf8_decode(bb, b.len, &j);
+        // NOTE: invalid bytes are compared by value, after all valid codepoints
+        ca = (ca != _CEX_STR__UTF8_INVALID) ? _cex_str__utf8_tolower_cp(ca) : 0x110000u + ab[ia];
+        cb = (cb != _CEX_STR__UTF8_INVALID) ? _cex_str__utf8_tolower_cp(cb) : 0x110000u + bb[jb];
+        if (ca != cb) { return (ca < cb) ? -1 : 1; }
+    }
+    return (i < a.len) - (j < b.len);
+}
+
+/// Converts UTF-8 into null-terminated UTF-16 (native endian). Pass out=NULL to get required
+/// length in out_len (excluding null-terminator). Returns Error.integrity on invalid UTF-8,
+/// Error.overflow if out_cap is not enough.
+static Exception
+cex_str__utf8__to_utf16(str_s s, u16* out, usize out_cap, usize* out_len)
+{
+    if (unlikely(s.buf == NULL || out_len == NULL)) { return Error.argument; }
+    if (unlikely(out != NULL && out_cap == 0)) { return Error.argument; }
+    *out_len = 0;
+
+    const u8* b = (const u8*)s.buf;
+    usize i = 0;
+    usize n = 0;
+    while (i < s.len) {
+        u32 cp = _cex_str__utf8_decode(b, s.len, &i);
+        if (cp == _CEX_STR__UTF8_INVALID) {
+            if (out) { out[0] = 0; }
+            return Error.integrity;
+        }
+        usize n_units = (cp < 0x10000) ? 1 : 2;
+        if (out) {
+            if (n + n_units >= out_cap) {
+                out[0] = 0;
+                return Error.overflow;
+            }
+            if (n_units == 1) {
+                out[n] = (u16)cp;
+            } else {
+                cp -= 0x10000;
+                out[n] = (u16)(0xD800 | (cp >> 10));
+                out[n + 1] = (u16)(0xDC00 | (cp & 0x3FF));
+            }
+        }
+        n += n_units;
+    }
+    if (out) { out[n] = 0; }
+    *out_len = n;
+    return EOK;
+}
+
+#undef _CEX_STR__UTF8_INVALID
+#undef _CEX_STR__SWAR_HI
+#undef _CEX_STR__SWAR_EACH
+
+const struct __cex_namespace__str str = {
+    // Autogenerated by CEX
+    // clang-format off
+
+    .clone = cex_str_clone,
+    .copy = cex_str_copy,
+    .ends_with = cex_str_ends_with,
+    .eq = cex_str_eq,
+    .eqi = cex_str_eqi,
+    .find = cex_str_find,
+    .findr = cex_str_findr,
+    .fmt = cex_str_fmt,
+    .join = cex_str_join,
+    .len = cex_str_len,
+    .lower = cex_str_lower,
+    .match = cex_str_match,
+    .qscmp = cex_str_qscmp,
+    .qscmpi = cex_str_qscmpi,
+    .replace = cex_str_replace,
+    .sbuf = cex_str_sbuf,
+    .split = cex_str_split,
+    .split_lines = cex_str_split_lines,
+    .split_packed = cex_str_split_packed,
+    .sprintf = cex_str_sprintf,
+    .sstr = cex_str_sstr,
+    .starts_with = cex_str_starts_with,
+    .sub = cex_str_sub,
+    .upper = cex_str_upper,
+    .vsprintf = cex_str_vsprintf,
+
+    .convert = {
+        .parse_many_f64 = cex_str__convert__parse_many_f64,
+        .parse_many_i64 = cex_str__convert__parse_many_i64,
+        .to_f32 = cex_str__convert__to_f32,
+        .to_f32s = cex_str__convert__to_f32s,
+        .to_f64 = cex_str__convert__to_f64,
+        .to_f64s = cex_str__convert__to_f64s,
+        .to_i16 = cex_str__convert__to_i16,
+        .to_i16s = cex_str__convert__to_i16s,
+        .to_i32 = cex_str__convert__to_i32,
+        .to_i32s = cex_str__convert__to_i32s,
+        .to_i64 = cex_str__convert__to_i64,
+        .to_i64s = cex_str__convert__to_i64s,
+        .to_i8 = cex_str__convert__to_i8,
+        .to_i8s = cex_str__convert__to_i8s,
+        .to_u16 = cex_str__convert__to_u16,
+        .to_u16s = cex_str__convert__to_u16s,
+        .to_u32 = cex_str__convert__to_u32,
+        .to_u32s = cex_str__convert__to_u32s,
+        .to_u64 = cex_str__convert__to_u64,
+        .to_u64s = cex_str__convert__to_u64s,
+        .to_u8 = cex_str__convert__to_u8,
+        .to_u8s = cex_str__convert__to_u8s,
+    },
+
+    .slice = {
+        .clone = cex_str__slice__clone,
+        .copy = cex_str__slice__copy,
+        .ends_with = cex_str__slice__ends_with,
+        .eq = cex_str__slice__eq,
+        .eqi = cex_str__slice__eqi,
+        .index_of = cex_str__slice__index_of,
+        .iter_split = cex_str__slice__iter_split,
+        .lstrip = cex_str__slice__lstrip,
+        .match = cex_str__slice__match,
+        .qscmp = cex_str__slice__qscmp,
+        .qscmpi = cex_str__slice__qscmpi,
+        .remove_prefix = cex_str__slice__remove_prefix,
         .remove_suffix = cex_str__slice__remove_suffix,
         .rstrip = cex_str__slice__rstrip,
+        .split_into = cex_str__slice__split_into,
         .starts_with = cex_str__slice__starts_with,
         .strip = cex_str__slice__strip,
         .sub = cex_str__slice__sub,
     },
 
+    .utf8 = {
+        .cmpi = cex_str__utf8__cmpi,
+        .iter = cex_str__utf8__iter,
+        .len = cex_str__utf8__len,
+        .lower = cex_str__utf8__lower,
+        .to_utf16 = cex_str__utf8__to_utf16,
+        .upper = cex_str__utf8__upper,
+        .validate = cex_str__utf8__validate,
+    },
+
     // clang-format on
 };
 #endif
@@ -11610,66 +13024,378 @@ cex_sbuf_isvalid(sbuf_c* self)
     }
 }
 
-const struct __cex_namespace__sbuf sbuf = {
-    // Autogenerated by CEX
-    // clang-format off
-
-    .append = cex_sbuf_append,
-    .appendf = cex_sbuf_appendf,
-    .appendfva = cex_sbuf_appendfva,
-    .capacity = cex_sbuf_capacity,
-    .clear = cex_sbuf_clear,
-    .create = cex_sbuf_create,
-    .create_static = cex_sbuf_create_static,
-    .destroy = cex_sbuf_destroy,
-    .isvalid = cex_sbuf_isvalid,
-    .len = cex_sbuf_len,
-    .shrink = cex_sbuf_shrink,
-    .validate = cex_sbuf_validate,
+static sbuf_rope_chunk_s*
+_sbuf__rope_new_chunk(sbuf_rope_c* self, usize capacity)
+{
+    // NOTE: +1 byte for null terminator of chunk data
+    sbuf_rope_chunk_s* c = mem$malloc(self->allocator, sizeof(sbuf_rope_chunk_s) + capacity + 1);
+    if (unlikely(c == NULL)) {
+        self->err = Error.memory;
+        return NULL;
+    }
+    c->next = NULL;
+    c->length = 0;
+    c->capacity = capacity;
+    c->data[0] = '\0';
 
-    // clang-format on
-};
-#endif
+    if (self->last) {
+        self->last->next = c;
+    } else {
+        self->first = c;
+    }
+    self->last = c;
+    return c;
+}
 
+static Exc
+_sbuf__rope_write(sbuf_rope_c* self, char* s, usize len)
+{
+    while (len > 0) {
+        sbuf_rope_chunk_s* c = self->last;
+        if (c == NULL || c->length == c->capacity) {
+            c = _sbuf__rope_new_chunk(self, self->chunk_size);
+            if (unlikely(c == NULL)) { return self->err; }
+        }
+        usize n = c->capacity - c->length;
+        if (n > len) { n = len; }
 
+        memcpy(c->data + c->length, s, n);
+        c->length += n;
+        c->data[c->length] = '\0';
+        self->length += n;
+        s += n;
+        len -= n;
+    }
+    return EOK;
+}
 
-/*
-*                          src/io.c
-*/
-#if !defined(cex$enable_minimal) || defined(cex$enable_io)
-#include <errno.h>
-#include <stdio.h>
+/// Creates chunked string builder (rope), chunk_size=0 uses CEX_SBUF_ROPE_CHUNK. Nothing is
+/// allocated until first append.
+static sbuf_rope_c
+cex_sbuf__rope__create(usize chunk_size, IAllocator allocator)
+{
+    uassert(allocator != NULL);
+    if (chunk_size == 0) { chunk_size = CEX_SBUF_ROPE_CHUNK; }
+    if (chunk_size < CEX_SPRINTF_MIN * 2) { chunk_size = CEX_SPRINTF_MIN * 2; }
 
-#ifdef _WIN32
-#    include <io.h>
-#    include <sys/stat.h>
-#    include <windows.h>
-#elif cex$is_freestanding
-// does not support unistd.h
-#else
-#    include <sys/stat.h>
-#    include <unistd.h>
-#endif
+    return (sbuf_rope_c){
+        .allocator = allocator,
+        .chunk_size = chunk_size,
+        .err = (allocator == NULL) ? Error.argument : EOK,
+    };
+}
 
-/// Opens new file: io.fopen(&file, "file.txt", "r+")
-Exception
-cex_io_fopen(FILE** file, char* filename, char* mode)
+/// Append string to the rope
+static Exc
+cex_sbuf__rope__append(sbuf_rope_c* self, char* s)
 {
-    if (file == NULL) {
-        uassert(file != NULL);
+    uassert(self != NULL);
+    if (unlikely(self->err)) { return self->err; }
+    if (unlikely(s == NULL)) {
+        self->err = Error.argument;
         return Error.argument;
     }
+    return _sbuf__rope_write(self, s, strlen(s));
+}
 
-    *file = NULL;
+struct _sbuf__rope_sprintf_ctx
+{
+    sbuf_rope_c* rope;
+    char tmp[CEX_SPRINTF_MIN];
+};
 
-    if (filename == NULL) { return Error.argument; }
-    if (mode == NULL) {
-        uassert(mode != NULL);
-        return Error.argument;
+static char*
+_cex_sbuf__rope_sprintf_callback(char* buf, void* user, u32 len)
+{
+    struct _sbuf__rope_sprintf_ctx* ctx = (struct _sbuf__rope_sprintf_ctx*)user;
+    sbuf_rope_c* rope = ctx->rope;
+    if (unlikely(rope->err != EOK)) { return NULL; }
+
+    sbuf_rope_chunk_s* c = rope->last;
+    if (len > 0) {
+        if (c != NULL && buf == c->data + c->length) {
+            // engine has written directly into the chunk
+            uassert(c->length + len <= c->capacity && "out of bounds");
+            c->length += len;
+            rope->length += len;
+        } else if (_sbuf__rope_write(rope, buf, len)) {
+            return NULL;
+        }
+        c = rope->last;
     }
 
-    *file = fopen(filename, mode);
-    if (*file == NULL) {
+    if (c == NULL || c->length == c->capacity) {
+        c = _sbuf__rope_new_chunk(rope, rope->chunk_size);
+        if (unlikely(c == NULL)) { return NULL; }
+    }
+    return ((c->capacity - c->length) >= CEX_SPRINTF_MIN) ? c->data + c->length : ctx->tmp;
+}
+
+/// Append format va to the rope (using CEX formatting engine)
+static Exc
+cex_sbuf__rope__appendfva(sbuf_rope_c* self, char* format, va_list va)
+{
+    uassert(self != NULL);
+    if (unlikely(self->err)) { return self->err; }
+    if (unlikely(format == NULL)) {
+        self->err = Error.argument;
+        return Error.argument;
+    }
+
+    struct _sbuf__rope_sprintf_ctx ctx = { .rope = self };
+    char* buf = _cex_sbuf__rope_sprintf_callback(NULL, &ctx, 0);
+    if (unlikely(buf == NULL)) { return self->err; }
+
+    cexsp__vsprintfcb(_cex_sbuf__rope_sprintf_callback, &ctx, buf, format, va);
+
+    if (self->last) { self->last->data[self->last->length] = '\0'; }
+    return self->err;
+}
+
+/// Append format to the rope (using CEX formatting engine)
+static Exc
+cex_sbuf__rope__appendf(sbuf_rope_c* self, char* format, ...)
+{
+    va_list va;
+    va_start(va, format);
+    Exc result = cex_sbuf__rope__appendfva(self, format, va);
+    va_end(va);
+    return result;
+}
+
+/// Returns total rope length (64-bit)
+static u64
+cex_sbuf__rope__len(sbuf_rope_c* self)
+{
+    uassert(self != NULL);
+    if (unlikely(self->err)) { return 0; }
+    return self->length;
+}
+
+/// Writes all rope chunks into the stream, without making contiguous copy
+static Exception
+cex_sbuf__rope__fwrite(sbuf_rope_c* self, FILE* stream)
+{
+    uassert(self != NULL);
+    if (unlikely(self->err)) { return self->err; }
+    if (unlikely(stream == NULL)) { return Error.argument; }
+
+    for (sbuf_rope_chunk_s* c = self->first; c != NULL; c = c->next) {
+        if (c->length == 0) { continue; }
+        if (fwrite(c->data, sizeof(char), c->length, stream) != c->length) { return Error.io; }
+    }
+    return EOK;
+}
+
+/// Iterates over rope chunks as slices: for$iter (str_s, it, sbuf.rope.iter(&r, &it.iterator))
+static str_s
+cex_sbuf__rope__iter(sbuf_rope_c* self, cex_iterator_s* iterator)
+{
+    uassert(self != NULL);
+    uassert(iterator != NULL && "null iterator");
+
+    struct iter_ctx
+    {
+        sbuf_rope_chunk_s* chunk;
+    }* ctx = (struct iter_ctx*)iterator->_ctx;
+    static_assert(sizeof(*ctx) <= sizeof(iterator->_ctx), "ctx size overflow");
+
+    if (unlikely(!iterator->initialized)) {
+        iterator->initialized = 1;
+        ctx->chunk = (self->err) ? NULL : self->first;
+        iterator->idx.i = 0;
+    } else {
+        ctx->chunk = ctx->chunk->next;
+        iterator->idx.i++;
+    }
+    if (ctx->chunk == NULL) {
+        iterator->stopped = 1;
+        return (str_s){ 0 };
+    }
+    return (str_s){ .buf = ctx->chunk->data, .len = ctx->chunk->length };
+}
+
+/// Returns contiguous null-terminated rope contents, rope is merged into a single chunk (only once,
+/// until next append). Returns NULL on error.
+static char*
+cex_sbuf__rope__flatten(sbuf_rope_c* self)
+{
+    uassert(self != NULL);
+    if (unlikely(self->err)) { return NULL; }
+
+    if (self->first == NULL) {
+        if (_sbuf__rope_new_chunk(self, self->chunk_size) == NULL) { return NULL; }
+    }
+    if (self->first == self->last) { return self->first->data; }
+
+    if (unlikely(self->length >= PTRDIFF_MAX)) {
+        self->err = Error.overflow;
+        return NULL;
+    }
+    usize len = self->length;
+    sbuf_rope_chunk_s* first = self->first;
+    sbuf_rope_chunk_s* last = self->last;
+    self->first = self->last = NULL;
+    sbuf_rope_chunk_s* flat = _sbuf__rope_new_chunk(self, len);
+    if (unlikely(flat == NULL)) {
+        // keep existing data valid
+        self->first = first;
+        self->last = last;
+        return NULL;
+    }
+
+    char* d = flat->data;
+    sbuf_rope_chunk_s* c = first;
+    while (c != NULL) {
+        memcpy(d, c->data, c->length);
+        d += c->length;
+        sbuf_rope_chunk_s* next = c->next;
+        mem$free(self->allocator, c);
+        c = next;
+    }
+    flat->length = len;
+    flat->data[len] = '\0';
+    self->first = self->last = flat;
+
+    return flat->data;
+}
+
+/// Clears rope contents, keeps first chunk allocated
+static void
+cex_sbuf__rope__clear(sbuf_rope_c* self)
+{
+    uassert(self != NULL);
+    if (unlikely(self->err)) { return; }
+    if (self->first == NULL) { return; }
+
+    sbuf_rope_chunk_s* c = self->first->next;
+    while (c != NULL) {
+        sbuf_rope_chunk_s* next = c->next;
+        mem$free(self->allocator, c);
+        c = next;
+    }
+    self->first->next = NULL;
+    self->first->length = 0;
+    self->first->data[0] = '\0';
+    self->last = self->first;
+    self->length = 0;
+}
+
+/// Destroys the rope and deallocates all chunks
+static void
+cex_sbuf__rope__destroy(sbuf_rope_c* self)
+{
+    uassert(self != NULL);
+    sbuf_rope_chunk_s* c = self->first;
+    while (c != NULL) {
+        sbuf_rope_chunk_s* next = c->next;
+        mem$free(self->allocator, c);
+        c = next;
+    }
+    *self = (sbuf_rope_c){ 0 };
+}
+
+/// Validate rope state, returns sticky error of the last failed operation
+static Exception
+cex_sbuf__rope__validate(sbuf_rope_c* self)
+{
+    if (unlikely(self == NULL)) { return "NULL argument"; }
+    if (unlikely(self->err)) { return self->err; }
+    if (unlikely(self->allocator == NULL)) { return "Not initialized or destroyed"; }
+    if (unlikely(self->first == NULL && self->length != 0)) { return "Bad length"; }
+    return EOK;
+}
+
+const struct __cex_namespace__sbuf sbuf = {
+    // Autogenerated by CEX
+    // clang-format off
+
+    .append = cex_sbuf_append,
+    .appendf = cex_sbuf_appendf,
+    .appendfva = cex_sbuf_appendfva,
+    .capacity = cex_sbuf_capacity,
+    .clear = cex_sbuf_clear,
+    .create = cex_sbuf_create,
+    .create_static = cex_sbuf_create_static,
+    .destroy = cex_sbuf_destroy,
+    .isvalid = cex_sbuf_isvalid,
+    .len = cex_sbuf_len,
+    .shrink = cex_sbuf_shrink,
+    .validate = cex_sbuf_validate,
+
+    .rope = {
+        .append = cex_sbuf__rope__append,
+        .appendf = cex_sbuf__rope__appendf,
+        .appendfva = cex_sbuf__rope__appendfva,
+        .clear = cex_sbuf__rope__clear,
+        .create = cex_sbuf__rope__create,
+        .destroy = cex_sbuf__rope__destroy,
+        .flatten = cex_sbuf__rope__flatten,
+        .fwrite = cex_sbuf__rope__fwrite,
+        .iter = cex_sbuf__rope__iter,
+        .len = cex_sbuf__rope__len,
+        .validate = cex_sbuf__rope__validate,
+    },
+
+    // clang-format on
+};
+#endif
+
+
+
+/*
+*                          src/io.c
+*/
+#if !defined(cex$enable_minimal) || defined(cex$enable_io)
+#include <errno.h>
+#include <stdio.h>
+
+#ifdef _WIN32
+#    include <io.h>
+#    include <sys/stat.h>
+#    include <windows.h>
+#elif cex$is_freestanding
+// does not support unistd.h
+#else
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <sys/uio.h>
+#    include <unistd.h>
+#endif
+
+#if defined(__linux__) && !cex$is_freestanding && defined(__has_include)
+#    if __has_include(<linux/io_uring.h>)
+#        include <linux/io_uring.h>
+#        include <sys/syscall.h>
+// NOTE: 5.1-5.5 uapi headers lack IORING_OP_OPENAT/open_flags (no macro for op enums, but
+// IORING_FEAT_RW_CUR_POS comes with them in 5.6), synchronous/threads backend is used there
+#        if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter) &&                       \
+            defined(IORING_FEAT_RW_CUR_POS)
+#            define _CEX_IO_HAS_URING 1
+#        endif
+#    endif
+#endif
+
+/// Opens new file: io.fopen(&file, "file.txt", "r+")
+Exception
+cex_io_fopen(FILE** file, char* filename, char* mode)
+{
+    if (file == NULL) {
+        uassert(file != NULL);
+        return Error.argument;
+    }
+
+    *file = NULL;
+
+    if (filename == NULL) { return Error.argument; }
+    if (mode == NULL) {
+        uassert(mode != NULL);
+        return Error.argument;
+    }
+
+    *file = fopen(filename, mode);
+    if (*file == NULL) {
         switch (errno) {
             case ENOENT:
                 return Error.not_found;
@@ -12157,90 +13883,1375 @@ end:
     return out_content.buf;
 }
 
-/// Reads line from file, allocates result. Returns NULL on error.
-char*
-cex_io__file__readln(FILE* file, IAllocator allc)
+/// Creates buffered line reader for a file, buf_size=0 uses CEX_IO_LINES_BUF. Nothing is allocated
+/// until the first line read.
+io_lines_c
+cex_io__lines__create(FILE* file, usize buf_size, IAllocator allocator)
 {
-    errno = 0;
-    uassert(allc != NULL);
-    if (file == NULL) {
-        errno = EINVAL;
-        return NULL;
-    }
-
-    str_s out_content = (str_s){ 0 };
-    Exc err = cex_io_fread_line(file, &out_content, allc);
-    if (err) {
-        if (err == Error.eof) { return NULL; }
-        if (out_content.buf) { mem$free(allc, out_content.buf); }
-        return NULL;
-    }
-    return out_content.buf;
+    uassert(allocator != NULL);
+    io_lines_c self = {
+        .file = file,
+        .buf_size = (buf_size > 0) ? buf_size : CEX_IO_LINES_BUF,
+        .allocator = allocator,
+    };
+    if (unlikely(file == NULL)) { self.err = Error.argument; }
+    return self;
 }
 
-const struct __cex_namespace__io io = {
-    // Autogenerated by CEX
-    // clang-format off
-
-    .fclose = cex_io_fclose,
-    .fflush = cex_io_fflush,
-    .fopen = cex_io_fopen,
-    .fprintf = cex_io_fprintf,
-    .fread = cex_io_fread,
-    .fread_all = cex_io_fread_all,
-    .fread_line = cex_io_fread_line,
-    .fseek = cex_io_fseek,
-    .ftell = cex_io_ftell,
-    .fwrite = cex_io_fwrite,
-    .isatty = cex_io_isatty,
-    .printf = cex_io_printf,
-    .rewind = cex_io_rewind,
-
-    .file = {
-        .load = cex_io__file__load,
-        .readln = cex_io__file__readln,
-        .save = cex_io__file__save,
-        .size = cex_io__file__size,
-        .writeln = cex_io__file__writeln,
-    },
-
-    // clang-format on
-};
-
-#endif
-
-
+/// Destroys line reader buffer (file is not closed)
+void
+cex_io__lines__destroy(io_lines_c* self)
+{
+    uassert(self != NULL);
+    if (self->buf != NULL) { mem$free(self->allocator, self->buf); }
+    *self = (io_lines_c){ 0 };
+}
 
-/*
-*                          src/argparse.c
-*/
-#if !defined(cex$enable_minimal) || defined(cex$enable_os)
-#include <math.h>
+// Moves unread tail to the beginning of buffer (grows it if the line is longer) and reads more
+static Exception
+_cex_io__lines_refill(io_lines_c* self)
+{
+    if (self->buf == NULL) {
+        self->buf = mem$malloc(self->allocator, self->buf_size);
+        if (self->buf == NULL) { return Error.memory; }
+    }
+    usize tail_len = self->end - self->start;
+    if (self->start > 0) {
+        if (tail_len > 0) { memmove(self->buf, self->buf + self->start, tail_len); }
+        self->scan -= self->start;
+        self->start = 0;
+        self->end = tail_len;
+    }
+    if (self->end == self->buf_size) {
+        // the line doesn't fit, grow the buffer
+        if (unlikely(self->buf_size > PTRDIFF_MAX / 2)) { return Error.overflow; }
+        char* new_buf = mem$realloc(self->allocator, self->buf, self->buf_size * 2);
+        if (new_buf == NULL) { return Error.memory; }
+        self->buf = new_buf;
+        self->buf_size *= 2;
+    }
+
+    usize nread = fread(self->buf + self->end, 1, self->buf_size - self->end, self->file);
+    if (nread == 0) {
+        if (ferror(self->file)) { return Error.io; }
+        self->eof = true;
+    }
+    self->end += nread;
+    return EOK;
+}
 
-static char*
-_cex_argparse__prefix_skip(char* str, char* prefix)
+/// Reads next line into `line` slice (valid until the next call), returns Error.eof at the end.
+/// `\r\n` line endings are stripped, line length is not limited by the buffer size.
+Exception
+cex_io__lines__next(io_lines_c* self, str_s* line)
 {
-    usize len = strlen(prefix);
-    return strncmp(str, prefix, len) ? NULL : str + len;
+    uassert(self != NULL);
+    uassert(line != NULL);
+    *line = (str_s){ 0 };
+    if (unlikely(self->err)) { return self->err; }
+
+    while (true) {
+        if (self->scan < self->end) {
+            char* nl = memchr(self->buf + self->scan, '\n', self->end - self->scan);
+            if (nl != NULL) {
+                usize line_end = nl - self->buf;
+                usize len = line_end - self->start;
+                if (len > 0 && self->buf[line_end - 1] == '\r') { len--; }
+                *line = (str_s){ .buf = self->buf + self->start, .len = len };
+                self->start = self->scan = line_end + 1;
+                self->n_lines++;
+                return EOK;
+            }
+            self->scan = self->end;
+        }
+        if (self->eof) {
+            if (self->start == self->end) { return Error.eof; }
+            // last line without trailing newline
+            usize len = self->end - self->start;
+            if (self->buf[self->end - 1] == '\r') { len--; }
+            *line = (str_s){ .buf = self->buf + self->start, .len = len };
+            self->start = self->scan = self->end;
+            self->n_lines++;
+            return EOK;
+        }
+        e$except_silent (err, _cex_io__lines_refill(self)) {
+            self->err = err;
+            return err;
+        }
+    }
 }
 
-static Exception
-_cex_argparse__error(argparse_c* self, argparse_opt_s* opt, char* reason, bool is_long)
+/// Iterates over file lines: for$iter (str_s, it, io.lines.iter(&lr, &it.iterator)), it.val is
+/// valid until the next iteration. Check io.lines.validate() after the loop for errors.
+str_s
+cex_io__lines__iter(io_lines_c* self, cex_iterator_s* iterator)
 {
-    (void)self;
-    if (is_long) {
-        cexsp__fprintf(stdout, "error: option `--%s` %s\n", opt->long_name, reason);
+    uassert(self != NULL);
+    uassert(iterator != NULL && "null iterator");
+
+    if (unlikely(!iterator->initialized)) {
+        iterator->initialized = 1;
+        iterator->idx.i = 0;
     } else {
-        cexsp__fprintf(stdout, "error: option `-%c` %s\n", opt->short_name, reason);
+        iterator->idx.i++;
     }
-
-    return Error.argument;
+    str_s line;
+    if (cex_io__lines__next(self, &line) != EOK) {
+        iterator->stopped = 1;
+        return (str_s){ 0 };
+    }
+    return line;
 }
 
-static void
-cex_argparse_usage(argparse_c* self)
+/// Returns sticky error of the line reader, EOK if there was no error (end of file is not an error)
+Exception
+cex_io__lines__validate(io_lines_c* self)
 {
-    uassert(self->argv != NULL && "usage before parse!");
+    uassert(self != NULL);
+    return self->err;
+}
+
+static Exception
+_cex_io__file__mmap_fallback(char* path, io_mmap_s* out)
+{
+    FILE* file;
+    e$except_silent (err, cex_io_fopen(&file, path, "rb")) { return err; }
+    str_s content = { 0 };
+    Exc err = cex_io_fread_all(file, &content, mem$);
+    cex_io_fclose(&file);
+    if (err) { return err; }
+    if (content.buf) {
+        out->data = content;
+        out->_is_copy = true;
+    }
+    return EOK;
+}
+
+/// Maps full file contents into memory (read-only, or private copy-on-write with flags.is_private),
+/// flags can be NULL. Falls back to reading the file into mem$ buffer where mmap is not available.
+/// Result must be released by io.file.munmap().
+Exception
+cex_io__file__mmap(char* path, io_mmap_s* out, io_mmap_flags_s* flags)
+{
+    uassert(out != NULL);
+    *out = (io_mmap_s){ .data = { .buf = "", .len = 0 } };
+    if (path == NULL) { return Error.argument; }
+    io_mmap_flags_s f = (flags) ? *flags : (io_mmap_flags_s){ 0 };
+
+#if defined(_WIN32)
+    DWORD fattr = FILE_ATTRIBUTE_NORMAL | ((f.sequential) ? FILE_FLAG_SEQUENTIAL_SCAN : 0);
+    HANDLE fh = CreateFileA(
+        path,
+        GENERIC_READ,
+        FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+        NULL,
+        OPEN_EXISTING,
+        fattr,
+        NULL
+    );
+    if (fh == INVALID_HANDLE_VALUE) {
+        switch (GetLastError()) {
+            case ERROR_FILE_NOT_FOUND:
+            case ERROR_PATH_NOT_FOUND:
+                return Error.not_found;
+            case ERROR_ACCESS_DENIED:
+                return Error.permission;
+            default:
+                return Error.io;
+        }
+    }
+    LARGE_INTEGER fsize = { 0 };
+    if (!GetFileSizeEx(fh, &fsize)) {
+        CloseHandle(fh);
+        return Error.io;
+    }
+    if (fsize.QuadPart == 0) {
+        CloseHandle(fh);
+        return EOK;
+    }
+    if ((u64)fsize.QuadPart > (u64)SIZE_MAX) {
+        CloseHandle(fh);
+        return Error.overflow;
+    }
+    HANDLE mh = CreateFileMappingA(fh, NULL, (f.is_private) ? PAGE_WRITECOPY : PAGE_READONLY, 0, 0, NULL);
+    void* addr = NULL;
+    if (mh != NULL) {
+        addr = MapViewOfFile(mh, (f.is_private) ? FILE_MAP_COPY : FILE_MAP_READ, 0, 0, 0);
+        CloseHandle(mh); // view keeps mapping alive
+    }
+    CloseHandle(fh);
+    if (addr == NULL) {
+        if (f.no_fallback) { return Error.io; }
+        return _cex_io__file__mmap_fallback(path, out);
+    }
+    if (f.willneed) {
+        WIN32_MEMORY_RANGE_ENTRY range = { .VirtualAddress = addr, .NumberOfBytes = fsize.QuadPart };
+        PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+    }
+    out->_addr = addr;
+    out->_map_len = fsize.QuadPart;
+    out->data = (str_s){ .buf = addr, .len = fsize.QuadPart };
+    return EOK;
+
+#elif cex$is_freestanding
+    if (f.no_fallback) { return Error.os; }
+    return _cex_io__file__mmap_fallback(path, out);
+
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        switch (errno) {
+            case ENOENT:
+                return Error.not_found;
+            case EACCES:
+                return Error.permission;
+            default:
+                return strerror(errno);
+        }
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return strerror(errno);
+    }
+    if (S_ISDIR(st.st_mode)) {
+        close(fd);
+        return Error.argument;
+    }
+    if (!S_ISREG(st.st_mode) || st.st_size == 0) {
+        // pipes, devices, or procfs files (reported as zero size) can't be mapped, read them
+        close(fd);
+        if (f.no_fallback) { return (st.st_size == 0 && S_ISREG(st.st_mode)) ? EOK : Error.os; }
+        return _cex_io__file__mmap_fallback(path, out);
+    }
+    if ((u64)st.st_size > (u64)SIZE_MAX) {
+        close(fd);
+        return Error.overflow;
+    }
+    usize map_len = st.st_size;
+    void* addr = mmap(
+        NULL,
+        map_len,
+        (f.is_private) ? (PROT_READ | PROT_WRITE) : PROT_READ,
+        (f.is_private) ? MAP_PRIVATE : MAP_SHARED,
+        fd,
+        0
+    );
+    close(fd); // mapping keeps file reference
+    if (addr == MAP_FAILED) {
+        if (f.no_fallback) { return strerror(errno); }
+        return _cex_io__file__mmap_fallback(path, out);
+    }
+
+    // NOTE: hints are optional, errors are ignored
+#    if defined(MADV_SEQUENTIAL)
+    if (f.sequential) { (void)madvise(addr, map_len, MADV_SEQUENTIAL); }
+#    endif
+#    if defined(MADV_WILLNEED)
+    if (f.willneed) { (void)madvise(addr, map_len, MADV_WILLNEED); }
+#    endif
+#    if defined(MADV_HUGEPAGE)
+    if (f.hugepage) { (void)madvise(addr, map_len, MADV_HUGEPAGE); }
+#    endif
+
+    out->_addr = addr;
+    out->_map_len = map_len;
+    out->data = (str_s){ .buf = addr, .len = map_len };
+    return EOK;
+#endif
+}
+
+/// Releases memory mapped file, created by io.file.mmap() (safe to call multiple times)
+void
+cex_io__file__munmap(io_mmap_s* m)
+{
+    uassert(m != NULL);
+    if (m->_is_copy) {
+        mem$free(mem$, m->data.buf);
+    } else if (m->_addr != NULL) {
+#if defined(_WIN32)
+        UnmapViewOfFile(m->_addr);
+#elif !cex$is_freestanding
+        munmap(m->_addr, m->_map_len);
+#endif
+    }
+    *m = (io_mmap_s){ .data = { .buf = "", .len = 0 } };
+}
+
+/// Reads line from file, allocates result. Returns NULL on error.
+char*
+cex_io__file__readln(FILE* file, IAllocator allc)
+{
+    errno = 0;
+    uassert(allc != NULL);
+    if (file == NULL) {
+        errno = EINVAL;
+        return NULL;
+    }
+
+    str_s out_content = (str_s){ 0 };
+    Exc err = cex_io_fread_line(file, &out_content, allc);
+    if (err) {
+        if (err == Error.eof) { return NULL; }
+        if (out_content.buf) { mem$free(allc, out_content.buf); }
+        return NULL;
+    }
+    return out_content.buf;
+}
+
+/*
+ *                  IO ASYNC
+ */
+typedef struct _cex_io_async_slot_s
+{
+    u64 tag;
+    u64 offset;
+    void* buf;
+    usize len;
+    char* path; // owned copy (open only)
+    isize result;
+    Exc err;
+    int fd;
+    int flags;
+    i32 buf_idx; // index of registered pool buffer, or -1
+    IOAsyncOp_e op;
+} _cex_io_async_slot_s;
+
+typedef struct _cex_io_async_s
+{
+    IAllocator allc;
+    u32 qd; // power of 2
+    _cex_io_async_slot_s* slots;
+    u32* free_slots;
+    u32 n_free_slots;
+    u32* staged; // queued, but not submitted yet
+    u32 n_staged;
+
+    char* pool;
+    u32 n_buffers;
+    u32 buf_size;
+    u32* free_bufs;
+    u32 n_free_bufs;
+
+    // portable backend: work queue and completion queue rings (slot indexes)
+    u32* work;
+    u32 work_head;
+    u32 work_tail;
+    u32* done;
+    u32 done_head;
+    u32 done_tail;
+    u32 n_threads;
+    bool shutdown;
+#if defined(CEX_HAS_THREADS)
+    _cex_thread_t* threads;
+#    ifdef _WIN32
+    SRWLOCK lock;
+    CONDITION_VARIABLE cond_work;
+    CONDITION_VARIABLE cond_done;
+#    else
+    pthread_mutex_t lock;
+    pthread_cond_t cond_work;
+    pthread_cond_t cond_done;
+#    endif
+#endif
+
+#if defined(_CEX_IO_HAS_URING)
+    int ring_fd;
+    bool is_uring;
+    bool bufs_registered;
+    void* ring;
+    usize ring_size;
+    struct io_uring_sqe* sqes;
+    usize sqes_size;
+    u32* sq_head;
+    u32* sq_tail;
+    u32* sq_mask;
+    u32* sq_array;
+    u32* cq_head;
+    u32* cq_tail;
+    u32* cq_mask;
+    struct io_uring_cqe* cqes;
+#endif
+} _cex_io_async_s;
+
+static Exc
+_cex_io__errno(int err)
+{
+    switch (err) {
+        case ENOENT:
+            return Error.not_found;
+        case EPERM:
+        case EACCES:
+            return Error.permission;
+        case EEXIST:
+            return Error.exists;
+        case EIO:
+            return Error.io;
+        case EAGAIN:
+            return Error.try_again;
+        case EBADF:
+        case EINVAL:
+            return Error.argument;
+        default:
+            return strerror(err);
+    }
+}
+
+// Executes slot operation synchronously (portable backend)
+static void
+_cex_io__async_exec(_cex_io_async_slot_s* slot)
+{
+    isize res = -1;
+    errno = 0;
+#if defined(_WIN32)
+    switch (slot->op) {
+        case IOAsyncOp__open:
+            res = _open(slot->path, slot->flags | _O_BINARY, _S_IREAD | _S_IWRITE);
+            break;
+        case IOAsyncOp__read:
+        case IOAsyncOp__write: {
+            HANDLE fh = (HANDLE)_get_osfhandle(slot->fd);
+            if (fh == INVALID_HANDLE_VALUE) {
+                errno = EBADF;
+                break;
+            }
+            DWORD nbytes = 0;
+            DWORD len = (slot->len > UINT32_MAX) ? UINT32_MAX : (DWORD)slot->len;
+            OVERLAPPED ov = { .Offset = (DWORD)slot->offset,
+                              .OffsetHigh = (DWORD)(slot->offset >> 32) };
+            OVERLAPPED* pov = (slot->offset == (u64)-1) ? NULL : &ov;
+            BOOL ok = (slot->op == IOAsyncOp__read)
+                        ? ReadFile(fh, slot->buf, len, &nbytes, pov)
+                        : WriteFile(fh, slot->buf, len, &nbytes, pov);
+            if (ok || GetLastError() == ERROR_HANDLE_EOF) {
+                res = nbytes;
+            } else {
+                errno = EIO;
+            }
+            break;
+        }
+        case IOAsyncOp__fsync:
+            res = _commit(slot->fd);
+            break;
+        case IOAsyncOp__close:
+            res = _close(slot->fd);
+            break;
+        default:
+            res = 0;
+            break;
+    }
+#elif cex$is_freestanding
+    errno = ENOSYS;
+#else
+    switch (slot->op) {
+        case IOAsyncOp__open:
+            res = open(slot->path, slot->flags, 0644);
+            break;
+        case IOAsyncOp__read:
+            res = (slot->offset == (u64)-1) ? read(slot->fd, slot->buf, slot->len)
+                                            : pread(slot->fd, slot->buf, slot->len, slot->offset);
+            break;
+        case IOAsyncOp__write:
+            res = (slot->offset == (u64)-1) ? write(slot->fd, slot->buf, slot->len)
+                                            : pwrite(slot->fd, slot->buf, slot->len, slot->offset);
+            break;
+        case IOAsyncOp__fsync:
+            res = fsync(slot->fd);
+            break;
+        case IOAsyncOp__close:
+            res = close(slot->fd);
+            break;
+        default:
+            res = 0;
+            break;
+    }
+#endif
+    if (res < 0) {
+        slot->result = -1;
+        slot->err = _cex_io__errno(errno ? errno : EIO);
+    } else {
+        slot->result = res;
+        slot->err = EOK;
+    }
+}
+
+#if defined(CEX_HAS_THREADS)
+#    ifdef _WIN32
+#        define _cex_io__async_lock(a) AcquireSRWLockExclusive(&(a)->lock)
+#        define _cex_io__async_unlock(a) ReleaseSRWLockExclusive(&(a)->lock)
+#        define _cex_io__async_cond_wait(a, cond) SleepConditionVariableSRW(&(a)->cond, &(a)->lock, INFINITE, 0)
+#        define _cex_io__async_cond_signal(a, cond) WakeConditionVariable(&(a)->cond)
+#        define _cex_io__async_cond_broadcast(a, cond) WakeAllConditionVariable(&(a)->cond)
+#    else
+#        define _cex_io__async_lock(a) pthread_mutex_lock(&(a)->lock)
+#        define _cex_io__async_unlock(a) pthread_mutex_unlock(&(a)->lock)
+#        define _cex_io__async_cond_wait(a, cond) pthread_cond_wait(&(a)->cond, &(a)->lock)
+#        define _cex_io__async_cond_signal(a, cond) pthread_cond_signal(&(a)->cond)
+#        define _cex_io__async_cond_broadcast(a, cond) pthread_cond_broadcast(&(a)->cond)
+#    endif
+
+static void
+_cex_io__async_worker_loop(_cex_io_async_s* a)
+{
+    _cex_io__async_lock(a);
+    while (true) {
+        while (a->work_head == a->work_tail && !a->shutdown) {
+            _cex_io__async_cond_wait(a, cond_work);
+        }
+        if (a->work_head == a->work_tail) { break; } // shutdown
+        u32 idx = a->work[a->work_head++ & (a->qd - 1)];
+        _cex_io__async_unlock(a);
+
+        _cex_io__async_exec(&a->slots[idx]);
+
+        _cex_io__async_lock(a);
+        a->done[a->done_tail++ & (a->qd - 1)] = idx;
+        _cex_io__async_cond_signal(a, cond_done);
+    }
+    _cex_io__async_unlock(a);
+}
+
+static _cex_thread_fn(_cex_io__async_worker, arg)
+{
+    _cex_io__async_worker_loop(arg);
+    return 0;
+}
+#endif
+
+#if defined(_CEX_IO_HAS_URING)
+static bool
+_cex_io__async_uring_init(_cex_io_async_s* a)
+{
+    struct io_uring_params p = { 0 };
+    int fd = syscall(__NR_io_uring_setup, a->qd, &p);
+    if (fd < 0) { return false; }
+    // NOTE: IORING_FEAT_RW_CUR_POS (5.6) also implies OPENAT/CLOSE/READ/WRITE opcodes
+    if (!(p.features & IORING_FEAT_SINGLE_MMAP) || !(p.features & IORING_FEAT_RW_CUR_POS)) {
+        close(fd);
+        return false;
+    }
+
+    usize sq_size = p.sq_off.array + p.sq_entries * sizeof(u32);
+    usize cq_size = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+    a->ring_size = (sq_size > cq_size) ? sq_size : cq_size;
+    a->ring = mmap(
+        NULL,
+        a->ring_size,
+        PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_POPULATE,
+        fd,
+        IORING_OFF_SQ_RING
+    );
+    if (a->ring == MAP_FAILED) {
+        close(fd);
+        return false;
+    }
+    a->sqes_size = p.sq_entries * sizeof(struct io_uring_sqe);
+    a->sqes = mmap(
+        NULL,
+        a->sqes_size,
+        PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_POPULATE,
+        fd,
+        IORING_OFF_SQES
+    );
+    if (a->sqes == MAP_FAILED) {
+        munmap(a->ring, a->ring_size);
+        close(fd);
+        return false;
+    }
+
+    char* r = a->ring;
+    a->sq_head = (u32*)(r + p.sq_off.head);
+    a->sq_tail = (u32*)(r + p.sq_off.tail);
+    a->sq_mask = (u32*)(r + p.sq_off.ring_mask);
+    a->sq_array = (u32*)(r + p.sq_off.array);
+    a->cq_head = (u32*)(r + p.cq_off.head);
+    a->cq_tail = (u32*)(r + p.cq_off.tail);
+    a->cq_mask = (u32*)(r + p.cq_off.ring_mask);
+    a->cqes = (struct io_uring_cqe*)(r + p.cq_off.cqes);
+    a->ring_fd = fd;
+    a->is_uring = true;
+
+    if (a->n_buffers > 0) {
+        // NOTE: may fail because of RLIMIT_MEMLOCK, then regular read/write are used
+        struct iovec* iov = mem$calloc(a->allc, a->n_buffers, sizeof(struct iovec));
+        if (iov != NULL) {
+            for (u32 i = 0; i < a->n_buffers; i++) {
+                iov[i] = (struct iovec){ .iov_base = a->pool + (usize)i * a->buf_size,
+                                         .iov_len = a->buf_size };
+            }
+            a->bufs_registered = syscall(
+                                     __NR_io_uring_register,
+                                     fd,
+                                     IORING_REGISTER_BUFFERS,
+                                     iov,
+                                     a->n_buffers
+                                 ) == 0;
+            mem$free(a->allc, iov);
+        }
+    }
+    return true;
+}
+
+static Exception
+_cex_io__async_uring_submit(io_async_c* self)
+{
+    _cex_io_async_s* a = self->_impl;
+    u32 tail = *a->sq_tail;
+    u32 mask = *a->sq_mask;
+    for (u32 i = 0; i < a->n_staged; i++) {
+        _cex_io_async_slot_s* slot = &a->slots[a->staged[i]];
+        struct io_uring_sqe* sqe = &a->sqes[tail & mask];
+        memset(sqe, 0, sizeof(*sqe));
+        sqe->user_data = a->staged[i];
+        sqe->fd = slot->fd;
+        switch (slot->op) {
+            case IOAsyncOp__open:
+                sqe->opcode = IORING_OP_OPENAT;
+                sqe->fd = AT_FDCWD;
+                sqe->addr = (u64)(usize)slot->path;
+                sqe->len = 0644;
+                sqe->open_flags = slot->flags;
+                break;
+            case IOAsyncOp__read:
+            case IOAsyncOp__write: {
+                bool is_fixed = a->bufs_registered && slot->buf_idx >= 0;
+                if (slot->op == IOAsyncOp__read) {
+                    sqe->opcode = (is_fixed) ? IORING_OP_READ_FIXED : IORING_OP_READ;
+                } else {
+                    sqe->opcode = (is_fixed) ? IORING_OP_WRITE_FIXED : IORING_OP_WRITE;
+                }
+                if (is_fixed) { sqe->buf_index = slot->buf_idx; }
+                sqe->addr = (u64)(usize)slot->buf;
+                sqe->len = (slot->len > UINT32_MAX) ? UINT32_MAX : slot->len;
+                sqe->off = slot->offset;
+                break;
+            }
+            case IOAsyncOp__fsync:
+                sqe->opcode = IORING_OP_FSYNC;
+                break;
+            case IOAsyncOp__close:
+                sqe->opcode = IORING_OP_CLOSE;
+                break;
+            default:
+                sqe->opcode = IORING_OP_NOP;
+                break;
+        }
+        a->sq_array[tail & mask] = tail & mask;
+        tail++;
+    }
+    __atomic_store_n(a->sq_tail, tail, __ATOMIC_RELEASE);
+
+    u32 n_staged = a->n_staged;
+    u32 to_submit = n_staged;
+    a->n_staged = 0;
+    while (to_submit > 0) {
+        int ret = syscall(__NR_io_uring_enter, a->ring_fd, to_submit, 0, 0, NULL, 0);
+        if (ret < 0) {
+            if (errno == EINTR || errno == EAGAIN || errno == EBUSY) { continue; }
+            Exc err = _cex_io__errno(errno);
+            // Kernel didn't consume the rest of SQEs, taking them back, otherwise they are
+            // counted in n_pending and never complete (io.async.destroy() would wait forever)
+            __atomic_store_n(a->sq_tail, tail - to_submit, __ATOMIC_RELEASE);
+            for (u32 i = n_staged - to_submit; i < n_staged; i++) {
+                _cex_io_async_slot_s* slot = &a->slots[a->staged[i]];
+                if (slot->path) {
+                    mem$free(a->allc, slot->path);
+                    slot->path = NULL;
+                }
+                a->free_slots[a->n_free_slots++] = a->staged[i];
+            }
+            self->n_pending -= to_submit;
+            return err;
+        }
+        to_submit -= ret;
+    }
+    return EOK;
+}
+
+static u32
+_cex_io__async_uring_reap(_cex_io_async_s* a, u32* out_idx, u32 max_n)
+{
+    u32 head = *a->cq_head;
+    u32 tail = __atomic_load_n(a->cq_tail, __ATOMIC_ACQUIRE);
+    u32 mask = *a->cq_mask;
+    u32 n = 0;
+    while (head != tail && n < max_n) {
+        struct io_uring_cqe* cqe = &a->cqes[head & mask];
+        _cex_io_async_slot_s* slot = &a->slots[cqe->user_data];
+        if (cqe->res < 0) {
+            slot->result = -1;
+            slot->err = _cex_io__errno(-cqe->res);
+        } else {
+            slot->result = cqe->res;
+            slot->err = EOK;
+        }
+        out_idx[n++] = cqe->user_data;
+        head++;
+    }
+    __atomic_store_n(a->cq_head, head, __ATOMIC_RELEASE);
+    return n;
+}
+#endif
+
+void cex_io__async__destroy(io_async_c* self);
+Exception cex_io__async__wait(
+    io_async_c* self,
+    io_async_cqe_s* cqes,
+    u32 max_cqes,
+    u32 min_complete,
+    u32* n_done
+);
+
+/// Creates async IO engine, opts can be NULL (defaults). Uses io_uring on Linux when available,
+/// otherwise portable worker threads backend. Must be released by io.async.destroy().
+Exception
+cex_io__async__create(io_async_c* self, io_async_opts_s* opts, IAllocator allc)
+{
+    uassert(self != NULL);
+    uassert(allc != NULL);
+    *self = (io_async_c){ 0 };
+    io_async_opts_s o = (opts) ? *opts : (io_async_opts_s){ 0 };
+    if (o.queue_depth == 0) { o.queue_depth = 64; }
+    if (o.n_threads == 0) { o.n_threads = 4; }
+    if (o.buf_size == 0) { o.buf_size = CEX_IO_LINES_BUF; }
+    if (o.queue_depth > 4096) { return Error.argument; }
+
+    u32 qd = 1;
+    while (qd < o.queue_depth) { qd <<= 1; }
+    if (o.n_threads > qd) { o.n_threads = qd; }
+
+    _cex_io_async_s* a = mem$new(allc, _cex_io_async_s);
+    if (a == NULL) { return Error.memory; }
+    a->allc = allc;
+    a->qd = qd;
+    a->slots = mem$calloc(allc, qd, sizeof(*a->slots));
+    a->free_slots = mem$calloc(allc, qd, sizeof(u32));
+    a->staged = mem$calloc(allc, qd, sizeof(u32));
+    a->work = mem$calloc(allc, qd, sizeof(u32));
+    a->done = mem$calloc(allc, qd, sizeof(u32));
+    self->_impl = a;
+    if (!a->slots || !a->free_slots || !a->staged || !a->work || !a->done) { goto fail_memory; }
+    for (u32 i = 0; i < qd; i++) { a->free_slots[i] = qd - 1 - i; }
+    a->n_free_slots = qd;
+
+    if (o.n_buffers > 0) {
+        if ((usize)o.n_buffers * o.buf_size > PTRDIFF_MAX) { goto fail_memory; }
+        a->pool = mem$malloc(allc, (usize)o.n_buffers * o.buf_size, 64);
+        a->free_bufs = mem$calloc(allc, o.n_buffers, sizeof(u32));
+        if (!a->pool || !a->free_bufs) { goto fail_memory; }
+        a->n_buffers = o.n_buffers;
+        a->buf_size = o.buf_size;
+        for (u32 i = 0; i < o.n_buffers; i++) { a->free_bufs[i] = o.n_buffers - 1 - i; }
+        a->n_free_bufs = o.n_buffers;
+    }
+
+    self->queue_depth = qd;
+    self->backend = "sync";
+
+#if defined(_CEX_IO_HAS_URING)
+    if (!o.no_uring && _cex_io__async_uring_init(a)) {
+        self->backend = "io_uring";
+        return EOK;
+    }
+#endif
+
+#if defined(CEX_HAS_THREADS)
+    if (!o.no_threads) {
+#    ifdef _WIN32
+        InitializeSRWLock(&a->lock);
+        InitializeConditionVariable(&a->cond_work);
+        InitializeConditionVariable(&a->cond_done);
+#    else
+        pthread_mutex_init(&a->lock, NULL);
+        pthread_cond_init(&a->cond_work, NULL);
+        pthread_cond_init(&a->cond_done, NULL);
+#    endif
+        a->threads = mem$calloc(allc, o.n_threads, sizeof(_cex_thread_t));
+        if (a->threads == NULL) { goto fail_memory; }
+        for (u32 i = 0; i < o.n_threads; i++) {
+            if (!_cex_thread_spawn(&a->threads[i], _cex_io__async_worker, a)) { break; }
+            a->n_threads++;
+        }
+        if (a->n_threads > 0) { self->backend = "threads"; }
+    }
+#endif
+    return EOK;
+
+fail_memory:
+    cex_io__async__destroy(self);
+    return Error.memory;
+}
+
+/// Destroys async IO engine, waits for completion of all pending operations (results are discarded)
+void
+cex_io__async__destroy(io_async_c* self)
+{
+    uassert(self != NULL);
+    _cex_io_async_s* a = self->_impl;
+    if (a == NULL) { return; }
+    IAllocator allc = a->allc;
+
+    if (a->slots != NULL) {
+        io_async_cqe_s cqes[16];
+        while (self->n_pending > 0) {
+            u32 n_done = 0;
+            if (cex_io__async__wait(self, cqes, arr$len(cqes), 1, &n_done)) { break; }
+        }
+    }
+
+#if defined(CEX_HAS_THREADS)
+    if (a->n_threads > 0) {
+        _cex_io__async_lock(a);
+        a->shutdown = true;
+        _cex_io__async_cond_broadcast(a, cond_work);
+        _cex_io__async_unlock(a);
+        for (u32 i = 0; i < a->n_threads; i++) { _cex_thread_join(a->threads[i]); }
+#    ifndef _WIN32
+        pthread_mutex_destroy(&a->lock);
+        pthread_cond_destroy(&a->cond_work);
+        pthread_cond_destroy(&a->cond_done);
+#    endif
+    }
+    if (a->threads) { mem$free(allc, a->threads); }
+#endif
+
+#if defined(_CEX_IO_HAS_URING)
+    if (a->is_uring) {
+        munmap(a->sqes, a->sqes_size);
+        munmap(a->ring, a->ring_size);
+        close(a->ring_fd); // also unregisters buffers
+    }
+#endif
+    if (a->slots) {
+        for (u32 i = 0; i < a->qd; i++) {
+            if (a->slots[i].path) { mem$free(allc, a->slots[i].path); }
+        }
+        mem$free(allc, a->slots);
+    }
+    if (a->free_slots) { mem$free(allc, a->free_slots); }
+    if (a->staged) { mem$free(allc, a->staged); }
+    if (a->work) { mem$free(allc, a->work); }
+    if (a->done) { mem$free(allc, a->done); }
+    if (a->pool) { mem$free(allc, a->pool); }
+    if (a->free_bufs) { mem$free(allc, a->free_bufs); }
+    mem$free(allc, a);
+    *self = (io_async_c){ 0 };
+}
+
+// Reserves operation slot and queues it (until io.async.submit())
+static _cex_io_async_slot_s*
+_cex_io__async_queue(io_async_c* self, IOAsyncOp_e op, int fd, u64 tag)
+{
+    _cex_io_async_s* a = self->_impl;
+    if (a->n_free_slots == 0) { return NULL; }
+    u32 idx = a->free_slots[--a->n_free_slots];
+    _cex_io_async_slot_s* slot = &a->slots[idx];
+    *slot = (_cex_io_async_slot_s){ .tag = tag, .op = op, .fd = fd, .buf_idx = -1 };
+    a->staged[a->n_staged++] = idx;
+    self->n_pending++;
+    return slot;
+}
+
+/// Queues file opening, `mode` is fopen() like ("r", "r+", "w", "w+", "a", "a+", "x" suffix for
+/// exclusive creation), completion result is file descriptor. Returns Error.try_again if queue is full.
+Exception
+cex_io__async__open(io_async_c* self, char* path, char* mode, u64 tag)
+{
+    uassert(self != NULL && self->_impl != NULL);
+    if (path == NULL || mode == NULL) { return Error.argument; }
+
+    int flags = 0;
+    switch (mode[0]) {
+        case 'r':
+            flags = O_RDONLY;
+            break;
+        case 'w':
+            flags = O_WRONLY | O_CREAT | O_TRUNC;
+            break;
+        case 'a':
+            flags = O_WRONLY | O_CREAT | O_APPEND;
+            break;
+        default:
+            return Error.argument;
+    }
+    for (char* c = mode + 1; *c; c++) {
+        switch (*c) {
+            case '+':
+                flags = (flags & ~(O_RDONLY | O_WRONLY)) | O_RDWR;
+                break;
+            case 'x':
+                flags |= O_EXCL;
+                break;
+            case 'b':
+                break;
+            default:
+                return Error.argument;
+        }
+    }
+#ifdef O_CLOEXEC
+    flags |= O_CLOEXEC;
+#endif
+
+    _cex_io_async_s* a = self->_impl;
+    usize path_len = strlen(path);
+    char* path_copy = mem$malloc(a->allc, path_len + 1);
+    if (path_copy == NULL) { return Error.memory; }
+    memcpy(path_copy, path, path_len + 1);
+
+    _cex_io_async_slot_s* slot = _cex_io__async_queue(self, IOAsyncOp__open, -1, tag);
+    if (slot == NULL) {
+        mem$free(a->allc, path_copy);
+        return Error.try_again;
+    }
+    slot->path = path_copy;
+    slot->flags = flags;
+    return EOK;
+}
+
+static Exception
+_cex_io__async_rw(io_async_c* self, IOAsyncOp_e op, int fd, void* buf, usize len, u64 offset, u64 tag)
+{
+    uassert(self != NULL && self->_impl != NULL);
+    if (fd < 0 || buf == NULL) { return Error.argument; }
+    if (len > UINT32_MAX) { return Error.overflow; }
+
+    _cex_io_async_s* a = self->_impl;
+    _cex_io_async_slot_s* slot = _cex_io__async_queue(self, op, fd, tag);
+    if (slot == NULL) { return Error.try_again; }
+    slot->buf = buf;
+    slot->len = len;
+    slot->offset = offset;
+    if (a->pool && (char*)buf >= a->pool &&
+        (char*)buf + len <= a->pool + (usize)a->n_buffers * a->buf_size) {
+        usize buf_idx = ((char*)buf - a->pool) / a->buf_size;
+        // registered buffer requires whole range to be within single pool buffer
+        if ((char*)buf + len <= a->pool + (buf_idx + 1) * a->buf_size) { slot->buf_idx = buf_idx; }
+    }
+    return EOK;
+}
+
+/// Queues reading of up to `len` bytes at file `offset` ((u64)-1 - current file position) into
+/// `buf`, completion result is number of bytes read (0 - EOF).
+Exception
+cex_io__async__read(io_async_c* self, int fd, void* buf, usize len, u64 offset, u64 tag)
+{
+    return _cex_io__async_rw(self, IOAsyncOp__read, fd, buf, len, offset, tag);
+}
+
+/// Queues writing of `len` bytes from `buf` at file `offset` ((u64)-1 - current file position),
+/// completion result is number of bytes written. `buf` must be valid until completion.
+Exception
+cex_io__async__write(io_async_c* self, int fd, void* buf, usize len, u64 offset, u64 tag)
+{
+    return _cex_io__async_rw(self, IOAsyncOp__write, fd, buf, len, offset, tag);
+}
+
+/// Queues flushing of file data to the storage device
+Exception
+cex_io__async__fsync(io_async_c* self, int fd, u64 tag)
+{
+    uassert(self != NULL && self->_impl != NULL);
+    if (fd < 0) { return Error.argument; }
+    if (_cex_io__async_queue(self, IOAsyncOp__fsync, fd, tag) == NULL) { return Error.try_again; }
+    return EOK;
+}
+
+/// Queues closing of file descriptor
+Exception
+cex_io__async__close(io_async_c* self, int fd, u64 tag)
+{
+    uassert(self != NULL && self->_impl != NULL);
+    if (fd < 0) { return Error.argument; }
+    if (_cex_io__async_queue(self, IOAsyncOp__close, fd, tag) == NULL) { return Error.try_again; }
+    return EOK;
+}
+
+/// Submits all queued operations for execution as a single batch (on error, operations which
+/// were not accepted by the kernel are dropped, and not counted in n_pending)
+Exception
+cex_io__async__submit(io_async_c* self)
+{
+    uassert(self != NULL && self->_impl != NULL);
+    _cex_io_async_s* a = self->_impl;
+    if (a->n_staged == 0) { return EOK; }
+
+#if defined(_CEX_IO_HAS_URING)
+    if (a->is_uring) { return _cex_io__async_uring_submit(self); }
+#endif
+#if defined(CEX_HAS_THREADS)
+    if (a->n_threads > 0) {
+        _cex_io__async_lock(a);
+        for (u32 i = 0; i < a->n_staged; i++) { a->work[a->work_tail++ & (a->qd - 1)] = a->staged[i]; }
+        _cex_io__async_cond_broadcast(a, cond_work);
+        _cex_io__async_unlock(a);
+        a->n_staged = 0;
+        return EOK;
+    }
+#endif
+    for (u32 i = 0; i < a->n_staged; i++) {
+        _cex_io__async_exec(&a->slots[a->staged[i]]);
+        a->done[a->done_tail++ & (a->qd - 1)] = a->staged[i];
+    }
+    a->n_staged = 0;
+    return EOK;
+}
+
+/// Submits queued operations, and waits until at least `min_complete` operations are completed
+/// (0 - just polls), returns up to `max_cqes` completions into `cqes`, count is set in `n_done`.
+Exception
+cex_io__async__wait(
+    io_async_c* self,
+    io_async_cqe_s* cqes,
+    u32 max_cqes,
+    u32 min_complete,
+    u32* n_done
+)
+{
+    uassert(self != NULL && self->_impl != NULL);
+    uassert(n_done != NULL);
+    *n_done = 0;
+    if (cqes == NULL || max_cqes == 0) { return Error.argument; }
+    e$ret(cex_io__async__submit(self));
+
+    _cex_io_async_s* a = self->_impl;
+    if (min_complete > self->n_pending) { min_complete = self->n_pending; }
+    if (min_complete > max_cqes) { min_complete = max_cqes; }
+    if (max_cqes > a->qd) { max_cqes = a->qd; }
+    u32* indexes = a->staged; // NOTE: nothing is staged after submit, reusing as temp
+    u32 n = 0;
+
+#if defined(_CEX_IO_HAS_URING)
+    if (a->is_uring) {
+        n = _cex_io__async_uring_reap(a, indexes, max_cqes);
+        while (n < min_complete) {
+            int ret = syscall(
+                __NR_io_uring_enter,
+                a->ring_fd,
+                0,
+                min_complete - n,
+                IORING_ENTER_GETEVENTS,
+                NULL,
+                0
+            );
+            if (ret < 0 && errno != EINTR) {
+                // completions reaped so far are lost otherwise, keep them
+                if (n > 0) { break; }
+                return _cex_io__errno(errno);
+            }
+            n += _cex_io__async_uring_reap(a, indexes + n, max_cqes - n);
+        }
+    } else
+#endif
+    {
+#if defined(CEX_HAS_THREADS)
+        if (a->n_threads > 0) { _cex_io__async_lock(a); }
+        while (a->n_threads > 0 && a->done_tail - a->done_head < min_complete) {
+            _cex_io__async_cond_wait(a, cond_done);
+        }
+#endif
+        while (a->done_head != a->done_tail && n < max_cqes) {
+            indexes[n++] = a->done[a->done_head++ & (a->qd - 1)];
+        }
+#if defined(CEX_HAS_THREADS)
+        if (a->n_threads > 0) { _cex_io__async_unlock(a); }
+#endif
+    }
+
+    for (u32 i = 0; i < n; i++) {
+        _cex_io_async_slot_s* slot = &a->slots[indexes[i]];
+        cqes[i] = (io_async_cqe_s){
+            .tag = slot->tag,
+            .result = slot->result,
+            .err = slot->err,
+            .buf = slot->buf,
+            .op = slot->op,
+        };
+        if (slot->path) { mem$free(a->allc, slot->path); }
+        a->free_slots[a->n_free_slots++] = indexes[i];
+    }
+    self->n_pending -= n;
+    *n_done = n;
+    return EOK;
+}
+
+/// Returns free buffer from the pool (opts.buf_size bytes), NULL if pool is empty or exhausted
+void*
+cex_io__async__buf_get(io_async_c* self)
+{
+    uassert(self != NULL && self->_impl != NULL);
+    _cex_io_async_s* a = self->_impl;
+    if (a->n_free_bufs == 0) { return NULL; }
+    u32 idx = a->free_bufs[--a->n_free_bufs];
+    return a->pool + (usize)idx * a->buf_size;
+}
+
+/// Returns buffer back to the pool
+void
+cex_io__async__buf_put(io_async_c* self, void* buf)
+{
+    uassert(self != NULL && self->_impl != NULL);
+    _cex_io_async_s* a = self->_impl;
+    if (buf == NULL) { return; }
+    uassert((char*)buf >= a->pool && "buffer is not from the pool");
+    usize idx = ((char*)buf - a->pool) / a->buf_size;
+    uassert(idx < a->n_buffers && "buffer is not from the pool");
+    uassert(a->n_free_bufs < a->n_buffers && "double buf_put()?");
+    a->free_bufs[a->n_free_bufs++] = idx;
+}
+
+/// Writes all `bufs` into file descriptor `fd` (gathered by writev() if supported), partial writes
+/// are retried until everything is written. Empty buffers are skipped.
+Exception
+cex_io_writev(int fd, str_s* bufs, usize n_bufs)
+{
+    if (fd < 0) { return Error.argument; }
+    if (bufs == NULL && n_bufs > 0) { return Error.argument; }
+
+#if defined(_WIN32)
+    for (usize i = 0; i < n_bufs; i++) {
+        char* p = bufs[i].buf;
+        usize left = bufs[i].len;
+        while (left > 0) {
+            unsigned int chunk = (left > INT32_MAX) ? INT32_MAX : (unsigned int)left;
+            int n = _write(fd, p, chunk);
+            if (n < 0) { return _cex_io__errno(errno); }
+            p += n;
+            left -= n;
+        }
+    }
+    return EOK;
+#elif cex$is_freestanding
+    (void)bufs;
+    (void)n_bufs;
+    return Error.os;
+#else
+    struct iovec iov[64];
+    usize idx = 0;    // current buffer
+    usize offset = 0; // written bytes of bufs[idx]
+    while (true) {
+        while (idx < n_bufs && bufs[idx].len == offset) {
+            idx++;
+            offset = 0;
+        }
+        if (idx >= n_bufs) { break; }
+
+        u32 n_iov = 0;
+        for (usize i = idx; i < n_bufs && n_iov < arr$len(iov); i++) {
+            usize skip = (i == idx) ? offset : 0;
+            if (bufs[i].len == skip) { continue; }
+            if (unlikely(bufs[i].buf == NULL)) { return Error.argument; }
+            iov[n_iov++] = (struct iovec){ .iov_base = bufs[i].buf + skip,
+                                           .iov_len = bufs[i].len - skip };
+        }
+        isize n = writev(fd, iov, n_iov);
+        if (n < 0) {
+            if (errno == EINTR) { continue; }
+            return _cex_io__errno(errno);
+        }
+        // advance over written bytes
+        usize written = n;
+        while (written > 0) {
+            usize left = bufs[idx].len - offset;
+            if (written < left) {
+                offset += written;
+                break;
+            }
+            written -= left;
+            idx++;
+            offset = 0;
+        }
+    }
+    return EOK;
+#endif
+}
+
+/// Atomically replaces file at `path` with concatenation of `parts` (binary mode). Data is written
+/// into temp file in the same directory and then renamed over `path`, readers never see partial
+/// contents. is_durable=true also syncs data (and directory) to the storage device before return.
+Exception
+cex_io__file__save_atomic(char* path, str_s* parts, usize n_parts, bool is_durable)
+{
+    if (path == NULL || path[0] == '\0') { return Error.argument; }
+    if (parts == NULL && n_parts > 0) { return Error.argument; }
+
+#if cex$is_freestanding
+    (void)is_durable;
+    return Error.os;
+#else
+    static u32 counter = 0;
+    usize path_len = strlen(path);
+    char tmp_path[PATH_MAX]; // no mem$, it's called from worker threads
+    if (path_len + 32 > sizeof(tmp_path)) { return Error.overflow; }
+
+    Exc result = EOK;
+    int fd = -1;
+#    if defined(_WIN32)
+    u32 pid = GetCurrentProcessId();
+#    else
+    u32 pid = getpid();
+#    endif
+    for (u32 attempt = 0; attempt < 16; attempt++) {
+        u32 n = __atomic_fetch_add(&counter, 1, __ATOMIC_RELAXED);
+        memcpy(tmp_path, path, path_len);
+        if (cexsp__snprintf(tmp_path + path_len, 32, ".%x.%x.tmp", pid, n) <= 0) {
+            result = Error.overflow;
+            goto end;
+        }
+#    if defined(_WIN32)
+        fd = _open(tmp_path, _O_CREAT | _O_EXCL | _O_WRONLY | _O_BINARY, _S_IREAD | _S_IWRITE);
+#    else
+        fd = open(tmp_path, O_CREAT | O_EXCL | O_WRONLY | O_CLOEXEC, 0666);
+#    endif
+        if (fd >= 0 || errno != EEXIST) { break; }
+    }
+    if (fd < 0) {
+        result = _cex_io__errno(errno);
+        goto end;
+    }
+
+#    if !defined(_WIN32)
+    // replaced file keeps its permissions
+    struct stat st;
+    if (stat(path, &st) == 0) { (void)fchmod(fd, st.st_mode & 07777); }
+#    endif
+
+    e$except_silent (err, cex_io_writev(fd, parts, n_parts)) { result = err; }
+
+    if (!result && is_durable) {
+#    if defined(_WIN32)
+        if (_commit(fd) != 0) { result = _cex_io__errno(errno); }
+#    elif defined(__APPLE__)
+        if (fcntl(fd, F_FULLFSYNC) != 0 && fsync(fd) != 0) { result = _cex_io__errno(errno); }
+#    else
+        if (fdatasync(fd) != 0) { result = _cex_io__errno(errno); }
+#    endif
+    }
+#    if defined(_WIN32)
+    if (_close(fd) != 0 && !result) { result = _cex_io__errno(errno); }
+    if (!result) {
+        DWORD flags = MOVEFILE_REPLACE_EXISTING | ((is_durable) ? MOVEFILE_WRITE_THROUGH : 0);
+        if (!MoveFileExA(tmp_path, path, flags)) { result = Error.io; }
+    }
+    if (result) { _unlink(tmp_path); }
+#    else
+    if (close(fd) != 0 && !result) { result = _cex_io__errno(errno); }
+    if (!result && rename(tmp_path, path) != 0) { result = _cex_io__errno(errno); }
+    if (result) {
+        (void)unlink(tmp_path);
+    } else if (is_durable) {
+        // makes rename itself durable
+        char* dir_end = strrchr(path, '/');
+        if (dir_end == path) {
+            memcpy(tmp_path, "/", 2);
+        } else if (dir_end == NULL) {
+            memcpy(tmp_path, ".", 2);
+        } else {
+            memcpy(tmp_path, path, dir_end - path);
+            tmp_path[dir_end - path] = '\0';
+        }
+        int dir_fd = open(tmp_path, O_RDONLY | O_CLOEXEC);
+        if (dir_fd >= 0) {
+            if (fsync(dir_fd) != 0 && errno != EINVAL) { result = _cex_io__errno(errno); }
+            close(dir_fd);
+        }
+    }
+#    endif
+
+end:
+    return result;
+#endif
+}
+
+const struct __cex_namespace__io io = {
+    // Autogenerated by CEX
+    // clang-format off
+
+    .fclose = cex_io_fclose,
+    .fflush = cex_io_fflush,
+    .fopen = cex_io_fopen,
+    .fprintf = cex_io_fprintf,
+    .fread = cex_io_fread,
+    .fread_all = cex_io_fread_all,
+    .fread_line = cex_io_fread_line,
+    .fseek = cex_io_fseek,
+    .ftell = cex_io_ftell,
+    .fwrite = cex_io_fwrite,
+    .isatty = cex_io_isatty,
+    .printf = cex_io_printf,
+    .rewind = cex_io_rewind,
+    .writev = cex_io_writev,
+
+    .async = {
+        .buf_get = cex_io__async__buf_get,
+        .buf_put = cex_io__async__buf_put,
+        .close = cex_io__async__close,
+        .create = cex_io__async__create,
+        .destroy = cex_io__async__destroy,
+        .fsync = cex_io__async__fsync,
+        .open = cex_io__async__open,
+        .read = cex_io__async__read,
+        .submit = cex_io__async__submit,
+        .wait = cex_io__async__wait,
+        .write = cex_io__async__write,
+    },
+
+    .file = {
+        .load = cex_io__file__load,
+        .mmap = cex_io__file__mmap,
+        .munmap = cex_io__file__munmap,
+        .readln = cex_io__file__readln,
+        .save = cex_io__file__save,
+        .save_atomic = cex_io__file__save_atomic,
+        .size = cex_io__file__size,
+        .writeln = cex_io__file__writeln,
+    },
+
+    .lines = {
+        .create = cex_io__lines__create,
+        .destroy = cex_io__lines__destroy,
+        .iter = cex_io__lines__iter,
+        .next = cex_io__lines__next,
+        .validate = cex_io__lines__validate,
+    },
+
+    // clang-format on
+};
+#endif
+
+
+
+/*
+*                          src/argparse.c
+*/
+#if !defined(cex$enable_minimal) || defined(cex$enable_os)
+#include <math.h>
+
+static char*
+_cex_argparse__prefix_skip(char* str, char* prefix)
+{
+    usize len = strlen(prefix);
+    return strncmp(str, prefix, len) ? NULL : str + len;
+}
+
+static Exception
+_cex_argparse__error(argparse_c* self, argparse_opt_s* opt, char* reason, bool is_long)
+{
+    (void)self;
+    if (is_long) {
+        cexsp__fprintf(stdout, "error: option `--%s` %s\n", opt->long_name, reason);
+    } else {
+        cexsp__fprintf(stdout, "error: option `-%c` %s\n", opt->short_name, reason);
+    }
+
+    return Error.argument;
+}
+
+static void
+cex_argparse_usage(argparse_c* self)
+{
+    uassert(self->argv != NULL && "usage before parse!");
 
     io.printf("Usage:\n");
     if (self->usage) {
@@ -13661,6 +16672,18 @@ int subprocess_alive(struct subprocess_s *const process) {
 
 #ifndef _WIN32
 #    include <dirent.h>
+#    include <poll.h>
+#    include <signal.h>
+#    include <spawn.h>
+extern char** environ;
+#    if defined(__linux__)
+#        include <sys/ioctl.h>
+#        include <sys/sendfile.h>
+#        include <sys/syscall.h>
+#        ifndef FICLONE
+#            define FICLONE _IOW(0x94, 9, int)
+#        endif
+#    endif
 #else // _WIN32
 // minirent.h HEADER BEGIN
 // Copyright 2021 Alexey Kutepov <reximkut@gmail.com>
@@ -14054,82 +17077,352 @@ cex_os__fs__remove(char* path)
 #endif
 }
 
-/// Iterates over directory (can be recursive) using callback function
+typedef struct _os_fs_walk_s
+{
+    os_fs_dir_walk_f* dir_walk_fn;
+    os_fs_walk_f* walk_fn;
+    void* user_ctx;
+    bool is_recursive;
+    bool with_stat;
+} _os_fs_walk_s;
+
+// Returns entry type from dirent.d_type, and calls stat() only for symlinks, DT_UNKNOWN or with_stat
+static os_fs_stat_s
+_os__fs__dirent_stat(DIR* dp, struct dirent* ep, char* path, bool with_stat)
+{
+#if defined(_WIN32) || !defined(DT_UNKNOWN)
+    (void)dp;
+    (void)ep;
+    (void)with_stat;
+    return os.fs.stat(path);
+#else
+    (void)path;
+    os_fs_stat_s result = { .is_valid = true };
+    if (!with_stat) {
+        switch (ep->d_type) {
+            case DT_REG:
+                result.is_file = true;
+                return result;
+            case DT_DIR:
+                result.is_directory = true;
+                return result;
+            case DT_UNKNOWN: // some file systems don't support d_type
+            case DT_LNK:
+                break;
+            default:
+                result.is_other = true;
+                return result;
+        }
+    }
+
+    struct stat statbuf;
+    if (unlikely(fstatat(dirfd(dp), ep->d_name, &statbuf, AT_SYMLINK_NOFOLLOW) < 0)) {
+        return (os_fs_stat_s){ .error = os.get_last_error() };
+    }
+    if (S_ISLNK(statbuf.st_mode)) {
+        result.is_symlink = true;
+        if (unlikely(fstatat(dirfd(dp), ep->d_name, &statbuf, 0) < 0)) {
+            // dangling symlink, doesn't stop the walk
+            result.is_other = true;
+            return result;
+        }
+    }
+    if (S_ISREG(statbuf.st_mode)) {
+        result.is_file = true;
+    } else if (S_ISDIR(statbuf.st_mode)) {
+        result.is_directory = true;
+    } else {
+        result.is_other = true;
+    }
+    result.size = statbuf.st_size;
+    result.mtime = statbuf.st_mtime;
+    return result;
+#endif
+}
+
+// Opens sub-directory `name` of `parent` (relative to parent fd if supported), `path` is full path
+static DIR*
+_os__fs__opendir_at(DIR* parent, char* name, char* path)
+{
+#if defined(_WIN32) || !defined(O_DIRECTORY)
+    (void)parent;
+    (void)name;
+    return opendir(path);
+#else
+    (void)path;
+    int fd = openat(dirfd(parent), name, O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+    if (fd < 0) { return NULL; }
+    DIR* dp = fdopendir(fd);
+    if (dp == NULL) { close(fd); }
+    return dp;
+#endif
+}
+
+// Walks `dp` entries, `path_buf` (PATH_MAX) contains directory path of path_len, and shared between
+// all recursion levels. Sub-directories are visited before the callback of directory itself.
+static Exception
+_os__fs__walk_serial(_os_fs_walk_s* w, DIR* dp, char* path_buf, usize path_len)
+{
+    if (path_buf[path_len - 1] != '/' && path_buf[path_len - 1] != '\\') {
+        if (path_len >= PATH_MAX - 1) { return Error.overflow; }
+        path_buf[path_len++] = os$PATH_SEP;
+    }
+
+    struct dirent* ep;
+    while ((ep = readdir(dp)) != NULL) {
+        char* name = ep->d_name;
+        if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0'))) {
+            continue;
+        }
+        usize name_len = strlen(name);
+        if (unlikely(path_len + name_len >= PATH_MAX)) { return Error.overflow; }
+        memcpy(path_buf + path_len, name, name_len + 1);
+
+        os_fs_stat_s ftype = _os__fs__dirent_stat(dp, ep, path_buf, w->with_stat);
+        if (!ftype.is_valid) { return ftype.error; }
+
+        if (w->is_recursive && ftype.is_directory && !ftype.is_symlink) {
+            DIR* sub_dp = _os__fs__opendir_at(dp, name, path_buf);
+            if (unlikely(sub_dp == NULL)) { return os.get_last_error(); }
+            Exc err = _os__fs__walk_serial(w, sub_dp, path_buf, path_len + name_len);
+            (void)closedir(sub_dp);
+            if (err) { return err; }
+            path_buf[path_len + name_len] = '\0'; // recursion extended the path
+        }
+
+        // After recursive call make a callback on a directory itself
+        Exc err = (w->walk_fn) ? w->walk_fn(path_buf, ftype, 0, w->user_ctx)
+                               : w->dir_walk_fn(path_buf, ftype, w->user_ctx);
+        if (err) { return err; }
+    }
+    return EOK;
+}
+
+static Exception
+_os__fs__walk_root(_os_fs_walk_s* w, char* path)
+{
+    if (path == NULL || path[0] == '\0') { return Error.argument; }
+    usize path_len = strlen(path);
+    if (path_len > PATH_MAX - 2) { return Error.overflow; }
+
+    char path_buf[PATH_MAX];
+    memcpy(path_buf, path, path_len + 1);
+
+    DIR* dp = opendir(path);
+    if (unlikely(dp == NULL)) { return os.get_last_error(); }
+    Exc result = _os__fs__walk_serial(w, dp, path_buf, path_len);
+    (void)closedir(dp);
+    return result;
+}
+
+/// Iterates over directory (can be recursive) using callback function. Entry types are taken from
+/// the directory listing, ftype.size/ftype.mtime are not filled (see os.fs.walk() with_stat option)
 Exception
 cex_os__fs__dir_walk(char* path, bool is_recursive, os_fs_dir_walk_f callback_fn, void* user_ctx)
 {
-    (void)user_ctx;
-    if (path == NULL || path[0] == '\0') { return Error.argument; }
-    Exc result = Error.os;
     uassert(callback_fn != NULL && "you must provide callback_fn");
+    _os_fs_walk_s w = {
+        .dir_walk_fn = callback_fn,
+        .user_ctx = user_ctx,
+        .is_recursive = is_recursive,
+    };
+    return _os__fs__walk_root(&w, path);
+}
 
-    DIR* dp = opendir(path);
+#if defined(CEX_HAS_THREADS)
+typedef struct _os_fs_walk_parallel_s
+{
+    _os_fs_walk_s* w;
+    arr$(char*) dirs; // pending directories, guarded by lock
+    u32 n_busy;       // threads processing a directory
+    u32 next_thread_idx;
+    Exc err;
+#    ifdef _WIN32
+    SRWLOCK lock;
+    CONDITION_VARIABLE cond;
+#    else
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+#    endif
+} _os_fs_walk_parallel_s;
 
-    if (unlikely(dp == NULL)) {
-        result = os.get_last_error();
-        goto end;
-    }
+#    ifdef _WIN32
+#        define _os__fs__walk_lock(p) AcquireSRWLockExclusive(&(p)->lock)
+#        define _os__fs__walk_unlock(p) ReleaseSRWLockExclusive(&(p)->lock)
+#        define _os__fs__walk_wait(p) SleepConditionVariableSRW(&(p)->cond, &(p)->lock, INFINITE, 0)
+#        define _os__fs__walk_signal(p) WakeConditionVariable(&(p)->cond)
+#        define _os__fs__walk_broadcast(p) WakeAllConditionVariable(&(p)->cond)
+#    else
+#        define _os__fs__walk_lock(p) pthread_mutex_lock(&(p)->lock)
+#        define _os__fs__walk_unlock(p) pthread_mutex_unlock(&(p)->lock)
+#        define _os__fs__walk_wait(p) pthread_cond_wait(&(p)->cond, &(p)->lock)
+#        define _os__fs__walk_signal(p) pthread_cond_signal(&(p)->cond)
+#        define _os__fs__walk_broadcast(p) pthread_cond_broadcast(&(p)->cond)
+#    endif
 
-    u32 path_len = strlen(path);
-    if (path_len > PATH_MAX - 2) {
-        result = Error.overflow;
-        goto end;
+// Lists single directory, sub-directories are pushed into shared queue (callbacks are pre-order)
+static Exception
+_os__fs__walk_parallel_dir(_os_fs_walk_parallel_s* p, char* dir, u32 thread_idx)
+{
+    _os_fs_walk_s* w = p->w;
+    usize path_len = strlen(dir);
+    if (path_len > PATH_MAX - 2) { return Error.overflow; }
+    char path_buf[PATH_MAX];
+    memcpy(path_buf, dir, path_len + 1);
+    if (path_buf[path_len - 1] != '/' && path_buf[path_len - 1] != '\\') {
+        path_buf[path_len++] = os$PATH_SEP;
     }
 
-    char path_buf[PATH_MAX];
+    DIR* dp = opendir(dir);
+    if (unlikely(dp == NULL)) { return os.get_last_error(); }
 
+    Exc result = EOK;
     struct dirent* ep;
     while ((ep = readdir(dp)) != NULL) {
-        errno = 0;
-        if (str.eq(ep->d_name, ".")) { continue; }
-        if (str.eq(ep->d_name, "..")) { continue; }
-        memcpy(path_buf, path, path_len);
-        u32 path_offset = 0;
-        if (path_buf[path_len - 1] != '/' && path_buf[path_len - 1] != '\\') {
-            path_buf[path_len] = os$PATH_SEP;
-            path_offset = 1;
+        char* name = ep->d_name;
+        if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0'))) {
+            continue;
         }
-
-        e$except_silent (
-            err,
-            str.copy(
-                path_buf + path_len + path_offset,
-                ep->d_name,
-                sizeof(path_buf) - path_len - 1 - path_offset
-            )
-        ) {
-            result = err;
-            goto end;
+        usize name_len = strlen(name);
+        if (unlikely(path_len + name_len >= PATH_MAX)) {
+            result = Error.overflow;
+            break;
         }
+        memcpy(path_buf + path_len, name, name_len + 1);
 
-        auto ftype = os.fs.stat(path_buf);
+        os_fs_stat_s ftype = _os__fs__dirent_stat(dp, ep, path_buf, w->with_stat);
         if (!ftype.is_valid) {
             result = ftype.error;
-            goto end;
-        }
-
-        if (is_recursive && ftype.is_directory && !ftype.is_symlink) {
-            e$except_silent (
-                err,
-                cex_os__fs__dir_walk(path_buf, is_recursive, callback_fn, user_ctx)
-            ) {
-                result = err;
-                goto end;
-            }
+            break;
         }
-        // After recursive call make a callback on a directory itself
-        e$except_silent (err, callback_fn(path_buf, ftype, user_ctx)) {
+        e$except_silent (err, w->walk_fn(path_buf, ftype, thread_idx, w->user_ctx)) {
             result = err;
-            goto end;
+            break;
+        }
+        if (w->is_recursive && ftype.is_directory && !ftype.is_symlink) {
+            _os__fs__walk_lock(p);
+            // NOTE: allocations are made under lock, mem$ is not thread safe in CEX_TEST mode
+            char* sub_dir = str.clone(path_buf, mem$);
+            bool is_pushed = sub_dir != NULL && arr$grow_check(p->dirs, 1);
+            if (is_pushed) {
+                arr$push(p->dirs, sub_dir);
+                _os__fs__walk_signal(p);
+            } else if (sub_dir) {
+                mem$free(mem$, sub_dir);
+            }
+            bool is_failed = p->err != EOK; // other thread failed
+            _os__fs__walk_unlock(p);
+            if (!is_pushed) {
+                result = Error.memory;
+                break;
+            }
+            if (is_failed) { break; }
         }
     }
-
-    result = EOK;
-end:
-    if (dp != NULL) { (void)closedir(dp); }
+    (void)closedir(dp);
     return result;
 }
 
+static void
+_os__fs__walk_parallel_loop(_os_fs_walk_parallel_s* p)
+{
+    _os__fs__walk_lock(p);
+    u32 thread_idx = p->next_thread_idx++;
+    while (true) {
+        while (arr$len(p->dirs) == 0 && p->n_busy > 0 && p->err == EOK) { _os__fs__walk_wait(p); }
+        if (arr$len(p->dirs) == 0 || p->err != EOK) { break; }
+
+        char* dir = arr$pop(p->dirs);
+        p->n_busy++;
+        _os__fs__walk_unlock(p);
+
+        Exc err = _os__fs__walk_parallel_dir(p, dir, thread_idx);
+
+        _os__fs__walk_lock(p);
+        mem$free(mem$, dir);
+        p->n_busy--;
+        if (err && p->err == EOK) { p->err = err; }
+        if (p->err || (p->n_busy == 0 && arr$len(p->dirs) == 0)) { _os__fs__walk_broadcast(p); }
+    }
+    _os__fs__walk_broadcast(p);
+    _os__fs__walk_unlock(p);
+}
+
+static _cex_thread_fn(_os__fs__walk_parallel_worker, arg)
+{
+    _os__fs__walk_parallel_loop(arg);
+    // tmem$ is thread local, callbacks may use it, pages must be released before thread exit
+    _cex_allocator_temp_cleanup();
+    return 0;
+}
+#endif
+
+/// Walks directory entries, calling `callback_fn(path, ftype, thread_idx, user_ctx)`, opts can be
+/// NULL (non-recursive, single threaded). With n_threads != 1 callbacks are called from multiple
+/// threads (in arbitrary order, directory callback comes before its contents). Entry types are taken
+/// from the directory listing, set opts.with_stat for ftype.size/ftype.mtime.
+static Exception
+cex_os__fs__walk(char* path, os_fs_walk_opts_s* opts, os_fs_walk_f callback_fn, void* user_ctx)
+{
+    uassert(callback_fn != NULL && "you must provide callback_fn");
+    os_fs_walk_opts_s o = (opts) ? *opts : (os_fs_walk_opts_s){ .n_threads = 1 };
+    _os_fs_walk_s w = {
+        .walk_fn = callback_fn,
+        .user_ctx = user_ctx,
+        .is_recursive = o.is_recursive,
+        .with_stat = o.with_stat,
+    };
+    u32 n_threads = (o.n_threads > 0) ? o.n_threads : os.platform.cpu_count();
+
+#if defined(CEX_HAS_THREADS)
+    if (n_threads > 1 && o.is_recursive) {
+        if (path == NULL || path[0] == '\0') { return Error.argument; }
+        if (strlen(path) > PATH_MAX - 2) { return Error.overflow; }
+        os_fs_stat_s root = os.fs.stat(path);
+        if (!root.is_valid) { return root.error; }
+        if (!root.is_directory) { return Error.argument; }
+
+        _os_fs_walk_parallel_s p = { .w = &w, .dirs = arr$new(p.dirs, mem$) };
+        char* root_copy = str.clone(path, mem$);
+        if (p.dirs == NULL || root_copy == NULL) {
+            if (p.dirs) { arr$free(p.dirs); }
+            if (root_copy) { mem$free(mem$, root_copy); }
+            return Error.memory;
+        }
+        arr$push(p.dirs, root_copy);
+
+#    ifdef _WIN32
+        InitializeSRWLock(&p.lock);
+        InitializeConditionVariable(&p.cond);
+#    else
+        pthread_mutex_init(&p.lock, NULL);
+        pthread_cond_init(&p.cond, NULL);
+#    endif
+        u32 n_spawned = 0;
+        _cex_thread_t* threads = mem$calloc(mem$, n_threads, sizeof(_cex_thread_t));
+        for (u32 i = 1; threads && i < n_threads; i++) {
+            if (!_cex_thread_spawn(&threads[n_spawned], _os__fs__walk_parallel_worker, &p)) {
+                break;
+            }
+            n_spawned++;
+        }
+        // current thread is also a worker
+        _os__fs__walk_parallel_loop(&p);
+        for (u32 i = 0; i < n_spawned; i++) { _cex_thread_join(threads[i]); }
+#    ifndef _WIN32
+        pthread_mutex_destroy(&p.lock);
+        pthread_cond_destroy(&p.cond);
+#    endif
+        if (threads) { mem$free(mem$, threads); }
+        for$each (it, p.dirs) { mem$free(mem$, it); } // left after error
+        arr$free(p.dirs);
+        return p.err;
+    }
+#endif
+    (void)n_threads;
+    return _os__fs__walk_root(&w, path);
+}
+
 struct _os_fs_find_ctx_s
 {
     char* pattern;
@@ -14172,8 +17465,9 @@ struct _os_fs_copy_tree_ctx_s
 };
 
 static Exception
-_os__fs__copy_tree_walker(char* path, os_fs_stat_s ftype, void* user_ctx)
+_os__fs__copy_tree_walker(char* path, os_fs_stat_s ftype, u32 thread_idx, void* user_ctx)
 {
+    (void)thread_idx;
     struct _os_fs_copy_tree_ctx_s* ctx = user_ctx;
     mem$scope(tmem$, _)
     {
@@ -14183,7 +17477,7 @@ _os__fs__copy_tree_walker(char* path, os_fs_stat_s ftype, void* user_ctx)
         if (ftype.is_file) {
             e$ret(os.fs.mkpath(out_file));
             e$ret(os.fs.copy(path, out_file));
-        } else {
+        } else if (ftype.is_directory) {
             // Making empty directory if necessary
             char* out_dir = str.fmt(_, "%s/", out_file);
             e$ret(os.fs.mkpath(out_dir));
@@ -14193,10 +17487,8 @@ _os__fs__copy_tree_walker(char* path, os_fs_stat_s ftype, void* user_ctx)
     return EOK;
 }
 
-
-/// Copy directory recursively
 static Exception
-cex_os__fs__copy_tree(char* src_dir, char* dst_dir)
+_os__fs__copy_tree(char* src_dir, char* dst_dir, u32 n_threads)
 {
     if (src_dir == NULL || src_dir[0] == '\0') { return Error.argument; }
     os_fs_stat_s s = os.fs.stat(src_dir);
@@ -14212,13 +17504,29 @@ cex_os__fs__copy_tree(char* src_dir, char* dst_dir)
         .src_dir = str.sstr(src_dir),
         .dest_dir = str.sstr(dst_dir),
     };
-    e$except_silent (err, cex_os__fs__dir_walk(src_dir, true, _os__fs__copy_tree_walker, &ctx)) {
+    // NOTE: in parallel mode directory callback comes first, so its copy exists before the files
+    os_fs_walk_opts_s opts = { .n_threads = n_threads, .is_recursive = true };
+    e$except_silent (err, cex_os__fs__walk(src_dir, &opts, _os__fs__copy_tree_walker, &ctx)) {
         return err;
     }
 
     return EOK;
 }
 
+/// Copy directory recursively
+static Exception
+cex_os__fs__copy_tree(char* src_dir, char* dst_dir)
+{
+    return _os__fs__copy_tree(src_dir, dst_dir, 1);
+}
+
+/// Copy directory recursively using up to `n_threads` parallel file copies (0 - cpu count)
+static Exception
+cex_os__fs__copy_tree_parallel(char* src_dir, char* dst_dir, u32 n_threads)
+{
+    return _os__fs__copy_tree(src_dir, dst_dir, n_threads);
+}
+
 static Exception
 _os__fs__find_walker(char* path, os_fs_stat_s ftype, void* user_ctx)
 {
@@ -14349,7 +17657,105 @@ cex_os__fs__chdir(char* path)
 }
 
 
-/// Copy file
+#ifndef _WIN32
+// Copies [offset, offset+len) of src into the same offset of dst, using in-kernel copy if possible
+static Exception
+_os__fs__copy_range(int src_fd, int dst_fd, off_t offset, off_t len, char* buf, usize buf_size)
+{
+    off_t end = offset + len;
+#    if defined(__linux__) && defined(__NR_copy_file_range)
+    // NOTE: same filesystem copy, may also reflink or use server side copy (NFS)
+    while (offset < end) {
+        loff_t off_in = offset;
+        loff_t off_out = offset;
+        isize n = syscall(__NR_copy_file_range, src_fd, &off_in, dst_fd, &off_out, end - offset, 0);
+        if (n < 0) {
+            break; // not supported (e.g. cross-filesystem on old kernels), try next method
+        }
+        if (n == 0) { return EOK; } // src truncated
+        offset += n;
+    }
+    if (offset >= end) { return EOK; }
+
+    if (lseek(dst_fd, offset, SEEK_SET) == offset) {
+        while (offset < end) {
+            off_t off_in = offset;
+            isize n = sendfile(dst_fd, src_fd, &off_in, end - offset);
+            if (n <= 0) { break; }
+            offset += n;
+        }
+        if (offset >= end) { return EOK; }
+    }
+#    endif
+
+    while (offset < end) {
+        usize chunk = ((off_t)buf_size < end - offset) ? buf_size : (usize)(end - offset);
+        isize n = pread(src_fd, buf, chunk, offset);
+        if (n < 0) {
+            if (errno == EINTR) { continue; }
+            return os.get_last_error();
+        }
+        if (n == 0) { break; } // src truncated
+        char* wbuf = buf;
+        while (n > 0) {
+            isize m = pwrite(dst_fd, wbuf, n, offset);
+            if (m < 0) {
+                if (errno == EINTR) { continue; }
+                return os.get_last_error();
+            }
+            n -= m;
+            wbuf += m;
+            offset += m;
+        }
+    }
+    return EOK;
+}
+
+// Copies file contents: reflink if supported, otherwise data ranges (holes of sparse files are kept)
+static Exception
+_os__fs__copy_data(int src_fd, int dst_fd, struct stat* src_stat)
+{
+#    if defined(__linux__)
+    // copy-on-write clone (btrfs, xfs, bcachefs...), instant and doesn't use extra space
+    if (ioctl(dst_fd, FICLONE, src_fd) == 0) { return EOK; }
+#    endif
+
+    Exc result = EOK;
+    // NOTE: may run on os.fs.copy_tree_parallel() threads, no mem$ (not thread safe in CEX_TEST
+    // mode), and small enough for default thread stack sizes
+    char buf[32 * 1024];
+    off_t size = src_stat->st_size;
+    off_t offset = 0;
+    bool is_sparse = src_stat->st_blocks * 512 < size;
+    while (offset < size) {
+        off_t data_end = size;
+#    if defined(SEEK_DATA) && defined(SEEK_HOLE)
+        if (is_sparse) {
+            off_t data = lseek(src_fd, offset, SEEK_DATA);
+            off_t hole = (data >= 0) ? lseek(src_fd, data, SEEK_HOLE) : -1;
+            if (data < 0 && errno == ENXIO) {
+                break; // only hole till the end of file
+            } else if (data < 0 || hole < 0) {
+                is_sparse = false; // not supported by filesystem, copy all the rest
+            } else {
+                offset = data;
+                data_end = (hole < size) ? hole : size;
+            }
+        }
+#    endif
+        result = _os__fs__copy_range(src_fd, dst_fd, offset, data_end - offset, buf, sizeof(buf));
+        if (result != EOK) { break; }
+        offset = data_end;
+    }
+    if (result == EOK && is_sparse && ftruncate(dst_fd, size) < 0) {
+        result = os.get_last_error(); // trailing hole
+    }
+    return result;
+}
+#endif
+
+/// Copy file (uses copy-on-write clone or in-kernel copy when possible, keeps sparse file holes,
+/// permissions, and modification time)
 static Exception
 cex_os__fs__copy(char* src_path, char* dst_path)
 {
@@ -14366,12 +17772,9 @@ cex_os__fs__copy(char* src_path, char* dst_path)
 #else
     int src_fd = -1;
     int dst_fd = -1;
-    size_t buf_size = 32 * 1024;
-    char* buf = mem$malloc(mem$, buf_size);
-    if (buf == NULL) { return Error.memory; }
     Exc result = Error.runtime;
 
-    if ((src_fd = open(src_path, O_RDONLY)) == -1) {
+    if ((src_fd = open(src_path, O_RDONLY | O_CLOEXEC)) == -1) {
         result = os.get_last_error();
         goto defer;
     }
@@ -14382,34 +17785,28 @@ cex_os__fs__copy(char* src_path, char* dst_path)
         goto defer;
     }
 
-    dst_fd = open(dst_path, O_CREAT | O_TRUNC | O_WRONLY, src_stat.st_mode);
+    dst_fd = open(dst_path, O_CREAT | O_TRUNC | O_WRONLY | O_CLOEXEC, src_stat.st_mode);
     if (dst_fd < 0) {
         result = strerror(errno);
         goto defer;
     }
 
-    for (;;) {
-        ssize_t n = read(src_fd, buf, buf_size);
-        if (n == 0) { break; }
-        if (n < 0) {
-            result = os.get_last_error();
-            goto defer;
-        }
-        char* buf2 = buf;
-        while (n > 0) {
-            ssize_t m = write(dst_fd, buf2, n);
-            if (m < 0) {
-                result = os.get_last_error();
-                goto defer;
-            }
-            n -= m;
-            buf2 += m;
-        }
+    e$except_silent (err, _os__fs__copy_data(src_fd, dst_fd, &src_stat)) {
+        result = err;
+        goto defer;
     }
+
+    // NOTE: metadata is best effort (some filesystems don't support it)
+    (void)fchmod(dst_fd, src_stat.st_mode & 07777);
+#    if defined(__APPLE__)
+    struct timespec times[2] = { src_stat.st_atimespec, src_stat.st_mtimespec };
+#    else
+    struct timespec times[2] = { src_stat.st_atim, src_stat.st_mtim };
+#    endif
+    (void)futimens(dst_fd, times);
     result = EOK;
 
 defer:
-    mem$free(mem$, buf);
     if (src_fd >= 0) { close(src_fd); }
     if (dst_fd >= 0) { close(dst_fd); }
     return result;
@@ -14842,15 +18239,12 @@ cex_os__cmd__run(char** args, usize args_len, os_cmd_c* out_cmd)
 end:
     return result;
 #else
-    pid_t cpid = fork();
-    if (cpid < 0) { return e$raise(Error.os, "Could not fork child process: %s", strerror(errno)); }
-
-    if (cpid == 0) {
-        if (execvp(args[0], (char* const*)args) < 0) {
-            log$error("Could not exec child process: %s\n", strerror(errno));
-            exit(1);
-        }
-        uassert(false && "unreachable");
+    // NOTE: posix_spawn() avoids copying of parent address space (fork), glibc/musl use
+    // clone(CLONE_VM|CLONE_VFORK), which matters for big parent processes
+    pid_t cpid = 0;
+    int err = posix_spawnp(&cpid, args[0], NULL, NULL, args, environ);
+    if (err != 0) {
+        return e$raise(Error.os, "Could not spawn child process '%s': %s", args[0], strerror(err));
     }
 
     *out_cmd = (os_cmd_c){ ._is_subprocess = false,
@@ -14863,6 +18257,662 @@ end:
 #endif
 }
 
+struct _os_cmd_pool_slot_s
+{
+    u32 job_idx;
+    FILE* output; // temp file with combined stdout/stderr of the child
+#ifdef _WIN32
+    HANDLE process;
+#else
+    pid_t pid;
+#endif
+};
+
+/// Creates pool of concurrently running commands, opts can be NULL (cpu count jobs, fail fast,
+/// output printed per job). Job outputs are captured and printed as a whole on job completion,
+/// so parallel outputs never interleave.
+static Exception
+cex_os__cmd__pool_create(os_cmd_pool_c* self, os_cmd_pool_opts_s* opts, IAllocator allc)
+{
+    uassert(self != NULL);
+    uassert(allc != NULL);
+
+    *self = (os_cmd_pool_c){
+        .opts = (opts) ? *opts : (os_cmd_pool_opts_s){ 0 },
+        .allc = allc,
+    };
+    if (self->opts.n_jobs == 0) { self->opts.n_jobs = os.platform.cpu_count(); }
+#ifdef _WIN32
+    // WaitForMultipleObjects() limit
+    if (self->opts.n_jobs > MAXIMUM_WAIT_OBJECTS) { self->opts.n_jobs = MAXIMUM_WAIT_OBJECTS; }
+#endif
+
+    self->jobs = arr$new(self->jobs, allc);
+    self->_slots = mem$calloc(allc, self->opts.n_jobs, sizeof(struct _os_cmd_pool_slot_s));
+    if (self->jobs == NULL || self->_slots == NULL) {
+        if (self->jobs) { arr$free(self->jobs); }
+        return Error.memory;
+    }
+    return EOK;
+}
+
+static Exception
+_cex_os__cmd__pool_spawn(os_cmd_pool_c* self, u32 job_idx)
+{
+    char** args = self->jobs[job_idx].args;
+    struct _os_cmd_pool_slot_s* slot = &self->_slots[self->n_running];
+    *slot = (struct _os_cmd_pool_slot_s){ .job_idx = job_idx };
+
+    slot->output = tmpfile();
+    if (slot->output == NULL) { return os.get_last_error(); }
+
+#ifdef _WIN32
+    Exc result = Error.runtime;
+    HANDLE hout = (HANDLE)_get_osfhandle(_fileno(slot->output));
+    if (!SetHandleInformation(hout, HANDLE_FLAG_INHERIT, HANDLE_FLAG_INHERIT)) {
+        result = os.get_last_error();
+        goto end;
+    }
+
+    STARTUPINFO si = { 0 };
+    PROCESS_INFORMATION pi = { 0 };
+    si.cb = sizeof(STARTUPINFO);
+    si.dwFlags |= STARTF_USESTDHANDLES;
+    si.hStdError = hout;
+    si.hStdOutput = hout;
+    si.hStdInput = GetStdHandle(STD_INPUT_HANDLE);
+
+    mem$scope(tmem$, _)
+    {
+        sbuf_c cmd = sbuf.create(1024, _);
+        for (u32 i = 0; args[i] != NULL; i++) {
+            if (str.find(args[i], " ") || str.find(args[i], "\"")) {
+                char* escaped_arg = str.replace(args[i], "\"", "\\\"", _);
+                e$except_silent (err, sbuf.appendf(&cmd, "\"%s\" ", escaped_arg)) {
+                    result = err;
+                    goto end;
+                }
+            } else {
+                e$except_silent (err, sbuf.appendf(&cmd, "%s ", args[i])) {
+                    result = err;
+                    goto end;
+                }
+            }
+        }
+
+        if (!CreateProcessA(NULL, cmd, NULL, NULL, TRUE, 0, NULL, NULL, &si, &pi)) {
+            result = os.get_last_error();
+            goto end;
+        }
+    }
+    CloseHandle(pi.hThread);
+    slot->process = pi.hProcess;
+    result = EOK;
+
+end:
+    if (result != EOK) {
+        fclose(slot->output);
+        slot->output = NULL;
+        return result;
+    }
+#else
+    int out_fd = fileno(slot->output);
+    // other children must not inherit this output (dup2() in child clears the flag)
+    fcntl(out_fd, F_SETFD, FD_CLOEXEC);
+
+    posix_spawn_file_actions_t actions;
+    int err = posix_spawn_file_actions_init(&actions);
+    if (err == 0) {
+        err = posix_spawn_file_actions_addopen(&actions, STDIN_FILENO, "/dev/null", O_RDONLY, 0);
+    }
+    if (err == 0) { err = posix_spawn_file_actions_adddup2(&actions, out_fd, STDOUT_FILENO); }
+    if (err == 0) { err = posix_spawn_file_actions_adddup2(&actions, out_fd, STDERR_FILENO); }
+    pid_t cpid = 0;
+    if (err == 0) { err = posix_spawnp(&cpid, args[0], &actions, NULL, args, environ); }
+    posix_spawn_file_actions_destroy(&actions);
+    if (err != 0) {
+        fclose(slot->output);
+        slot->output = NULL;
+        return e$raise(Error.os, "Could not spawn child process '%s': %s", args[0], strerror(err));
+    }
+    slot->pid = cpid;
+#endif
+
+    self->n_running++;
+    return EOK;
+}
+
+static void
+_cex_os__cmd__pool_finish(os_cmd_pool_c* self, u32 slot_idx, i32 ret_code)
+{
+    uassert(slot_idx < self->n_running);
+    struct _os_cmd_pool_slot_s* slot = &self->_slots[slot_idx];
+    os_cmd_job_s* job = &self->jobs[slot->job_idx];
+
+    job->ret_code = ret_code;
+    job->is_done = true;
+    if (ret_code != 0) {
+        job->err = Error.runtime;
+        self->n_failed++;
+        if (self->err == EOK) { self->err = job->err; }
+    }
+
+    rewind(slot->output);
+    if (self->opts.keep_output) {
+        str_s out = { 0 };
+        if (io.fread_all(slot->output, &out, self->allc) == EOK) { job->output = out.buf; }
+        if (!self->opts.no_print && out.len > 0) {
+            fwrite(out.buf, 1, out.len, stdout);
+            fflush(stdout);
+        }
+    } else if (!self->opts.no_print) {
+        char buf[4096];
+        usize n = 0;
+        while ((n = fread(buf, 1, sizeof(buf), slot->output)) > 0) { fwrite(buf, 1, n, stdout); }
+        fflush(stdout);
+    }
+    fclose(slot->output);
+
+    // swap remove
+    self->n_running--;
+    self->_slots[slot_idx] = self->_slots[self->n_running];
+}
+
+/// Blocks until at least one running job finishes
+static Exception
+_cex_os__cmd__pool_wait_any(os_cmd_pool_c* self)
+{
+    if (self->n_running == 0) { return EOK; }
+
+#ifdef _WIN32
+    HANDLE handles[MAXIMUM_WAIT_OBJECTS];
+    for (u32 i = 0; i < self->n_running; i++) { handles[i] = self->_slots[i].process; }
+    DWORD r = WaitForMultipleObjects(self->n_running, handles, FALSE, INFINITE);
+    if (r == WAIT_FAILED) { return os.get_last_error(); }
+    for (u32 i = 0; i < self->n_running;) {
+        HANDLE process = self->_slots[i].process;
+        if (WaitForSingleObject(process, 0) != WAIT_OBJECT_0) {
+            i++;
+            continue;
+        }
+        DWORD exit_code = 0;
+        i32 ret_code = GetExitCodeProcess(process, &exit_code) ? (i32)exit_code : -1;
+        CloseHandle(process);
+        _cex_os__cmd__pool_finish(self, i, ret_code);
+    }
+    return EOK;
+#else
+    while (true) {
+        u32 n_done = 0;
+        for (u32 i = 0; i < self->n_running;) {
+            int status = 0;
+            pid_t r = waitpid(self->_slots[i].pid, &status, WNOHANG);
+            if (r == 0) {
+                i++;
+                continue;
+            }
+            if (r < 0 && errno == EINTR) { continue; }
+
+            i32 ret_code = -1;
+            if (r > 0 && WIFEXITED(status)) {
+                ret_code = WEXITSTATUS(status);
+            } else if (r > 0 && WIFSIGNALED(status)) {
+                ret_code = 128 + WTERMSIG(status);
+            }
+            _cex_os__cmd__pool_finish(self, i, ret_code);
+            n_done++;
+        }
+        if (n_done > 0 || self->n_running == 0) { return EOK; }
+
+#    if defined(__linux__)
+        // Sleep until any child exits, without reaping it. If it's not a child of the pool
+        // (e.g. zombie of another os.cmd) waitid() returns immediately, fall back to polling.
+        siginfo_t info = { 0 };
+        if (waitid(P_ALL, 0, &info, WEXITED | WNOWAIT) == 0) {
+            bool is_ours = false;
+            for (u32 i = 0; i < self->n_running; i++) {
+                if (self->_slots[i].pid == info.si_pid) {
+                    is_ours = true;
+                    break;
+                }
+            }
+            if (is_ours) { continue; }
+        }
+#    endif
+        cex_os_sleep(2);
+    }
+#endif
+}
+
+/// Adds new job to the pool, args are copied and must be NULL terminated (same as os.cmd.run()).
+/// Blocks while all opts.n_jobs slots are busy. Returns error of the first failed job (without
+/// launching a new one) unless opts.keep_going is set.
+static Exception
+cex_os__cmd__pool_add(os_cmd_pool_c* self, char** args, usize args_len)
+{
+    uassert(self != NULL);
+    uassert(self->_slots != NULL && "pool is not created");
+
+    if (args == NULL || args_len == 0) {
+        return e$raise(Error.argument, "`args` argument is empty or null");
+    }
+    if (args_len == 1 || args[args_len - 1] != NULL) {
+        return e$raise(Error.argument, "`args` last item must be a NULL");
+    }
+    for (u32 i = 0; i < args_len - 1; i++) {
+        if (args[i] == NULL || args[i][0] == '\0') {
+            return e$raise(
+                Error.argument,
+                "`args` item[%d] is NULL/empty, which may indicate string operation failure",
+                i
+            );
+        }
+    }
+
+    while (self->n_running >= self->opts.n_jobs) { e$ret(_cex_os__cmd__pool_wait_any(self)); }
+    if (self->err != EOK && !self->opts.keep_going) { return self->err; }
+
+    _os$args_print("CMD:", args, args_len);
+
+    os_cmd_job_s job = { .ret_code = -1 };
+    job.args = mem$calloc(self->allc, args_len, sizeof(char*));
+    if (job.args == NULL) { return Error.memory; }
+    for (u32 i = 0; i < args_len - 1; i++) {
+        job.args[i] = str.clone(args[i], self->allc);
+        if (job.args[i] == NULL) {
+            // job.args is calloc'ed, so everything cloned so far is NULL-terminated
+            for (u32 j = 0; j < i; j++) { mem$free(self->allc, job.args[j]); }
+            mem$free(self->allc, job.args);
+            return Error.memory;
+        }
+    }
+    arr$push(self->jobs, job);
+
+    u32 job_idx = arr$len(self->jobs) - 1;
+    e$except_silent (err, _cex_os__cmd__pool_spawn(self, job_idx)) {
+        self->jobs[job_idx].err = err;
+        self->jobs[job_idx].is_done = true;
+        self->n_failed++;
+        if (self->err == EOK) { self->err = err; }
+        return (self->opts.keep_going) ? EOK : err;
+    }
+    return EOK;
+}
+
+/// Waits all running jobs to finish, returns error of the first failed job (check
+/// os_cmd_pool_c.jobs for individual results)
+static Exception
+cex_os__cmd__pool_join(os_cmd_pool_c* self)
+{
+    uassert(self != NULL);
+    uassert(self->_slots != NULL && "pool is not created");
+
+    while (self->n_running > 0) { e$ret(_cex_os__cmd__pool_wait_any(self)); }
+    return self->err;
+}
+
+/// Terminates still running jobs and frees pool resources
+static void
+cex_os__cmd__pool_destroy(os_cmd_pool_c* self)
+{
+    uassert(self != NULL);
+    if (self->_slots == NULL) { return; }
+
+    self->opts.no_print = true;
+    while (self->n_running > 0) {
+        struct _os_cmd_pool_slot_s* slot = &self->_slots[self->n_running - 1];
+#ifdef _WIN32
+        TerminateProcess(slot->process, 1);
+        WaitForSingleObject(slot->process, INFINITE);
+        CloseHandle(slot->process);
+#else
+        kill(slot->pid, SIGTERM);
+        while (waitpid(slot->pid, NULL, 0) < 0 && errno == EINTR) {}
+#endif
+        _cex_os__cmd__pool_finish(self, self->n_running - 1, -1);
+    }
+
+    for$eachp(job, self->jobs)
+    {
+        if (job->args) {
+            for (u32 i = 0; job->args[i] != NULL; i++) { mem$free(self->allc, job->args[i]); }
+            mem$free(self->allc, job->args);
+        }
+        if (job->output) { mem$free(self->allc, job->output); }
+    }
+    arr$free(self->jobs);
+    mem$free(self->allc, self->_slots);
+    memset(self, 0, sizeof(*self));
+}
+
+typedef struct _os_cmd_io_state_s
+{
+    f64 deadline; // os.timer() value, 0 - no timeout
+    usize in_written;
+#ifdef _WIN32
+    HANDLE h_out;
+    HANDLE h_err;
+#else
+    int fd_out;
+    int fd_err;
+    int fd_in;
+    int fd_pid; // pidfd (Linux 5.3+), -1 - waitpid() polling
+#endif
+    bool is_exited;
+    bool is_killed;
+    bool is_done;
+} _os_cmd_io_state_s;
+
+static void
+_cex_os__cmd__io_kill(os_cmd_io_s* io, _os_cmd_io_state_s* st, Exc reason)
+{
+    if (st->is_killed || st->is_exited) { return; }
+    if (subprocess_terminate(&io->cmd->_subpr)) {} // result ignored, exit is checked anyway
+    st->is_killed = true;
+    if (io->result == EOK) { io->result = reason; }
+}
+
+static void
+_cex_os__cmd__io_deliver(os_cmd_io_s* io, _os_cmd_io_state_s* st, bool is_stderr, str_s data)
+{
+    sbuf_c* sb = (is_stderr) ? io->err : io->out;
+    if (sb) {
+        e$except_silent (err, sbuf.appendf(sb, "%S", data)) { _cex_os__cmd__io_kill(io, st, err); }
+    }
+    if (io->on_data) {
+        e$except_silent (err, io->on_data(io->cmd, is_stderr, data, io->user_ctx)) {
+            _cex_os__cmd__io_kill(io, st, err);
+        }
+    }
+}
+
+static void
+_cex_os__cmd__io_finish(os_cmd_io_s* io, _os_cmd_io_state_s* st)
+{
+    if (io->cmd->_subpr.stdin_file) {
+        fclose(io->cmd->_subpr.stdin_file);
+        io->cmd->_subpr.stdin_file = NULL;
+    }
+#ifndef _WIN32
+    if (st->fd_pid >= 0) { close(st->fd_pid); }
+#endif
+    // child is already exited, join only gets exit code and releases resources
+    Exc err = cex_os__cmd__join(io->cmd, 0, &io->ret_code);
+    if (io->result == EOK) { io->result = err; }
+    st->is_done = true;
+}
+
+/// Services stdin/stdout/stderr of many commands (made by os.cmd.create()) from the current thread
+/// until all of them exit, and joins them (no os.cmd.join() needed). Returns first failed
+/// ios[i].result. NOTE: don't mix with os.cmd.read_line()/os.cmd.fstdout() buffered reads.
+static Exception
+cex_os__cmd__communicate(os_cmd_io_s* ios, u32 ios_len)
+{
+    if (ios == NULL || ios_len == 0) { return e$raise(Error.argument, "`ios` is empty or null"); }
+    for (u32 i = 0; i < ios_len; i++) {
+        os_cmd_c* cmd = ios[i].cmd;
+        if (cmd == NULL || !cmd->_is_subprocess || cmd->_subpr.stdout_file == NULL) {
+            return e$raise(Error.argument, "ios[%d].cmd must be created by os.cmd.create()", i);
+        }
+        ios[i].ret_code = -1;
+        ios[i].result = EOK;
+    }
+
+    Exc result = EOK;
+    char buf[16 * 1024];
+    f64 t_start = os.timer();
+    // NOTE: no tmem$ scope here, ios[i].out/err may be allocated by outer tmem$ scope
+    _os_cmd_io_state_s* states = mem$calloc(mem$, ios_len, sizeof(_os_cmd_io_state_s));
+    if (states == NULL) { return Error.memory; }
+#ifndef _WIN32
+    struct pollfd* pfds = mem$calloc(mem$, ios_len * 4, sizeof(struct pollfd));
+    u32* pfd_owners = mem$calloc(mem$, ios_len * 4, sizeof(u32));
+    if (pfds == NULL || pfd_owners == NULL) {
+        result = Error.memory;
+        goto end;
+    }
+#endif
+
+    bool has_stdin = false;
+    for (u32 i = 0; i < ios_len; i++) {
+        os_cmd_io_s* io = &ios[i];
+        _os_cmd_io_state_s* st = &states[i];
+        struct subprocess_s* sp = &io->cmd->_subpr;
+        if (io->timeout_ms) { st->deadline = t_start + io->timeout_ms / 1000.0; }
+        if (sp->stdin_file && io->stdin_data.len == 0) {
+            fclose(sp->stdin_file);
+            sp->stdin_file = NULL;
+        }
+        has_stdin |= sp->stdin_file != NULL;
+#ifdef _WIN32
+        st->h_out = (HANDLE)_get_osfhandle(_fileno(sp->stdout_file));
+        st->h_err = (sp->stderr_file && sp->stderr_file != sp->stdout_file)
+                      ? (HANDLE)_get_osfhandle(_fileno(sp->stderr_file))
+                      : INVALID_HANDLE_VALUE;
+        if (sp->stdin_file) {
+            // NOTE: anonymous pipes have no non-blocking mode on Windows, stdin is written at
+            // once, this may block if child is not reading stdin
+            HANDLE h_in = (HANDLE)_get_osfhandle(_fileno(sp->stdin_file));
+            while (st->in_written < io->stdin_data.len) {
+                DWORD n = 0;
+                usize len = io->stdin_data.len - st->in_written;
+                if (len > INT32_MAX) { len = INT32_MAX; }
+                if (!WriteFile(h_in, io->stdin_data.buf + st->in_written, len, &n, NULL)) {
+                    break;
+                }
+                st->in_written += n;
+            }
+            fclose(sp->stdin_file);
+            sp->stdin_file = NULL;
+        }
+#else
+        st->fd_out = fileno(sp->stdout_file);
+        st->fd_err = (sp->stderr_file && sp->stderr_file != sp->stdout_file)
+                       ? fileno(sp->stderr_file)
+                       : -1;
+        st->fd_in = (sp->stdin_file) ? fileno(sp->stdin_file) : -1;
+        st->fd_pid = -1;
+#    if defined(__linux__) && defined(SYS_pidfd_open)
+        st->fd_pid = syscall(SYS_pidfd_open, sp->child, 0);
+#    endif
+        int fds[] = { st->fd_out, st->fd_err, st->fd_in };
+        for$each (fd, fds) {
+            if (fd >= 0) { fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK); }
+        }
+#endif
+    }
+
+#ifdef _WIN32
+    (void)has_stdin;
+    u32 n_done = 0;
+    while (n_done < ios_len) {
+        bool is_idle = true;
+        for (u32 i = 0; i < ios_len; i++) {
+            os_cmd_io_s* io = &ios[i];
+            _os_cmd_io_state_s* st = &states[i];
+            if (st->is_done) { continue; }
+
+            HANDLE* handles[] = { &st->h_out, &st->h_err };
+            for (u32 k = 0; k < arr$len(handles); k++) {
+                if (*handles[k] == INVALID_HANDLE_VALUE) { continue; }
+                DWORD avail = 0;
+                if (!PeekNamedPipe(*handles[k], NULL, 0, NULL, &avail, NULL)) {
+                    *handles[k] = INVALID_HANDLE_VALUE; // broken pipe -> EOF
+                    continue;
+                }
+                if (avail == 0) { continue; }
+                DWORD n = 0;
+                if (avail > sizeof(buf)) { avail = sizeof(buf); }
+                if (!ReadFile(*handles[k], buf, avail, &n, NULL) || n == 0) {
+                    *handles[k] = INVALID_HANDLE_VALUE;
+                    continue;
+                }
+                is_idle = false;
+                _cex_os__cmd__io_deliver(io, st, k == 1, (str_s){ .buf = buf, .len = n });
+            }
+
+            if (!st->is_exited) {
+                st->is_exited = WaitForSingleObject(io->cmd->_subpr.hProcess, 0) ==
+                                WAIT_OBJECT_0;
+            }
+            if (!st->is_exited && st->deadline > 0 && os.timer() >= st->deadline) {
+                _cex_os__cmd__io_kill(io, st, Error.timeout);
+            }
+            if (st->is_exited && (st->is_killed || (st->h_out == INVALID_HANDLE_VALUE &&
+                                                    st->h_err == INVALID_HANDLE_VALUE))) {
+                _cex_os__cmd__io_finish(io, st);
+                n_done++;
+                is_idle = false;
+            }
+        }
+        if (is_idle) { cex_os_sleep(1); }
+    }
+#else
+    // writing into pipe of exited child must not kill us, SIGPIPE is blocked only for this
+    // thread (the process-wide handler is not touched, other threads may rely on it)
+    sigset_t sigpipe_set;
+    sigset_t sigmask_prev;
+    bool sigpipe_was_pending = false;
+    sigemptyset(&sigpipe_set);
+    sigaddset(&sigpipe_set, SIGPIPE);
+    if (has_stdin) {
+        sigset_t pending;
+        sigpending(&pending);
+        sigpipe_was_pending = sigismember(&pending, SIGPIPE);
+        pthread_sigmask(SIG_BLOCK, &sigpipe_set, &sigmask_prev);
+    }
+
+    u32 n_done = 0;
+    while (n_done < ios_len) {
+        u32 n_pfds = 0;
+        int timeout_ms = -1;
+        f64 now = os.timer();
+        for (u32 i = 0; i < ios_len; i++) {
+            _os_cmd_io_state_s* st = &states[i];
+            if (st->is_done) { continue; }
+            int fds[] = { st->fd_out, st->fd_err, st->fd_in, st->is_exited ? -1 : st->fd_pid };
+            for (u32 k = 0; k < arr$len(fds); k++) {
+                if (fds[k] < 0) { continue; }
+                pfds[n_pfds] = (struct pollfd){ .fd = fds[k] };
+                pfds[n_pfds].events = (k == 2) ? POLLOUT : POLLIN;
+                pfd_owners[n_pfds] = i;
+                n_pfds++;
+            }
+            int t_ms = -1;
+            if (!st->is_exited && st->fd_pid < 0) { t_ms = 10; } // no pidfd, polling exit
+            if (st->deadline > 0 && !st->is_killed) {
+                f64 remaining = (st->deadline - now) * 1000.0;
+                int r_ms = (remaining > 0) ? (int)remaining + 1 : 0;
+                if (t_ms < 0 || r_ms < t_ms) { t_ms = r_ms; }
+            }
+            if (t_ms >= 0 && (timeout_ms < 0 || t_ms < timeout_ms)) { timeout_ms = t_ms; }
+        }
+
+        int n_ready = poll(pfds, n_pfds, timeout_ms);
+        if (n_ready < 0) {
+            if (errno != EINTR) { cex_os_sleep(1); }
+            n_ready = 0;
+        }
+
+        for (u32 p = 0; p < n_pfds && n_ready > 0; p++) {
+            if (pfds[p].revents == 0) { continue; }
+            n_ready--;
+            os_cmd_io_s* io = &ios[pfd_owners[p]];
+            _os_cmd_io_state_s* st = &states[pfd_owners[p]];
+            int fd = pfds[p].fd;
+
+            if (fd == st->fd_out || fd == st->fd_err) {
+                isize n = read(fd, buf, sizeof(buf));
+                if (n > 0) {
+                    str_s data = { .buf = buf, .len = n };
+                    _cex_os__cmd__io_deliver(io, st, fd == st->fd_err, data);
+                } else if (n == 0 || (errno != EAGAIN && errno != EINTR)) {
+                    // EOF, the file is closed by os.cmd.join()
+                    if (fd == st->fd_out) {
+                        st->fd_out = -1;
+                    } else {
+                        st->fd_err = -1;
+                    }
+                }
+            } else if (fd == st->fd_in) {
+                isize n = write(
+                    fd,
+                    io->stdin_data.buf + st->in_written,
+                    io->stdin_data.len - st->in_written
+                );
+                if (n > 0) { st->in_written += n; }
+                if (st->in_written == io->stdin_data.len ||
+                    (n < 0 && errno != EAGAIN && errno != EINTR)) {
+                    // all written, or child closed its stdin (EPIPE)
+                    fclose(io->cmd->_subpr.stdin_file);
+                    io->cmd->_subpr.stdin_file = NULL;
+                    st->fd_in = -1;
+                }
+            }
+            // pidfd readiness is handled by waitpid() below
+        }
+
+        now = os.timer();
+        for (u32 i = 0; i < ios_len; i++) {
+            os_cmd_io_s* io = &ios[i];
+            _os_cmd_io_state_s* st = &states[i];
+            if (st->is_done) { continue; }
+            struct subprocess_s* sp = &io->cmd->_subpr;
+
+            if (!st->is_exited) {
+                int status = 0;
+                if (waitpid(sp->child, &status, WNOHANG) == sp->child) {
+                    // os.cmd.join() will use saved exit code
+                    sp->child = 0;
+                    sp->alive = 0;
+                    sp->return_status = WIFEXITED(status) ? WEXITSTATUS(status)
+                                                          : 128 + WTERMSIG(status);
+                    st->is_exited = true;
+                } else if (st->deadline > 0 && now >= st->deadline) {
+                    _cex_os__cmd__io_kill(io, st, Error.timeout);
+                }
+            }
+            if (st->is_exited && (st->is_killed || (st->fd_out < 0 && st->fd_err < 0))) {
+                _cex_os__cmd__io_finish(io, st);
+                n_done++;
+            }
+        }
+    }
+    if (has_stdin) {
+        if (!sigpipe_was_pending) {
+            // discard SIGPIPE raised by our writes before unblocking, or it would be delivered
+            sigset_t pending;
+            sigpending(&pending);
+            if (sigismember(&pending, SIGPIPE)) {
+#    if defined(__APPLE__)
+                int sig;
+                sigwait(&sigpipe_set, &sig); // pending already, does not block
+#    else
+                struct timespec no_wait = { 0 };
+                while (sigtimedwait(&sigpipe_set, NULL, &no_wait) < 0 && errno == EINTR) {}
+#    endif
+            }
+        }
+        pthread_sigmask(SIG_SETMASK, &sigmask_prev, NULL);
+    }
+#endif
+
+    for (u32 i = 0; i < ios_len; i++) {
+        if (ios[i].result != EOK) {
+            result = ios[i].result;
+            break;
+        }
+    }
+
+end:
+#ifndef _WIN32
+    if (pfds) { mem$free(mem$, pfds); }
+    if (pfd_owners) { mem$free(mem$, pfd_owners); }
+#endif
+    mem$free(mem$, states);
+    return result;
+}
+
 /// Returns current OS platform, returns enum of OSPlatform__*, e.g. OSPlatform__win,
 /// OSPlatform__linux, OSPlatform__macos, etc..
 static OSPlatform_e
@@ -14901,7 +18951,23 @@ cex_os__platform__current(void)
 static char*
 cex_os__platform__current_str(void)
 {
-    return os.platform.to_str(os.platform.current());
+    return os.platform.to_str(os.platform.current());
+}
+
+/// Returns number of online CPU cores (at least 1)
+static u32
+cex_os__platform__cpu_count(void)
+{
+#if defined(_WIN32)
+    SYSTEM_INFO si;
+    GetSystemInfo(&si);
+    return (si.dwNumberOfProcessors > 0) ? (u32)si.dwNumberOfProcessors : 1;
+#elif defined(_SC_NPROCESSORS_ONLN)
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return (n > 0) ? (u32)n : 1;
+#else
+    return 1;
+#endif
 }
 
 /// Converts platform name to enum
@@ -14953,6 +19019,7 @@ const struct __cex_namespace__os os = {
     .timer = cex_os_timer,
 
     .cmd = {
+        .communicate = cex_os__cmd__communicate,
         .create = cex_os__cmd__create,
         .exists = cex_os__cmd__exists,
         .fstderr = cex_os__cmd__fstderr,
@@ -14961,6 +19028,10 @@ const struct __cex_namespace__os os = {
         .is_alive = cex_os__cmd__is_alive,
         .join = cex_os__cmd__join,
         .kill = cex_os__cmd__kill,
+        .pool_add = cex_os__cmd__pool_add,
+        .pool_create = cex_os__cmd__pool_create,
+        .pool_destroy = cex_os__cmd__pool_destroy,
+        .pool_join = cex_os__cmd__pool_join,
         .read_all = cex_os__cmd__read_all,
         .read_line = cex_os__cmd__read_line,
         .run = cex_os__cmd__run,
@@ -14976,6 +19047,7 @@ const struct __cex_namespace__os os = {
         .chdir = cex_os__fs__chdir,
         .copy = cex_os__fs__copy,
         .copy_tree = cex_os__fs__copy_tree,
+        .copy_tree_parallel = cex_os__fs__copy_tree_parallel,
         .dir_walk = cex_os__fs__dir_walk,
         .find = cex_os__fs__find,
         .getcwd = cex_os__fs__getcwd,
@@ -14985,6 +19057,7 @@ const struct __cex_namespace__os os = {
         .remove_tree = cex_os__fs__remove_tree,
         .rename = cex_os__fs__rename,
         .stat = cex_os__fs__stat,
+        .walk = cex_os__fs__walk,
     },
 
     .path = {
@@ -14999,6 +19072,7 @@ const struct __cex_namespace__os os = {
     .platform = {
         .arch_from_str = cex_os__platform__arch_from_str,
         .arch_to_str = cex_os__platform__arch_to_str,
+        .cpu_count = cex_os__platform__cpu_count,
         .current = cex_os__platform__current,
         .current_str = cex_os__platform__current_str,
         .from_str = cex_os__platform__from_str,
@@ -15094,10 +19168,9 @@ _cex__codegen_print_case_exit(_cex__codegen_s** cgptr)
     uassert(*cgptr != NULL);
     _cex__codegen_s* cg = *cgptr;
 
+    _cex__codegen_print_line(cg, "break;\n");
     if (cg->indent >= 4) { cg->indent -= 4; }
     _cex__codegen_indent(cg);
-    _cex__codegen_print_line(cg, "break;\n", '}');
-    _cex__codegen_indent(cg);
     _cex__codegen_print(cg, false, "%c\n", '}');
 }
 
@@ -15191,454 +19264,1138 @@ cexy_build_self(int argc, char** argv, char* cex_source)
                 e$goto(sbuf.appendf(&dargs_sbuf, "%s ", _darg), err);
             }
         }
-#    endif
-        e$goto(sbuf.append(&dargs_sbuf, "\""), err);
-
-        arr$push(args, dargs_sbuf);
-
-        char* custom_args[] = { cexy$cex_self_args };
-        arr$pusha(args, custom_args);
-
-        arr$pushm(args, "-o", bin_path, cex_source, NULL);
-        _os$args_print("CMD:", args, arr$len(args));
-        os_cmd_c _cmd = { 0 };
-        e$except (err, os.cmd.run(args, arr$len(args), &_cmd)) { goto fail_recovery; }
-        e$except (err, os.cmd.join(&_cmd, 0, NULL)) { goto fail_recovery; }
+#    endif
+        e$goto(sbuf.append(&dargs_sbuf, "\""), err);
+
+        arr$push(args, dargs_sbuf);
+
+        char* custom_args[] = { cexy$cex_self_args };
+        arr$pusha(args, custom_args);
+
+        arr$pushm(args, "-o", bin_path, cex_source, NULL);
+        _os$args_print("CMD:", args, arr$len(args));
+        os_cmd_c _cmd = { 0 };
+        e$except (err, os.cmd.run(args, arr$len(args), &_cmd)) { goto fail_recovery; }
+        e$except (err, os.cmd.join(&_cmd, 0, NULL)) { goto fail_recovery; }
+
+        // All good new build successful, remove old binary
+        if (os.fs.remove(old_name)) {}
+
+        // run rebuilt cex executable again
+        arr$clear(args);
+        arr$pushm(args, bin_path);
+        for$each (darg, argv + dflag_idx, argc - dflag_idx) { arr$push(args, darg); }
+        arr$pushm(args, NULL);
+        _os$args_print("CMD:", args, arr$len(args));
+        e$except (err, os.cmd.run(args, arr$len(args), &_cmd)) { goto err; }
+        if (os.cmd.join(&_cmd, 0, NULL)) { goto err; }
+        exit(0); // unconditionally exit after build was successful
+    fail_recovery:
+        if (os.path.exists(old_name)) {
+            e$except (err, os.fs.rename(old_name, bin_path)) { goto err; }
+        }
+        goto err;
+    err:
+        exit(1);
+    }
+}
+
+// Include dependency graph, see implementation below
+static u64 _cexy__cache_hash(const void* data, usize len, u64 seed);
+static char* _cexy__cache_path(char* src_fn, char* kind, IAllocator alloc);
+static int _cexy__deps_check(char* deps_fn, u64 variant, os_fs_stat_s target_meta, IAllocator _);
+static bool _cexy__deps_scan(
+    char* deps_fn,
+    u64 variant,
+    char* src_path,
+    arr$(char*) incl_path,
+    bool with_file_dir,
+    os_fs_stat_s target_meta,
+    IAllocator _
+);
+
+static bool
+cexy_src_include_changed(char* target_path, char* src_path, arr$(char*) alt_include_path)
+{
+    if (unlikely(target_path == NULL)) {
+        log$error("target_path is NULL\n");
+        return false;
+    }
+    if (unlikely(src_path == NULL)) {
+        log$error("src_path is NULL\n");
+        return false;
+    }
+
+    auto src_meta = os.fs.stat(src_path);
+    if (!src_meta.is_valid) {
+        (void)e$raise(src_meta.error, "Error src: %s", src_path);
+        return false;
+    } else if (!src_meta.is_file || src_meta.is_symlink) {
+        (void)e$raise("Bad type", "src is not a file: %s", src_path);
+        return false;
+    }
+
+    auto target_meta = os.fs.stat(target_path);
+    if (!target_meta.is_valid) {
+        if (target_meta.error == Error.not_found) {
+            return true;
+        } else {
+            (void)e$raise(target_meta.error, "target_path: '%s'", target_path);
+            return false;
+        }
+    } else if (!target_meta.is_file || target_meta.is_symlink) {
+        (void)e$raise("Bad type", "target_path is not a file: %s", target_path);
+        return false;
+    }
+
+    if (!str.ends_with(src_path, ".c") && !str.ends_with(src_path, ".h")) {
+        // We only parse includes for appropriate .c/.h files
+        if (src_meta.mtime > target_meta.mtime) {
+            log$debug("Src changed: %s\n", src_path);
+            return true;
+        }
+        return false;
+    }
+
+    mem$scope(tmem$, _)
+    {
+        arr$(char*) incl_path = arr$new(incl_path, _);
+        bool with_file_dir = true;
+        if (arr$len(alt_include_path) > 0) {
+            for$each (p, alt_include_path) {
+                arr$push(incl_path, p);
+                if (!os.path.exists(p)) { log$warn("alt_include_path not exists: %s\n", p); }
+            }
+            with_file_dir = false;
+        } else {
+            char* def_incl_path[] = { cexy$cc_include };
+            for$each (p, def_incl_path) {
+                char* clean_path = p;
+                if (str.starts_with(p, "-I")) {
+                    clean_path = p + 2;
+                } else if (str.starts_with(p, "-iquote=")) {
+                    clean_path = p + strlen("-iquote=");
+                }
+                if (!os.path.exists(clean_path)) {
+                    log$trace("cexy$cc_include not exists: %s\n", clean_path);
+                    continue;
+                }
+                arr$push(incl_path, clean_path);
+            }
+        }
+
+        // Dependency graph is only valid for the same source and include search paths
+        u64 variant = _cexy__cache_hash(src_path, str.len(src_path), with_file_dir);
+        for$each (p, incl_path) { variant = _cexy__cache_hash(p, str.len(p), variant); }
+
+        char* deps_fn = _cexy__cache_path(target_path, "deps", _);
+        int deps_state = _cexy__deps_check(deps_fn, variant, target_meta, _);
+        if (deps_state >= 0) { return deps_state; }
+
+        // No valid dependency graph (first run or target rebuilt), full transitive scan
+        return _cexy__deps_scan(
+            deps_fn,
+            variant,
+            src_path,
+            incl_path,
+            with_file_dir,
+            target_meta,
+            _
+        );
+    }
+    return false;
+}
+
+static bool
+cexy_src_changed(char* target_path, char** src_array, usize src_array_len)
+{
+    if (unlikely(src_array == NULL || src_array_len == 0)) {
+        if (src_array == NULL) {
+            log$error("src_array is NULL, which may indicate error\n");
+        } else {
+            log$error("src_array is empty\n");
+        }
+        return false;
+    }
+    if (unlikely(target_path == NULL)) {
+        log$error("target_path is NULL\n");
+        return false;
+    }
+    auto target_ftype = os.fs.stat(target_path);
+    if (!target_ftype.is_valid) {
+        if (target_ftype.error == Error.not_found) {
+            log$trace("Target '%s' not exists, needs build.\n", target_path);
+            return true;
+        } else {
+            (void)e$raise(target_ftype.error, "target_path: '%s'", target_path);
+            return false;
+        }
+    } else if (!target_ftype.is_file || target_ftype.is_symlink) {
+        (void)e$raise("Bad type", "target_path is not a file: %s", target_path);
+        return false;
+    }
+
+    bool has_error = false;
+    for$each (p, src_array, src_array_len) {
+        auto ftype = os.fs.stat(p);
+        if (!ftype.is_valid) {
+            (void)e$raise(ftype.error, "Error src: %s", p);
+            has_error = true;
+        } else if (!ftype.is_file || ftype.is_symlink) {
+            (void)e$raise("Bad type", "src is not a file: %s", p);
+            has_error = true;
+        } else {
+            if (has_error) { continue; }
+            if (ftype.mtime > target_ftype.mtime) {
+                log$trace("Source changed '%s'\n", p);
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+static char*
+cexy_target_make(char* src_path, char* build_dir, char* name_or_extension, IAllocator allocator)
+{
+    uassert(allocator != NULL);
+
+    if (src_path == NULL || src_path[0] == '\0') {
+        log$error("src_path is NULL or empty\n");
+        return NULL;
+    }
+    if (build_dir == NULL) {
+        log$error("build_dir is NULL\n");
+        return NULL;
+    }
+    if (name_or_extension == NULL || name_or_extension[0] == '\0') {
+        log$error("name_or_extension is NULL or empty\n");
+        return NULL;
+    }
+    if (!os.path.exists(src_path)) {
+        log$error("src_path does not exist: '%s'\n", src_path);
+        return NULL;
+    }
+
+    char* result = NULL;
+    if (name_or_extension[0] == '.') {
+        // starts_with .ext, make full path as following: build_dir/src_path/src_file.ext[.exe]
+        result = str.fmt(
+            allocator,
+            "%s%c%s%s%s",
+            build_dir,
+            os$PATH_SEP,
+            src_path,
+            name_or_extension,
+            cexy$build_ext_exe
+        );
+        uassert(result != NULL && "memory error");
+    } else {
+        // probably a program name, make full path: build_dir/name_or_extension[.exe]
+        result = str.fmt(
+            allocator,
+            "%s%c%s%s",
+            build_dir,
+            os$PATH_SEP,
+            name_or_extension,
+            cexy$build_ext_exe
+        );
+        uassert(result != NULL && "memory error");
+    }
+    e$except (err, os.fs.mkpath(result)) { mem$free(allocator, result); }
+
+    return result;
+}
+
+Exception
+cexy__fuzz__create(char* target)
+{
+    if (!str.slice.starts_with(os.path.split(target, false), str$s("fuzz_"))) {
+        return e$raise(Error.argument, "Fuzz file must start with `fuzz_` prefix, got: %s", target);
+    }
+    if (os.path.exists(target)) {
+        return e$raise(Error.exists, "Fuzz file already exists: %s", target);
+    }
+    e$ret(os.fs.mkpath(target));
+
+    mem$scope(tmem$, _)
+    {
+        sbuf_c buf = sbuf.create(1024 * 10, _);
+        cg$init(&buf);
+        cg$pn("#define CEX_IMPLEMENTATION");
+        cg$pn("#include \"cex.h\"");
+
+        cg$pn("");
+        cg$pn("/*");
+        cg$func("fuzz$setup(void)", "")
+        {
+            cg$pn("// This function allows programmatically seed new corpus for fuzzer");
+            cg$pn("io.printf(\"CORPUS: %s\\n\", fuzz$corpus_dir);");
+            cg$scope("memcg$scope(tmem$, _)", "")
+            {
+                cg$pn("char* fn = str.fmt(_, \"%s/my_case\", fuzz$corpus_dir);");
+                cg$pn("(void)fn;");
+                cg$pn("// io.file.save(fn, \"my seed data\");");
+            }
+        }
+        cg$pn("*/");
+
+        cg$pn("");
+        cg$func("int\nfuzz$case(const u8* data, usize size)", "")
+        {
+            cg$pn("// TODO: do your stuff based on input data and size");
+            cg$if("size > 2 && data[0] == 'C' && data[1] == 'E' && data[2] == 'X'", "")
+            {
+                cg$pn("__builtin_trap();");
+            }
+            cg$pn("return 0;");
+        }
 
-        // All good new build successful, remove old binary
-        if (os.fs.remove(old_name)) {}
+        cg$pn("");
+        cg$pn("fuzz$main();");
 
-        // run rebuilt cex executable again
-        arr$clear(args);
-        arr$pushm(args, bin_path);
-        for$each (darg, argv + dflag_idx, argc - dflag_idx) { arr$push(args, darg); }
-        arr$pushm(args, NULL);
-        _os$args_print("CMD:", args, arr$len(args));
-        e$except (err, os.cmd.run(args, arr$len(args), &_cmd)) { goto err; }
-        if (os.cmd.join(&_cmd, 0, NULL)) { goto err; }
-        exit(0); // unconditionally exit after build was successful
-    fail_recovery:
-        if (os.path.exists(old_name)) {
-            e$except (err, os.fs.rename(old_name, bin_path)) { goto err; }
-        }
-        goto err;
-    err:
-        exit(1);
+        e$ret(io.file.save(target, buf));
     }
+    return EOK;
 }
 
-static bool
-cexy_src_include_changed(char* target_path, char* src_path, arr$(char*) alt_include_path)
+Exception
+cexy__test__create(char* target, bool include_sample)
 {
-    if (unlikely(target_path == NULL)) {
-        log$error("target_path is NULL\n");
-        return false;
+    if (os.path.exists(target)) {
+        return e$raise(Error.exists, "Test file already exists: %s", target);
     }
-    if (unlikely(src_path == NULL)) {
-        log$error("src_path is NULL\n");
-        return false;
+    if (str.eq(target, "all") || str.find(target, "*")) {
+        return e$raise(
+            Error.argument,
+            "You must pass exact file path, not pattern, got: %s",
+            target
+        );
     }
+    e$ret(os.fs.mkpath(target));
 
-    auto src_meta = os.fs.stat(src_path);
-    if (!src_meta.is_valid) {
-        (void)e$raise(src_meta.error, "Error src: %s", src_path);
-        return false;
-    } else if (!src_meta.is_file || src_meta.is_symlink) {
-        (void)e$raise("Bad type", "src is not a file: %s", src_path);
-        return false;
+    mem$scope(tmem$, _)
+    {
+        sbuf_c buf = sbuf.create(1024 * 10, _);
+        cg$init(&buf);
+        cg$pn("#define CEX_IMPLEMENTATION");
+        cg$pn("#define CEX_TEST");
+        cg$pn("#include \"cex.h\"");
+        if (include_sample) { cg$pn("#include \"lib/mylib.c\""); }
+        cg$pn("");
+        cg$pn("//test$setup_case() {return EOK;}");
+        cg$pn("//test$teardown_case() {return EOK;}");
+        cg$pn("//test$setup_suite() {return EOK;}");
+        cg$pn("//test$teardown_suite() {return EOK;}");
+        cg$pn("");
+        cg$scope("test$case(%s)", (include_sample) ? "mylib_test_case" : "my_test_case")
+        {
+            if (include_sample) {
+                cg$pn("tassert_eq(mylib_add(1, 2), 3);");
+                cg$pn("// Next will be available after calling `cex process lib/mylib.c`");
+                cg$pn("// tassert_eq(mylib.add(1, 2), 3);");
+            } else {
+                cg$pn("tassert_eq(1, 0);");
+            }
+            cg$pn("return EOK;");
+        }
+        cg$pn("");
+        cg$pn("test$main();");
+
+        e$ret(io.file.save(target, buf));
     }
+    return EOK;
+}
 
-    auto target_meta = os.fs.stat(target_path);
-    if (!target_meta.is_valid) {
-        if (target_meta.error == Error.not_found) {
-            return true;
-        } else {
-            (void)e$raise(target_meta.error, "target_path: '%s'", target_path);
-            return false;
+Exception
+cexy__test__clean(char* target)
+{
+
+    if (str.eq(target, "all")) {
+        log$info("Cleaning all tests\n");
+        e$ret(os.fs.remove_tree(cexy$build_dir "/tests/"));
+    } else {
+        log$info("Cleaning target: %s\n", target);
+        if (!os.path.exists(target)) {
+            return e$raise(Error.exists, "Test target not exists: %s", target);
+        }
+
+        mem$scope(tmem$, _)
+        {
+            char* test_target = cexy.target_make(target, cexy$build_dir, ".test", _);
+            e$ret(os.fs.remove(test_target));
         }
-    } else if (!target_meta.is_file || target_meta.is_symlink) {
-        (void)e$raise("Bad type", "target_path is not a file: %s", target_path);
-        return false;
     }
+    return EOK;
+}
 
-    if (src_meta.mtime > target_meta.mtime) {
-        // File itself changed
-        log$debug("Src changed: %s\n", src_path);
-        return true;
+Exception
+cexy__test__make_target_pattern(char** target)
+{
+    if (target == NULL) {
+        return e$raise(
+            Error.argsparse,
+            "Invalid target: '(null)', expected all or tests/test_some_file.c"
+        );
     }
+    if (str.eq(*target, "all")) { *target = "tests/test_*.c"; }
 
-    if (!str.ends_with(src_path, ".c") && !str.ends_with(src_path, ".h")) {
-        // We only parse includes for appropriate .c/.h files
-        return false;
+    if (!str.match(*target, "*test*.c")) {
+        return e$raise(
+            Error.argsparse,
+            "Invalid target: '%s', expected all or tests/test_some_file.c",
+            *target
+        );
     }
+    return EOK;
+}
 
-    mem$scope(tmem$, _)
-    {
-        arr$(char*) incl_path = arr$new(incl_path, _);
-        if (arr$len(alt_include_path) > 0) {
-            for$each (p, alt_include_path) {
-                arr$push(incl_path, p);
-                if (!os.path.exists(p)) { log$warn("alt_include_path not exists: %s\n", p); }
-            }
-        } else {
-            char* def_incl_path[] = { cexy$cc_include };
-            for$each (p, def_incl_path) {
-                char* clean_path = p;
-                if (str.starts_with(p, "-I")) {
-                    clean_path = p + 2;
-                } else if (str.starts_with(p, "-iquote=")) {
-                    clean_path = p + strlen("-iquote=");
-                }
-                if (!os.path.exists(clean_path)) {
-                    log$trace("cexy$cc_include not exists: %s\n", clean_path);
-                    continue;
-                }
-                arr$push(incl_path, clean_path);
-            }
-            // Adding relative to src_path directory as a search target
-            arr$push(incl_path, os.path.dirname(src_path, _));
-        }
+/// Extracts `-j` (all CPU cores), `-jN` or `--jobs=N` from argv[1..] (also removes it from argv).
+/// Parsing stops at `--` or at the `stop_positional`-th positional argument (0 - no limit), so
+/// the arguments passed to the target program are left intact.
+/// *out_n_jobs is 1 if option is not present, 0 means CPU count.
+static Exception
+_cexy__jobs_arg_extract(int* argc, char** argv, u32 stop_positional, u32* out_n_jobs)
+{
+    uassert(argc != NULL);
+    uassert(out_n_jobs != NULL);
+    *out_n_jobs = 1;
 
-        char* code = io.file.load(src_path, _);
-        if (code == NULL) {
-            (void)e$raise("IOError", "src is not a file: '%s'", src_path);
-            return false;
+    u32 n_positional = 0;
+    for (int i = 1; i < *argc; i++) {
+        char* a = argv[i];
+        char* n_str = NULL;
+        if (str.eq(a, "--")) {
+            break;
+        } else if (a[0] != '-') {
+            if (++n_positional == stop_positional) { break; }
+            continue;
+        } else if (str.eq(a, "-j") || str.eq(a, "--jobs")) {
+            n_str = "";
+        } else if (str.starts_with(a, "--jobs=")) {
+            n_str = a + strlen("--jobs=");
+        } else if (str.starts_with(a, "-j")) {
+            n_str = a + 2;
+        } else {
+            continue;
         }
 
-        (void)CexTkn_str;
-        CexParser_c lx = CexParser.create(code, 0, true);
-        cex_token_s t;
-        while ((t = CexParser.next_token(&lx)).type) {
-            if (t.type != CexTkn__preproc) { continue; }
-            if (str.slice.starts_with(t.value, str$s("include"))) {
-                str_s incf = str.slice.sub(t.value, strlen("include"), 0);
-                incf = str.slice.strip(incf);
-                if (incf.len <= 4) { // <.h>
-                    log$warn(
-                        "Bad include in: %s (item: %S at line: %d)\n",
-                        src_path,
-                        t.value,
-                        lx.line
-                    );
-                    continue;
-                }
-                log$trace("Processing include: '%S'\n", incf);
-                if (!str.slice.match(incf, "\"*.[hc]\"*")) {
-                    // system includes skipped
-                    log$trace("Skipping include: '%S'\n", incf);
-                    continue;
-                }
-                incf = str.slice.sub(incf, 1, 0);
-                incf = str.slice.sub(incf, 0, str.slice.index_of(incf, str$s("\"")) - 1);
-
-                mem$scope(tmem$, _)
-                {
-                    char extensions[] = { 'c', 'h' };
-                    for$each (ext, extensions) {
-                        char* inc_fn = str.fmt(_, "%S%c", incf, ext);
-                        uassert(inc_fn != NULL);
-                        for$each (inc_dir, incl_path) {
-                            char* try_path = os$path_join(_, inc_dir, inc_fn);
-                            uassert(try_path != NULL);
-                            auto src_meta = os.fs.stat(try_path);
-                            log$trace("Probing include: %s\n", try_path);
-                            if (src_meta.is_valid && src_meta.mtime > target_meta.mtime) {
-                                return true;
-                            }
-                        }
-                    }
-                }
+        *out_n_jobs = 0;
+        if (n_str[0] != '\0') {
+            if (str.convert.to_u32(n_str, out_n_jobs) || *out_n_jobs == 0) {
+                return e$raise(Error.argsparse, "Invalid jobs option: '%s'", a);
             }
         }
+        memmove(&argv[i], &argv[i + 1], (*argc - i - 1) * sizeof(char*));
+        (*argc)--;
+        argv[*argc] = NULL;
+        break;
     }
-    return false;
+    return EOK;
 }
 
-static bool
-cexy_src_changed(char* target_path, char** src_array, usize src_array_len)
+Exception
+cexy__test__run(char* target, bool is_debug, int argc, char** argv)
 {
-    if (unlikely(src_array == NULL || src_array_len == 0)) {
-        if (src_array == NULL) {
-            log$error("src_array is NULL, which may indicate error\n");
+    Exc result = EOK;
+    u32 n_tests = 0;
+    u32 n_failed = 0;
+    mem$scope(tmem$, _)
+    {
+        if (str.ends_with(target, "test_*.c")) {
+            // quiet mode
+            io.printf("-------------------------------------\n");
+            io.printf("Running Tests: %s\n", target);
+            io.printf("-------------------------------------\n\n");
         } else {
-            log$error("src_array is empty\n");
+            if (!os.path.exists(target)) {
+                return e$raise(Error.not_found, "Test file not found: %s", target);
+            }
         }
-        return false;
-    }
-    if (unlikely(target_path == NULL)) {
-        log$error("target_path is NULL\n");
-        return false;
-    }
-    auto target_ftype = os.fs.stat(target_path);
-    if (!target_ftype.is_valid) {
-        if (target_ftype.error == Error.not_found) {
-            log$trace("Target '%s' not exists, needs build.\n", target_path);
-            return true;
-        } else {
-            (void)e$raise(target_ftype.error, "target_path: '%s'", target_path);
-            return false;
+
+        for$each (test_src, os.fs.find(target, true, _)) {
+            n_tests++;
+            char* test_target = cexy.target_make(test_src, cexy$build_dir, ".test", _);
+            arr$(char*) args = arr$new(args, _);
+            if (is_debug) { arr$pushm(args, cexy$debug_cmd); }
+            arr$pushm(args, test_target, );
+            if (str.ends_with(target, "test_*.c")) { arr$push(args, "--quiet"); }
+            arr$pusha(args, argv, argc);
+            arr$push(args, NULL);
+            if (os$cmda(args)) {
+                log$error("<<<<<<<<<<<<<<<<<< Test failed: %s\n", test_target);
+                n_failed++;
+                result = Error.runtime;
+            }
         }
-    } else if (!target_ftype.is_file || target_ftype.is_symlink) {
-        (void)e$raise("Bad type", "target_path is not a file: %s", target_path);
-        return false;
     }
+    if (str.ends_with(target, "test_*.c")) {
+        io.printf("\n-------------------------------------\n");
+        io.printf("Total: %d Passed: %d Failed: %d\n", n_tests, n_tests - n_failed, n_failed);
+        io.printf("-------------------------------------\n\n");
+    }
+    return result;
+}
 
-    bool has_error = false;
-    for$each (p, src_array, src_array_len) {
-        auto ftype = os.fs.stat(p);
-        if (!ftype.is_valid) {
-            (void)e$raise(ftype.error, "Error src: %s", p);
-            has_error = true;
-        } else if (!ftype.is_file || ftype.is_symlink) {
-            (void)e$raise("Bad type", "src is not a file: %s", p);
-            has_error = true;
+/// Runs tests in parallel, each test output is printed at once when test finishes
+static Exception
+_cexy__test__run_jobs(char* target, u32 n_jobs, int argc, char** argv)
+{
+    Exc result = EOK;
+    u32 n_tests = 0;
+    u32 n_failed = 0;
+    bool is_all = str.ends_with(target, "test_*.c");
+    mem$scope(tmem$, _)
+    {
+        if (is_all) {
+            io.printf("-------------------------------------\n");
+            io.printf("Running Tests: %s (jobs: %d)\n", target, n_jobs);
+            io.printf("-------------------------------------\n\n");
         } else {
-            if (has_error) { continue; }
-            if (ftype.mtime > target_ftype.mtime) {
-                log$trace("Source changed '%s'\n", p);
-                return true;
+            if (!os.path.exists(target)) {
+                return e$raise(Error.not_found, "Test file not found: %s", target);
+            }
+        }
+        fflush(stdout);
+
+        os_cmd_pool_c pool;
+        os_cmd_pool_opts_s opts = { .n_jobs = n_jobs, .keep_going = true };
+        e$ret(os.cmd.pool_create(&pool, &opts, _));
+        for$each (test_src, os.fs.find(target, true, _)) {
+            n_tests++;
+            char* test_target = cexy.target_make(test_src, cexy$build_dir, ".test", _);
+            arr$(char*) args = arr$new(args, _);
+            arr$pushm(args, test_target, );
+            if (is_all) { arr$push(args, "--quiet"); }
+            arr$pusha(args, argv, argc);
+            arr$push(args, NULL);
+            if (os.cmd.pool_add(&pool, args, arr$len(args))) { result = Error.runtime; }
+        }
+        if (os.cmd.pool_join(&pool)) { result = Error.runtime; }
+
+        for$each (job, pool.jobs) {
+            if (job.err != EOK) {
+                log$error("<<<<<<<<<<<<<<<<<< Test failed: %s\n", job.args[0]);
+                n_failed++;
             }
         }
+        os.cmd.pool_destroy(&pool);
     }
+    if (is_all) {
+        io.printf("\n-------------------------------------\n");
+        io.printf("Total: %d Passed: %d Failed: %d\n", n_tests, n_tests - n_failed, n_failed);
+        io.printf("-------------------------------------\n\n");
+    }
+    return result;
+}
 
-    return false;
+/*
+ *  Parsed source cache: cexy$cache_dir/<path hash>.<kind>, invalidated per source file by
+ *  path, size, mtime and content hash.
+ */
+// NOTE: bump on cache layout or CexParser output changes, invalidates all cached files
+#define _CEXY__CACHE_VERSION 2
+
+typedef struct _cexy__cache_hdr_s
+{
+    char magic[8]; // "CEXYC001" without zero terminator
+    u64 src_size;
+    i64 src_mtime;
+    u64 src_hash;
+    u64 variant; // e.g. hash of parser options
+    u32 path_len;
+    u32 data_len;
+} _cexy__cache_hdr_s;
+
+typedef struct _cexy__cache_decl_s
+{
+    u32 name_off;
+    u32 name_len;
+    u32 docs_off; // UINT32_MAX if NULL
+    u32 docs_len;
+    u32 body_off; // UINT32_MAX if NULL
+    u32 body_len;
+    u32 ret_type_len;
+    u32 args_len;
+    u32 line;
+    u16 type;
+    u8 is_static;
+    u8 is_inline;
+} _cexy__cache_decl_s;
+
+static u64
+_cexy__cache_hash(const void* data, usize len, u64 seed)
+{
+    const u8* p = data;
+    u64 h = seed ^ (len * 0x9E3779B97F4A7C15ULL);
+    for (; len >= 8; len -= 8, p += 8) {
+        u64 w;
+        memcpy(&w, p, sizeof(w));
+        h = (h ^ w) * 0xFF51AFD7ED558CCDULL;
+        h ^= h >> 32;
+    }
+    for (; len > 0; len--, p++) { h = (h ^ *p) * 0x100000001B3ULL; }
+    // murmur3 finalizer
+    h ^= h >> 33;
+    h *= 0xC4CEB9FE1A85EC53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+/// Mixes _CEXY__CACHE_VERSION into the `variant`, files of other cexy versions never match
+static inline u64
+_cexy__cache_variant(u64 variant)
+{
+    return _cexy__cache_hash(&variant, sizeof(variant), _CEXY__CACHE_VERSION);
 }
 
 static char*
-cexy_target_make(char* src_path, char* build_dir, char* name_or_extension, IAllocator allocator)
+_cexy__cache_path(char* src_fn, char* kind, IAllocator alloc)
+{
+    if (cexy$cache_dir[0] == '\0') { return NULL; }
+    char* abspath = os.path.abs(src_fn, alloc);
+    if (abspath == NULL) { return NULL; }
+    u64 path_hash = _cexy__cache_hash(abspath, str.len(abspath), 0);
+    return str.fmt(
+        alloc,
+        "%s/%s.%08x%08x.%s",
+        cexy$cache_dir,
+        os.path.basename(abspath, alloc),
+        (u32)(path_hash >> 32),
+        (u32)path_hash,
+        kind
+    );
+}
+
+static inline bool
+_cexy__slice_in(str_s s, str_s code)
 {
-    uassert(allocator != NULL);
+    return s.buf == NULL || (s.buf >= code.buf && s.buf + s.len <= code.buf + code.len);
+}
 
-    if (src_path == NULL || src_path[0] == '\0') {
-        log$error("src_path is NULL or empty\n");
-        return NULL;
-    }
-    if (build_dir == NULL) {
-        log$error("build_dir is NULL\n");
-        return NULL;
-    }
-    if (name_or_extension == NULL || name_or_extension[0] == '\0') {
-        log$error("name_or_extension is NULL or empty\n");
-        return NULL;
-    }
-    if (!os.path.exists(src_path)) {
-        log$error("src_path does not exist: '%s'\n", src_path);
-        return NULL;
-    }
+/// Returns cached data of `kind` for the src_fn with exact `code` contents, or empty str_s
+static str_s
+_cexy__cache_load(char* src_fn, str_s code, char* kind, u64 variant, IAllocator alloc)
+{
+    str_s result = { 0 };
+    char* cache_fn = _cexy__cache_path(src_fn, kind, alloc);
+    if (cache_fn == NULL) { return result; }
 
-    char* result = NULL;
-    if (name_or_extension[0] == '.') {
-        // starts_with .ext, make full path as following: build_dir/src_path/src_file.ext[.exe]
-        result = str.fmt(
-            allocator,
-            "%s%c%s%s%s",
-            build_dir,
-            os$PATH_SEP,
-            src_path,
-            name_or_extension,
-            cexy$build_ext_exe
-        );
-        uassert(result != NULL && "memory error");
-    } else {
-        // probably a program name, make full path: build_dir/name_or_extension[.exe]
-        result = str.fmt(
-            allocator,
-            "%s%c%s%s",
-            build_dir,
-            os$PATH_SEP,
-            name_or_extension,
-            cexy$build_ext_exe
-        );
-        uassert(result != NULL && "memory error");
+    os_fs_stat_s st = os.fs.stat(src_fn);
+    if (!st.is_valid || st.size != code.len) { return result; }
+
+    FILE* fh = NULL;
+    if (io.fopen(&fh, cache_fn, "rb")) { return result; }
+    str_s content = { 0 };
+    Exc err = io.fread_all(fh, &content, alloc);
+    io.fclose(&fh);
+    if (err || content.len < sizeof(_cexy__cache_hdr_s)) { return result; }
+
+    _cexy__cache_hdr_s hdr;
+    memcpy(&hdr, content.buf, sizeof(hdr));
+    char* abspath = os.path.abs(src_fn, alloc);
+    str_s cached_path = { .buf = content.buf + sizeof(hdr), .len = hdr.path_len };
+    if (memcmp(hdr.magic, "CEXYC001", sizeof(hdr.magic)) != 0 || hdr.src_size != code.len ||
+        hdr.src_mtime != (i64)st.mtime || hdr.variant != _cexy__cache_variant(variant) ||
+        content.len != sizeof(hdr) + hdr.path_len + hdr.data_len ||
+        !str.slice.eq(str.sstr(abspath), cached_path)) {
+        return result;
     }
-    e$except (err, os.fs.mkpath(result)) { mem$free(allocator, result); }
+    if (hdr.src_hash != _cexy__cache_hash(code.buf, code.len, 0)) { return result; }
 
+    result.buf = content.buf + sizeof(hdr) + hdr.path_len;
+    result.len = hdr.data_len;
     return result;
 }
 
-Exception
-cexy__fuzz__create(char* target)
+/// Saves `data` of `kind` for the src_fn, the cache is optional so errors are only logged
+static void
+_cexy__cache_save(char* src_fn, str_s code, char* kind, u64 variant, str_s data)
 {
-    if (!str.slice.starts_with(os.path.split(target, false), str$s("fuzz_"))) {
-        return e$raise(Error.argument, "Fuzz file must start with `fuzz_` prefix, got: %s", target);
-    }
-    if (os.path.exists(target)) {
-        return e$raise(Error.exists, "Fuzz file already exists: %s", target);
-    }
-    e$ret(os.fs.mkpath(target));
-
     mem$scope(tmem$, _)
     {
-        sbuf_c buf = sbuf.create(1024 * 10, _);
-        cg$init(&buf);
-        cg$pn("#define CEX_IMPLEMENTATION");
-        cg$pn("#include \"cex.h\"");
+        char* cache_fn = _cexy__cache_path(src_fn, kind, _);
+        if (cache_fn == NULL) { return; }
+        os_fs_stat_s st = os.fs.stat(src_fn);
+        if (!st.is_valid || st.size != code.len) { return; }
+
+        char* abspath = os.path.abs(src_fn, _);
+        _cexy__cache_hdr_s hdr = {
+            .src_size = code.len,
+            .src_mtime = st.mtime,
+            .src_hash = _cexy__cache_hash(code.buf, code.len, 0),
+            .variant = _cexy__cache_variant(variant),
+            .path_len = str.len(abspath),
+            .data_len = data.len,
+        };
+        memcpy(hdr.magic, "CEXYC001", sizeof(hdr.magic));
+
+        e$except_silent (err, os.fs.mkpath(cache_fn)) { return; }
+        // atomic replace, concurrent cexy processes never see partially written cache
+        str_s parts[] = {
+            { .buf = (char*)&hdr, .len = sizeof(hdr) },
+            { .buf = abspath, .len = hdr.path_len },
+            data,
+        };
+        e$except_silent (err, io.file.save_atomic(cache_fn, parts, arr$len(parts), false)) {
+            log$debug("Cache write failed: %s (%s)\n", cache_fn, err);
+        }
+    }
+}
 
-        cg$pn("");
-        cg$pn("/*");
-        cg$func("fuzz$setup(void)", "")
-        {
-            cg$pn("// This function allows programmatically seed new corpus for fuzzer");
-            cg$pn("io.printf(\"CORPUS: %s\\n\", fuzz$corpus_dir);");
-            cg$scope("memcg$scope(tmem$, _)", "")
-            {
-                cg$pn("char* fn = str.fmt(_, \"%s/my_case\", fuzz$corpus_dir);");
-                cg$pn("(void)fn;");
-                cg$pn("// io.file.save(fn, \"my seed data\");");
+/*
+ *  Include dependency graph: cexy$cache_dir/<target>.<path hash>.deps, has all transitive
+ *  `#include "..."` files of the target source with their size, mtime and content hash (and
+ *  include candidates which did not exist). Valid until the target itself is rebuilt.
+ */
+typedef struct _cexy__deps_hdr_s
+{
+    char magic[8]; // "CEXYD001" without zero terminator
+    u64 variant; // hash of src path and include search paths
+    u64 target_size;
+    i64 target_mtime;
+    u32 n_deps;
+    u32 paths_len;
+} _cexy__deps_hdr_s;
+
+typedef struct _cexy__deps_rec_s
+{
+    u64 size;
+    i64 mtime;
+    u64 hash;
+    u32 path_off; // zero terminated path in paths blob
+    u32 is_file;  // 0 - include candidate which didn't exist at scan time
+} _cexy__deps_rec_s;
+
+/// Lexical path normalization (drops `.` and `dir/..` parts), keeps graph paths unique
+static char*
+_cexy__path_normalize(char* path, IAllocator alloc)
+{
+    usize len = str.len(path);
+    char* result = mem$malloc(alloc, len + 2);
+    if (result == NULL) { return NULL; }
+
+    usize n = 0;
+    if (path[0] == '/' || path[0] == '\\') { result[n++] = os$PATH_SEP; }
+    usize root = n;
+    for (usize i = 0; i < len; i++) {
+        usize seg_len = 0;
+        while (i + seg_len < len && path[i + seg_len] != '/' && path[i + seg_len] != '\\') {
+            seg_len++;
+        }
+        char* seg = path + i;
+        i += seg_len;
+        if (seg_len == 0 || (seg_len == 1 && seg[0] == '.')) { continue; }
+
+        usize last = n;
+        while (last > root && result[last - 1] != os$PATH_SEP) { last--; }
+        bool is_last_up = n - last == 2 && result[last] == '.' && result[last + 1] == '.';
+        if (seg_len == 2 && seg[0] == '.' && seg[1] == '.' && !is_last_up) {
+            if (n > root) {
+                // parent of previous segment
+                n = (last > root) ? last - 1 : root;
+                continue;
+            } else if (root > 0) {
+                // parent of root is root
+                continue;
             }
         }
-        cg$pn("*/");
+        if (n > root) { result[n++] = os$PATH_SEP; }
+        memcpy(result + n, seg, seg_len);
+        n += seg_len;
+    }
+    if (n == 0) { result[n++] = '.'; }
+    result[n] = '\0';
+    return result;
+}
 
-        cg$pn("");
-        cg$func("int\nfuzz$case(const u8* data, usize size)", "")
-        {
-            cg$pn("// TODO: do your stuff based on input data and size");
-            cg$if("size > 2 && data[0] == 'C' && data[1] == 'E' && data[2] == 'X'", "")
-            {
-                cg$pn("__builtin_trap();");
+/// Checks dependency graph of the target, returns 1 - changed, 0 - up to date, -1 - no valid graph
+static int
+_cexy__deps_check(char* deps_fn, u64 variant, os_fs_stat_s target_meta, IAllocator _)
+{
+    if (deps_fn == NULL) { return -1; }
+
+    FILE* fh = NULL;
+    if (io.fopen(&fh, deps_fn, "rb")) { return -1; }
+    str_s content = { 0 };
+    Exc err = io.fread_all(fh, &content, _);
+    io.fclose(&fh);
+    if (err || content.len < sizeof(_cexy__deps_hdr_s)) { return -1; }
+
+    _cexy__deps_hdr_s hdr;
+    memcpy(&hdr, content.buf, sizeof(hdr));
+    usize recs_len = (usize)hdr.n_deps * sizeof(_cexy__deps_rec_s);
+    if (memcmp(hdr.magic, "CEXYD001", sizeof(hdr.magic)) != 0 ||
+        hdr.variant != _cexy__cache_variant(variant) ||
+        hdr.target_size != target_meta.size || hdr.target_mtime != (i64)target_meta.mtime ||
+        content.len != sizeof(hdr) + recs_len + hdr.paths_len || hdr.paths_len == 0 ||
+        content.buf[content.len - 1] != '\0') {
+        return -1;
+    }
+
+    char* recs = content.buf + sizeof(hdr);
+    char* paths = recs + recs_len;
+    bool is_touched = false;
+    time_t now = time(NULL);
+    for (u32 i = 0; i < hdr.n_deps; i++) {
+        _cexy__deps_rec_s rec;
+        memcpy(&rec, recs + i * sizeof(rec), sizeof(rec));
+        if (rec.path_off >= hdr.paths_len) { return -1; }
+        char* dep_fn = paths + rec.path_off;
+
+        auto meta = os.fs.stat(dep_fn);
+        if (!rec.is_file) {
+            if (meta.is_valid && meta.is_file) {
+                log$debug("Include added: %s\n", dep_fn);
+                return 1;
             }
-            cg$pn("return 0;");
+            continue;
+        }
+        if (!meta.is_valid || !meta.is_file) {
+            log$debug("Include removed: %s\n", dep_fn);
+            return 1;
         }
+        if (meta.size == rec.size && (i64)meta.mtime == rec.mtime) { continue; }
 
-        cg$pn("");
-        cg$pn("fuzz$main();");
+        // Metadata changed, but contents may be the same (touch, checkout, editor save)
+        char* code = (meta.size == rec.size) ? io.file.load(dep_fn, _) : NULL;
+        if (code == NULL || _cexy__cache_hash(code, str.len(code), 0) != rec.hash) {
+            log$debug("Src changed: %s\n", dep_fn);
+            return 1;
+        }
+        if (meta.mtime < now) {
+            // NOTE: mtime of current second is racy, same size edits may follow unnoticed
+            rec.mtime = meta.mtime;
+            memcpy(recs + i * sizeof(rec), &rec, sizeof(rec));
+            is_touched = true;
+        }
+    }
 
-        e$ret(io.file.save(target, buf));
+    if (is_touched) {
+        // Refresh mtimes, next check stays on stat() only
+        str_s parts[] = { content };
+        e$except_silent (err, io.file.save_atomic(deps_fn, parts, arr$len(parts), false)) {
+            log$debug("Deps write failed: %s (%s)\n", deps_fn, err);
+        }
     }
-    return EOK;
+    return 0;
 }
 
-Exception
-cexy__test__create(char* target, bool include_sample)
+/// Full scan of transitive includes of src_path, returns true if any of them is newer than the
+/// target. Otherwise saves dependency graph for the next _cexy__deps_check()
+static bool
+_cexy__deps_scan(
+    char* deps_fn,
+    u64 variant,
+    char* src_path,
+    arr$(char*) incl_path,
+    bool with_file_dir,
+    os_fs_stat_s target_meta,
+    IAllocator _
+)
 {
-    if (os.path.exists(target)) {
-        return e$raise(Error.exists, "Test file already exists: %s", target);
-    }
-    if (str.eq(target, "all") || str.find(target, "*")) {
-        return e$raise(
-            Error.argument,
-            "You must pass exact file path, not pattern, got: %s",
-            target
+    arr$(_cexy__deps_rec_s) deps = arr$new(deps, _, .capacity = 64);
+    arr$(char) paths = arr$new(paths, _, .capacity = 4096);
+    arr$(char*) queue = arr$new(queue, _, .capacity = 64);
+    hm$(char*, bool) visited = hm$new(visited, _, .capacity = 256);
+
+    char* src_norm = _cexy__path_normalize(src_path, _);
+    uassert(src_norm != NULL);
+    arr$push(queue, src_norm);
+    hm$set(visited, src_norm, true);
+    time_t now = time(NULL);
+
+    for (usize qi = 0; qi < arr$len(queue); qi++) {
+        char* dep_fn = queue[qi];
+        auto meta = os.fs.stat(dep_fn);
+        if (!meta.is_valid || meta.mtime > target_meta.mtime) {
+            log$debug("Src changed: %s\n", dep_fn);
+            return true;
+        }
+        char* code = io.file.load(dep_fn, _);
+        if (code == NULL) {
+            log$debug("Src not readable: %s\n", dep_fn);
+            return true;
+        }
+        arr$push(
+            deps,
+            (_cexy__deps_rec_s){
+                .size = meta.size,
+                .mtime = (meta.mtime < now) ? meta.mtime : 0, // racy mtime, rehash next time
+                .hash = _cexy__cache_hash(code, str.len(code), 0),
+                .path_off = arr$len(paths),
+                .is_file = 1,
+            }
         );
-    }
-    e$ret(os.fs.mkpath(target));
+        arr$pusha(paths, dep_fn, str.len(dep_fn) + 1);
 
-    mem$scope(tmem$, _)
-    {
-        sbuf_c buf = sbuf.create(1024 * 10, _);
-        cg$init(&buf);
-        cg$pn("#define CEX_IMPLEMENTATION");
-        cg$pn("#define CEX_TEST");
-        cg$pn("#include \"cex.h\"");
-        if (include_sample) { cg$pn("#include \"lib/mylib.c\""); }
-        cg$pn("");
-        cg$pn("//test$setup_case() {return EOK;}");
-        cg$pn("//test$teardown_case() {return EOK;}");
-        cg$pn("//test$setup_suite() {return EOK;}");
-        cg$pn("//test$teardown_suite() {return EOK;}");
-        cg$pn("");
-        cg$scope("test$case(%s)", (include_sample) ? "mylib_test_case" : "my_test_case")
-        {
-            if (include_sample) {
-                cg$pn("tassert_eq(mylib_add(1, 2), 3);");
-                cg$pn("// Next will be available after calling `cex process lib/mylib.c`");
-                cg$pn("// tassert_eq(mylib.add(1, 2), 3);");
-            } else {
-                cg$pn("tassert_eq(1, 0);");
+        char* file_dir = (with_file_dir) ? os.path.dirname(dep_fn, _) : NULL;
+        (void)CexTkn_str;
+        CexParser_c lx = CexParser.create(code, 0, true);
+        cex_token_s t;
+        while ((t = CexParser.next_token(&lx)).type) {
+            if (t.type != CexTkn__preproc) { continue; }
+            if (!str.slice.starts_with(t.value, str$s("include"))) { continue; }
+            str_s incf = str.slice.sub(t.value, strlen("include"), 0);
+            incf = str.slice.strip(incf);
+            if (incf.len <= 4) { // <.h>
+                log$warn("Bad include in: %s (item: %S at line: %d)\n", dep_fn, t.value, lx.line);
+                continue;
+            }
+            log$trace("Processing include: '%S'\n", incf);
+            if (!str.slice.match(incf, "\"*.[hc]\"*")) {
+                // system includes skipped
+                log$trace("Skipping include: '%S'\n", incf);
+                continue;
+            }
+            incf = str.slice.sub(incf, 1, 0);
+            incf = str.slice.sub(incf, 0, str.slice.index_of(incf, str$s("\"")) - 1);
+
+            char extensions[] = { 'c', 'h' };
+            for$each (ext, extensions) {
+                char* inc_fn = str.fmt(_, "%S%c", incf, ext);
+                uassert(inc_fn != NULL);
+                for (usize di = 0; di <= arr$len(incl_path); di++) {
+                    char* inc_dir = (di < arr$len(incl_path)) ? incl_path[di] : file_dir;
+                    if (inc_dir == NULL) { continue; }
+                    char* try_path = _cexy__path_normalize(os$path_join(_, inc_dir, inc_fn), _);
+                    uassert(try_path != NULL);
+                    if (hm$get(visited, try_path)) { continue; }
+                    hm$set(visited, try_path, true);
+
+                    log$trace("Probing include: %s\n", try_path);
+                    auto inc_meta = os.fs.stat(try_path);
+                    if (inc_meta.is_valid && inc_meta.is_file) {
+                        arr$push(queue, try_path);
+                    } else {
+                        arr$push(deps, (_cexy__deps_rec_s){ .path_off = arr$len(paths) });
+                        arr$pusha(paths, try_path, str.len(try_path) + 1);
+                    }
+                }
             }
-            cg$pn("return EOK;");
         }
-        cg$pn("");
-        cg$pn("test$main();");
+    }
+
+    if (deps_fn != NULL) {
+        _cexy__deps_hdr_s hdr = {
+            .variant = _cexy__cache_variant(variant),
+            .target_size = target_meta.size,
+            .target_mtime = target_meta.mtime,
+            .n_deps = arr$len(deps),
+            .paths_len = arr$len(paths),
+        };
+        memcpy(hdr.magic, "CEXYD001", sizeof(hdr.magic));
+        e$except_silent (err, os.fs.mkpath(deps_fn)) { return false; }
+        str_s parts[] = {
+            { .buf = (char*)&hdr, .len = sizeof(hdr) },
+            { .buf = (char*)deps, .len = arr$len(deps) * sizeof(*deps) },
+            { .buf = paths, .len = arr$len(paths) },
+        };
+        e$except_silent (err, io.file.save_atomic(deps_fn, parts, arr$len(parts), false)) {
+            log$debug("Deps write failed: %s (%s)\n", deps_fn, err);
+        }
+    }
+    return false;
+}
+
+/// Parses all declarations of the src_fn `code` (CexParser.decl_parse() with ignore_kw), results
+/// are cached. Returns Error.integrity on parsing error, out_decls has all decls before error.
+static Exception
+_cexy__decls_parse(
+    char* src_fn,
+    char* code,
+    char* ignore_kw,
+    IAllocator alloc,
+    arr$(cex_decl_s*) * out_decls
+)
+{
+    uassert(out_decls && *out_decls);
+    str_s code_s = str.sstr(code);
+    u64 variant = (ignore_kw) ? _cexy__cache_hash(ignore_kw, str.len(ignore_kw), 1) : 0;
+
+    usize n_before = arr$len(*out_decls);
+    str_s cached = _cexy__cache_load(src_fn, code_s, "decls", variant, alloc);
+    if (cached.buf && cached.len >= sizeof(u32)) {
+        u32 n_decls;
+        memcpy(&n_decls, cached.buf, sizeof(u32));
+        usize off = sizeof(u32);
+        for (u32 i = 0; i < n_decls; i++) {
+            _cexy__cache_decl_s r;
+            if (off + sizeof(r) > cached.len) { goto corrupted; }
+            memcpy(&r, cached.buf + off, sizeof(r));
+            off += sizeof(r);
+            if (off + r.ret_type_len + r.args_len > cached.len ||
+                (usize)r.name_off + r.name_len > code_s.len ||
+                (r.docs_off != UINT32_MAX && (usize)r.docs_off + r.docs_len > code_s.len) ||
+                (r.body_off != UINT32_MAX && (usize)r.body_off + r.body_len > code_s.len)) {
+                goto corrupted;
+            }
+
+            cex_decl_s* d = mem$new(alloc, cex_decl_s);
+            d->name = (str_s){ .buf = code + r.name_off, .len = r.name_len };
+            if (r.docs_off != UINT32_MAX) {
+                d->docs = (str_s){ .buf = code + r.docs_off, .len = r.docs_len };
+            }
+            if (r.body_off != UINT32_MAX) {
+                d->body = (str_s){ .buf = code + r.body_off, .len = r.body_len };
+            }
+            d->ret_type = sbuf.create(r.ret_type_len + 1, alloc);
+            d->args = sbuf.create(r.args_len + 1, alloc);
+            str_s ret_type = { .buf = cached.buf + off, .len = r.ret_type_len };
+            off += r.ret_type_len;
+            str_s args = { .buf = cached.buf + off, .len = r.args_len };
+            off += r.args_len;
+            e$ret(sbuf.appendf(&d->ret_type, "%S", ret_type));
+            e$ret(sbuf.appendf(&d->args, "%S", args));
+            d->file = src_fn;
+            d->line = r.line;
+            d->type = r.type;
+            d->is_static = r.is_static;
+            d->is_inline = r.is_inline;
+            arr$push(*out_decls, d);
+        }
+        return EOK;
 
-        e$ret(io.file.save(target, buf));
+    corrupted:
+        log$debug("Cache corrupted for: %s\n", src_fn);
+        while (arr$len(*out_decls) > n_before) {
+            CexParser.decl_free(arr$pop(*out_decls), alloc);
+        }
     }
-    return EOK;
-}
 
-Exception
-cexy__test__clean(char* target)
-{
+    arr$(cex_token_s) items = arr$new(items, alloc);
+    sbuf_c data = sbuf.create(1024 * 16, alloc);
+    u32 n_decls = 0;
+    e$ret(sbuf.appendf(&data, "%S", (str_s){ .buf = (char*)&n_decls, .len = sizeof(n_decls) }));
 
-    if (str.eq(target, "all")) {
-        log$info("Cleaning all tests\n");
-        e$ret(os.fs.remove_tree(cexy$build_dir "/tests/"));
-    } else {
-        log$info("Cleaning target: %s\n", target);
-        if (!os.path.exists(target)) {
-            return e$raise(Error.exists, "Test target not exists: %s", target);
+    bool is_cacheable = true;
+    CexParser_c lx = CexParser.create(code, code_s.len, true);
+    cex_token_s t;
+    while ((t = CexParser.next_entity(&lx, &items)).type) {
+        if (t.type == CexTkn__error) {
+            return e$raise(
+                Error.integrity,
+                "Error parsing file %s, at line: %d, cursor: %d",
+                src_fn,
+                lx.line,
+                (i32)(lx.cur - lx.content)
+            );
         }
-
-        mem$scope(tmem$, _)
-        {
-            char* test_target = cexy.target_make(target, cexy$build_dir, ".test", _);
-            e$ret(os.fs.remove(test_target));
+        cex_decl_s* d = CexParser.decl_parse(&lx, t, items, ignore_kw, alloc);
+        if (d == NULL) { continue; }
+        d->file = src_fn;
+        arr$push(*out_decls, d);
+        if (!_cexy__slice_in(d->name, code_s) || !_cexy__slice_in(d->docs, code_s) ||
+            !_cexy__slice_in(d->body, code_s)) {
+            is_cacheable = false;
+            continue;
         }
+
+        _cexy__cache_decl_s r = {
+            .name_off = d->name.buf - code,
+            .name_len = d->name.len,
+            .docs_off = (d->docs.buf) ? (u32)(d->docs.buf - code) : UINT32_MAX,
+            .docs_len = d->docs.len,
+            .body_off = (d->body.buf) ? (u32)(d->body.buf - code) : UINT32_MAX,
+            .body_len = d->body.len,
+            .ret_type_len = sbuf.len(&d->ret_type),
+            .args_len = sbuf.len(&d->args),
+            .line = d->line,
+            .type = d->type,
+            .is_static = d->is_static,
+            .is_inline = d->is_inline,
+        };
+        e$ret(sbuf.appendf(&data, "%S", (str_s){ .buf = (char*)&r, .len = sizeof(r) }));
+        e$ret(sbuf.appendf(&data, "%s%s", d->ret_type, d->args));
+        n_decls++;
+    }
+    memcpy(data, &n_decls, sizeof(n_decls));
+    if (is_cacheable) {
+        str_s payload = { .buf = data, .len = sbuf.len(&data) };
+        _cexy__cache_save(src_fn, code_s, "decls", variant, payload);
     }
+    sbuf.destroy(&data);
+    arr$free(items);
     return EOK;
 }
 
-Exception
-cexy__test__make_target_pattern(char** target)
+/*
+ *  Worker pool for independent per-file jobs (parsing, codegen). Each worker thread has its own
+ *  tmem$ arena, job results must be stored by index and merged by caller in index order.
+ */
+typedef struct _cexy__parallel_s
 {
-    if (target == NULL) {
-        return e$raise(
-            Error.argsparse,
-            "Invalid target: '(null)', expected all or tests/test_some_file.c"
-        );
-    }
-    if (str.eq(*target, "all")) { *target = "tests/test_*.c"; }
+    Exception (*job_fn)(u32 idx, void* ctx);
+    void* ctx;
+    Exc* errors;
+    u32 n_jobs;
+    u32 next_job; // atomic
+} _cexy__parallel_s;
 
-    if (!str.match(*target, "*test*.c")) {
-        return e$raise(
-            Error.argsparse,
-            "Invalid target: '%s', expected all or tests/test_some_file.c",
-            *target
-        );
+static void
+_cexy__parallel_worker_loop(_cexy__parallel_s* p)
+{
+    while (true) {
+        u32 idx = __atomic_fetch_add(&p->next_job, 1, __ATOMIC_RELAXED);
+        if (idx >= p->n_jobs) { break; }
+        p->errors[idx] = p->job_fn(idx, p->ctx);
     }
-    return EOK;
 }
 
-Exception
-cexy__test__run(char* target, bool is_debug, int argc, char** argv)
+#    if defined(CEX_HAS_THREADS)
+static _cex_thread_fn(_cexy__parallel_worker, arg)
+{
+    _cexy__parallel_worker_loop(arg);
+    // tmem$ is thread local, pages must be released before thread exit
+    _cex_allocator_temp_cleanup();
+    return 0;
+}
+#    endif
+
+/// Runs job_fn(0..n_jobs-1) on up to cexy$parallel_jobs threads (0 - cpu count), returns error of
+/// the first failed job (in job index order, i.e. deterministic)
+static Exception
+_cexy__parallel_for(u32 n_jobs, Exception (*job_fn)(u32 idx, void* ctx), void* ctx)
 {
+    uassert(job_fn != NULL);
+    if (n_jobs == 0) { return EOK; }
+
+    u32 n_threads = (cexy$parallel_jobs > 0) ? cexy$parallel_jobs : os.platform.cpu_count();
+    if (n_threads > n_jobs) { n_threads = n_jobs; }
+
     Exc result = EOK;
-    u32 n_tests = 0;
-    u32 n_failed = 0;
     mem$scope(tmem$, _)
     {
-        if (str.ends_with(target, "test_*.c")) {
-            // quiet mode
-            io.printf("-------------------------------------\n");
-            io.printf("Running Tests: %s\n", target);
-            io.printf("-------------------------------------\n\n");
-        } else {
-            if (!os.path.exists(target)) {
-                return e$raise(Error.not_found, "Test file not found: %s", target);
-            }
+        _cexy__parallel_s p = {
+            .job_fn = job_fn,
+            .ctx = ctx,
+            .errors = mem$calloc(_, n_jobs, sizeof(Exc)),
+            .n_jobs = n_jobs,
+        };
+
+#    if defined(CEX_HAS_THREADS)
+        // current thread is also a worker
+        u32 n_spawned = 0;
+        _cex_thread_t* threads = mem$calloc(_, n_threads, sizeof(_cex_thread_t));
+        for (u32 i = 1; i < n_threads; i++) {
+            if (!_cex_thread_spawn(&threads[n_spawned], _cexy__parallel_worker, &p)) { break; }
+            n_spawned++;
         }
+        _cexy__parallel_worker_loop(&p);
+        for (u32 i = 0; i < n_spawned; i++) { _cex_thread_join(threads[i]); }
+#    else
+        (void)n_threads;
+        _cexy__parallel_worker_loop(&p);
+#    endif
 
-        for$each (test_src, os.fs.find(target, true, _)) {
-            n_tests++;
-            char* test_target = cexy.target_make(test_src, cexy$build_dir, ".test", _);
-            arr$(char*) args = arr$new(args, _);
-            if (is_debug) { arr$pushm(args, cexy$debug_cmd); }
-            arr$pushm(args, test_target, );
-            if (str.ends_with(target, "test_*.c")) { arr$push(args, "--quiet"); }
-            arr$pusha(args, argv, argc);
-            arr$push(args, NULL);
-            if (os$cmda(args)) {
-                log$error("<<<<<<<<<<<<<<<<<< Test failed: %s\n", test_target);
-                n_failed++;
-                result = Error.runtime;
+        for (u32 i = 0; i < n_jobs; i++) {
+            if (p.errors[i] != EOK) {
+                result = p.errors[i];
+                break;
             }
         }
     }
-    if (str.ends_with(target, "test_*.c")) {
-        io.printf("\n-------------------------------------\n");
-        io.printf("Total: %d Passed: %d Failed: %d\n", n_tests, n_tests - n_failed, n_failed);
-        io.printf("-------------------------------------\n\n");
-    }
     return result;
 }
 
@@ -15973,6 +20730,475 @@ _cexy__fn_dotted(str_s fn_name, char* expected_ns, IAllocator alloc)
     }
 }
 
+typedef struct _cexy__json_field_s
+{
+    str_s name; // C field name (and JSON key)
+    str_s type; // C type (without pointer)
+    char* kind; // bool, int, uint, i64, float, cstr, cbuf, str, obj, objptr
+    char* min;  // int range for kind int/uint
+    char* max;
+} _cexy__json_field_s;
+
+static Exception
+_cexy__json_parse_fields(
+    cex_decl_s* decl,
+    arr$(str_s) json_types,
+    arr$(_cexy__json_field_s)* out_fields,
+    IAllocator alloc
+)
+{
+    // clang-format off
+    static struct { char* type; char* kind; char* min; char* max; } types[] = {
+        {"bool", "bool", 0, 0}, {"_Bool", "bool", 0, 0},
+        {"i8", "int", "INT8_MIN", "INT8_MAX"}, {"i16", "int", "INT16_MIN", "INT16_MAX"},
+        {"i32", "int", "INT32_MIN", "INT32_MAX"}, {"int", "int", "INT_MIN", "INT_MAX"},
+        {"isize", "int", "PTRDIFF_MIN", "PTRDIFF_MAX"}, {"i64", "i64", 0, 0},
+        {"u8", "uint", "0", "UINT8_MAX"}, {"u16", "uint", "0", "UINT16_MAX"},
+        {"u32", "uint", "0", "UINT32_MAX"}, {"usize", "uint", "0", "SIZE_MAX"},
+        {"u64", "uint", "0", "UINT64_MAX"},
+        {"f32", "float", 0, 0}, {"f64", "float", 0, 0},
+        {"float", "float", 0, 0}, {"double", "float", 0, 0},
+        {"str_s", "str", 0, 0},
+    };
+    // clang-format on
+
+    str_s body = str.slice.sub(decl->body, 1, -1); // strip {}
+    CexParser_c lx = CexParser.create(body.buf, body.len, true);
+    arr$(cex_token_s) ftoks = arr$new(ftoks, alloc);
+    cex_token_s t;
+    char* field_start = NULL;
+    while ((t = CexParser.next_token(&lx)).type) {
+        if (t.type == CexTkn__comment_single || t.type == CexTkn__comment_multi) { continue; }
+        if (t.type == CexTkn__ident && str.slice.match(t.value, "(const|volatile)")) { continue; }
+        if (field_start == NULL) { field_start = t.value.buf; }
+        if (t.type != CexTkn__eos) {
+            arr$push(ftoks, t);
+            continue;
+        }
+
+        str_s ftext = { .buf = field_start, .len = t.value.buf - field_start };
+        (void)ftext; // used only in error message
+        field_start = NULL;
+        usize n = arr$len(ftoks);
+        _cexy__json_field_s f = { 0 };
+        u32 n_stars = 0;
+        bool is_fixed_arr = false;
+        if (n >= 2 && ftoks[n - 1].type == CexTkn__bracket_block) {
+            is_fixed_arr = true;
+            n--;
+        }
+        if (n < 2 || ftoks[n - 1].type != CexTkn__ident) { goto unsupported; }
+        f.name = ftoks[n - 1].value;
+        for (usize i = 0; i < n - 1; i++) {
+            if (ftoks[i].type == CexTkn__star) {
+                n_stars++;
+            } else if (ftoks[i].type == CexTkn__ident && f.type.buf == NULL && n_stars == 0) {
+                f.type = ftoks[i].value;
+            } else {
+                goto unsupported;
+            }
+        }
+
+        if (is_fixed_arr) {
+            if (n_stars == 0 && str.slice.eq(f.type, str$s("char"))) { f.kind = "cbuf"; }
+        } else if (n_stars == 1) {
+            if (str.slice.eq(f.type, str$s("char"))) { f.kind = "cstr"; }
+            for$each (jt, json_types) {
+                if (str.slice.eq(f.type, jt)) { f.kind = "objptr"; }
+            }
+        } else if (n_stars == 0) {
+            for$each (it, types) {
+                if (str.slice.eq(f.type, str.sstr(it.type))) {
+                    f.kind = it.kind;
+                    f.min = it.min;
+                    f.max = it.max;
+                }
+            }
+            for$each (jt, json_types) {
+                if (str.slice.eq(f.type, jt)) { f.kind = "obj"; }
+            }
+        }
+        if (f.kind == NULL) { goto unsupported; }
+        arr$push(*out_fields, f);
+        arr$clear(ftoks);
+        continue;
+
+    unsupported:
+        return e$raise(
+            Error.integrity,
+            "Unsupported JSON field in %S (line: %d): '%S'",
+            decl->name,
+            decl->line,
+            str.slice.strip(ftext)
+        );
+    }
+    if (t.type == CexTkn__error) {
+        return e$raise(Error.integrity, "Error parsing struct %S", decl->name);
+    }
+    if (arr$len(*out_fields) == 0) {
+        return e$raise(Error.integrity, "No JSON fields in struct %S", decl->name);
+    }
+    return EOK;
+}
+
+static void
+_cexy__json_gen_decode_field(_cex__codegen_s* cg$var, _cexy__json_field_s* f)
+{
+    char* kind = f->kind;
+    if (str.eq(kind, "bool")) {
+        cg$pf("jr$egoto(jr, jr$get_bool(jr, &out->%S), fail);", f->name);
+    } else if (str.eq(kind, "i64")) {
+        cg$pf("jr$egoto(jr, jr$get_i64(jr, &out->%S), fail);", f->name);
+    } else if (str.eq(kind, "int")) {
+        cg$pn("i64 n = 0;");
+        cg$pn("jr$egoto(jr, jr$get_i64(jr, &n), fail);");
+        cg$pf("if (n < %s || n > %s) { jr$egoto(jr, Error.overflow, fail); }", f->min, f->max);
+        cg$pf("out->%S = (%S)n;", f->name, f->type);
+    } else if (str.eq(kind, "uint")) {
+        cg$pn("u64 n = 0;");
+        cg$pn("jr$egoto(jr, jr$get_u64(jr, &n), fail);");
+        if (!str.eq(f->max, "UINT64_MAX")) {
+            cg$pf("if (n > %s) { jr$egoto(jr, Error.overflow, fail); }", f->max);
+        }
+        cg$pf("out->%S = (%S)n;", f->name, f->type);
+    } else if (str.eq(kind, "float")) {
+        cg$pn("f64 n = 0;");
+        cg$pn("jr$egoto(jr, jr$get_f64(jr, &n), fail);");
+        cg$pf("out->%S = (%S)n;", f->name, f->type);
+    } else if (str.eq(kind, "cstr")) {
+        cg$pf("jr$egoto(jr, jr$get_str_alloc(jr, &out->%S, allc), fail);", f->name);
+    } else if (str.eq(kind, "cbuf")) {
+        cg$pf("jr$egoto(jr, jr$get_str(jr, out->%S, sizeof(out->%S)), fail);", f->name, f->name);
+    } else if (str.eq(kind, "str")) {
+        cg$pn("Exc err_type = (jr->type == JsonType__str) ? EOK : \"Expected string value\";");
+        cg$pn("jr$egoto(jr, err_type, fail);");
+        cg$pf("out->%S = v; // raw JSON value (not unescaped)", f->name);
+    } else if (str.eq(kind, "obj")) {
+        cg$pf("jr$egoto(jr, %S_json_decode(jr, &out->%S, allc), fail);", f->type, f->name);
+    } else if (str.eq(kind, "objptr")) {
+        cg$pf("if (out->%S == NULL) { out->%S = mem$new(allc, %S); }", f->name, f->name, f->type);
+        cg$pf("if (out->%S == NULL) { jr$egoto(jr, Error.memory, fail); }", f->name);
+        cg$pf("jr$egoto(jr, %S_json_decode(jr, out->%S, allc), fail);", f->type, f->name);
+    } else {
+        unreachable();
+    }
+}
+
+static void
+_cexy__json_gen_decode_keys(_cex__codegen_s* cg$var, arr$(_cexy__json_field_s*) fields)
+{
+    // fields with the same key length, dispatching by most distinctive char position
+    usize key_len = fields[0]->name.len;
+    if (arr$len(fields) == 1) {
+        cg$if("memcmp(k.buf, \"%S\", %d) == 0", fields[0]->name, key_len)
+        {
+            _cexy__json_gen_decode_field(cg$var, fields[0]);
+        }
+        return;
+    }
+
+    usize best_pos = 0;
+    u32 best_distinct = 0;
+    for (usize pos = 0; pos < key_len; pos++) {
+        u32 distinct = 0;
+        for$each (f, fields) {
+            bool is_new = true;
+            for$each (prev, fields) {
+                if (prev == f) { break; }
+                if (prev->name.buf[pos] == f->name.buf[pos]) { is_new = false; }
+            }
+            distinct += is_new;
+        }
+        if (distinct > best_distinct) {
+            best_distinct = distinct;
+            best_pos = pos;
+        }
+    }
+
+    cg$switch("k.buf[%d]", best_pos)
+    {
+        for$each (f, fields) {
+            char c = f->name.buf[best_pos];
+            bool is_first = true;
+            for$each (prev, fields) {
+                if (prev == f) { break; }
+                if (prev->name.buf[best_pos] == c) { is_first = false; }
+            }
+            if (!is_first) { continue; }
+            cg$case("'%c'", c)
+            {
+                for$each (f2, fields) {
+                    if (f2->name.buf[best_pos] != c) { continue; }
+                    cg$if("memcmp(k.buf, \"%S\", %d) == 0", f2->name, key_len)
+                    {
+                        _cexy__json_gen_decode_field(cg$var, f2);
+                    }
+                }
+            }
+        }
+    }
+}
+
+static Exception
+_cexy__json_gen_struct(sbuf_c* out_buf, str_s type_name, arr$(_cexy__json_field_s) fields)
+{
+    cg$init(out_buf);
+
+    // Decoder: switch on key length + most distinctive char, and direct field writes
+    cg$pn("/// Decodes JSON object into `out`, allc is used for char* and struct pointer fields");
+    cg$pn("Exception");
+    cg$func("%S_json_decode(jr_c* jr, %S* out, IAllocator allc)\n", type_name, type_name)
+    {
+        cg$pn("(void)allc;");
+        cg$scope("jr$foreach(k, v, jr) ", "")
+        {
+            cg$pn("(void)v;");
+            cg$pn("if (jr->type == JsonType__null) { continue; }");
+            cg$switch("k.len", "")
+            {
+                usize max_len = 0;
+                for$each (f, fields) { max_len = (f.name.len > max_len) ? f.name.len : max_len; }
+                for (usize len = 1; len <= max_len; len++) {
+                    mem$scope(tmem$, _)
+                    {
+                        arr$(_cexy__json_field_s*) same_len = arr$new(same_len, _);
+                        for$eachp(f, fields) {
+                            if (f->name.len == len) { arr$push(same_len, f); }
+                        }
+                        if (arr$len(same_len) == 0) { continue; }
+                        cg$case("%d", len)
+                        {
+                            _cexy__json_gen_decode_keys(cg$var, same_len);
+                        }
+                    }
+                }
+            }
+        }
+        cg$pa("\nfail:\n", "");
+        cg$pn("return jr->error;");
+    }
+    cg$pn("");
+
+    // Encoder: jw$ writer scope
+    cg$pn("/// Encodes `obj` as JSON object into jw$ writer");
+    cg$pn("Exception");
+    cg$func("%S_json_encode(jw_c* jw, %S* obj)\n", type_name, type_name)
+    {
+        cg$scope("jw$scope(jw, JsonType__obj) ", "")
+        {
+            for$each (f, fields) {
+                cg$pf("jw$key(\"%S\");", f.name);
+                if (str.eq(f.kind, "bool")) {
+                    cg$pf("jw$bool(obj->%S);", f.name);
+                } else if (str.eq(f.kind, "cstr")) {
+                    cg$if("obj->%S != NULL", f.name)
+                    {
+                        cg$pf("jw$val(obj->%S);", f.name);
+                    }
+                    cg$else()
+                    {
+                        cg$pn("jw$null();");
+                    }
+                } else if (str.eq(f.kind, "obj")) {
+                    cg$pf("e$ret(%S_json_encode(jw, &obj->%S));", f.type, f.name);
+                } else if (str.eq(f.kind, "objptr")) {
+                    cg$if("obj->%S != NULL", f.name)
+                    {
+                        cg$pf("e$ret(%S_json_encode(jw, obj->%S));", f.type, f.name);
+                    }
+                    cg$else()
+                    {
+                        cg$pn("jw$null();");
+                    }
+                } else if (str.eq(f.kind, "int") || str.eq(f.kind, "uint") ||
+                           str.eq(f.kind, "float")) {
+                    // jw$val() has no overloads for platform types, e.g. int/usize/double
+                    char* cast = str.eq(f.kind, "int") ? "i64" : "u64";
+                    if (str.eq(f.kind, "float")) {
+                        bool is_f32 = str.slice.eq(f.type, str$s("f32")) ||
+                                      str.slice.eq(f.type, str$s("float"));
+                        cast = (is_f32) ? "f32" : "f64";
+                    }
+                    cg$pf("jw$val((%s)obj->%S);", cast, f.name);
+                } else {
+                    cg$pf("jw$val(obj->%S);", f.name);
+                }
+            }
+        }
+        cg$pn("return jw$validate(jw);");
+    }
+    cg$pn("");
+
+    if (!cg$is_valid()) { return e$raise(Error.runtime, "Code generation error occured\n"); }
+    return EOK;
+}
+
+/// Generates JSON decoders/encoders for typedef structs marked by `@json` in docs comment of
+/// header_file. Output file has <type>_json_decode(jr_c*, <type>*, IAllocator) and
+/// <type>_json_encode(jw_c*, <type>*) functions, it must be included after lib/json/json.c and
+/// the header. Supported fields: bool, ints, floats, char*, char[N], str_s, and @json structs.
+static Exception
+cexy__utils__json_codegen(char* header_file, char* out_file)
+{
+    if (header_file == NULL || out_file == NULL) { return Error.argument; }
+    mem$scope(tmem$, _)
+    {
+        char* code = io.file.load(header_file, _);
+        if (code == NULL) { return e$raise(Error.not_found, "Failed loading: %s", header_file); }
+
+        arr$(cex_token_s) items = arr$new(items, _);
+        arr$(cex_decl_s*) decls = arr$new(decls, _);
+        arr$(str_s) json_types = arr$new(json_types, _);
+
+        CexParser_c lx = CexParser.create(code, 0, true);
+        cex_token_s t;
+        while ((t = CexParser.next_entity(&lx, &items)).type) {
+            if (t.type == CexTkn__error) {
+                return e$raise(
+                    Error.integrity,
+                    "Error parsing file %s, at line: %d",
+                    header_file,
+                    lx.line
+                );
+            }
+            if (t.type != CexTkn__typedef) { continue; }
+            cex_decl_s* d = CexParser.decl_parse(&lx, t, items, NULL, _);
+            if (d == NULL || d->body.len == 0 || !str.slice.match(d->docs, "*@json*")) { continue; }
+            bool is_struct = false;
+            for$each (it, items) {
+                if (it.type == CexTkn__ident && str.slice.eq(it.value, str$s("struct"))) {
+                    is_struct = true;
+                    break;
+                }
+            }
+            if (!is_struct) { continue; }
+            arr$push(decls, d);
+            arr$push(json_types, d->name);
+        }
+        if (arr$len(decls) == 0) {
+            return e$raise(Error.not_found, "No structs with @json docs in: %s", header_file);
+        }
+
+        sbuf_c buf = sbuf.create(16 * 1024, _);
+        e$ret(sbuf.appendf(
+            &buf,
+            "// Autogenerated by CEX (./cex process --json %s), do not edit!\n"
+            "// Include after lib/json/json.c and %s\n\n",
+            header_file,
+            os.path.basename(header_file, _)
+        ));
+        for$each (d, decls) {
+            e$ret(sbuf.appendf(
+                &buf,
+                "Exception %S_json_decode(jr_c* jr, %S* out, IAllocator allc);\n"
+                "Exception %S_json_encode(jw_c* jw, %S* obj);\n",
+                d->name,
+                d->name,
+                d->name,
+                d->name
+            ));
+        }
+        e$ret(sbuf.append(&buf, "\n"));
+        for$each (d, decls) {
+            arr$(_cexy__json_field_s) fields = arr$new(fields, _);
+            e$ret(_cexy__json_parse_fields(d, json_types, &fields, _));
+            e$ret(_cexy__json_gen_struct(&buf, d->name, fields));
+        }
+        e$ret(io.file.save(out_file, buf));
+        log$info("JSON codecs generated: %s -> %s\n", header_file, out_file);
+    }
+    return EOK;
+}
+
+typedef struct _cexy__process_ctx_s
+{
+    arr$(char*) src_files;
+    char* ignore_kw;
+    bool only_update;
+} _cexy__process_ctx_s;
+
+static Exception
+_cexy__process_file(u32 idx, void* ctx)
+{
+    _cexy__process_ctx_s* pctx = ctx;
+    char* src_fn = pctx->src_files[idx];
+    bool only_update = pctx->only_update;
+
+    mem$scope(tmem$, _)
+    {
+        e$assert(str.ends_with(src_fn, ".c") && "file must end with .c");
+
+        char* hdr_fn = str.clone(src_fn, _);
+        hdr_fn[str.len(hdr_fn) - 1] = 'h'; // .c -> .h
+
+        str_s ns_prefix = str.sub(os.path.basename(src_fn, _), 0, -2); // src.c -> src
+        log$debug(
+            "Cex Processing src: '%s' hdr: '%s' prefix: '%S'\n",
+            src_fn,
+            hdr_fn,
+            ns_prefix
+        );
+        if (!os.path.exists(hdr_fn)) {
+            if (only_update) {
+                log$debug("CEX skipped (no .h file for: %s)\n", src_fn);
+                return EOK;
+            } else {
+                return e$raise(Error.not_found, "Header file not exists: '%s'", hdr_fn);
+            }
+        }
+        char* code = io.file.load(src_fn, _);
+        e$assert(code && "failed loading code");
+        arr$(cex_decl_s*) all_decls = arr$new(all_decls, _, .capacity = 128);
+        arr$(cex_decl_s*) decls = arr$new(decls, _, .capacity = 128);
+
+        e$ret(_cexy__decls_parse(src_fn, code, pctx->ignore_kw, _, &all_decls));
+        for$each (d, all_decls) {
+            if (d->type != CexTkn__func_def) { continue; }
+            if (d->is_inline && d->is_static) { continue; }
+            if (!_cexy__fn_match(d->name, ns_prefix)) { continue; }
+            log$trace("FN: %S ret_type: '%s' args: '%s'\n", d->name, d->ret_type, d->args);
+            arr$push(decls, d);
+        }
+        if (arr$len(decls) == 0) {
+            log$info("CEX skipped (no cex decls found in : %s)\n", src_fn);
+            return EOK;
+        }
+
+        arr$sort(decls, _cexy__decl_comparator);
+
+        sbuf_c cex_h_struct = sbuf.create(10 * 1024, _);
+        sbuf_c cex_h_var_decl = sbuf.create(1024, _);
+        sbuf_c cex_c_var_def = sbuf.create(10 * 1024, _);
+
+        e$ret(sbuf.appendf(
+            &cex_h_var_decl,
+            "CEX_NAMESPACE struct __cex_namespace__%S %S;\n",
+            ns_prefix,
+            ns_prefix
+        ));
+        e$ret(_cexy__process_gen_struct(ns_prefix, decls, &cex_h_struct));
+        e$ret(_cexy__process_gen_var_def(ns_prefix, decls, &cex_c_var_def));
+        e$ret(_cexy__process_update_code(
+            src_fn,
+            only_update,
+            cex_h_struct,
+            cex_h_var_decl,
+            cex_c_var_def
+        ));
+        e$ret(_cexy__process_update_code(
+            hdr_fn,
+            only_update,
+            cex_h_struct,
+            cex_h_var_decl,
+            cex_c_var_def
+        ));
+
+        // log$info("cex_h_struct: \n%s\n", cex_h_struct);
+        log$info("CEX processed: %s\n", src_fn);
+    }
+    return EOK;
+}
+
 static Exception
 cexy__cmd__process(int argc, char** argv, void* user_ctx)
 {
@@ -15995,11 +21221,15 @@ cexy__cmd__process(int argc, char** argv, void* user_ctx)
     "7. Functions with `static inline` are not included into namespace\n" 
     "8. Functions with prefix `foo__some` are considered internal and not included\n"
     "9. New namespace is created when you use exact foo.c argument, `all` just for updates\n"
+    "\n"
+    "JSON codecs: `process --json path/foo.h` generates path/foo_json.c with\n"
+    "   <type>_json_decode() / <type>_json_encode() for typedef structs with @json in docs\n"
 
     ;
     // clang-format on
 
     char* ignore_kw = cexy$process_ignore_kw;
+    bool is_json = false;
     argparse_c cmd_args = {
         .program_name = "./cex",
         .usage = "process [options] all|path/some_file.c",
@@ -16014,6 +21244,7 @@ cexy__cmd__process(int argc, char** argv, void* user_ctx)
                 "ignore",
                 .help = "ignores `keyword` or `keyword()` from processed function signatures\n  uses cexy$process_ignore_kw"
             ),
+            argparse$opt(&is_json, 'j', "json", .help = "generate JSON codecs for path/foo.h"),
         ),
     };
     e$ret(argparse.parse(&cmd_args, argc, argv));
@@ -16029,6 +21260,18 @@ cexy__cmd__process(int argc, char** argv, void* user_ctx)
     }
 
 
+    if (is_json) {
+        if (!str.ends_with(target, ".h")) {
+            return e$raise(Error.argument, "Expected path/some_file.h, got: '%s'", target);
+        }
+        mem$scope(tmem$, _)
+        {
+            char* out_file = str.fmt(_, "%S_json.c", str.sub(target, 0, -2));
+            e$ret(cexy.utils.json_codegen(target, out_file));
+        }
+        return EOK;
+    }
+
     bool only_update = true;
     if (str.eq(target, "all")) {
         target = "*.c";
@@ -16045,6 +21288,11 @@ cexy__cmd__process(int argc, char** argv, void* user_ctx)
         char* build_path = os.path.abs(cexy$build_dir, _);
         char* test_path = os.path.abs("./tests/", _);
 
+        _cexy__process_ctx_s pctx = {
+            .src_files = arr$new(pctx.src_files, _, .capacity = 128),
+            .ignore_kw = ignore_kw,
+            .only_update = only_update,
+        };
         for$each (src_fn, os.fs.find(target, true, _)) {
             if (only_update) {
                 char* abspath = os.path.abs(src_fn, _);
@@ -16054,90 +21302,117 @@ cexy__cmd__process(int argc, char** argv, void* user_ctx)
             }
             char* basename = os.path.basename(src_fn, _);
             if (str.starts_with(basename, "test") || str.eq(basename, "cex.c")) { continue; }
-            mem$scope(tmem$, _)
-            {
-                e$assert(str.ends_with(src_fn, ".c") && "file must end with .c");
+            arr$push(pctx.src_files, src_fn);
+        }
+        e$ret(_cexy__parallel_for(arr$len(pctx.src_files), _cexy__process_file, &pctx));
+    }
+    return EOK;
+}
 
-                char* hdr_fn = str.clone(src_fn, _);
-                hdr_fn[str.len(hdr_fn) - 1] = 'h'; // .c -> .h
+typedef struct _cexy__file_stats_s
+{
+    u32 n_asserts;
+    u32 n_lines_code;
+    u32 n_lines_comments;
+    u32 n_lines_total;
+    u32 n_loc;
+} _cexy__file_stats_s;
 
-                str_s ns_prefix = str.sub(os.path.basename(src_fn, _), 0, -2); // src.c -> src
-                log$debug(
-                    "Cex Processing src: '%s' hdr: '%s' prefix: '%S'\n",
-                    src_fn,
-                    hdr_fn,
-                    ns_prefix
-                );
-                if (!os.path.exists(hdr_fn)) {
-                    if (only_update) {
-                        log$debug("CEX skipped (no .h file for: %s)\n", src_fn);
-                        continue;
-                    } else {
-                        return e$raise(Error.not_found, "Header file not exists: '%s'", hdr_fn);
+static Exception
+_cexy__stats_parse(char* src_fn, char* code, _cexy__file_stats_s* stats)
+{
+    (void)src_fn; // used only in error message
+    if (code[0] != '\0') { stats->n_lines_total++; }
+    CexParser_c lx = CexParser.create(code, 0, false);
+    cex_token_s t;
+
+    u32 last_line = 0;
+    while ((t = CexParser.next_token(&lx)).type) {
+        if (t.type == CexTkn__error) {
+            return e$raise(
+                Error.integrity,
+                "Error parsing file %s, at line: %d, cursor: %d",
+                src_fn,
+                lx.line,
+                (i32)(lx.cur - lx.content)
+            );
+        }
+        switch (t.type) {
+            case CexTkn__ident:
+                if (t.value.len >= 6) {
+                    // NOTE: code is not modified, it's hashed for the cache
+                    char lower[8];
+                    usize len = (t.value.len < sizeof(lower)) ? t.value.len : sizeof(lower);
+                    for (usize i = 0; i < len; i++) { lower[i] = tolower(t.value.buf[i]); }
+                    str_s ident = { .buf = lower, .len = len };
+                    if (str.slice.starts_with(ident, str$s("uassert")) ||
+                        str.slice.starts_with(ident, str$s("assert")) ||
+                        str.slice.starts_with(ident, str$s("ensure")) ||
+                        str.slice.starts_with(ident, str$s("enforce")) ||
+                        str.slice.starts_with(ident, str$s("expect")) ||
+                        str.slice.starts_with(ident, str$s("e$assert")) ||
+                        str.slice.starts_with(ident, str$s("tassert"))) {
+                        stats->n_asserts++;
                     }
                 }
-                char* code = io.file.load(src_fn, _);
-                e$assert(code && "failed loading code");
-                arr$(cex_token_s) items = arr$new(items, _);
-                arr$(cex_decl_s*) decls = arr$new(decls, _, .capacity = 128);
-
-                CexParser_c lx = CexParser.create(code, 0, true);
-                cex_token_s t;
-                while ((t = CexParser.next_entity(&lx, &items)).type) {
-                    if (t.type == CexTkn__error) {
-                        return e$raise(
-                            Error.integrity,
-                            "Error parsing file %s, at line: %d, cursor: %d",
-                            src_fn,
-                            lx.line,
-                            (i32)(lx.cur - lx.content)
-                        );
+                goto def;
+            case CexTkn__comment_multi: {
+                for$each (c, t.value.buf, t.value.len) {
+                    if (c == '\n') { stats->n_lines_comments++; }
+                }
+            }
+                fallthrough();
+            case CexTkn__comment_single:
+                stats->n_lines_comments++;
+                break;
+            case CexTkn__preproc: {
+                for$each (c, t.value.buf, t.value.len) {
+                    if (c == '\n') {
+                        stats->n_lines_code++;
+                        stats->n_loc++;
                     }
-                    cex_decl_s* d = CexParser.decl_parse(&lx, t, items, cexy$process_ignore_kw, _);
-                    if (d == NULL) { continue; }
-                    if (d->type != CexTkn__func_def) { continue; }
-                    if (d->is_inline && d->is_static) { continue; }
-                    if (!_cexy__fn_match(d->name, ns_prefix)) { continue; }
-                    log$trace("FN: %S ret_type: '%s' args: '%s'\n", d->name, d->ret_type, d->args);
-                    arr$push(decls, d);
                 }
-                if (arr$len(decls) == 0) {
-                    log$info("CEX skipped (no cex decls found in : %s)\n", src_fn);
-                    continue;
+            }
+                fallthrough();
+            default:
+            def:
+                if (last_line < lx.line) {
+                    stats->n_lines_code++;
+                    stats->n_loc++;
+                    stats->n_lines_total += (lx.line - last_line);
+                    last_line = lx.line;
                 }
+                break;
+        }
+    }
+    return EOK;
+}
 
-                arr$sort(decls, _cexy__decl_comparator);
-
-                sbuf_c cex_h_struct = sbuf.create(10 * 1024, _);
-                sbuf_c cex_h_var_decl = sbuf.create(1024, _);
-                sbuf_c cex_c_var_def = sbuf.create(10 * 1024, _);
-
-                e$ret(sbuf.appendf(
-                    &cex_h_var_decl,
-                    "CEX_NAMESPACE struct __cex_namespace__%S %S;\n",
-                    ns_prefix,
-                    ns_prefix
-                ));
-                e$ret(_cexy__process_gen_struct(ns_prefix, decls, &cex_h_struct));
-                e$ret(_cexy__process_gen_var_def(ns_prefix, decls, &cex_c_var_def));
-                e$ret(_cexy__process_update_code(
-                    src_fn,
-                    only_update,
-                    cex_h_struct,
-                    cex_h_var_decl,
-                    cex_c_var_def
-                ));
-                e$ret(_cexy__process_update_code(
-                    hdr_fn,
-                    only_update,
-                    cex_h_struct,
-                    cex_h_var_decl,
-                    cex_c_var_def
-                ));
-
-                // log$info("cex_h_struct: \n%s\n", cex_h_struct);
-                log$info("CEX processed: %s\n", src_fn);
-            }
+typedef struct _cexy__stats_ctx_s
+{
+    arr$(char*) src_files;
+    _cexy__file_stats_s* results;
+} _cexy__stats_ctx_s;
+
+static Exception
+_cexy__stats_file(u32 idx, void* ctx)
+{
+    _cexy__stats_ctx_s* sctx = ctx;
+    char* src_fn = sctx->src_files[idx];
+    _cexy__file_stats_s* fstats = &sctx->results[idx];
+
+    mem$scope(tmem$, _)
+    {
+        char* code = io.file.load(src_fn, _);
+        if (!code) { return e$raise(Error.os, "Error opening file: '%s'", src_fn); }
+
+        str_s cached = _cexy__cache_load(src_fn, str.sstr(code), "stats", 0, _);
+        if (cached.len == sizeof(*fstats)) {
+            memcpy(fstats, cached.buf, sizeof(*fstats));
+        } else {
+            e$ret(_cexy__stats_parse(src_fn, code, fstats));
+            str_s data = { .buf = (char*)fstats, .len = sizeof(*fstats) };
+            _cexy__cache_save(src_fn, str.sstr(code), "stats", 0, data);
         }
     }
     return EOK;
@@ -16211,86 +21486,34 @@ cexy__cmd__stats(int argc, char** argv, void* user_ctx)
         if (verbose) {
             io.printf("Files found: %d excluded: %d\n", hm$len(src_files), hm$len(excl_files));
         }
+        _cexy__stats_ctx_s sctx = {
+            .src_files = arr$new(sctx.src_files, _, .capacity = hm$len(src_files) + 1),
+        };
         for$each (src_fn, src_files) {
             if (hm$getp(excl_files, src_fn.key)) { continue; }
+            if (str.eq(os.path.basename(src_fn.key, _), "cex.h")) { continue; }
+            arr$push(sctx.src_files, src_fn.key);
+        }
+        u32 n_files = arr$len(sctx.src_files);
+        sctx.results = mem$calloc(_, n_files + 1, sizeof(_cexy__file_stats_s));
+        e$ret(_cexy__parallel_for(n_files, _cexy__stats_file, &sctx));
+
+        for (u32 i = 0; i < n_files; i++) {
+            char* src_fn = sctx.src_files[i];
+            _cexy__file_stats_s* fstats = &sctx.results[i];
 
-            char* basename = os.path.basename(src_fn.key, _);
-            if (str.eq(basename, "cex.h")) { continue; }
+            char* basename = os.path.basename(src_fn, _);
             struct code_stats* stats = (str.find(basename, "test") != NULL) ? &test_stats
                                                                             : &code_stats;
-
-            mem$scope(tmem$, _)
-            {
-                char* code = io.file.load(src_fn.key, _);
-                if (!code) { return e$raise(Error.os, "Error opening file: '%s'", src_fn); }
-                stats->n_files++;
-
-                if (code[0] != '\0') { stats->n_lines_total++; }
-                CexParser_c lx = CexParser.create(code, 0, false);
-                cex_token_s t;
-
-                u32 last_line = 0;
-                u32 file_loc = 0;
-                while ((t = CexParser.next_token(&lx)).type) {
-                    if (t.type == CexTkn__error) {
-                        return e$raise(
-                            Error.integrity,
-                            "Error parsing file %s, at line: %d, cursor: %d",
-                            src_fn,
-                            lx.line,
-                            (i32)(lx.cur - lx.content)
-                        );
-                    }
-                    switch (t.type) {
-                        case CexTkn__ident:
-                            if (t.value.len >= 6) {
-                                for (usize i = 0; i < t.value.len; i++) {
-                                    t.value.buf[i] = tolower(t.value.buf[i]);
-                                }
-                                if (str.slice.starts_with(t.value, str$s("uassert")) ||
-                                    str.slice.starts_with(t.value, str$s("assert")) ||
-                                    str.slice.starts_with(t.value, str$s("ensure")) ||
-                                    str.slice.starts_with(t.value, str$s("enforce")) ||
-                                    str.slice.starts_with(t.value, str$s("expect")) ||
-                                    str.slice.starts_with(t.value, str$s("e$assert")) ||
-                                    str.slice.starts_with(t.value, str$s("tassert"))) {
-                                    stats->n_asserts++;
-                                }
-                            }
-                            goto def;
-                        case CexTkn__comment_multi: {
-                            for$each (c, t.value.buf, t.value.len) {
-                                if (c == '\n') { stats->n_lines_comments++; }
-                            }
-                        }
-                            fallthrough();
-                        case CexTkn__comment_single:
-                            stats->n_lines_comments++;
-                            break;
-                        case CexTkn__preproc: {
-                            for$each (c, t.value.buf, t.value.len) {
-                                if (c == '\n') {
-                                    stats->n_lines_code++;
-                                    file_loc++;
-                                }
-                            }
-                        }
-                            fallthrough();
-                        default:
-                        def:
-                            if (last_line < lx.line) {
-                                stats->n_lines_code++;
-                                file_loc++;
-                                stats->n_lines_total += (lx.line - last_line);
-                                last_line = lx.line;
-                            }
-                            break;
-                    }
-                }
-                if (verbose) {
-                    char* pcur = str.replace(src_fn.key, os.fs.getcwd(_), ".", _);
-                    io.printf("%5d loc | %s\n", file_loc, pcur);
-                }
+            stats->n_files++;
+            stats->n_asserts += fstats->n_asserts;
+            stats->n_lines_code += fstats->n_lines_code;
+            stats->n_lines_comments += fstats->n_lines_comments;
+            stats->n_lines_total += fstats->n_lines_total;
+
+            if (verbose) {
+                char* pcur = str.replace(src_fn, os.fs.getcwd(_), ".", _);
+                io.printf("%5d loc | %s\n", fstats->n_loc, pcur);
             }
         }
     }
@@ -16663,15 +21886,12 @@ _cexy__display_full_info(
                 if (code == NULL) {
                     return e$raise(Error.not_found, "Error loading: %s\n", src_fn);
                 }
-                arr$(cex_token_s) items = arr$new(items, _);
-
-                CexParser_c lx = CexParser.create(code, 0, true);
-                cex_token_s t;
-                while ((t = CexParser.next_entity(&lx, &items)).type) {
-                    if (t.type == CexTkn__error) { break; }
-                    if (t.type != CexTkn__func_def) { continue; }
-                    cex_decl_s* d = CexParser.decl_parse(&lx, t, items, NULL, _);
-                    if (d == NULL) { continue; }
+                arr$(cex_decl_s*) decls = arr$new(decls, _);
+                e$except_silent (err, _cexy__decls_parse(src_fn, code, NULL, _, &decls)) {
+                    // parsing error, use decls before error
+                }
+                for$each (d, decls) {
+                    if (d->type != CexTkn__func_def) { continue; }
                     if (d->body.buf == NULL) { continue; }
                     if (str.slice.index_of(d->body, name) != -1) {
                         n_used++;
@@ -16812,22 +22032,13 @@ cexy__cmd__help(int argc, char** argv, void* user_ctx)
                 if (code == NULL) {
                     return e$raise(Error.not_found, "Error loading: %s\n", src_fn);
                 }
-                arr$(cex_token_s) items = arr$new(items, _);
                 arr$(cex_decl_s*) all_decls = arr$new(all_decls, _);
                 cex_decl_s* ns_decl = NULL;
 
-                CexParser_c lx = CexParser.create(code, 0, true);
-                cex_token_s t;
-                while ((t = CexParser.next_entity(&lx, &items)).type) {
-                    if (t.type == CexTkn__error) {
-                        log$error("Error parsing: %s at line: %d\n", src_fn, lx.line);
-                        break;
-                    }
-                    cex_decl_s* d = CexParser.decl_parse(&lx, t, items, NULL, arena);
-                    if (d == NULL) { continue; }
-                    arr$push(all_decls, d);
-
-                    d->file = src_fn;
+                e$except (err, _cexy__decls_parse(src_fn, code, NULL, arena, &all_decls)) {
+                    // keep going with decls parsed before error
+                }
+                for$each (d, all_decls) {
                     if (d->type == CexTkn__cex_module_struct || d->type == CexTkn__cex_module_def) {
                         log$trace("Found cex namespace: %s (namespace: %s)\n", src_fn, base_ns);
                         hm$set(cex_ns_map, src_fn, str.clone(base_ns, arena));
@@ -17021,6 +22232,7 @@ cexy__cmd__config(int argc, char** argv, void* user_ctx)
     "* CEX_LOG_LVL               " cex$stringize(CEX_LOG_LVL) "\n"                                             \
     "* cexy$build_dir            " cexy$build_dir "\n"                                             \
     "* cexy$src_dir              " cexy$src_dir "\n"                                             \
+    "* cexy$cache_dir            " cexy$cache_dir "\n"                                             \
     "* cexy$cc                   " cexy$cc "\n"                                                    \
     "* cexy$cc_include           " cex$stringize(cexy$cc_include) "\n"                             \
     "* cexy$cc_args_sanitizer    " cex$stringize(cexy$cc_args_sanitizer) "\n"                                \
@@ -17215,12 +22427,16 @@ cexy__cmd__simple_test(int argc, char** argv, void* user_ctx)
     (void)user_ctx;
     argparse_c cmd_args = {
         .program_name = "./cex",
-        .usage = "test [options] {run,build,create,clean,debug} all|tests/test_file.c [--test-options]",
+        .usage = "test [options] {run,build,create,clean,debug} [-j[N]] all|tests/test_file.c "
+                 "[--test-options]",
         .description = _cexy$cmd_test_help,
         .epilog = _cexy$cmd_test_epilog,
         argparse$opt_list(argparse$opt_help(), ),
     };
 
+    // -j[N] only before the target, the rest of args belongs to the test program
+    u32 n_jobs = 1;
+    e$ret(_cexy__jobs_arg_extract(&argc, argv, 2, &n_jobs));
     e$ret(argparse.parse(&cmd_args, argc, argv));
     char* cmd = argparse.next(&cmd_args);
     char* target = argparse.next(&cmd_args);
@@ -17248,6 +22464,10 @@ cexy__cmd__simple_test(int argc, char** argv, void* user_ctx)
     (void)n_built;
     mem$scope(tmem$, _)
     {
+        os_cmd_pool_c pool = { 0 };
+        if (n_jobs != 1) {
+            e$ret(os.cmd.pool_create(&pool, &(os_cmd_pool_opts_s){ .n_jobs = n_jobs }, _));
+        }
         for$each (test_src, os.fs.find(target, true, _)) {
             char* test_target = cexy.target_make(test_src, cexy$build_dir, ".test", _);
             log$trace("Test src: %s -> %s\n", test_src, test_target);
@@ -17274,15 +22494,26 @@ cexy__cmd__simple_test(int argc, char** argv, void* user_ctx)
 
 
             arr$push(args, NULL);
-            e$ret(os$cmda(args));
+            if (n_jobs == 1) {
+                e$ret(os$cmda(args));
+            } else if (os.cmd.pool_add(&pool, args, arr$len(args))) {
+                break; // fail fast, compiler output is already printed
+            }
             n_built++;
         }
+        if (n_jobs != 1) {
+            Exc err = os.cmd.pool_join(&pool);
+            os.cmd.pool_destroy(&pool);
+            if (err) { return e$raise(err, "Tests building failed"); }
+        }
     }
 
     log$info("Tests building: %d tests processed, %d tests built\n", n_tests, n_built);
     fflush(stdout);
 
-    if (str.match(cmd, "(run|debug)")) {
+    if (str.eq(cmd, "run") && n_jobs != 1) {
+        e$ret(_cexy__test__run_jobs(target, n_jobs, cmd_args.argc, cmd_args.argv));
+    } else if (str.match(cmd, "(run|debug)")) {
         e$ret(cexy.test.run(target, str.eq(cmd, "debug"), cmd_args.argc, cmd_args.argv));
     }
     return EOK;
@@ -17587,10 +22818,21 @@ cexy__cmd__simple_app(int argc, char** argv, void* user_ctx)
     (void)user_ctx;
     argparse_c cmd_args = {
         .program_name = "./cex",
-        .usage = "app [options] {run,build,create,clean,debug} APP_NAME [--app-options app args]",
+        .usage = "app [options] {run,build,create,clean,debug} APP_NAME [--app-options app args]\n"
+                 "app [options] build [-j[N]] APP_NAME [APP_NAME2 ...]",
         argparse$opt_list(argparse$opt_help(), ),
     };
 
+    // -j[N] for `build` may be anywhere, for other commands only before APP_NAME (app args follow)
+    bool is_build = false;
+    for (int i = 1; i < argc; i++) {
+        if (argv[i][0] != '-') {
+            is_build = str.eq(argv[i], "build");
+            break;
+        }
+    }
+    u32 n_jobs = 1;
+    e$ret(_cexy__jobs_arg_extract(&argc, argv, (is_build) ? 0 : 2, &n_jobs));
     e$ret(argparse.parse(&cmd_args, argc, argv));
     char* cmd = argparse.next(&cmd_args);
     char* target = argparse.next(&cmd_args);
@@ -17611,35 +22853,58 @@ cexy__cmd__simple_app(int argc, char** argv, void* user_ctx)
 
     mem$scope(tmem$, _)
     {
-        char* app_src;
-        e$ret(cexy.app.find_app_target_src(_, target, &app_src));
-        char* app_exec = cexy.target_make(app_src, cexy$build_dir, target, _);
-        log$trace("App src: %s -> %s\n", target, app_exec);
-        if (!cexy.src_include_changed(app_exec, app_src, NULL)) { goto run; }
-        arr$(char*) args = arr$new(args, _);
-        arr$pushm(args, cexy$cc, );
-        // NOTE: reconstructing char*[] because some cexy$ variables might be empty
-        char* cc_args[] = { cexy$cc_args };
-        char* cc_include[] = { cexy$cc_include };
-        char* ld_args[] = { cexy$ld_args };
-        char* pkgconf_libargs[] = { cexy$pkgconf_libs };
-        arr$pusha(args, cc_args);
-        arr$pusha(args, cc_include);
-        if (arr$len(pkgconf_libargs)) {
-            e$ret(cexy$pkgconf(_, &args, "--cflags", cexy$pkgconf_libs));
-        }
-        arr$push(args, (char*)app_src);
-        arr$pusha(args, ld_args);
-        if (arr$len(pkgconf_libargs)) {
-            e$ret(cexy$pkgconf(_, &args, "--libs", cexy$pkgconf_libs));
+        os_cmd_pool_c pool = { 0 };
+        if (n_jobs != 1) {
+            e$ret(os.cmd.pool_create(&pool, &(os_cmd_pool_opts_s){ .n_jobs = n_jobs }, _));
         }
-        arr$pushm(args, "-o", app_exec);
+        Exc err = EOK;
+        char* app_name = target;
+        do {
+            char* app_src;
+            err = cexy.app.find_app_target_src(_, app_name, &app_src);
+            if (err) { break; }
+            char* app_exec = cexy.target_make(app_src, cexy$build_dir, app_name, _);
+            log$trace("App src: %s -> %s\n", app_name, app_exec);
+            if (!cexy.src_include_changed(app_exec, app_src, NULL)) { continue; }
+            arr$(char*) args = arr$new(args, _);
+            arr$pushm(args, cexy$cc, );
+            // NOTE: reconstructing char*[] because some cexy$ variables might be empty
+            char* cc_args[] = { cexy$cc_args };
+            char* cc_include[] = { cexy$cc_include };
+            char* ld_args[] = { cexy$ld_args };
+            char* pkgconf_libargs[] = { cexy$pkgconf_libs };
+            arr$pusha(args, cc_args);
+            arr$pusha(args, cc_include);
+            if (arr$len(pkgconf_libargs)) {
+                err = cexy$pkgconf(_, &args, "--cflags", cexy$pkgconf_libs);
+                if (err) { break; }
+            }
+            arr$push(args, (char*)app_src);
+            arr$pusha(args, ld_args);
+            if (arr$len(pkgconf_libargs)) {
+                err = cexy$pkgconf(_, &args, "--libs", cexy$pkgconf_libs);
+                if (err) { break; }
+            }
+            arr$pushm(args, "-o", app_exec);
 
 
-        arr$push(args, NULL);
-        e$ret(os$cmda(args));
+            arr$push(args, NULL);
+            if (n_jobs == 1) {
+                err = os$cmda(args);
+            } else {
+                err = os.cmd.pool_add(&pool, args, arr$len(args));
+            }
+            if (err) { break; }
+            // `build` accepts many app names, e.g. ./cex app build -j app1 app2 app3
+        } while (str.eq(cmd, "build") && (app_name = argparse.next(&cmd_args)));
+
+        if (n_jobs != 1) {
+            Exc join_err = os.cmd.pool_join(&pool);
+            if (err == EOK) { err = join_err; }
+            os.cmd.pool_destroy(&pool);
+        }
+        if (err) { return err; }
 
-    run:
         if (str.match(cmd, "(run|debug)")) {
             e$ret(cexy.app.run(target, str.eq(cmd, "debug"), cmd_args.argc, cmd_args.argv));
         }
@@ -18256,6 +23521,7 @@ const struct __cex_namespace__cexy cexy = {
     .utils = {
         .git_hash = cexy__utils__git_hash,
         .git_lib_fetch = cexy__utils__git_lib_fetch,
+        .json_codegen = cexy__utils__json_codegen,
         .make_compile_flags = cexy__utils__make_compile_flags,
         .make_new_project = cexy__utils__make_new_project,
         .pkgconf = cexy__utils__pkgconf,
@@ -18274,7 +23540,6 @@ const struct __cex_namespace__cexy cexy = {
 */
 #if !defined(cex$enable_minimal)
 
-#include <ctype.h>
 
 const char* CexTkn_str[] = {
 #define X(name) cex$stringize(name),
@@ -18287,30 +23552,93 @@ const char* CexTkn_str[] = {
     ({                                                                                             \
         char res = '\0';                                                                           \
         if ((lx->cur < lx->content_end)) {                                                         \
-            if (*lx->cur == '\n') { lx->line++; lx->col = 0;}                                                  \
-            lx->col++;\
+            if (*lx->cur == '\n') {                                                                \
+                lx->line++;                                                                        \
+                lx->col = 0;                                                                       \
+            }                                                                                      \
+            lx->col++;                                                                             \
             res = *(lx->cur++);                                                                    \
         }                                                                                          \
         res;                                                                                       \
     })
 
-#define lx$rewind(lx)                                                                              \
-    ({                                                                                             \
-        if (lx->cur > lx->content) {                                                               \
-            lx->cur--;                                                                             \
-            if (*lx->cur == '\n') { lx->line--; }                                                  \
-        }                                                                                          \
-    })
-
 #define lx$peek(lx) ((lx->cur < lx->content_end) ? *lx->cur : '\0')
 
 #define lx$peek_next(lx) ((lx->cur + 1 < lx->content_end) ? lx->cur[1] : '\0')
 
-#define lx$skip_space(lx, c)                                                                       \
-    while (c && isspace((c))) {                                                                    \
-        lx$next(lx);                                                                               \
-        (c) = lx$peek(lx);                                                                         \
+/* Character classes (C locale isspace/isalnum + C specific) */
+#define lx$cc_space (1 << 0)     // isspace()
+#define lx$cc_ident (1 << 1)     // isalnum() or _ or $
+#define lx$cc_ident_1st (1 << 2) // isalpha() or _ or $
+#define lx$cc_digit (1 << 3)     // isdigit()
+#define lx$cc_num_end (1 << 4)   // number token terminators
+#define lx$cc_scope (1 << 5)     // chars of interest inside folded scopes
+
+// clang-format off
+#define S lx$cc_space
+#define I (lx$cc_ident | lx$cc_ident_1st)
+#define D (lx$cc_ident | lx$cc_digit)
+#define N lx$cc_num_end
+#define B lx$cc_scope
+static const u8 _CexParser__char_class[256] = {
+    /*        0  1  2  3  4  5  6  7  8  9  a      b  c      d      e  f */
+    /* 00 */  B, 0, 0, 0, 0, 0, 0, 0, 0, S|N, S|N, S, S, S|N, 0, 0,
+    /* 10 */  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    /*        sp   !  "  #  $  %  &  '  (  )    *  +  ,  -  .  /   */
+    /* 20 */  S|N, 0, B, B, I, 0, 0, B, B, B|N, N, N, N, N, 0, B|N,
+    /*        0  1  2  3  4  5  6  7  8  9  :  ;  <  =  >  ?  */
+    /* 30 */  D, D, D, D, D, D, D, D, D, D, 0, 0, 0, 0, 0, 0,
+    /* 40 */  0, I, I, I, I, I, I, I, I, I, I, I, I, I, I, I,
+    /*        P  Q  R  S  T  U  V  W  X  Y  Z  [  \  ]    ^  _  */
+    /* 50 */  I, I, I, I, I, I, I, I, I, I, I, B, 0, B|N, 0, I,
+    /* 60 */  0, I, I, I, I, I, I, I, I, I, I, I, I, I, I, I,
+    /*        p  q  r  s  t  u  v  w  x  y  z  {  |  }    ~  DEL */
+    /* 70 */  I, I, I, I, I, I, I, I, I, I, I, B, 0, B|N, 0, 0,
+};
+#undef S
+#undef I
+#undef D
+#undef N
+#undef B
+// clang-format on
+
+#define lx$is(c, cc) (_CexParser__char_class[(u8)(c)] & (cc))
+
+/// Moves cursor to `new_cur`, updating line/col as lx$next() does for every skipped char
+static inline void
+_CexParser__advance(CexParser_c* lx, char* new_cur)
+{
+    char* last_nl = NULL;
+    char* p = lx->cur;
+    while (p < new_cur && (p = memchr(p, '\n', new_cur - p)) != NULL) {
+        lx->line++;
+        last_nl = p++;
+    }
+    if (last_nl) {
+        lx->col = new_cur - last_nl;
+    } else {
+        lx->col += new_cur - lx->cur;
+    }
+    lx->cur = new_cur;
+}
+
+/// Skips whitespace, 8 spaces at once for indentation runs, returns next char or '\0'
+static inline char
+_CexParser__skip_space(CexParser_c* lx)
+{
+    char* p = lx->cur;
+    char* end = lx->content_end;
+    while (p < end && lx$is(*p, lx$cc_space)) {
+        u64 w;
+        if (end - p >= 8 && (memcpy(&w, p, sizeof(w)), w == 0x2020202020202020ULL)) {
+            p += 8;
+        } else {
+            p++;
+        }
     }
+    if (p != lx->cur) { _CexParser__advance(lx, p); }
+    return lx$peek(lx);
+}
 
 CexParser_c
 CexParser_create(char* content, u32 content_len, bool fold_scopes)
@@ -18331,17 +23659,36 @@ CexParser_reset(CexParser_c* lx)
     lx->line = 0;
 }
 
+/// Moves lexer cursor to `offset` (must be a position between tokens), recalculates line/col
+void
+CexParser_resync(CexParser_c* lx, u32 offset)
+{
+    uassert(lx != NULL);
+    uassert(lx->content + offset <= lx->content_end && "offset out of bounds");
+    char* new_cur = lx->content + offset;
+    if (new_cur < lx->cur) {
+        lx->cur = lx->content;
+        lx->line = 0;
+        lx->col = 0;
+    }
+    _CexParser__advance(lx, new_cur);
+}
+
 static cex_token_s
 _CexParser__scan_ident(CexParser_c* lx)
 {
     cex_token_s t = { .type = CexTkn__ident, .value = { .buf = lx->cur, .len = 0 } };
-    char c;
-    while ((c = lx$next(lx))) {
-        if (!(isalnum(c) || c == '_' || c == '$')) {
-            lx$rewind(lx);
-            break;
-        }
-        t.value.len++;
+    char* p = lx->cur;
+    char* end = lx->content_end;
+    // ident never contains new lines
+    while (p < end && lx$is(*p, lx$cc_ident)) { p++; }
+    t.value.len = p - lx->cur;
+    lx->col += t.value.len;
+    lx->cur = p;
+    if (p < end && *p == '\0') {
+        // lx$next() compatibility: '\0' stops the scan, but consumed
+        lx->cur++;
+        lx->col++;
     }
     return t;
 }
@@ -18350,97 +23697,109 @@ static cex_token_s
 _CexParser__scan_number(CexParser_c* lx)
 {
     cex_token_s t = { .type = CexTkn__number, .value = { .buf = lx->cur, .len = 0 } };
-    char c;
-    while ((c = lx$next(lx))) {
-        switch (c) {
-            case ' ':
-            case '\t':
-            case '\n':
-            case '\r':
-            case '/':
-            case '*':
-            case '+':
-            case '-':
-            case ',':
-            case ')':
-            case ']':
-            case '}':
-                lx$rewind(lx);
-                return t;
-        }
-        t.value.len++;
+    char* p = lx->cur;
+    char* end = lx->content_end;
+    while (p < end && *p != '\0' && !lx$is(*p, lx$cc_num_end)) { p++; }
+    t.value.len = p - lx->cur;
+    lx->col += t.value.len;
+    lx->cur = p;
+    if (p < end && *p == '\0') {
+        // lx$next() compatibility: '\0' stops the scan, but consumed
+        lx->cur++;
+        lx->col++;
     }
     return t;
 }
 
+#define lx$has_less(w, n) /* TEMP MACRO: non zero if any byte < n (n <= 128) */                    \
+    (((w) - 0x0101010101010101ULL * (n)) & ~(w) & 0x8080808080808080ULL)
+#define lx$has_eq(w, c) /* TEMP MACRO: non zero if any byte == c */                                 \
+    lx$has_less((w) ^ (0x0101010101010101ULL * (u8)(c)), 1)
+
 static cex_token_s
 _CexParser__scan_string(CexParser_c* lx)
 {
-    cex_token_s t = { .type = (*lx->cur == '"' ? CexTkn__string : CexTkn__char),
+    char quote = *lx->cur;
+    cex_token_s t = { .type = (quote == '"' ? CexTkn__string : CexTkn__char),
                       .value = { .buf = lx->cur + 1, .len = 0 } };
-    lx$next(lx);
-    char c;
-    while ((c = lx$next(lx))) {
-        switch (c) {
-            case '\\': // escape char, unconditionally skip next
-                lx$next(lx);
-                t.value.len++;
-                break;
-            case '\'':
-                if (t.type == CexTkn__char) { goto end; }
-                break;
-            case '"':
-                if (t.type == CexTkn__string) { goto end; }
-                break;
-            default: {
-                if (unlikely((u8)c < 0x20)) {
-                    t.type = CexTkn__error;
-                    t.value = (str_s){ 0 };
-                    return t;
-                }
-            }
+    char* p = lx->cur + 1;
+    char* end = lx->content_end;
+    while (p < end) {
+        // skipping 8 bytes at once when no quote, escape or control chars (SWAR)
+        while (end - p >= 8) {
+            u64 w;
+            memcpy(&w, p, sizeof(w));
+            if (lx$has_less(w, 0x20) | lx$has_eq(w, quote) | lx$has_eq(w, '\\')) { break; }
+            p += 8;
+        }
+        if (p >= end) { break; }
+        char c = *p;
+        if (c == quote) {
+            t.value.len = p - t.value.buf;
+            _CexParser__advance(lx, p + 1);
+            return t;
+        } else if (c == '\\') {
+            // escape char, unconditionally skip next
+            p += 2;
+        } else if (c == '\0') {
+            // lx$next() compatibility: '\0' stops the scan, but consumed
+            t.value.len = p - t.value.buf;
+            _CexParser__advance(lx, p + 1);
+            return t;
+        } else if (unlikely((u8)c < 0x20)) {
+            _CexParser__advance(lx, p + 1);
+            return (cex_token_s){ .type = CexTkn__error };
+        } else {
+            p++;
         }
-        t.value.len++;
     }
-end:
+    // unterminated string or escape at EOF
+    t.value.len = p - t.value.buf;
+    _CexParser__advance(lx, end);
     if (unlikely(t.value.buf + t.value.len > lx->content_end)) {
         t = (cex_token_s){ .type = CexTkn__error };
     }
     return t;
 }
 
+#undef lx$has_less
+#undef lx$has_eq
+
 static cex_token_s
 _CexParser__scan_comment(CexParser_c* lx)
 {
     cex_token_s t = { .type = lx->cur[1] == '/' ? CexTkn__comment_single : CexTkn__comment_multi,
                       .value = { .buf = lx->cur, .len = 2 } };
-    lx$next(lx);
-    lx$next(lx);
-    char c;
-    while ((c = lx$next(lx))) {
-        switch (c) {
-            case '\n':
-                if (t.type == CexTkn__comment_single) {
-                    lx$rewind(lx);
-                    goto end;
-                }
+    char* p = lx->cur + 2;
+    char* end = lx->content_end;
+    if (p > end) { p = end; }
+
+    if (t.type == CexTkn__comment_single) {
+        char* nl = memchr(p, '\n', end - p);
+        p = (nl) ? nl : end;
+    } else {
+        while (p < end) {
+            char* star = memchr(p, '*', end - p);
+            if (star == NULL) {
+                p = end;
                 break;
-            case '*':
-                if (t.type == CexTkn__comment_multi) {
-                    if (lx$peek(lx) == '/') {
-                        lx$next(lx);
-                        t.value.len += 2;
-                        goto end;
-                    }
-                }
+            }
+            p = star + 1;
+            if (p < end && *p == '/') {
+                p++;
                 break;
+            }
         }
-        t.value.len++;
     }
-end:
-    if (unlikely(t.value.buf + t.value.len > lx->content_end)) {
-        t = (cex_token_s){ .type = CexTkn__error };
+    char* zero = memchr(t.value.buf, '\0', p - t.value.buf);
+    if (unlikely(zero != NULL)) {
+        // lx$next() compatibility: '\0' stops the scan, but consumed
+        p = zero + 1;
+        t.value.len = zero - t.value.buf;
+    } else {
+        t.value.len = p - t.value.buf;
     }
+    _CexParser__advance(lx, p);
     return t;
 }
 
@@ -18451,27 +23810,40 @@ _CexParser__scan_preproc(CexParser_c* lx)
 
     if (lx->cur >= lx->content_end) { return (cex_token_s){ .type = CexTkn__error }; }
 
-    char c = *lx->cur;
-    lx$skip_space(lx, c);
+    _CexParser__skip_space(lx);
     cex_token_s t = { .type = CexTkn__preproc, .value = { .buf = lx->cur, .len = 0 } };
 
-    while ((c = lx$next(lx))) {
-        switch (c) {
-            case '\n':
-                goto end;
-            case '\\':
-                // next line concat for #define
-                t.value.len++;
-                if (!lx$next(lx)) {
-                    // Oops, we expected next symbol here, but got EOF, invalidate token then
-                    t.value.len++;
-                    goto end;
-                }
-                break;
+    char* p = lx->cur;
+    char* end = lx->content_end;
+    t.value.len = end - t.value.buf;
+    while (p < end) {
+        char* nl = memchr(p, '\n', end - p);
+        if (nl == NULL) {
+            // no new line until EOF, escape char at EOF invalidates the token
+            u32 n_escapes = 0;
+            for (char* e = end - 1; e >= p && *e == '\\'; e--) { n_escapes++; }
+            t.value.len = end - t.value.buf + (n_escapes % 2);
+            p = end;
+            break;
+        }
+        // next line concat for #define, if odd number of escapes before new line
+        u32 n_escapes = 0;
+        for (char* e = nl - 1; e >= p && *e == '\\'; e--) { n_escapes++; }
+        p = nl + 1;
+        if (n_escapes % 2 == 0) {
+            t.value.len = nl - t.value.buf;
+            break;
         }
-        t.value.len++;
     }
-end:
+    char* zero = memchr(t.value.buf, '\0', p - t.value.buf);
+    if (unlikely(zero != NULL && zero < t.value.buf + t.value.len)) {
+        // lx$next() compatibility: '\0' stops the scan, but consumed
+        u32 n_escapes = 0;
+        for (char* e = zero - 1; e >= t.value.buf && *e == '\\'; e--) { n_escapes++; }
+        t.value.len = zero - t.value.buf + (n_escapes % 2);
+        p = zero + 1;
+    }
+    _CexParser__advance(lx, p);
     if (unlikely(t.value.buf + t.value.len > lx->content_end)) {
         t = (cex_token_s){ .type = CexTkn__error };
     }
@@ -18532,6 +23904,14 @@ _CexParser__scan_scope(CexParser_c* lx)
         }
 
         while ((c = lx$peek(lx))) {
+            if (scope_depth > 0 && !lx$is(c, lx$cc_scope)) {
+                // bulk skip of the scope contents until next bracket/string/comment/preproc
+                char* p = lx->cur + 1;
+                while (p < lx->content_end && !lx$is(*p, lx$cc_scope)) { p++; }
+                t.value.len += p - lx->cur;
+                _CexParser__advance(lx, p);
+                continue;
+            }
             switch (c) {
                 case '{':
                     scope$push(c);
@@ -18604,11 +23984,11 @@ CexParser_next_token(CexParser_c* lx)
 
     char c;
     while ((c = lx$peek(lx))) {
-        lx$skip_space(lx, c);
+        if (lx$is(c, lx$cc_space)) { c = _CexParser__skip_space(lx); }
         if (!c) { break; }
 
-        if (isalpha(c) || c == '_' || c == '$') { return _CexParser__scan_ident(lx); }
-        if (isdigit(c)) { return _CexParser__scan_number(lx); }
+        if (lx$is(c, lx$cc_ident_1st)) { return _CexParser__scan_ident(lx); }
+        if (lx$is(c, lx$cc_digit)) { return _CexParser__scan_number(lx); }
 
         switch (c) {
             case '\'':
@@ -18688,6 +24068,250 @@ CexParser_next_token(CexParser_c* lx)
     return (cex_token_s){ 0 }; // EOF
 }
 
+static inline i32
+_CexParser__scope_delta(CexTkn_e type)
+{
+    switch (type) {
+        case CexTkn__lparen:
+        case CexTkn__lbracket:
+        case CexTkn__lbrace:
+            return 1;
+        case CexTkn__rparen:
+        case CexTkn__rbracket:
+        case CexTkn__rbrace:
+            return -1;
+        default:
+            return 0;
+    }
+}
+
+/// Tokenizes whole lx content into `tokens`, and adds a checkpoint every `checkpoint_every` tokens
+/// and at the end of content (used by CexParser.retokenize()). On lexing error `tokens` contains
+/// tokens before error.
+Exception
+CexParser_tokenize(
+    CexParser_c* lx,
+    u32 checkpoint_every,
+    arr$(cex_token_s) * tokens,
+    arr$(cex_token_checkpoint_s) * checkpoints
+)
+{
+    uassert(lx != NULL);
+    uassert(tokens != NULL && *tokens != NULL && "non initialized arr$");
+    uassert(checkpoints != NULL && *checkpoints != NULL && "non initialized arr$");
+    uassert(checkpoint_every > 0);
+
+    CexParser_reset(lx);
+    lx->col = 0;
+    arr$clear(*tokens);
+    arr$clear(*checkpoints);
+
+    i32 depth = 0;
+    cex_token_s t;
+    while (true) {
+        u32 idx = arr$len(*tokens);
+        if (idx % checkpoint_every == 0) {
+            arr$push(
+                *checkpoints,
+                (cex_token_checkpoint_s){
+                    .offset = lx->cur - lx->content,
+                    .line = lx->line,
+                    .token_idx = idx,
+                    .scope_depth = depth,
+                }
+            );
+        }
+        if (!(t = CexParser_next_token(lx)).type) { break; }
+        if (t.type == CexTkn__error) {
+            return e$raise(Error.integrity, "Lexing error at line: %d", lx->line);
+        }
+        depth += _CexParser__scope_delta(t.type);
+        arr$push(*tokens, t);
+    }
+    // Final checkpoint at the end of content (may duplicate last one if idx % every == 0)
+    cex_token_checkpoint_s* last = &(*checkpoints)[arr$len(*checkpoints) - 1];
+    if (last->offset != lx->cur - lx->content) {
+        arr$push(
+            *checkpoints,
+            (cex_token_checkpoint_s){
+                .offset = lx->cur - lx->content,
+                .line = lx->line,
+                .token_idx = arr$len(*tokens),
+                .scope_depth = depth,
+            }
+        );
+    }
+    return EOK;
+}
+
+/// Replaces elements [k, j) of arr by `region` elements (region_len), arr len is old_n
+static void
+_CexParser__splice(void* arr, usize elsize, usize k, usize j, usize old_n, void* region, usize region_len)
+{
+    char* a = arr;
+    memmove(a + (k + region_len) * elsize, a + j * elsize, (old_n - j) * elsize);
+    if (region_len) { memcpy(a + k * elsize, region, region_len * elsize); }
+}
+
+/// Re-tokenizes lx content after the edit of the old content, tokens/checkpoints must be created by
+/// CexParser.tokenize() for old_content. The edit replaced `removed_len` bytes at `edit_offset` by
+/// `inserted_len` bytes, lx must be created for the new content (can be the same buffer). Only the
+/// damaged region is re-lexed, unchanged tail tokens are reused (rebased to new content).
+Exception
+CexParser_retokenize(
+    CexParser_c* lx,
+    char* old_content,
+    u32 edit_offset,
+    u32 removed_len,
+    u32 inserted_len,
+    u32 checkpoint_every,
+    arr$(cex_token_s) * tokens,
+    arr$(cex_token_checkpoint_s) * checkpoints
+)
+{
+    uassert(lx != NULL);
+    uassert(tokens != NULL && *tokens != NULL && "non initialized arr$");
+    uassert(checkpoints != NULL && *checkpoints != NULL && "non initialized arr$");
+    uassert(checkpoint_every > 0);
+    uassert(lx->content + edit_offset + inserted_len <= lx->content_end && "edit out of bounds");
+
+    usize n_cp = arr$len(*checkpoints);
+    if (n_cp == 0 || (*checkpoints)[0].offset != 0) {
+        return CexParser_tokenize(lx, checkpoint_every, tokens, checkpoints);
+    }
+
+    // Resume from the last checkpoint before edit (its previous token lookahead is intact)
+    usize ci = 0;
+    while (ci + 1 < n_cp && (*checkpoints)[ci + 1].offset < edit_offset) { ci++; }
+    cex_token_checkpoint_s cp = (*checkpoints)[ci];
+    usize k = cp.token_idx;
+    usize old_n = arr$len(*tokens);
+    uassert(k <= old_n);
+
+    isize delta = (isize)inserted_len - (isize)removed_len;
+    usize edit_end = edit_offset + inserted_len; // in new content
+    usize old_edit_end = edit_offset + removed_len;
+    // previous tokenization failed, tail is missing and has to be lexed completely
+    bool has_tail = (isize)(*checkpoints)[n_cp - 1].offset + delta ==
+                    (isize)(lx->content_end - lx->content);
+
+    lx->cur = lx->content + cp.offset;
+    lx->line = cp.line;
+    lx->col = 0;
+
+    Exc result = EOK;
+    arr$(cex_token_s) region = arr$new(region, mem$, .capacity = checkpoint_every * 2);
+    arr$(cex_token_checkpoint_s) region_cp = arr$new(region_cp, mem$);
+    usize sync_cj = 0; // old checkpoint where new lexer state matches old one
+    i32 depth = cp.scope_depth;
+    usize cj = ci + 1;
+    cex_token_s t;
+    while (true) {
+        usize n = lx->cur - lx->content;
+        if (has_tail && n > edit_end) {
+            // old checkpoints after edit, shifted to new content positions
+            while (cj < n_cp && ((*checkpoints)[cj].offset < old_edit_end ||
+                                 (isize)(*checkpoints)[cj].offset + delta < (isize)n)) {
+                cj++;
+            }
+            if (cj < n_cp && (isize)(*checkpoints)[cj].offset + delta == (isize)n) {
+                sync_cj = cj;
+                break;
+            }
+        }
+        usize idx = arr$len(region);
+        if (idx > 0 && idx % checkpoint_every == 0) {
+            arr$push(
+                region_cp,
+                (cex_token_checkpoint_s){
+                    .offset = n,
+                    .line = lx->line,
+                    .token_idx = k + idx,
+                    .scope_depth = depth,
+                }
+            );
+        }
+        if (!(t = CexParser_next_token(lx)).type) { break; }
+        if (t.type == CexTkn__error) {
+            result = e$raise(Error.integrity, "Lexing error at line: %d", lx->line);
+            break;
+        }
+        depth += _CexParser__scope_delta(t.type);
+        arr$push(region, t);
+    }
+
+    usize m = arr$len(region);
+    usize j = (sync_cj) ? (*checkpoints)[sync_cj].token_idx : old_n;
+    usize new_n = k + m + (old_n - j);
+
+    // Tokens: head + region + old tail rebased to the new content
+    if (new_n > old_n && !arr$grow_check(*tokens, new_n - old_n)) { return Error.memory; }
+    _CexParser__splice(*tokens, sizeof(cex_token_s), k, j, old_n, region, m);
+    // extend length up to new_n (items are already in place)
+    for (usize i = old_n; i < new_n; i++) { arr$push(*tokens, (*tokens)[i]); }
+    while (arr$len(*tokens) > new_n) { (void)arr$pop(*tokens); }
+    if (lx->content != old_content) {
+        for (usize i = 0; i < k; i++) {
+            cex_token_s* it = &(*tokens)[i];
+            it->value.buf = lx->content + (it->value.buf - old_content);
+        }
+    }
+    if (sync_cj && (lx->content != old_content || delta != 0)) {
+        for (usize i = k + m; i < new_n; i++) {
+            cex_token_s* it = &(*tokens)[i];
+            it->value.buf = lx->content + ((it->value.buf - old_content) + delta);
+        }
+    }
+
+    // Checkpoints: head (incl. resume point) + region + old tail adjusted
+    usize tail_cp = (sync_cj) ? n_cp - sync_cj : 0;
+    usize new_cp = ci + 1 + arr$len(region_cp) + tail_cp;
+    cex_token_checkpoint_s sync_cp = (sync_cj) ? (*checkpoints)[sync_cj]
+                                               : (cex_token_checkpoint_s){ 0 };
+    if (new_cp > n_cp && !arr$grow_check(*checkpoints, new_cp - n_cp)) { return Error.memory; }
+    _CexParser__splice(
+        *checkpoints,
+        sizeof(cex_token_checkpoint_s),
+        ci + 1,
+        (sync_cj) ? sync_cj : n_cp,
+        n_cp,
+        region_cp,
+        arr$len(region_cp)
+    );
+    for (usize i = n_cp; i < new_cp; i++) { arr$push(*checkpoints, (*checkpoints)[i]); }
+    while (arr$len(*checkpoints) > new_cp) { (void)arr$pop(*checkpoints); }
+
+    if (sync_cj) {
+        i64 line_delta = (i64)lx->line - (i64)sync_cp.line;
+        i32 depth_delta = depth - sync_cp.scope_depth;
+        for (usize i = new_cp - tail_cp; i < new_cp; i++) {
+            cex_token_checkpoint_s* it = &(*checkpoints)[i];
+            it->offset += delta;
+            it->line += line_delta;
+            it->token_idx = it->token_idx - j + k + m;
+            it->scope_depth += depth_delta;
+        }
+        // lexer at the end of content, as after full tokenization
+        cex_token_checkpoint_s* last = &(*checkpoints)[new_cp - 1];
+        lx->cur = lx->content + last->offset;
+        lx->line = last->line;
+    } else if (result == EOK) {
+        arr$push(
+            *checkpoints,
+            (cex_token_checkpoint_s){
+                .offset = lx->cur - lx->content,
+                .line = lx->line,
+                .token_idx = new_n,
+                .scope_depth = depth,
+            }
+        );
+    }
+
+    arr$free(region);
+    arr$free(region_cp);
+    return result;
+}
+
 cex_token_s
 CexParser_next_entity(CexParser_c* lx, arr$(cex_token_s) * children)
 {
@@ -19150,7 +24774,14 @@ fail:
 
 #undef lx$next
 #undef lx$peek
-#undef lx$skip_space
+#undef lx$peek_next
+#undef lx$is
+#undef lx$cc_space
+#undef lx$cc_ident
+#undef lx$cc_ident_1st
+#undef lx$cc_digit
+#undef lx$cc_num_end
+#undef lx$cc_scope
 
 const struct __cex_namespace__CexParser CexParser = {
     // Autogenerated by CEX
@@ -19162,10 +24793,12 @@ const struct __cex_namespace__CexParser CexParser = {
     .next_entity = CexParser_next_entity,
     .next_token = CexParser_next_token,
     .reset = CexParser_reset,
+    .resync = CexParser_resync,
+    .retokenize = CexParser_retokenize,
+    .tokenize = CexParser_tokenize,
 
     // clang-format on
 };
-
 #endif
 
 
@@ -10,38 +10,220 @@
         ? (jw)->scope_stack[(jw)->scope_depth - 1]                                                 \
         : 0
 
-#define $print(format, ...) /* temp macro */                                                       \
-    ({                                                                                             \
-        if (jw->error == EOK) {                                                                    \
-            if (jw->buf) {                                                                         \
-                Exc err = sbuf.appendf(&jw->buf, format, __VA_ARGS__);                             \
-                if (unlikely(err != EOK && jw->error == EOK)) { jw->error = err; }                 \
-            } else if (jw->stream) {                                                               \
-                io.fprintf(jw->stream, format, __VA_ARGS__);                                       \
-            }                                                                                      \
-        }                                                                                          \
-    })
+/* JSON lexer character classes */
+#define $cc_space (1 << 0)
+#define $cc_ident (1 << 1)
+#define $cc_digit (1 << 2)
+#define $cc_struct (1 << 3)
 
-#define $printva() /* temp macro! */                                                               \
-    if (jw->error == EOK) {                                                                        \
-        va_list va;                                                                                \
-        va_start(va, format);                                                                      \
-        if (jw->buf) {                                                                             \
-            Exc err = sbuf.appendfva(&jw->buf, format, va);                                        \
-            if (unlikely(err != EOK && jw->error != EOK)) { jw->error = err; }                     \
-        } else if (jw->stream) {                                                                   \
-            int result = cexsp__vfprintf(jw->stream, format, va);                                  \
-            if (result == -1) { jw->error = Error.io; }                                            \
-        }                                                                                          \
-        va_end(va);                                                                                \
+static const u8 _cex_json__char_class[256] = {
+    [' '] = $cc_space,         ['\t'] = $cc_space,        ['\n'] = $cc_space,
+    ['\r'] = $cc_space,        ['\v'] = $cc_space,        ['\f'] = $cc_space,
+    ['a' ... 'z'] = $cc_ident, ['A' ... 'Z'] = $cc_ident, ['_'] = $cc_ident,
+    ['$'] = $cc_ident,         ['0' ... '9'] = $cc_digit, ['{'] = $cc_struct,
+    ['}'] = $cc_struct,        ['['] = $cc_struct,        [']'] = $cc_struct,
+    [','] = $cc_struct,        [':'] = $cc_struct,        ['-'] = $cc_struct,
+    ['+'] = $cc_struct,
+};
+
+static const CexTkn_e _cex_json__struct_token[128] = {
+    ['{'] = CexTkn__lbrace, ['}'] = CexTkn__rbrace, ['['] = CexTkn__lbracket,
+    [']'] = CexTkn__rbracket, [','] = CexTkn__comma, [':'] = CexTkn__colon,
+    ['-'] = CexTkn__minus, ['+'] = CexTkn__plus,
+};
+
+// Loads 8 bytes in little-endian order, so lowest bits always match the first byte
+static inline u64
+_cex_json__load_le64(const char* p)
+{
+    u64 w;
+    memcpy(&w, p, sizeof(w));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    w = __builtin_bswap64(w);
+#endif
+    return w;
+}
+
+// Structural mask of 8 string bytes: high bit of every byte which is a quote_mask char,
+// a backslash, or a control char (< 0x20, not allowed in JSON strings).
+static inline u64
+_cex_json__string_mask(u64 w, u64 quote_mask)
+{
+    const u64 lo7 = 0x7F7F7F7F7F7F7F7FULL;
+    const u64 hi = 0x8080808080808080ULL;
+    u64 q = w ^ quote_mask;
+    u64 b = w ^ (0x0101010101010101ULL * '\\');
+    u64 is_quote = ~(((q & lo7) + lo7) | q);
+    u64 is_bslash = ~(((b & lo7) + lo7) | b);
+    u64 is_ctrl = ~(((w & lo7) + 0x6060606060606060ULL) | w);
+    return (is_quote | is_bslash | is_ctrl) & hi;
+}
+
+// Finds closing quote of the string starting at *cur_ptr (opening quote), on success *cur_ptr
+// points to the closing quote, on failure it points to the error position.
+static inline bool
+_cex_json__skip_string(char** cur_ptr, char* end)
+{
+    char* cur = *cur_ptr;
+    char quote = *cur;
+    u64 quote_mask = 0x0101010101010101ULL * (u8)quote;
+    cur++;
+
+    for (;;) {
+        // jump over regular string bytes 8 at a time, stop at the next special one
+        while (cur + 8 <= end) {
+            u64 m = _cex_json__string_mask(_cex_json__load_le64(cur), quote_mask);
+            if (m) {
+                cur += __builtin_ctzll(m) >> 3;
+                goto special;
+            }
+            cur += 8;
+        }
+        while (cur < end) {
+            u8 c = *cur;
+            if (c == (u8)quote || c == '\\' || c < 0x20) { goto special; }
+            cur++;
+        }
+        goto error; // unterminated
+
+    special:
+        if (*cur == quote) {
+            *cur_ptr = cur;
+            return true;
+        } else if (*cur == '\\') {
+            // escape char, unconditionally skip next
+            if (cur + 2 > end || (u8)cur[1] < 0x20) { goto error; }
+            cur += 2;
+        } else {
+            goto error; // control char
+        }
+    }
+
+error:
+    *cur_ptr = cur;
+    return false;
+}
+
+static cex_token_s
+_cex_json__scan_string(CexParser_c* lx)
+{
+    char* cur = lx->cur;
+    cex_token_s t = { .type = (*cur == '"' ? CexTkn__string : CexTkn__char),
+                      .value = { .buf = cur + 1, .len = 0 } };
+    if (!_cex_json__skip_string(&cur, lx->content_end)) {
+        lx->cur = cur;
+        return (cex_token_s){ .type = CexTkn__error };
+    }
+    t.value.len = cur - t.value.buf;
+    lx->cur = cur + 1;
+    return t;
+}
+
+static cex_token_s
+_cex_json__scan_comment(jr_c* it)
+{
+    CexParser_c* lx = &it->_impl.lexer;
+    char* cur = lx->cur;
+    char* end = lx->content_end;
+    cex_token_s t = { .type = cur[1] == '/' ? CexTkn__comment_single : CexTkn__comment_multi,
+                      .value = { .buf = cur, .len = 0 } };
+    cur += 2;
+    if (t.type == CexTkn__comment_single) {
+        char* nl = memchr(cur, '\n', end - cur);
+        cur = (nl) ? nl : end;
+    } else {
+        for (;;) {
+            char* star = memchr(cur, '*', end - cur);
+            if (star == NULL || star + 1 >= end) {
+                lx->cur = end;
+                return (cex_token_s){ .type = CexTkn__error };
+            }
+            for (char* c = cur; c < star; c++) {
+                if (*c == '\n') {
+                    lx->line++;
+                    it->_impl.line_start = c;
+                }
+            }
+            cur = star + 1;
+            if (*cur == '/') {
+                cur++;
+                break;
+            }
+        }
+    }
+    t.value.len = cur - t.value.buf;
+    lx->cur = cur;
+    return t;
+}
+
+// Dedicated JSON tokenizer, emits CexParser compatible tokens
+static cex_token_s
+_cex_json__next_token(jr_c* it)
+{
+    CexParser_c* lx = &it->_impl.lexer;
+    char* cur = lx->cur;
+    char* end = lx->content_end;
+    cex_token_s t = { 0 };
+
+    // skip whitespace, and keep track of lines for error reporting
+    while (cur < end && (_cex_json__char_class[(u8)*cur] & $cc_space)) {
+        if (*cur == '\n') {
+            lx->line++;
+            it->_impl.line_start = cur;
+        }
+        cur++;
+    }
+    lx->cur = cur;
+    if (cur >= end || *cur == '\0') { goto end; } // EOF
+
+    u8 c = *cur;
+    u8 cc = _cex_json__char_class[c];
+    if (cc & $cc_struct) {
+        t = (cex_token_s){ .type = _cex_json__struct_token[c], .value = { .buf = cur, .len = 1 } };
+        lx->cur = cur + 1;
+        if (c == '{' || c == '[') { it->_impl.scope_idx++; } // scope ordinal for tape lookups
+    } else if (c == '"' || c == '\'') {
+        t = _cex_json__scan_string(lx);
+    } else if (cc & $cc_digit) {
+        // number with optional fraction/exponent, or anything alpha-numeric for integrity checks
+        char* start = cur++;
+        while (cur < end) {
+            u8 n = *cur;
+            if ((_cex_json__char_class[n] & ($cc_digit | $cc_ident)) || n == '.') {
+                cur++;
+            } else if ((n == '-' || n == '+') && (cur[-1] == 'e' || cur[-1] == 'E')) {
+                cur++;
+            } else {
+                break;
+            }
+        }
+        t = (cex_token_s){ .type = CexTkn__number, .value = { .buf = start, .len = cur - start } };
+        lx->cur = cur;
+    } else if (cc & $cc_ident) {
+        char* start = cur++;
+        while (cur < end && (_cex_json__char_class[(u8)*cur] & ($cc_digit | $cc_ident))) {
+            cur++;
+        }
+        t = (cex_token_s){ .type = CexTkn__ident, .value = { .buf = start, .len = cur - start } };
+        lx->cur = cur;
+    } else if (c == '/' && cur + 1 < end && (cur[1] == '/' || cur[1] == '*')) {
+        t = _cex_json__scan_comment(it);
+    } else {
+        t = (cex_token_s){ .type = CexTkn__unk, .value = { .buf = cur, .len = 1 } };
+        lx->cur = cur + 1;
     }
 
+end:
+    lx->col = lx->cur - it->_impl.line_start;
+    return t;
+}
+
 #define $next_tok() /* TEMP MACRO */                                                               \
     ({                                                                                             \
-        cex_token_s _tok = CexParser.next_token(&it->_impl.lexer);                                 \
+        cex_token_s _tok = _cex_json__next_token(it);                                              \
         if (!it->_impl.strict_mode) {                                                              \
             while (_tok.type == CexTkn__comment_single || _tok.type == CexTkn__comment_multi) {    \
-                _tok = CexParser.next_token(&it->_impl.lexer);                                     \
+                _tok = _cex_json__next_token(it);                                                  \
             }                                                                                      \
         }                                                                                          \
         it->_impl.prev_token = it->_impl.curr_token;                                               \
@@ -49,6 +231,177 @@
         _tok;                                                                                      \
     })
 
+// Finds next byte which may change scope structure: bracket, quote, comment or '\0' (EOF)
+static inline char*
+_cex_json__next_structural(char* cur, char* end)
+{
+    const u64 ones = 0x0101010101010101ULL;
+    const u64 lo7 = 0x7F7F7F7F7F7F7F7FULL;
+#define $eq_mask(w, c) /* TEMP MACRO: high bit of every byte equal to c */                        \
+    ({                                                                                             \
+        u64 _x = (w) ^ (ones * (u8)(c));                                                           \
+        ~(((_x & lo7) + lo7) | _x);                                                                \
+    })
+    while (cur + 8 <= end) {
+        u64 w = _cex_json__load_le64(cur);
+        u64 b = w | (ones * 0x20); // '[' -> '{', ']' -> '}'
+        u64 m = $eq_mask(b, '{') | $eq_mask(b, '}') | $eq_mask(w, '"') | $eq_mask(w, '\'') |
+                $eq_mask(w, '/') | $eq_mask(w, 0);
+        m &= 0x8080808080808080ULL;
+        if (m) { return cur + (__builtin_ctzll(m) >> 3); }
+        cur += 8;
+    }
+#undef $eq_mask
+    for (; cur < end; cur++) {
+        switch (*cur) {
+            case '{':
+            case '}':
+            case '[':
+            case ']':
+            case '"':
+            case '\'':
+            case '/':
+            case '\0':
+                return cur;
+            default:
+                break;
+        }
+    }
+    return end;
+}
+
+// Returns position after comment which starts at cur, or cur + 1 if it's not a comment, or NULL
+// if multi-line comment is not terminated.
+static inline char*
+_cex_json__skip_comment(char* cur, char* end)
+{
+    if (cur + 1 >= end) { return end; }
+    if (cur[1] == '/') {
+        char* nl = memchr(cur + 2, '\n', end - cur - 2);
+        return (nl) ? nl : end;
+    } else if (cur[1] == '*') {
+        for (cur += 2;;) {
+            char* star = memchr(cur, '*', end - cur);
+            if (star == NULL || star + 1 >= end) { return NULL; }
+            if (star[1] == '/') { return star + 2; }
+            cur = star + 1;
+        }
+    }
+    return cur + 1;
+}
+
+// Finds closing bracket of the scope opened at `cur`, only brackets/strings/comments are
+// respected, tokens are not validated (NULL if end of content reached)
+static char*
+_cex_json__skip_scope(char* cur, char* end)
+{
+    usize depth = 0;
+    for (;;) {
+        cur = _cex_json__next_structural(cur, end);
+        if (cur >= end) { return NULL; }
+        switch (*cur) {
+            case '{':
+            case '[':
+                depth++;
+                break;
+            case '}':
+            case ']':
+                if (--depth == 0) { return cur; }
+                break;
+            case '"':
+            case '\'':
+                if (!_cex_json__skip_string(&cur, end)) { return NULL; }
+                break;
+            case '/':
+                if (!(cur = _cex_json__skip_comment(cur, end))) { return NULL; }
+                continue;
+            default:
+                return NULL; // '\0'
+        }
+        cur++;
+    }
+}
+
+// Builds scope offsets index of content, broken structure leaves tape empty (unused by reader)
+static Exception
+_cex_json__reader__tape_build(jr_tape_c* tape, char* content, usize content_len)
+{
+    if (tape->allc == NULL) { return Error.argument; }
+    if (tape->scopes == NULL) {
+        arr$new(tape->scopes, tape->allc, .capacity = 64);
+        if (tape->scopes == NULL) { return Error.memory; }
+    } else {
+        arr$clear(tape->scopes);
+    }
+    tape->content = NULL;
+    tape->content_len = 0;
+
+    usize stack[CEX_MAX_JSON_DEPTH];
+    u8 brackets[CEX_MAX_JSON_DEPTH];
+    u32 depth = 0;
+    char* cur = content;
+    char* end = content + content_len;
+
+    for (;;) {
+        cur = _cex_json__next_structural(cur, end);
+        if (cur >= end || *cur == '\0') { break; }
+        switch (*cur) {
+            case '{':
+            case '[':
+                if (depth >= CEX_MAX_JSON_DEPTH) { goto broken; }
+                if (!arr$grow_check(tape->scopes, 1)) { return Error.memory; }
+                stack[depth] = arr$len(tape->scopes);
+                brackets[depth] = (*cur == '{') ? '}' : ']';
+                depth++;
+                arr$push(tape->scopes, (jr_tape_scope_s){ .start = cur - content });
+                break;
+            case '}':
+            case ']': {
+                if (depth == 0 || brackets[depth - 1] != *cur) { goto broken; }
+                depth--;
+                jr_tape_scope_s* s = &tape->scopes[stack[depth]];
+                s->end = cur - content;
+                s->n_nested = arr$len(tape->scopes) - stack[depth] - 1;
+                break;
+            }
+            case '"':
+            case '\'':
+                if (!_cex_json__skip_string(&cur, end)) { goto broken; }
+                break;
+            case '/':
+                if (!(cur = _cex_json__skip_comment(cur, end))) { goto broken; }
+                continue;
+            default:
+                unreachable();
+        }
+        cur++;
+    }
+    if (depth != 0) { goto broken; }
+
+    tape->content = content;
+    tape->content_len = content_len;
+    return EOK;
+
+broken:
+    // reader will report exact error position when it gets there
+    arr$clear(tape->scopes);
+    return EOK;
+}
+
+/**
+ * @brief Frees memory of JSON scope offsets index (see jr_kw.tape)
+ *
+ * @param tape
+ */
+void
+_cex_json__reader__tape_free(jr_tape_c* tape)
+{
+    if (tape == NULL) { return; }
+    if (tape->scopes != NULL) { arr$free(tape->scopes); }
+    tape->content = NULL;
+    tape->content_len = 0;
+}
+
 
 /**
  * @brief Create new JSON reader (it doesn't allocate memory and uses content slicing)
@@ -56,7 +409,11 @@
  * @param it self instance (typically allocated on stack)
  * @param content  JSON content
  * @param content_len JSON content length (if 0 length will be recalculated via strlen())
- * @param strict_mode true - stick to JSON spec, false - allowing comments, trailing commas, nan
+ * @param kwargs.strict_mode true - stick to JSON spec, false - allowing comments, trailing commas, nan
+ * @param kwargs.trusted_input skipped scopes are not validated, only brackets are counted
+ * @param kwargs.tape optional scope offsets index, (re)built for content, O(1) scope skips
+ * @param kwargs.tape_reuse skip rebuilding tape made for the same content ptr/len, caller must
+ * guarantee the content is unchanged since then (otherwise skips land on stale offsets)
  * @return
  */
 Exception
@@ -65,16 +422,33 @@ _cex_json__reader__create(jr_c* it, char* content, usize content_len, jr_kw* kwa
     uassert(it != NULL);
     if (content == NULL) { return Error.argument; }
 
-    bool strict_mode = false;
-    if (kwargs != NULL) { strict_mode = kwargs->strict_mode; }
+    jr_kw kw = { 0 };
+    if (kwargs != NULL) { kw = *kwargs; }
+
+    if (content_len == 0) { content_len = strlen(content); }
 
     *it = (jr_c){
         ._impl = {
-            .strict_mode = strict_mode,
-            .lexer = CexParser.create(content, content_len, false),
+            .strict_mode = kw.strict_mode,
+            .trusted_input = kw.trusted_input,
+            .lexer = {
+                .content = content,
+                .cur = content,
+                .content_end = content + content_len,
+            },
+            .line_start = content,
         },
     };
     if (it->_impl.lexer.content == it->_impl.lexer.content_end) { return Error.empty; }
+
+    if (kw.tape != NULL) {
+        jr_tape_c* tape = kw.tape;
+        if (!kw.tape_reuse || tape->scopes == NULL || tape->content != content ||
+            tape->content_len != content_len) {
+            e$ret(_cex_json__reader__tape_build(tape, content, content_len));
+        }
+        if (tape->content != NULL) { it->_impl.tape = tape; }
+    }
     _cex_json__reader__next(it);
     return EOK;
 }
@@ -149,6 +523,44 @@ error:
 static Exc
 _cex_json__reader__skip(jr_c* it)
 {
+    if (it->_impl.tape != NULL || it->_impl.trusted_input) {
+        // Fast path: jump to closing bracket, skipped contents are not validated
+        CexParser_c* lx = &it->_impl.lexer;
+        char* open = lx->cur - 1;
+        char* close = NULL;
+        jr_tape_c* tape = it->_impl.tape;
+        if (tape != NULL) {
+            usize idx = it->_impl.scope_idx - 1;
+            if (likely(
+                    idx < arr$len(tape->scopes) &&
+                    tape->scopes[idx].start == (usize)(open - lx->content)
+                )) {
+                close = lx->content + tape->scopes[idx].end;
+                it->_impl.scope_idx += tape->scopes[idx].n_nested;
+            }
+        }
+        if (close == NULL && it->_impl.trusted_input) {
+            close = _cex_json__skip_scope(open, lx->content_end);
+            if (close == NULL) {
+                lx->cur = lx->content_end;
+                it->error = "Unexpected end of JSON scope";
+                it->type = JsonType__err;
+                it->val = (str_s){ 0 };
+                return it->error;
+            }
+        }
+        if (close != NULL) {
+            lx->cur = close + 1;
+            it->_impl.prev_token = it->_impl.curr_token;
+            it->_impl.curr_token = (*close == '}') ? CexTkn__rbrace : CexTkn__rbracket;
+            it->_impl.has_items = true;
+            it->type = JsonType__eos;
+            it->val = (str_s){ 0 };
+            return EOK;
+        }
+        // tape is out of sync, fallback to validating skip
+    }
+
     // Simulate full step-in/next sequence for all nested stuff (because it serves as syntax check)
     u32 scope_depth_initial = it->_impl.scope_depth;
     if (_cex_json__reader__step_in(it, it->type)) { return it->error; }
@@ -202,6 +614,444 @@ str_s _cex_json__reader__get_scope(jr_c* it, JsonType_e scope_type) {
     return result;
 }
 
+// Returns decimal digit value of c, or > 9 if c is not a digit
+static inline u32
+_cex_json__digit(char c)
+{
+    return (u32)((u8)c - '0');
+}
+
+// Parses JSON integer, magnitude limited by pos_limit (positive) or neg_limit (negative numbers)
+static Exception
+_cex_json__reader__get_int(jr_c* it, u64 pos_limit, u64 neg_limit, bool* out_neg, u64* out)
+{
+    if (unlikely(it->error != EOK)) { return it->error; }
+    if (unlikely(it->type != JsonType__num)) { return "Expected number value"; }
+
+    char* cur = it->val.buf;
+    char* end = cur + it->val.len;
+    bool neg = false;
+    if (*cur == '-') {
+        neg = true;
+        cur++;
+    } else if (*cur == '+' && !it->_impl.strict_mode) {
+        cur++;
+    }
+    if (unlikely(cur >= end)) { return Error.argument; }
+    if (unlikely(it->_impl.strict_mode && *cur == '0' && cur + 1 < end)) {
+        return Error.argument; // leading zeros
+    }
+
+    u64 limit = neg ? neg_limit : pos_limit;
+    u64 n = 0;
+    for (; cur < end; cur++) {
+        u32 d = _cex_json__digit(*cur);
+        if (unlikely(d > 9)) { return Error.argument; }
+        if (unlikely(n > limit / 10 || (n == limit / 10 && d > limit % 10))) {
+            return Error.overflow;
+        }
+        n = n * 10 + d;
+    }
+    *out_neg = neg;
+    *out = n;
+    return EOK;
+}
+
+/**
+ * @brief Gets current JSON number value as i64, validates JSON number format in the same pass
+ *
+ * @param it
+ * @param out result
+ * @return Error.argument - not an integer, Error.overflow - out of i64 range
+ */
+Exception
+_cex_json__reader__get_i64(jr_c* it, i64* out)
+{
+    uassert(out != NULL);
+    bool neg = false;
+    u64 n = 0;
+    Exc err = _cex_json__reader__get_int(it, INT64_MAX, (u64)INT64_MAX + 1, &neg, &n);
+    if (unlikely(err != EOK)) { return err; }
+    *out = neg ? (i64)(0 - n) : (i64)n;
+    return EOK;
+}
+
+/**
+ * @brief Gets current JSON number value as u64, validates JSON number format in the same pass
+ *
+ * @param it
+ * @param out result
+ * @return Error.argument - not an integer, Error.overflow - negative or out of u64 range
+ */
+Exception
+_cex_json__reader__get_u64(jr_c* it, u64* out)
+{
+    uassert(out != NULL);
+    bool neg = false;
+    u64 n = 0;
+    Exc err = _cex_json__reader__get_int(it, UINT64_MAX, 0, &neg, &n); // -0 is still 0
+    if (unlikely(err != EOK)) { return err; }
+    *out = n;
+    return EOK;
+}
+
+/**
+ * @brief Gets current JSON number value as f64, validates JSON number format in the same pass
+ *
+ * Numbers with mantissa <= 2^53 and |exponent| <= 22 (or integers fitting u64) are converted
+ * exactly in place, other numbers go through strtod() which is correctly rounded. Numbers longer
+ * than 127 chars (or non "C" locale decimal point) are scaled by powers of 10 (may differ by
+ * few ulp).
+ *
+ * @param it
+ * @param out result
+ * @return Error.argument - bad number format, Error.overflow - out of f64 range
+ */
+Exception
+_cex_json__reader__get_f64(jr_c* it, f64* out)
+{
+    uassert(out != NULL);
+    if (unlikely(it->error != EOK)) { return it->error; }
+    if (unlikely(it->type != JsonType__num)) { return "Expected number value"; }
+
+    static const f64 pow10[] = { 1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                                 1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                                 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+    bool strict = it->_impl.strict_mode;
+    char* cur = it->val.buf;
+    char* end = cur + it->val.len;
+    bool neg = false;
+    if (*cur == '-') {
+        neg = true;
+        cur++;
+    } else if (*cur == '+' && !strict) {
+        cur++;
+    }
+    if (unlikely(cur >= end)) { return Error.argument; }
+    if (unlikely(_cex_json__digit(*cur) > 9)) {
+        if (strict) { return Error.argument; }
+        return str.convert.to_f64s(it->val, out); // nan/inf
+    }
+    if (unlikely(strict && *cur == '0' && cur + 1 < end && _cex_json__digit(cur[1]) <= 9)) {
+        return Error.argument; // leading zeros
+    }
+
+    u64 mantissa = 0;
+    i32 n_digits = 0;   // significant digits in mantissa
+    i32 exponent = 0;   // decimal exponent of mantissa
+    bool is_exact = true;
+    for (; cur < end && _cex_json__digit(*cur) <= 9; cur++) {
+        if (mantissa == 0 && *cur == '0') { continue; }
+        if (n_digits < 19) {
+            mantissa = mantissa * 10 + (*cur - '0');
+            n_digits++;
+        } else {
+            exponent++;
+            is_exact = false;
+        }
+    }
+    if (cur < end && *cur == '.') {
+        cur++;
+        char* frac = cur;
+        for (; cur < end && _cex_json__digit(*cur) <= 9; cur++) {
+            if (mantissa == 0 && *cur == '0') {
+                exponent--;
+                continue;
+            }
+            if (n_digits < 19) {
+                mantissa = mantissa * 10 + (*cur - '0');
+                n_digits++;
+                exponent--;
+            } else {
+                is_exact = false;
+            }
+        }
+        if (unlikely(cur == frac && strict)) { return Error.argument; }
+    }
+    if (cur < end && (*cur == 'e' || *cur == 'E')) {
+        cur++;
+        bool exp_neg = false;
+        if (cur < end && (*cur == '-' || *cur == '+')) { exp_neg = (*cur++ == '-'); }
+        if (unlikely(cur >= end)) { return Error.argument; }
+        i32 e = 0;
+        for (; cur < end && _cex_json__digit(*cur) <= 9; cur++) {
+            if (e < 100000) { e = e * 10 + (*cur - '0'); }
+        }
+        exponent += exp_neg ? -e : e;
+    }
+    if (unlikely(cur != end)) { return Error.argument; }
+
+    if (mantissa == 0) {
+        *out = neg ? -0.0 : 0.0;
+        return EOK;
+    }
+    if (likely(is_exact && mantissa <= (1ULL << 53) && exponent >= -22 && exponent <= 22)) {
+        // exact: mantissa and 10^exponent are representable, only one rounding
+        f64 r = (f64)mantissa;
+        r = (exponent < 0) ? r / pow10[-exponent] : r * pow10[exponent];
+        *out = neg ? -r : r;
+        return EOK;
+    }
+    if (is_exact && exponent >= 0) {
+        // large integers: exact if mantissa * 10^exponent fits u64, and only one rounding
+        while (exponent > 0 && mantissa <= UINT64_MAX / 10) {
+            mantissa *= 10;
+            exponent--;
+        }
+        if (exponent == 0) {
+            *out = neg ? -(f64)mantissa : (f64)mantissa;
+            return EOK;
+        }
+    }
+
+    // 17-19 digits mantissa or big exponent, double rounding is not exact, strtod() is
+    char buf[128];
+    if (it->val.len < sizeof(buf)) {
+        memcpy(buf, it->val.buf, it->val.len);
+        buf[it->val.len] = '\0';
+        char* num_end = NULL;
+        errno = 0;
+        f64 r = strtod(buf, &num_end);
+        if (num_end == buf + it->val.len) { // may stop early on locale decimal point
+            if (unlikely(errno == ERANGE && (r == HUGE_VAL || r == -HUGE_VAL))) {
+                return Error.overflow;
+            }
+            *out = r;
+            return EOK;
+        }
+    }
+
+    // generic case: scaling by 10^22 steps, may differ by few ulp from correctly rounded result
+    f64 r = (f64)mantissa;
+    for (; exponent > 22 && r < 1e300; exponent -= 22) { r *= pow10[22]; }
+    for (; exponent < -22 && r > 0; exponent += 22) { r /= pow10[22]; }
+    if (exponent > 22) { return Error.overflow; }
+    if (exponent >= -22) { r = (exponent < 0) ? r / pow10[-exponent] : r * pow10[exponent]; }
+    if (unlikely(r == (f64)INFINITY)) { return Error.overflow; }
+    *out = neg ? -r : r;
+    return EOK;
+}
+
+/**
+ * @brief Gets current JSON boolean value
+ *
+ * @param it
+ * @param out result
+ * @return
+ */
+Exception
+_cex_json__reader__get_bool(jr_c* it, bool* out)
+{
+    uassert(out != NULL);
+    if (unlikely(it->error != EOK)) { return it->error; }
+    if (unlikely(it->type != JsonType__bool)) { return "Expected bool value"; }
+    *out = it->val.buf[0] == 't';
+    return EOK;
+}
+
+// Decodes JSON string escapes of src into dst (dst may be equal to src, the result is never
+// longer), returns result length or -1 on invalid escape, -2 if dst_cap is too small
+static isize
+_cex_json__unescape(char* src, usize len, char* dst, usize dst_cap, bool strict)
+{
+    char* end = src + len;
+    usize n = 0;
+    while (src < end) {
+        char* bs = memchr(src, '\\', end - src);
+        usize run = ((bs) ? bs : end) - src;
+        if (unlikely(n + run > dst_cap)) { return -2; }
+        if (dst + n != src) { memmove(dst + n, src, run); }
+        n += run;
+        src += run;
+        if (src >= end) { break; }
+
+        // src at backslash
+        if (unlikely(src + 1 >= end)) { return -1; }
+        char c = src[1];
+        src += 2;
+        u32 cp = 0;
+        switch (c) {
+            case '"':
+            case '\\':
+            case '/':
+                cp = c;
+                break;
+            case '\'':
+                if (strict) { return -1; }
+                cp = c;
+                break;
+            case 'b':
+                cp = '\b';
+                break;
+            case 'f':
+                cp = '\f';
+                break;
+            case 'n':
+                cp = '\n';
+                break;
+            case 'r':
+                cp = '\r';
+                break;
+            case 't':
+                cp = '\t';
+                break;
+            case 'u': {
+                for (u32 pair = 0; pair < 2; pair++) {
+                    if (unlikely(end - src < 4)) { return -1; }
+                    u32 u = 0;
+                    for (u32 i = 0; i < 4; i++) {
+                        u8 h = src[i];
+                        u32 v = _cex_json__digit(h);
+                        if (v > 9) {
+                            v = (u32)((h | 0x20) - 'a') + 10;
+                            if (unlikely(v < 10 || v > 15)) { return -1; }
+                        }
+                        u = (u << 4) | v;
+                    }
+                    src += 4;
+                    if (pair == 0) {
+                        cp = u;
+                        // high surrogate must be followed by \uDC00-\uDFFF low surrogate
+                        if (cp < 0xD800 || cp > 0xDBFF) { break; }
+                        if (end - src < 6 || src[0] != '\\' || src[1] != 'u') { break; }
+                        src += 2;
+                    } else if (u >= 0xDC00 && u <= 0xDFFF) {
+                        cp = 0x10000 + ((cp - 0xD800) << 10) + (u - 0xDC00);
+                    } else {
+                        src -= 6; // not a low surrogate, decode it separately
+                    }
+                }
+                if (cp >= 0xD800 && cp <= 0xDFFF) { cp = 0xFFFD; } // lone surrogate
+                break;
+            }
+            default:
+                return -1;
+        }
+
+        // UTF-8 encoding of code point (at most 4 bytes <= 6 bytes of \uXXXX escapes)
+        u8 utf[4];
+        u32 ulen;
+        if (cp < 0x80) {
+            utf[0] = cp;
+            ulen = 1;
+        } else if (cp < 0x800) {
+            utf[0] = 0xC0 | (cp >> 6);
+            utf[1] = 0x80 | (cp & 0x3F);
+            ulen = 2;
+        } else if (cp < 0x10000) {
+            utf[0] = 0xE0 | (cp >> 12);
+            utf[1] = 0x80 | ((cp >> 6) & 0x3F);
+            utf[2] = 0x80 | (cp & 0x3F);
+            ulen = 3;
+        } else {
+            utf[0] = 0xF0 | (cp >> 18);
+            utf[1] = 0x80 | ((cp >> 12) & 0x3F);
+            utf[2] = 0x80 | ((cp >> 6) & 0x3F);
+            utf[3] = 0x80 | (cp & 0x3F);
+            ulen = 4;
+        }
+        if (unlikely(n + ulen > dst_cap)) { return -2; }
+        memcpy(dst + n, utf, ulen);
+        n += ulen;
+    }
+    return n;
+}
+
+/**
+ * @brief Unescapes current JSON string value into buffer (null-terminated)
+ *
+ * @param it
+ * @param buf destination buffer
+ * @param buf_size destination buffer size (including null-terminator)
+ * @return Error.overflow if buf_size is too small
+ */
+Exception
+_cex_json__reader__get_str(jr_c* it, char* buf, usize buf_size)
+{
+    if (unlikely(buf == NULL || buf_size == 0)) { return Error.argument; }
+    buf[0] = '\0';
+    if (unlikely(it->error != EOK)) { return it->error; }
+    if (unlikely(it->type != JsonType__str)) { return "Expected string value"; }
+
+    isize len = _cex_json__unescape(
+        it->val.buf,
+        it->val.len,
+        buf,
+        buf_size - 1,
+        it->_impl.strict_mode
+    );
+    if (unlikely(len < 0)) {
+        buf[0] = '\0';
+        return (len == -2) ? Error.overflow : "Invalid string escape";
+    }
+    buf[len] = '\0';
+    return EOK;
+}
+
+/**
+ * @brief Allocates unescaped copy of current JSON string value (null-terminated)
+ *
+ * @param it
+ * @param out result string
+ * @param allc allocator (e.g. arena, the result can't be longer than raw value)
+ * @return
+ */
+Exception
+_cex_json__reader__get_str_alloc(jr_c* it, char** out, IAllocator allc)
+{
+    uassert(out != NULL);
+    *out = NULL;
+    if (unlikely(allc == NULL)) { return Error.argument; }
+    if (unlikely(it->error != EOK)) { return it->error; }
+    if (unlikely(it->type != JsonType__str)) { return "Expected string value"; }
+
+    char* buf = mem$malloc(allc, it->val.len + 1);
+    if (unlikely(buf == NULL)) { return Error.memory; }
+    isize len = _cex_json__unescape(
+        it->val.buf,
+        it->val.len,
+        buf,
+        it->val.len,
+        it->_impl.strict_mode
+    );
+    if (unlikely(len < 0)) {
+        mem$free(allc, buf);
+        return "Invalid string escape";
+    }
+    buf[len] = '\0';
+    *out = buf;
+    return EOK;
+}
+
+/**
+ * @brief Unescapes current JSON string value in place, i.e. modifies JSON content (the content
+ * can't be parsed again after this!)
+ *
+ * @param it
+ * @param out result slice (pointing to the JSON content)
+ * @return
+ */
+Exception
+_cex_json__reader__get_str_inplace(jr_c* it, str_s* out)
+{
+    uassert(out != NULL);
+    *out = (str_s){ 0 };
+    if (unlikely(it->error != EOK)) { return it->error; }
+    if (unlikely(it->type != JsonType__str)) { return "Expected string value"; }
+
+    isize len = _cex_json__unescape(
+        it->val.buf,
+        it->val.len,
+        it->val.buf,
+        it->val.len,
+        it->_impl.strict_mode
+    );
+    if (unlikely(len < 0)) { return "Invalid string escape"; }
+    it->val.len = len;
+    *out = it->val;
+    return EOK;
+}
+
 bool
 _cex_json__reader__next(jr_c* it)
 {
@@ -317,7 +1167,7 @@ parse_generic:
                 it->_impl.scope_depth--;
                 it->type = JsonType__eos;
                 it->val = (str_s){ 0 };
-                if (it->_impl.scope_depth == 0) { it->_impl.has_items = true; }
+                it->_impl.has_items = true; // closed scope is an item of the parent
                 goto end;
             } else {
                 goto error_unexpected;
@@ -334,7 +1184,7 @@ parse_generic:
                 it->_impl.scope_depth--;
                 it->type = JsonType__eos;
                 it->val = (str_s){ 0 };
-                if (it->_impl.scope_depth == 0) { it->_impl.has_items = true; }
+                it->_impl.has_items = true; // closed scope is an item of the parent
                 goto end;
             } else {
                 goto error_unexpected;
@@ -419,22 +1269,500 @@ error:
     goto end;
 }
 
+// Returns true if record has nothing but whitespace
+static inline bool
+_cex_json__is_blank(char* cur, char* end)
+{
+    while (cur < end && (_cex_json__char_class[(u8)*cur] & $cc_space)) { cur++; }
+    return cur == end;
+}
+
+/**
+ * @brief Create JSON Lines (NDJSON) streaming reader with bounded window buffer
+ *
+ * @param st self instance (typically allocated on stack)
+ * @param stream source stream (not closed by jr$stream_free())
+ * @param allc window buffer allocator
+ * @param kwargs.strict_mode enforces JSON compliant spec for every record
+ * @param kwargs.buf_size initial window buffer size (default: 64KB)
+ * @param kwargs.max_record max record length (default: 64MB)
+ * @return
+ */
+Exception
+_cex_json__stream__create(jr_stream_c* st, FILE* stream, IAllocator allc, jr_stream_kw* kwargs)
+{
+    uassert(st != NULL);
+    if (stream == NULL || allc == NULL) { return Error.argument; }
+
+    jr_stream_kw kw = { 0 };
+    if (kwargs != NULL) { kw = *kwargs; }
+    if (kw.buf_size == 0) { kw.buf_size = 64 * 1024; }
+    if (kw.max_record == 0) { kw.max_record = 64 * 1024 * 1024; }
+    if (kw.buf_size > kw.max_record) { kw.buf_size = kw.max_record; }
+
+    *st = (jr_stream_c){
+        .stream = stream,
+        .allc = allc,
+        ._impl = {
+            .cap = kw.buf_size,
+            .max_record = kw.max_record,
+            .strict_mode = kw.strict_mode,
+        },
+    };
+    st->_impl.buf = mem$malloc(allc, st->_impl.cap);
+    if (st->_impl.buf == NULL) { return Error.memory; }
+    return EOK;
+}
+
+// Moves unread data to the window start, grows window if full, and reads more from stream
+static Exception
+_cex_json__stream__refill(jr_stream_c* st)
+{
+    auto w = &st->_impl;
+    if (w->pos > 0) {
+        memmove(w->buf, w->buf + w->pos, w->len - w->pos);
+        w->len -= w->pos;
+        w->buf_offset += w->pos;
+        w->pos = 0;
+    }
+    if (w->len == w->cap) {
+        if (w->cap >= w->max_record) { return "JSON record is too long"; }
+        usize new_cap = (w->cap > w->max_record / 2) ? w->max_record : w->cap * 2;
+        char* new_buf = mem$realloc(st->allc, w->buf, new_cap);
+        if (new_buf == NULL) { return Error.memory; }
+        w->buf = new_buf;
+        w->cap = new_cap;
+    }
+    usize n = fread(w->buf + w->len, 1, w->cap - w->len, st->stream);
+    if (n == 0) {
+        if (ferror(st->stream)) { return Error.io; }
+        w->eof = true;
+    }
+    w->len += n;
+    return EOK;
+}
+
+/**
+ * @brief Initializes JSON reader with the next non-empty record of the stream
+ *
+ * @param st
+ * @param it JSON reader, valid until the next call (it refers to the window buffer)
+ * @return false at the end of stream or on error (st->error is set)
+ */
+bool
+_cex_json__stream__next(jr_stream_c* st, jr_c* it)
+{
+    uassert(st != NULL);
+    uassert(it != NULL);
+    if (unlikely(st->error != EOK || st->_impl.buf == NULL)) { return false; }
+
+    auto w = &st->_impl;
+    for (;;) {
+        char* start = w->buf + w->pos;
+        char* data_end = w->buf + w->len;
+        char* nl = memchr(start + w->scanned, '\n', data_end - start - w->scanned);
+        if (nl == NULL) {
+            if (!w->eof) {
+                w->scanned = data_end - start;
+                if ((st->error = _cex_json__stream__refill(st))) { return false; }
+                w->scanned = (w->scanned > w->len) ? w->len : w->scanned;
+                continue;
+            }
+            if (start == data_end) { return false; } // EOF
+            nl = data_end;                           // last record without new line
+        }
+
+        st->offset = w->buf_offset + w->pos;
+        st->line = w->next_line++;
+        w->pos = (nl < data_end) ? (usize)(nl - w->buf) + 1 : w->len;
+        w->scanned = 0;
+
+        char* end = nl;
+        if (end > start && end[-1] == '\r') { end--; }
+        if (_cex_json__is_blank(start, end)) { continue; }
+
+        if ((st->error = jr$new(it, start, end - start, .strict_mode = w->strict_mode))) {
+            return false;
+        }
+        return true;
+    }
+}
+
+/**
+ * @brief Frees window buffer of JSON Lines stream reader (stream is not closed)
+ *
+ * @param st
+ */
+void
+_cex_json__stream__destroy(jr_stream_c* st)
+{
+    if (st == NULL) { return; }
+    if (st->_impl.buf != NULL) { mem$free(st->allc, st->_impl.buf); }
+    st->_impl.buf = NULL;
+    st->_impl.len = st->_impl.pos = st->_impl.cap = 0;
+}
+
+typedef struct _cex_json__ndjson_worker_s
+{
+    char* content;      // whole content (for offsets)
+    char* start;        // chunk start
+    char* end;          // chunk end
+    jr_ndjson_kw* kw;   // user arguments
+    u64* min_error;     // shared lowest error offset of all workers (UINT64_MAX - no errors)
+    Exc error;          // worker error
+    u64 error_offset;   // record offset of worker error
+    u32 worker_id;      // worker index
+} _cex_json__ndjson_worker_s;
+
+static void*
+_cex_json__ndjson__worker(void* arg)
+{
+    _cex_json__ndjson_worker_s* wrk = arg;
+    char* cur = wrk->start;
+    while (cur < wrk->end) {
+        // records before the lowest known error are still processed, the first error must win
+        if ((u64)(cur - wrk->content) > __atomic_load_n(wrk->min_error, __ATOMIC_RELAXED)) {
+            break;
+        }
+        char* nl = memchr(cur, '\n', wrk->end - cur);
+        char* end = (nl) ? nl : wrk->end;
+        char* rec = cur;
+        cur = end + 1;
+
+        if (end > rec && end[-1] == '\r') { end--; }
+        if (_cex_json__is_blank(rec, end)) { continue; }
+
+        jr_c js;
+        Exc err = jr$new(&js, rec, end - rec, .strict_mode = wrk->kw->strict_mode);
+        if (err == EOK) { err = wrk->kw->fn(&js, rec - wrk->content, wrk->worker_id, wrk->kw->ctx); }
+        if (err != EOK) {
+            wrk->error = err;
+            wrk->error_offset = rec - wrk->content;
+            u64 min_error = __atomic_load_n(wrk->min_error, __ATOMIC_RELAXED);
+            while (wrk->error_offset < min_error &&
+                   !__atomic_compare_exchange_n(
+                       wrk->min_error,
+                       &min_error,
+                       wrk->error_offset,
+                       true,
+                       __ATOMIC_RELAXED,
+                       __ATOMIC_RELAXED
+                   )) {}
+            break;
+        }
+    }
+    return NULL;
+}
+
+#if defined(CEX_HAS_THREADS)
+static _cex_thread_fn(_cex_json__ndjson__thread, arg)
+{
+    _cex_json__ndjson__worker(arg);
+    _cex_allocator_temp_cleanup(); // tmem$ pages of this thread
+    return 0;
+}
+#endif
+
+/**
+ * @brief Parses JSON Lines (NDJSON) content by chunks split on new lines, across worker threads
+ *
+ * @param content NDJSON content (e.g. mmap-ed file)
+ * @param content_len content length (if 0 length will be recalculated via strlen())
+ * @param kwargs.fn record callback (must be thread safe)
+ * @param kwargs.ctx user context
+ * @param kwargs.n_workers number of threads (default: number of CPUs), 1 - no threads
+ * @param kwargs.strict_mode enforces JSON compliant spec for every record
+ * @return first error (by content position) of fn or jr$new()
+ */
+Exception
+_cex_json__ndjson__parallel(char* content, usize content_len, jr_ndjson_kw* kwargs)
+{
+    if (content == NULL || kwargs == NULL || kwargs->fn == NULL) { return Error.argument; }
+    if (content_len == 0) { content_len = strlen(content); }
+
+    enum
+    {
+        max_workers = 64,
+        min_chunk = 64 * 1024, // smaller chunks are not worth a thread
+    };
+    u32 n_workers = kwargs->n_workers;
+#if defined(CEX_HAS_THREADS)
+    if (n_workers == 0) { n_workers = os.platform.cpu_count(); }
+#else
+    n_workers = 1;
+#endif
+    if (n_workers > max_workers) { n_workers = max_workers; }
+    if (n_workers > content_len / min_chunk + 1) { n_workers = content_len / min_chunk + 1; }
+
+    u64 min_error = UINT64_MAX;
+    _cex_json__ndjson_worker_s workers[max_workers];
+    char* end = content + content_len;
+    char* cur = content;
+    u32 n_chunks = 0;
+    for (u32 i = 0; i < n_workers && cur < end; i++) {
+        char* chunk_end = content + content_len / n_workers * (i + 1);
+        if (i == n_workers - 1 || chunk_end >= end) {
+            chunk_end = end;
+        } else if (chunk_end < cur) {
+            continue;
+        } else {
+            char* nl = memchr(chunk_end, '\n', end - chunk_end);
+            chunk_end = (nl) ? nl + 1 : end;
+        }
+        workers[n_chunks] = (_cex_json__ndjson_worker_s){
+            .content = content,
+            .start = cur,
+            .end = chunk_end,
+            .kw = kwargs,
+            .min_error = &min_error,
+            .worker_id = n_chunks,
+        };
+        n_chunks++;
+        cur = chunk_end;
+    }
+
+#if defined(CEX_HAS_THREADS)
+    _cex_thread_t threads[max_workers];
+    bool started[max_workers] = { 0 };
+    for (u32 i = 1; i < n_chunks; i++) {
+        started[i] = _cex_thread_spawn(&threads[i], _cex_json__ndjson__thread, &workers[i]);
+    }
+    _cex_json__ndjson__worker(&workers[0]); // current thread is worker 0
+    for (u32 i = 1; i < n_chunks; i++) {
+        if (started[i]) {
+            _cex_thread_join(threads[i]);
+        } else {
+            _cex_json__ndjson__worker(&workers[i]); // failed to start, falling back to serial
+        }
+    }
+#else
+    for (u32 i = 0; i < n_chunks; i++) { _cex_json__ndjson__worker(&workers[i]); }
+#endif
+
+    Exc result = EOK;
+    u64 result_offset = 0;
+    for (u32 i = 0; i < n_chunks; i++) {
+        if (workers[i].error != EOK && (result == EOK || workers[i].error_offset < result_offset)) {
+            result = workers[i].error;
+            result_offset = workers[i].error_offset;
+        }
+    }
+    return result;
+}
+
+static void
+_cex_json__writer__flush(jw_c* jw)
+{
+    u32 len = jw->_impl.len;
+    if (len == 0) { return; }
+    jw->_impl.len = 0;
+    if (unlikely(jw->error != EOK)) { return; }
+
+    Exc err = EOK;
+    jw->_impl.buf[len] = '\0';
+    if (jw->buf) {
+        err = sbuf.append(&jw->buf, jw->_impl.buf);
+    } else if (jw->rope) {
+        err = sbuf.rope.append(jw->rope, jw->_impl.buf);
+    } else if (jw->stream) {
+        if (fwrite(jw->_impl.buf, 1, len, jw->stream) != len) { err = Error.io; }
+    }
+    if (unlikely(err != EOK)) { jw->error = err; }
+}
+
+static inline void
+_cex_json__writer__out(jw_c* jw, const char* s, usize len)
+{
+    usize avail = CEX_JSON_WRITER_BUF_SIZE - jw->_impl.len;
+    if (likely(len <= avail)) {
+        memcpy(jw->_impl.buf + jw->_impl.len, s, len);
+        jw->_impl.len += len;
+        return;
+    }
+    while (len > 0) {
+        if (avail == 0) {
+            _cex_json__writer__flush(jw);
+            avail = CEX_JSON_WRITER_BUF_SIZE;
+        }
+        usize n = (len < avail) ? len : avail;
+        memcpy(jw->_impl.buf + jw->_impl.len, s, n);
+        jw->_impl.len += n;
+        avail -= n;
+        s += n;
+        len -= n;
+    }
+}
+
+static void
+_cex_json__writer__outva(jw_c* jw, char* format, va_list va)
+{
+    va_list va2;
+    va_copy(va2, va);
+    usize avail = CEX_JSON_WRITER_BUF_SIZE - jw->_impl.len;
+    int n = cexsp__vsnprintf(jw->_impl.buf + jw->_impl.len, avail + 1, format, va);
+    if (n >= 0 && (usize)n <= avail) {
+        jw->_impl.len += n;
+    } else {
+        // formatted text does not fit into the rest of the buffer
+        jw->_impl.buf[jw->_impl.len] = '\0';
+        _cex_json__writer__flush(jw);
+        if (jw->error == EOK) {
+            if (jw->buf) {
+                Exc err = sbuf.appendfva(&jw->buf, format, va2);
+                if (unlikely(err != EOK)) { jw->error = err; }
+            } else if (jw->rope) {
+                Exc err = sbuf.rope.appendfva(jw->rope, format, va2);
+                if (unlikely(err != EOK)) { jw->error = err; }
+            } else if (jw->stream) {
+                if (cexsp__vfprintf(jw->stream, format, va2) == -1) { jw->error = Error.io; }
+            }
+        }
+    }
+    va_end(va2);
+}
+
+#define $has_less(w, n) /* TEMP MACRO: high bit of every byte < n (n <= 128) */                    \
+    (((w) - 0x0101010101010101ULL * (n)) & ~(w) & 0x8080808080808080ULL)
+#define $has_eq(w, c) /* TEMP MACRO: high bit of every byte equal to c */                          \
+    $has_less((w) ^ (0x0101010101010101ULL * (u8)(c)), 1)
+
+// Writes JSON string contents with escaping (without quotes)
+static void
+_cex_json__writer__out_escaped(jw_c* jw, const char* s, usize len)
+{
+    static const char hex[] = "0123456789abcdef";
+    const char* end = s + len;
+    const char* run = s;
+    const char* p = s;
+
+    while (p < end) {
+        // Skipping 8 bytes at once if there is nothing to escape (SWAR)
+        while (end - p >= 8) {
+            u64 w;
+            memcpy(&w, p, sizeof(w));
+            if ($has_less(w, 0x20) | $has_eq(w, '"') | $has_eq(w, '\\')) { break; }
+            p += 8;
+        }
+        if (p >= end) { break; }
+
+        u8 c = (u8)*p;
+        if (likely(c >= 0x20 && c != '"' && c != '\\')) {
+            p++;
+            continue;
+        }
+
+        _cex_json__writer__out(jw, run, p - run);
+        char esc[6] = { '\\', 0, '0', '0', 0, 0 };
+        usize esc_len = 2;
+        switch (c) {
+            case '"':
+            case '\\':
+                esc[1] = c;
+                break;
+            case '\b':
+                esc[1] = 'b';
+                break;
+            case '\f':
+                esc[1] = 'f';
+                break;
+            case '\n':
+                esc[1] = 'n';
+                break;
+            case '\r':
+                esc[1] = 'r';
+                break;
+            case '\t':
+                esc[1] = 't';
+                break;
+            default:
+                esc[1] = 'u';
+                esc[4] = hex[c >> 4];
+                esc[5] = hex[c & 0xf];
+                esc_len = 6;
+        }
+        _cex_json__writer__out(jw, esc, esc_len);
+        p++;
+        run = p;
+    }
+    _cex_json__writer__out(jw, run, end - run);
+}
+#undef $has_less
+#undef $has_eq
+
+static void
+_cex_json__writer__out_str(jw_c* jw, const char* s, usize len)
+{
+    _cex_json__writer__out(jw, "\"", 1);
+    _cex_json__writer__out_escaped(jw, s, len);
+    _cex_json__writer__out(jw, "\"", 1);
+}
+
+typedef struct _cex_json__writer__fmt_ctx_s
+{
+    jw_c* jw;
+    char tmp[CEX_SPRINTF_MIN];
+} _cex_json__writer__fmt_ctx_s;
+
+// cexsp__vsprintfcb() callback, escapes formatted text chunks into the writer buffer
+static char*
+_cex_json__writer__escaped_cb(char* buf, void* user, u32 len)
+{
+    _cex_json__writer__fmt_ctx_s* ctx = user;
+    if (len) { _cex_json__writer__out_escaped(ctx->jw, buf, len); }
+    return ctx->tmp;
+}
+
+static usize
+_cex_json__u64_to_str(u64 val, char* buf_end)
+{
+    static const char digits2[] = "00010203040506070809101112131415161718192021222324"
+                                  "25262728293031323334353637383940414243444546474849"
+                                  "50515253545556575859606162636465666768697071727374"
+                                  "75767778798081828384858687888990919293949596979899";
+    // writes digits backwards, returns length
+    char* p = buf_end;
+    while (val >= 100) {
+        u32 i = (u32)(val % 100) * 2;
+        val /= 100;
+        *--p = digits2[i + 1];
+        *--p = digits2[i];
+    }
+    if (val >= 10) {
+        u32 i = (u32)val * 2;
+        *--p = digits2[i + 1];
+        *--p = digits2[i];
+    } else {
+        *--p = (char)('0' + val);
+    }
+    return (usize)(buf_end - p);
+}
+
 void
 _cex_json_writer_indent(jw_c* jw, bool last_item)
 {
+    static const char spaces[] = "                                ";
     if (unlikely(jw->error != EOK)) { return; }
     if (jw->scope_depth && jw->scope_stack[jw->scope_depth - 1] & $scope_has_items) {
-        if (!last_item) { $print(", ", ""); }
-        if (jw->indent_width) { $print("\n", ""); }
+        if (!last_item) {
+            if (jw->compact) {
+                _cex_json__writer__out(jw, ",", 1);
+            } else {
+                _cex_json__writer__out(jw, ", ", 2);
+            }
+        }
+        if (jw->indent_width) { _cex_json__writer__out(jw, "\n", 1); }
     } else {
         if (!last_item) {
-            if (jw->indent_width && jw->scope_depth) { $print("\n", ""); }
+            if (jw->indent_width && jw->scope_depth) { _cex_json__writer__out(jw, "\n", 1); }
         } else {
             // skipping indent for empty obj/arr -> {} or []
             return;
         }
     }
-    for (u32 i = 0; i < jw->indent; i++) { $print(" ", ""); }
+    for (u32 i = 0; i < jw->indent; i += sizeof(spaces) - 1) {
+        u32 n = jw->indent - i;
+        _cex_json__writer__out(jw, spaces, (n < sizeof(spaces) - 1) ? n : sizeof(spaces) - 1);
+    }
 }
 
 /**
@@ -452,28 +1780,36 @@ _cex_json__writer__create(jw_c* jw, jw_kw* kwargs)
     uassert(jw != NULL);
     uassert(kwargs != NULL);
 
-    if (kwargs->buf == NULL && kwargs->stream == NULL) { return "Empty buf and stream kwargs"; }
-    if (kwargs->buf != NULL && kwargs->stream != NULL) {
-        return "buf and stream kwargs are mutually exclusive";
-    }
+    u32 n_outputs = (kwargs->buf != NULL) + (kwargs->stream != NULL) + (kwargs->rope != NULL);
+    if (n_outputs == 0) { return "Empty buf and stream kwargs"; }
+    if (n_outputs > 1) { return "buf, rope and stream kwargs are mutually exclusive"; }
 
-    *jw = (jw_c){
-        .indent_width = kwargs->indent,
-        .buf = kwargs->buf,
-        .stream = kwargs->stream,
-    };
+    jw->stream = kwargs->stream;
+    jw->buf = kwargs->buf;
+    jw->rope = kwargs->rope;
+    jw->error = EOK;
+    jw->indent = 0;
+    jw->indent_width = (kwargs->compact) ? 0 : kwargs->indent;
+    jw->scope_depth = 0;
+    jw->compact = kwargs->compact;
+    jw->_impl.len = 0;
 
     return EOK;
 }
 
-void
-_cex_json__writer__print(jw_c* jw, char* format, ...)
+static inline void
+_cex_json__writer__item_begin(jw_c* jw)
 {
     u8 last_scope = $last_scope(jw);
-    if (!(last_scope & $scope_has_key)) { _cex_json_writer_indent(jw, false); }
-
-    $printva();
+    if (!(last_scope & $scope_has_key)) {
+        uassertf(!(last_scope & $scope_obj), "Writing jw$val() without setting jw$key() before");
+        _cex_json_writer_indent(jw, false);
+    }
+}
 
+static inline void
+_cex_json__writer__item_end(jw_c* jw)
+{
     if (jw->scope_depth && jw->scope_stack[jw->scope_depth - 1]) {
         jw->scope_stack[jw->scope_depth - 1] |= $scope_has_items;
         jw->scope_stack[jw->scope_depth - 1] &= ~$scope_has_key;
@@ -481,23 +1817,171 @@ _cex_json__writer__print(jw_c* jw, char* format, ...)
 }
 
 void
-_cex_json__writer__print_item(jw_c* jw, char* format, ...)
+_cex_json__writer__print(jw_c* jw, char* format, ...)
 {
     u8 last_scope = $last_scope(jw);
-    // if (!(last_scope & $scope_has_key)) { _cex_json_writer_indent(jw, false); }
+    if (!(last_scope & $scope_has_key)) { _cex_json_writer_indent(jw, false); }
 
-    if (!(last_scope & $scope_has_key)) {
-        uassertf(!(last_scope & $scope_obj), "Writing jw$val() without setting jw$key() before");
-        _cex_json_writer_indent(jw, false);
+    if (jw->error == EOK) {
+        va_list va;
+        va_start(va, format);
+        _cex_json__writer__outva(jw, format, va);
+        va_end(va);
     }
+    _cex_json__writer__item_end(jw);
+}
 
-    // if (!(last_scope & $scope_has_key) && (last_scope & $scope_has_items)) {
-    // _cex_json_writer_indent(jw, false); }
-    $printva();
-    if (jw->scope_depth && jw->scope_stack[jw->scope_depth - 1]) {
-        jw->scope_stack[jw->scope_depth - 1] |= $scope_has_items;
-        jw->scope_stack[jw->scope_depth - 1] &= ~$scope_has_key;
+void
+_cex_json__writer__print_item(jw_c* jw, char* format, ...)
+{
+    _cex_json__writer__item_begin(jw);
+    if (jw->error == EOK) {
+        va_list va;
+        va_start(va, format);
+        _cex_json__writer__outva(jw, format, va);
+        va_end(va);
     }
+    _cex_json__writer__item_end(jw);
+}
+
+void
+_cex_json__writer__val_i64(jw_c* jw, i64 val)
+{
+    _cex_json__writer__item_begin(jw);
+    char buf[24];
+    char* end = buf + sizeof(buf);
+    usize len = _cex_json__u64_to_str((val < 0) ? -(u64)val : (u64)val, end);
+    if (val < 0) {
+        len++;
+        end[-(isize)len] = '-';
+    }
+    _cex_json__writer__out(jw, end - len, len);
+    _cex_json__writer__item_end(jw);
+}
+
+void
+_cex_json__writer__val_u64(jw_c* jw, u64 val)
+{
+    _cex_json__writer__item_begin(jw);
+    char buf[24];
+    char* end = buf + sizeof(buf);
+    usize len = _cex_json__u64_to_str(val, end);
+    _cex_json__writer__out(jw, end - len, len);
+    _cex_json__writer__item_end(jw);
+}
+
+static void
+_cex_json__writer__out_float(jw_c* jw, f64 val, bool is_f32)
+{
+    if (isnan(val) || isinf(val)) {
+        // no JSON representation for nan/inf
+        _cex_json__writer__out(jw, "null", 4);
+        return;
+    }
+    if (val == 0) {
+        if (signbit(val)) {
+            _cex_json__writer__out(jw, "-0", 2);
+        } else {
+            _cex_json__writer__out(jw, "0", 1);
+        }
+        return;
+    }
+    if (val > -9007199254740992.0 && val < 9007199254740992.0 && val == (f64)(i64)val) {
+        // exact integer, no float formatting needed
+        char buf[24];
+        char* end = buf + sizeof(buf);
+        usize len = _cex_json__u64_to_str((val < 0) ? -(u64)(i64)val : (u64)(i64)val, end);
+        if (val < 0) {
+            len++;
+            end[-(isize)len] = '-';
+        }
+        _cex_json__writer__out(jw, end - len, len);
+        return;
+    }
+
+    // Shortest of %.15g/%.16g/%.17g (%.6g - %.9g for f32) which round trips to the same value
+    char buf[40];
+    int prec = (is_f32) ? 6 : 15;
+    int max_prec = (is_f32) ? 9 : 17;
+    int len = 0;
+    for (; prec <= max_prec; prec++) {
+        len = cexsp__snprintf(buf, sizeof(buf), "%.*g", prec, val);
+        if (prec == max_prec) { break; }
+        if (is_f32) {
+            if (strtof(buf, NULL) == (f32)val) { break; }
+        } else {
+            if (strtod(buf, NULL) == val) { break; }
+        }
+    }
+    _cex_json__writer__out(jw, buf, len);
+}
+
+void
+_cex_json__writer__val_f64(jw_c* jw, f64 val)
+{
+    _cex_json__writer__item_begin(jw);
+    _cex_json__writer__out_float(jw, val, false);
+    _cex_json__writer__item_end(jw);
+}
+
+void
+_cex_json__writer__val_f32(jw_c* jw, f32 val)
+{
+    _cex_json__writer__item_begin(jw);
+    _cex_json__writer__out_float(jw, val, true);
+    _cex_json__writer__item_end(jw);
+}
+
+void
+_cex_json__writer__val_bool(jw_c* jw, bool val)
+{
+    _cex_json__writer__item_begin(jw);
+    if (val) {
+        _cex_json__writer__out(jw, "true", 4);
+    } else {
+        _cex_json__writer__out(jw, "false", 5);
+    }
+    _cex_json__writer__item_end(jw);
+}
+
+void
+_cex_json__writer__val_null(jw_c* jw)
+{
+    _cex_json__writer__item_begin(jw);
+    _cex_json__writer__out(jw, "null", 4);
+    _cex_json__writer__item_end(jw);
+}
+
+void
+_cex_json__writer__val_char(jw_c* jw, char val)
+{
+    _cex_json__writer__item_begin(jw);
+    _cex_json__writer__out_str(jw, &val, 1);
+    _cex_json__writer__item_end(jw);
+}
+
+void
+_cex_json__writer__val_str(jw_c* jw, str_s val)
+{
+    _cex_json__writer__item_begin(jw);
+    if (val.buf == NULL) {
+        _cex_json__writer__out(jw, "null", 4);
+    } else {
+        _cex_json__writer__out_str(jw, val.buf, val.len);
+    }
+    _cex_json__writer__item_end(jw);
+}
+
+void
+_cex_json__writer__val_cstr(jw_c* jw, const char* val)
+{
+    _cex_json__writer__item_begin(jw);
+    if (val == NULL) {
+        _cex_json__writer__out(jw, "null", 4);
+    } else {
+        _cex_json__writer__out_str(jw, val, strlen(val));
+    }
+    _cex_json__writer__item_end(jw);
 }
 
 void
@@ -508,9 +1992,29 @@ _cex_json__writer__print_key(jw_c* jw, char* format, ...)
         "Expected to be in json object scope"
     );
     _cex_json_writer_indent(jw, false);
-    $print("\"", "");
-    $printva();
-    $print("\": ", "");
+    if (format[0] != '\x1f' && strchr(format, '%') == NULL) {
+        // literal key (fmt$() compiled formats start with "\x1fcexfmt" magic)
+        _cex_json__writer__out_str(jw, format, strlen(format));
+    } else {
+        _cex_json__writer__fmt_ctx_s ctx = { .jw = jw };
+        va_list va;
+        va_start(va, format);
+        _cex_json__writer__out(jw, "\"", 1);
+        cexsp__vsprintfcb(
+            _cex_json__writer__escaped_cb,
+            &ctx,
+            _cex_json__writer__escaped_cb(NULL, &ctx, 0),
+            format,
+            va
+        );
+        _cex_json__writer__out(jw, "\"", 1);
+        va_end(va);
+    }
+    if (jw->compact) {
+        _cex_json__writer__out(jw, ":", 1);
+    } else {
+        _cex_json__writer__out(jw, ": ", 2);
+    }
     if (jw->scope_depth && jw->scope_stack[jw->scope_depth - 1]) {
         jw->scope_stack[jw->scope_depth - 1] |= $scope_has_items;
         jw->scope_stack[jw->scope_depth - 1] |= $scope_has_key;
@@ -528,11 +2032,13 @@ _cex_json__writer__print_scope_enter(jw_c* jw, JsonType_e scope_type, bool shoul
             !(last_scope & $scope_obj),
             "Entering jw$scope() value without setting jw$key() before"
         );
-        if (last_scope & $scope_has_items) { _cex_json_writer_indent(jw, false); }
+        if (jw->scope_depth) { _cex_json_writer_indent(jw, false); }
     }
+    // nested scope is an item of the parent scope
+    _cex_json__writer__item_end(jw);
 
     if (scope_type == JsonType__obj) {
-        $print("%c", '{');
+        _cex_json__writer__out(jw, "{", 1);
         if (jw->scope_depth <= sizeof(jw->scope_stack) - 1) {
             jw->scope_stack[jw->scope_depth] = $scope_obj;
             jw->scope_depth++;
@@ -540,7 +2046,7 @@ _cex_json__writer__print_scope_enter(jw_c* jw, JsonType_e scope_type, bool shoul
             jw->error = "Scope overflow";
         }
     } else if (scope_type == JsonType__arr) {
-        $print("%c", '[');
+        _cex_json__writer__out(jw, "[", 1);
         if (jw->scope_depth <= sizeof(jw->scope_stack) - 1) {
             jw->scope_stack[jw->scope_depth] = $scope_arr;
             jw->scope_depth++;
@@ -565,23 +2071,31 @@ _cex_json__writer__print_scope_exit(jw_c** jwptr)
     if (jw->scope_depth > 0) {
         _cex_json_writer_indent(jw, true);
 
-        $print("%c", (jw->scope_stack[jw->scope_depth - 1] & $scope_arr) ? ']' : '}');
+        _cex_json__writer__out(
+            jw,
+            (jw->scope_stack[jw->scope_depth - 1] & $scope_arr) ? "]" : "}",
+            1
+        );
         jw->scope_depth--;
     } else {
         jw->error = "Scope overflow";
     }
+    if (jw->scope_depth == 0) { _cex_json__writer__flush(jw); }
 }
 
 Exception
 _cex_json__writer__validate(jw_c* jw)
 {
     if (jw == NULL) { return Error.argument; }
+    _cex_json__writer__flush(jw);
     return jw->error;
 }
 
 #undef $next_tok /* TEMP MACRO */
-#undef $print
-#undef $printva
+#undef $cc_space
+#undef $cc_ident
+#undef $cc_digit
+#undef $cc_struct
 #undef $scope_obj
 #undef $scope_arr
 #undef $scope_has_items
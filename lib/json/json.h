@@ -4,6 +4,11 @@
 #    define CEX_MAX_JSON_DEPTH 128
 #endif
 
+#ifndef CEX_JSON_WRITER_BUF_SIZE
+/// jw$ output is staged in internal buffer and flushed to buf/rope/stream in blocks of this size
+#    define CEX_JSON_WRITER_BUF_SIZE 4096
+#endif
+
 /// JSON Reader Namespace
 #define __jr$
 
@@ -46,6 +51,33 @@
 #define jr$get_scope_str_s(json_reader, json_type)                                                 \
     _cex_json__reader__get_scope((json_reader), json_type)
 
+/// Gets current json_reader number value as i64 (validates JSON number, integers only)
+#define jr$get_i64(json_reader, out_i64_ptr) _cex_json__reader__get_i64((json_reader), (out_i64_ptr))
+
+/// Gets current json_reader number value as u64 (validates JSON number, non-negative integers only)
+#define jr$get_u64(json_reader, out_u64_ptr) _cex_json__reader__get_u64((json_reader), (out_u64_ptr))
+
+/// Gets current json_reader number value as f64 (validates JSON number)
+#define jr$get_f64(json_reader, out_f64_ptr) _cex_json__reader__get_f64((json_reader), (out_f64_ptr))
+
+/// Gets current json_reader boolean value
+#define jr$get_bool(json_reader, out_bool_ptr)                                                     \
+    _cex_json__reader__get_bool((json_reader), (out_bool_ptr))
+
+/// Unescapes current json_reader string value into buf[buf_size] (null-terminated), strings
+/// without escapes are just copied. Returns Error.overflow if buffer is too small.
+#define jr$get_str(json_reader, buf, buf_size)                                                     \
+    _cex_json__reader__get_str((json_reader), (buf), (buf_size))
+
+/// Allocates unescaped null-terminated copy of current json_reader string value
+#define jr$get_str_alloc(json_reader, out_char_ptr, allocator)                                     \
+    _cex_json__reader__get_str_alloc((json_reader), (out_char_ptr), (allocator))
+
+/// Unescapes current json_reader string value in place (content must be mutable, and it can't be
+/// parsed again), out_str_s_ptr and json_reader.val point to the result
+#define jr$get_str_inplace(json_reader, out_str_s_ptr)                                             \
+    _cex_json__reader__get_str_inplace((json_reader), (out_str_s_ptr))
+
 /// Context specific iterator over json_reader scope:
 /// jr$foreach(val, json_reader) - iterates over array scope items
 /// jr$foreach(key, val, json_reader) - iterates over object scope key:value pairs
@@ -90,9 +122,36 @@ typedef enum JsonType_e
 } JsonType_e;
 
 
+/// Scope offsets of jr_tape_c index (relative to content start)
+typedef struct jr_tape_scope_s
+{
+    usize start;    // opening bracket offset
+    usize end;      // closing bracket offset
+    usize n_nested; // number of all nested scopes inside
+} jr_tape_scope_s;
+
+/// Optional JSON reader scope offsets index, built by jr$new(..., .tape = &tape), next readers of
+/// the same unchanged content may reuse it via .tape_reuse = true. Makes skipping and
+/// jr$get_scope_str_s() O(1).
+/// Usage: jr_tape_c tape = { .allc = mem$ }; ... jr$tape_free(&tape);
+typedef struct jr_tape_c
+{
+    IAllocator allc;              // allocator for scopes index
+    char* content;                // content the tape was built for (NULL if not valid)
+    usize content_len;            // content length the tape was built for
+    arr$(jr_tape_scope_s) scopes; // scopes in order of opening brackets
+} jr_tape_c;
+
+/// Frees JSON reader tape memory
+#define jr$tape_free(tape) _cex_json__reader__tape_free((tape))
+
+/// JSON Reader jr$new() keyword arguments
 typedef struct jr_kw
 {
-    bool strict_mode;
+    bool strict_mode;   // enforces JSON compliant spec
+    bool trusted_input; // skipped scopes are not validated, only brackets are counted
+    jr_tape_c* tape;    // optional scope offsets index (skipped scopes are not validated)
+    bool tape_reuse;    // reuse tape built for the same content (caller guarantees it's unchanged)
 } jr_kw;
 
 typedef struct jr_c
@@ -104,8 +163,12 @@ typedef struct jr_c
 
     struct
     {
-        CexParser_c lexer;   // JSON lexer
+        CexParser_c lexer;   // JSON lexer state (content, cursor, line/col)
+        char* line_start;    // last new line position (for col calculation)
+        jr_tape_c* tape;     // scope offsets index (optional)
+        usize scope_idx;     // ordinal of last opened scope (for tape lookups)
         bool strict_mode;    // enforces JSON compliant spec
+        bool trusted_input;  // fast skipping without validation
         bool has_items;      // flag is set when at least one item processed in scope
         CexTkn_e prev_token; // JSON previous token
         CexTkn_e curr_token; // JSON current token
@@ -115,12 +178,89 @@ typedef struct jr_c
 
 } jr_c;
 
+/// JSON Lines (NDJSON) streaming reader, jr$stream_new() keyword arguments
+typedef struct jr_stream_kw
+{
+    bool strict_mode; // enforces JSON compliant spec for every record
+    usize buf_size;   // initial window buffer size (default: 64KB)
+    usize max_record; // max record length, window never grows beyond (default: 64MB)
+} jr_stream_kw;
+
+/// JSON Lines (NDJSON) streaming reader, emits one top-level JSON value per line, and keeps
+/// bounded memory window over the stream (records can't be larger than max_record).
+typedef struct jr_stream_c
+{
+    FILE* stream;    // source stream
+    IAllocator allc; // window buffer allocator
+    Exc error;       // last stream error (I/O, record overflow, or record jr$new() error)
+    u64 offset;      // stream offset of the current record
+    u64 line;        // line number of the current record (0-based)
+
+    struct
+    {
+        char* buf;         // window buffer
+        usize len;         // data length in window
+        usize pos;         // next record position in window
+        usize scanned;     // bytes after pos without new lines
+        usize cap;         // window capacity
+        usize max_record;  // window capacity limit
+        u64 buf_offset;    // stream offset of window start
+        u64 next_line;     // line number of the next record
+        bool strict_mode;  // enforces JSON compliant spec
+        bool eof;          // stream end reached
+    } _impl;
+} jr_stream_c;
+
+/// Creates JSON Lines (NDJSON) streaming reader over FILE*, kwargs... are optional see:
+/// jr_stream_kw. Use fdopen() for raw file descriptors.
+#define jr$stream_new(jr_stream, stream, allocator, kwargs...)                                     \
+    _cex_json__stream__create((jr_stream), (stream), (allocator), &(jr_stream_kw){ kwargs })
+
+/// Initializes json_reader (jr_c) with next non-empty record of the stream, returns false at the
+/// end of stream or on error (check jr_stream.error). The record content is valid until the next
+/// call. Usage:
+/// while (jr$stream_next(&jrs, &js)) { jr$foreach(k, v, &js) { ... } }
+#define jr$stream_next(jr_stream, json_reader) _cex_json__stream__next((jr_stream), (json_reader))
+
+/// Frees JSON Lines stream reader window buffer (stream is not closed)
+#define jr$stream_free(jr_stream) _cex_json__stream__destroy((jr_stream))
+
+/*clang-format off*/
+
+/// Same as jr$err_fmt(), but reports absolute line and stream offset of the current record
+#define jr$stream_err_fmt(jr_stream, json_reader)                                                  \
+    "JSON %s(%s) at line: %lu col: %d offset: %lu\n",                                              \
+        ((jr_stream)->error || (json_reader)->error) ? "Parsing Error " : "",                      \
+        (jr_stream)->error ? (jr_stream)->error                                                    \
+                           : ((json_reader)->error ? (json_reader)->error : "OK"),                 \
+        (u64)((jr_stream)->line + 1), (json_reader)->_impl.lexer.col, (u64)(jr_stream)->offset
+
+/*clang-format on*/
+
+/// Parallel JSON Lines (NDJSON) parsing, jr$ndjson_parallel() keyword arguments
+typedef struct jr_ndjson_kw
+{
+    // record callback, must be thread safe, offset is a record position in content
+    Exception (*fn)(jr_c* record, u64 offset, u32 worker_id, void* ctx);
+    void* ctx;        // user context for fn
+    u32 n_workers;    // number of threads (default: number of CPUs)
+    bool strict_mode; // enforces JSON compliant spec for every record
+} jr_ndjson_kw;
+
+/// Parses JSON Lines (NDJSON) content in parallel, content is split into chunks on new line
+/// boundaries, each chunk records are passed to kwargs.fn in order by a worker thread. Returns
+/// the first error (by content position) of fn or jr$new().
+#define jr$ndjson_parallel(content, content_len, kwargs...)                                        \
+    _cex_json__ndjson__parallel((content), (content_len), &(jr_ndjson_kw){ kwargs })
+
 /// JSON Writer jw$new() keyword arguments 
 typedef struct jw_kw
 {
     FILE* stream;
     sbuf_c buf;
+    sbuf_rope_c* rope;
     u32 indent;
+    bool compact; // minified output without spaces after `,` and `:` (indent is ignored)
 } jw_kw;
 
 /// JSON Writer container type
@@ -128,54 +268,67 @@ typedef struct jw_c
 {
     FILE* stream;
     sbuf_c buf;
+    sbuf_rope_c* rope;
     Exc error;
     u32 indent;
     u32 indent_width;
     u32 scope_depth;
+    bool compact;
     u8 scope_stack[CEX_MAX_JSON_DEPTH];
+    struct
+    {
+        u32 len;
+        char buf[CEX_JSON_WRITER_BUF_SIZE + 1];
+    } _impl;
 } jw_c;
 
 /// JSON Writer Namespace
 #define __jw$
 
 /// Creates new instance of json writer, non allocating serializer, with support of exporting to
-/// FILE* or backing by string buffer sbuf_c
+/// FILE* or backing by string buffer sbuf_c, or chunked sbuf_rope_c for very large outputs.
+/// Output is buffered internally, and flushed when the top level jw$scope() is closed, or
+/// by jw$validate()
 #define jw$new(json_writer, kwargs...)                                                             \
     _cex_json__writer__create((json_writer), &(jw_kw){ kwargs })
 
-/// Checks if json writer has no errors
+/// Checks if json writer has no errors, and flushes pending output
 #define jw$validate(json_writer) _cex_json__writer__validate((json_writer))
 
-/// Writes a new key (must be in jw$scope(jw, JsonType__obj))
+/// Writes a new key (must be in jw$scope(jw, JsonType__obj)), key is escaped
 #define jw$key(format, ...) _cex_json__writer__print_key(_jw$scope_var, format, ##__VA_ARGS__)
 
 /// Writes a new value to the json scope (object or array), expects json compatible primitive
-/// arguments. Use `jr$fmt` for customizable output.
+/// arguments. Strings are escaped, NULL strings and nan/inf floats are written as null.
+/// Use `jw$fmt` for customizable output.
 #define jw$val(json_compatible_val)                                                                \
-    ({                                                                                             \
-        char* format = _Generic(                                                                   \
-            json_compatible_val,                                                                   \
-            u8: "%d",                                                                              \
-            i8: "%d",                                                                              \
-            i16: "%d",                                                                             \
-            u16: "%d",                                                                             \
-            i32: "%d",                                                                             \
-            u32: "%u",                                                                             \
-            i64: "%ld",                                                                            \
-            u64: "%lu",                                                                            \
-            f32: "%f",                                                                             \
-            f64: "%f",                                                                             \
-            char: "\"%c\"",                                                                        \
-            _Bool: "%d",                                                                           \
-            str_s: "\"%S\"",                                                                       \
-            const char*: "\"%s\"",                                                                 \
-            char*: "\"%s\""                                                                        \
-        );                                                                                         \
-        _cex_json__writer__print_item(_jw$scope_var, format, json_compatible_val);                  \
-    })
+    _Generic(                                                                                      \
+        (json_compatible_val),                                                                     \
+        u8: _cex_json__writer__val_u64,                                                            \
+        i8: _cex_json__writer__val_i64,                                                            \
+        i16: _cex_json__writer__val_i64,                                                           \
+        u16: _cex_json__writer__val_u64,                                                           \
+        i32: _cex_json__writer__val_i64,                                                           \
+        u32: _cex_json__writer__val_u64,                                                           \
+        i64: _cex_json__writer__val_i64,                                                           \
+        u64: _cex_json__writer__val_u64,                                                           \
+        f32: _cex_json__writer__val_f32,                                                           \
+        f64: _cex_json__writer__val_f64,                                                           \
+        char: _cex_json__writer__val_char,                                                         \
+        _Bool: _cex_json__writer__val_bool,                                                        \
+        str_s: _cex_json__writer__val_str,                                                         \
+        const char*: _cex_json__writer__val_cstr,                                                  \
+        char*: _cex_json__writer__val_cstr                                                         \
+    )(_jw$scope_var, json_compatible_val)
 
 #define _jw$scope_var _json_writer_macro_scope
 
+/// Writes a new boolean value (true/false) to the json scope
+#define jw$bool(bool_val) _cex_json__writer__val_bool(_jw$scope_var, (bool_val))
+
+/// Writes a new null value to the json scope
+#define jw$null() _cex_json__writer__val_null(_jw$scope_var)
+
 /// Opens JSON scope, jsontype_arr_or_obj expects JsonType__obj or JsonType__arr
 #define jw$scope(json_writer_ptr, jsontype_arr_or_obj)                                             \
     for (jw_c * _jw$scope_var                                                              \
@@ -194,11 +347,32 @@ Exception _cex_json__reader__create(jr_c* it, char* content, usize content_len,
 Exception _cex_json__reader__step_in(jr_c* it, JsonType_e expected_type);
 bool _cex_json__reader__next(jr_c* it);
 str_s _cex_json__reader__get_scope(jr_c* it, JsonType_e scope_type);
+void _cex_json__reader__tape_free(jr_tape_c* tape);
+Exception _cex_json__reader__get_i64(jr_c* it, i64* out);
+Exception _cex_json__reader__get_u64(jr_c* it, u64* out);
+Exception _cex_json__reader__get_f64(jr_c* it, f64* out);
+Exception _cex_json__reader__get_bool(jr_c* it, bool* out);
+Exception _cex_json__reader__get_str(jr_c* it, char* buf, usize buf_size);
+Exception _cex_json__reader__get_str_alloc(jr_c* it, char** out, IAllocator allc);
+Exception _cex_json__reader__get_str_inplace(jr_c* it, str_s* out);
+Exception _cex_json__stream__create(jr_stream_c* st, FILE* stream, IAllocator allc, jr_stream_kw* kwargs);
+bool _cex_json__stream__next(jr_stream_c* st, jr_c* it);
+void _cex_json__stream__destroy(jr_stream_c* st);
+Exception _cex_json__ndjson__parallel(char* content, usize content_len, jr_ndjson_kw* kwargs);
 
 
 void _cex_json__writer__print(jw_c* jw, char* format, ...);
 void _cex_json__writer__print_item(jw_c* jw, char* format, ...);
 void _cex_json__writer__print_key(jw_c* jw, char* format, ...);
+void _cex_json__writer__val_i64(jw_c* jw, i64 val);
+void _cex_json__writer__val_u64(jw_c* jw, u64 val);
+void _cex_json__writer__val_f64(jw_c* jw, f64 val);
+void _cex_json__writer__val_f32(jw_c* jw, f32 val);
+void _cex_json__writer__val_bool(jw_c* jw, bool val);
+void _cex_json__writer__val_char(jw_c* jw, char val);
+void _cex_json__writer__val_str(jw_c* jw, str_s val);
+void _cex_json__writer__val_cstr(jw_c* jw, const char* val);
+void _cex_json__writer__val_null(jw_c* jw);
 void _cex_json__writer__print_scope_exit(jw_c** jwptr);
 jw_c* _cex_json__writer__print_scope_enter(jw_c* jw, JsonType_e scope_type, bool should_indent);
 Exception _cex_json__writer__create(jw_c* jw, jw_kw* kwargs);
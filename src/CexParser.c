@@ -1,7 +1,6 @@
 #if !defined(cex$enable_minimal)
 
 #include "CexParser.h"
-#include <ctype.h>
 #include "str.h"
 
 const char* CexTkn_str[] = {
@@ -15,30 +14,93 @@ const char* CexTkn_str[] = {
     ({                                                                                             \
         char res = '\0';                                                                           \
         if ((lx->cur < lx->content_end)) {                                                         \
-            if (*lx->cur == '\n') { lx->line++; lx->col = 0;}                                                  \
-            lx->col++;\
+            if (*lx->cur == '\n') {                                                                \
+                lx->line++;                                                                        \
+                lx->col = 0;                                                                       \
+            }                                                                                      \
+            lx->col++;                                                                             \
             res = *(lx->cur++);                                                                    \
         }                                                                                          \
         res;                                                                                       \
     })
 
-#define lx$rewind(lx)                                                                              \
-    ({                                                                                             \
-        if (lx->cur > lx->content) {                                                               \
-            lx->cur--;                                                                             \
-            if (*lx->cur == '\n') { lx->line--; }                                                  \
-        }                                                                                          \
-    })
-
 #define lx$peek(lx) ((lx->cur < lx->content_end) ? *lx->cur : '\0')
 
 #define lx$peek_next(lx) ((lx->cur + 1 < lx->content_end) ? lx->cur[1] : '\0')
 
-#define lx$skip_space(lx, c)                                                                       \
-    while (c && isspace((c))) {                                                                    \
-        lx$next(lx);                                                                               \
-        (c) = lx$peek(lx);                                                                         \
+/* Character classes (C locale isspace/isalnum + C specific) */
+#define lx$cc_space (1 << 0)     // isspace()
+#define lx$cc_ident (1 << 1)     // isalnum() or _ or $
+#define lx$cc_ident_1st (1 << 2) // isalpha() or _ or $
+#define lx$cc_digit (1 << 3)     // isdigit()
+#define lx$cc_num_end (1 << 4)   // number token terminators
+#define lx$cc_scope (1 << 5)     // chars of interest inside folded scopes
+
+// clang-format off
+#define S lx$cc_space
+#define I (lx$cc_ident | lx$cc_ident_1st)
+#define D (lx$cc_ident | lx$cc_digit)
+#define N lx$cc_num_end
+#define B lx$cc_scope
+static const u8 _CexParser__char_class[256] = {
+    /*        0  1  2  3  4  5  6  7  8  9  a      b  c      d      e  f */
+    /* 00 */  B, 0, 0, 0, 0, 0, 0, 0, 0, S|N, S|N, S, S, S|N, 0, 0,
+    /* 10 */  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    /*        sp   !  "  #  $  %  &  '  (  )    *  +  ,  -  .  /   */
+    /* 20 */  S|N, 0, B, B, I, 0, 0, B, B, B|N, N, N, N, N, 0, B|N,
+    /*        0  1  2  3  4  5  6  7  8  9  :  ;  <  =  >  ?  */
+    /* 30 */  D, D, D, D, D, D, D, D, D, D, 0, 0, 0, 0, 0, 0,
+    /* 40 */  0, I, I, I, I, I, I, I, I, I, I, I, I, I, I, I,
+    /*        P  Q  R  S  T  U  V  W  X  Y  Z  [  \  ]    ^  _  */
+    /* 50 */  I, I, I, I, I, I, I, I, I, I, I, B, 0, B|N, 0, I,
+    /* 60 */  0, I, I, I, I, I, I, I, I, I, I, I, I, I, I, I,
+    /*        p  q  r  s  t  u  v  w  x  y  z  {  |  }    ~  DEL */
+    /* 70 */  I, I, I, I, I, I, I, I, I, I, I, B, 0, B|N, 0, 0,
+};
+#undef S
+#undef I
+#undef D
+#undef N
+#undef B
+// clang-format on
+
+#define lx$is(c, cc) (_CexParser__char_class[(u8)(c)] & (cc))
+
+/// Moves cursor to `new_cur`, updating line/col as lx$next() does for every skipped char
+static inline void
+_CexParser__advance(CexParser_c* lx, char* new_cur)
+{
+    char* last_nl = NULL;
+    char* p = lx->cur;
+    while (p < new_cur && (p = memchr(p, '\n', new_cur - p)) != NULL) {
+        lx->line++;
+        last_nl = p++;
+    }
+    if (last_nl) {
+        lx->col = new_cur - last_nl;
+    } else {
+        lx->col += new_cur - lx->cur;
     }
+    lx->cur = new_cur;
+}
+
+/// Skips whitespace, 8 spaces at once for indentation runs, returns next char or '\0'
+static inline char
+_CexParser__skip_space(CexParser_c* lx)
+{
+    char* p = lx->cur;
+    char* end = lx->content_end;
+    while (p < end && lx$is(*p, lx$cc_space)) {
+        u64 w;
+        if (end - p >= 8 && (memcpy(&w, p, sizeof(w)), w == 0x2020202020202020ULL)) {
+            p += 8;
+        } else {
+            p++;
+        }
+    }
+    if (p != lx->cur) { _CexParser__advance(lx, p); }
+    return lx$peek(lx);
+}
 
 CexParser_c
 CexParser_create(char* content, u32 content_len, bool fold_scopes)
@@ -59,17 +121,36 @@ CexParser_reset(CexParser_c* lx)
     lx->line = 0;
 }
 
+/// Moves lexer cursor to `offset` (must be a position between tokens), recalculates line/col
+void
+CexParser_resync(CexParser_c* lx, u32 offset)
+{
+    uassert(lx != NULL);
+    uassert(lx->content + offset <= lx->content_end && "offset out of bounds");
+    char* new_cur = lx->content + offset;
+    if (new_cur < lx->cur) {
+        lx->cur = lx->content;
+        lx->line = 0;
+        lx->col = 0;
+    }
+    _CexParser__advance(lx, new_cur);
+}
+
 static cex_token_s
 _CexParser__scan_ident(CexParser_c* lx)
 {
     cex_token_s t = { .type = CexTkn__ident, .value = { .buf = lx->cur, .len = 0 } };
-    char c;
-    while ((c = lx$next(lx))) {
-        if (!(isalnum(c) || c == '_' || c == '$')) {
-            lx$rewind(lx);
-            break;
-        }
-        t.value.len++;
+    char* p = lx->cur;
+    char* end = lx->content_end;
+    // ident never contains new lines
+    while (p < end && lx$is(*p, lx$cc_ident)) { p++; }
+    t.value.len = p - lx->cur;
+    lx->col += t.value.len;
+    lx->cur = p;
+    if (p < end && *p == '\0') {
+        // lx$next() compatibility: '\0' stops the scan, but consumed
+        lx->cur++;
+        lx->col++;
     }
     return t;
 }
@@ -78,97 +159,109 @@ static cex_token_s
 _CexParser__scan_number(CexParser_c* lx)
 {
     cex_token_s t = { .type = CexTkn__number, .value = { .buf = lx->cur, .len = 0 } };
-    char c;
-    while ((c = lx$next(lx))) {
-        switch (c) {
-            case ' ':
-            case '\t':
-            case '\n':
-            case '\r':
-            case '/':
-            case '*':
-            case '+':
-            case '-':
-            case ',':
-            case ')':
-            case ']':
-            case '}':
-                lx$rewind(lx);
-                return t;
-        }
-        t.value.len++;
+    char* p = lx->cur;
+    char* end = lx->content_end;
+    while (p < end && *p != '\0' && !lx$is(*p, lx$cc_num_end)) { p++; }
+    t.value.len = p - lx->cur;
+    lx->col += t.value.len;
+    lx->cur = p;
+    if (p < end && *p == '\0') {
+        // lx$next() compatibility: '\0' stops the scan, but consumed
+        lx->cur++;
+        lx->col++;
     }
     return t;
 }
 
+#define lx$has_less(w, n) /* TEMP MACRO: non zero if any byte < n (n <= 128) */                    \
+    (((w) - 0x0101010101010101ULL * (n)) & ~(w) & 0x8080808080808080ULL)
+#define lx$has_eq(w, c) /* TEMP MACRO: non zero if any byte == c */                                 \
+    lx$has_less((w) ^ (0x0101010101010101ULL * (u8)(c)), 1)
+
 static cex_token_s
 _CexParser__scan_string(CexParser_c* lx)
 {
-    cex_token_s t = { .type = (*lx->cur == '"' ? CexTkn__string : CexTkn__char),
+    char quote = *lx->cur;
+    cex_token_s t = { .type = (quote == '"' ? CexTkn__string : CexTkn__char),
                       .value = { .buf = lx->cur + 1, .len = 0 } };
-    lx$next(lx);
-    char c;
-    while ((c = lx$next(lx))) {
-        switch (c) {
-            case '\\': // escape char, unconditionally skip next
-                lx$next(lx);
-                t.value.len++;
-                break;
-            case '\'':
-                if (t.type == CexTkn__char) { goto end; }
-                break;
-            case '"':
-                if (t.type == CexTkn__string) { goto end; }
-                break;
-            default: {
-                if (unlikely((u8)c < 0x20)) {
-                    t.type = CexTkn__error;
-                    t.value = (str_s){ 0 };
-                    return t;
-                }
-            }
+    char* p = lx->cur + 1;
+    char* end = lx->content_end;
+    while (p < end) {
+        // skipping 8 bytes at once when no quote, escape or control chars (SWAR)
+        while (end - p >= 8) {
+            u64 w;
+            memcpy(&w, p, sizeof(w));
+            if (lx$has_less(w, 0x20) | lx$has_eq(w, quote) | lx$has_eq(w, '\\')) { break; }
+            p += 8;
+        }
+        if (p >= end) { break; }
+        char c = *p;
+        if (c == quote) {
+            t.value.len = p - t.value.buf;
+            _CexParser__advance(lx, p + 1);
+            return t;
+        } else if (c == '\\') {
+            // escape char, unconditionally skip next
+            p += 2;
+        } else if (c == '\0') {
+            // lx$next() compatibility: '\0' stops the scan, but consumed
+            t.value.len = p - t.value.buf;
+            _CexParser__advance(lx, p + 1);
+            return t;
+        } else if (unlikely((u8)c < 0x20)) {
+            _CexParser__advance(lx, p + 1);
+            return (cex_token_s){ .type = CexTkn__error };
+        } else {
+            p++;
         }
-        t.value.len++;
     }
-end:
+    // unterminated string or escape at EOF
+    t.value.len = p - t.value.buf;
+    _CexParser__advance(lx, end);
     if (unlikely(t.value.buf + t.value.len > lx->content_end)) {
         t = (cex_token_s){ .type = CexTkn__error };
     }
     return t;
 }
 
+#undef lx$has_less
+#undef lx$has_eq
+
 static cex_token_s
 _CexParser__scan_comment(CexParser_c* lx)
 {
     cex_token_s t = { .type = lx->cur[1] == '/' ? CexTkn__comment_single : CexTkn__comment_multi,
                       .value = { .buf = lx->cur, .len = 2 } };
-    lx$next(lx);
-    lx$next(lx);
-    char c;
-    while ((c = lx$next(lx))) {
-        switch (c) {
-            case '\n':
-                if (t.type == CexTkn__comment_single) {
-                    lx$rewind(lx);
-                    goto end;
-                }
+    char* p = lx->cur + 2;
+    char* end = lx->content_end;
+    if (p > end) { p = end; }
+
+    if (t.type == CexTkn__comment_single) {
+        char* nl = memchr(p, '\n', end - p);
+        p = (nl) ? nl : end;
+    } else {
+        while (p < end) {
+            char* star = memchr(p, '*', end - p);
+            if (star == NULL) {
+                p = end;
                 break;
-            case '*':
-                if (t.type == CexTkn__comment_multi) {
-                    if (lx$peek(lx) == '/') {
-                        lx$next(lx);
-                        t.value.len += 2;
-                        goto end;
-                    }
-                }
+            }
+            p = star + 1;
+            if (p < end && *p == '/') {
+                p++;
                 break;
+            }
         }
-        t.value.len++;
     }
-end:
-    if (unlikely(t.value.buf + t.value.len > lx->content_end)) {
-        t = (cex_token_s){ .type = CexTkn__error };
+    char* zero = memchr(t.value.buf, '\0', p - t.value.buf);
+    if (unlikely(zero != NULL)) {
+        // lx$next() compatibility: '\0' stops the scan, but consumed
+        p = zero + 1;
+        t.value.len = zero - t.value.buf;
+    } else {
+        t.value.len = p - t.value.buf;
     }
+    _CexParser__advance(lx, p);
     return t;
 }
 
@@ -179,27 +272,40 @@ _CexParser__scan_preproc(CexParser_c* lx)
 
     if (lx->cur >= lx->content_end) { return (cex_token_s){ .type = CexTkn__error }; }
 
-    char c = *lx->cur;
-    lx$skip_space(lx, c);
+    _CexParser__skip_space(lx);
     cex_token_s t = { .type = CexTkn__preproc, .value = { .buf = lx->cur, .len = 0 } };
 
-    while ((c = lx$next(lx))) {
-        switch (c) {
-            case '\n':
-                goto end;
-            case '\\':
-                // next line concat for #define
-                t.value.len++;
-                if (!lx$next(lx)) {
-                    // Oops, we expected next symbol here, but got EOF, invalidate token then
-                    t.value.len++;
-                    goto end;
-                }
-                break;
+    char* p = lx->cur;
+    char* end = lx->content_end;
+    t.value.len = end - t.value.buf;
+    while (p < end) {
+        char* nl = memchr(p, '\n', end - p);
+        if (nl == NULL) {
+            // no new line until EOF, escape char at EOF invalidates the token
+            u32 n_escapes = 0;
+            for (char* e = end - 1; e >= p && *e == '\\'; e--) { n_escapes++; }
+            t.value.len = end - t.value.buf + (n_escapes % 2);
+            p = end;
+            break;
+        }
+        // next line concat for #define, if odd number of escapes before new line
+        u32 n_escapes = 0;
+        for (char* e = nl - 1; e >= p && *e == '\\'; e--) { n_escapes++; }
+        p = nl + 1;
+        if (n_escapes % 2 == 0) {
+            t.value.len = nl - t.value.buf;
+            break;
         }
-        t.value.len++;
     }
-end:
+    char* zero = memchr(t.value.buf, '\0', p - t.value.buf);
+    if (unlikely(zero != NULL && zero < t.value.buf + t.value.len)) {
+        // lx$next() compatibility: '\0' stops the scan, but consumed
+        u32 n_escapes = 0;
+        for (char* e = zero - 1; e >= t.value.buf && *e == '\\'; e--) { n_escapes++; }
+        t.value.len = zero - t.value.buf + (n_escapes % 2);
+        p = zero + 1;
+    }
+    _CexParser__advance(lx, p);
     if (unlikely(t.value.buf + t.value.len > lx->content_end)) {
         t = (cex_token_s){ .type = CexTkn__error };
     }
@@ -260,6 +366,14 @@ _CexParser__scan_scope(CexParser_c* lx)
         }
 
         while ((c = lx$peek(lx))) {
+            if (scope_depth > 0 && !lx$is(c, lx$cc_scope)) {
+                // bulk skip of the scope contents until next bracket/string/comment/preproc
+                char* p = lx->cur + 1;
+                while (p < lx->content_end && !lx$is(*p, lx$cc_scope)) { p++; }
+                t.value.len += p - lx->cur;
+                _CexParser__advance(lx, p);
+                continue;
+            }
             switch (c) {
                 case '{':
                     scope$push(c);
@@ -332,11 +446,11 @@ CexParser_next_token(CexParser_c* lx)
 
     char c;
     while ((c = lx$peek(lx))) {
-        lx$skip_space(lx, c);
+        if (lx$is(c, lx$cc_space)) { c = _CexParser__skip_space(lx); }
         if (!c) { break; }
 
-        if (isalpha(c) || c == '_' || c == '$') { return _CexParser__scan_ident(lx); }
-        if (isdigit(c)) { return _CexParser__scan_number(lx); }
+        if (lx$is(c, lx$cc_ident_1st)) { return _CexParser__scan_ident(lx); }
+        if (lx$is(c, lx$cc_digit)) { return _CexParser__scan_number(lx); }
 
         switch (c) {
             case '\'':
@@ -416,6 +530,250 @@ CexParser_next_token(CexParser_c* lx)
     return (cex_token_s){ 0 }; // EOF
 }
 
+static inline i32
+_CexParser__scope_delta(CexTkn_e type)
+{
+    switch (type) {
+        case CexTkn__lparen:
+        case CexTkn__lbracket:
+        case CexTkn__lbrace:
+            return 1;
+        case CexTkn__rparen:
+        case CexTkn__rbracket:
+        case CexTkn__rbrace:
+            return -1;
+        default:
+            return 0;
+    }
+}
+
+/// Tokenizes whole lx content into `tokens`, and adds a checkpoint every `checkpoint_every` tokens
+/// and at the end of content (used by CexParser.retokenize()). On lexing error `tokens` contains
+/// tokens before error.
+Exception
+CexParser_tokenize(
+    CexParser_c* lx,
+    u32 checkpoint_every,
+    arr$(cex_token_s) * tokens,
+    arr$(cex_token_checkpoint_s) * checkpoints
+)
+{
+    uassert(lx != NULL);
+    uassert(tokens != NULL && *tokens != NULL && "non initialized arr$");
+    uassert(checkpoints != NULL && *checkpoints != NULL && "non initialized arr$");
+    uassert(checkpoint_every > 0);
+
+    CexParser_reset(lx);
+    lx->col = 0;
+    arr$clear(*tokens);
+    arr$clear(*checkpoints);
+
+    i32 depth = 0;
+    cex_token_s t;
+    while (true) {
+        u32 idx = arr$len(*tokens);
+        if (idx % checkpoint_every == 0) {
+            arr$push(
+                *checkpoints,
+                (cex_token_checkpoint_s){
+                    .offset = lx->cur - lx->content,
+                    .line = lx->line,
+                    .token_idx = idx,
+                    .scope_depth = depth,
+                }
+            );
+        }
+        if (!(t = CexParser_next_token(lx)).type) { break; }
+        if (t.type == CexTkn__error) {
+            return e$raise(Error.integrity, "Lexing error at line: %d", lx->line);
+        }
+        depth += _CexParser__scope_delta(t.type);
+        arr$push(*tokens, t);
+    }
+    // Final checkpoint at the end of content (may duplicate last one if idx % every == 0)
+    cex_token_checkpoint_s* last = &(*checkpoints)[arr$len(*checkpoints) - 1];
+    if (last->offset != lx->cur - lx->content) {
+        arr$push(
+            *checkpoints,
+            (cex_token_checkpoint_s){
+                .offset = lx->cur - lx->content,
+                .line = lx->line,
+                .token_idx = arr$len(*tokens),
+                .scope_depth = depth,
+            }
+        );
+    }
+    return EOK;
+}
+
+/// Replaces elements [k, j) of arr by `region` elements (region_len), arr len is old_n
+static void
+_CexParser__splice(void* arr, usize elsize, usize k, usize j, usize old_n, void* region, usize region_len)
+{
+    char* a = arr;
+    memmove(a + (k + region_len) * elsize, a + j * elsize, (old_n - j) * elsize);
+    if (region_len) { memcpy(a + k * elsize, region, region_len * elsize); }
+}
+
+/// Re-tokenizes lx content after the edit of the old content, tokens/checkpoints must be created by
+/// CexParser.tokenize() for old_content. The edit replaced `removed_len` bytes at `edit_offset` by
+/// `inserted_len` bytes, lx must be created for the new content (can be the same buffer). Only the
+/// damaged region is re-lexed, unchanged tail tokens are reused (rebased to new content).
+Exception
+CexParser_retokenize(
+    CexParser_c* lx,
+    char* old_content,
+    u32 edit_offset,
+    u32 removed_len,
+    u32 inserted_len,
+    u32 checkpoint_every,
+    arr$(cex_token_s) * tokens,
+    arr$(cex_token_checkpoint_s) * checkpoints
+)
+{
+    uassert(lx != NULL);
+    uassert(tokens != NULL && *tokens != NULL && "non initialized arr$");
+    uassert(checkpoints != NULL && *checkpoints != NULL && "non initialized arr$");
+    uassert(checkpoint_every > 0);
+    uassert(lx->content + edit_offset + inserted_len <= lx->content_end && "edit out of bounds");
+
+    usize n_cp = arr$len(*checkpoints);
+    if (n_cp == 0 || (*checkpoints)[0].offset != 0) {
+        return CexParser_tokenize(lx, checkpoint_every, tokens, checkpoints);
+    }
+
+    // Resume from the last checkpoint before edit (its previous token lookahead is intact)
+    usize ci = 0;
+    while (ci + 1 < n_cp && (*checkpoints)[ci + 1].offset < edit_offset) { ci++; }
+    cex_token_checkpoint_s cp = (*checkpoints)[ci];
+    usize k = cp.token_idx;
+    usize old_n = arr$len(*tokens);
+    uassert(k <= old_n);
+
+    isize delta = (isize)inserted_len - (isize)removed_len;
+    usize edit_end = edit_offset + inserted_len; // in new content
+    usize old_edit_end = edit_offset + removed_len;
+    // previous tokenization failed, tail is missing and has to be lexed completely
+    bool has_tail = (isize)(*checkpoints)[n_cp - 1].offset + delta ==
+                    (isize)(lx->content_end - lx->content);
+
+    lx->cur = lx->content + cp.offset;
+    lx->line = cp.line;
+    lx->col = 0;
+
+    Exc result = EOK;
+    arr$(cex_token_s) region = arr$new(region, mem$, .capacity = checkpoint_every * 2);
+    arr$(cex_token_checkpoint_s) region_cp = arr$new(region_cp, mem$);
+    usize sync_cj = 0; // old checkpoint where new lexer state matches old one
+    i32 depth = cp.scope_depth;
+    usize cj = ci + 1;
+    cex_token_s t;
+    while (true) {
+        usize n = lx->cur - lx->content;
+        if (has_tail && n > edit_end) {
+            // old checkpoints after edit, shifted to new content positions
+            while (cj < n_cp && ((*checkpoints)[cj].offset < old_edit_end ||
+                                 (isize)(*checkpoints)[cj].offset + delta < (isize)n)) {
+                cj++;
+            }
+            if (cj < n_cp && (isize)(*checkpoints)[cj].offset + delta == (isize)n) {
+                sync_cj = cj;
+                break;
+            }
+        }
+        usize idx = arr$len(region);
+        if (idx > 0 && idx % checkpoint_every == 0) {
+            arr$push(
+                region_cp,
+                (cex_token_checkpoint_s){
+                    .offset = n,
+                    .line = lx->line,
+                    .token_idx = k + idx,
+                    .scope_depth = depth,
+                }
+            );
+        }
+        if (!(t = CexParser_next_token(lx)).type) { break; }
+        if (t.type == CexTkn__error) {
+            result = e$raise(Error.integrity, "Lexing error at line: %d", lx->line);
+            break;
+        }
+        depth += _CexParser__scope_delta(t.type);
+        arr$push(region, t);
+    }
+
+    usize m = arr$len(region);
+    usize j = (sync_cj) ? (*checkpoints)[sync_cj].token_idx : old_n;
+    usize new_n = k + m + (old_n - j);
+
+    // Tokens: head + region + old tail rebased to the new content
+    if (new_n > old_n && !arr$grow_check(*tokens, new_n - old_n)) { return Error.memory; }
+    _CexParser__splice(*tokens, sizeof(cex_token_s), k, j, old_n, region, m);
+    // extend length up to new_n (items are already in place)
+    for (usize i = old_n; i < new_n; i++) { arr$push(*tokens, (*tokens)[i]); }
+    while (arr$len(*tokens) > new_n) { (void)arr$pop(*tokens); }
+    if (lx->content != old_content) {
+        for (usize i = 0; i < k; i++) {
+            cex_token_s* it = &(*tokens)[i];
+            it->value.buf = lx->content + (it->value.buf - old_content);
+        }
+    }
+    if (sync_cj && (lx->content != old_content || delta != 0)) {
+        for (usize i = k + m; i < new_n; i++) {
+            cex_token_s* it = &(*tokens)[i];
+            it->value.buf = lx->content + ((it->value.buf - old_content) + delta);
+        }
+    }
+
+    // Checkpoints: head (incl. resume point) + region + old tail adjusted
+    usize tail_cp = (sync_cj) ? n_cp - sync_cj : 0;
+    usize new_cp = ci + 1 + arr$len(region_cp) + tail_cp;
+    cex_token_checkpoint_s sync_cp = (sync_cj) ? (*checkpoints)[sync_cj]
+                                               : (cex_token_checkpoint_s){ 0 };
+    if (new_cp > n_cp && !arr$grow_check(*checkpoints, new_cp - n_cp)) { return Error.memory; }
+    _CexParser__splice(
+        *checkpoints,
+        sizeof(cex_token_checkpoint_s),
+        ci + 1,
+        (sync_cj) ? sync_cj : n_cp,
+        n_cp,
+        region_cp,
+        arr$len(region_cp)
+    );
+    for (usize i = n_cp; i < new_cp; i++) { arr$push(*checkpoints, (*checkpoints)[i]); }
+    while (arr$len(*checkpoints) > new_cp) { (void)arr$pop(*checkpoints); }
+
+    if (sync_cj) {
+        i64 line_delta = (i64)lx->line - (i64)sync_cp.line;
+        i32 depth_delta = depth - sync_cp.scope_depth;
+        for (usize i = new_cp - tail_cp; i < new_cp; i++) {
+            cex_token_checkpoint_s* it = &(*checkpoints)[i];
+            it->offset += delta;
+            it->line += line_delta;
+            it->token_idx = it->token_idx - j + k + m;
+            it->scope_depth += depth_delta;
+        }
+        // lexer at the end of content, as after full tokenization
+        cex_token_checkpoint_s* last = &(*checkpoints)[new_cp - 1];
+        lx->cur = lx->content + last->offset;
+        lx->line = last->line;
+    } else if (result == EOK) {
+        arr$push(
+            *checkpoints,
+            (cex_token_checkpoint_s){
+                .offset = lx->cur - lx->content,
+                .line = lx->line,
+                .token_idx = new_n,
+                .scope_depth = depth,
+            }
+        );
+    }
+
+    arr$free(region);
+    arr$free(region_cp);
+    return result;
+}
+
 cex_token_s
 CexParser_next_entity(CexParser_c* lx, arr$(cex_token_s) * children)
 {
@@ -878,7 +1236,14 @@ fail:
 
 #undef lx$next
 #undef lx$peek
-#undef lx$skip_space
+#undef lx$peek_next
+#undef lx$is
+#undef lx$cc_space
+#undef lx$cc_ident
+#undef lx$cc_ident_1st
+#undef lx$cc_digit
+#undef lx$cc_num_end
+#undef lx$cc_scope
 
 const struct __cex_namespace__CexParser CexParser = {
     // Autogenerated by CEX
@@ -890,8 +1255,10 @@ const struct __cex_namespace__CexParser CexParser = {
     .next_entity = CexParser_next_entity,
     .next_token = CexParser_next_token,
     .reset = CexParser_reset,
+    .resync = CexParser_resync,
+    .retokenize = CexParser_retokenize,
+    .tokenize = CexParser_tokenize,
 
     // clang-format on
 };
-
 #endif
@@ -62,6 +62,15 @@ typedef struct cex_token_s
     str_s value;
 } cex_token_s;
 
+/// Lexer state between tokens, allows resuming tokenization without re-lexing the head
+typedef struct cex_token_checkpoint_s
+{
+    u32 offset;      // cursor offset in the content (position before token)
+    u32 line;        // cursor line at offset
+    u32 token_idx;   // index of the next token in the token list
+    i32 scope_depth; // balance of ( [ { minus ) ] } tokens before offset (non folded scopes)
+} cex_token_checkpoint_s;
+
 typedef struct CexParser_c
 {
     char* content;     // full content
@@ -99,6 +108,17 @@ struct __cex_namespace__CexParser {
     cex_token_s     (*next_entity)(CexParser_c* lx, arr$(cex_token_s)* children);
     cex_token_s     (*next_token)(CexParser_c* lx);
     void            (*reset)(CexParser_c* lx);
+    /// Moves lexer cursor to `offset` (must be a position between tokens), recalculates line/col
+    void            (*resync)(CexParser_c* lx, u32 offset);
+    /// Re-tokenizes lx content after the edit of the old content, tokens/checkpoints must be created by
+    /// CexParser.tokenize() for old_content. The edit replaced `removed_len` bytes at `edit_offset` by
+    /// `inserted_len` bytes, lx must be created for the new content (can be the same buffer). Only the
+    /// damaged region is re-lexed, unchanged tail tokens are reused (rebased to new content).
+    Exception       (*retokenize)(CexParser_c* lx, char* old_content, u32 edit_offset, u32 removed_len, u32 inserted_len, u32 checkpoint_every, arr$(cex_token_s)* tokens, arr$(cex_token_checkpoint_s)* checkpoints);
+    /// Tokenizes whole lx content into `tokens`, and adds a checkpoint every `checkpoint_every` tokens
+    /// and at the end of content (used by CexParser.retokenize()). On lexing error `tokens` contains
+    /// tokens before error.
+    Exception       (*tokenize)(CexParser_c* lx, u32 checkpoint_every, arr$(cex_token_s)* tokens, arr$(cex_token_checkpoint_s)* checkpoints);
 
     // clang-format on
 };
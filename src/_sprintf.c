@@ -89,6 +89,168 @@ cexsp__format_s_check_va_item_string_len(char const* s, u32 limit)
     return (u32)(sn - s);
 }
 
+typedef struct cexsp__spec
+{
+    i32 fw;
+    i32 pr;
+    u32 fl;
+    u32 star; // 1 - width is `*`, 2 - precision is `*`
+} cexsp__spec;
+
+static inline char const*
+cexsp__scan_spec(char const* f, cexsp__spec* spec)
+{
+    i32 fw = 0;
+    i32 pr = -1;
+    u32 fl = 0;
+    u32 star = 0;
+
+    // flags
+    for (;;) {
+        switch (f[0]) {
+            // if we have left justify
+            case '-':
+                fl |= CEXSP__LEFTJUST;
+                ++f;
+                continue;
+            // if we have leading plus
+            case '+':
+                fl |= CEXSP__LEADINGPLUS;
+                ++f;
+                continue;
+            // if we have leading space
+            case ' ':
+                fl |= CEXSP__LEADINGSPACE;
+                ++f;
+                continue;
+            // if we have leading 0x
+            case '#':
+                fl |= CEXSP__LEADING_0X;
+                ++f;
+                continue;
+            // if we have thousand commas
+            case '\'':
+                fl |= CEXSP__TRIPLET_COMMA;
+                ++f;
+                continue;
+            // if we have kilo marker (none->kilo->kibi->jedec)
+            case '$':
+                if (fl & CEXSP__METRIC_SUFFIX) {
+                    if (fl & CEXSP__METRIC_1024) {
+                        fl |= CEXSP__METRIC_JEDEC;
+                    } else {
+                        fl |= CEXSP__METRIC_1024;
+                    }
+                } else {
+                    fl |= CEXSP__METRIC_SUFFIX;
+                }
+                ++f;
+                continue;
+            // if we don't want space between metric suffix and number
+            case '_':
+                fl |= CEXSP__METRIC_NOSPACE;
+                ++f;
+                continue;
+            // if we have leading zero
+            case '0':
+                fl |= CEXSP__LEADINGZERO;
+                ++f;
+                goto flags_done;
+            default:
+                goto flags_done;
+        }
+    }
+flags_done:
+
+    // get the field width
+    if (f[0] == '*') {
+        star |= 1;
+        ++f;
+    } else {
+        while ((f[0] >= '0') && (f[0] <= '9')) {
+            fw = fw * 10 + f[0] - '0';
+            f++;
+        }
+    }
+    // get the precision
+    if (f[0] == '.') {
+        ++f;
+        if (f[0] == '*') {
+            star |= 2;
+            ++f;
+        } else {
+            pr = 0;
+            while ((f[0] >= '0') && (f[0] <= '9')) {
+                pr = pr * 10 + f[0] - '0';
+                f++;
+            }
+        }
+    }
+
+    // handle integer size overrides
+    switch (f[0]) {
+        // are we halfwidth?
+        case 'h':
+            fl |= CEXSP__HALFWIDTH;
+            ++f;
+            if (f[0] == 'h') {
+                ++f; // QUARTERWIDTH
+            }
+            break;
+        // are we 64-bit (unix style)
+        case 'l':
+            // %ld/%lld - is always 64 bits
+            fl |= CEXSP__INTMAX;
+            ++f;
+            if (f[0] == 'l') { ++f; }
+            break;
+        // are we 64-bit on intmax? (c99)
+        case 'j':
+            fl |= (sizeof(intmax_t) == 8) ? CEXSP__INTMAX : 0;
+            ++f;
+            break;
+        // are we 64-bit on size_t or ptrdiff_t? (c99)
+        case 'z':
+            fl |= (sizeof(ptrdiff_t) == 8) ? CEXSP__INTMAX : 0;
+            ++f;
+            break;
+        case 't':
+            fl |= (sizeof(ptrdiff_t) == 8) ? CEXSP__INTMAX : 0;
+            ++f;
+            break;
+        // are we 64-bit (msft style)
+        case 'I':
+            if ((f[1] == '6') && (f[2] == '4')) {
+                fl |= CEXSP__INTMAX;
+                f += 3;
+            } else if ((f[1] == '3') && (f[2] == '2')) {
+                f += 3;
+            } else {
+                fl |= ((sizeof(void*) == 8) ? CEXSP__INTMAX : 0);
+                ++f;
+            }
+            break;
+        default:
+            break;
+    }
+
+    spec->fw = fw;
+    spec->pr = pr;
+    spec->fl = fl;
+    spec->star = star;
+    return f;
+}
+
+#define CEXSP__FMT_MAGIC "\x1f" "cexfmt"
+
+static inline bool
+cexsp__is_fmt_compiled(char const* fmt)
+{
+    // NOTE: short-circuit comparison never reads beyond the terminating zero of regular strings
+    return fmt[0] == '\x1f' && fmt[1] == 'c' && fmt[2] == 'e' && fmt[3] == 'x' && fmt[4] == 'f' &&
+           fmt[5] == 'm' && fmt[6] == 't' && fmt[7] == '\0';
+}
+
 CEXSP__PUBLICDEF int
 cexsp__vsprintfcb(cexsp_callback_f* callback, void* user, char* buf, char const* fmt, va_list va)
 {
@@ -97,6 +259,15 @@ cexsp__vsprintfcb(cexsp_callback_f* callback, void* user, char* buf, char const*
     char* bf = buf;
     char const* f;
     int tlen = 0;
+    cexsp__spec spec;
+    const cexsp__fmt* cfmt = NULL;
+    u32 op_idx = 0;
+
+    if (unlikely(cexsp__is_fmt_compiled(fmt))) {
+        // fmt$() pre-parsed format, literal runs and conversion specs are ready to use
+        cfmt = (const cexsp__fmt*)fmt;
+        fmt = cfmt->format;
+    }
 
     f = fmt;
     for (;;) {
@@ -127,6 +298,29 @@ cexsp__vsprintfcb(cexsp_callback_f* callback, void* user, char* buf, char const*
         if (cl > lg) cl = lg;                                                                      \
     }
 
+        if (cfmt) {
+            if (op_idx >= cfmt->n_ops) { goto endfmt; }
+            const cexsp__fmt_op* op = &cfmt->ops[op_idx++];
+            char const* lit = fmt + op->lit_off;
+            i32 n = op->lit_len;
+            while (n) {
+                i32 i;
+                cexsp__cb_buf_clamp(i, n);
+                memcpy(bf, lit, i);
+                bf += i;
+                lit += i;
+                n -= i;
+                cexsp__chk_cb_buf(1);
+            }
+            if (op->conv_off == UINT16_MAX) { goto endfmt; }
+            f = fmt + op->conv_off;
+            spec.fw = op->fw;
+            spec.pr = op->pr;
+            spec.fl = op->flags;
+            spec.star = op->star;
+            goto spec_ready;
+        }
+
         // fast copy everything up to the next % (or end of string)
         for (;;) {
             if (f[0] == '%') { goto scandd; }
@@ -137,142 +331,16 @@ cexsp__vsprintfcb(cexsp_callback_f* callback, void* user, char* buf, char const*
         }
     scandd:
 
-        ++f;
-
         // ok, we have a percent, read the modifiers first
-        fw = 0;
-        pr = -1;
-        fl = 0;
-        tz = 0;
-
-        // flags
-        for (;;) {
-            switch (f[0]) {
-                // if we have left justify
-                case '-':
-                    fl |= CEXSP__LEFTJUST;
-                    ++f;
-                    continue;
-                // if we have leading plus
-                case '+':
-                    fl |= CEXSP__LEADINGPLUS;
-                    ++f;
-                    continue;
-                // if we have leading space
-                case ' ':
-                    fl |= CEXSP__LEADINGSPACE;
-                    ++f;
-                    continue;
-                // if we have leading 0x
-                case '#':
-                    fl |= CEXSP__LEADING_0X;
-                    ++f;
-                    continue;
-                // if we have thousand commas
-                case '\'':
-                    fl |= CEXSP__TRIPLET_COMMA;
-                    ++f;
-                    continue;
-                // if we have kilo marker (none->kilo->kibi->jedec)
-                case '$':
-                    if (fl & CEXSP__METRIC_SUFFIX) {
-                        if (fl & CEXSP__METRIC_1024) {
-                            fl |= CEXSP__METRIC_JEDEC;
-                        } else {
-                            fl |= CEXSP__METRIC_1024;
-                        }
-                    } else {
-                        fl |= CEXSP__METRIC_SUFFIX;
-                    }
-                    ++f;
-                    continue;
-                // if we don't want space between metric suffix and number
-                case '_':
-                    fl |= CEXSP__METRIC_NOSPACE;
-                    ++f;
-                    continue;
-                // if we have leading zero
-                case '0':
-                    fl |= CEXSP__LEADINGZERO;
-                    ++f;
-                    goto flags_done;
-                default:
-                    goto flags_done;
-            }
-        }
-    flags_done:
-
-        // get the field width
-        if (f[0] == '*') {
-            fw = va_arg(va, u32);
-            ++f;
-        } else {
-            while ((f[0] >= '0') && (f[0] <= '9')) {
-                fw = fw * 10 + f[0] - '0';
-                f++;
-            }
-        }
-        // get the precision
-        if (f[0] == '.') {
-            ++f;
-            if (f[0] == '*') {
-                pr = va_arg(va, u32);
-                ++f;
-            } else {
-                pr = 0;
-                while ((f[0] >= '0') && (f[0] <= '9')) {
-                    pr = pr * 10 + f[0] - '0';
-                    f++;
-                }
-            }
-        }
+        f = cexsp__scan_spec(f + 1, &spec);
 
-        // handle integer size overrides
-        switch (f[0]) {
-            // are we halfwidth?
-            case 'h':
-                fl |= CEXSP__HALFWIDTH;
-                ++f;
-                if (f[0] == 'h') {
-                    ++f; // QUARTERWIDTH
-                }
-                break;
-            // are we 64-bit (unix style)
-            case 'l':
-                // %ld/%lld - is always 64 bits
-                fl |= CEXSP__INTMAX;
-                ++f;
-                if (f[0] == 'l') { ++f; }
-                break;
-            // are we 64-bit on intmax? (c99)
-            case 'j':
-                fl |= (sizeof(intmax_t) == 8) ? CEXSP__INTMAX : 0;
-                ++f;
-                break;
-            // are we 64-bit on size_t or ptrdiff_t? (c99)
-            case 'z':
-                fl |= (sizeof(ptrdiff_t) == 8) ? CEXSP__INTMAX : 0;
-                ++f;
-                break;
-            case 't':
-                fl |= (sizeof(ptrdiff_t) == 8) ? CEXSP__INTMAX : 0;
-                ++f;
-                break;
-            // are we 64-bit (msft style)
-            case 'I':
-                if ((f[1] == '6') && (f[2] == '4')) {
-                    fl |= CEXSP__INTMAX;
-                    f += 3;
-                } else if ((f[1] == '3') && (f[2] == '2')) {
-                    f += 3;
-                } else {
-                    fl |= ((sizeof(void*) == 8) ? CEXSP__INTMAX : 0);
-                    ++f;
-                }
-                break;
-            default:
-                break;
-        }
+    spec_ready:
+        fw = spec.fw;
+        pr = spec.pr;
+        fl = spec.fl;
+        tz = 0;
+        if (spec.star & 1) { fw = va_arg(va, u32); }
+        if (spec.star & 2) { pr = va_arg(va, u32); }
 
         // handle each replacement
         switch (f[0]) {
@@ -1193,6 +1261,73 @@ cexsp__fprintf(FILE* stream, const char* format, ...)
     return result;
 }
 
+CEXSP__PUBLICDEF char*
+cexsp__fmt_compile(cexsp__fmt* self, const char* format)
+{
+    u32 state = __atomic_load_n(&self->state, __ATOMIC_ACQUIRE);
+    if (likely(state == 2)) { return (char*)self; }
+    if (state == 3) { return (char*)format; }
+
+    u32 expected = 0;
+    if (!__atomic_compare_exchange_n(
+            &self->state,
+            &expected,
+            1,
+            false,
+            __ATOMIC_ACQ_REL,
+            __ATOMIC_ACQUIRE
+        )) {
+        // another thread is compiling this format right now, use the slow path this time
+        return (char*)format;
+    }
+
+    // NOTE: states 0 - new, 1 - compiling, 2 - ready, 3 - not supported (regular format fallback)
+    u32 result_state = 3;
+    u32 n_ops = 0;
+    char const* f = format;
+    char const* lit = format;
+    cexsp__spec spec;
+
+    if (format == NULL) { goto end; }
+
+    for (;;) {
+        while (f[0] != '%' && f[0] != '\0') { f++; }
+        if (n_ops >= arr$len(self->ops) || f - format >= UINT16_MAX - 1) { goto end; }
+
+        cexsp__fmt_op* op = &self->ops[n_ops++];
+        op->lit_off = (u16)(lit - format);
+        op->lit_len = (u16)(f - lit);
+        if (f[0] == '\0') {
+            op->conv_off = UINT16_MAX;
+            break;
+        }
+
+        f = cexsp__scan_spec(f + 1, &spec);
+        if (f[0] == '\0' || f - format >= UINT16_MAX - 1 || spec.fw > UINT16_MAX ||
+            spec.pr > INT16_MAX || spec.fl > UINT16_MAX) {
+            // trailing % or odd sizes, let the regular engine handle it
+            goto end;
+        }
+        op->conv_off = (u16)(f - format);
+        op->flags = (u16)spec.fl;
+        op->fw = (u16)spec.fw;
+        op->pr = (i16)spec.pr;
+        op->star = (u16)spec.star;
+
+        f++;
+        lit = f;
+    }
+
+    memcpy(self->magic, CEXSP__FMT_MAGIC, sizeof(self->magic));
+    self->format = format;
+    self->n_ops = n_ops;
+    result_state = 2;
+
+end:
+    __atomic_store_n(&self->state, result_state, __ATOMIC_RELEASE);
+    return (result_state == 2) ? (char*)self : (char*)format;
+}
+
 // =======================================================================
 //   low level float utility functions
 
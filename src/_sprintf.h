@@ -110,7 +110,53 @@ typedef struct cexsp__context
     char tmp[CEX_SPRINTF_MIN];
 } cexsp__context;
 
+#ifndef CEX_SPRINTF_OPS
+#    define CEX_SPRINTF_OPS 12 // max number of conversions in fmt$() pre-parsed format
+#endif
+
+typedef struct cexsp__fmt_op
+{
+    u16 lit_off;  // literal run offset in format
+    u16 lit_len;  // literal run length
+    u16 conv_off; // conversion char offset in format (UINT16_MAX - trailing literal only)
+    u16 flags;
+    u16 fw;
+    i16 pr;
+    u16 star; // 1 - width is `*`, 2 - precision is `*`
+} cexsp__fmt_op;
+
+typedef struct cexsp__fmt
+{
+    char magic[8]; // CEXSP__FMT_MAGIC, allows passing cexsp__fmt* as regular format string
+    const char* format;
+    u32 state;
+    u32 n_ops;
+    cexsp__fmt_op ops[CEX_SPRINTF_OPS];
+} cexsp__fmt;
+
+/**
+Pre-parses literal format string once per call site, and caches result in a static variable.
+The result can be passed as a format into any CEX formatting function (io.printf, str.fmt,
+sbuf.appendf, etc.), which skips format parsing and copies literal runs at once.
+
+Falls back to the regular format if it's too long or has more than CEX_SPRINTF_OPS conversions.
+
+NOTE: result is not a valid C-string, don't pass it to libc printf() or strlen()
+
+```c
+for (u32 i = 0; i < n; i++) {
+    e$ret(sbuf.appendf(&buf, fmt$("item: %05d, name: %S\n"), i, names[i]));
+}
+```
+*/
+#define fmt$(format)                                                                               \
+    ({                                                                                             \
+        static cexsp__fmt cex$tmpname(cexsp_fmt) = { 0 };                                          \
+        cexsp__fmt_compile(&cex$tmpname(cexsp_fmt), "" format "");                                 \
+    })
+
 // clang-format off
+CEXSP__PUBLICDEC char* cexsp__fmt_compile(cexsp__fmt* self, const char* format);
 CEXSP__PUBLICDEF int cexsp__vfprintf(FILE* stream, const char* format, va_list va);
 CEXSP__PUBLICDEF int cexsp__fprintf(FILE* stream, const char* format, ...);
 CEXSP__PUBLICDEC int cexsp__vsnprintf(char* buf, int count, char const* fmt, va_list va);
@@ -41,3 +41,29 @@ __cex__panic(void)
 }
 
 #endif
+
+#if defined(CEX_HAS_THREADS)
+/// Starts native thread running `thread_fn(arg)`, returns false on failure
+bool
+_cex_thread_spawn(_cex_thread_t* thread, _cex_thread_f thread_fn, void* arg)
+{
+#    ifdef _WIN32
+    *thread = CreateThread(NULL, 0, thread_fn, arg, 0, NULL);
+    return *thread != NULL;
+#    else
+    return pthread_create(thread, NULL, thread_fn, arg) == 0;
+#    endif
+}
+
+/// Waits for the thread started by _cex_thread_spawn() and releases it
+void
+_cex_thread_join(_cex_thread_t thread)
+{
+#    ifdef _WIN32
+    WaitForSingleObject(thread, INFINITE);
+    CloseHandle(thread);
+#    else
+    pthread_join(thread, NULL);
+#    endif
+}
+#endif
@@ -234,7 +234,7 @@ extern const struct _CEX_Error_struct
 #    define __cex__fprintf(stream, prefix, filename, line, func, format, ...)                      \
         cexsp__fprintf(                                                                            \
             stream,                                                                                \
-            "%s ( %s:%d %s() ) " format,                                                           \
+            fmt$("%s ( %s:%d %s() ) " format),                                                     \
             prefix,                                                                                \
             filename,                                                                              \
             line,                                                                                  \
@@ -647,3 +647,25 @@ int __cex_test_uassert_enabled = 1;
 // If __STDC_HOSTED__ is not defined, we're likely freestanding
 #    define cex$is_freestanding 1
 #endif
+
+#if !cex$is_freestanding && !defined(__EMSCRIPTEN__) &&                                            \
+    (defined(_WIN32) || !(defined(__GLIBC__) && __GLIBC__ == 2 && __GLIBC_MINOR__ < 34))
+// NOTE: glibc < 2.34 requires -lpthread, so bootstrap `cc cex.c` stays single threaded there
+/// Defined if CEX uses native threads (parallel os.fs.walk, io.async workers, cexy, json ndjson)
+#    define CEX_HAS_THREADS 1
+#    ifdef _WIN32
+#        include <windows.h>
+typedef HANDLE _cex_thread_t;
+typedef DWORD(WINAPI* _cex_thread_f)(LPVOID arg);
+/// Thread function definition, must `return 0;`
+#        define _cex_thread_fn(fn_name, arg_name) DWORD WINAPI fn_name(LPVOID arg_name)
+#    else
+#        include <pthread.h>
+typedef pthread_t _cex_thread_t;
+typedef void* (*_cex_thread_f)(void* arg);
+/// Thread function definition, must `return 0;`
+#        define _cex_thread_fn(fn_name, arg_name) void* fn_name(void* arg_name)
+#    endif
+bool _cex_thread_spawn(_cex_thread_t* thread, _cex_thread_f thread_fn, void* arg);
+void _cex_thread_join(_cex_thread_t thread);
+#endif
@@ -80,10 +80,9 @@ _cex__codegen_print_case_exit(_cex__codegen_s** cgptr)
     uassert(*cgptr != NULL);
     _cex__codegen_s* cg = *cgptr;
 
+    _cex__codegen_print_line(cg, "break;\n");
     if (cg->indent >= 4) { cg->indent -= 4; }
     _cex__codegen_indent(cg);
-    _cex__codegen_print_line(cg, "break;\n", '}');
-    _cex__codegen_indent(cg);
     _cex__codegen_print(cg, false, "%c\n", '}');
 }
 
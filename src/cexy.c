@@ -117,6 +117,20 @@ cexy_build_self(int argc, char** argv, char* cex_source)
     }
 }
 
+// Include dependency graph, see implementation below
+static u64 _cexy__cache_hash(const void* data, usize len, u64 seed);
+static char* _cexy__cache_path(char* src_fn, char* kind, IAllocator alloc);
+static int _cexy__deps_check(char* deps_fn, u64 variant, os_fs_stat_s target_meta, IAllocator _);
+static bool _cexy__deps_scan(
+    char* deps_fn,
+    u64 variant,
+    char* src_path,
+    arr$(char*) incl_path,
+    bool with_file_dir,
+    os_fs_stat_s target_meta,
+    IAllocator _
+);
+
 static bool
 cexy_src_include_changed(char* target_path, char* src_path, arr$(char*) alt_include_path)
 {
@@ -151,25 +165,25 @@ cexy_src_include_changed(char* target_path, char* src_path, arr$(char*) alt_incl
         return false;
     }
 
-    if (src_meta.mtime > target_meta.mtime) {
-        // File itself changed
-        log$debug("Src changed: %s\n", src_path);
-        return true;
-    }
-
     if (!str.ends_with(src_path, ".c") && !str.ends_with(src_path, ".h")) {
         // We only parse includes for appropriate .c/.h files
+        if (src_meta.mtime > target_meta.mtime) {
+            log$debug("Src changed: %s\n", src_path);
+            return true;
+        }
         return false;
     }
 
     mem$scope(tmem$, _)
     {
         arr$(char*) incl_path = arr$new(incl_path, _);
+        bool with_file_dir = true;
         if (arr$len(alt_include_path) > 0) {
             for$each (p, alt_include_path) {
                 arr$push(incl_path, p);
                 if (!os.path.exists(p)) { log$warn("alt_include_path not exists: %s\n", p); }
             }
+            with_file_dir = false;
         } else {
             char* def_incl_path[] = { cexy$cc_include };
             for$each (p, def_incl_path) {
@@ -185,61 +199,26 @@ cexy_src_include_changed(char* target_path, char* src_path, arr$(char*) alt_incl
                 }
                 arr$push(incl_path, clean_path);
             }
-            // Adding relative to src_path directory as a search target
-            arr$push(incl_path, os.path.dirname(src_path, _));
         }
 
-        char* code = io.file.load(src_path, _);
-        if (code == NULL) {
-            (void)e$raise("IOError", "src is not a file: '%s'", src_path);
-            return false;
-        }
+        // Dependency graph is only valid for the same source and include search paths
+        u64 variant = _cexy__cache_hash(src_path, str.len(src_path), with_file_dir);
+        for$each (p, incl_path) { variant = _cexy__cache_hash(p, str.len(p), variant); }
 
-        (void)CexTkn_str;
-        CexParser_c lx = CexParser.create(code, 0, true);
-        cex_token_s t;
-        while ((t = CexParser.next_token(&lx)).type) {
-            if (t.type != CexTkn__preproc) { continue; }
-            if (str.slice.starts_with(t.value, str$s("include"))) {
-                str_s incf = str.slice.sub(t.value, strlen("include"), 0);
-                incf = str.slice.strip(incf);
-                if (incf.len <= 4) { // <.h>
-                    log$warn(
-                        "Bad include in: %s (item: %S at line: %d)\n",
-                        src_path,
-                        t.value,
-                        lx.line
-                    );
-                    continue;
-                }
-                log$trace("Processing include: '%S'\n", incf);
-                if (!str.slice.match(incf, "\"*.[hc]\"*")) {
-                    // system includes skipped
-                    log$trace("Skipping include: '%S'\n", incf);
-                    continue;
-                }
-                incf = str.slice.sub(incf, 1, 0);
-                incf = str.slice.sub(incf, 0, str.slice.index_of(incf, str$s("\"")) - 1);
-
-                mem$scope(tmem$, _)
-                {
-                    char extensions[] = { 'c', 'h' };
-                    for$each (ext, extensions) {
-                        char* inc_fn = str.fmt(_, "%S%c", incf, ext);
-                        uassert(inc_fn != NULL);
-                        for$each (inc_dir, incl_path) {
-                            char* try_path = os$path_join(_, inc_dir, inc_fn);
-                            uassert(try_path != NULL);
-                            auto src_meta = os.fs.stat(try_path);
-                            log$trace("Probing include: %s\n", try_path);
-                            if (src_meta.is_valid && src_meta.mtime > target_meta.mtime) {
-                                return true;
-                            }
-                        }
-                    }
-                }
-            }
-        }
+        char* deps_fn = _cexy__cache_path(target_path, "deps", _);
+        int deps_state = _cexy__deps_check(deps_fn, variant, target_meta, _);
+        if (deps_state >= 0) { return deps_state; }
+
+        // No valid dependency graph (first run or target rebuilt), full transitive scan
+        return _cexy__deps_scan(
+            deps_fn,
+            variant,
+            src_path,
+            incl_path,
+            with_file_dir,
+            target_meta,
+            _
+        );
     }
     return false;
 }
@@ -489,6 +468,50 @@ cexy__test__make_target_pattern(char** target)
     return EOK;
 }
 
+/// Extracts `-j` (all CPU cores), `-jN` or `--jobs=N` from argv[1..] (also removes it from argv).
+/// Parsing stops at `--` or at the `stop_positional`-th positional argument (0 - no limit), so
+/// the arguments passed to the target program are left intact.
+/// *out_n_jobs is 1 if option is not present, 0 means CPU count.
+static Exception
+_cexy__jobs_arg_extract(int* argc, char** argv, u32 stop_positional, u32* out_n_jobs)
+{
+    uassert(argc != NULL);
+    uassert(out_n_jobs != NULL);
+    *out_n_jobs = 1;
+
+    u32 n_positional = 0;
+    for (int i = 1; i < *argc; i++) {
+        char* a = argv[i];
+        char* n_str = NULL;
+        if (str.eq(a, "--")) {
+            break;
+        } else if (a[0] != '-') {
+            if (++n_positional == stop_positional) { break; }
+            continue;
+        } else if (str.eq(a, "-j") || str.eq(a, "--jobs")) {
+            n_str = "";
+        } else if (str.starts_with(a, "--jobs=")) {
+            n_str = a + strlen("--jobs=");
+        } else if (str.starts_with(a, "-j")) {
+            n_str = a + 2;
+        } else {
+            continue;
+        }
+
+        *out_n_jobs = 0;
+        if (n_str[0] != '\0') {
+            if (str.convert.to_u32(n_str, out_n_jobs) || *out_n_jobs == 0) {
+                return e$raise(Error.argsparse, "Invalid jobs option: '%s'", a);
+            }
+        }
+        memmove(&argv[i], &argv[i + 1], (*argc - i - 1) * sizeof(char*));
+        (*argc)--;
+        argv[*argc] = NULL;
+        break;
+    }
+    return EOK;
+}
+
 Exception
 cexy__test__run(char* target, bool is_debug, int argc, char** argv)
 {
@@ -532,6 +555,667 @@ cexy__test__run(char* target, bool is_debug, int argc, char** argv)
     return result;
 }
 
+/// Runs tests in parallel, each test output is printed at once when test finishes
+static Exception
+_cexy__test__run_jobs(char* target, u32 n_jobs, int argc, char** argv)
+{
+    Exc result = EOK;
+    u32 n_tests = 0;
+    u32 n_failed = 0;
+    bool is_all = str.ends_with(target, "test_*.c");
+    mem$scope(tmem$, _)
+    {
+        if (is_all) {
+            io.printf("-------------------------------------\n");
+            io.printf("Running Tests: %s (jobs: %d)\n", target, n_jobs);
+            io.printf("-------------------------------------\n\n");
+        } else {
+            if (!os.path.exists(target)) {
+                return e$raise(Error.not_found, "Test file not found: %s", target);
+            }
+        }
+        fflush(stdout);
+
+        os_cmd_pool_c pool;
+        os_cmd_pool_opts_s opts = { .n_jobs = n_jobs, .keep_going = true };
+        e$ret(os.cmd.pool_create(&pool, &opts, _));
+        for$each (test_src, os.fs.find(target, true, _)) {
+            n_tests++;
+            char* test_target = cexy.target_make(test_src, cexy$build_dir, ".test", _);
+            arr$(char*) args = arr$new(args, _);
+            arr$pushm(args, test_target, );
+            if (is_all) { arr$push(args, "--quiet"); }
+            arr$pusha(args, argv, argc);
+            arr$push(args, NULL);
+            if (os.cmd.pool_add(&pool, args, arr$len(args))) { result = Error.runtime; }
+        }
+        if (os.cmd.pool_join(&pool)) { result = Error.runtime; }
+
+        for$each (job, pool.jobs) {
+            if (job.err != EOK) {
+                log$error("<<<<<<<<<<<<<<<<<< Test failed: %s\n", job.args[0]);
+                n_failed++;
+            }
+        }
+        os.cmd.pool_destroy(&pool);
+    }
+    if (is_all) {
+        io.printf("\n-------------------------------------\n");
+        io.printf("Total: %d Passed: %d Failed: %d\n", n_tests, n_tests - n_failed, n_failed);
+        io.printf("-------------------------------------\n\n");
+    }
+    return result;
+}
+
+/*
+ *  Parsed source cache: cexy$cache_dir/<path hash>.<kind>, invalidated per source file by
+ *  path, size, mtime and content hash.
+ */
+// NOTE: bump on cache layout or CexParser output changes, invalidates all cached files
+#define _CEXY__CACHE_VERSION 2
+
+typedef struct _cexy__cache_hdr_s
+{
+    char magic[8]; // "CEXYC001" without zero terminator
+    u64 src_size;
+    i64 src_mtime;
+    u64 src_hash;
+    u64 variant; // e.g. hash of parser options
+    u32 path_len;
+    u32 data_len;
+} _cexy__cache_hdr_s;
+
+typedef struct _cexy__cache_decl_s
+{
+    u32 name_off;
+    u32 name_len;
+    u32 docs_off; // UINT32_MAX if NULL
+    u32 docs_len;
+    u32 body_off; // UINT32_MAX if NULL
+    u32 body_len;
+    u32 ret_type_len;
+    u32 args_len;
+    u32 line;
+    u16 type;
+    u8 is_static;
+    u8 is_inline;
+} _cexy__cache_decl_s;
+
+static u64
+_cexy__cache_hash(const void* data, usize len, u64 seed)
+{
+    const u8* p = data;
+    u64 h = seed ^ (len * 0x9E3779B97F4A7C15ULL);
+    for (; len >= 8; len -= 8, p += 8) {
+        u64 w;
+        memcpy(&w, p, sizeof(w));
+        h = (h ^ w) * 0xFF51AFD7ED558CCDULL;
+        h ^= h >> 32;
+    }
+    for (; len > 0; len--, p++) { h = (h ^ *p) * 0x100000001B3ULL; }
+    // murmur3 finalizer
+    h ^= h >> 33;
+    h *= 0xC4CEB9FE1A85EC53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+/// Mixes _CEXY__CACHE_VERSION into the `variant`, files of other cexy versions never match
+static inline u64
+_cexy__cache_variant(u64 variant)
+{
+    return _cexy__cache_hash(&variant, sizeof(variant), _CEXY__CACHE_VERSION);
+}
+
+static char*
+_cexy__cache_path(char* src_fn, char* kind, IAllocator alloc)
+{
+    if (cexy$cache_dir[0] == '\0') { return NULL; }
+    char* abspath = os.path.abs(src_fn, alloc);
+    if (abspath == NULL) { return NULL; }
+    u64 path_hash = _cexy__cache_hash(abspath, str.len(abspath), 0);
+    return str.fmt(
+        alloc,
+        "%s/%s.%08x%08x.%s",
+        cexy$cache_dir,
+        os.path.basename(abspath, alloc),
+        (u32)(path_hash >> 32),
+        (u32)path_hash,
+        kind
+    );
+}
+
+static inline bool
+_cexy__slice_in(str_s s, str_s code)
+{
+    return s.buf == NULL || (s.buf >= code.buf && s.buf + s.len <= code.buf + code.len);
+}
+
+/// Returns cached data of `kind` for the src_fn with exact `code` contents, or empty str_s
+static str_s
+_cexy__cache_load(char* src_fn, str_s code, char* kind, u64 variant, IAllocator alloc)
+{
+    str_s result = { 0 };
+    char* cache_fn = _cexy__cache_path(src_fn, kind, alloc);
+    if (cache_fn == NULL) { return result; }
+
+    os_fs_stat_s st = os.fs.stat(src_fn);
+    if (!st.is_valid || st.size != code.len) { return result; }
+
+    FILE* fh = NULL;
+    if (io.fopen(&fh, cache_fn, "rb")) { return result; }
+    str_s content = { 0 };
+    Exc err = io.fread_all(fh, &content, alloc);
+    io.fclose(&fh);
+    if (err || content.len < sizeof(_cexy__cache_hdr_s)) { return result; }
+
+    _cexy__cache_hdr_s hdr;
+    memcpy(&hdr, content.buf, sizeof(hdr));
+    char* abspath = os.path.abs(src_fn, alloc);
+    str_s cached_path = { .buf = content.buf + sizeof(hdr), .len = hdr.path_len };
+    if (memcmp(hdr.magic, "CEXYC001", sizeof(hdr.magic)) != 0 || hdr.src_size != code.len ||
+        hdr.src_mtime != (i64)st.mtime || hdr.variant != _cexy__cache_variant(variant) ||
+        content.len != sizeof(hdr) + hdr.path_len + hdr.data_len ||
+        !str.slice.eq(str.sstr(abspath), cached_path)) {
+        return result;
+    }
+    if (hdr.src_hash != _cexy__cache_hash(code.buf, code.len, 0)) { return result; }
+
+    result.buf = content.buf + sizeof(hdr) + hdr.path_len;
+    result.len = hdr.data_len;
+    return result;
+}
+
+/// Saves `data` of `kind` for the src_fn, the cache is optional so errors are only logged
+static void
+_cexy__cache_save(char* src_fn, str_s code, char* kind, u64 variant, str_s data)
+{
+    mem$scope(tmem$, _)
+    {
+        char* cache_fn = _cexy__cache_path(src_fn, kind, _);
+        if (cache_fn == NULL) { return; }
+        os_fs_stat_s st = os.fs.stat(src_fn);
+        if (!st.is_valid || st.size != code.len) { return; }
+
+        char* abspath = os.path.abs(src_fn, _);
+        _cexy__cache_hdr_s hdr = {
+            .src_size = code.len,
+            .src_mtime = st.mtime,
+            .src_hash = _cexy__cache_hash(code.buf, code.len, 0),
+            .variant = _cexy__cache_variant(variant),
+            .path_len = str.len(abspath),
+            .data_len = data.len,
+        };
+        memcpy(hdr.magic, "CEXYC001", sizeof(hdr.magic));
+
+        e$except_silent (err, os.fs.mkpath(cache_fn)) { return; }
+        // atomic replace, concurrent cexy processes never see partially written cache
+        str_s parts[] = {
+            { .buf = (char*)&hdr, .len = sizeof(hdr) },
+            { .buf = abspath, .len = hdr.path_len },
+            data,
+        };
+        e$except_silent (err, io.file.save_atomic(cache_fn, parts, arr$len(parts), false)) {
+            log$debug("Cache write failed: %s (%s)\n", cache_fn, err);
+        }
+    }
+}
+
+/*
+ *  Include dependency graph: cexy$cache_dir/<target>.<path hash>.deps, has all transitive
+ *  `#include "..."` files of the target source with their size, mtime and content hash (and
+ *  include candidates which did not exist). Valid until the target itself is rebuilt.
+ */
+typedef struct _cexy__deps_hdr_s
+{
+    char magic[8]; // "CEXYD001" without zero terminator
+    u64 variant; // hash of src path and include search paths
+    u64 target_size;
+    i64 target_mtime;
+    u32 n_deps;
+    u32 paths_len;
+} _cexy__deps_hdr_s;
+
+typedef struct _cexy__deps_rec_s
+{
+    u64 size;
+    i64 mtime;
+    u64 hash;
+    u32 path_off; // zero terminated path in paths blob
+    u32 is_file;  // 0 - include candidate which didn't exist at scan time
+} _cexy__deps_rec_s;
+
+/// Lexical path normalization (drops `.` and `dir/..` parts), keeps graph paths unique
+static char*
+_cexy__path_normalize(char* path, IAllocator alloc)
+{
+    usize len = str.len(path);
+    char* result = mem$malloc(alloc, len + 2);
+    if (result == NULL) { return NULL; }
+
+    usize n = 0;
+    if (path[0] == '/' || path[0] == '\\') { result[n++] = os$PATH_SEP; }
+    usize root = n;
+    for (usize i = 0; i < len; i++) {
+        usize seg_len = 0;
+        while (i + seg_len < len && path[i + seg_len] != '/' && path[i + seg_len] != '\\') {
+            seg_len++;
+        }
+        char* seg = path + i;
+        i += seg_len;
+        if (seg_len == 0 || (seg_len == 1 && seg[0] == '.')) { continue; }
+
+        usize last = n;
+        while (last > root && result[last - 1] != os$PATH_SEP) { last--; }
+        bool is_last_up = n - last == 2 && result[last] == '.' && result[last + 1] == '.';
+        if (seg_len == 2 && seg[0] == '.' && seg[1] == '.' && !is_last_up) {
+            if (n > root) {
+                // parent of previous segment
+                n = (last > root) ? last - 1 : root;
+                continue;
+            } else if (root > 0) {
+                // parent of root is root
+                continue;
+            }
+        }
+        if (n > root) { result[n++] = os$PATH_SEP; }
+        memcpy(result + n, seg, seg_len);
+        n += seg_len;
+    }
+    if (n == 0) { result[n++] = '.'; }
+    result[n] = '\0';
+    return result;
+}
+
+/// Checks dependency graph of the target, returns 1 - changed, 0 - up to date, -1 - no valid graph
+static int
+_cexy__deps_check(char* deps_fn, u64 variant, os_fs_stat_s target_meta, IAllocator _)
+{
+    if (deps_fn == NULL) { return -1; }
+
+    FILE* fh = NULL;
+    if (io.fopen(&fh, deps_fn, "rb")) { return -1; }
+    str_s content = { 0 };
+    Exc err = io.fread_all(fh, &content, _);
+    io.fclose(&fh);
+    if (err || content.len < sizeof(_cexy__deps_hdr_s)) { return -1; }
+
+    _cexy__deps_hdr_s hdr;
+    memcpy(&hdr, content.buf, sizeof(hdr));
+    usize recs_len = (usize)hdr.n_deps * sizeof(_cexy__deps_rec_s);
+    if (memcmp(hdr.magic, "CEXYD001", sizeof(hdr.magic)) != 0 ||
+        hdr.variant != _cexy__cache_variant(variant) ||
+        hdr.target_size != target_meta.size || hdr.target_mtime != (i64)target_meta.mtime ||
+        content.len != sizeof(hdr) + recs_len + hdr.paths_len || hdr.paths_len == 0 ||
+        content.buf[content.len - 1] != '\0') {
+        return -1;
+    }
+
+    char* recs = content.buf + sizeof(hdr);
+    char* paths = recs + recs_len;
+    bool is_touched = false;
+    time_t now = time(NULL);
+    for (u32 i = 0; i < hdr.n_deps; i++) {
+        _cexy__deps_rec_s rec;
+        memcpy(&rec, recs + i * sizeof(rec), sizeof(rec));
+        if (rec.path_off >= hdr.paths_len) { return -1; }
+        char* dep_fn = paths + rec.path_off;
+
+        auto meta = os.fs.stat(dep_fn);
+        if (!rec.is_file) {
+            if (meta.is_valid && meta.is_file) {
+                log$debug("Include added: %s\n", dep_fn);
+                return 1;
+            }
+            continue;
+        }
+        if (!meta.is_valid || !meta.is_file) {
+            log$debug("Include removed: %s\n", dep_fn);
+            return 1;
+        }
+        if (meta.size == rec.size && (i64)meta.mtime == rec.mtime) { continue; }
+
+        // Metadata changed, but contents may be the same (touch, checkout, editor save)
+        char* code = (meta.size == rec.size) ? io.file.load(dep_fn, _) : NULL;
+        if (code == NULL || _cexy__cache_hash(code, str.len(code), 0) != rec.hash) {
+            log$debug("Src changed: %s\n", dep_fn);
+            return 1;
+        }
+        if (meta.mtime < now) {
+            // NOTE: mtime of current second is racy, same size edits may follow unnoticed
+            rec.mtime = meta.mtime;
+            memcpy(recs + i * sizeof(rec), &rec, sizeof(rec));
+            is_touched = true;
+        }
+    }
+
+    if (is_touched) {
+        // Refresh mtimes, next check stays on stat() only
+        str_s parts[] = { content };
+        e$except_silent (err, io.file.save_atomic(deps_fn, parts, arr$len(parts), false)) {
+            log$debug("Deps write failed: %s (%s)\n", deps_fn, err);
+        }
+    }
+    return 0;
+}
+
+/// Full scan of transitive includes of src_path, returns true if any of them is newer than the
+/// target. Otherwise saves dependency graph for the next _cexy__deps_check()
+static bool
+_cexy__deps_scan(
+    char* deps_fn,
+    u64 variant,
+    char* src_path,
+    arr$(char*) incl_path,
+    bool with_file_dir,
+    os_fs_stat_s target_meta,
+    IAllocator _
+)
+{
+    arr$(_cexy__deps_rec_s) deps = arr$new(deps, _, .capacity = 64);
+    arr$(char) paths = arr$new(paths, _, .capacity = 4096);
+    arr$(char*) queue = arr$new(queue, _, .capacity = 64);
+    hm$(char*, bool) visited = hm$new(visited, _, .capacity = 256);
+
+    char* src_norm = _cexy__path_normalize(src_path, _);
+    uassert(src_norm != NULL);
+    arr$push(queue, src_norm);
+    hm$set(visited, src_norm, true);
+    time_t now = time(NULL);
+
+    for (usize qi = 0; qi < arr$len(queue); qi++) {
+        char* dep_fn = queue[qi];
+        auto meta = os.fs.stat(dep_fn);
+        if (!meta.is_valid || meta.mtime > target_meta.mtime) {
+            log$debug("Src changed: %s\n", dep_fn);
+            return true;
+        }
+        char* code = io.file.load(dep_fn, _);
+        if (code == NULL) {
+            log$debug("Src not readable: %s\n", dep_fn);
+            return true;
+        }
+        arr$push(
+            deps,
+            (_cexy__deps_rec_s){
+                .size = meta.size,
+                .mtime = (meta.mtime < now) ? meta.mtime : 0, // racy mtime, rehash next time
+                .hash = _cexy__cache_hash(code, str.len(code), 0),
+                .path_off = arr$len(paths),
+                .is_file = 1,
+            }
+        );
+        arr$pusha(paths, dep_fn, str.len(dep_fn) + 1);
+
+        char* file_dir = (with_file_dir) ? os.path.dirname(dep_fn, _) : NULL;
+        (void)CexTkn_str;
+        CexParser_c lx = CexParser.create(code, 0, true);
+        cex_token_s t;
+        while ((t = CexParser.next_token(&lx)).type) {
+            if (t.type != CexTkn__preproc) { continue; }
+            if (!str.slice.starts_with(t.value, str$s("include"))) { continue; }
+            str_s incf = str.slice.sub(t.value, strlen("include"), 0);
+            incf = str.slice.strip(incf);
+            if (incf.len <= 4) { // <.h>
+                log$warn("Bad include in: %s (item: %S at line: %d)\n", dep_fn, t.value, lx.line);
+                continue;
+            }
+            log$trace("Processing include: '%S'\n", incf);
+            if (!str.slice.match(incf, "\"*.[hc]\"*")) {
+                // system includes skipped
+                log$trace("Skipping include: '%S'\n", incf);
+                continue;
+            }
+            incf = str.slice.sub(incf, 1, 0);
+            incf = str.slice.sub(incf, 0, str.slice.index_of(incf, str$s("\"")) - 1);
+
+            char extensions[] = { 'c', 'h' };
+            for$each (ext, extensions) {
+                char* inc_fn = str.fmt(_, "%S%c", incf, ext);
+                uassert(inc_fn != NULL);
+                for (usize di = 0; di <= arr$len(incl_path); di++) {
+                    char* inc_dir = (di < arr$len(incl_path)) ? incl_path[di] : file_dir;
+                    if (inc_dir == NULL) { continue; }
+                    char* try_path = _cexy__path_normalize(os$path_join(_, inc_dir, inc_fn), _);
+                    uassert(try_path != NULL);
+                    if (hm$get(visited, try_path)) { continue; }
+                    hm$set(visited, try_path, true);
+
+                    log$trace("Probing include: %s\n", try_path);
+                    auto inc_meta = os.fs.stat(try_path);
+                    if (inc_meta.is_valid && inc_meta.is_file) {
+                        arr$push(queue, try_path);
+                    } else {
+                        arr$push(deps, (_cexy__deps_rec_s){ .path_off = arr$len(paths) });
+                        arr$pusha(paths, try_path, str.len(try_path) + 1);
+                    }
+                }
+            }
+        }
+    }
+
+    if (deps_fn != NULL) {
+        _cexy__deps_hdr_s hdr = {
+            .variant = _cexy__cache_variant(variant),
+            .target_size = target_meta.size,
+            .target_mtime = target_meta.mtime,
+            .n_deps = arr$len(deps),
+            .paths_len = arr$len(paths),
+        };
+        memcpy(hdr.magic, "CEXYD001", sizeof(hdr.magic));
+        e$except_silent (err, os.fs.mkpath(deps_fn)) { return false; }
+        str_s parts[] = {
+            { .buf = (char*)&hdr, .len = sizeof(hdr) },
+            { .buf = (char*)deps, .len = arr$len(deps) * sizeof(*deps) },
+            { .buf = paths, .len = arr$len(paths) },
+        };
+        e$except_silent (err, io.file.save_atomic(deps_fn, parts, arr$len(parts), false)) {
+            log$debug("Deps write failed: %s (%s)\n", deps_fn, err);
+        }
+    }
+    return false;
+}
+
+/// Parses all declarations of the src_fn `code` (CexParser.decl_parse() with ignore_kw), results
+/// are cached. Returns Error.integrity on parsing error, out_decls has all decls before error.
+static Exception
+_cexy__decls_parse(
+    char* src_fn,
+    char* code,
+    char* ignore_kw,
+    IAllocator alloc,
+    arr$(cex_decl_s*) * out_decls
+)
+{
+    uassert(out_decls && *out_decls);
+    str_s code_s = str.sstr(code);
+    u64 variant = (ignore_kw) ? _cexy__cache_hash(ignore_kw, str.len(ignore_kw), 1) : 0;
+
+    usize n_before = arr$len(*out_decls);
+    str_s cached = _cexy__cache_load(src_fn, code_s, "decls", variant, alloc);
+    if (cached.buf && cached.len >= sizeof(u32)) {
+        u32 n_decls;
+        memcpy(&n_decls, cached.buf, sizeof(u32));
+        usize off = sizeof(u32);
+        for (u32 i = 0; i < n_decls; i++) {
+            _cexy__cache_decl_s r;
+            if (off + sizeof(r) > cached.len) { goto corrupted; }
+            memcpy(&r, cached.buf + off, sizeof(r));
+            off += sizeof(r);
+            if (off + r.ret_type_len + r.args_len > cached.len ||
+                (usize)r.name_off + r.name_len > code_s.len ||
+                (r.docs_off != UINT32_MAX && (usize)r.docs_off + r.docs_len > code_s.len) ||
+                (r.body_off != UINT32_MAX && (usize)r.body_off + r.body_len > code_s.len)) {
+                goto corrupted;
+            }
+
+            cex_decl_s* d = mem$new(alloc, cex_decl_s);
+            d->name = (str_s){ .buf = code + r.name_off, .len = r.name_len };
+            if (r.docs_off != UINT32_MAX) {
+                d->docs = (str_s){ .buf = code + r.docs_off, .len = r.docs_len };
+            }
+            if (r.body_off != UINT32_MAX) {
+                d->body = (str_s){ .buf = code + r.body_off, .len = r.body_len };
+            }
+            d->ret_type = sbuf.create(r.ret_type_len + 1, alloc);
+            d->args = sbuf.create(r.args_len + 1, alloc);
+            str_s ret_type = { .buf = cached.buf + off, .len = r.ret_type_len };
+            off += r.ret_type_len;
+            str_s args = { .buf = cached.buf + off, .len = r.args_len };
+            off += r.args_len;
+            e$ret(sbuf.appendf(&d->ret_type, "%S", ret_type));
+            e$ret(sbuf.appendf(&d->args, "%S", args));
+            d->file = src_fn;
+            d->line = r.line;
+            d->type = r.type;
+            d->is_static = r.is_static;
+            d->is_inline = r.is_inline;
+            arr$push(*out_decls, d);
+        }
+        return EOK;
+
+    corrupted:
+        log$debug("Cache corrupted for: %s\n", src_fn);
+        while (arr$len(*out_decls) > n_before) {
+            CexParser.decl_free(arr$pop(*out_decls), alloc);
+        }
+    }
+
+    arr$(cex_token_s) items = arr$new(items, alloc);
+    sbuf_c data = sbuf.create(1024 * 16, alloc);
+    u32 n_decls = 0;
+    e$ret(sbuf.appendf(&data, "%S", (str_s){ .buf = (char*)&n_decls, .len = sizeof(n_decls) }));
+
+    bool is_cacheable = true;
+    CexParser_c lx = CexParser.create(code, code_s.len, true);
+    cex_token_s t;
+    while ((t = CexParser.next_entity(&lx, &items)).type) {
+        if (t.type == CexTkn__error) {
+            return e$raise(
+                Error.integrity,
+                "Error parsing file %s, at line: %d, cursor: %d",
+                src_fn,
+                lx.line,
+                (i32)(lx.cur - lx.content)
+            );
+        }
+        cex_decl_s* d = CexParser.decl_parse(&lx, t, items, ignore_kw, alloc);
+        if (d == NULL) { continue; }
+        d->file = src_fn;
+        arr$push(*out_decls, d);
+        if (!_cexy__slice_in(d->name, code_s) || !_cexy__slice_in(d->docs, code_s) ||
+            !_cexy__slice_in(d->body, code_s)) {
+            is_cacheable = false;
+            continue;
+        }
+
+        _cexy__cache_decl_s r = {
+            .name_off = d->name.buf - code,
+            .name_len = d->name.len,
+            .docs_off = (d->docs.buf) ? (u32)(d->docs.buf - code) : UINT32_MAX,
+            .docs_len = d->docs.len,
+            .body_off = (d->body.buf) ? (u32)(d->body.buf - code) : UINT32_MAX,
+            .body_len = d->body.len,
+            .ret_type_len = sbuf.len(&d->ret_type),
+            .args_len = sbuf.len(&d->args),
+            .line = d->line,
+            .type = d->type,
+            .is_static = d->is_static,
+            .is_inline = d->is_inline,
+        };
+        e$ret(sbuf.appendf(&data, "%S", (str_s){ .buf = (char*)&r, .len = sizeof(r) }));
+        e$ret(sbuf.appendf(&data, "%s%s", d->ret_type, d->args));
+        n_decls++;
+    }
+    memcpy(data, &n_decls, sizeof(n_decls));
+    if (is_cacheable) {
+        str_s payload = { .buf = data, .len = sbuf.len(&data) };
+        _cexy__cache_save(src_fn, code_s, "decls", variant, payload);
+    }
+    sbuf.destroy(&data);
+    arr$free(items);
+    return EOK;
+}
+
+/*
+ *  Worker pool for independent per-file jobs (parsing, codegen). Each worker thread has its own
+ *  tmem$ arena, job results must be stored by index and merged by caller in index order.
+ */
+typedef struct _cexy__parallel_s
+{
+    Exception (*job_fn)(u32 idx, void* ctx);
+    void* ctx;
+    Exc* errors;
+    u32 n_jobs;
+    u32 next_job; // atomic
+} _cexy__parallel_s;
+
+static void
+_cexy__parallel_worker_loop(_cexy__parallel_s* p)
+{
+    while (true) {
+        u32 idx = __atomic_fetch_add(&p->next_job, 1, __ATOMIC_RELAXED);
+        if (idx >= p->n_jobs) { break; }
+        p->errors[idx] = p->job_fn(idx, p->ctx);
+    }
+}
+
+#    if defined(CEX_HAS_THREADS)
+static _cex_thread_fn(_cexy__parallel_worker, arg)
+{
+    _cexy__parallel_worker_loop(arg);
+    // tmem$ is thread local, pages must be released before thread exit
+    _cex_allocator_temp_cleanup();
+    return 0;
+}
+#    endif
+
+/// Runs job_fn(0..n_jobs-1) on up to cexy$parallel_jobs threads (0 - cpu count), returns error of
+/// the first failed job (in job index order, i.e. deterministic)
+static Exception
+_cexy__parallel_for(u32 n_jobs, Exception (*job_fn)(u32 idx, void* ctx), void* ctx)
+{
+    uassert(job_fn != NULL);
+    if (n_jobs == 0) { return EOK; }
+
+    u32 n_threads = (cexy$parallel_jobs > 0) ? cexy$parallel_jobs : os.platform.cpu_count();
+    if (n_threads > n_jobs) { n_threads = n_jobs; }
+
+    Exc result = EOK;
+    mem$scope(tmem$, _)
+    {
+        _cexy__parallel_s p = {
+            .job_fn = job_fn,
+            .ctx = ctx,
+            .errors = mem$calloc(_, n_jobs, sizeof(Exc)),
+            .n_jobs = n_jobs,
+        };
+
+#    if defined(CEX_HAS_THREADS)
+        // current thread is also a worker
+        u32 n_spawned = 0;
+        _cex_thread_t* threads = mem$calloc(_, n_threads, sizeof(_cex_thread_t));
+        for (u32 i = 1; i < n_threads; i++) {
+            if (!_cex_thread_spawn(&threads[n_spawned], _cexy__parallel_worker, &p)) { break; }
+            n_spawned++;
+        }
+        _cexy__parallel_worker_loop(&p);
+        for (u32 i = 0; i < n_spawned; i++) { _cex_thread_join(threads[i]); }
+#    else
+        (void)n_threads;
+        _cexy__parallel_worker_loop(&p);
+#    endif
+
+        for (u32 i = 0; i < n_jobs; i++) {
+            if (p.errors[i] != EOK) {
+                result = p.errors[i];
+                break;
+            }
+        }
+    }
+    return result;
+}
+
 static int
 _cexy__decl_comparator(const void* a, const void* b)
 {
@@ -863,6 +1547,475 @@ _cexy__fn_dotted(str_s fn_name, char* expected_ns, IAllocator alloc)
     }
 }
 
+typedef struct _cexy__json_field_s
+{
+    str_s name; // C field name (and JSON key)
+    str_s type; // C type (without pointer)
+    char* kind; // bool, int, uint, i64, float, cstr, cbuf, str, obj, objptr
+    char* min;  // int range for kind int/uint
+    char* max;
+} _cexy__json_field_s;
+
+static Exception
+_cexy__json_parse_fields(
+    cex_decl_s* decl,
+    arr$(str_s) json_types,
+    arr$(_cexy__json_field_s)* out_fields,
+    IAllocator alloc
+)
+{
+    // clang-format off
+    static struct { char* type; char* kind; char* min; char* max; } types[] = {
+        {"bool", "bool", 0, 0}, {"_Bool", "bool", 0, 0},
+        {"i8", "int", "INT8_MIN", "INT8_MAX"}, {"i16", "int", "INT16_MIN", "INT16_MAX"},
+        {"i32", "int", "INT32_MIN", "INT32_MAX"}, {"int", "int", "INT_MIN", "INT_MAX"},
+        {"isize", "int", "PTRDIFF_MIN", "PTRDIFF_MAX"}, {"i64", "i64", 0, 0},
+        {"u8", "uint", "0", "UINT8_MAX"}, {"u16", "uint", "0", "UINT16_MAX"},
+        {"u32", "uint", "0", "UINT32_MAX"}, {"usize", "uint", "0", "SIZE_MAX"},
+        {"u64", "uint", "0", "UINT64_MAX"},
+        {"f32", "float", 0, 0}, {"f64", "float", 0, 0},
+        {"float", "float", 0, 0}, {"double", "float", 0, 0},
+        {"str_s", "str", 0, 0},
+    };
+    // clang-format on
+
+    str_s body = str.slice.sub(decl->body, 1, -1); // strip {}
+    CexParser_c lx = CexParser.create(body.buf, body.len, true);
+    arr$(cex_token_s) ftoks = arr$new(ftoks, alloc);
+    cex_token_s t;
+    char* field_start = NULL;
+    while ((t = CexParser.next_token(&lx)).type) {
+        if (t.type == CexTkn__comment_single || t.type == CexTkn__comment_multi) { continue; }
+        if (t.type == CexTkn__ident && str.slice.match(t.value, "(const|volatile)")) { continue; }
+        if (field_start == NULL) { field_start = t.value.buf; }
+        if (t.type != CexTkn__eos) {
+            arr$push(ftoks, t);
+            continue;
+        }
+
+        str_s ftext = { .buf = field_start, .len = t.value.buf - field_start };
+        (void)ftext; // used only in error message
+        field_start = NULL;
+        usize n = arr$len(ftoks);
+        _cexy__json_field_s f = { 0 };
+        u32 n_stars = 0;
+        bool is_fixed_arr = false;
+        if (n >= 2 && ftoks[n - 1].type == CexTkn__bracket_block) {
+            is_fixed_arr = true;
+            n--;
+        }
+        if (n < 2 || ftoks[n - 1].type != CexTkn__ident) { goto unsupported; }
+        f.name = ftoks[n - 1].value;
+        for (usize i = 0; i < n - 1; i++) {
+            if (ftoks[i].type == CexTkn__star) {
+                n_stars++;
+            } else if (ftoks[i].type == CexTkn__ident && f.type.buf == NULL && n_stars == 0) {
+                f.type = ftoks[i].value;
+            } else {
+                goto unsupported;
+            }
+        }
+
+        if (is_fixed_arr) {
+            if (n_stars == 0 && str.slice.eq(f.type, str$s("char"))) { f.kind = "cbuf"; }
+        } else if (n_stars == 1) {
+            if (str.slice.eq(f.type, str$s("char"))) { f.kind = "cstr"; }
+            for$each (jt, json_types) {
+                if (str.slice.eq(f.type, jt)) { f.kind = "objptr"; }
+            }
+        } else if (n_stars == 0) {
+            for$each (it, types) {
+                if (str.slice.eq(f.type, str.sstr(it.type))) {
+                    f.kind = it.kind;
+                    f.min = it.min;
+                    f.max = it.max;
+                }
+            }
+            for$each (jt, json_types) {
+                if (str.slice.eq(f.type, jt)) { f.kind = "obj"; }
+            }
+        }
+        if (f.kind == NULL) { goto unsupported; }
+        arr$push(*out_fields, f);
+        arr$clear(ftoks);
+        continue;
+
+    unsupported:
+        return e$raise(
+            Error.integrity,
+            "Unsupported JSON field in %S (line: %d): '%S'",
+            decl->name,
+            decl->line,
+            str.slice.strip(ftext)
+        );
+    }
+    if (t.type == CexTkn__error) {
+        return e$raise(Error.integrity, "Error parsing struct %S", decl->name);
+    }
+    if (arr$len(*out_fields) == 0) {
+        return e$raise(Error.integrity, "No JSON fields in struct %S", decl->name);
+    }
+    return EOK;
+}
+
+static void
+_cexy__json_gen_decode_field(_cex__codegen_s* cg$var, _cexy__json_field_s* f)
+{
+    char* kind = f->kind;
+    if (str.eq(kind, "bool")) {
+        cg$pf("jr$egoto(jr, jr$get_bool(jr, &out->%S), fail);", f->name);
+    } else if (str.eq(kind, "i64")) {
+        cg$pf("jr$egoto(jr, jr$get_i64(jr, &out->%S), fail);", f->name);
+    } else if (str.eq(kind, "int")) {
+        cg$pn("i64 n = 0;");
+        cg$pn("jr$egoto(jr, jr$get_i64(jr, &n), fail);");
+        cg$pf("if (n < %s || n > %s) { jr$egoto(jr, Error.overflow, fail); }", f->min, f->max);
+        cg$pf("out->%S = (%S)n;", f->name, f->type);
+    } else if (str.eq(kind, "uint")) {
+        cg$pn("u64 n = 0;");
+        cg$pn("jr$egoto(jr, jr$get_u64(jr, &n), fail);");
+        if (!str.eq(f->max, "UINT64_MAX")) {
+            cg$pf("if (n > %s) { jr$egoto(jr, Error.overflow, fail); }", f->max);
+        }
+        cg$pf("out->%S = (%S)n;", f->name, f->type);
+    } else if (str.eq(kind, "float")) {
+        cg$pn("f64 n = 0;");
+        cg$pn("jr$egoto(jr, jr$get_f64(jr, &n), fail);");
+        cg$pf("out->%S = (%S)n;", f->name, f->type);
+    } else if (str.eq(kind, "cstr")) {
+        cg$pf("jr$egoto(jr, jr$get_str_alloc(jr, &out->%S, allc), fail);", f->name);
+    } else if (str.eq(kind, "cbuf")) {
+        cg$pf("jr$egoto(jr, jr$get_str(jr, out->%S, sizeof(out->%S)), fail);", f->name, f->name);
+    } else if (str.eq(kind, "str")) {
+        cg$pn("Exc err_type = (jr->type == JsonType__str) ? EOK : \"Expected string value\";");
+        cg$pn("jr$egoto(jr, err_type, fail);");
+        cg$pf("out->%S = v; // raw JSON value (not unescaped)", f->name);
+    } else if (str.eq(kind, "obj")) {
+        cg$pf("jr$egoto(jr, %S_json_decode(jr, &out->%S, allc), fail);", f->type, f->name);
+    } else if (str.eq(kind, "objptr")) {
+        cg$pf("if (out->%S == NULL) { out->%S = mem$new(allc, %S); }", f->name, f->name, f->type);
+        cg$pf("if (out->%S == NULL) { jr$egoto(jr, Error.memory, fail); }", f->name);
+        cg$pf("jr$egoto(jr, %S_json_decode(jr, out->%S, allc), fail);", f->type, f->name);
+    } else {
+        unreachable();
+    }
+}
+
+static void
+_cexy__json_gen_decode_keys(_cex__codegen_s* cg$var, arr$(_cexy__json_field_s*) fields)
+{
+    // fields with the same key length, dispatching by most distinctive char position
+    usize key_len = fields[0]->name.len;
+    if (arr$len(fields) == 1) {
+        cg$if("memcmp(k.buf, \"%S\", %d) == 0", fields[0]->name, key_len)
+        {
+            _cexy__json_gen_decode_field(cg$var, fields[0]);
+        }
+        return;
+    }
+
+    usize best_pos = 0;
+    u32 best_distinct = 0;
+    for (usize pos = 0; pos < key_len; pos++) {
+        u32 distinct = 0;
+        for$each (f, fields) {
+            bool is_new = true;
+            for$each (prev, fields) {
+                if (prev == f) { break; }
+                if (prev->name.buf[pos] == f->name.buf[pos]) { is_new = false; }
+            }
+            distinct += is_new;
+        }
+        if (distinct > best_distinct) {
+            best_distinct = distinct;
+            best_pos = pos;
+        }
+    }
+
+    cg$switch("k.buf[%d]", best_pos)
+    {
+        for$each (f, fields) {
+            char c = f->name.buf[best_pos];
+            bool is_first = true;
+            for$each (prev, fields) {
+                if (prev == f) { break; }
+                if (prev->name.buf[best_pos] == c) { is_first = false; }
+            }
+            if (!is_first) { continue; }
+            cg$case("'%c'", c)
+            {
+                for$each (f2, fields) {
+                    if (f2->name.buf[best_pos] != c) { continue; }
+                    cg$if("memcmp(k.buf, \"%S\", %d) == 0", f2->name, key_len)
+                    {
+                        _cexy__json_gen_decode_field(cg$var, f2);
+                    }
+                }
+            }
+        }
+    }
+}
+
+static Exception
+_cexy__json_gen_struct(sbuf_c* out_buf, str_s type_name, arr$(_cexy__json_field_s) fields)
+{
+    cg$init(out_buf);
+
+    // Decoder: switch on key length + most distinctive char, and direct field writes
+    cg$pn("/// Decodes JSON object into `out`, allc is used for char* and struct pointer fields");
+    cg$pn("Exception");
+    cg$func("%S_json_decode(jr_c* jr, %S* out, IAllocator allc)\n", type_name, type_name)
+    {
+        cg$pn("(void)allc;");
+        cg$scope("jr$foreach(k, v, jr) ", "")
+        {
+            cg$pn("(void)v;");
+            cg$pn("if (jr->type == JsonType__null) { continue; }");
+            cg$switch("k.len", "")
+            {
+                usize max_len = 0;
+                for$each (f, fields) { max_len = (f.name.len > max_len) ? f.name.len : max_len; }
+                for (usize len = 1; len <= max_len; len++) {
+                    mem$scope(tmem$, _)
+                    {
+                        arr$(_cexy__json_field_s*) same_len = arr$new(same_len, _);
+                        for$eachp(f, fields) {
+                            if (f->name.len == len) { arr$push(same_len, f); }
+                        }
+                        if (arr$len(same_len) == 0) { continue; }
+                        cg$case("%d", len)
+                        {
+                            _cexy__json_gen_decode_keys(cg$var, same_len);
+                        }
+                    }
+                }
+            }
+        }
+        cg$pa("\nfail:\n", "");
+        cg$pn("return jr->error;");
+    }
+    cg$pn("");
+
+    // Encoder: jw$ writer scope
+    cg$pn("/// Encodes `obj` as JSON object into jw$ writer");
+    cg$pn("Exception");
+    cg$func("%S_json_encode(jw_c* jw, %S* obj)\n", type_name, type_name)
+    {
+        cg$scope("jw$scope(jw, JsonType__obj) ", "")
+        {
+            for$each (f, fields) {
+                cg$pf("jw$key(\"%S\");", f.name);
+                if (str.eq(f.kind, "bool")) {
+                    cg$pf("jw$bool(obj->%S);", f.name);
+                } else if (str.eq(f.kind, "cstr")) {
+                    cg$if("obj->%S != NULL", f.name)
+                    {
+                        cg$pf("jw$val(obj->%S);", f.name);
+                    }
+                    cg$else()
+                    {
+                        cg$pn("jw$null();");
+                    }
+                } else if (str.eq(f.kind, "obj")) {
+                    cg$pf("e$ret(%S_json_encode(jw, &obj->%S));", f.type, f.name);
+                } else if (str.eq(f.kind, "objptr")) {
+                    cg$if("obj->%S != NULL", f.name)
+                    {
+                        cg$pf("e$ret(%S_json_encode(jw, obj->%S));", f.type, f.name);
+                    }
+                    cg$else()
+                    {
+                        cg$pn("jw$null();");
+                    }
+                } else if (str.eq(f.kind, "int") || str.eq(f.kind, "uint") ||
+                           str.eq(f.kind, "float")) {
+                    // jw$val() has no overloads for platform types, e.g. int/usize/double
+                    char* cast = str.eq(f.kind, "int") ? "i64" : "u64";
+                    if (str.eq(f.kind, "float")) {
+                        bool is_f32 = str.slice.eq(f.type, str$s("f32")) ||
+                                      str.slice.eq(f.type, str$s("float"));
+                        cast = (is_f32) ? "f32" : "f64";
+                    }
+                    cg$pf("jw$val((%s)obj->%S);", cast, f.name);
+                } else {
+                    cg$pf("jw$val(obj->%S);", f.name);
+                }
+            }
+        }
+        cg$pn("return jw$validate(jw);");
+    }
+    cg$pn("");
+
+    if (!cg$is_valid()) { return e$raise(Error.runtime, "Code generation error occured\n"); }
+    return EOK;
+}
+
+/// Generates JSON decoders/encoders for typedef structs marked by `@json` in docs comment of
+/// header_file. Output file has <type>_json_decode(jr_c*, <type>*, IAllocator) and
+/// <type>_json_encode(jw_c*, <type>*) functions, it must be included after lib/json/json.c and
+/// the header. Supported fields: bool, ints, floats, char*, char[N], str_s, and @json structs.
+static Exception
+cexy__utils__json_codegen(char* header_file, char* out_file)
+{
+    if (header_file == NULL || out_file == NULL) { return Error.argument; }
+    mem$scope(tmem$, _)
+    {
+        char* code = io.file.load(header_file, _);
+        if (code == NULL) { return e$raise(Error.not_found, "Failed loading: %s", header_file); }
+
+        arr$(cex_token_s) items = arr$new(items, _);
+        arr$(cex_decl_s*) decls = arr$new(decls, _);
+        arr$(str_s) json_types = arr$new(json_types, _);
+
+        CexParser_c lx = CexParser.create(code, 0, true);
+        cex_token_s t;
+        while ((t = CexParser.next_entity(&lx, &items)).type) {
+            if (t.type == CexTkn__error) {
+                return e$raise(
+                    Error.integrity,
+                    "Error parsing file %s, at line: %d",
+                    header_file,
+                    lx.line
+                );
+            }
+            if (t.type != CexTkn__typedef) { continue; }
+            cex_decl_s* d = CexParser.decl_parse(&lx, t, items, NULL, _);
+            if (d == NULL || d->body.len == 0 || !str.slice.match(d->docs, "*@json*")) { continue; }
+            bool is_struct = false;
+            for$each (it, items) {
+                if (it.type == CexTkn__ident && str.slice.eq(it.value, str$s("struct"))) {
+                    is_struct = true;
+                    break;
+                }
+            }
+            if (!is_struct) { continue; }
+            arr$push(decls, d);
+            arr$push(json_types, d->name);
+        }
+        if (arr$len(decls) == 0) {
+            return e$raise(Error.not_found, "No structs with @json docs in: %s", header_file);
+        }
+
+        sbuf_c buf = sbuf.create(16 * 1024, _);
+        e$ret(sbuf.appendf(
+            &buf,
+            "// Autogenerated by CEX (./cex process --json %s), do not edit!\n"
+            "// Include after lib/json/json.c and %s\n\n",
+            header_file,
+            os.path.basename(header_file, _)
+        ));
+        for$each (d, decls) {
+            e$ret(sbuf.appendf(
+                &buf,
+                "Exception %S_json_decode(jr_c* jr, %S* out, IAllocator allc);\n"
+                "Exception %S_json_encode(jw_c* jw, %S* obj);\n",
+                d->name,
+                d->name,
+                d->name,
+                d->name
+            ));
+        }
+        e$ret(sbuf.append(&buf, "\n"));
+        for$each (d, decls) {
+            arr$(_cexy__json_field_s) fields = arr$new(fields, _);
+            e$ret(_cexy__json_parse_fields(d, json_types, &fields, _));
+            e$ret(_cexy__json_gen_struct(&buf, d->name, fields));
+        }
+        e$ret(io.file.save(out_file, buf));
+        log$info("JSON codecs generated: %s -> %s\n", header_file, out_file);
+    }
+    return EOK;
+}
+
+typedef struct _cexy__process_ctx_s
+{
+    arr$(char*) src_files;
+    char* ignore_kw;
+    bool only_update;
+} _cexy__process_ctx_s;
+
+static Exception
+_cexy__process_file(u32 idx, void* ctx)
+{
+    _cexy__process_ctx_s* pctx = ctx;
+    char* src_fn = pctx->src_files[idx];
+    bool only_update = pctx->only_update;
+
+    mem$scope(tmem$, _)
+    {
+        e$assert(str.ends_with(src_fn, ".c") && "file must end with .c");
+
+        char* hdr_fn = str.clone(src_fn, _);
+        hdr_fn[str.len(hdr_fn) - 1] = 'h'; // .c -> .h
+
+        str_s ns_prefix = str.sub(os.path.basename(src_fn, _), 0, -2); // src.c -> src
+        log$debug(
+            "Cex Processing src: '%s' hdr: '%s' prefix: '%S'\n",
+            src_fn,
+            hdr_fn,
+            ns_prefix
+        );
+        if (!os.path.exists(hdr_fn)) {
+            if (only_update) {
+                log$debug("CEX skipped (no .h file for: %s)\n", src_fn);
+                return EOK;
+            } else {
+                return e$raise(Error.not_found, "Header file not exists: '%s'", hdr_fn);
+            }
+        }
+        char* code = io.file.load(src_fn, _);
+        e$assert(code && "failed loading code");
+        arr$(cex_decl_s*) all_decls = arr$new(all_decls, _, .capacity = 128);
+        arr$(cex_decl_s*) decls = arr$new(decls, _, .capacity = 128);
+
+        e$ret(_cexy__decls_parse(src_fn, code, pctx->ignore_kw, _, &all_decls));
+        for$each (d, all_decls) {
+            if (d->type != CexTkn__func_def) { continue; }
+            if (d->is_inline && d->is_static) { continue; }
+            if (!_cexy__fn_match(d->name, ns_prefix)) { continue; }
+            log$trace("FN: %S ret_type: '%s' args: '%s'\n", d->name, d->ret_type, d->args);
+            arr$push(decls, d);
+        }
+        if (arr$len(decls) == 0) {
+            log$info("CEX skipped (no cex decls found in : %s)\n", src_fn);
+            return EOK;
+        }
+
+        arr$sort(decls, _cexy__decl_comparator);
+
+        sbuf_c cex_h_struct = sbuf.create(10 * 1024, _);
+        sbuf_c cex_h_var_decl = sbuf.create(1024, _);
+        sbuf_c cex_c_var_def = sbuf.create(10 * 1024, _);
+
+        e$ret(sbuf.appendf(
+            &cex_h_var_decl,
+            "CEX_NAMESPACE struct __cex_namespace__%S %S;\n",
+            ns_prefix,
+            ns_prefix
+        ));
+        e$ret(_cexy__process_gen_struct(ns_prefix, decls, &cex_h_struct));
+        e$ret(_cexy__process_gen_var_def(ns_prefix, decls, &cex_c_var_def));
+        e$ret(_cexy__process_update_code(
+            src_fn,
+            only_update,
+            cex_h_struct,
+            cex_h_var_decl,
+            cex_c_var_def
+        ));
+        e$ret(_cexy__process_update_code(
+            hdr_fn,
+            only_update,
+            cex_h_struct,
+            cex_h_var_decl,
+            cex_c_var_def
+        ));
+
+        // log$info("cex_h_struct: \n%s\n", cex_h_struct);
+        log$info("CEX processed: %s\n", src_fn);
+    }
+    return EOK;
+}
+
 static Exception
 cexy__cmd__process(int argc, char** argv, void* user_ctx)
 {
@@ -885,11 +2038,15 @@ cexy__cmd__process(int argc, char** argv, void* user_ctx)
     "7. Functions with `static inline` are not included into namespace\n" 
     "8. Functions with prefix `foo__some` are considered internal and not included\n"
     "9. New namespace is created when you use exact foo.c argument, `all` just for updates\n"
+    "\n"
+    "JSON codecs: `process --json path/foo.h` generates path/foo_json.c with\n"
+    "   <type>_json_decode() / <type>_json_encode() for typedef structs with @json in docs\n"
 
     ;
     // clang-format on
 
     char* ignore_kw = cexy$process_ignore_kw;
+    bool is_json = false;
     argparse_c cmd_args = {
         .program_name = "./cex",
         .usage = "process [options] all|path/some_file.c",
@@ -904,6 +2061,7 @@ cexy__cmd__process(int argc, char** argv, void* user_ctx)
                 "ignore",
                 .help = "ignores `keyword` or `keyword()` from processed function signatures\n  uses cexy$process_ignore_kw"
             ),
+            argparse$opt(&is_json, 'j', "json", .help = "generate JSON codecs for path/foo.h"),
         ),
     };
     e$ret(argparse.parse(&cmd_args, argc, argv));
@@ -919,6 +2077,18 @@ cexy__cmd__process(int argc, char** argv, void* user_ctx)
     }
 
 
+    if (is_json) {
+        if (!str.ends_with(target, ".h")) {
+            return e$raise(Error.argument, "Expected path/some_file.h, got: '%s'", target);
+        }
+        mem$scope(tmem$, _)
+        {
+            char* out_file = str.fmt(_, "%S_json.c", str.sub(target, 0, -2));
+            e$ret(cexy.utils.json_codegen(target, out_file));
+        }
+        return EOK;
+    }
+
     bool only_update = true;
     if (str.eq(target, "all")) {
         target = "*.c";
@@ -935,6 +2105,11 @@ cexy__cmd__process(int argc, char** argv, void* user_ctx)
         char* build_path = os.path.abs(cexy$build_dir, _);
         char* test_path = os.path.abs("./tests/", _);
 
+        _cexy__process_ctx_s pctx = {
+            .src_files = arr$new(pctx.src_files, _, .capacity = 128),
+            .ignore_kw = ignore_kw,
+            .only_update = only_update,
+        };
         for$each (src_fn, os.fs.find(target, true, _)) {
             if (only_update) {
                 char* abspath = os.path.abs(src_fn, _);
@@ -944,90 +2119,117 @@ cexy__cmd__process(int argc, char** argv, void* user_ctx)
             }
             char* basename = os.path.basename(src_fn, _);
             if (str.starts_with(basename, "test") || str.eq(basename, "cex.c")) { continue; }
-            mem$scope(tmem$, _)
-            {
-                e$assert(str.ends_with(src_fn, ".c") && "file must end with .c");
+            arr$push(pctx.src_files, src_fn);
+        }
+        e$ret(_cexy__parallel_for(arr$len(pctx.src_files), _cexy__process_file, &pctx));
+    }
+    return EOK;
+}
 
-                char* hdr_fn = str.clone(src_fn, _);
-                hdr_fn[str.len(hdr_fn) - 1] = 'h'; // .c -> .h
+typedef struct _cexy__file_stats_s
+{
+    u32 n_asserts;
+    u32 n_lines_code;
+    u32 n_lines_comments;
+    u32 n_lines_total;
+    u32 n_loc;
+} _cexy__file_stats_s;
 
-                str_s ns_prefix = str.sub(os.path.basename(src_fn, _), 0, -2); // src.c -> src
-                log$debug(
-                    "Cex Processing src: '%s' hdr: '%s' prefix: '%S'\n",
-                    src_fn,
-                    hdr_fn,
-                    ns_prefix
-                );
-                if (!os.path.exists(hdr_fn)) {
-                    if (only_update) {
-                        log$debug("CEX skipped (no .h file for: %s)\n", src_fn);
-                        continue;
-                    } else {
-                        return e$raise(Error.not_found, "Header file not exists: '%s'", hdr_fn);
+static Exception
+_cexy__stats_parse(char* src_fn, char* code, _cexy__file_stats_s* stats)
+{
+    (void)src_fn; // used only in error message
+    if (code[0] != '\0') { stats->n_lines_total++; }
+    CexParser_c lx = CexParser.create(code, 0, false);
+    cex_token_s t;
+
+    u32 last_line = 0;
+    while ((t = CexParser.next_token(&lx)).type) {
+        if (t.type == CexTkn__error) {
+            return e$raise(
+                Error.integrity,
+                "Error parsing file %s, at line: %d, cursor: %d",
+                src_fn,
+                lx.line,
+                (i32)(lx.cur - lx.content)
+            );
+        }
+        switch (t.type) {
+            case CexTkn__ident:
+                if (t.value.len >= 6) {
+                    // NOTE: code is not modified, it's hashed for the cache
+                    char lower[8];
+                    usize len = (t.value.len < sizeof(lower)) ? t.value.len : sizeof(lower);
+                    for (usize i = 0; i < len; i++) { lower[i] = tolower(t.value.buf[i]); }
+                    str_s ident = { .buf = lower, .len = len };
+                    if (str.slice.starts_with(ident, str$s("uassert")) ||
+                        str.slice.starts_with(ident, str$s("assert")) ||
+                        str.slice.starts_with(ident, str$s("ensure")) ||
+                        str.slice.starts_with(ident, str$s("enforce")) ||
+                        str.slice.starts_with(ident, str$s("expect")) ||
+                        str.slice.starts_with(ident, str$s("e$assert")) ||
+                        str.slice.starts_with(ident, str$s("tassert"))) {
+                        stats->n_asserts++;
                     }
                 }
-                char* code = io.file.load(src_fn, _);
-                e$assert(code && "failed loading code");
-                arr$(cex_token_s) items = arr$new(items, _);
-                arr$(cex_decl_s*) decls = arr$new(decls, _, .capacity = 128);
-
-                CexParser_c lx = CexParser.create(code, 0, true);
-                cex_token_s t;
-                while ((t = CexParser.next_entity(&lx, &items)).type) {
-                    if (t.type == CexTkn__error) {
-                        return e$raise(
-                            Error.integrity,
-                            "Error parsing file %s, at line: %d, cursor: %d",
-                            src_fn,
-                            lx.line,
-                            (i32)(lx.cur - lx.content)
-                        );
+                goto def;
+            case CexTkn__comment_multi: {
+                for$each (c, t.value.buf, t.value.len) {
+                    if (c == '\n') { stats->n_lines_comments++; }
+                }
+            }
+                fallthrough();
+            case CexTkn__comment_single:
+                stats->n_lines_comments++;
+                break;
+            case CexTkn__preproc: {
+                for$each (c, t.value.buf, t.value.len) {
+                    if (c == '\n') {
+                        stats->n_lines_code++;
+                        stats->n_loc++;
                     }
-                    cex_decl_s* d = CexParser.decl_parse(&lx, t, items, cexy$process_ignore_kw, _);
-                    if (d == NULL) { continue; }
-                    if (d->type != CexTkn__func_def) { continue; }
-                    if (d->is_inline && d->is_static) { continue; }
-                    if (!_cexy__fn_match(d->name, ns_prefix)) { continue; }
-                    log$trace("FN: %S ret_type: '%s' args: '%s'\n", d->name, d->ret_type, d->args);
-                    arr$push(decls, d);
                 }
-                if (arr$len(decls) == 0) {
-                    log$info("CEX skipped (no cex decls found in : %s)\n", src_fn);
-                    continue;
+            }
+                fallthrough();
+            default:
+            def:
+                if (last_line < lx.line) {
+                    stats->n_lines_code++;
+                    stats->n_loc++;
+                    stats->n_lines_total += (lx.line - last_line);
+                    last_line = lx.line;
                 }
+                break;
+        }
+    }
+    return EOK;
+}
 
-                arr$sort(decls, _cexy__decl_comparator);
-
-                sbuf_c cex_h_struct = sbuf.create(10 * 1024, _);
-                sbuf_c cex_h_var_decl = sbuf.create(1024, _);
-                sbuf_c cex_c_var_def = sbuf.create(10 * 1024, _);
-
-                e$ret(sbuf.appendf(
-                    &cex_h_var_decl,
-                    "CEX_NAMESPACE struct __cex_namespace__%S %S;\n",
-                    ns_prefix,
-                    ns_prefix
-                ));
-                e$ret(_cexy__process_gen_struct(ns_prefix, decls, &cex_h_struct));
-                e$ret(_cexy__process_gen_var_def(ns_prefix, decls, &cex_c_var_def));
-                e$ret(_cexy__process_update_code(
-                    src_fn,
-                    only_update,
-                    cex_h_struct,
-                    cex_h_var_decl,
-                    cex_c_var_def
-                ));
-                e$ret(_cexy__process_update_code(
-                    hdr_fn,
-                    only_update,
-                    cex_h_struct,
-                    cex_h_var_decl,
-                    cex_c_var_def
-                ));
-
-                // log$info("cex_h_struct: \n%s\n", cex_h_struct);
-                log$info("CEX processed: %s\n", src_fn);
-            }
+typedef struct _cexy__stats_ctx_s
+{
+    arr$(char*) src_files;
+    _cexy__file_stats_s* results;
+} _cexy__stats_ctx_s;
+
+static Exception
+_cexy__stats_file(u32 idx, void* ctx)
+{
+    _cexy__stats_ctx_s* sctx = ctx;
+    char* src_fn = sctx->src_files[idx];
+    _cexy__file_stats_s* fstats = &sctx->results[idx];
+
+    mem$scope(tmem$, _)
+    {
+        char* code = io.file.load(src_fn, _);
+        if (!code) { return e$raise(Error.os, "Error opening file: '%s'", src_fn); }
+
+        str_s cached = _cexy__cache_load(src_fn, str.sstr(code), "stats", 0, _);
+        if (cached.len == sizeof(*fstats)) {
+            memcpy(fstats, cached.buf, sizeof(*fstats));
+        } else {
+            e$ret(_cexy__stats_parse(src_fn, code, fstats));
+            str_s data = { .buf = (char*)fstats, .len = sizeof(*fstats) };
+            _cexy__cache_save(src_fn, str.sstr(code), "stats", 0, data);
         }
     }
     return EOK;
@@ -1101,86 +2303,34 @@ cexy__cmd__stats(int argc, char** argv, void* user_ctx)
         if (verbose) {
             io.printf("Files found: %d excluded: %d\n", hm$len(src_files), hm$len(excl_files));
         }
+        _cexy__stats_ctx_s sctx = {
+            .src_files = arr$new(sctx.src_files, _, .capacity = hm$len(src_files) + 1),
+        };
         for$each (src_fn, src_files) {
             if (hm$getp(excl_files, src_fn.key)) { continue; }
+            if (str.eq(os.path.basename(src_fn.key, _), "cex.h")) { continue; }
+            arr$push(sctx.src_files, src_fn.key);
+        }
+        u32 n_files = arr$len(sctx.src_files);
+        sctx.results = mem$calloc(_, n_files + 1, sizeof(_cexy__file_stats_s));
+        e$ret(_cexy__parallel_for(n_files, _cexy__stats_file, &sctx));
 
-            char* basename = os.path.basename(src_fn.key, _);
-            if (str.eq(basename, "cex.h")) { continue; }
+        for (u32 i = 0; i < n_files; i++) {
+            char* src_fn = sctx.src_files[i];
+            _cexy__file_stats_s* fstats = &sctx.results[i];
+
+            char* basename = os.path.basename(src_fn, _);
             struct code_stats* stats = (str.find(basename, "test") != NULL) ? &test_stats
                                                                             : &code_stats;
-
-            mem$scope(tmem$, _)
-            {
-                char* code = io.file.load(src_fn.key, _);
-                if (!code) { return e$raise(Error.os, "Error opening file: '%s'", src_fn); }
-                stats->n_files++;
-
-                if (code[0] != '\0') { stats->n_lines_total++; }
-                CexParser_c lx = CexParser.create(code, 0, false);
-                cex_token_s t;
-
-                u32 last_line = 0;
-                u32 file_loc = 0;
-                while ((t = CexParser.next_token(&lx)).type) {
-                    if (t.type == CexTkn__error) {
-                        return e$raise(
-                            Error.integrity,
-                            "Error parsing file %s, at line: %d, cursor: %d",
-                            src_fn,
-                            lx.line,
-                            (i32)(lx.cur - lx.content)
-                        );
-                    }
-                    switch (t.type) {
-                        case CexTkn__ident:
-                            if (t.value.len >= 6) {
-                                for (usize i = 0; i < t.value.len; i++) {
-                                    t.value.buf[i] = tolower(t.value.buf[i]);
-                                }
-                                if (str.slice.starts_with(t.value, str$s("uassert")) ||
-                                    str.slice.starts_with(t.value, str$s("assert")) ||
-                                    str.slice.starts_with(t.value, str$s("ensure")) ||
-                                    str.slice.starts_with(t.value, str$s("enforce")) ||
-                                    str.slice.starts_with(t.value, str$s("expect")) ||
-                                    str.slice.starts_with(t.value, str$s("e$assert")) ||
-                                    str.slice.starts_with(t.value, str$s("tassert"))) {
-                                    stats->n_asserts++;
-                                }
-                            }
-                            goto def;
-                        case CexTkn__comment_multi: {
-                            for$each (c, t.value.buf, t.value.len) {
-                                if (c == '\n') { stats->n_lines_comments++; }
-                            }
-                        }
-                            fallthrough();
-                        case CexTkn__comment_single:
-                            stats->n_lines_comments++;
-                            break;
-                        case CexTkn__preproc: {
-                            for$each (c, t.value.buf, t.value.len) {
-                                if (c == '\n') {
-                                    stats->n_lines_code++;
-                                    file_loc++;
-                                }
-                            }
-                        }
-                            fallthrough();
-                        default:
-                        def:
-                            if (last_line < lx.line) {
-                                stats->n_lines_code++;
-                                file_loc++;
-                                stats->n_lines_total += (lx.line - last_line);
-                                last_line = lx.line;
-                            }
-                            break;
-                    }
-                }
-                if (verbose) {
-                    char* pcur = str.replace(src_fn.key, os.fs.getcwd(_), ".", _);
-                    io.printf("%5d loc | %s\n", file_loc, pcur);
-                }
+            stats->n_files++;
+            stats->n_asserts += fstats->n_asserts;
+            stats->n_lines_code += fstats->n_lines_code;
+            stats->n_lines_comments += fstats->n_lines_comments;
+            stats->n_lines_total += fstats->n_lines_total;
+
+            if (verbose) {
+                char* pcur = str.replace(src_fn, os.fs.getcwd(_), ".", _);
+                io.printf("%5d loc | %s\n", fstats->n_loc, pcur);
             }
         }
     }
@@ -1553,15 +2703,12 @@ _cexy__display_full_info(
                 if (code == NULL) {
                     return e$raise(Error.not_found, "Error loading: %s\n", src_fn);
                 }
-                arr$(cex_token_s) items = arr$new(items, _);
-
-                CexParser_c lx = CexParser.create(code, 0, true);
-                cex_token_s t;
-                while ((t = CexParser.next_entity(&lx, &items)).type) {
-                    if (t.type == CexTkn__error) { break; }
-                    if (t.type != CexTkn__func_def) { continue; }
-                    cex_decl_s* d = CexParser.decl_parse(&lx, t, items, NULL, _);
-                    if (d == NULL) { continue; }
+                arr$(cex_decl_s*) decls = arr$new(decls, _);
+                e$except_silent (err, _cexy__decls_parse(src_fn, code, NULL, _, &decls)) {
+                    // parsing error, use decls before error
+                }
+                for$each (d, decls) {
+                    if (d->type != CexTkn__func_def) { continue; }
                     if (d->body.buf == NULL) { continue; }
                     if (str.slice.index_of(d->body, name) != -1) {
                         n_used++;
@@ -1702,22 +2849,13 @@ cexy__cmd__help(int argc, char** argv, void* user_ctx)
                 if (code == NULL) {
                     return e$raise(Error.not_found, "Error loading: %s\n", src_fn);
                 }
-                arr$(cex_token_s) items = arr$new(items, _);
                 arr$(cex_decl_s*) all_decls = arr$new(all_decls, _);
                 cex_decl_s* ns_decl = NULL;
 
-                CexParser_c lx = CexParser.create(code, 0, true);
-                cex_token_s t;
-                while ((t = CexParser.next_entity(&lx, &items)).type) {
-                    if (t.type == CexTkn__error) {
-                        log$error("Error parsing: %s at line: %d\n", src_fn, lx.line);
-                        break;
-                    }
-                    cex_decl_s* d = CexParser.decl_parse(&lx, t, items, NULL, arena);
-                    if (d == NULL) { continue; }
-                    arr$push(all_decls, d);
-
-                    d->file = src_fn;
+                e$except (err, _cexy__decls_parse(src_fn, code, NULL, arena, &all_decls)) {
+                    // keep going with decls parsed before error
+                }
+                for$each (d, all_decls) {
                     if (d->type == CexTkn__cex_module_struct || d->type == CexTkn__cex_module_def) {
                         log$trace("Found cex namespace: %s (namespace: %s)\n", src_fn, base_ns);
                         hm$set(cex_ns_map, src_fn, str.clone(base_ns, arena));
@@ -1911,6 +3049,7 @@ cexy__cmd__config(int argc, char** argv, void* user_ctx)
     "* CEX_LOG_LVL               " cex$stringize(CEX_LOG_LVL) "\n"                                             \
     "* cexy$build_dir            " cexy$build_dir "\n"                                             \
     "* cexy$src_dir              " cexy$src_dir "\n"                                             \
+    "* cexy$cache_dir            " cexy$cache_dir "\n"                                             \
     "* cexy$cc                   " cexy$cc "\n"                                                    \
     "* cexy$cc_include           " cex$stringize(cexy$cc_include) "\n"                             \
     "* cexy$cc_args_sanitizer    " cex$stringize(cexy$cc_args_sanitizer) "\n"                                \
@@ -2105,12 +3244,16 @@ cexy__cmd__simple_test(int argc, char** argv, void* user_ctx)
     (void)user_ctx;
     argparse_c cmd_args = {
         .program_name = "./cex",
-        .usage = "test [options] {run,build,create,clean,debug} all|tests/test_file.c [--test-options]",
+        .usage = "test [options] {run,build,create,clean,debug} [-j[N]] all|tests/test_file.c "
+                 "[--test-options]",
         .description = _cexy$cmd_test_help,
         .epilog = _cexy$cmd_test_epilog,
         argparse$opt_list(argparse$opt_help(), ),
     };
 
+    // -j[N] only before the target, the rest of args belongs to the test program
+    u32 n_jobs = 1;
+    e$ret(_cexy__jobs_arg_extract(&argc, argv, 2, &n_jobs));
     e$ret(argparse.parse(&cmd_args, argc, argv));
     char* cmd = argparse.next(&cmd_args);
     char* target = argparse.next(&cmd_args);
@@ -2138,6 +3281,10 @@ cexy__cmd__simple_test(int argc, char** argv, void* user_ctx)
     (void)n_built;
     mem$scope(tmem$, _)
     {
+        os_cmd_pool_c pool = { 0 };
+        if (n_jobs != 1) {
+            e$ret(os.cmd.pool_create(&pool, &(os_cmd_pool_opts_s){ .n_jobs = n_jobs }, _));
+        }
         for$each (test_src, os.fs.find(target, true, _)) {
             char* test_target = cexy.target_make(test_src, cexy$build_dir, ".test", _);
             log$trace("Test src: %s -> %s\n", test_src, test_target);
@@ -2164,15 +3311,26 @@ cexy__cmd__simple_test(int argc, char** argv, void* user_ctx)
 
 
             arr$push(args, NULL);
-            e$ret(os$cmda(args));
+            if (n_jobs == 1) {
+                e$ret(os$cmda(args));
+            } else if (os.cmd.pool_add(&pool, args, arr$len(args))) {
+                break; // fail fast, compiler output is already printed
+            }
             n_built++;
         }
+        if (n_jobs != 1) {
+            Exc err = os.cmd.pool_join(&pool);
+            os.cmd.pool_destroy(&pool);
+            if (err) { return e$raise(err, "Tests building failed"); }
+        }
     }
 
     log$info("Tests building: %d tests processed, %d tests built\n", n_tests, n_built);
     fflush(stdout);
 
-    if (str.match(cmd, "(run|debug)")) {
+    if (str.eq(cmd, "run") && n_jobs != 1) {
+        e$ret(_cexy__test__run_jobs(target, n_jobs, cmd_args.argc, cmd_args.argv));
+    } else if (str.match(cmd, "(run|debug)")) {
         e$ret(cexy.test.run(target, str.eq(cmd, "debug"), cmd_args.argc, cmd_args.argv));
     }
     return EOK;
@@ -2477,10 +3635,21 @@ cexy__cmd__simple_app(int argc, char** argv, void* user_ctx)
     (void)user_ctx;
     argparse_c cmd_args = {
         .program_name = "./cex",
-        .usage = "app [options] {run,build,create,clean,debug} APP_NAME [--app-options app args]",
+        .usage = "app [options] {run,build,create,clean,debug} APP_NAME [--app-options app args]\n"
+                 "app [options] build [-j[N]] APP_NAME [APP_NAME2 ...]",
         argparse$opt_list(argparse$opt_help(), ),
     };
 
+    // -j[N] for `build` may be anywhere, for other commands only before APP_NAME (app args follow)
+    bool is_build = false;
+    for (int i = 1; i < argc; i++) {
+        if (argv[i][0] != '-') {
+            is_build = str.eq(argv[i], "build");
+            break;
+        }
+    }
+    u32 n_jobs = 1;
+    e$ret(_cexy__jobs_arg_extract(&argc, argv, (is_build) ? 0 : 2, &n_jobs));
     e$ret(argparse.parse(&cmd_args, argc, argv));
     char* cmd = argparse.next(&cmd_args);
     char* target = argparse.next(&cmd_args);
@@ -2501,35 +3670,58 @@ cexy__cmd__simple_app(int argc, char** argv, void* user_ctx)
 
     mem$scope(tmem$, _)
     {
-        char* app_src;
-        e$ret(cexy.app.find_app_target_src(_, target, &app_src));
-        char* app_exec = cexy.target_make(app_src, cexy$build_dir, target, _);
-        log$trace("App src: %s -> %s\n", target, app_exec);
-        if (!cexy.src_include_changed(app_exec, app_src, NULL)) { goto run; }
-        arr$(char*) args = arr$new(args, _);
-        arr$pushm(args, cexy$cc, );
-        // NOTE: reconstructing char*[] because some cexy$ variables might be empty
-        char* cc_args[] = { cexy$cc_args };
-        char* cc_include[] = { cexy$cc_include };
-        char* ld_args[] = { cexy$ld_args };
-        char* pkgconf_libargs[] = { cexy$pkgconf_libs };
-        arr$pusha(args, cc_args);
-        arr$pusha(args, cc_include);
-        if (arr$len(pkgconf_libargs)) {
-            e$ret(cexy$pkgconf(_, &args, "--cflags", cexy$pkgconf_libs));
+        os_cmd_pool_c pool = { 0 };
+        if (n_jobs != 1) {
+            e$ret(os.cmd.pool_create(&pool, &(os_cmd_pool_opts_s){ .n_jobs = n_jobs }, _));
         }
-        arr$push(args, (char*)app_src);
-        arr$pusha(args, ld_args);
-        if (arr$len(pkgconf_libargs)) {
-            e$ret(cexy$pkgconf(_, &args, "--libs", cexy$pkgconf_libs));
-        }
-        arr$pushm(args, "-o", app_exec);
+        Exc err = EOK;
+        char* app_name = target;
+        do {
+            char* app_src;
+            err = cexy.app.find_app_target_src(_, app_name, &app_src);
+            if (err) { break; }
+            char* app_exec = cexy.target_make(app_src, cexy$build_dir, app_name, _);
+            log$trace("App src: %s -> %s\n", app_name, app_exec);
+            if (!cexy.src_include_changed(app_exec, app_src, NULL)) { continue; }
+            arr$(char*) args = arr$new(args, _);
+            arr$pushm(args, cexy$cc, );
+            // NOTE: reconstructing char*[] because some cexy$ variables might be empty
+            char* cc_args[] = { cexy$cc_args };
+            char* cc_include[] = { cexy$cc_include };
+            char* ld_args[] = { cexy$ld_args };
+            char* pkgconf_libargs[] = { cexy$pkgconf_libs };
+            arr$pusha(args, cc_args);
+            arr$pusha(args, cc_include);
+            if (arr$len(pkgconf_libargs)) {
+                err = cexy$pkgconf(_, &args, "--cflags", cexy$pkgconf_libs);
+                if (err) { break; }
+            }
+            arr$push(args, (char*)app_src);
+            arr$pusha(args, ld_args);
+            if (arr$len(pkgconf_libargs)) {
+                err = cexy$pkgconf(_, &args, "--libs", cexy$pkgconf_libs);
+                if (err) { break; }
+            }
+            arr$pushm(args, "-o", app_exec);
 
 
-        arr$push(args, NULL);
-        e$ret(os$cmda(args));
+            arr$push(args, NULL);
+            if (n_jobs == 1) {
+                err = os$cmda(args);
+            } else {
+                err = os.cmd.pool_add(&pool, args, arr$len(args));
+            }
+            if (err) { break; }
+            // `build` accepts many app names, e.g. ./cex app build -j app1 app2 app3
+        } while (str.eq(cmd, "build") && (app_name = argparse.next(&cmd_args)));
+
+        if (n_jobs != 1) {
+            Exc join_err = os.cmd.pool_join(&pool);
+            if (err == EOK) { err = join_err; }
+            os.cmd.pool_destroy(&pool);
+        }
+        if (err) { return err; }
 
-    run:
         if (str.match(cmd, "(run|debug)")) {
             e$ret(cexy.app.run(target, str.eq(cmd, "debug"), cmd_args.argc, cmd_args.argv));
         }
@@ -3146,6 +4338,7 @@ const struct __cex_namespace__cexy cexy = {
     .utils = {
         .git_hash = cexy__utils__git_hash,
         .git_lib_fetch = cexy__utils__git_lib_fetch,
+        .json_codegen = cexy__utils__json_codegen,
         .make_compile_flags = cexy__utils__make_compile_flags,
         .make_new_project = cexy__utils__make_new_project,
         .pkgconf = cexy__utils__pkgconf,
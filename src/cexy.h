@@ -36,6 +36,16 @@
 #        define cexy$src_dir "./src"
 #    endif
 
+#    ifndef cexy$cache_dir
+/// Directory for parsed source cache of help/process/stats, "" - disables cache (may be overridden by user)
+#        define cexy$cache_dir cexy$build_dir "/.cexy_cache"
+#    endif
+
+#    ifndef cexy$parallel_jobs
+/// Number of worker threads for project-wide stats/process, 0 - use all CPU cores (may be overridden by user)
+#        define cexy$parallel_jobs 0
+#    endif
+
 #    ifndef cexy$create_compile_flags
 /// If 1 creates `compile_flags.txt` in project dir at every ./cex run, 0 - ignores creation (default: 1)
 #       define cexy$create_compile_flags 1
@@ -274,11 +284,14 @@ See `cex help str.match` for more information about patter syntax.
         "cex test debug tests/test_file.c         - run test via `cexy$debug_cmd` program\n"\
         "cex test clean all                       - delete all test executables in `cexy$build_dir`\n"\
         "cex test clean test/test_file.c          - delete specific test executable\n"\
-        "cex test run tests/test_file.c [--help]  - run test with passing arguments to the test runner program\n"
+        "cex test run tests/test_file.c [--help]  - run test with passing arguments to the test runner program\n"\
+        "cex test run -j16 all                    - build and run tests using up to 16 parallel jobs\n"\
+        "cex test run -j all                      - build and run tests using all CPU cores\n"
 
 
 // clang-format on
-struct __cex_namespace__cexy {
+struct __cex_namespace__cexy
+{
     // Autogenerated by CEX
     // clang-format off
 
@@ -320,6 +333,11 @@ struct __cex_namespace__cexy {
     struct {
         char*           (*git_hash)(IAllocator allc);
         Exception       (*git_lib_fetch)(char* git_url, char* git_label, char* out_dir, bool update_existing, bool preserve_dirs, char** repo_paths, usize repo_paths_len);
+        /// Generates JSON decoders/encoders for typedef structs marked by `@json` in docs comment of
+        /// header_file. Output file has <type>_json_decode(jr_c*, <type>*, IAllocator) and
+        /// <type>_json_encode(jw_c*, <type>*) functions, it must be included after lib/json/json.c and
+        /// the header. Supported fields: bool, ints, floats, char*, char[N], str_s, and @json structs.
+        Exception       (*json_codegen)(char* header_file, char* out_file);
         Exception       (*make_compile_flags)(char* flags_file, bool include_cexy_flags, arr$(char*) cc_flags_or_null);
         Exception       (*make_new_project)(char* proj_dir);
         Exception       (*pkgconf)(IAllocator allc, arr$(char*)* out_cc_args, char** pkgconf_args, usize pkgconf_args_len);
@@ -329,5 +347,4 @@ struct __cex_namespace__cexy {
 };
 #endif // #if defined(CEX_BUILD)
 CEX_NAMESPACE struct __cex_namespace__cexy cexy;
-
 #endif
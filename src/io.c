@@ -12,10 +12,26 @@
 #elif cex$is_freestanding
 // does not support unistd.h
 #else
+#    include <fcntl.h>
+#    include <sys/mman.h>
 #    include <sys/stat.h>
+#    include <sys/uio.h>
 #    include <unistd.h>
 #endif
 
+#if defined(__linux__) && !cex$is_freestanding && defined(__has_include)
+#    if __has_include(<linux/io_uring.h>)
+#        include <linux/io_uring.h>
+#        include <sys/syscall.h>
+// NOTE: 5.1-5.5 uapi headers lack IORING_OP_OPENAT/open_flags (no macro for op enums, but
+// IORING_FEAT_RW_CUR_POS comes with them in 5.6), synchronous/threads backend is used there
+#        if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter) &&                       \
+            defined(IORING_FEAT_RW_CUR_POS)
+#            define _CEX_IO_HAS_URING 1
+#        endif
+#    endif
+#endif
+
 /// Opens new file: io.fopen(&file, "file.txt", "r+")
 Exception
 cex_io_fopen(FILE** file, char* filename, char* mode)
@@ -522,6 +538,301 @@ end:
     return out_content.buf;
 }
 
+/// Creates buffered line reader for a file, buf_size=0 uses CEX_IO_LINES_BUF. Nothing is allocated
+/// until the first line read.
+io_lines_c
+cex_io__lines__create(FILE* file, usize buf_size, IAllocator allocator)
+{
+    uassert(allocator != NULL);
+    io_lines_c self = {
+        .file = file,
+        .buf_size = (buf_size > 0) ? buf_size : CEX_IO_LINES_BUF,
+        .allocator = allocator,
+    };
+    if (unlikely(file == NULL)) { self.err = Error.argument; }
+    return self;
+}
+
+/// Destroys line reader buffer (file is not closed)
+void
+cex_io__lines__destroy(io_lines_c* self)
+{
+    uassert(self != NULL);
+    if (self->buf != NULL) { mem$free(self->allocator, self->buf); }
+    *self = (io_lines_c){ 0 };
+}
+
+// Moves unread tail to the beginning of buffer (grows it if the line is longer) and reads more
+static Exception
+_cex_io__lines_refill(io_lines_c* self)
+{
+    if (self->buf == NULL) {
+        self->buf = mem$malloc(self->allocator, self->buf_size);
+        if (self->buf == NULL) { return Error.memory; }
+    }
+    usize tail_len = self->end - self->start;
+    if (self->start > 0) {
+        if (tail_len > 0) { memmove(self->buf, self->buf + self->start, tail_len); }
+        self->scan -= self->start;
+        self->start = 0;
+        self->end = tail_len;
+    }
+    if (self->end == self->buf_size) {
+        // the line doesn't fit, grow the buffer
+        if (unlikely(self->buf_size > PTRDIFF_MAX / 2)) { return Error.overflow; }
+        char* new_buf = mem$realloc(self->allocator, self->buf, self->buf_size * 2);
+        if (new_buf == NULL) { return Error.memory; }
+        self->buf = new_buf;
+        self->buf_size *= 2;
+    }
+
+    usize nread = fread(self->buf + self->end, 1, self->buf_size - self->end, self->file);
+    if (nread == 0) {
+        if (ferror(self->file)) { return Error.io; }
+        self->eof = true;
+    }
+    self->end += nread;
+    return EOK;
+}
+
+/// Reads next line into `line` slice (valid until the next call), returns Error.eof at the end.
+/// `\r\n` line endings are stripped, line length is not limited by the buffer size.
+Exception
+cex_io__lines__next(io_lines_c* self, str_s* line)
+{
+    uassert(self != NULL);
+    uassert(line != NULL);
+    *line = (str_s){ 0 };
+    if (unlikely(self->err)) { return self->err; }
+
+    while (true) {
+        if (self->scan < self->end) {
+            char* nl = memchr(self->buf + self->scan, '\n', self->end - self->scan);
+            if (nl != NULL) {
+                usize line_end = nl - self->buf;
+                usize len = line_end - self->start;
+                if (len > 0 && self->buf[line_end - 1] == '\r') { len--; }
+                *line = (str_s){ .buf = self->buf + self->start, .len = len };
+                self->start = self->scan = line_end + 1;
+                self->n_lines++;
+                return EOK;
+            }
+            self->scan = self->end;
+        }
+        if (self->eof) {
+            if (self->start == self->end) { return Error.eof; }
+            // last line without trailing newline
+            usize len = self->end - self->start;
+            if (self->buf[self->end - 1] == '\r') { len--; }
+            *line = (str_s){ .buf = self->buf + self->start, .len = len };
+            self->start = self->scan = self->end;
+            self->n_lines++;
+            return EOK;
+        }
+        e$except_silent (err, _cex_io__lines_refill(self)) {
+            self->err = err;
+            return err;
+        }
+    }
+}
+
+/// Iterates over file lines: for$iter (str_s, it, io.lines.iter(&lr, &it.iterator)), it.val is
+/// valid until the next iteration. Check io.lines.validate() after the loop for errors.
+str_s
+cex_io__lines__iter(io_lines_c* self, cex_iterator_s* iterator)
+{
+    uassert(self != NULL);
+    uassert(iterator != NULL && "null iterator");
+
+    if (unlikely(!iterator->initialized)) {
+        iterator->initialized = 1;
+        iterator->idx.i = 0;
+    } else {
+        iterator->idx.i++;
+    }
+    str_s line;
+    if (cex_io__lines__next(self, &line) != EOK) {
+        iterator->stopped = 1;
+        return (str_s){ 0 };
+    }
+    return line;
+}
+
+/// Returns sticky error of the line reader, EOK if there was no error (end of file is not an error)
+Exception
+cex_io__lines__validate(io_lines_c* self)
+{
+    uassert(self != NULL);
+    return self->err;
+}
+
+static Exception
+_cex_io__file__mmap_fallback(char* path, io_mmap_s* out)
+{
+    FILE* file;
+    e$except_silent (err, cex_io_fopen(&file, path, "rb")) { return err; }
+    str_s content = { 0 };
+    Exc err = cex_io_fread_all(file, &content, mem$);
+    cex_io_fclose(&file);
+    if (err) { return err; }
+    if (content.buf) {
+        out->data = content;
+        out->_is_copy = true;
+    }
+    return EOK;
+}
+
+/// Maps full file contents into memory (read-only, or private copy-on-write with flags.is_private),
+/// flags can be NULL. Falls back to reading the file into mem$ buffer where mmap is not available.
+/// Result must be released by io.file.munmap().
+Exception
+cex_io__file__mmap(char* path, io_mmap_s* out, io_mmap_flags_s* flags)
+{
+    uassert(out != NULL);
+    *out = (io_mmap_s){ .data = { .buf = "", .len = 0 } };
+    if (path == NULL) { return Error.argument; }
+    io_mmap_flags_s f = (flags) ? *flags : (io_mmap_flags_s){ 0 };
+
+#if defined(_WIN32)
+    DWORD fattr = FILE_ATTRIBUTE_NORMAL | ((f.sequential) ? FILE_FLAG_SEQUENTIAL_SCAN : 0);
+    HANDLE fh = CreateFileA(
+        path,
+        GENERIC_READ,
+        FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+        NULL,
+        OPEN_EXISTING,
+        fattr,
+        NULL
+    );
+    if (fh == INVALID_HANDLE_VALUE) {
+        switch (GetLastError()) {
+            case ERROR_FILE_NOT_FOUND:
+            case ERROR_PATH_NOT_FOUND:
+                return Error.not_found;
+            case ERROR_ACCESS_DENIED:
+                return Error.permission;
+            default:
+                return Error.io;
+        }
+    }
+    LARGE_INTEGER fsize = { 0 };
+    if (!GetFileSizeEx(fh, &fsize)) {
+        CloseHandle(fh);
+        return Error.io;
+    }
+    if (fsize.QuadPart == 0) {
+        CloseHandle(fh);
+        return EOK;
+    }
+    if ((u64)fsize.QuadPart > (u64)SIZE_MAX) {
+        CloseHandle(fh);
+        return Error.overflow;
+    }
+    HANDLE mh = CreateFileMappingA(fh, NULL, (f.is_private) ? PAGE_WRITECOPY : PAGE_READONLY, 0, 0, NULL);
+    void* addr = NULL;
+    if (mh != NULL) {
+        addr = MapViewOfFile(mh, (f.is_private) ? FILE_MAP_COPY : FILE_MAP_READ, 0, 0, 0);
+        CloseHandle(mh); // view keeps mapping alive
+    }
+    CloseHandle(fh);
+    if (addr == NULL) {
+        if (f.no_fallback) { return Error.io; }
+        return _cex_io__file__mmap_fallback(path, out);
+    }
+    if (f.willneed) {
+        WIN32_MEMORY_RANGE_ENTRY range = { .VirtualAddress = addr, .NumberOfBytes = fsize.QuadPart };
+        PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+    }
+    out->_addr = addr;
+    out->_map_len = fsize.QuadPart;
+    out->data = (str_s){ .buf = addr, .len = fsize.QuadPart };
+    return EOK;
+
+#elif cex$is_freestanding
+    if (f.no_fallback) { return Error.os; }
+    return _cex_io__file__mmap_fallback(path, out);
+
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        switch (errno) {
+            case ENOENT:
+                return Error.not_found;
+            case EACCES:
+                return Error.permission;
+            default:
+                return strerror(errno);
+        }
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return strerror(errno);
+    }
+    if (S_ISDIR(st.st_mode)) {
+        close(fd);
+        return Error.argument;
+    }
+    if (!S_ISREG(st.st_mode) || st.st_size == 0) {
+        // pipes, devices, or procfs files (reported as zero size) can't be mapped, read them
+        close(fd);
+        if (f.no_fallback) { return (st.st_size == 0 && S_ISREG(st.st_mode)) ? EOK : Error.os; }
+        return _cex_io__file__mmap_fallback(path, out);
+    }
+    if ((u64)st.st_size > (u64)SIZE_MAX) {
+        close(fd);
+        return Error.overflow;
+    }
+    usize map_len = st.st_size;
+    void* addr = mmap(
+        NULL,
+        map_len,
+        (f.is_private) ? (PROT_READ | PROT_WRITE) : PROT_READ,
+        (f.is_private) ? MAP_PRIVATE : MAP_SHARED,
+        fd,
+        0
+    );
+    close(fd); // mapping keeps file reference
+    if (addr == MAP_FAILED) {
+        if (f.no_fallback) { return strerror(errno); }
+        return _cex_io__file__mmap_fallback(path, out);
+    }
+
+    // NOTE: hints are optional, errors are ignored
+#    if defined(MADV_SEQUENTIAL)
+    if (f.sequential) { (void)madvise(addr, map_len, MADV_SEQUENTIAL); }
+#    endif
+#    if defined(MADV_WILLNEED)
+    if (f.willneed) { (void)madvise(addr, map_len, MADV_WILLNEED); }
+#    endif
+#    if defined(MADV_HUGEPAGE)
+    if (f.hugepage) { (void)madvise(addr, map_len, MADV_HUGEPAGE); }
+#    endif
+
+    out->_addr = addr;
+    out->_map_len = map_len;
+    out->data = (str_s){ .buf = addr, .len = map_len };
+    return EOK;
+#endif
+}
+
+/// Releases memory mapped file, created by io.file.mmap() (safe to call multiple times)
+void
+cex_io__file__munmap(io_mmap_s* m)
+{
+    uassert(m != NULL);
+    if (m->_is_copy) {
+        mem$free(mem$, m->data.buf);
+    } else if (m->_addr != NULL) {
+#if defined(_WIN32)
+        UnmapViewOfFile(m->_addr);
+#elif !cex$is_freestanding
+        munmap(m->_addr, m->_map_len);
+#endif
+    }
+    *m = (io_mmap_s){ .data = { .buf = "", .len = 0 } };
+}
+
 /// Reads line from file, allocates result. Returns NULL on error.
 char*
 cex_io__file__readln(FILE* file, IAllocator allc)
@@ -543,6 +854,971 @@ cex_io__file__readln(FILE* file, IAllocator allc)
     return out_content.buf;
 }
 
+/*
+ *                  IO ASYNC
+ */
+typedef struct _cex_io_async_slot_s
+{
+    u64 tag;
+    u64 offset;
+    void* buf;
+    usize len;
+    char* path; // owned copy (open only)
+    isize result;
+    Exc err;
+    int fd;
+    int flags;
+    i32 buf_idx; // index of registered pool buffer, or -1
+    IOAsyncOp_e op;
+} _cex_io_async_slot_s;
+
+typedef struct _cex_io_async_s
+{
+    IAllocator allc;
+    u32 qd; // power of 2
+    _cex_io_async_slot_s* slots;
+    u32* free_slots;
+    u32 n_free_slots;
+    u32* staged; // queued, but not submitted yet
+    u32 n_staged;
+
+    char* pool;
+    u32 n_buffers;
+    u32 buf_size;
+    u32* free_bufs;
+    u32 n_free_bufs;
+
+    // portable backend: work queue and completion queue rings (slot indexes)
+    u32* work;
+    u32 work_head;
+    u32 work_tail;
+    u32* done;
+    u32 done_head;
+    u32 done_tail;
+    u32 n_threads;
+    bool shutdown;
+#if defined(CEX_HAS_THREADS)
+    _cex_thread_t* threads;
+#    ifdef _WIN32
+    SRWLOCK lock;
+    CONDITION_VARIABLE cond_work;
+    CONDITION_VARIABLE cond_done;
+#    else
+    pthread_mutex_t lock;
+    pthread_cond_t cond_work;
+    pthread_cond_t cond_done;
+#    endif
+#endif
+
+#if defined(_CEX_IO_HAS_URING)
+    int ring_fd;
+    bool is_uring;
+    bool bufs_registered;
+    void* ring;
+    usize ring_size;
+    struct io_uring_sqe* sqes;
+    usize sqes_size;
+    u32* sq_head;
+    u32* sq_tail;
+    u32* sq_mask;
+    u32* sq_array;
+    u32* cq_head;
+    u32* cq_tail;
+    u32* cq_mask;
+    struct io_uring_cqe* cqes;
+#endif
+} _cex_io_async_s;
+
+static Exc
+_cex_io__errno(int err)
+{
+    switch (err) {
+        case ENOENT:
+            return Error.not_found;
+        case EPERM:
+        case EACCES:
+            return Error.permission;
+        case EEXIST:
+            return Error.exists;
+        case EIO:
+            return Error.io;
+        case EAGAIN:
+            return Error.try_again;
+        case EBADF:
+        case EINVAL:
+            return Error.argument;
+        default:
+            return strerror(err);
+    }
+}
+
+// Executes slot operation synchronously (portable backend)
+static void
+_cex_io__async_exec(_cex_io_async_slot_s* slot)
+{
+    isize res = -1;
+    errno = 0;
+#if defined(_WIN32)
+    switch (slot->op) {
+        case IOAsyncOp__open:
+            res = _open(slot->path, slot->flags | _O_BINARY, _S_IREAD | _S_IWRITE);
+            break;
+        case IOAsyncOp__read:
+        case IOAsyncOp__write: {
+            HANDLE fh = (HANDLE)_get_osfhandle(slot->fd);
+            if (fh == INVALID_HANDLE_VALUE) {
+                errno = EBADF;
+                break;
+            }
+            DWORD nbytes = 0;
+            DWORD len = (slot->len > UINT32_MAX) ? UINT32_MAX : (DWORD)slot->len;
+            OVERLAPPED ov = { .Offset = (DWORD)slot->offset,
+                              .OffsetHigh = (DWORD)(slot->offset >> 32) };
+            OVERLAPPED* pov = (slot->offset == (u64)-1) ? NULL : &ov;
+            BOOL ok = (slot->op == IOAsyncOp__read)
+                        ? ReadFile(fh, slot->buf, len, &nbytes, pov)
+                        : WriteFile(fh, slot->buf, len, &nbytes, pov);
+            if (ok || GetLastError() == ERROR_HANDLE_EOF) {
+                res = nbytes;
+            } else {
+                errno = EIO;
+            }
+            break;
+        }
+        case IOAsyncOp__fsync:
+            res = _commit(slot->fd);
+            break;
+        case IOAsyncOp__close:
+            res = _close(slot->fd);
+            break;
+        default:
+            res = 0;
+            break;
+    }
+#elif cex$is_freestanding
+    errno = ENOSYS;
+#else
+    switch (slot->op) {
+        case IOAsyncOp__open:
+            res = open(slot->path, slot->flags, 0644);
+            break;
+        case IOAsyncOp__read:
+            res = (slot->offset == (u64)-1) ? read(slot->fd, slot->buf, slot->len)
+                                            : pread(slot->fd, slot->buf, slot->len, slot->offset);
+            break;
+        case IOAsyncOp__write:
+            res = (slot->offset == (u64)-1) ? write(slot->fd, slot->buf, slot->len)
+                                            : pwrite(slot->fd, slot->buf, slot->len, slot->offset);
+            break;
+        case IOAsyncOp__fsync:
+            res = fsync(slot->fd);
+            break;
+        case IOAsyncOp__close:
+            res = close(slot->fd);
+            break;
+        default:
+            res = 0;
+            break;
+    }
+#endif
+    if (res < 0) {
+        slot->result = -1;
+        slot->err = _cex_io__errno(errno ? errno : EIO);
+    } else {
+        slot->result = res;
+        slot->err = EOK;
+    }
+}
+
+#if defined(CEX_HAS_THREADS)
+#    ifdef _WIN32
+#        define _cex_io__async_lock(a) AcquireSRWLockExclusive(&(a)->lock)
+#        define _cex_io__async_unlock(a) ReleaseSRWLockExclusive(&(a)->lock)
+#        define _cex_io__async_cond_wait(a, cond) SleepConditionVariableSRW(&(a)->cond, &(a)->lock, INFINITE, 0)
+#        define _cex_io__async_cond_signal(a, cond) WakeConditionVariable(&(a)->cond)
+#        define _cex_io__async_cond_broadcast(a, cond) WakeAllConditionVariable(&(a)->cond)
+#    else
+#        define _cex_io__async_lock(a) pthread_mutex_lock(&(a)->lock)
+#        define _cex_io__async_unlock(a) pthread_mutex_unlock(&(a)->lock)
+#        define _cex_io__async_cond_wait(a, cond) pthread_cond_wait(&(a)->cond, &(a)->lock)
+#        define _cex_io__async_cond_signal(a, cond) pthread_cond_signal(&(a)->cond)
+#        define _cex_io__async_cond_broadcast(a, cond) pthread_cond_broadcast(&(a)->cond)
+#    endif
+
+static void
+_cex_io__async_worker_loop(_cex_io_async_s* a)
+{
+    _cex_io__async_lock(a);
+    while (true) {
+        while (a->work_head == a->work_tail && !a->shutdown) {
+            _cex_io__async_cond_wait(a, cond_work);
+        }
+        if (a->work_head == a->work_tail) { break; } // shutdown
+        u32 idx = a->work[a->work_head++ & (a->qd - 1)];
+        _cex_io__async_unlock(a);
+
+        _cex_io__async_exec(&a->slots[idx]);
+
+        _cex_io__async_lock(a);
+        a->done[a->done_tail++ & (a->qd - 1)] = idx;
+        _cex_io__async_cond_signal(a, cond_done);
+    }
+    _cex_io__async_unlock(a);
+}
+
+static _cex_thread_fn(_cex_io__async_worker, arg)
+{
+    _cex_io__async_worker_loop(arg);
+    return 0;
+}
+#endif
+
+#if defined(_CEX_IO_HAS_URING)
+static bool
+_cex_io__async_uring_init(_cex_io_async_s* a)
+{
+    struct io_uring_params p = { 0 };
+    int fd = syscall(__NR_io_uring_setup, a->qd, &p);
+    if (fd < 0) { return false; }
+    // NOTE: IORING_FEAT_RW_CUR_POS (5.6) also implies OPENAT/CLOSE/READ/WRITE opcodes
+    if (!(p.features & IORING_FEAT_SINGLE_MMAP) || !(p.features & IORING_FEAT_RW_CUR_POS)) {
+        close(fd);
+        return false;
+    }
+
+    usize sq_size = p.sq_off.array + p.sq_entries * sizeof(u32);
+    usize cq_size = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+    a->ring_size = (sq_size > cq_size) ? sq_size : cq_size;
+    a->ring = mmap(
+        NULL,
+        a->ring_size,
+        PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_POPULATE,
+        fd,
+        IORING_OFF_SQ_RING
+    );
+    if (a->ring == MAP_FAILED) {
+        close(fd);
+        return false;
+    }
+    a->sqes_size = p.sq_entries * sizeof(struct io_uring_sqe);
+    a->sqes = mmap(
+        NULL,
+        a->sqes_size,
+        PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_POPULATE,
+        fd,
+        IORING_OFF_SQES
+    );
+    if (a->sqes == MAP_FAILED) {
+        munmap(a->ring, a->ring_size);
+        close(fd);
+        return false;
+    }
+
+    char* r = a->ring;
+    a->sq_head = (u32*)(r + p.sq_off.head);
+    a->sq_tail = (u32*)(r + p.sq_off.tail);
+    a->sq_mask = (u32*)(r + p.sq_off.ring_mask);
+    a->sq_array = (u32*)(r + p.sq_off.array);
+    a->cq_head = (u32*)(r + p.cq_off.head);
+    a->cq_tail = (u32*)(r + p.cq_off.tail);
+    a->cq_mask = (u32*)(r + p.cq_off.ring_mask);
+    a->cqes = (struct io_uring_cqe*)(r + p.cq_off.cqes);
+    a->ring_fd = fd;
+    a->is_uring = true;
+
+    if (a->n_buffers > 0) {
+        // NOTE: may fail because of RLIMIT_MEMLOCK, then regular read/write are used
+        struct iovec* iov = mem$calloc(a->allc, a->n_buffers, sizeof(struct iovec));
+        if (iov != NULL) {
+            for (u32 i = 0; i < a->n_buffers; i++) {
+                iov[i] = (struct iovec){ .iov_base = a->pool + (usize)i * a->buf_size,
+                                         .iov_len = a->buf_size };
+            }
+            a->bufs_registered = syscall(
+                                     __NR_io_uring_register,
+                                     fd,
+                                     IORING_REGISTER_BUFFERS,
+                                     iov,
+                                     a->n_buffers
+                                 ) == 0;
+            mem$free(a->allc, iov);
+        }
+    }
+    return true;
+}
+
+static Exception
+_cex_io__async_uring_submit(io_async_c* self)
+{
+    _cex_io_async_s* a = self->_impl;
+    u32 tail = *a->sq_tail;
+    u32 mask = *a->sq_mask;
+    for (u32 i = 0; i < a->n_staged; i++) {
+        _cex_io_async_slot_s* slot = &a->slots[a->staged[i]];
+        struct io_uring_sqe* sqe = &a->sqes[tail & mask];
+        memset(sqe, 0, sizeof(*sqe));
+        sqe->user_data = a->staged[i];
+        sqe->fd = slot->fd;
+        switch (slot->op) {
+            case IOAsyncOp__open:
+                sqe->opcode = IORING_OP_OPENAT;
+                sqe->fd = AT_FDCWD;
+                sqe->addr = (u64)(usize)slot->path;
+                sqe->len = 0644;
+                sqe->open_flags = slot->flags;
+                break;
+            case IOAsyncOp__read:
+            case IOAsyncOp__write: {
+                bool is_fixed = a->bufs_registered && slot->buf_idx >= 0;
+                if (slot->op == IOAsyncOp__read) {
+                    sqe->opcode = (is_fixed) ? IORING_OP_READ_FIXED : IORING_OP_READ;
+                } else {
+                    sqe->opcode = (is_fixed) ? IORING_OP_WRITE_FIXED : IORING_OP_WRITE;
+                }
+                if (is_fixed) { sqe->buf_index = slot->buf_idx; }
+                sqe->addr = (u64)(usize)slot->buf;
+                sqe->len = (slot->len > UINT32_MAX) ? UINT32_MAX : slot->len;
+                sqe->off = slot->offset;
+                break;
+            }
+            case IOAsyncOp__fsync:
+                sqe->opcode = IORING_OP_FSYNC;
+                break;
+            case IOAsyncOp__close:
+                sqe->opcode = IORING_OP_CLOSE;
+                break;
+            default:
+                sqe->opcode = IORING_OP_NOP;
+                break;
+        }
+        a->sq_array[tail & mask] = tail & mask;
+        tail++;
+    }
+    __atomic_store_n(a->sq_tail, tail, __ATOMIC_RELEASE);
+
+    u32 n_staged = a->n_staged;
+    u32 to_submit = n_staged;
+    a->n_staged = 0;
+    while (to_submit > 0) {
+        int ret = syscall(__NR_io_uring_enter, a->ring_fd, to_submit, 0, 0, NULL, 0);
+        if (ret < 0) {
+            if (errno == EINTR || errno == EAGAIN || errno == EBUSY) { continue; }
+            Exc err = _cex_io__errno(errno);
+            // Kernel didn't consume the rest of SQEs, taking them back, otherwise they are
+            // counted in n_pending and never complete (io.async.destroy() would wait forever)
+            __atomic_store_n(a->sq_tail, tail - to_submit, __ATOMIC_RELEASE);
+            for (u32 i = n_staged - to_submit; i < n_staged; i++) {
+                _cex_io_async_slot_s* slot = &a->slots[a->staged[i]];
+                if (slot->path) {
+                    mem$free(a->allc, slot->path);
+                    slot->path = NULL;
+                }
+                a->free_slots[a->n_free_slots++] = a->staged[i];
+            }
+            self->n_pending -= to_submit;
+            return err;
+        }
+        to_submit -= ret;
+    }
+    return EOK;
+}
+
+static u32
+_cex_io__async_uring_reap(_cex_io_async_s* a, u32* out_idx, u32 max_n)
+{
+    u32 head = *a->cq_head;
+    u32 tail = __atomic_load_n(a->cq_tail, __ATOMIC_ACQUIRE);
+    u32 mask = *a->cq_mask;
+    u32 n = 0;
+    while (head != tail && n < max_n) {
+        struct io_uring_cqe* cqe = &a->cqes[head & mask];
+        _cex_io_async_slot_s* slot = &a->slots[cqe->user_data];
+        if (cqe->res < 0) {
+            slot->result = -1;
+            slot->err = _cex_io__errno(-cqe->res);
+        } else {
+            slot->result = cqe->res;
+            slot->err = EOK;
+        }
+        out_idx[n++] = cqe->user_data;
+        head++;
+    }
+    __atomic_store_n(a->cq_head, head, __ATOMIC_RELEASE);
+    return n;
+}
+#endif
+
+void cex_io__async__destroy(io_async_c* self);
+Exception cex_io__async__wait(
+    io_async_c* self,
+    io_async_cqe_s* cqes,
+    u32 max_cqes,
+    u32 min_complete,
+    u32* n_done
+);
+
+/// Creates async IO engine, opts can be NULL (defaults). Uses io_uring on Linux when available,
+/// otherwise portable worker threads backend. Must be released by io.async.destroy().
+Exception
+cex_io__async__create(io_async_c* self, io_async_opts_s* opts, IAllocator allc)
+{
+    uassert(self != NULL);
+    uassert(allc != NULL);
+    *self = (io_async_c){ 0 };
+    io_async_opts_s o = (opts) ? *opts : (io_async_opts_s){ 0 };
+    if (o.queue_depth == 0) { o.queue_depth = 64; }
+    if (o.n_threads == 0) { o.n_threads = 4; }
+    if (o.buf_size == 0) { o.buf_size = CEX_IO_LINES_BUF; }
+    if (o.queue_depth > 4096) { return Error.argument; }
+
+    u32 qd = 1;
+    while (qd < o.queue_depth) { qd <<= 1; }
+    if (o.n_threads > qd) { o.n_threads = qd; }
+
+    _cex_io_async_s* a = mem$new(allc, _cex_io_async_s);
+    if (a == NULL) { return Error.memory; }
+    a->allc = allc;
+    a->qd = qd;
+    a->slots = mem$calloc(allc, qd, sizeof(*a->slots));
+    a->free_slots = mem$calloc(allc, qd, sizeof(u32));
+    a->staged = mem$calloc(allc, qd, sizeof(u32));
+    a->work = mem$calloc(allc, qd, sizeof(u32));
+    a->done = mem$calloc(allc, qd, sizeof(u32));
+    self->_impl = a;
+    if (!a->slots || !a->free_slots || !a->staged || !a->work || !a->done) { goto fail_memory; }
+    for (u32 i = 0; i < qd; i++) { a->free_slots[i] = qd - 1 - i; }
+    a->n_free_slots = qd;
+
+    if (o.n_buffers > 0) {
+        if ((usize)o.n_buffers * o.buf_size > PTRDIFF_MAX) { goto fail_memory; }
+        a->pool = mem$malloc(allc, (usize)o.n_buffers * o.buf_size, 64);
+        a->free_bufs = mem$calloc(allc, o.n_buffers, sizeof(u32));
+        if (!a->pool || !a->free_bufs) { goto fail_memory; }
+        a->n_buffers = o.n_buffers;
+        a->buf_size = o.buf_size;
+        for (u32 i = 0; i < o.n_buffers; i++) { a->free_bufs[i] = o.n_buffers - 1 - i; }
+        a->n_free_bufs = o.n_buffers;
+    }
+
+    self->queue_depth = qd;
+    self->backend = "sync";
+
+#if defined(_CEX_IO_HAS_URING)
+    if (!o.no_uring && _cex_io__async_uring_init(a)) {
+        self->backend = "io_uring";
+        return EOK;
+    }
+#endif
+
+#if defined(CEX_HAS_THREADS)
+    if (!o.no_threads) {
+#    ifdef _WIN32
+        InitializeSRWLock(&a->lock);
+        InitializeConditionVariable(&a->cond_work);
+        InitializeConditionVariable(&a->cond_done);
+#    else
+        pthread_mutex_init(&a->lock, NULL);
+        pthread_cond_init(&a->cond_work, NULL);
+        pthread_cond_init(&a->cond_done, NULL);
+#    endif
+        a->threads = mem$calloc(allc, o.n_threads, sizeof(_cex_thread_t));
+        if (a->threads == NULL) { goto fail_memory; }
+        for (u32 i = 0; i < o.n_threads; i++) {
+            if (!_cex_thread_spawn(&a->threads[i], _cex_io__async_worker, a)) { break; }
+            a->n_threads++;
+        }
+        if (a->n_threads > 0) { self->backend = "threads"; }
+    }
+#endif
+    return EOK;
+
+fail_memory:
+    cex_io__async__destroy(self);
+    return Error.memory;
+}
+
+/// Destroys async IO engine, waits for completion of all pending operations (results are discarded)
+void
+cex_io__async__destroy(io_async_c* self)
+{
+    uassert(self != NULL);
+    _cex_io_async_s* a = self->_impl;
+    if (a == NULL) { return; }
+    IAllocator allc = a->allc;
+
+    if (a->slots != NULL) {
+        io_async_cqe_s cqes[16];
+        while (self->n_pending > 0) {
+            u32 n_done = 0;
+            if (cex_io__async__wait(self, cqes, arr$len(cqes), 1, &n_done)) { break; }
+        }
+    }
+
+#if defined(CEX_HAS_THREADS)
+    if (a->n_threads > 0) {
+        _cex_io__async_lock(a);
+        a->shutdown = true;
+        _cex_io__async_cond_broadcast(a, cond_work);
+        _cex_io__async_unlock(a);
+        for (u32 i = 0; i < a->n_threads; i++) { _cex_thread_join(a->threads[i]); }
+#    ifndef _WIN32
+        pthread_mutex_destroy(&a->lock);
+        pthread_cond_destroy(&a->cond_work);
+        pthread_cond_destroy(&a->cond_done);
+#    endif
+    }
+    if (a->threads) { mem$free(allc, a->threads); }
+#endif
+
+#if defined(_CEX_IO_HAS_URING)
+    if (a->is_uring) {
+        munmap(a->sqes, a->sqes_size);
+        munmap(a->ring, a->ring_size);
+        close(a->ring_fd); // also unregisters buffers
+    }
+#endif
+    if (a->slots) {
+        for (u32 i = 0; i < a->qd; i++) {
+            if (a->slots[i].path) { mem$free(allc, a->slots[i].path); }
+        }
+        mem$free(allc, a->slots);
+    }
+    if (a->free_slots) { mem$free(allc, a->free_slots); }
+    if (a->staged) { mem$free(allc, a->staged); }
+    if (a->work) { mem$free(allc, a->work); }
+    if (a->done) { mem$free(allc, a->done); }
+    if (a->pool) { mem$free(allc, a->pool); }
+    if (a->free_bufs) { mem$free(allc, a->free_bufs); }
+    mem$free(allc, a);
+    *self = (io_async_c){ 0 };
+}
+
+// Reserves operation slot and queues it (until io.async.submit())
+static _cex_io_async_slot_s*
+_cex_io__async_queue(io_async_c* self, IOAsyncOp_e op, int fd, u64 tag)
+{
+    _cex_io_async_s* a = self->_impl;
+    if (a->n_free_slots == 0) { return NULL; }
+    u32 idx = a->free_slots[--a->n_free_slots];
+    _cex_io_async_slot_s* slot = &a->slots[idx];
+    *slot = (_cex_io_async_slot_s){ .tag = tag, .op = op, .fd = fd, .buf_idx = -1 };
+    a->staged[a->n_staged++] = idx;
+    self->n_pending++;
+    return slot;
+}
+
+/// Queues file opening, `mode` is fopen() like ("r", "r+", "w", "w+", "a", "a+", "x" suffix for
+/// exclusive creation), completion result is file descriptor. Returns Error.try_again if queue is full.
+Exception
+cex_io__async__open(io_async_c* self, char* path, char* mode, u64 tag)
+{
+    uassert(self != NULL && self->_impl != NULL);
+    if (path == NULL || mode == NULL) { return Error.argument; }
+
+    int flags = 0;
+    switch (mode[0]) {
+        case 'r':
+            flags = O_RDONLY;
+            break;
+        case 'w':
+            flags = O_WRONLY | O_CREAT | O_TRUNC;
+            break;
+        case 'a':
+            flags = O_WRONLY | O_CREAT | O_APPEND;
+            break;
+        default:
+            return Error.argument;
+    }
+    for (char* c = mode + 1; *c; c++) {
+        switch (*c) {
+            case '+':
+                flags = (flags & ~(O_RDONLY | O_WRONLY)) | O_RDWR;
+                break;
+            case 'x':
+                flags |= O_EXCL;
+                break;
+            case 'b':
+                break;
+            default:
+                return Error.argument;
+        }
+    }
+#ifdef O_CLOEXEC
+    flags |= O_CLOEXEC;
+#endif
+
+    _cex_io_async_s* a = self->_impl;
+    usize path_len = strlen(path);
+    char* path_copy = mem$malloc(a->allc, path_len + 1);
+    if (path_copy == NULL) { return Error.memory; }
+    memcpy(path_copy, path, path_len + 1);
+
+    _cex_io_async_slot_s* slot = _cex_io__async_queue(self, IOAsyncOp__open, -1, tag);
+    if (slot == NULL) {
+        mem$free(a->allc, path_copy);
+        return Error.try_again;
+    }
+    slot->path = path_copy;
+    slot->flags = flags;
+    return EOK;
+}
+
+static Exception
+_cex_io__async_rw(io_async_c* self, IOAsyncOp_e op, int fd, void* buf, usize len, u64 offset, u64 tag)
+{
+    uassert(self != NULL && self->_impl != NULL);
+    if (fd < 0 || buf == NULL) { return Error.argument; }
+    if (len > UINT32_MAX) { return Error.overflow; }
+
+    _cex_io_async_s* a = self->_impl;
+    _cex_io_async_slot_s* slot = _cex_io__async_queue(self, op, fd, tag);
+    if (slot == NULL) { return Error.try_again; }
+    slot->buf = buf;
+    slot->len = len;
+    slot->offset = offset;
+    if (a->pool && (char*)buf >= a->pool &&
+        (char*)buf + len <= a->pool + (usize)a->n_buffers * a->buf_size) {
+        usize buf_idx = ((char*)buf - a->pool) / a->buf_size;
+        // registered buffer requires whole range to be within single pool buffer
+        if ((char*)buf + len <= a->pool + (buf_idx + 1) * a->buf_size) { slot->buf_idx = buf_idx; }
+    }
+    return EOK;
+}
+
+/// Queues reading of up to `len` bytes at file `offset` ((u64)-1 - current file position) into
+/// `buf`, completion result is number of bytes read (0 - EOF).
+Exception
+cex_io__async__read(io_async_c* self, int fd, void* buf, usize len, u64 offset, u64 tag)
+{
+    return _cex_io__async_rw(self, IOAsyncOp__read, fd, buf, len, offset, tag);
+}
+
+/// Queues writing of `len` bytes from `buf` at file `offset` ((u64)-1 - current file position),
+/// completion result is number of bytes written. `buf` must be valid until completion.
+Exception
+cex_io__async__write(io_async_c* self, int fd, void* buf, usize len, u64 offset, u64 tag)
+{
+    return _cex_io__async_rw(self, IOAsyncOp__write, fd, buf, len, offset, tag);
+}
+
+/// Queues flushing of file data to the storage device
+Exception
+cex_io__async__fsync(io_async_c* self, int fd, u64 tag)
+{
+    uassert(self != NULL && self->_impl != NULL);
+    if (fd < 0) { return Error.argument; }
+    if (_cex_io__async_queue(self, IOAsyncOp__fsync, fd, tag) == NULL) { return Error.try_again; }
+    return EOK;
+}
+
+/// Queues closing of file descriptor
+Exception
+cex_io__async__close(io_async_c* self, int fd, u64 tag)
+{
+    uassert(self != NULL && self->_impl != NULL);
+    if (fd < 0) { return Error.argument; }
+    if (_cex_io__async_queue(self, IOAsyncOp__close, fd, tag) == NULL) { return Error.try_again; }
+    return EOK;
+}
+
+/// Submits all queued operations for execution as a single batch (on error, operations which
+/// were not accepted by the kernel are dropped, and not counted in n_pending)
+Exception
+cex_io__async__submit(io_async_c* self)
+{
+    uassert(self != NULL && self->_impl != NULL);
+    _cex_io_async_s* a = self->_impl;
+    if (a->n_staged == 0) { return EOK; }
+
+#if defined(_CEX_IO_HAS_URING)
+    if (a->is_uring) { return _cex_io__async_uring_submit(self); }
+#endif
+#if defined(CEX_HAS_THREADS)
+    if (a->n_threads > 0) {
+        _cex_io__async_lock(a);
+        for (u32 i = 0; i < a->n_staged; i++) { a->work[a->work_tail++ & (a->qd - 1)] = a->staged[i]; }
+        _cex_io__async_cond_broadcast(a, cond_work);
+        _cex_io__async_unlock(a);
+        a->n_staged = 0;
+        return EOK;
+    }
+#endif
+    for (u32 i = 0; i < a->n_staged; i++) {
+        _cex_io__async_exec(&a->slots[a->staged[i]]);
+        a->done[a->done_tail++ & (a->qd - 1)] = a->staged[i];
+    }
+    a->n_staged = 0;
+    return EOK;
+}
+
+/// Submits queued operations, and waits until at least `min_complete` operations are completed
+/// (0 - just polls), returns up to `max_cqes` completions into `cqes`, count is set in `n_done`.
+Exception
+cex_io__async__wait(
+    io_async_c* self,
+    io_async_cqe_s* cqes,
+    u32 max_cqes,
+    u32 min_complete,
+    u32* n_done
+)
+{
+    uassert(self != NULL && self->_impl != NULL);
+    uassert(n_done != NULL);
+    *n_done = 0;
+    if (cqes == NULL || max_cqes == 0) { return Error.argument; }
+    e$ret(cex_io__async__submit(self));
+
+    _cex_io_async_s* a = self->_impl;
+    if (min_complete > self->n_pending) { min_complete = self->n_pending; }
+    if (min_complete > max_cqes) { min_complete = max_cqes; }
+    if (max_cqes > a->qd) { max_cqes = a->qd; }
+    u32* indexes = a->staged; // NOTE: nothing is staged after submit, reusing as temp
+    u32 n = 0;
+
+#if defined(_CEX_IO_HAS_URING)
+    if (a->is_uring) {
+        n = _cex_io__async_uring_reap(a, indexes, max_cqes);
+        while (n < min_complete) {
+            int ret = syscall(
+                __NR_io_uring_enter,
+                a->ring_fd,
+                0,
+                min_complete - n,
+                IORING_ENTER_GETEVENTS,
+                NULL,
+                0
+            );
+            if (ret < 0 && errno != EINTR) {
+                // completions reaped so far are lost otherwise, keep them
+                if (n > 0) { break; }
+                return _cex_io__errno(errno);
+            }
+            n += _cex_io__async_uring_reap(a, indexes + n, max_cqes - n);
+        }
+    } else
+#endif
+    {
+#if defined(CEX_HAS_THREADS)
+        if (a->n_threads > 0) { _cex_io__async_lock(a); }
+        while (a->n_threads > 0 && a->done_tail - a->done_head < min_complete) {
+            _cex_io__async_cond_wait(a, cond_done);
+        }
+#endif
+        while (a->done_head != a->done_tail && n < max_cqes) {
+            indexes[n++] = a->done[a->done_head++ & (a->qd - 1)];
+        }
+#if defined(CEX_HAS_THREADS)
+        if (a->n_threads > 0) { _cex_io__async_unlock(a); }
+#endif
+    }
+
+    for (u32 i = 0; i < n; i++) {
+        _cex_io_async_slot_s* slot = &a->slots[indexes[i]];
+        cqes[i] = (io_async_cqe_s){
+            .tag = slot->tag,
+            .result = slot->result,
+            .err = slot->err,
+            .buf = slot->buf,
+            .op = slot->op,
+        };
+        if (slot->path) { mem$free(a->allc, slot->path); }
+        a->free_slots[a->n_free_slots++] = indexes[i];
+    }
+    self->n_pending -= n;
+    *n_done = n;
+    return EOK;
+}
+
+/// Returns free buffer from the pool (opts.buf_size bytes), NULL if pool is empty or exhausted
+void*
+cex_io__async__buf_get(io_async_c* self)
+{
+    uassert(self != NULL && self->_impl != NULL);
+    _cex_io_async_s* a = self->_impl;
+    if (a->n_free_bufs == 0) { return NULL; }
+    u32 idx = a->free_bufs[--a->n_free_bufs];
+    return a->pool + (usize)idx * a->buf_size;
+}
+
+/// Returns buffer back to the pool
+void
+cex_io__async__buf_put(io_async_c* self, void* buf)
+{
+    uassert(self != NULL && self->_impl != NULL);
+    _cex_io_async_s* a = self->_impl;
+    if (buf == NULL) { return; }
+    uassert((char*)buf >= a->pool && "buffer is not from the pool");
+    usize idx = ((char*)buf - a->pool) / a->buf_size;
+    uassert(idx < a->n_buffers && "buffer is not from the pool");
+    uassert(a->n_free_bufs < a->n_buffers && "double buf_put()?");
+    a->free_bufs[a->n_free_bufs++] = idx;
+}
+
+/// Writes all `bufs` into file descriptor `fd` (gathered by writev() if supported), partial writes
+/// are retried until everything is written. Empty buffers are skipped.
+Exception
+cex_io_writev(int fd, str_s* bufs, usize n_bufs)
+{
+    if (fd < 0) { return Error.argument; }
+    if (bufs == NULL && n_bufs > 0) { return Error.argument; }
+
+#if defined(_WIN32)
+    for (usize i = 0; i < n_bufs; i++) {
+        char* p = bufs[i].buf;
+        usize left = bufs[i].len;
+        while (left > 0) {
+            unsigned int chunk = (left > INT32_MAX) ? INT32_MAX : (unsigned int)left;
+            int n = _write(fd, p, chunk);
+            if (n < 0) { return _cex_io__errno(errno); }
+            p += n;
+            left -= n;
+        }
+    }
+    return EOK;
+#elif cex$is_freestanding
+    (void)bufs;
+    (void)n_bufs;
+    return Error.os;
+#else
+    struct iovec iov[64];
+    usize idx = 0;    // current buffer
+    usize offset = 0; // written bytes of bufs[idx]
+    while (true) {
+        while (idx < n_bufs && bufs[idx].len == offset) {
+            idx++;
+            offset = 0;
+        }
+        if (idx >= n_bufs) { break; }
+
+        u32 n_iov = 0;
+        for (usize i = idx; i < n_bufs && n_iov < arr$len(iov); i++) {
+            usize skip = (i == idx) ? offset : 0;
+            if (bufs[i].len == skip) { continue; }
+            if (unlikely(bufs[i].buf == NULL)) { return Error.argument; }
+            iov[n_iov++] = (struct iovec){ .iov_base = bufs[i].buf + skip,
+                                           .iov_len = bufs[i].len - skip };
+        }
+        isize n = writev(fd, iov, n_iov);
+        if (n < 0) {
+            if (errno == EINTR) { continue; }
+            return _cex_io__errno(errno);
+        }
+        // advance over written bytes
+        usize written = n;
+        while (written > 0) {
+            usize left = bufs[idx].len - offset;
+            if (written < left) {
+                offset += written;
+                break;
+            }
+            written -= left;
+            idx++;
+            offset = 0;
+        }
+    }
+    return EOK;
+#endif
+}
+
+/// Atomically replaces file at `path` with concatenation of `parts` (binary mode). Data is written
+/// into temp file in the same directory and then renamed over `path`, readers never see partial
+/// contents. is_durable=true also syncs data (and directory) to the storage device before return.
+Exception
+cex_io__file__save_atomic(char* path, str_s* parts, usize n_parts, bool is_durable)
+{
+    if (path == NULL || path[0] == '\0') { return Error.argument; }
+    if (parts == NULL && n_parts > 0) { return Error.argument; }
+
+#if cex$is_freestanding
+    (void)is_durable;
+    return Error.os;
+#else
+    static u32 counter = 0;
+    usize path_len = strlen(path);
+    char tmp_path[PATH_MAX]; // no mem$, it's called from worker threads
+    if (path_len + 32 > sizeof(tmp_path)) { return Error.overflow; }
+
+    Exc result = EOK;
+    int fd = -1;
+#    if defined(_WIN32)
+    u32 pid = GetCurrentProcessId();
+#    else
+    u32 pid = getpid();
+#    endif
+    for (u32 attempt = 0; attempt < 16; attempt++) {
+        u32 n = __atomic_fetch_add(&counter, 1, __ATOMIC_RELAXED);
+        memcpy(tmp_path, path, path_len);
+        if (cexsp__snprintf(tmp_path + path_len, 32, ".%x.%x.tmp", pid, n) <= 0) {
+            result = Error.overflow;
+            goto end;
+        }
+#    if defined(_WIN32)
+        fd = _open(tmp_path, _O_CREAT | _O_EXCL | _O_WRONLY | _O_BINARY, _S_IREAD | _S_IWRITE);
+#    else
+        fd = open(tmp_path, O_CREAT | O_EXCL | O_WRONLY | O_CLOEXEC, 0666);
+#    endif
+        if (fd >= 0 || errno != EEXIST) { break; }
+    }
+    if (fd < 0) {
+        result = _cex_io__errno(errno);
+        goto end;
+    }
+
+#    if !defined(_WIN32)
+    // replaced file keeps its permissions
+    struct stat st;
+    if (stat(path, &st) == 0) { (void)fchmod(fd, st.st_mode & 07777); }
+#    endif
+
+    e$except_silent (err, cex_io_writev(fd, parts, n_parts)) { result = err; }
+
+    if (!result && is_durable) {
+#    if defined(_WIN32)
+        if (_commit(fd) != 0) { result = _cex_io__errno(errno); }
+#    elif defined(__APPLE__)
+        if (fcntl(fd, F_FULLFSYNC) != 0 && fsync(fd) != 0) { result = _cex_io__errno(errno); }
+#    else
+        if (fdatasync(fd) != 0) { result = _cex_io__errno(errno); }
+#    endif
+    }
+#    if defined(_WIN32)
+    if (_close(fd) != 0 && !result) { result = _cex_io__errno(errno); }
+    if (!result) {
+        DWORD flags = MOVEFILE_REPLACE_EXISTING | ((is_durable) ? MOVEFILE_WRITE_THROUGH : 0);
+        if (!MoveFileExA(tmp_path, path, flags)) { result = Error.io; }
+    }
+    if (result) { _unlink(tmp_path); }
+#    else
+    if (close(fd) != 0 && !result) { result = _cex_io__errno(errno); }
+    if (!result && rename(tmp_path, path) != 0) { result = _cex_io__errno(errno); }
+    if (result) {
+        (void)unlink(tmp_path);
+    } else if (is_durable) {
+        // makes rename itself durable
+        char* dir_end = strrchr(path, '/');
+        if (dir_end == path) {
+            memcpy(tmp_path, "/", 2);
+        } else if (dir_end == NULL) {
+            memcpy(tmp_path, ".", 2);
+        } else {
+            memcpy(tmp_path, path, dir_end - path);
+            tmp_path[dir_end - path] = '\0';
+        }
+        int dir_fd = open(tmp_path, O_RDONLY | O_CLOEXEC);
+        if (dir_fd >= 0) {
+            if (fsync(dir_fd) != 0 && errno != EINVAL) { result = _cex_io__errno(errno); }
+            close(dir_fd);
+        }
+    }
+#    endif
+
+end:
+    return result;
+#endif
+}
+
 const struct __cex_namespace__io io = {
     // Autogenerated by CEX
     // clang-format off
@@ -560,16 +1836,41 @@ const struct __cex_namespace__io io = {
     .isatty = cex_io_isatty,
     .printf = cex_io_printf,
     .rewind = cex_io_rewind,
+    .writev = cex_io_writev,
+
+    .async = {
+        .buf_get = cex_io__async__buf_get,
+        .buf_put = cex_io__async__buf_put,
+        .close = cex_io__async__close,
+        .create = cex_io__async__create,
+        .destroy = cex_io__async__destroy,
+        .fsync = cex_io__async__fsync,
+        .open = cex_io__async__open,
+        .read = cex_io__async__read,
+        .submit = cex_io__async__submit,
+        .wait = cex_io__async__wait,
+        .write = cex_io__async__write,
+    },
 
     .file = {
         .load = cex_io__file__load,
+        .mmap = cex_io__file__mmap,
+        .munmap = cex_io__file__munmap,
         .readln = cex_io__file__readln,
         .save = cex_io__file__save,
+        .save_atomic = cex_io__file__save_atomic,
         .size = cex_io__file__size,
         .writeln = cex_io__file__writeln,
     },
 
+    .lines = {
+        .create = cex_io__lines__create,
+        .destroy = cex_io__lines__destroy,
+        .iter = cex_io__lines__iter,
+        .next = cex_io__lines__next,
+        .validate = cex_io__lines__validate,
+    },
+
     // clang-format on
 };
-
 #endif
@@ -5,6 +5,86 @@
 /// Makes string literal with ansi colored test
 #define io$ansi(text, ansi_col) "\033[" ansi_col "m" text "\033[0m"
 
+#ifndef CEX_IO_LINES_BUF
+#    define CEX_IO_LINES_BUF (1024 * 64) // default refill buffer size of io.lines
+#endif
+
+/// Buffered line reader, lines are yielded as slices of internal buffer (see io.lines)
+typedef struct io_lines_c
+{
+    FILE* file;
+    char* buf;
+    usize buf_size;
+    usize start; // beginning of the next line in buf
+    usize scan;  // buf position where next newline search starts
+    usize end;   // end of data in buf
+    u64 n_lines;
+    const Allocator_i* allocator;
+    Exc err;
+    bool eof;
+} io_lines_c;
+
+/// Flags for io.file.mmap()
+typedef struct io_mmap_flags_s
+{
+    u32 is_private : 1;  // if 1 - private copy-on-write mapping (data.buf is writable)
+    u32 sequential : 1;  // if 1 - hints sequential access (aggressive read-ahead)
+    u32 willneed : 1;    // if 1 - hints to prefetch whole file into page cache
+    u32 hugepage : 1;    // if 1 - hints to use transparent huge pages (Linux)
+    u32 no_fallback : 1; // if 1 - returns error if mmap is not supported, instead of reading file
+} io_mmap_flags_s;
+static_assert(sizeof(io_mmap_flags_s) == sizeof(u32), "size?");
+
+/// Memory mapped file (or its in-memory copy), returned by io.file.mmap()
+typedef struct io_mmap_s
+{
+    str_s data;     // file contents, NOT guaranteed to be NUL terminated (use data.len)
+    void* _addr;    // mapping address (NULL for empty file or read fallback)
+    usize _map_len; // mapping length
+    bool _is_copy;  // data.buf is allocated by mem$ (read fallback)
+} io_mmap_s;
+
+/// Operation types of io.async
+typedef enum IOAsyncOp_e
+{
+    IOAsyncOp__nop,
+    IOAsyncOp__open,
+    IOAsyncOp__read,
+    IOAsyncOp__write,
+    IOAsyncOp__fsync,
+    IOAsyncOp__close,
+} IOAsyncOp_e;
+
+/// Options of io.async.create(), zero fields use defaults
+typedef struct io_async_opts_s
+{
+    u32 queue_depth; // max number of queued/in flight operations (default 64, rounded to power of 2)
+    u32 n_threads;   // number of workers of portable thread backend (default 4)
+    u32 n_buffers;   // number of buffers in the pool, see io.async.buf_get() (default 0 - no pool)
+    u32 buf_size;    // size of each pool buffer (default CEX_IO_LINES_BUF)
+    bool no_uring;   // if true - don't use io_uring even if it's available
+    bool no_threads; // if true - portable backend executes operations synchronously in io.async.submit()
+} io_async_opts_s;
+
+/// Completed io.async operation, see io.async.wait()
+typedef struct io_async_cqe_s
+{
+    u64 tag;        // user tag, given at submission
+    isize result;   // file descriptor (open), bytes count (read/write), 0 (fsync/close), -1 on error
+    Exc err;        // operation error or EOK
+    void* buf;      // read/write buffer of the operation
+    IOAsyncOp_e op; // operation type
+} io_async_cqe_s;
+
+/// Asynchronous file IO engine (io_uring on Linux, or worker threads), see io.async
+typedef struct io_async_c
+{
+    void* _impl;
+    char* backend;   // "io_uring", "threads", or "sync"
+    u32 queue_depth; // max number of pending operations
+    u32 n_pending;   // queued/in flight operations, which are not returned by io.async.wait() yet
+} io_async_c;
+
 /**
 Cross-platform IO namespace
 
@@ -82,6 +162,61 @@ test$case(test_write_line)
 }
 ```
 
+- Fast line reader (zero-copy lines, no per line allocations)
+
+```c
+test$case(test_lines_iter)
+{
+    FILE* file;
+    e$ret(io.fopen(&file, "tests/data/text_file_line_4095.txt", "r"));
+
+    // NOTE: buf_size=0 - uses CEX_IO_LINES_BUF, lines longer than buffer grow it
+    io_lines_c lr = io.lines.create(file, 0, mem$);
+
+    // `it.val` is valid only until the next iteration, `\r\n` line endings are stripped
+    for$iter (str_s, it, io.lines.iter(&lr, &it.iterator)) {
+        io.printf("line %zu: %S\n", it.idx.i, it.val);
+    }
+    e$ret(io.lines.validate(&lr)); // iter() stops on error, errors are sticky
+
+    io.lines.destroy(&lr); // NOTE: file is not closed by lines reader
+    io.fclose(&file);
+    return EOK;
+}
+```
+
+- Asynchronous batched IO (io_uring on Linux, worker threads elsewhere)
+
+```c
+test$case(test_async_read_many)
+{
+    io_async_c aio;
+    e$ret(io.async.create(&aio, &(io_async_opts_s){ .queue_depth = 64, .n_buffers = 64 }, mem$));
+
+    // Operations are queued and executed in batch after io.async.submit()/io.async.wait()
+    e$ret(io.async.open(&aio, "tests/data/text_file_50b.txt", "r", 1)); // 1 - user tag
+    e$ret(io.async.submit(&aio));
+
+    io_async_cqe_s cqe[16];
+    u32 n_done = 0;
+    e$ret(io.async.wait(&aio, cqe, arr$len(cqe), 1, &n_done));
+    e$ret(cqe[0].err);
+    int fd = cqe[0].result; // open() returns file descriptor
+
+    // Buffer pool (registered in kernel for io_uring backend)
+    char* buf = io.async.buf_get(&aio);
+    e$ret(io.async.read(&aio, fd, buf, 50, 0, 2)); // read 50 bytes at offset 0
+    e$ret(io.async.wait(&aio, cqe, arr$len(cqe), 1, &n_done));
+    tassert_eq(cqe[0].result, 50);
+    io.async.buf_put(&aio, buf);
+
+    e$ret(io.async.close(&aio, fd, 3));
+    e$ret(io.async.wait(&aio, cqe, arr$len(cqe), 1, &n_done));
+    io.async.destroy(&aio); // NOTE: waits for all pending operations
+    return EOK;
+}
+```
+
 - File low-level write/read
 ```c
 
@@ -148,20 +283,80 @@ struct __cex_namespace__io {
     int             (*printf)(char* format,...);
     /// Rewind file cursor at the beginning
     void            (*rewind)(FILE* file);
+    /// Writes all `bufs` into file descriptor `fd` (gathered by writev() if supported), partial writes
+    /// are retried until everything is written. Empty buffers are skipped.
+    Exception       (*writev)(int fd, str_s* bufs, usize n_bufs);
+
+    struct {
+        /// Returns free buffer from the pool (opts.buf_size bytes), NULL if pool is empty or exhausted
+        void*           (*buf_get)(io_async_c* self);
+        /// Returns buffer back to the pool
+        void            (*buf_put)(io_async_c* self, void* buf);
+        /// Queues closing of file descriptor
+        Exception       (*close)(io_async_c* self, int fd, u64 tag);
+        /// Creates async IO engine, opts can be NULL (defaults). Uses io_uring on Linux when available,
+        /// otherwise portable worker threads backend. Must be released by io.async.destroy().
+        Exception       (*create)(io_async_c* self, io_async_opts_s* opts, IAllocator allc);
+        /// Destroys async IO engine, waits for completion of all pending operations (results are discarded)
+        void            (*destroy)(io_async_c* self);
+        /// Queues flushing of file data to the storage device
+        Exception       (*fsync)(io_async_c* self, int fd, u64 tag);
+        /// Queues file opening, `mode` is fopen() like ("r", "r+", "w", "w+", "a", "a+", "x" suffix for
+        /// exclusive creation), completion result is file descriptor. Returns Error.try_again if queue is full.
+        Exception       (*open)(io_async_c* self, char* path, char* mode, u64 tag);
+        /// Queues reading of up to `len` bytes at file `offset` ((u64)-1 - current file position) into
+        /// `buf`, completion result is number of bytes read (0 - EOF).
+        Exception       (*read)(io_async_c* self, int fd, void* buf, usize len, u64 offset, u64 tag);
+        /// Submits all queued operations for execution as a single batch (on error, operations which
+        /// were not accepted by the kernel are dropped, and not counted in n_pending)
+        Exception       (*submit)(io_async_c* self);
+        /// Submits queued operations, and waits until at least `min_complete` operations are completed
+        /// (0 - just polls), returns up to `max_cqes` completions into `cqes`, count is set in `n_done`.
+        Exception       (*wait)(io_async_c* self, io_async_cqe_s* cqes, u32 max_cqes, u32 min_complete, u32* n_done);
+        /// Queues writing of `len` bytes from `buf` at file `offset` ((u64)-1 - current file position),
+        /// completion result is number of bytes written. `buf` must be valid until completion.
+        Exception       (*write)(io_async_c* self, int fd, void* buf, usize len, u64 offset, u64 tag);
+    } async;
 
     struct {
         /// Load full contents of the file at `path`, using text mode. Returns NULL on error.
         char*           (*load)(char* path, IAllocator allc);
+        /// Maps full file contents into memory (read-only, or private copy-on-write with flags.is_private),
+        /// flags can be NULL. Falls back to reading the file into mem$ buffer where mmap is not available.
+        /// Result must be released by io.file.munmap().
+        Exception       (*mmap)(char* path, io_mmap_s* out, io_mmap_flags_s* flags);
+        /// Releases memory mapped file, created by io.file.mmap() (safe to call multiple times)
+        void            (*munmap)(io_mmap_s* m);
         /// Reads line from file, allocates result. Returns NULL on error.
         char*           (*readln)(FILE* file, IAllocator allc);
         /// Saves full `contents` in the file at `path`, using text mode.
         Exception       (*save)(char* path, char* contents);
+        /// Atomically replaces file at `path` with concatenation of `parts` (binary mode). Data is written
+        /// into temp file in the same directory and then renamed over `path`, readers never see partial
+        /// contents. is_durable=true also syncs data (and directory) to the storage device before return.
+        Exception       (*save_atomic)(char* path, str_s* parts, usize n_parts, bool is_durable);
         /// Return full file size, always 0 for NULL file or atty
         usize           (*size)(FILE* file);
         /// Writes new line to the file
         Exception       (*writeln)(FILE* file, char* line);
     } file;
 
+    struct {
+        /// Creates buffered line reader for a file, buf_size=0 uses CEX_IO_LINES_BUF. Nothing is allocated
+        /// until the first line read.
+        io_lines_c      (*create)(FILE* file, usize buf_size, IAllocator allocator);
+        /// Destroys line reader buffer (file is not closed)
+        void            (*destroy)(io_lines_c* self);
+        /// Iterates over file lines: for$iter (str_s, it, io.lines.iter(&lr, &it.iterator)), it.val is
+        /// valid until the next iteration. Check io.lines.validate() after the loop for errors.
+        str_s           (*iter)(io_lines_c* self, cex_iterator_s* iterator);
+        /// Reads next line into `line` slice (valid until the next call), returns Error.eof at the end.
+        /// `\r\n` line endings are stripped, line length is not limited by the buffer size.
+        Exception       (*next)(io_lines_c* self, str_s* line);
+        /// Returns sticky error of the line reader, EOK if there was no error (end of file is not an error)
+        Exception       (*validate)(io_lines_c* self);
+    } lines;
+
     // clang-format on
 };
 CEX_NAMESPACE struct __cex_namespace__io io;
@@ -16,10 +16,10 @@ _cex_allocator_arena_cleanup(IAllocator* allc)
     AllocatorArena.destroy(*allc);
 }
 
-// NOTE: destructor(101) - 101 lowest priority for destructors
-__attribute__((destructor(101))) void
-_cex_global_allocators_destructor()
+void
+_cex_allocator_temp_cleanup(void)
 {
+    // Frees pages of this thread tmem$ instance, must be called by threads before exit
     AllocatorArena_c* allc = (AllocatorArena_c*)tmem$;
     allocator_arena_page_s* page = allc->last_page;
     while (page) {
@@ -27,6 +27,15 @@ _cex_global_allocators_destructor()
         mem$free(mem$, page);
         page = tpage;
     }
+    allc->last_page = NULL;
+    allc->used = 0;
+}
+
+// NOTE: destructor(101) - 101 lowest priority for destructors
+__attribute__((destructor(101))) void
+_cex_global_allocators_destructor()
+{
+    _cex_allocator_temp_cleanup();
 }
 
 #endif
@@ -11,6 +11,7 @@
 
 void _cex_allocator_memscope_cleanup(IAllocator* allc);
 void _cex_allocator_arena_cleanup(IAllocator* allc);
+void _cex_allocator_temp_cleanup(void);
 
 /**
 Mem cheat-sheet
@@ -3,6 +3,18 @@
 
 #ifndef _WIN32
 #    include <dirent.h>
+#    include <poll.h>
+#    include <signal.h>
+#    include <spawn.h>
+extern char** environ;
+#    if defined(__linux__)
+#        include <sys/ioctl.h>
+#        include <sys/sendfile.h>
+#        include <sys/syscall.h>
+#        ifndef FICLONE
+#            define FICLONE _IOW(0x94, 9, int)
+#        endif
+#    endif
 #else // _WIN32
 // minirent.h HEADER BEGIN
 // Copyright 2021 Alexey Kutepov <reximkut@gmail.com>
@@ -396,82 +408,352 @@ cex_os__fs__remove(char* path)
 #endif
 }
 
-/// Iterates over directory (can be recursive) using callback function
-Exception
-cex_os__fs__dir_walk(char* path, bool is_recursive, os_fs_dir_walk_f callback_fn, void* user_ctx)
+typedef struct _os_fs_walk_s
 {
-    (void)user_ctx;
-    if (path == NULL || path[0] == '\0') { return Error.argument; }
-    Exc result = Error.os;
-    uassert(callback_fn != NULL && "you must provide callback_fn");
+    os_fs_dir_walk_f* dir_walk_fn;
+    os_fs_walk_f* walk_fn;
+    void* user_ctx;
+    bool is_recursive;
+    bool with_stat;
+} _os_fs_walk_s;
+
+// Returns entry type from dirent.d_type, and calls stat() only for symlinks, DT_UNKNOWN or with_stat
+static os_fs_stat_s
+_os__fs__dirent_stat(DIR* dp, struct dirent* ep, char* path, bool with_stat)
+{
+#if defined(_WIN32) || !defined(DT_UNKNOWN)
+    (void)dp;
+    (void)ep;
+    (void)with_stat;
+    return os.fs.stat(path);
+#else
+    (void)path;
+    os_fs_stat_s result = { .is_valid = true };
+    if (!with_stat) {
+        switch (ep->d_type) {
+            case DT_REG:
+                result.is_file = true;
+                return result;
+            case DT_DIR:
+                result.is_directory = true;
+                return result;
+            case DT_UNKNOWN: // some file systems don't support d_type
+            case DT_LNK:
+                break;
+            default:
+                result.is_other = true;
+                return result;
+        }
+    }
 
-    DIR* dp = opendir(path);
+    struct stat statbuf;
+    if (unlikely(fstatat(dirfd(dp), ep->d_name, &statbuf, AT_SYMLINK_NOFOLLOW) < 0)) {
+        return (os_fs_stat_s){ .error = os.get_last_error() };
+    }
+    if (S_ISLNK(statbuf.st_mode)) {
+        result.is_symlink = true;
+        if (unlikely(fstatat(dirfd(dp), ep->d_name, &statbuf, 0) < 0)) {
+            // dangling symlink, doesn't stop the walk
+            result.is_other = true;
+            return result;
+        }
+    }
+    if (S_ISREG(statbuf.st_mode)) {
+        result.is_file = true;
+    } else if (S_ISDIR(statbuf.st_mode)) {
+        result.is_directory = true;
+    } else {
+        result.is_other = true;
+    }
+    result.size = statbuf.st_size;
+    result.mtime = statbuf.st_mtime;
+    return result;
+#endif
+}
 
-    if (unlikely(dp == NULL)) {
-        result = os.get_last_error();
-        goto end;
+// Opens sub-directory `name` of `parent` (relative to parent fd if supported), `path` is full path
+static DIR*
+_os__fs__opendir_at(DIR* parent, char* name, char* path)
+{
+#if defined(_WIN32) || !defined(O_DIRECTORY)
+    (void)parent;
+    (void)name;
+    return opendir(path);
+#else
+    (void)path;
+    int fd = openat(dirfd(parent), name, O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+    if (fd < 0) { return NULL; }
+    DIR* dp = fdopendir(fd);
+    if (dp == NULL) { close(fd); }
+    return dp;
+#endif
+}
+
+// Walks `dp` entries, `path_buf` (PATH_MAX) contains directory path of path_len, and shared between
+// all recursion levels. Sub-directories are visited before the callback of directory itself.
+static Exception
+_os__fs__walk_serial(_os_fs_walk_s* w, DIR* dp, char* path_buf, usize path_len)
+{
+    if (path_buf[path_len - 1] != '/' && path_buf[path_len - 1] != '\\') {
+        if (path_len >= PATH_MAX - 1) { return Error.overflow; }
+        path_buf[path_len++] = os$PATH_SEP;
     }
 
-    u32 path_len = strlen(path);
-    if (path_len > PATH_MAX - 2) {
-        result = Error.overflow;
-        goto end;
+    struct dirent* ep;
+    while ((ep = readdir(dp)) != NULL) {
+        char* name = ep->d_name;
+        if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0'))) {
+            continue;
+        }
+        usize name_len = strlen(name);
+        if (unlikely(path_len + name_len >= PATH_MAX)) { return Error.overflow; }
+        memcpy(path_buf + path_len, name, name_len + 1);
+
+        os_fs_stat_s ftype = _os__fs__dirent_stat(dp, ep, path_buf, w->with_stat);
+        if (!ftype.is_valid) { return ftype.error; }
+
+        if (w->is_recursive && ftype.is_directory && !ftype.is_symlink) {
+            DIR* sub_dp = _os__fs__opendir_at(dp, name, path_buf);
+            if (unlikely(sub_dp == NULL)) { return os.get_last_error(); }
+            Exc err = _os__fs__walk_serial(w, sub_dp, path_buf, path_len + name_len);
+            (void)closedir(sub_dp);
+            if (err) { return err; }
+            path_buf[path_len + name_len] = '\0'; // recursion extended the path
+        }
+
+        // After recursive call make a callback on a directory itself
+        Exc err = (w->walk_fn) ? w->walk_fn(path_buf, ftype, 0, w->user_ctx)
+                               : w->dir_walk_fn(path_buf, ftype, w->user_ctx);
+        if (err) { return err; }
     }
+    return EOK;
+}
+
+static Exception
+_os__fs__walk_root(_os_fs_walk_s* w, char* path)
+{
+    if (path == NULL || path[0] == '\0') { return Error.argument; }
+    usize path_len = strlen(path);
+    if (path_len > PATH_MAX - 2) { return Error.overflow; }
+
+    char path_buf[PATH_MAX];
+    memcpy(path_buf, path, path_len + 1);
+
+    DIR* dp = opendir(path);
+    if (unlikely(dp == NULL)) { return os.get_last_error(); }
+    Exc result = _os__fs__walk_serial(w, dp, path_buf, path_len);
+    (void)closedir(dp);
+    return result;
+}
+
+/// Iterates over directory (can be recursive) using callback function. Entry types are taken from
+/// the directory listing, ftype.size/ftype.mtime are not filled (see os.fs.walk() with_stat option)
+Exception
+cex_os__fs__dir_walk(char* path, bool is_recursive, os_fs_dir_walk_f callback_fn, void* user_ctx)
+{
+    uassert(callback_fn != NULL && "you must provide callback_fn");
+    _os_fs_walk_s w = {
+        .dir_walk_fn = callback_fn,
+        .user_ctx = user_ctx,
+        .is_recursive = is_recursive,
+    };
+    return _os__fs__walk_root(&w, path);
+}
 
+#if defined(CEX_HAS_THREADS)
+typedef struct _os_fs_walk_parallel_s
+{
+    _os_fs_walk_s* w;
+    arr$(char*) dirs; // pending directories, guarded by lock
+    u32 n_busy;       // threads processing a directory
+    u32 next_thread_idx;
+    Exc err;
+#    ifdef _WIN32
+    SRWLOCK lock;
+    CONDITION_VARIABLE cond;
+#    else
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+#    endif
+} _os_fs_walk_parallel_s;
+
+#    ifdef _WIN32
+#        define _os__fs__walk_lock(p) AcquireSRWLockExclusive(&(p)->lock)
+#        define _os__fs__walk_unlock(p) ReleaseSRWLockExclusive(&(p)->lock)
+#        define _os__fs__walk_wait(p) SleepConditionVariableSRW(&(p)->cond, &(p)->lock, INFINITE, 0)
+#        define _os__fs__walk_signal(p) WakeConditionVariable(&(p)->cond)
+#        define _os__fs__walk_broadcast(p) WakeAllConditionVariable(&(p)->cond)
+#    else
+#        define _os__fs__walk_lock(p) pthread_mutex_lock(&(p)->lock)
+#        define _os__fs__walk_unlock(p) pthread_mutex_unlock(&(p)->lock)
+#        define _os__fs__walk_wait(p) pthread_cond_wait(&(p)->cond, &(p)->lock)
+#        define _os__fs__walk_signal(p) pthread_cond_signal(&(p)->cond)
+#        define _os__fs__walk_broadcast(p) pthread_cond_broadcast(&(p)->cond)
+#    endif
+
+// Lists single directory, sub-directories are pushed into shared queue (callbacks are pre-order)
+static Exception
+_os__fs__walk_parallel_dir(_os_fs_walk_parallel_s* p, char* dir, u32 thread_idx)
+{
+    _os_fs_walk_s* w = p->w;
+    usize path_len = strlen(dir);
+    if (path_len > PATH_MAX - 2) { return Error.overflow; }
     char path_buf[PATH_MAX];
+    memcpy(path_buf, dir, path_len + 1);
+    if (path_buf[path_len - 1] != '/' && path_buf[path_len - 1] != '\\') {
+        path_buf[path_len++] = os$PATH_SEP;
+    }
+
+    DIR* dp = opendir(dir);
+    if (unlikely(dp == NULL)) { return os.get_last_error(); }
 
+    Exc result = EOK;
     struct dirent* ep;
     while ((ep = readdir(dp)) != NULL) {
-        errno = 0;
-        if (str.eq(ep->d_name, ".")) { continue; }
-        if (str.eq(ep->d_name, "..")) { continue; }
-        memcpy(path_buf, path, path_len);
-        u32 path_offset = 0;
-        if (path_buf[path_len - 1] != '/' && path_buf[path_len - 1] != '\\') {
-            path_buf[path_len] = os$PATH_SEP;
-            path_offset = 1;
-        }
-
-        e$except_silent (
-            err,
-            str.copy(
-                path_buf + path_len + path_offset,
-                ep->d_name,
-                sizeof(path_buf) - path_len - 1 - path_offset
-            )
-        ) {
-            result = err;
-            goto end;
+        char* name = ep->d_name;
+        if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0'))) {
+            continue;
+        }
+        usize name_len = strlen(name);
+        if (unlikely(path_len + name_len >= PATH_MAX)) {
+            result = Error.overflow;
+            break;
         }
+        memcpy(path_buf + path_len, name, name_len + 1);
 
-        auto ftype = os.fs.stat(path_buf);
+        os_fs_stat_s ftype = _os__fs__dirent_stat(dp, ep, path_buf, w->with_stat);
         if (!ftype.is_valid) {
             result = ftype.error;
-            goto end;
-        }
-
-        if (is_recursive && ftype.is_directory && !ftype.is_symlink) {
-            e$except_silent (
-                err,
-                cex_os__fs__dir_walk(path_buf, is_recursive, callback_fn, user_ctx)
-            ) {
-                result = err;
-                goto end;
-            }
+            break;
         }
-        // After recursive call make a callback on a directory itself
-        e$except_silent (err, callback_fn(path_buf, ftype, user_ctx)) {
+        e$except_silent (err, w->walk_fn(path_buf, ftype, thread_idx, w->user_ctx)) {
             result = err;
-            goto end;
+            break;
+        }
+        if (w->is_recursive && ftype.is_directory && !ftype.is_symlink) {
+            _os__fs__walk_lock(p);
+            // NOTE: allocations are made under lock, mem$ is not thread safe in CEX_TEST mode
+            char* sub_dir = str.clone(path_buf, mem$);
+            bool is_pushed = sub_dir != NULL && arr$grow_check(p->dirs, 1);
+            if (is_pushed) {
+                arr$push(p->dirs, sub_dir);
+                _os__fs__walk_signal(p);
+            } else if (sub_dir) {
+                mem$free(mem$, sub_dir);
+            }
+            bool is_failed = p->err != EOK; // other thread failed
+            _os__fs__walk_unlock(p);
+            if (!is_pushed) {
+                result = Error.memory;
+                break;
+            }
+            if (is_failed) { break; }
         }
     }
-
-    result = EOK;
-end:
-    if (dp != NULL) { (void)closedir(dp); }
+    (void)closedir(dp);
     return result;
 }
 
+static void
+_os__fs__walk_parallel_loop(_os_fs_walk_parallel_s* p)
+{
+    _os__fs__walk_lock(p);
+    u32 thread_idx = p->next_thread_idx++;
+    while (true) {
+        while (arr$len(p->dirs) == 0 && p->n_busy > 0 && p->err == EOK) { _os__fs__walk_wait(p); }
+        if (arr$len(p->dirs) == 0 || p->err != EOK) { break; }
+
+        char* dir = arr$pop(p->dirs);
+        p->n_busy++;
+        _os__fs__walk_unlock(p);
+
+        Exc err = _os__fs__walk_parallel_dir(p, dir, thread_idx);
+
+        _os__fs__walk_lock(p);
+        mem$free(mem$, dir);
+        p->n_busy--;
+        if (err && p->err == EOK) { p->err = err; }
+        if (p->err || (p->n_busy == 0 && arr$len(p->dirs) == 0)) { _os__fs__walk_broadcast(p); }
+    }
+    _os__fs__walk_broadcast(p);
+    _os__fs__walk_unlock(p);
+}
+
+static _cex_thread_fn(_os__fs__walk_parallel_worker, arg)
+{
+    _os__fs__walk_parallel_loop(arg);
+    // tmem$ is thread local, callbacks may use it, pages must be released before thread exit
+    _cex_allocator_temp_cleanup();
+    return 0;
+}
+#endif
+
+/// Walks directory entries, calling `callback_fn(path, ftype, thread_idx, user_ctx)`, opts can be
+/// NULL (non-recursive, single threaded). With n_threads != 1 callbacks are called from multiple
+/// threads (in arbitrary order, directory callback comes before its contents). Entry types are taken
+/// from the directory listing, set opts.with_stat for ftype.size/ftype.mtime.
+static Exception
+cex_os__fs__walk(char* path, os_fs_walk_opts_s* opts, os_fs_walk_f callback_fn, void* user_ctx)
+{
+    uassert(callback_fn != NULL && "you must provide callback_fn");
+    os_fs_walk_opts_s o = (opts) ? *opts : (os_fs_walk_opts_s){ .n_threads = 1 };
+    _os_fs_walk_s w = {
+        .walk_fn = callback_fn,
+        .user_ctx = user_ctx,
+        .is_recursive = o.is_recursive,
+        .with_stat = o.with_stat,
+    };
+    u32 n_threads = (o.n_threads > 0) ? o.n_threads : os.platform.cpu_count();
+
+#if defined(CEX_HAS_THREADS)
+    if (n_threads > 1 && o.is_recursive) {
+        if (path == NULL || path[0] == '\0') { return Error.argument; }
+        if (strlen(path) > PATH_MAX - 2) { return Error.overflow; }
+        os_fs_stat_s root = os.fs.stat(path);
+        if (!root.is_valid) { return root.error; }
+        if (!root.is_directory) { return Error.argument; }
+
+        _os_fs_walk_parallel_s p = { .w = &w, .dirs = arr$new(p.dirs, mem$) };
+        char* root_copy = str.clone(path, mem$);
+        if (p.dirs == NULL || root_copy == NULL) {
+            if (p.dirs) { arr$free(p.dirs); }
+            if (root_copy) { mem$free(mem$, root_copy); }
+            return Error.memory;
+        }
+        arr$push(p.dirs, root_copy);
+
+#    ifdef _WIN32
+        InitializeSRWLock(&p.lock);
+        InitializeConditionVariable(&p.cond);
+#    else
+        pthread_mutex_init(&p.lock, NULL);
+        pthread_cond_init(&p.cond, NULL);
+#    endif
+        u32 n_spawned = 0;
+        _cex_thread_t* threads = mem$calloc(mem$, n_threads, sizeof(_cex_thread_t));
+        for (u32 i = 1; threads && i < n_threads; i++) {
+            if (!_cex_thread_spawn(&threads[n_spawned], _os__fs__walk_parallel_worker, &p)) {
+                break;
+            }
+            n_spawned++;
+        }
+        // current thread is also a worker
+        _os__fs__walk_parallel_loop(&p);
+        for (u32 i = 0; i < n_spawned; i++) { _cex_thread_join(threads[i]); }
+#    ifndef _WIN32
+        pthread_mutex_destroy(&p.lock);
+        pthread_cond_destroy(&p.cond);
+#    endif
+        if (threads) { mem$free(mem$, threads); }
+        for$each (it, p.dirs) { mem$free(mem$, it); } // left after error
+        arr$free(p.dirs);
+        return p.err;
+    }
+#endif
+    (void)n_threads;
+    return _os__fs__walk_root(&w, path);
+}
+
 struct _os_fs_find_ctx_s
 {
     char* pattern;
@@ -514,8 +796,9 @@ struct _os_fs_copy_tree_ctx_s
 };
 
 static Exception
-_os__fs__copy_tree_walker(char* path, os_fs_stat_s ftype, void* user_ctx)
+_os__fs__copy_tree_walker(char* path, os_fs_stat_s ftype, u32 thread_idx, void* user_ctx)
 {
+    (void)thread_idx;
     struct _os_fs_copy_tree_ctx_s* ctx = user_ctx;
     mem$scope(tmem$, _)
     {
@@ -525,7 +808,7 @@ _os__fs__copy_tree_walker(char* path, os_fs_stat_s ftype, void* user_ctx)
         if (ftype.is_file) {
             e$ret(os.fs.mkpath(out_file));
             e$ret(os.fs.copy(path, out_file));
-        } else {
+        } else if (ftype.is_directory) {
             // Making empty directory if necessary
             char* out_dir = str.fmt(_, "%s/", out_file);
             e$ret(os.fs.mkpath(out_dir));
@@ -535,10 +818,8 @@ _os__fs__copy_tree_walker(char* path, os_fs_stat_s ftype, void* user_ctx)
     return EOK;
 }
 
-
-/// Copy directory recursively
 static Exception
-cex_os__fs__copy_tree(char* src_dir, char* dst_dir)
+_os__fs__copy_tree(char* src_dir, char* dst_dir, u32 n_threads)
 {
     if (src_dir == NULL || src_dir[0] == '\0') { return Error.argument; }
     os_fs_stat_s s = os.fs.stat(src_dir);
@@ -554,13 +835,29 @@ cex_os__fs__copy_tree(char* src_dir, char* dst_dir)
         .src_dir = str.sstr(src_dir),
         .dest_dir = str.sstr(dst_dir),
     };
-    e$except_silent (err, cex_os__fs__dir_walk(src_dir, true, _os__fs__copy_tree_walker, &ctx)) {
+    // NOTE: in parallel mode directory callback comes first, so its copy exists before the files
+    os_fs_walk_opts_s opts = { .n_threads = n_threads, .is_recursive = true };
+    e$except_silent (err, cex_os__fs__walk(src_dir, &opts, _os__fs__copy_tree_walker, &ctx)) {
         return err;
     }
 
     return EOK;
 }
 
+/// Copy directory recursively
+static Exception
+cex_os__fs__copy_tree(char* src_dir, char* dst_dir)
+{
+    return _os__fs__copy_tree(src_dir, dst_dir, 1);
+}
+
+/// Copy directory recursively using up to `n_threads` parallel file copies (0 - cpu count)
+static Exception
+cex_os__fs__copy_tree_parallel(char* src_dir, char* dst_dir, u32 n_threads)
+{
+    return _os__fs__copy_tree(src_dir, dst_dir, n_threads);
+}
+
 static Exception
 _os__fs__find_walker(char* path, os_fs_stat_s ftype, void* user_ctx)
 {
@@ -691,7 +988,105 @@ cex_os__fs__chdir(char* path)
 }
 
 
-/// Copy file
+#ifndef _WIN32
+// Copies [offset, offset+len) of src into the same offset of dst, using in-kernel copy if possible
+static Exception
+_os__fs__copy_range(int src_fd, int dst_fd, off_t offset, off_t len, char* buf, usize buf_size)
+{
+    off_t end = offset + len;
+#    if defined(__linux__) && defined(__NR_copy_file_range)
+    // NOTE: same filesystem copy, may also reflink or use server side copy (NFS)
+    while (offset < end) {
+        loff_t off_in = offset;
+        loff_t off_out = offset;
+        isize n = syscall(__NR_copy_file_range, src_fd, &off_in, dst_fd, &off_out, end - offset, 0);
+        if (n < 0) {
+            break; // not supported (e.g. cross-filesystem on old kernels), try next method
+        }
+        if (n == 0) { return EOK; } // src truncated
+        offset += n;
+    }
+    if (offset >= end) { return EOK; }
+
+    if (lseek(dst_fd, offset, SEEK_SET) == offset) {
+        while (offset < end) {
+            off_t off_in = offset;
+            isize n = sendfile(dst_fd, src_fd, &off_in, end - offset);
+            if (n <= 0) { break; }
+            offset += n;
+        }
+        if (offset >= end) { return EOK; }
+    }
+#    endif
+
+    while (offset < end) {
+        usize chunk = ((off_t)buf_size < end - offset) ? buf_size : (usize)(end - offset);
+        isize n = pread(src_fd, buf, chunk, offset);
+        if (n < 0) {
+            if (errno == EINTR) { continue; }
+            return os.get_last_error();
+        }
+        if (n == 0) { break; } // src truncated
+        char* wbuf = buf;
+        while (n > 0) {
+            isize m = pwrite(dst_fd, wbuf, n, offset);
+            if (m < 0) {
+                if (errno == EINTR) { continue; }
+                return os.get_last_error();
+            }
+            n -= m;
+            wbuf += m;
+            offset += m;
+        }
+    }
+    return EOK;
+}
+
+// Copies file contents: reflink if supported, otherwise data ranges (holes of sparse files are kept)
+static Exception
+_os__fs__copy_data(int src_fd, int dst_fd, struct stat* src_stat)
+{
+#    if defined(__linux__)
+    // copy-on-write clone (btrfs, xfs, bcachefs...), instant and doesn't use extra space
+    if (ioctl(dst_fd, FICLONE, src_fd) == 0) { return EOK; }
+#    endif
+
+    Exc result = EOK;
+    // NOTE: may run on os.fs.copy_tree_parallel() threads, no mem$ (not thread safe in CEX_TEST
+    // mode), and small enough for default thread stack sizes
+    char buf[32 * 1024];
+    off_t size = src_stat->st_size;
+    off_t offset = 0;
+    bool is_sparse = src_stat->st_blocks * 512 < size;
+    while (offset < size) {
+        off_t data_end = size;
+#    if defined(SEEK_DATA) && defined(SEEK_HOLE)
+        if (is_sparse) {
+            off_t data = lseek(src_fd, offset, SEEK_DATA);
+            off_t hole = (data >= 0) ? lseek(src_fd, data, SEEK_HOLE) : -1;
+            if (data < 0 && errno == ENXIO) {
+                break; // only hole till the end of file
+            } else if (data < 0 || hole < 0) {
+                is_sparse = false; // not supported by filesystem, copy all the rest
+            } else {
+                offset = data;
+                data_end = (hole < size) ? hole : size;
+            }
+        }
+#    endif
+        result = _os__fs__copy_range(src_fd, dst_fd, offset, data_end - offset, buf, sizeof(buf));
+        if (result != EOK) { break; }
+        offset = data_end;
+    }
+    if (result == EOK && is_sparse && ftruncate(dst_fd, size) < 0) {
+        result = os.get_last_error(); // trailing hole
+    }
+    return result;
+}
+#endif
+
+/// Copy file (uses copy-on-write clone or in-kernel copy when possible, keeps sparse file holes,
+/// permissions, and modification time)
 static Exception
 cex_os__fs__copy(char* src_path, char* dst_path)
 {
@@ -708,12 +1103,9 @@ cex_os__fs__copy(char* src_path, char* dst_path)
 #else
     int src_fd = -1;
     int dst_fd = -1;
-    size_t buf_size = 32 * 1024;
-    char* buf = mem$malloc(mem$, buf_size);
-    if (buf == NULL) { return Error.memory; }
     Exc result = Error.runtime;
 
-    if ((src_fd = open(src_path, O_RDONLY)) == -1) {
+    if ((src_fd = open(src_path, O_RDONLY | O_CLOEXEC)) == -1) {
         result = os.get_last_error();
         goto defer;
     }
@@ -724,34 +1116,28 @@ cex_os__fs__copy(char* src_path, char* dst_path)
         goto defer;
     }
 
-    dst_fd = open(dst_path, O_CREAT | O_TRUNC | O_WRONLY, src_stat.st_mode);
+    dst_fd = open(dst_path, O_CREAT | O_TRUNC | O_WRONLY | O_CLOEXEC, src_stat.st_mode);
     if (dst_fd < 0) {
         result = strerror(errno);
         goto defer;
     }
 
-    for (;;) {
-        ssize_t n = read(src_fd, buf, buf_size);
-        if (n == 0) { break; }
-        if (n < 0) {
-            result = os.get_last_error();
-            goto defer;
-        }
-        char* buf2 = buf;
-        while (n > 0) {
-            ssize_t m = write(dst_fd, buf2, n);
-            if (m < 0) {
-                result = os.get_last_error();
-                goto defer;
-            }
-            n -= m;
-            buf2 += m;
-        }
+    e$except_silent (err, _os__fs__copy_data(src_fd, dst_fd, &src_stat)) {
+        result = err;
+        goto defer;
     }
+
+    // NOTE: metadata is best effort (some filesystems don't support it)
+    (void)fchmod(dst_fd, src_stat.st_mode & 07777);
+#    if defined(__APPLE__)
+    struct timespec times[2] = { src_stat.st_atimespec, src_stat.st_mtimespec };
+#    else
+    struct timespec times[2] = { src_stat.st_atim, src_stat.st_mtim };
+#    endif
+    (void)futimens(dst_fd, times);
     result = EOK;
 
 defer:
-    mem$free(mem$, buf);
     if (src_fd >= 0) { close(src_fd); }
     if (dst_fd >= 0) { close(dst_fd); }
     return result;
@@ -1184,15 +1570,12 @@ cex_os__cmd__run(char** args, usize args_len, os_cmd_c* out_cmd)
 end:
     return result;
 #else
-    pid_t cpid = fork();
-    if (cpid < 0) { return e$raise(Error.os, "Could not fork child process: %s", strerror(errno)); }
-
-    if (cpid == 0) {
-        if (execvp(args[0], (char* const*)args) < 0) {
-            log$error("Could not exec child process: %s\n", strerror(errno));
-            exit(1);
-        }
-        uassert(false && "unreachable");
+    // NOTE: posix_spawn() avoids copying of parent address space (fork), glibc/musl use
+    // clone(CLONE_VM|CLONE_VFORK), which matters for big parent processes
+    pid_t cpid = 0;
+    int err = posix_spawnp(&cpid, args[0], NULL, NULL, args, environ);
+    if (err != 0) {
+        return e$raise(Error.os, "Could not spawn child process '%s': %s", args[0], strerror(err));
     }
 
     *out_cmd = (os_cmd_c){ ._is_subprocess = false,
@@ -1205,6 +1588,662 @@ end:
 #endif
 }
 
+struct _os_cmd_pool_slot_s
+{
+    u32 job_idx;
+    FILE* output; // temp file with combined stdout/stderr of the child
+#ifdef _WIN32
+    HANDLE process;
+#else
+    pid_t pid;
+#endif
+};
+
+/// Creates pool of concurrently running commands, opts can be NULL (cpu count jobs, fail fast,
+/// output printed per job). Job outputs are captured and printed as a whole on job completion,
+/// so parallel outputs never interleave.
+static Exception
+cex_os__cmd__pool_create(os_cmd_pool_c* self, os_cmd_pool_opts_s* opts, IAllocator allc)
+{
+    uassert(self != NULL);
+    uassert(allc != NULL);
+
+    *self = (os_cmd_pool_c){
+        .opts = (opts) ? *opts : (os_cmd_pool_opts_s){ 0 },
+        .allc = allc,
+    };
+    if (self->opts.n_jobs == 0) { self->opts.n_jobs = os.platform.cpu_count(); }
+#ifdef _WIN32
+    // WaitForMultipleObjects() limit
+    if (self->opts.n_jobs > MAXIMUM_WAIT_OBJECTS) { self->opts.n_jobs = MAXIMUM_WAIT_OBJECTS; }
+#endif
+
+    self->jobs = arr$new(self->jobs, allc);
+    self->_slots = mem$calloc(allc, self->opts.n_jobs, sizeof(struct _os_cmd_pool_slot_s));
+    if (self->jobs == NULL || self->_slots == NULL) {
+        if (self->jobs) { arr$free(self->jobs); }
+        return Error.memory;
+    }
+    return EOK;
+}
+
+static Exception
+_cex_os__cmd__pool_spawn(os_cmd_pool_c* self, u32 job_idx)
+{
+    char** args = self->jobs[job_idx].args;
+    struct _os_cmd_pool_slot_s* slot = &self->_slots[self->n_running];
+    *slot = (struct _os_cmd_pool_slot_s){ .job_idx = job_idx };
+
+    slot->output = tmpfile();
+    if (slot->output == NULL) { return os.get_last_error(); }
+
+#ifdef _WIN32
+    Exc result = Error.runtime;
+    HANDLE hout = (HANDLE)_get_osfhandle(_fileno(slot->output));
+    if (!SetHandleInformation(hout, HANDLE_FLAG_INHERIT, HANDLE_FLAG_INHERIT)) {
+        result = os.get_last_error();
+        goto end;
+    }
+
+    STARTUPINFO si = { 0 };
+    PROCESS_INFORMATION pi = { 0 };
+    si.cb = sizeof(STARTUPINFO);
+    si.dwFlags |= STARTF_USESTDHANDLES;
+    si.hStdError = hout;
+    si.hStdOutput = hout;
+    si.hStdInput = GetStdHandle(STD_INPUT_HANDLE);
+
+    mem$scope(tmem$, _)
+    {
+        sbuf_c cmd = sbuf.create(1024, _);
+        for (u32 i = 0; args[i] != NULL; i++) {
+            if (str.find(args[i], " ") || str.find(args[i], "\"")) {
+                char* escaped_arg = str.replace(args[i], "\"", "\\\"", _);
+                e$except_silent (err, sbuf.appendf(&cmd, "\"%s\" ", escaped_arg)) {
+                    result = err;
+                    goto end;
+                }
+            } else {
+                e$except_silent (err, sbuf.appendf(&cmd, "%s ", args[i])) {
+                    result = err;
+                    goto end;
+                }
+            }
+        }
+
+        if (!CreateProcessA(NULL, cmd, NULL, NULL, TRUE, 0, NULL, NULL, &si, &pi)) {
+            result = os.get_last_error();
+            goto end;
+        }
+    }
+    CloseHandle(pi.hThread);
+    slot->process = pi.hProcess;
+    result = EOK;
+
+end:
+    if (result != EOK) {
+        fclose(slot->output);
+        slot->output = NULL;
+        return result;
+    }
+#else
+    int out_fd = fileno(slot->output);
+    // other children must not inherit this output (dup2() in child clears the flag)
+    fcntl(out_fd, F_SETFD, FD_CLOEXEC);
+
+    posix_spawn_file_actions_t actions;
+    int err = posix_spawn_file_actions_init(&actions);
+    if (err == 0) {
+        err = posix_spawn_file_actions_addopen(&actions, STDIN_FILENO, "/dev/null", O_RDONLY, 0);
+    }
+    if (err == 0) { err = posix_spawn_file_actions_adddup2(&actions, out_fd, STDOUT_FILENO); }
+    if (err == 0) { err = posix_spawn_file_actions_adddup2(&actions, out_fd, STDERR_FILENO); }
+    pid_t cpid = 0;
+    if (err == 0) { err = posix_spawnp(&cpid, args[0], &actions, NULL, args, environ); }
+    posix_spawn_file_actions_destroy(&actions);
+    if (err != 0) {
+        fclose(slot->output);
+        slot->output = NULL;
+        return e$raise(Error.os, "Could not spawn child process '%s': %s", args[0], strerror(err));
+    }
+    slot->pid = cpid;
+#endif
+
+    self->n_running++;
+    return EOK;
+}
+
+static void
+_cex_os__cmd__pool_finish(os_cmd_pool_c* self, u32 slot_idx, i32 ret_code)
+{
+    uassert(slot_idx < self->n_running);
+    struct _os_cmd_pool_slot_s* slot = &self->_slots[slot_idx];
+    os_cmd_job_s* job = &self->jobs[slot->job_idx];
+
+    job->ret_code = ret_code;
+    job->is_done = true;
+    if (ret_code != 0) {
+        job->err = Error.runtime;
+        self->n_failed++;
+        if (self->err == EOK) { self->err = job->err; }
+    }
+
+    rewind(slot->output);
+    if (self->opts.keep_output) {
+        str_s out = { 0 };
+        if (io.fread_all(slot->output, &out, self->allc) == EOK) { job->output = out.buf; }
+        if (!self->opts.no_print && out.len > 0) {
+            fwrite(out.buf, 1, out.len, stdout);
+            fflush(stdout);
+        }
+    } else if (!self->opts.no_print) {
+        char buf[4096];
+        usize n = 0;
+        while ((n = fread(buf, 1, sizeof(buf), slot->output)) > 0) { fwrite(buf, 1, n, stdout); }
+        fflush(stdout);
+    }
+    fclose(slot->output);
+
+    // swap remove
+    self->n_running--;
+    self->_slots[slot_idx] = self->_slots[self->n_running];
+}
+
+/// Blocks until at least one running job finishes
+static Exception
+_cex_os__cmd__pool_wait_any(os_cmd_pool_c* self)
+{
+    if (self->n_running == 0) { return EOK; }
+
+#ifdef _WIN32
+    HANDLE handles[MAXIMUM_WAIT_OBJECTS];
+    for (u32 i = 0; i < self->n_running; i++) { handles[i] = self->_slots[i].process; }
+    DWORD r = WaitForMultipleObjects(self->n_running, handles, FALSE, INFINITE);
+    if (r == WAIT_FAILED) { return os.get_last_error(); }
+    for (u32 i = 0; i < self->n_running;) {
+        HANDLE process = self->_slots[i].process;
+        if (WaitForSingleObject(process, 0) != WAIT_OBJECT_0) {
+            i++;
+            continue;
+        }
+        DWORD exit_code = 0;
+        i32 ret_code = GetExitCodeProcess(process, &exit_code) ? (i32)exit_code : -1;
+        CloseHandle(process);
+        _cex_os__cmd__pool_finish(self, i, ret_code);
+    }
+    return EOK;
+#else
+    while (true) {
+        u32 n_done = 0;
+        for (u32 i = 0; i < self->n_running;) {
+            int status = 0;
+            pid_t r = waitpid(self->_slots[i].pid, &status, WNOHANG);
+            if (r == 0) {
+                i++;
+                continue;
+            }
+            if (r < 0 && errno == EINTR) { continue; }
+
+            i32 ret_code = -1;
+            if (r > 0 && WIFEXITED(status)) {
+                ret_code = WEXITSTATUS(status);
+            } else if (r > 0 && WIFSIGNALED(status)) {
+                ret_code = 128 + WTERMSIG(status);
+            }
+            _cex_os__cmd__pool_finish(self, i, ret_code);
+            n_done++;
+        }
+        if (n_done > 0 || self->n_running == 0) { return EOK; }
+
+#    if defined(__linux__)
+        // Sleep until any child exits, without reaping it. If it's not a child of the pool
+        // (e.g. zombie of another os.cmd) waitid() returns immediately, fall back to polling.
+        siginfo_t info = { 0 };
+        if (waitid(P_ALL, 0, &info, WEXITED | WNOWAIT) == 0) {
+            bool is_ours = false;
+            for (u32 i = 0; i < self->n_running; i++) {
+                if (self->_slots[i].pid == info.si_pid) {
+                    is_ours = true;
+                    break;
+                }
+            }
+            if (is_ours) { continue; }
+        }
+#    endif
+        cex_os_sleep(2);
+    }
+#endif
+}
+
+/// Adds new job to the pool, args are copied and must be NULL terminated (same as os.cmd.run()).
+/// Blocks while all opts.n_jobs slots are busy. Returns error of the first failed job (without
+/// launching a new one) unless opts.keep_going is set.
+static Exception
+cex_os__cmd__pool_add(os_cmd_pool_c* self, char** args, usize args_len)
+{
+    uassert(self != NULL);
+    uassert(self->_slots != NULL && "pool is not created");
+
+    if (args == NULL || args_len == 0) {
+        return e$raise(Error.argument, "`args` argument is empty or null");
+    }
+    if (args_len == 1 || args[args_len - 1] != NULL) {
+        return e$raise(Error.argument, "`args` last item must be a NULL");
+    }
+    for (u32 i = 0; i < args_len - 1; i++) {
+        if (args[i] == NULL || args[i][0] == '\0') {
+            return e$raise(
+                Error.argument,
+                "`args` item[%d] is NULL/empty, which may indicate string operation failure",
+                i
+            );
+        }
+    }
+
+    while (self->n_running >= self->opts.n_jobs) { e$ret(_cex_os__cmd__pool_wait_any(self)); }
+    if (self->err != EOK && !self->opts.keep_going) { return self->err; }
+
+    _os$args_print("CMD:", args, args_len);
+
+    os_cmd_job_s job = { .ret_code = -1 };
+    job.args = mem$calloc(self->allc, args_len, sizeof(char*));
+    if (job.args == NULL) { return Error.memory; }
+    for (u32 i = 0; i < args_len - 1; i++) {
+        job.args[i] = str.clone(args[i], self->allc);
+        if (job.args[i] == NULL) {
+            // job.args is calloc'ed, so everything cloned so far is NULL-terminated
+            for (u32 j = 0; j < i; j++) { mem$free(self->allc, job.args[j]); }
+            mem$free(self->allc, job.args);
+            return Error.memory;
+        }
+    }
+    arr$push(self->jobs, job);
+
+    u32 job_idx = arr$len(self->jobs) - 1;
+    e$except_silent (err, _cex_os__cmd__pool_spawn(self, job_idx)) {
+        self->jobs[job_idx].err = err;
+        self->jobs[job_idx].is_done = true;
+        self->n_failed++;
+        if (self->err == EOK) { self->err = err; }
+        return (self->opts.keep_going) ? EOK : err;
+    }
+    return EOK;
+}
+
+/// Waits all running jobs to finish, returns error of the first failed job (check
+/// os_cmd_pool_c.jobs for individual results)
+static Exception
+cex_os__cmd__pool_join(os_cmd_pool_c* self)
+{
+    uassert(self != NULL);
+    uassert(self->_slots != NULL && "pool is not created");
+
+    while (self->n_running > 0) { e$ret(_cex_os__cmd__pool_wait_any(self)); }
+    return self->err;
+}
+
+/// Terminates still running jobs and frees pool resources
+static void
+cex_os__cmd__pool_destroy(os_cmd_pool_c* self)
+{
+    uassert(self != NULL);
+    if (self->_slots == NULL) { return; }
+
+    self->opts.no_print = true;
+    while (self->n_running > 0) {
+        struct _os_cmd_pool_slot_s* slot = &self->_slots[self->n_running - 1];
+#ifdef _WIN32
+        TerminateProcess(slot->process, 1);
+        WaitForSingleObject(slot->process, INFINITE);
+        CloseHandle(slot->process);
+#else
+        kill(slot->pid, SIGTERM);
+        while (waitpid(slot->pid, NULL, 0) < 0 && errno == EINTR) {}
+#endif
+        _cex_os__cmd__pool_finish(self, self->n_running - 1, -1);
+    }
+
+    for$eachp(job, self->jobs)
+    {
+        if (job->args) {
+            for (u32 i = 0; job->args[i] != NULL; i++) { mem$free(self->allc, job->args[i]); }
+            mem$free(self->allc, job->args);
+        }
+        if (job->output) { mem$free(self->allc, job->output); }
+    }
+    arr$free(self->jobs);
+    mem$free(self->allc, self->_slots);
+    memset(self, 0, sizeof(*self));
+}
+
+typedef struct _os_cmd_io_state_s
+{
+    f64 deadline; // os.timer() value, 0 - no timeout
+    usize in_written;
+#ifdef _WIN32
+    HANDLE h_out;
+    HANDLE h_err;
+#else
+    int fd_out;
+    int fd_err;
+    int fd_in;
+    int fd_pid; // pidfd (Linux 5.3+), -1 - waitpid() polling
+#endif
+    bool is_exited;
+    bool is_killed;
+    bool is_done;
+} _os_cmd_io_state_s;
+
+static void
+_cex_os__cmd__io_kill(os_cmd_io_s* io, _os_cmd_io_state_s* st, Exc reason)
+{
+    if (st->is_killed || st->is_exited) { return; }
+    if (subprocess_terminate(&io->cmd->_subpr)) {} // result ignored, exit is checked anyway
+    st->is_killed = true;
+    if (io->result == EOK) { io->result = reason; }
+}
+
+static void
+_cex_os__cmd__io_deliver(os_cmd_io_s* io, _os_cmd_io_state_s* st, bool is_stderr, str_s data)
+{
+    sbuf_c* sb = (is_stderr) ? io->err : io->out;
+    if (sb) {
+        e$except_silent (err, sbuf.appendf(sb, "%S", data)) { _cex_os__cmd__io_kill(io, st, err); }
+    }
+    if (io->on_data) {
+        e$except_silent (err, io->on_data(io->cmd, is_stderr, data, io->user_ctx)) {
+            _cex_os__cmd__io_kill(io, st, err);
+        }
+    }
+}
+
+static void
+_cex_os__cmd__io_finish(os_cmd_io_s* io, _os_cmd_io_state_s* st)
+{
+    if (io->cmd->_subpr.stdin_file) {
+        fclose(io->cmd->_subpr.stdin_file);
+        io->cmd->_subpr.stdin_file = NULL;
+    }
+#ifndef _WIN32
+    if (st->fd_pid >= 0) { close(st->fd_pid); }
+#endif
+    // child is already exited, join only gets exit code and releases resources
+    Exc err = cex_os__cmd__join(io->cmd, 0, &io->ret_code);
+    if (io->result == EOK) { io->result = err; }
+    st->is_done = true;
+}
+
+/// Services stdin/stdout/stderr of many commands (made by os.cmd.create()) from the current thread
+/// until all of them exit, and joins them (no os.cmd.join() needed). Returns first failed
+/// ios[i].result. NOTE: don't mix with os.cmd.read_line()/os.cmd.fstdout() buffered reads.
+static Exception
+cex_os__cmd__communicate(os_cmd_io_s* ios, u32 ios_len)
+{
+    if (ios == NULL || ios_len == 0) { return e$raise(Error.argument, "`ios` is empty or null"); }
+    for (u32 i = 0; i < ios_len; i++) {
+        os_cmd_c* cmd = ios[i].cmd;
+        if (cmd == NULL || !cmd->_is_subprocess || cmd->_subpr.stdout_file == NULL) {
+            return e$raise(Error.argument, "ios[%d].cmd must be created by os.cmd.create()", i);
+        }
+        ios[i].ret_code = -1;
+        ios[i].result = EOK;
+    }
+
+    Exc result = EOK;
+    char buf[16 * 1024];
+    f64 t_start = os.timer();
+    // NOTE: no tmem$ scope here, ios[i].out/err may be allocated by outer tmem$ scope
+    _os_cmd_io_state_s* states = mem$calloc(mem$, ios_len, sizeof(_os_cmd_io_state_s));
+    if (states == NULL) { return Error.memory; }
+#ifndef _WIN32
+    struct pollfd* pfds = mem$calloc(mem$, ios_len * 4, sizeof(struct pollfd));
+    u32* pfd_owners = mem$calloc(mem$, ios_len * 4, sizeof(u32));
+    if (pfds == NULL || pfd_owners == NULL) {
+        result = Error.memory;
+        goto end;
+    }
+#endif
+
+    bool has_stdin = false;
+    for (u32 i = 0; i < ios_len; i++) {
+        os_cmd_io_s* io = &ios[i];
+        _os_cmd_io_state_s* st = &states[i];
+        struct subprocess_s* sp = &io->cmd->_subpr;
+        if (io->timeout_ms) { st->deadline = t_start + io->timeout_ms / 1000.0; }
+        if (sp->stdin_file && io->stdin_data.len == 0) {
+            fclose(sp->stdin_file);
+            sp->stdin_file = NULL;
+        }
+        has_stdin |= sp->stdin_file != NULL;
+#ifdef _WIN32
+        st->h_out = (HANDLE)_get_osfhandle(_fileno(sp->stdout_file));
+        st->h_err = (sp->stderr_file && sp->stderr_file != sp->stdout_file)
+                      ? (HANDLE)_get_osfhandle(_fileno(sp->stderr_file))
+                      : INVALID_HANDLE_VALUE;
+        if (sp->stdin_file) {
+            // NOTE: anonymous pipes have no non-blocking mode on Windows, stdin is written at
+            // once, this may block if child is not reading stdin
+            HANDLE h_in = (HANDLE)_get_osfhandle(_fileno(sp->stdin_file));
+            while (st->in_written < io->stdin_data.len) {
+                DWORD n = 0;
+                usize len = io->stdin_data.len - st->in_written;
+                if (len > INT32_MAX) { len = INT32_MAX; }
+                if (!WriteFile(h_in, io->stdin_data.buf + st->in_written, len, &n, NULL)) {
+                    break;
+                }
+                st->in_written += n;
+            }
+            fclose(sp->stdin_file);
+            sp->stdin_file = NULL;
+        }
+#else
+        st->fd_out = fileno(sp->stdout_file);
+        st->fd_err = (sp->stderr_file && sp->stderr_file != sp->stdout_file)
+                       ? fileno(sp->stderr_file)
+                       : -1;
+        st->fd_in = (sp->stdin_file) ? fileno(sp->stdin_file) : -1;
+        st->fd_pid = -1;
+#    if defined(__linux__) && defined(SYS_pidfd_open)
+        st->fd_pid = syscall(SYS_pidfd_open, sp->child, 0);
+#    endif
+        int fds[] = { st->fd_out, st->fd_err, st->fd_in };
+        for$each (fd, fds) {
+            if (fd >= 0) { fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK); }
+        }
+#endif
+    }
+
+#ifdef _WIN32
+    (void)has_stdin;
+    u32 n_done = 0;
+    while (n_done < ios_len) {
+        bool is_idle = true;
+        for (u32 i = 0; i < ios_len; i++) {
+            os_cmd_io_s* io = &ios[i];
+            _os_cmd_io_state_s* st = &states[i];
+            if (st->is_done) { continue; }
+
+            HANDLE* handles[] = { &st->h_out, &st->h_err };
+            for (u32 k = 0; k < arr$len(handles); k++) {
+                if (*handles[k] == INVALID_HANDLE_VALUE) { continue; }
+                DWORD avail = 0;
+                if (!PeekNamedPipe(*handles[k], NULL, 0, NULL, &avail, NULL)) {
+                    *handles[k] = INVALID_HANDLE_VALUE; // broken pipe -> EOF
+                    continue;
+                }
+                if (avail == 0) { continue; }
+                DWORD n = 0;
+                if (avail > sizeof(buf)) { avail = sizeof(buf); }
+                if (!ReadFile(*handles[k], buf, avail, &n, NULL) || n == 0) {
+                    *handles[k] = INVALID_HANDLE_VALUE;
+                    continue;
+                }
+                is_idle = false;
+                _cex_os__cmd__io_deliver(io, st, k == 1, (str_s){ .buf = buf, .len = n });
+            }
+
+            if (!st->is_exited) {
+                st->is_exited = WaitForSingleObject(io->cmd->_subpr.hProcess, 0) ==
+                                WAIT_OBJECT_0;
+            }
+            if (!st->is_exited && st->deadline > 0 && os.timer() >= st->deadline) {
+                _cex_os__cmd__io_kill(io, st, Error.timeout);
+            }
+            if (st->is_exited && (st->is_killed || (st->h_out == INVALID_HANDLE_VALUE &&
+                                                    st->h_err == INVALID_HANDLE_VALUE))) {
+                _cex_os__cmd__io_finish(io, st);
+                n_done++;
+                is_idle = false;
+            }
+        }
+        if (is_idle) { cex_os_sleep(1); }
+    }
+#else
+    // writing into pipe of exited child must not kill us, SIGPIPE is blocked only for this
+    // thread (the process-wide handler is not touched, other threads may rely on it)
+    sigset_t sigpipe_set;
+    sigset_t sigmask_prev;
+    bool sigpipe_was_pending = false;
+    sigemptyset(&sigpipe_set);
+    sigaddset(&sigpipe_set, SIGPIPE);
+    if (has_stdin) {
+        sigset_t pending;
+        sigpending(&pending);
+        sigpipe_was_pending = sigismember(&pending, SIGPIPE);
+        pthread_sigmask(SIG_BLOCK, &sigpipe_set, &sigmask_prev);
+    }
+
+    u32 n_done = 0;
+    while (n_done < ios_len) {
+        u32 n_pfds = 0;
+        int timeout_ms = -1;
+        f64 now = os.timer();
+        for (u32 i = 0; i < ios_len; i++) {
+            _os_cmd_io_state_s* st = &states[i];
+            if (st->is_done) { continue; }
+            int fds[] = { st->fd_out, st->fd_err, st->fd_in, st->is_exited ? -1 : st->fd_pid };
+            for (u32 k = 0; k < arr$len(fds); k++) {
+                if (fds[k] < 0) { continue; }
+                pfds[n_pfds] = (struct pollfd){ .fd = fds[k] };
+                pfds[n_pfds].events = (k == 2) ? POLLOUT : POLLIN;
+                pfd_owners[n_pfds] = i;
+                n_pfds++;
+            }
+            int t_ms = -1;
+            if (!st->is_exited && st->fd_pid < 0) { t_ms = 10; } // no pidfd, polling exit
+            if (st->deadline > 0 && !st->is_killed) {
+                f64 remaining = (st->deadline - now) * 1000.0;
+                int r_ms = (remaining > 0) ? (int)remaining + 1 : 0;
+                if (t_ms < 0 || r_ms < t_ms) { t_ms = r_ms; }
+            }
+            if (t_ms >= 0 && (timeout_ms < 0 || t_ms < timeout_ms)) { timeout_ms = t_ms; }
+        }
+
+        int n_ready = poll(pfds, n_pfds, timeout_ms);
+        if (n_ready < 0) {
+            if (errno != EINTR) { cex_os_sleep(1); }
+            n_ready = 0;
+        }
+
+        for (u32 p = 0; p < n_pfds && n_ready > 0; p++) {
+            if (pfds[p].revents == 0) { continue; }
+            n_ready--;
+            os_cmd_io_s* io = &ios[pfd_owners[p]];
+            _os_cmd_io_state_s* st = &states[pfd_owners[p]];
+            int fd = pfds[p].fd;
+
+            if (fd == st->fd_out || fd == st->fd_err) {
+                isize n = read(fd, buf, sizeof(buf));
+                if (n > 0) {
+                    str_s data = { .buf = buf, .len = n };
+                    _cex_os__cmd__io_deliver(io, st, fd == st->fd_err, data);
+                } else if (n == 0 || (errno != EAGAIN && errno != EINTR)) {
+                    // EOF, the file is closed by os.cmd.join()
+                    if (fd == st->fd_out) {
+                        st->fd_out = -1;
+                    } else {
+                        st->fd_err = -1;
+                    }
+                }
+            } else if (fd == st->fd_in) {
+                isize n = write(
+                    fd,
+                    io->stdin_data.buf + st->in_written,
+                    io->stdin_data.len - st->in_written
+                );
+                if (n > 0) { st->in_written += n; }
+                if (st->in_written == io->stdin_data.len ||
+                    (n < 0 && errno != EAGAIN && errno != EINTR)) {
+                    // all written, or child closed its stdin (EPIPE)
+                    fclose(io->cmd->_subpr.stdin_file);
+                    io->cmd->_subpr.stdin_file = NULL;
+                    st->fd_in = -1;
+                }
+            }
+            // pidfd readiness is handled by waitpid() below
+        }
+
+        now = os.timer();
+        for (u32 i = 0; i < ios_len; i++) {
+            os_cmd_io_s* io = &ios[i];
+            _os_cmd_io_state_s* st = &states[i];
+            if (st->is_done) { continue; }
+            struct subprocess_s* sp = &io->cmd->_subpr;
+
+            if (!st->is_exited) {
+                int status = 0;
+                if (waitpid(sp->child, &status, WNOHANG) == sp->child) {
+                    // os.cmd.join() will use saved exit code
+                    sp->child = 0;
+                    sp->alive = 0;
+                    sp->return_status = WIFEXITED(status) ? WEXITSTATUS(status)
+                                                          : 128 + WTERMSIG(status);
+                    st->is_exited = true;
+                } else if (st->deadline > 0 && now >= st->deadline) {
+                    _cex_os__cmd__io_kill(io, st, Error.timeout);
+                }
+            }
+            if (st->is_exited && (st->is_killed || (st->fd_out < 0 && st->fd_err < 0))) {
+                _cex_os__cmd__io_finish(io, st);
+                n_done++;
+            }
+        }
+    }
+    if (has_stdin) {
+        if (!sigpipe_was_pending) {
+            // discard SIGPIPE raised by our writes before unblocking, or it would be delivered
+            sigset_t pending;
+            sigpending(&pending);
+            if (sigismember(&pending, SIGPIPE)) {
+#    if defined(__APPLE__)
+                int sig;
+                sigwait(&sigpipe_set, &sig); // pending already, does not block
+#    else
+                struct timespec no_wait = { 0 };
+                while (sigtimedwait(&sigpipe_set, NULL, &no_wait) < 0 && errno == EINTR) {}
+#    endif
+            }
+        }
+        pthread_sigmask(SIG_SETMASK, &sigmask_prev, NULL);
+    }
+#endif
+
+    for (u32 i = 0; i < ios_len; i++) {
+        if (ios[i].result != EOK) {
+            result = ios[i].result;
+            break;
+        }
+    }
+
+end:
+#ifndef _WIN32
+    if (pfds) { mem$free(mem$, pfds); }
+    if (pfd_owners) { mem$free(mem$, pfd_owners); }
+#endif
+    mem$free(mem$, states);
+    return result;
+}
+
 /// Returns current OS platform, returns enum of OSPlatform__*, e.g. OSPlatform__win,
 /// OSPlatform__linux, OSPlatform__macos, etc..
 static OSPlatform_e
@@ -1246,6 +2285,22 @@ cex_os__platform__current_str(void)
     return os.platform.to_str(os.platform.current());
 }
 
+/// Returns number of online CPU cores (at least 1)
+static u32
+cex_os__platform__cpu_count(void)
+{
+#if defined(_WIN32)
+    SYSTEM_INFO si;
+    GetSystemInfo(&si);
+    return (si.dwNumberOfProcessors > 0) ? (u32)si.dwNumberOfProcessors : 1;
+#elif defined(_SC_NPROCESSORS_ONLN)
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return (n > 0) ? (u32)n : 1;
+#else
+    return 1;
+#endif
+}
+
 /// Converts platform name to enum
 static OSPlatform_e
 cex_os__platform__from_str(char* name)
@@ -1295,6 +2350,7 @@ const struct __cex_namespace__os os = {
     .timer = cex_os_timer,
 
     .cmd = {
+        .communicate = cex_os__cmd__communicate,
         .create = cex_os__cmd__create,
         .exists = cex_os__cmd__exists,
         .fstderr = cex_os__cmd__fstderr,
@@ -1303,6 +2359,10 @@ const struct __cex_namespace__os os = {
         .is_alive = cex_os__cmd__is_alive,
         .join = cex_os__cmd__join,
         .kill = cex_os__cmd__kill,
+        .pool_add = cex_os__cmd__pool_add,
+        .pool_create = cex_os__cmd__pool_create,
+        .pool_destroy = cex_os__cmd__pool_destroy,
+        .pool_join = cex_os__cmd__pool_join,
         .read_all = cex_os__cmd__read_all,
         .read_line = cex_os__cmd__read_line,
         .run = cex_os__cmd__run,
@@ -1318,6 +2378,7 @@ const struct __cex_namespace__os os = {
         .chdir = cex_os__fs__chdir,
         .copy = cex_os__fs__copy,
         .copy_tree = cex_os__fs__copy_tree,
+        .copy_tree_parallel = cex_os__fs__copy_tree_parallel,
         .dir_walk = cex_os__fs__dir_walk,
         .find = cex_os__fs__find,
         .getcwd = cex_os__fs__getcwd,
@@ -1327,6 +2388,7 @@ const struct __cex_namespace__os os = {
         .remove_tree = cex_os__fs__remove_tree,
         .rename = cex_os__fs__rename,
         .stat = cex_os__fs__stat,
+        .walk = cex_os__fs__walk,
     },
 
     .path = {
@@ -1341,6 +2403,7 @@ const struct __cex_namespace__os os = {
     .platform = {
         .arch_from_str = cex_os__platform__arch_from_str,
         .arch_to_str = cex_os__platform__arch_to_str,
+        .cpu_count = cex_os__platform__cpu_count,
         .current = cex_os__platform__current,
         .current_str = cex_os__platform__current_str,
         .from_str = cex_os__platform__from_str,
@@ -34,6 +34,55 @@ typedef struct os_cmd_c
     bool _is_subprocess;
 } os_cmd_c;
 
+/// Options for os.cmd.pool_create()
+typedef struct os_cmd_pool_opts_s
+{
+    u32 n_jobs;       // max number of concurrently running commands (0 - cpu count)
+    bool keep_going;  // if true - keeps launching jobs after failure (default: fail fast)
+    bool keep_output; // if true - captured output is stored in os_cmd_job_s.output
+    bool no_print;    // if true - captured output is not printed to stdout on job completion
+} os_cmd_pool_opts_s;
+
+/// Job record of os_cmd_pool_c (see os_cmd_pool_c.jobs)
+typedef struct os_cmd_job_s
+{
+    char** args;  // NULL terminated copy of command arguments
+    char* output; // combined stdout/stderr (NULL if empty or opts.keep_output is not set)
+    i32 ret_code; // process exit code (128+signal if killed, -1 if not started)
+    Exc err;      // EOK, Error.runtime if ret_code != 0, or launch error
+    bool is_done;
+} os_cmd_job_s;
+
+/// Pool of concurrently running commands with captured output (see os.cmd.pool_create())
+typedef struct os_cmd_pool_c
+{
+    arr$(os_cmd_job_s) jobs; // all jobs in order of os.cmd.pool_add() calls
+    os_cmd_pool_opts_s opts;
+    IAllocator allc;
+    struct _os_cmd_pool_slot_s* _slots; // running children, opts.n_jobs capacity
+    u32 n_running;
+    u32 n_failed;
+    Exc err; // first failure, sticky
+} os_cmd_pool_c;
+
+/// os.cmd.communicate() output callback, called for each chunk of child stdout/stderr data,
+/// returning error kills the child
+typedef Exception os_cmd_data_f(os_cmd_c* cmd, bool is_stderr, str_s data, void* user_ctx);
+
+/// Command I/O record of os.cmd.communicate()
+typedef struct os_cmd_io_s
+{
+    os_cmd_c* cmd;          // command made by os.cmd.create()
+    str_s stdin_data;       // written to child stdin, then stdin is closed
+    sbuf_c* out;            // if not NULL - appends child stdout (or combined stdout/stderr)
+    sbuf_c* err;            // if not NULL - appends child stderr
+    os_cmd_data_f* on_data; // if not NULL - called on each output chunk
+    void* user_ctx;         // on_data user_ctx
+    u32 timeout_ms;         // 0 - no timeout, otherwise child is killed after timeout
+    i32 ret_code;           // (result) child exit code
+    Exc result;             // (result) EOK, Error.runtime (ret_code != 0), Error.timeout, etc.
+} os_cmd_io_s;
+
 /// File stats metadata (cross-platform), returned by os.fs.stats
 typedef struct os_fs_stat_s
 {
@@ -53,6 +102,18 @@ static_assert(sizeof(os_fs_stat_s) <= sizeof(u64) * 2, "size?");
 
 typedef Exception os_fs_dir_walk_f(char* path, os_fs_stat_s ftype, void* user_ctx);
 
+/// Options of os.fs.walk()
+typedef struct os_fs_walk_opts_s
+{
+    u32 n_threads;     // number of walker threads (0 - os.platform.cpu_count(), 1 - current thread)
+    bool is_recursive; // walk into sub-directories (symlinks to directories are not followed)
+    bool with_stat;    // fill ftype.size/ftype.mtime (extra stat() call for each entry)
+} os_fs_walk_opts_s;
+
+/// os.fs.walk() callback, `thread_idx` is less than number of threads, and can be used as index of
+/// per-thread contexts in user_ctx
+typedef Exception os_fs_walk_f(char* path, os_fs_stat_s ftype, u32 thread_idx, void* user_ctx);
+
 #define _CexOSPlatformList                                                                         \
     X(linux)                                                                                       \
     X(win)                                                                                         \
@@ -223,6 +284,37 @@ mem$scope(tmem$, _)
 }
 ```
 
+- Running commands in parallel (job pool, output of each job is printed at once on completion)
+```c
+mem$scope(tmem$, _)
+{
+    os_cmd_pool_c pool;
+    e$ret(os.cmd.pool_create(&pool, &(os_cmd_pool_opts_s){ .n_jobs = 8 }, _));
+    for$each (src, sources) { // arr$(char*) of .c files
+        char* args[] = { cexy$cc, "-c", src, "-o", str.fmt(_, "%s.o", src), NULL };
+        if (os.cmd.pool_add(&pool, args, arr$len(args))) { break; } // fail fast
+    }
+    Exc err = os.cmd.pool_join(&pool);
+    os.cmd.pool_destroy(&pool);
+    e$ret(err);
+}
+```
+
+- Serving stdin/stdout/stderr of many commands from one thread (no pipe deadlocks)
+```c
+mem$scope(tmem$, _)
+{
+    os_cmd_c cmd = { 0 };
+    char* args[] = { "sort", NULL };
+    e$ret(os.cmd.create(&cmd, args, arr$len(args), NULL));
+
+    sbuf_c out = sbuf.create(1024, _);
+    os_cmd_io_s cio = { .cmd = &cmd, .stdin_data = str$s("b\na\n"), .out = &out, .timeout_ms = 5000 };
+    e$ret(os.cmd.communicate(&cio, 1)); // may pass array of many os_cmd_io_s
+    io.printf("%s", out);
+}
+```
+
 - Getting command output (low level api)
 ```c
 
@@ -285,7 +377,11 @@ struct __cex_namespace__os
     f64             (*timer)(void);
 
     struct {
-        /// Creates new os command (use os$cmd() and os$cmd() for easy cases)
+        /// Services stdin/stdout/stderr of many commands (made by os.cmd.create()) from the current thread
+        /// until all of them exit, and joins them (no os.cmd.join() needed). Returns first failed
+        /// ios[i].result. NOTE: don't mix with os.cmd.read_line()/os.cmd.fstdout() buffered reads.
+        Exception       (*communicate)(os_cmd_io_s* ios, u32 ios_len);
+        /// Creates new os command (use os$cmd() and os$cmd() for easy cases). flags can be NULL.
         Exception       (*create)(os_cmd_c* self, char** args, usize args_len, os_cmd_flags_s* flags);
         /// Check if `cmd_exe` program name exists in PATH. cmd_exe can be absolute, or simple command name,
         /// e.g. `cat`
@@ -303,6 +399,19 @@ struct __cex_namespace__os
         Exception       (*join)(os_cmd_c* self, u32 timeout_sec, i32* out_ret_code);
         /// Terminates the running process
         Exception       (*kill)(os_cmd_c* self);
+        /// Adds new job to the pool, args are copied and must be NULL terminated (same as os.cmd.run()).
+        /// Blocks while all opts.n_jobs slots are busy. Returns error of the first failed job (without
+        /// launching a new one) unless opts.keep_going is set.
+        Exception       (*pool_add)(os_cmd_pool_c* self, char** args, usize args_len);
+        /// Creates pool of concurrently running commands, opts can be NULL (cpu count jobs, fail fast,
+        /// output printed per job). Job outputs are captured and printed as a whole on job completion,
+        /// so parallel outputs never interleave.
+        Exception       (*pool_create)(os_cmd_pool_c* self, os_cmd_pool_opts_s* opts, IAllocator allc);
+        /// Terminates still running jobs and frees pool resources
+        void            (*pool_destroy)(os_cmd_pool_c* self);
+        /// Waits all running jobs to finish, returns error of the first failed job (check
+        /// os_cmd_pool_c.jobs for individual results)
+        Exception       (*pool_join)(os_cmd_pool_c* self);
         /// Read all output from process stdout, NULL if stdout is not available
         char*           (*read_all)(os_cmd_c* self, IAllocator allc);
         /// Read line from process stdout, NULL if stdout is not available
@@ -323,11 +432,15 @@ struct __cex_namespace__os
     struct {
         /// Change current working directory
         Exception       (*chdir)(char* path);
-        /// Copy file
+        /// Copy file (uses copy-on-write clone or in-kernel copy when possible, keeps sparse file holes,
+        /// permissions, and modification time)
         Exception       (*copy)(char* src_path, char* dst_path);
         /// Copy directory recursively
         Exception       (*copy_tree)(char* src_dir, char* dst_dir);
-        /// Iterates over directory (can be recursive) using callback function
+        /// Copy directory recursively using up to `n_threads` parallel file copies (0 - cpu count)
+        Exception       (*copy_tree_parallel)(char* src_dir, char* dst_dir, u32 n_threads);
+        /// Iterates over directory (can be recursive) using callback function. Entry types are taken from
+        /// the directory listing, ftype.size/ftype.mtime are not filled (see os.fs.walk() with_stat option)
         Exception       (*dir_walk)(char* path, bool is_recursive, os_fs_dir_walk_f callback_fn, void* user_ctx);
         /// Finds files in `dir/pattern`, for example "./mydir/*.c" (all c files), if is_recursive=true, all
         /// *.c files found in sub-directories.
@@ -346,6 +459,11 @@ struct __cex_namespace__os
         Exception       (*rename)(char* old_path, char* new_path);
         /// Returns cross-platform path stats information (see os_fs_stat_s)
         os_fs_stat_s    (*stat)(char* path);
+        /// Walks directory entries, calling `callback_fn(path, ftype, thread_idx, user_ctx)`, opts can be
+        /// NULL (non-recursive, single threaded). With n_threads != 1 callbacks are called from multiple
+        /// threads (in arbitrary order, directory callback comes before its contents). Entry types are taken
+        /// from the directory listing, set opts.with_stat for ftype.size/ftype.mtime.
+        Exception       (*walk)(char* path, os_fs_walk_opts_s* opts, os_fs_walk_f callback_fn, void* user_ctx);
     } fs;
 
     struct {
@@ -369,6 +487,8 @@ struct __cex_namespace__os
         OSArch_e        (*arch_from_str)(char* name);
         /// Converts arch to string
         char*           (*arch_to_str)(OSArch_e platform);
+        /// Returns number of online CPU cores (at least 1)
+        u32             (*cpu_count)(void);
         /// Returns current OS platform, returns enum of OSPlatform__*, e.g. OSPlatform__win,
         /// OSPlatform__linux, OSPlatform__macos, etc..
         OSPlatform_e    (*current)(void);
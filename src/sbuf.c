@@ -381,6 +381,288 @@ cex_sbuf_isvalid(sbuf_c* self)
     }
 }
 
+static sbuf_rope_chunk_s*
+_sbuf__rope_new_chunk(sbuf_rope_c* self, usize capacity)
+{
+    // NOTE: +1 byte for null terminator of chunk data
+    sbuf_rope_chunk_s* c = mem$malloc(self->allocator, sizeof(sbuf_rope_chunk_s) + capacity + 1);
+    if (unlikely(c == NULL)) {
+        self->err = Error.memory;
+        return NULL;
+    }
+    c->next = NULL;
+    c->length = 0;
+    c->capacity = capacity;
+    c->data[0] = '\0';
+
+    if (self->last) {
+        self->last->next = c;
+    } else {
+        self->first = c;
+    }
+    self->last = c;
+    return c;
+}
+
+static Exc
+_sbuf__rope_write(sbuf_rope_c* self, char* s, usize len)
+{
+    while (len > 0) {
+        sbuf_rope_chunk_s* c = self->last;
+        if (c == NULL || c->length == c->capacity) {
+            c = _sbuf__rope_new_chunk(self, self->chunk_size);
+            if (unlikely(c == NULL)) { return self->err; }
+        }
+        usize n = c->capacity - c->length;
+        if (n > len) { n = len; }
+
+        memcpy(c->data + c->length, s, n);
+        c->length += n;
+        c->data[c->length] = '\0';
+        self->length += n;
+        s += n;
+        len -= n;
+    }
+    return EOK;
+}
+
+/// Creates chunked string builder (rope), chunk_size=0 uses CEX_SBUF_ROPE_CHUNK. Nothing is
+/// allocated until first append.
+static sbuf_rope_c
+cex_sbuf__rope__create(usize chunk_size, IAllocator allocator)
+{
+    uassert(allocator != NULL);
+    if (chunk_size == 0) { chunk_size = CEX_SBUF_ROPE_CHUNK; }
+    if (chunk_size < CEX_SPRINTF_MIN * 2) { chunk_size = CEX_SPRINTF_MIN * 2; }
+
+    return (sbuf_rope_c){
+        .allocator = allocator,
+        .chunk_size = chunk_size,
+        .err = (allocator == NULL) ? Error.argument : EOK,
+    };
+}
+
+/// Append string to the rope
+static Exc
+cex_sbuf__rope__append(sbuf_rope_c* self, char* s)
+{
+    uassert(self != NULL);
+    if (unlikely(self->err)) { return self->err; }
+    if (unlikely(s == NULL)) {
+        self->err = Error.argument;
+        return Error.argument;
+    }
+    return _sbuf__rope_write(self, s, strlen(s));
+}
+
+struct _sbuf__rope_sprintf_ctx
+{
+    sbuf_rope_c* rope;
+    char tmp[CEX_SPRINTF_MIN];
+};
+
+static char*
+_cex_sbuf__rope_sprintf_callback(char* buf, void* user, u32 len)
+{
+    struct _sbuf__rope_sprintf_ctx* ctx = (struct _sbuf__rope_sprintf_ctx*)user;
+    sbuf_rope_c* rope = ctx->rope;
+    if (unlikely(rope->err != EOK)) { return NULL; }
+
+    sbuf_rope_chunk_s* c = rope->last;
+    if (len > 0) {
+        if (c != NULL && buf == c->data + c->length) {
+            // engine has written directly into the chunk
+            uassert(c->length + len <= c->capacity && "out of bounds");
+            c->length += len;
+            rope->length += len;
+        } else if (_sbuf__rope_write(rope, buf, len)) {
+            return NULL;
+        }
+        c = rope->last;
+    }
+
+    if (c == NULL || c->length == c->capacity) {
+        c = _sbuf__rope_new_chunk(rope, rope->chunk_size);
+        if (unlikely(c == NULL)) { return NULL; }
+    }
+    return ((c->capacity - c->length) >= CEX_SPRINTF_MIN) ? c->data + c->length : ctx->tmp;
+}
+
+/// Append format va to the rope (using CEX formatting engine)
+static Exc
+cex_sbuf__rope__appendfva(sbuf_rope_c* self, char* format, va_list va)
+{
+    uassert(self != NULL);
+    if (unlikely(self->err)) { return self->err; }
+    if (unlikely(format == NULL)) {
+        self->err = Error.argument;
+        return Error.argument;
+    }
+
+    struct _sbuf__rope_sprintf_ctx ctx = { .rope = self };
+    char* buf = _cex_sbuf__rope_sprintf_callback(NULL, &ctx, 0);
+    if (unlikely(buf == NULL)) { return self->err; }
+
+    cexsp__vsprintfcb(_cex_sbuf__rope_sprintf_callback, &ctx, buf, format, va);
+
+    if (self->last) { self->last->data[self->last->length] = '\0'; }
+    return self->err;
+}
+
+/// Append format to the rope (using CEX formatting engine)
+static Exc
+cex_sbuf__rope__appendf(sbuf_rope_c* self, char* format, ...)
+{
+    va_list va;
+    va_start(va, format);
+    Exc result = cex_sbuf__rope__appendfva(self, format, va);
+    va_end(va);
+    return result;
+}
+
+/// Returns total rope length (64-bit)
+static u64
+cex_sbuf__rope__len(sbuf_rope_c* self)
+{
+    uassert(self != NULL);
+    if (unlikely(self->err)) { return 0; }
+    return self->length;
+}
+
+/// Writes all rope chunks into the stream, without making contiguous copy
+static Exception
+cex_sbuf__rope__fwrite(sbuf_rope_c* self, FILE* stream)
+{
+    uassert(self != NULL);
+    if (unlikely(self->err)) { return self->err; }
+    if (unlikely(stream == NULL)) { return Error.argument; }
+
+    for (sbuf_rope_chunk_s* c = self->first; c != NULL; c = c->next) {
+        if (c->length == 0) { continue; }
+        if (fwrite(c->data, sizeof(char), c->length, stream) != c->length) { return Error.io; }
+    }
+    return EOK;
+}
+
+/// Iterates over rope chunks as slices: for$iter (str_s, it, sbuf.rope.iter(&r, &it.iterator))
+static str_s
+cex_sbuf__rope__iter(sbuf_rope_c* self, cex_iterator_s* iterator)
+{
+    uassert(self != NULL);
+    uassert(iterator != NULL && "null iterator");
+
+    struct iter_ctx
+    {
+        sbuf_rope_chunk_s* chunk;
+    }* ctx = (struct iter_ctx*)iterator->_ctx;
+    static_assert(sizeof(*ctx) <= sizeof(iterator->_ctx), "ctx size overflow");
+
+    if (unlikely(!iterator->initialized)) {
+        iterator->initialized = 1;
+        ctx->chunk = (self->err) ? NULL : self->first;
+        iterator->idx.i = 0;
+    } else {
+        ctx->chunk = ctx->chunk->next;
+        iterator->idx.i++;
+    }
+    if (ctx->chunk == NULL) {
+        iterator->stopped = 1;
+        return (str_s){ 0 };
+    }
+    return (str_s){ .buf = ctx->chunk->data, .len = ctx->chunk->length };
+}
+
+/// Returns contiguous null-terminated rope contents, rope is merged into a single chunk (only once,
+/// until next append). Returns NULL on error.
+static char*
+cex_sbuf__rope__flatten(sbuf_rope_c* self)
+{
+    uassert(self != NULL);
+    if (unlikely(self->err)) { return NULL; }
+
+    if (self->first == NULL) {
+        if (_sbuf__rope_new_chunk(self, self->chunk_size) == NULL) { return NULL; }
+    }
+    if (self->first == self->last) { return self->first->data; }
+
+    if (unlikely(self->length >= PTRDIFF_MAX)) {
+        self->err = Error.overflow;
+        return NULL;
+    }
+    usize len = self->length;
+    sbuf_rope_chunk_s* first = self->first;
+    sbuf_rope_chunk_s* last = self->last;
+    self->first = self->last = NULL;
+    sbuf_rope_chunk_s* flat = _sbuf__rope_new_chunk(self, len);
+    if (unlikely(flat == NULL)) {
+        // keep existing data valid
+        self->first = first;
+        self->last = last;
+        return NULL;
+    }
+
+    char* d = flat->data;
+    sbuf_rope_chunk_s* c = first;
+    while (c != NULL) {
+        memcpy(d, c->data, c->length);
+        d += c->length;
+        sbuf_rope_chunk_s* next = c->next;
+        mem$free(self->allocator, c);
+        c = next;
+    }
+    flat->length = len;
+    flat->data[len] = '\0';
+    self->first = self->last = flat;
+
+    return flat->data;
+}
+
+/// Clears rope contents, keeps first chunk allocated
+static void
+cex_sbuf__rope__clear(sbuf_rope_c* self)
+{
+    uassert(self != NULL);
+    if (unlikely(self->err)) { return; }
+    if (self->first == NULL) { return; }
+
+    sbuf_rope_chunk_s* c = self->first->next;
+    while (c != NULL) {
+        sbuf_rope_chunk_s* next = c->next;
+        mem$free(self->allocator, c);
+        c = next;
+    }
+    self->first->next = NULL;
+    self->first->length = 0;
+    self->first->data[0] = '\0';
+    self->last = self->first;
+    self->length = 0;
+}
+
+/// Destroys the rope and deallocates all chunks
+static void
+cex_sbuf__rope__destroy(sbuf_rope_c* self)
+{
+    uassert(self != NULL);
+    sbuf_rope_chunk_s* c = self->first;
+    while (c != NULL) {
+        sbuf_rope_chunk_s* next = c->next;
+        mem$free(self->allocator, c);
+        c = next;
+    }
+    *self = (sbuf_rope_c){ 0 };
+}
+
+/// Validate rope state, returns sticky error of the last failed operation
+static Exception
+cex_sbuf__rope__validate(sbuf_rope_c* self)
+{
+    if (unlikely(self == NULL)) { return "NULL argument"; }
+    if (unlikely(self->err)) { return self->err; }
+    if (unlikely(self->allocator == NULL)) { return "Not initialized or destroyed"; }
+    if (unlikely(self->first == NULL && self->length != 0)) { return "Bad length"; }
+    return EOK;
+}
+
 const struct __cex_namespace__sbuf sbuf = {
     // Autogenerated by CEX
     // clang-format off
@@ -398,6 +680,20 @@ const struct __cex_namespace__sbuf sbuf = {
     .shrink = cex_sbuf_shrink,
     .validate = cex_sbuf_validate,
 
+    .rope = {
+        .append = cex_sbuf__rope__append,
+        .appendf = cex_sbuf__rope__appendf,
+        .appendfva = cex_sbuf__rope__appendfva,
+        .clear = cex_sbuf__rope__clear,
+        .create = cex_sbuf__rope__create,
+        .destroy = cex_sbuf__rope__destroy,
+        .flatten = cex_sbuf__rope__flatten,
+        .fwrite = cex_sbuf__rope__fwrite,
+        .iter = cex_sbuf__rope__iter,
+        .len = cex_sbuf__rope__len,
+        .validate = cex_sbuf__rope__validate,
+    },
+
     // clang-format on
 };
 #endif
@@ -23,6 +23,30 @@ typedef struct
 static_assert(alignof(sbuf_head_s) == 1, "align");
 static_assert(alignof(sbuf_head_s) == alignof(char), "align");
 //static_assert(sizeof(sbuf_head_s) == 36, "size");
+
+#ifndef CEX_SBUF_ROPE_CHUNK
+#    define CEX_SBUF_ROPE_CHUNK (1024 * 64) // default chunk size of sbuf.rope
+#endif
+
+/// Chunk of sbuf_rope_c (data is always null-terminated at length)
+typedef struct sbuf_rope_chunk_s
+{
+    struct sbuf_rope_chunk_s* next;
+    usize length;
+    usize capacity;
+    char data[];
+} sbuf_rope_chunk_s;
+
+/// Chunked string builder for very large outputs, appends never move existing bytes
+typedef struct sbuf_rope_c
+{
+    sbuf_rope_chunk_s* first;
+    sbuf_rope_chunk_s* last;
+    const Allocator_i* allocator;
+    Exc err;
+    u64 length;
+    usize chunk_size;
+} sbuf_rope_c;
 /**
 
 Dynamic string builder class
@@ -66,6 +90,26 @@ sbuf.clear(&s); // reset dynamic string + null term
 sbuf.destroy(&s);
 ```
 
+- Chunked string builder (rope) for very large outputs
+```c
+// NOTE: rope is a list of fixed size chunks, appending never reallocates or moves existing
+// data, length is 64-bit, and it's not limited by 2gb as regular sbuf_c
+sbuf_rope_c r = sbuf.rope.create(0, mem$); // 0 - CEX_SBUF_ROPE_CHUNK default chunk size
+
+sbuf.rope.appendf(&r, "%s, CEX slice: %S\n", "456", str$s("slice"));
+sbuf.rope.append(&r, "some string");
+
+e$ret(sbuf.rope.validate(&r)); // errors are sticky, like in sbuf_c
+
+sbuf.rope.len(&r); // u64 length
+e$ret(sbuf.rope.fwrite(&r, stdout)); // chunk by chunk writing, without copying
+
+// Contiguous null-terminated copy (lazy, rope is merged into single chunk only once)
+char* s = sbuf.rope.flatten(&r);
+
+sbuf.rope.destroy(&r);
+```
+
 - Static buffer backed string
 ```c
 
@@ -106,11 +150,38 @@ struct __cex_namespace__sbuf {
     bool            (*isvalid)(sbuf_c* self);
     /// Returns string length from its metadata
     u32             (*len)(sbuf_c* self);
-    /// Shrinks string length to new_length
+    /// Shrinks string length to new_length (fails when new_length > existing length)
     Exc             (*shrink)(sbuf_c* self, usize new_length);
     /// Validate dynamic string state, with detailed Exception
     Exception       (*validate)(sbuf_c* self);
 
+    struct {
+        /// Append string to the rope
+        Exc             (*append)(sbuf_rope_c* self, char* s);
+        /// Append format to the rope (using CEX formatting engine)
+        Exc             (*appendf)(sbuf_rope_c* self, char* format,...);
+        /// Append format va to the rope (using CEX formatting engine)
+        Exc             (*appendfva)(sbuf_rope_c* self, char* format, va_list va);
+        /// Clears rope contents, keeps first chunk allocated
+        void            (*clear)(sbuf_rope_c* self);
+        /// Creates chunked string builder (rope), chunk_size=0 uses CEX_SBUF_ROPE_CHUNK. Nothing is
+        /// allocated until first append.
+        sbuf_rope_c     (*create)(usize chunk_size, IAllocator allocator);
+        /// Destroys the rope and deallocates all chunks
+        void            (*destroy)(sbuf_rope_c* self);
+        /// Returns contiguous null-terminated rope contents, rope is merged into a single chunk (only once,
+        /// until next append). Returns NULL on error.
+        char*           (*flatten)(sbuf_rope_c* self);
+        /// Writes all rope chunks into the stream, without making contiguous copy
+        Exception       (*fwrite)(sbuf_rope_c* self, FILE* stream);
+        /// Iterates over rope chunks as slices: for$iter (str_s, it, sbuf.rope.iter(&r, &it.iterator))
+        str_s           (*iter)(sbuf_rope_c* self, cex_iterator_s* iterator);
+        /// Returns total rope length (64-bit)
+        u64             (*len)(sbuf_rope_c* self);
+        /// Validate rope state, returns sticky error of the last failed operation
+        Exception       (*validate)(sbuf_rope_c* self);
+    } rope;
+
     // clang-format on
 };
 CEX_NAMESPACE struct __cex_namespace__sbuf sbuf;
@@ -26,7 +26,7 @@ _cex_str__index(str_s* s, char* c, u8 clen)
 
     if (!_cex_str__isvalid(s)) { return -1; }
 
-    u8 split_by_idx[UINT8_MAX] = { 0 };
+    u8 split_by_idx[UINT8_MAX + 1] = { 0 };
     for (u8 i = 0; i < clen; i++) { split_by_idx[(u8)c[i]] = 1; }
 
     for (usize i = 0; i < s->len; i++) {
@@ -39,6 +39,38 @@ _cex_str__index(str_s* s, char* c, u8 clen)
     return result;
 }
 
+static inline void
+_cex_str__split_table(char* split_by, u8 split_by_idx[UINT8_MAX + 1])
+{
+    memset(split_by_idx, 0, UINT8_MAX + 1);
+    for (char* c = split_by; *c; c++) { split_by_idx[(u8)*c] = 1; }
+}
+
+// Counts tokens the same way as str.slice.iter_split() does, and their total length
+static inline usize
+_cex_str__split_count(str_s s, const u8* split_by_idx, usize* out_tokens_len)
+{
+    if (s.len == 0) {
+        *out_tokens_len = 0;
+        return 0;
+    }
+    usize n_sep = 0;
+    for (usize i = 0; i < s.len; i++) { n_sep += split_by_idx[(u8)s.buf[i]]; }
+    *out_tokens_len = s.len - n_sep;
+    return n_sep + 1;
+}
+
+// Returns token starting at *cursor, and moves cursor after the next separator
+static inline str_s
+_cex_str__split_next(str_s s, const u8* split_by_idx, usize* cursor)
+{
+    usize start = *cursor;
+    usize i = start;
+    while (i < s.len && !split_by_idx[(u8)s.buf[i]]) { i++; }
+    *cursor = i + 1;
+    return (str_s){ .buf = s.buf + start, .len = i - start };
+}
+
 /// Creates string slice of input C string (NULL tolerant, (str_s){0} on error)
 static str_s
 cex_str_sstr(char* ccharptr)
@@ -197,8 +229,7 @@ cex_str_replace(char* s, char* old_sub, char* new_sub, IAllocator allc)
         current_pos += new_sub_len;
         start = found + old_sub_len;
     }
-    // NOLINTNEXTLINE
-    strcpy(current_pos, start);
+    memcpy(current_pos, start, str_len - (start - s));
     new_str[new_str_len] = '\0';
     return new_str;
 }
@@ -615,6 +646,29 @@ cex_str__slice__iter_split(str_s s, char* split_by, cex_iterator_s* iterator)
     }
 }
 
+/// Splits slice into an existing arr$(str_s) (appends), zero-copy, items are slices of `s`.
+/// Produces the same tokens as str.slice.iter_split(), array is resized at most once.
+static Exception
+cex_str__slice__split_into(str_s s, char* split_by, arr$(str_s) * out_arr)
+{
+    if (unlikely(out_arr == NULL || *out_arr == NULL)) { return Error.argument; }
+    if (unlikely(!_cex_str__isvalid(&s) || split_by == NULL)) { return Error.argument; }
+    if (split_by[0] == '\0') { return Error.argument; }
+
+    u8 split_by_idx[UINT8_MAX + 1];
+    _cex_str__split_table(split_by, split_by_idx);
+
+    usize tokens_len = 0;
+    usize n_tokens = _cex_str__split_count(s, split_by_idx, &tokens_len);
+    if (n_tokens == 0) { return EOK; }
+    if (!arr$grow_check(*out_arr, n_tokens)) { return Error.memory; }
+
+    usize cursor = 0;
+    for (usize i = 0; i < n_tokens; i++) {
+        arr$push(*out_arr, _cex_str__split_next(s, split_by_idx, &cursor));
+    }
+    return EOK;
+}
 
 static Exception
 cex_str__to_signed_num(char* self, usize len, i64* num, i64 num_min, i64 num_max)
@@ -1093,6 +1147,220 @@ cex_str__convert__to_u64(char* s, u64* num)
     return cex_str__convert__to_u64s(str.sstr(s), num);
 }
 
+static inline usize
+_cex_str__many_tok_end(char* s, usize i, usize len, char sep)
+{
+    // NOTE: new line always terminates a token (rows of delimited values)
+    for (; i < len; i++) {
+        char c = s[i];
+        if (c == sep || c == '\n') { break; }
+    }
+    return i;
+}
+
+static inline bool
+_cex_str__many_tok_next(char* s, usize* i, usize len, char sep)
+{
+    // Consumes separator after the token, returns false if token is followed by garbage
+    usize j = *i;
+    if (sep != ' ') {
+        while (j < len && s[j] == ' ') { j++; }
+    }
+    if (j < len && s[j] == '\r' && j + 1 < len && s[j + 1] == '\n') { j++; }
+    if (j < len) {
+        if (s[j] != sep && s[j] != '\n') { return false; }
+        j++;
+    }
+    *i = j;
+    return true;
+}
+
+static Exception
+_cex_str__many_tok_slow(char* s, usize* i, usize len, char sep, bool is_float, void* out)
+{
+    // Generic path: hex, overflow checks, nan/inf, long mantissas
+    usize start = *i;
+    usize end = _cex_str__many_tok_end(s, start, len, sep);
+    usize tlen = end - start;
+    if (tlen > 0 && s[end - 1] == '\r') { tlen--; }
+    if (unlikely(tlen == 0)) { return Error.argument; }
+
+    Exc err;
+    if (is_float) {
+        err = cex_str__to_double(s + start, tlen, out, -307, 308);
+    } else {
+        err = cex_str__to_signed_num(s + start, tlen, out, INT64_MIN + 1, INT64_MAX);
+    }
+    if (err) { return err; }
+
+    *i = end;
+    if (end < len) { *i = end + 1; }
+    return EOK;
+}
+
+/// Parses `sep` (or new line) delimited run of integers from `s` into `out` (up to `out_cap`
+/// items). Sets `out_len` to number of parsed items, and `consumed` to number of processed bytes of
+/// `s` (on error it's offset of the first bad token). If out_cap reached, resume parsing from
+/// str.slice.sub(s, consumed, 0).
+static Exception
+cex_str__convert__parse_many_i64(
+    str_s s,
+    char sep,
+    i64* out,
+    usize out_cap,
+    usize* out_len,
+    usize* consumed
+)
+{
+    uassert(out_len != NULL);
+    uassert(consumed != NULL);
+    *out_len = 0;
+    *consumed = 0;
+    if (unlikely(s.buf == NULL || out == NULL)) { return Error.argument; }
+
+    char* b = s.buf;
+    usize len = s.len;
+    usize i = 0;
+    usize n = 0;
+
+    while (i < len && n < out_cap) {
+        usize tok = i;
+        while (i < len && b[i] == ' ') { i++; }
+
+        u64 neg = 0;
+        if (i < len && (b[i] == '-' || b[i] == '+')) {
+            neg = b[i] == '-';
+            i++;
+        }
+
+        // Fast path: up to 18 decimal digits never overflow i64
+        usize d0 = i;
+        u64 acc = 0;
+        u8 d;
+        while (i < len && (d = (u8)(b[i] - '0')) < 10) {
+            acc = acc * 10 + d;
+            i++;
+        }
+        usize ndigits = i - d0;
+
+        if (likely(ndigits > 0 && ndigits <= 18) && _cex_str__many_tok_next(b, &i, len, sep)) {
+            out[n++] = (i64)((acc ^ -neg) + neg);
+        } else {
+            i = tok;
+            Exc err = _cex_str__many_tok_slow(b, &i, len, sep, false, &out[n]);
+            if (unlikely(err != EOK)) {
+                *out_len = n;
+                *consumed = tok;
+                return err;
+            }
+            n++;
+        }
+    }
+
+    *out_len = n;
+    *consumed = i;
+    return EOK;
+}
+
+/// Parses `sep` (or new line) delimited run of floats from `s` into `out` (up to `out_cap`
+/// items). Sets `out_len` to number of parsed items, and `consumed` to number of processed bytes of
+/// `s` (on error it's offset of the first bad token). If out_cap reached, resume parsing from
+/// str.slice.sub(s, consumed, 0).
+static Exception
+cex_str__convert__parse_many_f64(
+    str_s s,
+    char sep,
+    f64* out,
+    usize out_cap,
+    usize* out_len,
+    usize* consumed
+)
+{
+    uassert(out_len != NULL);
+    uassert(consumed != NULL);
+    *out_len = 0;
+    *consumed = 0;
+    if (unlikely(s.buf == NULL || out == NULL)) { return Error.argument; }
+
+    // Exact powers of 10 for fast path (Clinger: mantissa < 2^53 and |exponent| <= 22)
+    static const f64 pow10[] = { 1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                                 1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                                 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+    char* b = s.buf;
+    usize len = s.len;
+    usize i = 0;
+    usize n = 0;
+
+    while (i < len && n < out_cap) {
+        usize tok = i;
+        while (i < len && b[i] == ' ') { i++; }
+
+        bool neg = false;
+        if (i < len && (b[i] == '-' || b[i] == '+')) {
+            neg = b[i] == '-';
+            i++;
+        }
+
+        u64 mant = 0;
+        i32 exp10 = 0;
+        u32 ndigits = 0;
+        u8 d;
+        while (i < len && (d = (u8)(b[i] - '0')) < 10) {
+            mant = mant * 10 + d;
+            ndigits++;
+            i++;
+        }
+        if (i < len && b[i] == '.') {
+            i++;
+            while (i < len && (d = (u8)(b[i] - '0')) < 10) {
+                mant = mant * 10 + d;
+                ndigits++;
+                exp10--;
+                i++;
+            }
+        }
+        bool fast = ndigits > 0 && ndigits <= 15;
+        if (fast && i < len && (b[i] == 'e' || b[i] == 'E')) {
+            i++;
+            i32 esign = 1;
+            if (i < len && (b[i] == '-' || b[i] == '+')) {
+                esign = b[i] == '-' ? -1 : 1;
+                i++;
+            }
+            u32 e = 0;
+            u32 edigits = 0;
+            while (i < len && (d = (u8)(b[i] - '0')) < 10 && edigits < 4) {
+                e = e * 10 + d;
+                edigits++;
+                i++;
+            }
+            fast = edigits > 0 && edigits < 4;
+            exp10 += (i32)e * esign;
+        }
+
+        if (likely(fast && exp10 >= -22 && exp10 <= 22) &&
+            _cex_str__many_tok_next(b, &i, len, sep)) {
+            f64 v = (f64)mant;
+            v = exp10 < 0 ? v / pow10[-exp10] : v * pow10[exp10];
+            out[n++] = neg ? -v : v;
+        } else {
+            i = tok;
+            Exc err = _cex_str__many_tok_slow(b, &i, len, sep, true, &out[n]);
+            if (unlikely(err != EOK)) {
+                *out_len = n;
+                *consumed = tok;
+                return err;
+            }
+            n++;
+        }
+    }
+
+    *out_len = n;
+    *consumed = i;
+    return EOK;
+}
+
 
 static char*
 _cex_str__fmt_callback(char* buf, void* user, u32 len)
@@ -1101,8 +1369,11 @@ _cex_str__fmt_callback(char* buf, void* user, u32 len)
     cexsp__context* ctx = user;
     if (unlikely(ctx->has_error)) { return NULL; }
 
+    // NOTE: the engine writes up to CEX_SPRINTF_MIN bytes into returned buffer before next call,
+    //       and small outputs are kept in ctx->tmp until the final flush
     if (unlikely(
-            len >= CEX_SPRINTF_MIN && (ctx->buf == NULL || ctx->length + len >= ctx->capacity)
+            (ctx->buf == NULL) ? len >= CEX_SPRINTF_MIN - 1
+                               : ctx->length + len + CEX_SPRINTF_MIN >= ctx->capacity
         )) {
 
         if (len > INT32_MAX || ctx->length + len > INT32_MAX) {
@@ -1112,21 +1383,19 @@ _cex_str__fmt_callback(char* buf, void* user, u32 len)
 
         uassert(ctx->allc != NULL);
 
-        if (ctx->buf == NULL) {
-            ctx->buf = mem$calloc(ctx->allc, 1, CEX_SPRINTF_MIN * 2);
-            if (ctx->buf == NULL) {
-                ctx->has_error = true;
-                return NULL;
-            }
-            ctx->capacity = CEX_SPRINTF_MIN * 2;
-        } else {
-            ctx->buf = mem$realloc(ctx->allc, ctx->buf, ctx->capacity + CEX_SPRINTF_MIN * 2);
-            if (ctx->buf == NULL) {
-                ctx->has_error = true;
-                return NULL;
-            }
-            ctx->capacity += CEX_SPRINTF_MIN * 2;
+        u32 new_capacity = ctx->capacity;
+        while (ctx->length + len + CEX_SPRINTF_MIN >= new_capacity) {
+            new_capacity += CEX_SPRINTF_MIN * 2;
         }
+        char* new_buf = (ctx->buf == NULL)
+                          ? mem$calloc(ctx->allc, 1, new_capacity)
+                          : mem$realloc(ctx->allc, ctx->buf, new_capacity);
+        if (new_buf == NULL) {
+            ctx->has_error = true;
+            return NULL;
+        }
+        ctx->buf = new_buf;
+        ctx->capacity = new_capacity;
     }
     ctx->length += len;
 
@@ -1245,17 +1514,60 @@ static arr$(char*) cex_str_split(char* s, char* split_by, IAllocator allc)
 {
     str_s src = cex_str_sstr(s);
     if (src.buf == NULL || split_by == NULL) { return NULL; }
-    arr$(char*) result = arr$new(result, allc);
+
+    u8 split_by_idx[UINT8_MAX + 1];
+    _cex_str__split_table(split_by, split_by_idx);
+    usize tokens_len = 0;
+    usize n_tokens = (split_by[0]) ? _cex_str__split_count(src, split_by_idx, &tokens_len) : 0;
+
+    arr$(char*) result = arr$new(result, allc, .capacity = n_tokens);
     if (result == NULL) { return NULL; }
 
-    for$iter (str_s, it, cex_str__slice__iter_split(src, split_by, &it.iterator)) {
-        char* tok = cex_str__slice__clone(it.val, allc);
+    usize cursor = 0;
+    for (usize i = 0; i < n_tokens; i++) {
+        char* tok = cex_str__slice__clone(_cex_str__split_next(src, split_by_idx, &cursor), allc);
         arr$push(result, tok);
     }
 
     return result;
 }
 
+/// Splits string using split_by (allows many) chars, all tokens are packed into a single memory
+/// block, which starts at result[0]. Returns NULL on error, NULL tolerant. Free with
+/// `mem$free(allc, res[0]); arr$free(res);` when heap allocator is used (only 2 allocations).
+static arr$(char*) cex_str_split_packed(char* s, char* split_by, IAllocator allc)
+{
+    str_s src = cex_str_sstr(s);
+    if (src.buf == NULL || split_by == NULL) { return NULL; }
+
+    u8 split_by_idx[UINT8_MAX + 1];
+    _cex_str__split_table(split_by, split_by_idx);
+    usize tokens_len = 0;
+    usize n_tokens = (split_by[0]) ? _cex_str__split_count(src, split_by_idx, &tokens_len) : 0;
+
+    arr$(char*) result = arr$new(result, allc, .capacity = n_tokens);
+    if (result == NULL) { return NULL; }
+    if (n_tokens == 0) { return result; }
+
+    // every token gets its own null terminator
+    char* block = mem$malloc(allc, tokens_len + n_tokens);
+    if (block == NULL) {
+        arr$free(result);
+        return NULL;
+    }
+
+    usize cursor = 0;
+    for (usize i = 0; i < n_tokens; i++) {
+        str_s tok = _cex_str__split_next(src, split_by_idx, &cursor);
+        memcpy(block, tok.buf, tok.len);
+        block[tok.len] = '\0';
+        arr$push(result, block);
+        block += tok.len + 1;
+    }
+
+    return result;
+}
+
 /// Splits string by lines, result allocated by allc, as dynamic array of cloned lines, Returns NULL
 /// on error, NULL tolerant. Items of array are cloned, so you need free them independently or
 /// better use arena or tmem$. Supports \n or \r\n.
@@ -1263,7 +1575,13 @@ static arr$(char*) cex_str_split_lines(char* s, IAllocator allc)
 {
     uassert(allc != NULL);
     if (s == NULL) { return NULL; }
-    arr$(char*) result = arr$new(result, allc);
+
+    // NOTE: upper bound, \r\n counts twice
+    usize n_lines = 1;
+    for (char* c = s; *c; c++) {
+        n_lines += (*c == '\n' || *c == '\r' || *c == '\v' || *c == '\f');
+    }
+    arr$(char*) result = arr$new(result, allc, .capacity = n_lines);
     if (result == NULL) { return NULL; }
     char c;
     char* line_start = s;
@@ -1307,32 +1625,33 @@ cex_str_join(char** str_arr, usize str_arr_len, char* join_by, IAllocator allc)
     usize jlen = strlen(join_by);
     if (jlen == 0) { return NULL; }
 
-    char* result = NULL;
-    usize cursor = 0;
+    if (str_arr_len == 0) { return NULL; }
+
+    // first pass: exact result size
+    usize total_len = jlen * (str_arr_len - 1);
     for$each (s, str_arr, str_arr_len) {
-        if (s == NULL) {
-            if (result != NULL) { mem$free(allc, result); }
-            return NULL;
-        }
-        usize slen = strlen(s);
-        if (result == NULL) {
-            result = mem$malloc(allc, slen + jlen + 1);
-        } else {
-            result = mem$realloc(allc, result, cursor + slen + jlen + 1);
-        }
-        if (result == NULL) {
-            return NULL; // memory error
-        }
+        if (s == NULL) { return NULL; }
+        total_len += strlen(s);
+    }
+
+    char* result = mem$malloc(allc, total_len + 1);
+    if (result == NULL) {
+        return NULL; // memory error
+    }
 
-        if (cursor > 0) {
+    usize cursor = 0;
+    for (usize i = 0; i < str_arr_len; i++) {
+        if (i > 0) {
             memcpy(&result[cursor], join_by, jlen);
             cursor += jlen;
         }
-
+        char* s = str_arr[i];
+        usize slen = strlen(s);
         memcpy(&result[cursor], s, slen);
         cursor += slen;
     }
-    if (result) { result[cursor] = '\0'; }
+    uassert(cursor == total_len);
+    result[cursor] = '\0';
 
     return result;
 }
@@ -1572,6 +1891,357 @@ cex_str_qscmpi(const void* a, const void* b)
     return _cex_str__tolower((unsigned char)*_a) - _cex_str__tolower((unsigned char)*_b);
 }
 
+#define _CEX_STR__UTF8_INVALID UINT32_MAX
+
+static inline u64
+_cex_str__utf8_load_u64(const char* p)
+{
+    u64 v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+// Decodes a codepoint at s[*i] and advances *i, invalid sequences are skipped by 1 byte and
+// return _CEX_STR__UTF8_INVALID (rejects overlong forms, surrogates, codepoints > U+10FFFF)
+static inline u32
+_cex_str__utf8_decode(const u8* s, usize len, usize* i)
+{
+    usize pos = *i;
+    u8 c = s[pos];
+    if (c < 0x80) {
+        *i = pos + 1;
+        return c;
+    }
+
+    u32 cp;
+    u32 n;
+    if (c >= 0xC2 && c <= 0xDF) {
+        n = 1;
+        cp = c & 0x1F;
+    } else if ((c & 0xF0) == 0xE0) {
+        n = 2;
+        cp = c & 0x0F;
+    } else if (c >= 0xF0 && c <= 0xF4) {
+        n = 3;
+        cp = c & 0x07;
+    } else {
+        goto invalid;
+    }
+    if (len - pos <= n) { goto invalid; }
+
+    for (u32 k = 1; k <= n; k++) {
+        u8 b = s[pos + k];
+        if ((b & 0xC0) != 0x80) { goto invalid; }
+        cp = (cp << 6) | (b & 0x3F);
+    }
+    if (n == 2 && (cp < 0x800 || (cp >= 0xD800 && cp <= 0xDFFF))) { goto invalid; }
+    if (n == 3 && (cp < 0x10000 || cp > 0x10FFFF)) { goto invalid; }
+
+    *i = pos + n + 1;
+    return cp;
+
+invalid:
+    *i = pos + 1;
+    return _CEX_STR__UTF8_INVALID;
+}
+
+static inline usize
+_cex_str__utf8_encode(u32 cp, char* out)
+{
+    if (cp < 0x80) {
+        out[0] = (char)cp;
+        return 1;
+    } else if (cp < 0x800) {
+        out[0] = (char)(0xC0 | (cp >> 6));
+        out[1] = (char)(0x80 | (cp & 0x3F));
+        return 2;
+    } else if (cp < 0x10000) {
+        out[0] = (char)(0xE0 | (cp >> 12));
+        out[1] = (char)(0x80 | ((cp >> 6) & 0x3F));
+        out[2] = (char)(0x80 | (cp & 0x3F));
+        return 3;
+    } else {
+        out[0] = (char)(0xF0 | (cp >> 18));
+        out[1] = (char)(0x80 | ((cp >> 12) & 0x3F));
+        out[2] = (char)(0x80 | ((cp >> 6) & 0x3F));
+        out[3] = (char)(0x80 | (cp & 0x3F));
+        return 4;
+    }
+}
+
+// Simple case mapping for Latin-1, Latin Extended-A, Greek, Cyrillic and Armenian,
+// mapped codepoints always keep the same UTF-8 length.
+static inline u32
+_cex_str__utf8_tolower_cp(u32 c)
+{
+    if (c < 0x80) { return (c >= 'A' && c <= 'Z') ? c + 32 : c; }
+    if (c >= 0xC0 && c <= 0xDE) { return (c != 0xD7) ? c + 32 : c; }
+    if (c >= 0x100 && c <= 0x17E) {
+        if (c == 0x130 || c == 0x131 || c == 0x138 || c == 0x149) { return c; }
+        if (c <= 0x137 || (c >= 0x14A && c <= 0x177)) { return c | 1; }
+        if (c == 0x178) { return 0xFF; }
+        return (c & 1) ? c + 1 : c;
+    }
+    if (c >= 0x386 && c <= 0x38F) {
+        if (c == 0x386) { return 0x3AC; }
+        if (c >= 0x388 && c <= 0x38A) { return c + 37; }
+        if (c == 0x38C) { return 0x3CC; }
+        if (c >= 0x38E) { return c + 63; }
+        return c;
+    }
+    if (c >= 0x391 && c <= 0x3AB) { return (c != 0x3A2) ? c + 32 : c; }
+    if (c >= 0x400 && c <= 0x40F) { return c + 80; }
+    if (c >= 0x410 && c <= 0x42F) { return c + 32; }
+    if (c >= 0x531 && c <= 0x556) { return c + 48; }
+    return c;
+}
+
+static inline u32
+_cex_str__utf8_toupper_cp(u32 c)
+{
+    if (c < 0x80) { return (c >= 'a' && c <= 'z') ? c - 32 : c; }
+    if (c >= 0xE0 && c <= 0xFE) { return (c != 0xF7) ? c - 32 : c; }
+    if (c == 0xFF) { return 0x178; }
+    if (c >= 0x100 && c <= 0x17E) {
+        if (c == 0x130 || c == 0x131 || c == 0x138 || c == 0x149 || c == 0x178) { return c; }
+        if (c <= 0x137 || (c >= 0x14A && c <= 0x177)) { return c & ~1u; }
+        return (c & 1) ? c : c - 1;
+    }
+    if (c == 0x3C2) { return 0x3A3; } // final sigma
+    if (c >= 0x3B1 && c <= 0x3CB) { return c - 32; }
+    if (c >= 0x3AC && c <= 0x3CE) {
+        if (c == 0x3AC) { return 0x386; }
+        if (c <= 0x3AF) { return c - 37; }
+        if (c == 0x3CC) { return 0x38C; }
+        if (c >= 0x3CD) { return c - 63; }
+    }
+    if (c >= 0x430 && c <= 0x44F) { return c - 32; }
+    if (c >= 0x450 && c <= 0x45F) { return c - 80; }
+    if (c >= 0x561 && c <= 0x586) { return c - 48; }
+    return c;
+}
+
+#define _CEX_STR__SWAR_HI 0x8080808080808080ULL
+#define _CEX_STR__SWAR_EACH(b) (0x0101010101010101ULL * (b))
+
+// ASCII only 8-byte word case conversion (all bytes must be < 0x80)
+static inline u64
+_cex_str__swar_case(u64 w, bool to_upper)
+{
+    u8 first = (to_upper) ? 'a' : 'A';
+    u8 last = (to_upper) ? 'z' : 'Z';
+    u64 ge_first = w + _CEX_STR__SWAR_EACH(0x80 - first);
+    u64 gt_last = w + _CEX_STR__SWAR_EACH(0x7F - last);
+    u64 mask = ge_first & ~gt_last & _CEX_STR__SWAR_HI;
+    return w ^ (mask >> 2);
+}
+
+/// Validates UTF-8 string, returns Error.integrity on invalid sequence (overlong, surrogates,
+/// truncated, or > U+10FFFF), has fast path for ASCII text.
+static Exception
+cex_str__utf8__validate(str_s s)
+{
+    if (unlikely(s.buf == NULL)) { return Error.argument; }
+    const u8* b = (const u8*)s.buf;
+    usize i = 0;
+    while (i < s.len) {
+        if (i + 16 <= s.len) {
+            u64 w = _cex_str__utf8_load_u64(s.buf + i) | _cex_str__utf8_load_u64(s.buf + i + 8);
+            if ((w & _CEX_STR__SWAR_HI) == 0) {
+                i += 16;
+                continue;
+            }
+        }
+        if (b[i] < 0x80) {
+            i++;
+            continue;
+        }
+        if (_cex_str__utf8_decode(b, s.len, &i) == _CEX_STR__UTF8_INVALID) {
+            return Error.integrity;
+        }
+    }
+    return EOK;
+}
+
+/// Returns number of codepoints in UTF-8 string, or -1 if invalid (NULL tolerant)
+static isize
+cex_str__utf8__len(str_s s)
+{
+    if (unlikely(s.buf == NULL)) { return -1; }
+    const u8* b = (const u8*)s.buf;
+    usize i = 0;
+    isize n = 0;
+    while (i < s.len) {
+        if (i + 8 <= s.len && (_cex_str__utf8_load_u64(s.buf + i) & _CEX_STR__SWAR_HI) == 0) {
+            i += 8;
+            n += 8;
+            continue;
+        }
+        if (_cex_str__utf8_decode(b, s.len, &i) == _CEX_STR__UTF8_INVALID) { return -1; }
+        n++;
+    }
+    return n;
+}
+
+/// iterator over UTF-8 codepoints: for$iter (u32, it, str.utf8.iter(s, &it.iterator)) {},
+/// it.idx.i is a byte offset of codepoint, invalid bytes are returned as U+FFFD.
+static u32
+cex_str__utf8__iter(str_s s, cex_iterator_s* iterator)
+{
+    uassert(iterator != NULL && "null iterator");
+
+    // temporary struct based on _ctxbuffer
+    struct iter_ctx
+    {
+        usize cursor;
+    }* ctx = (struct iter_ctx*)iterator->_ctx;
+    static_assert(sizeof(*ctx) <= sizeof(iterator->_ctx), "ctx size overflow");
+    static_assert(alignof(struct iter_ctx) <= alignof(usize), "cex_iterator_s _ctx misalign");
+
+    if (unlikely(!iterator->initialized)) {
+        iterator->initialized = 1;
+        ctx->cursor = 0;
+    }
+    if (unlikely(s.buf == NULL || ctx->cursor >= s.len)) {
+        iterator->stopped = 1;
+        return 0;
+    }
+
+    iterator->idx.i = ctx->cursor;
+    u32 cp = _cex_str__utf8_decode((const u8*)s.buf, s.len, &ctx->cursor);
+    return (cp != _CEX_STR__UTF8_INVALID) ? cp : 0xFFFD;
+}
+
+static char*
+_cex_str__utf8_case(str_s s, bool to_upper, IAllocator allc)
+{
+    if (s.buf == NULL) { return NULL; }
+    uassert(s.len < PTRDIFF_MAX);
+
+    char* result = mem$malloc(allc, s.len + 1);
+    if (result == NULL) { return NULL; }
+
+    const u8* b = (const u8*)s.buf;
+    usize i = 0;
+    usize o = 0;
+    while (i < s.len) {
+        if (i + 8 <= s.len) {
+            u64 w = _cex_str__utf8_load_u64(s.buf + i);
+            if ((w & _CEX_STR__SWAR_HI) == 0) {
+                w = _cex_str__swar_case(w, to_upper);
+                memcpy(result + o, &w, sizeof(w));
+                i += 8;
+                o += 8;
+                continue;
+            }
+        }
+        usize start = i;
+        u32 cp = _cex_str__utf8_decode(b, s.len, &i);
+        if (cp == _CEX_STR__UTF8_INVALID) {
+            result[o++] = s.buf[start]; // invalid bytes copied as is
+            continue;
+        }
+        cp = (to_upper) ? _cex_str__utf8_toupper_cp(cp) : _cex_str__utf8_tolower_cp(cp);
+        o += _cex_str__utf8_encode(cp, result + o);
+        uassert(o == i && "case mapping changed utf8 length");
+    }
+    result[o] = '\0';
+    return result;
+}
+
+/// Returns new lower case UTF-8 string (Latin, Greek, Cyrillic, Armenian), NULL on error,
+/// invalid UTF-8 bytes are copied as is.
+static char*
+cex_str__utf8__lower(str_s s, IAllocator allc)
+{
+    return _cex_str__utf8_case(s, false, allc);
+}
+
+/// Returns new upper case UTF-8 string (Latin, Greek, Cyrillic, Armenian), NULL on error,
+/// invalid UTF-8 bytes are copied as is.
+static char*
+cex_str__utf8__upper(str_s s, IAllocator allc)
+{
+    return _cex_str__utf8_case(s, true, allc);
+}
+
+/// Case insensitive UTF-8 compare (Latin, Greek, Cyrillic, Armenian), returns <0, 0, >0
+static int
+cex_str__utf8__cmpi(str_s a, str_s b)
+{
+    if (a.buf == NULL || b.buf == NULL) { return (a.buf != NULL) - (b.buf != NULL); }
+
+    const u8* ab = (const u8*)a.buf;
+    const u8* bb = (const u8*)b.buf;
+    usize i = 0;
+    usize j = 0;
+    while (i < a.len && j < b.len) {
+        if (i == j && i + 8 <= a.len && i + 8 <= b.len) {
+            u64 wa = _cex_str__utf8_load_u64(a.buf + i);
+            u64 wb = _cex_str__utf8_load_u64(b.buf + j);
+            if (((wa | wb) & _CEX_STR__SWAR_HI) == 0 &&
+                _cex_str__swar_case(wa, false) == _cex_str__swar_case(wb, false)) {
+                i += 8;
+                j += 8;
+                continue;
+            }
+        }
+        usize ia = i;
+        usize jb = j;
+        u32 ca = _cex_str__utf8_decode(ab, a.len, &i);
+        u32 cb = _cex_str__utf8_decode(bb, b.len, &j);
+        // NOTE: invalid bytes are compared by value, after all valid codepoints
+        ca = (ca != _CEX_STR__UTF8_INVALID) ? _cex_str__utf8_tolower_cp(ca) : 0x110000u + ab[ia];
+        cb = (cb != _CEX_STR__UTF8_INVALID) ? _cex_str__utf8_tolower_cp(cb) : 0x110000u + bb[jb];
+        if (ca != cb) { return (ca < cb) ? -1 : 1; }
+    }
+    return (i < a.len) - (j < b.len);
+}
+
+/// Converts UTF-8 into null-terminated UTF-16 (native endian). Pass out=NULL to get required
+/// length in out_len (excluding null-terminator). Returns Error.integrity on invalid UTF-8,
+/// Error.overflow if out_cap is not enough.
+static Exception
+cex_str__utf8__to_utf16(str_s s, u16* out, usize out_cap, usize* out_len)
+{
+    if (unlikely(s.buf == NULL || out_len == NULL)) { return Error.argument; }
+    if (unlikely(out != NULL && out_cap == 0)) { return Error.argument; }
+    *out_len = 0;
+
+    const u8* b = (const u8*)s.buf;
+    usize i = 0;
+    usize n = 0;
+    while (i < s.len) {
+        u32 cp = _cex_str__utf8_decode(b, s.len, &i);
+        if (cp == _CEX_STR__UTF8_INVALID) {
+            if (out) { out[0] = 0; }
+            return Error.integrity;
+        }
+        usize n_units = (cp < 0x10000) ? 1 : 2;
+        if (out) {
+            if (n + n_units >= out_cap) {
+                out[0] = 0;
+                return Error.overflow;
+            }
+            if (n_units == 1) {
+                out[n] = (u16)cp;
+            } else {
+                cp -= 0x10000;
+                out[n] = (u16)(0xD800 | (cp >> 10));
+                out[n + 1] = (u16)(0xDC00 | (cp & 0x3FF));
+            }
+        }
+        n += n_units;
+    }
+    if (out) { out[n] = 0; }
+    *out_len = n;
+    return EOK;
+}
+
+#undef _CEX_STR__UTF8_INVALID
+#undef _CEX_STR__SWAR_HI
+#undef _CEX_STR__SWAR_EACH
+
 const struct __cex_namespace__str str = {
     // Autogenerated by CEX
     // clang-format off
@@ -1594,6 +2264,7 @@ const struct __cex_namespace__str str = {
     .sbuf = cex_str_sbuf,
     .split = cex_str_split,
     .split_lines = cex_str_split_lines,
+    .split_packed = cex_str_split_packed,
     .sprintf = cex_str_sprintf,
     .sstr = cex_str_sstr,
     .starts_with = cex_str_starts_with,
@@ -1602,6 +2273,8 @@ const struct __cex_namespace__str str = {
     .vsprintf = cex_str_vsprintf,
 
     .convert = {
+        .parse_many_f64 = cex_str__convert__parse_many_f64,
+        .parse_many_i64 = cex_str__convert__parse_many_i64,
         .to_f32 = cex_str__convert__to_f32,
         .to_f32s = cex_str__convert__to_f32s,
         .to_f64 = cex_str__convert__to_f64,
@@ -1639,11 +2312,22 @@ const struct __cex_namespace__str str = {
         .remove_prefix = cex_str__slice__remove_prefix,
         .remove_suffix = cex_str__slice__remove_suffix,
         .rstrip = cex_str__slice__rstrip,
+        .split_into = cex_str__slice__split_into,
         .starts_with = cex_str__slice__starts_with,
         .strip = cex_str__slice__strip,
         .sub = cex_str__slice__sub,
     },
 
+    .utf8 = {
+        .cmpi = cex_str__utf8__cmpi,
+        .iter = cex_str__utf8__iter,
+        .len = cex_str__utf8__len,
+        .lower = cex_str__utf8__lower,
+        .to_utf16 = cex_str__utf8__to_utf16,
+        .upper = cex_str__utf8__upper,
+        .validate = cex_str__utf8__validate,
+    },
+
     // clang-format on
 };
 #endif
@@ -45,6 +45,14 @@
     ) \
 )(str_or_slice, out_var_ptr)
 
+/// Bulk parses `sep` delimited numbers from slice into `out_arr` (i64* or f64*), up to `out_cap`
+/// items, e.g. str$parse_many(str$s("1,2,3"), ',', buf, arr$len(buf), &n, &consumed)
+#define str$parse_many(str_slice, sep, out_arr, out_cap, out_len, consumed)                        \
+    _Generic((out_arr), \
+        i64*:  str.convert.parse_many_i64, \
+        f64*:  str.convert.parse_many_f64 \
+    )(str_slice, sep, out_arr, out_cap, out_len, consumed)
+
 /**
 
 CEX string principles:
@@ -118,10 +126,30 @@ mem$scope(tmem$, _)
     for$each (v, res) {
         io.printf("%s\n", v); // NOTE: strings now cloned and null-terminated
     }
+
+    // NOTE: all tokens share one allocation (starts at res[0])
+    res = str.split_packed("123,456,789", ",", _);
+
+    // Zero-copy split into existing array of slices
+    arr$(str_s) tokens = arr$new(tokens, _);
+    e$ret(str.slice.split_into(str.sstr("123,456,789"), ",", &tokens));
 }
 
 ```
 
+- UTF-8 support
+
+```c
+str_s text = str.sstr("Привет, World!");
+e$ret(str.utf8.validate(text)); // Error.integrity on malformed UTF-8
+
+for$iter (u32, it, str.utf8.iter(text, &it.iterator)) {
+    io.printf("offset: %zu codepoint: U+%04X\n", it.idx.i, it.val);
+}
+char* lower = str.utf8.lower(text, _); // "привет, world!"
+tassert(str.utf8.cmpi(text, str.sstr(lower)) == 0);
+```
+
 - Chaining string operations
 ```c
 
@@ -215,6 +243,10 @@ struct __cex_namespace__str
     /// on error, NULL tolerant. Items of array are cloned, so you need free them independently or
     /// better use arena or tmem$. Supports \n or \r\n.
     arr$(char*)     (*split_lines)(char* s, IAllocator allc);
+    /// Splits string using split_by (allows many) chars, all tokens are packed into a single memory
+    /// block, which starts at result[0]. Returns NULL on error, NULL tolerant. Free with
+    /// `mem$free(allc, res[0]); arr$free(res);` when heap allocator is used (only 2 allocations).
+    arr$(char*)     (*split_packed)(char* s, char* split_by, IAllocator allc);
     /// Analog of sprintf() uses CEX sprintf engine. NULL tolerant, overflow safe.
     Exc             (*sprintf)(char* dest, usize dest_len, char* format,...);
     /// Creates string slice of input C string (NULL tolerant, (str_s){0} on error)
@@ -231,6 +263,16 @@ struct __cex_namespace__str
     Exception       (*vsprintf)(char* dest, usize dest_len, char* format, va_list va);
 
     struct {
+        /// Parses `sep` (or new line) delimited run of floats from `s` into `out` (up to `out_cap`
+        /// items). Sets `out_len` to number of parsed items, and `consumed` to number of processed bytes of
+        /// `s` (on error it's offset of the first bad token). If out_cap reached, resume parsing from
+        /// str.slice.sub(s, consumed, 0).
+        Exception       (*parse_many_f64)(str_s s, char sep, f64* out, usize out_cap, usize* out_len, usize* consumed);
+        /// Parses `sep` (or new line) delimited run of integers from `s` into `out` (up to `out_cap`
+        /// items). Sets `out_len` to number of parsed items, and `consumed` to number of processed bytes of
+        /// `s` (on error it's offset of the first bad token). If out_cap reached, resume parsing from
+        /// str.slice.sub(s, consumed, 0).
+        Exception       (*parse_many_i64)(str_s s, char sep, i64* out, usize out_cap, usize* out_len, usize* consumed);
         Exception       (*to_f32)(char* s, f32* num);
         Exception       (*to_f32s)(str_s s, f32* num);
         Exception       (*to_f64)(char* s, f64* num);
@@ -283,6 +325,9 @@ struct __cex_namespace__str
         str_s           (*remove_suffix)(str_s s, str_s suffix);
         /// Removes white spaces from the end of slice
         str_s           (*rstrip)(str_s s);
+        /// Splits slice into an existing arr$(str_s) (appends), zero-copy, items are slices of `s`.
+        /// Produces the same tokens as str.slice.iter_split(), array is resized at most once.
+        Exception       (*split_into)(str_s s, char* split_by, arr$(str_s)* out_arr);
         /// Checks if slice starts with prefix, returns (str_s){0} on error, NULL tolerant
         bool            (*starts_with)(str_s s, str_s prefix);
         /// Removes white spaces from both ends of slice
@@ -293,6 +338,29 @@ struct __cex_namespace__str
         str_s           (*sub)(str_s s, isize start, isize end);
     } slice;
 
+    struct {
+        /// Case insensitive UTF-8 compare (Latin, Greek, Cyrillic, Armenian), returns <0, 0, >0
+        int             (*cmpi)(str_s a, str_s b);
+        /// iterator over UTF-8 codepoints: for$iter (u32, it, str.utf8.iter(s, &it.iterator)) {},
+        /// it.idx.i is a byte offset of codepoint, invalid bytes are returned as U+FFFD.
+        u32             (*iter)(str_s s, cex_iterator_s* iterator);
+        /// Returns number of codepoints in UTF-8 string, or -1 if invalid (NULL tolerant)
+        isize           (*len)(str_s s);
+        /// Returns new lower case UTF-8 string (Latin, Greek, Cyrillic, Armenian), NULL on error,
+        /// invalid UTF-8 bytes are copied as is.
+        char*           (*lower)(str_s s, IAllocator allc);
+        /// Converts UTF-8 into null-terminated UTF-16 (native endian). Pass out=NULL to get required
+        /// length in out_len (excluding null-terminator). Returns Error.integrity on invalid UTF-8,
+        /// Error.overflow if out_cap is not enough.
+        Exception       (*to_utf16)(str_s s, u16* out, usize out_cap, usize* out_len);
+        /// Returns new upper case UTF-8 string (Latin, Greek, Cyrillic, Armenian), NULL on error,
+        /// invalid UTF-8 bytes are copied as is.
+        char*           (*upper)(str_s s, IAllocator allc);
+        /// Validates UTF-8 string, returns Error.integrity on invalid sequence (overlong, surrogates,
+        /// truncated, or > U+10FFFF), has fast path for ASCII text.
+        Exception       (*validate)(str_s s);
+    } utf8;
+
     // clang-format on
 };
 CEX_NAMESPACE struct __cex_namespace__str str;
@@ -0,0 +1,41 @@
+#pragma once
+#include "cex.h"
+
+/// JSON codegen test structs, regenerate by: ./cex process --json tests/data/json_codegen.h
+
+/// Stock info
+/// @json
+typedef struct json_stock_s
+{
+    i64 id;
+    char ticker[8];
+    bool is_active;
+} json_stock_s;
+
+/**
+ * @brief Order with all supported field types
+ * @json
+ */
+typedef struct json_order_s
+{
+    u32 qty;
+    i8 side;
+    u16 flags;
+    int count;
+    usize seq;
+    u64 ts;
+    f64 price;
+    f32 fee;
+    char* note;      // allocated
+    str_s raw;       // raw JSON string slice
+    json_stock_s stock;
+    json_stock_s* hedge; // allocated
+    bool is_open;
+    bool is_hidden;
+} json_order_s;
+
+// not a @json struct, skipped by codegen
+typedef struct json_other_s
+{
+    arr$(int) items;
+} json_other_s;
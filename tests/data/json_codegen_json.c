@@ -0,0 +1,240 @@
+// Autogenerated by CEX (./cex process --json tests/data/json_codegen.h), do not edit!
+// Include after lib/json/json.c and json_codegen.h
+
+Exception json_stock_s_json_decode(jr_c* jr, json_stock_s* out, IAllocator allc);
+Exception json_stock_s_json_encode(jw_c* jw, json_stock_s* obj);
+Exception json_order_s_json_decode(jr_c* jr, json_order_s* out, IAllocator allc);
+Exception json_order_s_json_encode(jw_c* jw, json_order_s* obj);
+
+/// Decodes JSON object into `out`, allc is used for char* and struct pointer fields
+Exception
+json_stock_s_json_decode(jr_c* jr, json_stock_s* out, IAllocator allc)
+{
+    (void)allc;
+    jr$foreach(k, v, jr) {
+        (void)v;
+        if (jr->type == JsonType__null) { continue; }
+        switch (k.len) {
+            case 2: {
+                if (memcmp(k.buf, "id", 2) == 0) {
+                    jr$egoto(jr, jr$get_i64(jr, &out->id), fail);
+                }
+                break;
+            }
+            case 6: {
+                if (memcmp(k.buf, "ticker", 6) == 0) {
+                    jr$egoto(jr, jr$get_str(jr, out->ticker, sizeof(out->ticker)), fail);
+                }
+                break;
+            }
+            case 9: {
+                if (memcmp(k.buf, "is_active", 9) == 0) {
+                    jr$egoto(jr, jr$get_bool(jr, &out->is_active), fail);
+                }
+                break;
+            }
+        }
+    }
+fail:
+    return jr->error;
+}
+
+/// Encodes `obj` as JSON object into jw$ writer
+Exception
+json_stock_s_json_encode(jw_c* jw, json_stock_s* obj)
+{
+    jw$scope(jw, JsonType__obj) {
+        jw$key("id");
+        jw$val(obj->id);
+        jw$key("ticker");
+        jw$val(obj->ticker);
+        jw$key("is_active");
+        jw$bool(obj->is_active);
+    }
+    return jw$validate(jw);
+}
+
+/// Decodes JSON object into `out`, allc is used for char* and struct pointer fields
+Exception
+json_order_s_json_decode(jr_c* jr, json_order_s* out, IAllocator allc)
+{
+    (void)allc;
+    jr$foreach(k, v, jr) {
+        (void)v;
+        if (jr->type == JsonType__null) { continue; }
+        switch (k.len) {
+            case 2: {
+                if (memcmp(k.buf, "ts", 2) == 0) {
+                    u64 n = 0;
+                    jr$egoto(jr, jr$get_u64(jr, &n), fail);
+                    out->ts = (u64)n;
+                }
+                break;
+            }
+            case 3: {
+                switch (k.buf[0]) {
+                    case 'q': {
+                        if (memcmp(k.buf, "qty", 3) == 0) {
+                            u64 n = 0;
+                            jr$egoto(jr, jr$get_u64(jr, &n), fail);
+                            if (n > UINT32_MAX) { jr$egoto(jr, Error.overflow, fail); }
+                            out->qty = (u32)n;
+                        }
+                        break;
+                    }
+                    case 's': {
+                        if (memcmp(k.buf, "seq", 3) == 0) {
+                            u64 n = 0;
+                            jr$egoto(jr, jr$get_u64(jr, &n), fail);
+                            if (n > SIZE_MAX) { jr$egoto(jr, Error.overflow, fail); }
+                            out->seq = (usize)n;
+                        }
+                        break;
+                    }
+                    case 'f': {
+                        if (memcmp(k.buf, "fee", 3) == 0) {
+                            f64 n = 0;
+                            jr$egoto(jr, jr$get_f64(jr, &n), fail);
+                            out->fee = (f32)n;
+                        }
+                        break;
+                    }
+                    case 'r': {
+                        if (memcmp(k.buf, "raw", 3) == 0) {
+                            Exc err_type = (jr->type == JsonType__str) ? EOK : "Expected string value";
+                            jr$egoto(jr, err_type, fail);
+                            out->raw = v; // raw JSON value (not unescaped)
+                        }
+                        break;
+                    }
+                }
+                break;
+            }
+            case 4: {
+                switch (k.buf[0]) {
+                    case 's': {
+                        if (memcmp(k.buf, "side", 4) == 0) {
+                            i64 n = 0;
+                            jr$egoto(jr, jr$get_i64(jr, &n), fail);
+                            if (n < INT8_MIN || n > INT8_MAX) { jr$egoto(jr, Error.overflow, fail); }
+                            out->side = (i8)n;
+                        }
+                        break;
+                    }
+                    case 'n': {
+                        if (memcmp(k.buf, "note", 4) == 0) {
+                            jr$egoto(jr, jr$get_str_alloc(jr, &out->note, allc), fail);
+                        }
+                        break;
+                    }
+                }
+                break;
+            }
+            case 5: {
+                switch (k.buf[0]) {
+                    case 'f': {
+                        if (memcmp(k.buf, "flags", 5) == 0) {
+                            u64 n = 0;
+                            jr$egoto(jr, jr$get_u64(jr, &n), fail);
+                            if (n > UINT16_MAX) { jr$egoto(jr, Error.overflow, fail); }
+                            out->flags = (u16)n;
+                        }
+                        break;
+                    }
+                    case 'c': {
+                        if (memcmp(k.buf, "count", 5) == 0) {
+                            i64 n = 0;
+                            jr$egoto(jr, jr$get_i64(jr, &n), fail);
+                            if (n < INT_MIN || n > INT_MAX) { jr$egoto(jr, Error.overflow, fail); }
+                            out->count = (int)n;
+                        }
+                        break;
+                    }
+                    case 'p': {
+                        if (memcmp(k.buf, "price", 5) == 0) {
+                            f64 n = 0;
+                            jr$egoto(jr, jr$get_f64(jr, &n), fail);
+                            out->price = (f64)n;
+                        }
+                        break;
+                    }
+                    case 's': {
+                        if (memcmp(k.buf, "stock", 5) == 0) {
+                            jr$egoto(jr, json_stock_s_json_decode(jr, &out->stock, allc), fail);
+                        }
+                        break;
+                    }
+                    case 'h': {
+                        if (memcmp(k.buf, "hedge", 5) == 0) {
+                            if (out->hedge == NULL) { out->hedge = mem$new(allc, json_stock_s); }
+                            if (out->hedge == NULL) { jr$egoto(jr, Error.memory, fail); }
+                            jr$egoto(jr, json_stock_s_json_decode(jr, out->hedge, allc), fail);
+                        }
+                        break;
+                    }
+                }
+                break;
+            }
+            case 7: {
+                if (memcmp(k.buf, "is_open", 7) == 0) {
+                    jr$egoto(jr, jr$get_bool(jr, &out->is_open), fail);
+                }
+                break;
+            }
+            case 9: {
+                if (memcmp(k.buf, "is_hidden", 9) == 0) {
+                    jr$egoto(jr, jr$get_bool(jr, &out->is_hidden), fail);
+                }
+                break;
+            }
+        }
+    }
+fail:
+    return jr->error;
+}
+
+/// Encodes `obj` as JSON object into jw$ writer
+Exception
+json_order_s_json_encode(jw_c* jw, json_order_s* obj)
+{
+    jw$scope(jw, JsonType__obj) {
+        jw$key("qty");
+        jw$val((u64)obj->qty);
+        jw$key("side");
+        jw$val((i64)obj->side);
+        jw$key("flags");
+        jw$val((u64)obj->flags);
+        jw$key("count");
+        jw$val((i64)obj->count);
+        jw$key("seq");
+        jw$val((u64)obj->seq);
+        jw$key("ts");
+        jw$val((u64)obj->ts);
+        jw$key("price");
+        jw$val((f64)obj->price);
+        jw$key("fee");
+        jw$val((f32)obj->fee);
+        jw$key("note");
+        if (obj->note != NULL) {
+            jw$val(obj->note);
+        } else {
+            jw$null();
+        }
+        jw$key("raw");
+        jw$val(obj->raw);
+        jw$key("stock");
+        e$ret(json_stock_s_json_encode(jw, &obj->stock));
+        jw$key("hedge");
+        if (obj->hedge != NULL) {
+            e$ret(json_stock_s_json_encode(jw, obj->hedge));
+        } else {
+            jw$null();
+        }
+        jw$key("is_open");
+        jw$bool(obj->is_open);
+        jw$key("is_hidden");
+        jw$bool(obj->is_hidden);
+    }
+    return jw$validate(jw);
+}
+
@@ -602,4 +602,155 @@ test$case(test_token_parser)
     return EOK;
 }
 
+test$case(test_token_bulk_scanning)
+{
+    // long runs of whitespace/strings/comments/preproc are scanned in bulk, line must be consistent
+    char* code = "                                  foo\n"
+                 "  \"long string with \\\"escapes\\\" \\\\ and 'quotes' inside\"\n"
+                 "/* multi ** line * \n comment **/ // single comment\n"
+                 "#define MACRO(x) \\\n    x \\\\\n"
+                 "bar 'x' '\\''\n"
+                 "{ \"}\" '}' /* } */ // }\n #define BAR }\n }\n"
+                 "\"unterminated";
+    CexParser_c lx = CexParser_create(code, 0, true);
+
+    token_cmp_s expected[] = {
+        { "foo", NULL, CexTkn__ident },
+        { "long string with \\\"escapes\\\" \\\\ and 'quotes' inside", NULL, CexTkn__string },
+        { "/* multi ** line * \n comment **/", NULL, CexTkn__comment_multi },
+        { "// single comment", NULL, CexTkn__comment_single },
+        { "define MACRO(x) \\\n    x \\\\", NULL, CexTkn__preproc },
+        { "bar", NULL, CexTkn__ident },
+        { "x", NULL, CexTkn__char },
+        { "\\'", NULL, CexTkn__char },
+        { "{ \"}\" '}' /* } */ // }\n #define BAR }\n }", NULL, CexTkn__brace_block },
+        { "unterminated", NULL, CexTkn__string },
+    };
+    u32 lines[] = { 0, 1, 3, 3, 6, 6, 6, 6, 9, 10 };
+
+    for (u32 i = 0; i < arr$len(expected); i++) {
+        cex_token_s t = CexParser_next_token(&lx);
+        char* exp_code = expected[i].code;
+        tassertf(t.type == expected[i].type, "code: %s, t.type: %s", exp_code, CexTkn_str[t.type]);
+        tassert_eq(t.value, str.sstr(exp_code));
+        tassertf(lx.line == lines[i], "code: %s line: %d", exp_code, lx.line);
+    }
+    tassert_eq(CexParser_next_token(&lx).type, CexTkn__eof);
+
+    // control chars in strings, and escape char at EOF are errors
+    char* bad_code[] = { "\"a\nb\"", "\"abc\\", "#define FOO \\" };
+    for$each (it, bad_code) {
+        lx = CexParser_create(it, 0, false);
+        tassertf(CexParser_next_token(&lx).type == CexTkn__error, "code: %s", it);
+    }
+    return EOK;
+}
+
+test$case(test_retokenize_after_edits)
+{
+    char* code = "#include <stdio.h>\n"
+                 "/// doc\n"
+                 "int foo(int a, int b) { return a + b; }\n"
+                 "\n"
+                 "int bar(void) { return foo(1, 2) * 3; }\n"
+                 "char* s = \"string\";\n";
+    // each edit: offset, removed, inserted text
+    struct
+    {
+        u32 offset;
+        u32 removed;
+        char* inserted;
+    } edits[] = {
+        { 67, 0, "\n\n// new line comment\n" }, // new lines in the middle
+        { 0, 0, "/* head */ " },                // at the beginning
+        { 46, 12, "int* x" },                   // replace function args
+        { 95, 0, "\"unfinished, it's a " },     // damages the tail, string through the lines
+        { 95, 20, "" },                         // revert it back
+        { 0, 0, "{ " },                         // unbalanced scope depth
+        { 0, 2, "" },                           // revert it back
+        { 1000, 0, "\nint baz;" },              // at the end
+    };
+
+    mem$scope(tmem$, _)
+    {
+        sbuf_c content = sbuf.create(256, _);
+        e$ret(sbuf.append(&content, code));
+        arr$(cex_token_s) tokens = arr$new(tokens, _);
+        arr$(cex_token_checkpoint_s) checkpoints = arr$new(checkpoints, _);
+
+        CexParser_c lx = CexParser.create(content, sbuf.len(&content), false);
+        tassert_er(EOK, CexParser.tokenize(&lx, 4, &tokens, &checkpoints));
+        tassert_gt(arr$len(checkpoints), 2);
+        tassert_eq(arr$last(checkpoints).offset, sbuf.len(&content));
+        tassert_eq(arr$last(checkpoints).token_idx, arr$len(tokens));
+
+        for$each (e, edits) {
+            // new content in a different buffer, tokens must be rebased to it
+            char* old_content = content;
+            u32 offset = (e.offset < sbuf.len(&content)) ? e.offset : sbuf.len(&content);
+            str_s head = { .buf = content, .len = offset };
+            str_s new_code = str.sstr(
+                str.fmt(_, "%S%s%s", head, e.inserted, content + offset + e.removed)
+            );
+            content = sbuf.create(new_code.len + 1, _);
+            e$ret(sbuf.appendf(&content, "%S", new_code));
+
+            lx = CexParser.create(content, sbuf.len(&content), false);
+            Exc err_inc = CexParser.retokenize(
+                &lx,
+                old_content,
+                offset,
+                e.removed,
+                str.len(e.inserted),
+                4,
+                &tokens,
+                &checkpoints
+            );
+
+            CexParser_c lx_full = CexParser.create(content, sbuf.len(&content), false);
+            arr$(cex_token_s) exp_tokens = arr$new(exp_tokens, _);
+            arr$(cex_token_checkpoint_s) exp_checkpoints = arr$new(exp_checkpoints, _);
+            Exc err_full = CexParser.tokenize(&lx_full, 4, &exp_tokens, &exp_checkpoints);
+
+            tassert_er(err_full, err_inc);
+            tassert_eq(arr$len(tokens), arr$len(exp_tokens));
+            for (u32 i = 0; i < arr$len(tokens); i++) {
+                tassertf(tokens[i].type == exp_tokens[i].type, "edit: %s tok: %d", e.inserted, i);
+                tassertf(tokens[i].value.buf == exp_tokens[i].value.buf, "edit: %s tok: %d", e.inserted, i);
+                tassert_eq(tokens[i].value, exp_tokens[i].value);
+            }
+            if (err_full == EOK) {
+                tassert_eq(lx.line, lx_full.line);
+                tassert_eq(arr$last(checkpoints).offset, sbuf.len(&content));
+            }
+
+            // every checkpoint is a valid resume position
+            for$each (cp, checkpoints) {
+                CexParser_c lx_cp = CexParser.create(content, sbuf.len(&content), false);
+                CexParser.resync(&lx_cp, cp.offset);
+                tassert_eq(lx_cp.line, cp.line);
+                cex_token_s t = CexParser.next_token(&lx_cp);
+                if (cp.token_idx < arr$len(tokens)) {
+                    tassert_eq(t.value, tokens[cp.token_idx].value);
+                } else {
+                    tassert_eq(t.type, CexTkn__eof);
+                }
+
+                i32 depth = 0;
+                for (u32 i = 0; i < cp.token_idx; i++) {
+                    if (tokens[i].type == CexTkn__lbrace || tokens[i].type == CexTkn__lparen) {
+                        depth++;
+                    } else if (tokens[i].type == CexTkn__rbrace ||
+                               tokens[i].type == CexTkn__rparen) {
+                        depth--;
+                    }
+                }
+                tassert_eq(cp.scope_depth, depth);
+            }
+        }
+        tassert_eq(tokens[arr$len(tokens) - 2].value, str$s("baz"));
+    }
+    return EOK;
+}
+
 test$main();
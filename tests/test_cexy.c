@@ -254,6 +254,103 @@ test$case(test_src_changed_include_skips_system)
     return EOK;
 }
 
+test$case(test_src_changed_include_nested)
+{
+    mem$scope(tmem$, _)
+    {
+        char* tgt = TBUILDDIR "t3/my_tgt";
+        char* src = TBUILDDIR "t3/my_src.c";
+        char* inc_a = TBUILDDIR "t3/inc/a.h";
+        char* inc_b = TBUILDDIR "t3/b.h";
+        e$ret(os.fs.mkpath(inc_a));
+
+        e$ret(io.file.save(src, "#include \"inc/a.h\""));
+        e$ret(io.file.save(inc_a, "#include \"../b.h\""));
+        e$ret(io.file.save(inc_b, "#include \"inc/a.h\"\n// I am nested")); // include cycle
+        e$ret(io.file.save(tgt, ""));
+
+        char* deps_fn = _cexy__cache_path(tgt, "deps", _);
+        tassert(!os.path.exists(deps_fn));
+        tassert_eq(0, cexy.src_include_changed(tgt, src, NULL));
+        tassert(os.path.exists(deps_fn));
+        tassert_eq(0, cexy.src_include_changed(tgt, src, NULL));
+
+        os.sleep(1500);
+        tassert_eq(0, cexy.src_include_changed(tgt, src, NULL));
+        e$ret(io.file.save(inc_b, "#include \"inc/a.h\"\n// I am nested again"));
+        tassert_eq(1, cexy.src_include_changed(tgt, src, NULL));
+        tassert_eq(1, cexy.src_include_changed(tgt, src, NULL));
+
+        // target rebuilt, dependency graph is rescanned
+        e$ret(io.file.save(tgt, ""));
+        tassert_eq(0, cexy.src_include_changed(tgt, src, NULL));
+        tassert_eq(0, cexy.src_include_changed(tgt, src, NULL));
+    }
+    return EOK;
+}
+
+test$case(test_src_changed_include_same_content)
+{
+    char* tgt = TBUILDDIR "my_tgt";
+    char* src = TBUILDDIR "my_src.c";
+    char* src2 = TBUILDDIR "my_src2.c";
+
+    e$ret(io.file.save(src, "#include \"my_src2.c\""));
+    e$ret(io.file.save(src2, "// I am include"));
+    e$ret(io.file.save(tgt, ""));
+    tassert_eq(0, cexy.src_include_changed(tgt, src, NULL));
+
+    os.sleep(1500);
+    // mtime changes, but contents are the same
+    e$ret(io.file.save(src, "#include \"my_src2.c\""));
+    e$ret(io.file.save(src2, "// I am include"));
+    tassert_eq(0, cexy.src_include_changed(tgt, src, NULL));
+    tassert_eq(0, cexy.src_include_changed(tgt, src, NULL));
+
+    e$ret(io.file.save(src2, "// I am INCLUDE"));
+    tassert_eq(1, cexy.src_include_changed(tgt, src, NULL));
+    return EOK;
+}
+
+test$case(test_src_changed_include_new_file)
+{
+    char* tgt = TBUILDDIR "t4/my_tgt";
+    char* src = TBUILDDIR "t4/my_src.c";
+    e$ret(os.fs.mkdir(TBUILDDIR "t4/"));
+
+    // found via cexy$cc_include, but t4/my_inc.h would take precedence when created
+    e$ret(io.file.save(src, "#include \"my_inc.h\""));
+    e$ret(io.file.save(TBUILDDIR "my_inc.h", "// I am include"));
+    e$ret(io.file.save(tgt, ""));
+    tassert_eq(0, cexy.src_include_changed(tgt, src, NULL));
+    tassert_eq(0, cexy.src_include_changed(tgt, src, NULL));
+
+    e$ret(io.file.save(TBUILDDIR "t4/my_inc.h", "// I am new include"));
+    tassert_eq(1, cexy.src_include_changed(tgt, src, NULL));
+
+    e$ret(os.fs.remove(TBUILDDIR "t4/my_inc.h"));
+    tassert_eq(0, cexy.src_include_changed(tgt, src, NULL));
+    e$ret(os.fs.remove(TBUILDDIR "my_inc.h"));
+    tassert_eq(1, cexy.src_include_changed(tgt, src, NULL));
+    return EOK;
+}
+
+test$case(test_src_changed_path_normalize)
+{
+    mem$scope(tmem$, _)
+    {
+        char sep[2] = { os$PATH_SEP, '\0' };
+        tassert_eq(_cexy__path_normalize("a/./b/../c.h", _), str.fmt(_, "a%sc.h", sep));
+        tassert_eq(_cexy__path_normalize("./a/b/../../c.h", _), "c.h");
+        tassert_eq(_cexy__path_normalize("../../c.h", _), str.fmt(_, "..%s..%sc.h", sep, sep));
+        tassert_eq(_cexy__path_normalize("a/../../c.h", _), str.fmt(_, "..%sc.h", sep));
+        tassert_eq(_cexy__path_normalize("/a/../../c.h", _), str.fmt(_, "%sc.h", sep));
+        tassert_eq(_cexy__path_normalize("a//b\\c.h", _), str.fmt(_, "a%sb%sc.h", sep, sep));
+        tassert_eq(_cexy__path_normalize("a/..", _), ".");
+    }
+    return EOK;
+}
+
 
 test$case(test_lib_fetch_check_args)
 {
@@ -539,6 +636,59 @@ test$case(test_git_lib_fetch_update)
     return EOK;
 }
 
+test$case(test_decls_parse_cache)
+{
+    mem$scope(tmem$, _)
+    {
+        char* src = TBUILDDIR "my_src.c";
+        char* code = "/// my func\n"
+                     "static int my_func(int a, char* b) { return a; }\n"
+                     "#define MY_MACRO 1\n"
+                     "struct my_s { int a; };\n";
+        e$ret(io.file.save(src, code));
+        tassert(!os.path.exists(cexy$cache_dir));
+
+        char* code1 = io.file.load(src, _);
+        arr$(cex_decl_s*) decls1 = arr$new(decls1, _);
+        e$ret(_cexy__decls_parse(src, code1, NULL, _, &decls1));
+        tassert_eq(arr$len(decls1), 3);
+        tassert(os.path.exists(cexy$cache_dir));
+
+        // loaded from cache, slices point to a new code buffer
+        char* code2 = io.file.load(src, _);
+        arr$(cex_decl_s*) decls2 = arr$new(decls2, _);
+        e$ret(_cexy__decls_parse(src, code2, NULL, _, &decls2));
+        tassert_eq(arr$len(decls2), arr$len(decls1));
+        for (usize i = 0; i < arr$len(decls1); i++) {
+            cex_decl_s* d1 = decls1[i];
+            cex_decl_s* d2 = decls2[i];
+            tassert_eq(d2->name, d1->name);
+            tassert(d2->name.buf >= code2 && d2->name.buf < code2 + str.len(code2));
+            tassert_eq(d2->docs, d1->docs);
+            tassert_eq(d2->body, d1->body);
+            tassert_eq(d2->ret_type, d1->ret_type);
+            tassert_eq(d2->args, d1->args);
+            tassert_eq((char*)d2->file, src);
+            tassert_eq(d2->line, d1->line);
+            tassert_eq(d2->type, d1->type);
+            tassert_eq(d2->is_static, d1->is_static);
+            tassert_eq(d2->is_inline, d1->is_inline);
+        }
+        tassert_eq(decls2[0]->name, str$s("my_func"));
+        tassert_eq(decls2[0]->docs, str$s("/// my func"));
+        tassert_eq(decls2[0]->args, "int a, char* b");
+
+        // same size, different contents, cache must be invalidated
+        e$ret(io.file.save(src, str.replace(code, "my_func", "my_fund", _)));
+        char* code3 = io.file.load(src, _);
+        arr$(cex_decl_s*) decls3 = arr$new(decls3, _);
+        e$ret(_cexy__decls_parse(src, code3, NULL, _, &decls3));
+        tassert_eq(arr$len(decls3), 3);
+        tassert_eq(decls3[0]->name, str$s("my_fund"));
+    }
+    return EOK;
+}
+
 #else
 test$case(not_supported_by_platform)
 {
@@ -1,4 +1,4 @@
-#define TBUILDDIR "tests/build/cexytest/"
+#define TBUILDDIR "tests/build/cexy_help_test/"
 #define CEX_LOG_LVL 4
 #define cexy$cc_include "-I.", "-I" TBUILDDIR
 #include "src/all.c"
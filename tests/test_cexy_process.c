@@ -1,4 +1,4 @@
-#define TBUILDDIR "tests/build/cexytest/"
+#define TBUILDDIR "tests/build/cexy_process_test/"
 #define CEX_LOG_LVL 8
 #define cexy$cc_include "-I.", "-I" TBUILDDIR
 #include "src/all.c"
@@ -662,4 +662,351 @@ test$case(test_fload)
     return EOK;
 }
 
+test$case(test_file_mmap)
+{
+    io_mmap_s m = { 0 };
+    char* content = io.file.load("tests/data/text_file_line_4095.txt", mem$);
+    tassert(content);
+
+    tassert_er(EOK, io.file.mmap("tests/data/text_file_line_4095.txt", &m, NULL));
+    tassert(m._addr != NULL);
+    tassert_eq(m.data.len, strlen(content));
+    tassert(str.slice.eq(m.data, str.sstr(content)));
+    io.file.munmap(&m);
+    tassert(m._addr == NULL);
+    tassert_eq(m.data.len, 0);
+    io.file.munmap(&m); // safe to call twice
+
+    // private copy-on-write mapping is writable, file stays intact
+    io_mmap_flags_s flags = { .is_private = 1, .sequential = 1, .willneed = 1, .hugepage = 1 };
+    tassert_er(EOK, io.file.mmap("tests/data/text_file_line_4095.txt", &m, &flags));
+    m.data.buf[0] = 'X';
+    tassert_eq(m.data.buf[0], 'X');
+    io.file.munmap(&m);
+    tassert_er(EOK, io.file.mmap("tests/data/text_file_line_4095.txt", &m, NULL));
+    tassert_eq(m.data.buf[0], '4');
+    io.file.munmap(&m);
+    mem$free(mem$, content);
+
+    // binary contents with zero bytes
+    tassert_er(EOK, io.file.mmap("tests/data/text_file_zero_byte.txt", &m, NULL));
+    tassert_eq(m.data.len, 50);
+    tassert_eq(m.data.buf[11], '\0');
+    tassert(str.slice.starts_with(m.data, (str_s){ .buf = "000000001\n0\0", .len = 12 }));
+    io.file.munmap(&m);
+
+    tassert_er(EOK, io.file.mmap("tests/data/text_file_empty.txt", &m, NULL));
+    tassert_eq(m.data.len, 0);
+    tassert(m.data.buf != NULL);
+    io.file.munmap(&m);
+
+    tassert_er(Error.not_found, io.file.mmap("tests/data/asdjaldhashdajlkhuci.txt", &m, NULL));
+    tassert_eq(m.data.len, 0);
+    tassert_er(Error.argument, io.file.mmap(NULL, &m, NULL));
+    tassert_er(Error.argument, io.file.mmap("tests/data/", &m, NULL));
+    return EOK;
+}
+
+test$case(test_lines_iter)
+{
+    FILE* file;
+    FILE* file2;
+    usize buf_sizes[] = { 0, 1, 7, 4096 };
+    for$each (bsize, buf_sizes) {
+        tassert_er(EOK, io.fopen(&file, "tests/data/text_file_line_4095.txt", "r"));
+        tassert_er(EOK, io.fopen(&file2, "tests/data/text_file_line_4095.txt", "r"));
+
+        io_lines_c lr = io.lines.create(file, bsize, mem$);
+        usize n_lines = 0;
+        for$iter (str_s, it, io.lines.iter(&lr, &it.iterator)) {
+            tassert_eq(it.idx.i, n_lines);
+            str_s expected;
+            tassert_er(EOK, io.fread_line(file2, &expected, mem$));
+            tassert(str.slice.eq(it.val, expected));
+            mem$free(mem$, expected.buf);
+            n_lines++;
+        }
+        tassert_er(EOK, io.lines.validate(&lr));
+        tassert_eq(n_lines, lr.n_lines);
+        tassert(n_lines > 0);
+        str_s line;
+        tassert_er(Error.eof, io.lines.next(&lr, &line));
+        tassert_er(Error.eof, io.fread_line(file2, &line, mem$));
+
+        io.lines.destroy(&lr);
+        tassert(lr.buf == NULL);
+        io.fclose(&file);
+        io.fclose(&file2);
+    }
+    return EOK;
+}
+
+test$case(test_lines_next)
+{
+    char* content = "first\r\n\nthird line is longer than buffer\n\r\n\rlast\r";
+    tassert_er(EOK, io.file.save("tests/data/text_file_write.txt", content));
+
+    usize buf_sizes[] = { 0, 1, 2, 3, 8 };
+    for$each (bsize, buf_sizes) {
+        FILE* file;
+        tassert_er(EOK, io.fopen(&file, "tests/data/text_file_write.txt", "rb"));
+        io_lines_c lr = io.lines.create(file, bsize, mem$);
+        str_s line;
+        tassert_er(EOK, io.lines.next(&lr, &line));
+        tassert_eq(line, str$s("first"));
+        tassert_er(EOK, io.lines.next(&lr, &line));
+        tassert_eq(line, str$s(""));
+        tassert_er(EOK, io.lines.next(&lr, &line));
+        tassert_eq(line, str$s("third line is longer than buffer"));
+        tassert_er(EOK, io.lines.next(&lr, &line));
+        tassert_eq(line, str$s(""));
+        tassert_er(EOK, io.lines.next(&lr, &line));
+        tassert_eq(line, str$s("\rlast"));
+        tassert_er(Error.eof, io.lines.next(&lr, &line));
+        tassert_er(Error.eof, io.lines.next(&lr, &line));
+        tassert_eq(lr.n_lines, 5);
+        tassert_er(EOK, io.lines.validate(&lr));
+        io.lines.destroy(&lr);
+        io.fclose(&file);
+    }
+
+    FILE* file;
+    tassert_er(EOK, io.fopen(&file, "tests/data/text_file_empty.txt", "rb"));
+    io_lines_c lr = io.lines.create(file, 0, mem$);
+    for$iter (str_s, it, io.lines.iter(&lr, &it.iterator)) { tassert(false && "unexpected"); }
+    tassert_er(EOK, io.lines.validate(&lr));
+    io.lines.destroy(&lr);
+    io.fclose(&file);
+
+    lr = io.lines.create(NULL, 0, mem$);
+    str_s line;
+    tassert_er(Error.argument, io.lines.next(&lr, &line));
+    tassert_er(Error.argument, io.lines.validate(&lr));
+    io.lines.destroy(&lr);
+    return EOK;
+}
+
+test$case(test_async_io)
+{
+    io_async_opts_s backends[] = {
+        { .queue_depth = 16, .n_buffers = 8, .buf_size = 64 },
+        { .queue_depth = 16, .n_buffers = 8, .buf_size = 64, .no_uring = true },
+        { .queue_depth = 16, .n_buffers = 8, .buf_size = 64, .no_uring = true, .no_threads = true },
+    };
+    enum
+    {
+        n_files = 24
+    };
+
+    for$each (opts, backends) {
+        io_async_c aio;
+        tassert_er(EOK, io.async.create(&aio, &opts, mem$));
+        tassert(aio.backend != NULL);
+        tassert_eq(aio.queue_depth, 16);
+        if (opts.no_threads) { tassert_eq(aio.backend, "sync"); }
+
+        int fds[n_files];
+        char contents[n_files][32];
+        io_async_cqe_s cqe[8];
+        u32 n_done = 0;
+
+        // open for writing more files than queue depth, with backpressure
+        for (u32 i = 0; i < n_files; i++) {
+            char path[64];
+            tassert(str.sprintf(path, sizeof(path), "tests/data/text_file_async_%d.txt", i) == EOK);
+            Exc err = EOK;
+            while ((err = io.async.open(&aio, path, "w", i)) == Error.try_again) {
+                tassert_er(EOK, io.async.wait(&aio, cqe, arr$len(cqe), 1, &n_done));
+                for (u32 j = 0; j < n_done; j++) {
+                    tassert_er(EOK, cqe[j].err);
+                    tassert_eq(cqe[j].op, IOAsyncOp__open);
+                    fds[cqe[j].tag] = cqe[j].result;
+                }
+            }
+            tassert_er(EOK, err);
+        }
+        while (aio.n_pending > 0) {
+            tassert_er(EOK, io.async.wait(&aio, cqe, arr$len(cqe), aio.n_pending, &n_done));
+            for (u32 j = 0; j < n_done; j++) {
+                tassert_er(EOK, cqe[j].err);
+                fds[cqe[j].tag] = cqe[j].result;
+            }
+        }
+
+        // write + fsync + close as one batch per file (completion order is not guaranteed)
+        for (u32 i = 0; i < n_files; i++) {
+            tassert(str.sprintf(contents[i], sizeof(contents[i]), "async file #%d", i) == EOK);
+            tassert_er(EOK, io.async.write(&aio, fds[i], contents[i], strlen(contents[i]), 0, i));
+            tassert_er(EOK, io.async.submit(&aio));
+            tassert_er(EOK, io.async.wait(&aio, cqe, arr$len(cqe), 1, &n_done));
+            tassert_eq(n_done, 1);
+            tassert_er(EOK, cqe[0].err);
+            tassert_eq(cqe[0].result, strlen(contents[i]));
+            tassert(cqe[0].buf == contents[i]);
+            if (i % 8 == 0) {
+                tassert_er(EOK, io.async.fsync(&aio, fds[i], i));
+                tassert_er(EOK, io.async.wait(&aio, cqe, arr$len(cqe), 1, &n_done));
+                tassert_er(EOK, cqe[0].err);
+            }
+            tassert_er(EOK, io.async.close(&aio, fds[i], i));
+            tassert_er(EOK, io.async.wait(&aio, cqe, arr$len(cqe), 1, &n_done));
+            tassert_er(EOK, cqe[0].err);
+            tassert_eq(cqe[0].op, IOAsyncOp__close);
+        }
+        tassert_eq(aio.n_pending, 0);
+
+        // read back using pool buffers
+        char* bufs[n_files] = { 0 };
+        for (u32 i = 0; i < n_files; i++) {
+            char path[64];
+            tassert(str.sprintf(path, sizeof(path), "tests/data/text_file_async_%d.txt", i) == EOK);
+            tassert_er(EOK, io.async.open(&aio, path, "rb", i));
+            tassert_er(EOK, io.async.wait(&aio, cqe, arr$len(cqe), 1, &n_done));
+            tassert_er(EOK, cqe[0].err);
+            fds[i] = cqe[0].result;
+        }
+        u32 n_read = 0;
+        for (u32 i = 0; i < n_files; i++) {
+            bufs[i] = io.async.buf_get(&aio);
+            if (bufs[i] == NULL) {
+                tassert_eq(i, 8); // pool is exhausted
+                break;
+            }
+            memset(bufs[i], 0, 64);
+            tassert_er(EOK, io.async.read(&aio, fds[i], bufs[i], 64, 0, i));
+            n_read++;
+        }
+        tassert_eq(n_read, 8);
+        // regular buffer (not from pool)
+        char big_buf[64] = { 0 };
+        tassert_er(EOK, io.async.read(&aio, fds[n_read], big_buf, sizeof(big_buf), 0, n_read));
+
+        u32 n_completed = 0;
+        while (aio.n_pending > 0) {
+            tassert_er(EOK, io.async.wait(&aio, cqe, arr$len(cqe), 1, &n_done));
+            for (u32 j = 0; j < n_done; j++) {
+                u32 i = cqe[j].tag;
+                tassert_er(EOK, cqe[j].err);
+                tassert_eq(cqe[j].op, IOAsyncOp__read);
+                tassert_eq(cqe[j].result, strlen(contents[i]));
+                tassert_eq((char*)cqe[j].buf, contents[i]);
+                if (i < n_read) { io.async.buf_put(&aio, cqe[j].buf); }
+                n_completed++;
+            }
+        }
+        tassert_eq(n_completed, n_read + 1);
+        tassert(io.async.buf_get(&aio) != NULL); // buffers are returned
+
+        for (u32 i = 0; i < n_files; i++) {
+            while (io.async.close(&aio, fds[i], i) == Error.try_again) {
+                tassert_er(EOK, io.async.wait(&aio, cqe, arr$len(cqe), 1, &n_done));
+            }
+        }
+        io.async.destroy(&aio); // waits pending
+        tassert(aio._impl == NULL);
+
+        // queue is full
+        tassert_er(EOK, io.async.create(&aio, &opts, mem$));
+        for (u32 i = 0; i < aio.queue_depth; i++) {
+            tassert_er(EOK, io.async.open(&aio, "tests/data/text_file_50b.txt", "r", i));
+        }
+        tassert_er(Error.try_again, io.async.open(&aio, "tests/data/text_file_50b.txt", "r", 0));
+        u32 n_closed = 0;
+        while (aio.n_pending > 0) {
+            tassert_er(EOK, io.async.wait(&aio, cqe, arr$len(cqe), 1, &n_done));
+            for (u32 j = 0; j < n_done; j++) {
+                if (cqe[j].op == IOAsyncOp__open) {
+                    tassert_er(EOK, cqe[j].err);
+                    tassert_er(EOK, io.async.close(&aio, cqe[j].result, 0));
+                } else {
+                    n_closed++;
+                }
+            }
+        }
+        tassert_eq(n_closed, aio.queue_depth);
+        io.async.destroy(&aio);
+
+        tassert_er(EOK, io.async.create(&aio, &opts, mem$));
+        tassert_er(Error.argument, io.async.open(&aio, "tests/data/text_file_50b.txt", "z", 0));
+        tassert_er(Error.argument, io.async.read(&aio, -1, big_buf, 10, 0, 0));
+        tassert_er(EOK, io.async.open(&aio, "tests/data/asdjaldhashdajlkhuci.txt", "r", 77));
+        tassert_er(EOK, io.async.wait(&aio, cqe, arr$len(cqe), 1, &n_done));
+        tassert_eq(n_done, 1);
+        tassert_eq(cqe[0].tag, 77);
+        tassert_eq(cqe[0].result, -1);
+        tassert_er(Error.not_found, cqe[0].err);
+        io.async.destroy(&aio);
+    }
+
+    for (u32 i = 0; i < n_files; i++) {
+        char path[64];
+        tassert(str.sprintf(path, sizeof(path), "tests/data/text_file_async_%d.txt", i) == EOK);
+        tassert_er(EOK, os.fs.remove(path));
+    }
+    return EOK;
+}
+
+test$case(test_writev_and_save_atomic)
+{
+    mem$scope(tmem$, _)
+    {
+        // many parts (more than a single writev batch), including empty ones
+        arr$(str_s) parts = arr$new(parts, _);
+        sbuf_c expected = sbuf.create(1024, _);
+        for (u32 i = 0; i < 200; i++) {
+            char* p = str.fmt(_, "part%d;", i);
+            arr$push(parts, str.sstr(p));
+            if (i % 3 == 0) { arr$push(parts, str$s("")); }
+            tassert_er(EOK, sbuf.append(&expected, p));
+        }
+
+        char* fn = "tests/data/text_file_write.txt";
+        tassert_er(EOK, io.file.save(fn, "old contents"));
+        tassert_er(EOK, io.file.save_atomic(fn, parts, arr$len(parts), false));
+        tassert_eq(io.file.load(fn, _), expected);
+
+        // io.writev() on raw file descriptor
+        FILE* file;
+        tassert_er(EOK, io.fopen(&file, fn, "wb"));
+        tassert_er(EOK, io.writev(fileno(file), parts, arr$len(parts)));
+        tassert_er(EOK, io.writev(fileno(file), NULL, 0));
+        io.fclose(&file);
+        tassert_eq(io.file.load(fn, _), expected);
+        tassert_er(Error.argument, io.writev(-1, parts, 1));
+
+        // single slice, durable, binary data
+        str_s bin = { .buf = "a\0b\nc", .len = 5 };
+        tassert_er(EOK, io.file.save_atomic(fn, &bin, 1, true));
+        io_mmap_s m;
+        tassert_er(EOK, io.file.mmap(fn, &m, NULL));
+        tassert(str.slice.eq(m.data, bin));
+        io.file.munmap(&m);
+
+        // empty contents
+        tassert_er(EOK, io.file.save_atomic(fn, NULL, 0, false));
+        tassert_eq(io.file.load(fn, _), "");
+
+#ifndef _WIN32
+        // permissions of replaced file are kept
+        tassert_eq(0, chmod(fn, 0640));
+        tassert_er(EOK, io.file.save_atomic(fn, &bin, 1, false));
+        struct stat st;
+        tassert_eq(0, stat(fn, &st));
+        tassert_eq(st.st_mode & 0777, 0640);
+        tassert_eq(0, chmod(fn, 0644));
+#endif
+
+        tassert_er(Error.not_found, io.file.save_atomic("tests/data/not_existing_dir/f.txt", &bin, 1, false));
+        tassert_er(Error.argument, io.file.save_atomic(NULL, &bin, 1, false));
+        tassert_er(Error.argument, io.file.save_atomic(fn, NULL, 1, false));
+        char long_path[PATH_MAX] = { 0 };
+        memset(long_path, 'a', sizeof(long_path) - 1);
+        tassert_er(Error.overflow, io.file.save_atomic(long_path, &bin, 1, false));
+
+        // no temp files left
+        tassert_eq(arr$len(os.fs.find("tests/data/*.tmp", false, _)), 0);
+    }
+    return EOK;
+}
+
 test$main();
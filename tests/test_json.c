@@ -2,6 +2,8 @@
 #define CEX_TEST
 #include "cex.h"
 #include "lib/json/json.c"
+#include "tests/data/json_codegen.h"
+#include "tests/data/json_codegen_json.c"
 #include <math.h>
 #include <stdint.h>
 
@@ -645,7 +647,7 @@ test$case(json_writer_multi_func_serde_concept)
         print_json_expected(buf);
 
         char* expected = "{\n\
-    \"price\": 100.330002, \n\
+    \"price\": 100.33, \n\
     \"qty\": 33, \n\
     \"stock\": {\n\
         \"ticker\": \"UBER\", \n\
@@ -676,7 +678,7 @@ test$case(json_writer_multi_func_deser_order_err)
     {
 
         char* expected = "{\n\
-    \"price\": 100.330002, \n\
+    \"price\": 100.33, \n\
     \"qty\": 33, \n\
     \"stock\": {\n\
         \"ticker\": \"UBER\", \n\
@@ -771,17 +773,17 @@ test$case(json_writer_val_types)
     -9223372036854775808, \n\
     18446744073709551615, \n\
     \"@\", \n\
-    inf, \n\
-    -inf, \n\
-    nan, \n\
-    inf, \n\
-    -inf, \n\
-    nan, \n\
-    1, \n\
+    null, \n\
+    null, \n\
+    null, \n\
+    null, \n\
+    null, \n\
+    null, \n\
+    true, \n\
     \"const\", \n\
     \"str\", \n\
     \"str_s\", \n\
-    \"(null)\"\n\
+    null\n\
 ]";
         tassert_eq(buf, expected);
     }
@@ -814,4 +816,752 @@ test$case(json_reader_error_handling)
     return EOK;
 }
 
+test$case(json_writer_rope)
+{
+    mem$scope(tmem$, _)
+    {
+        jw_c jb;
+        sbuf_rope_c rope = sbuf.rope.create(0, _);
+        sbuf_c buf = sbuf.create(1024, _);
+        tassert_er(
+            "buf, rope and stream kwargs are mutually exclusive",
+            jw$new(&jb, .buf = buf, .rope = &rope)
+        );
+
+        tassert_er(EOK, jw$new(&jb, .rope = &rope, .indent = 0));
+        jw$scope(&jb, JsonType__arr)
+        {
+            for (u32 i = 0; i < 5000; i++) {
+                jw$val(i);
+                jw$val("item");
+            }
+        }
+        tassert_er(EOK, jb.error);
+        tassert(rope.first != rope.last);
+
+        char* json = sbuf.rope.flatten(&rope);
+        tassert(str.starts_with(json, "[0, \"item\", 1, \"item\", 2"));
+        tassert(str.ends_with(json, ", 4999, \"item\"]"));
+
+        jr_c js;
+        tassert_er(EOK, jr$new(&js, json, sbuf.rope.len(&rope)));
+        u32 cnt = 0;
+        jr$foreach(v, &js)
+        {
+            (void)v;
+            cnt++;
+        }
+        tassert_er(EOK, js.error);
+        tassert_eq(cnt, 10000);
+    }
+    return EOK;
+}
+
+test$case(json_reader_lexer_tokens)
+{
+    str_s content = str$s(
+        "[\"simple\", \"long string with \\\"escapes\\\" \\\\ and unicode \\u0430 текст\", "
+        "\"it's\", 1e-5, -2.5E+10, 0.125, 12345678901234567890, true, false, null, "
+        "{\"k\": []}, \"\"]"
+    );
+    char* expected[] = {
+        "simple",
+        "long string with \\\"escapes\\\" \\\\ and unicode \\u0430 текст",
+        "it's",
+        "1e-5",
+        "-2.5E+10",
+        "0.125",
+        "12345678901234567890",
+        "true",
+        "false",
+        "null",
+        NULL,
+        "",
+    };
+    JsonType_e types[] = { JsonType__str,  JsonType__str,  JsonType__str, JsonType__num,
+                           JsonType__num,  JsonType__num,  JsonType__num, JsonType__bool,
+                           JsonType__bool, JsonType__null, JsonType__obj, JsonType__str };
+
+    jr_c js;
+    e$ret(jr$new(&js, content.buf, content.len, .strict_mode = true));
+    u32 i = 0;
+    jr$foreach(v, &js)
+    {
+        tassert(i < arr$len(expected));
+        tassert_eq(js.type, types[i]);
+        if (expected[i]) { tassert_eq(v, str.sstr(expected[i])); }
+        i++;
+    }
+    tassert_er(EOK, js.error);
+    tassert_eq(i, arr$len(expected));
+
+    // non-strict mode: comments, single quotes
+    content = str$s(
+        "// header comment\n"
+        "{ /* multi\n line\n comment */ 'key': \"it's \\\"quoted\\\"\", // tail\n"
+        "  other: [1, 2,], }"
+    );
+    e$ret(jr$new(&js, content.buf, content.len));
+    i = 0;
+    jr$foreach(k, v, &js)
+    {
+        if (str$eq(k, "key")) {
+            tassert_eq(v, str$s("it's \\\"quoted\\\""));
+            i++;
+        } else if (str$eq(k, "other")) {
+            tassert_eq(js.type, JsonType__arr);
+            i++;
+        }
+    }
+    tassert_er(EOK, js.error);
+    tassert_eq(i, 2);
+    return EOK;
+}
+
+test$case(json_reader_lexer_errors)
+{
+    char* bad[] = {
+        "[\"unterminated",
+        "[\"unterminated escape\\",
+        "[\"raw\nnew line\"]",
+        "[\"raw\ttab in a longer string\"]",
+        "[1, 2 /* unterminated comment",
+        "[1e-5-]",
+        "[1, @]",
+    };
+    for$each (b, bad) {
+        jr_c js;
+        e$ret(jr$new(&js, b, 0));
+        jr$foreach(v, &js) { (void)v; }
+        tassertf(js.error != EOK, "expected error: %s", b);
+    }
+
+    // line/col points to the error position
+    str_s content = str$s("{\n  \"a\": 1,\n  \"b\": [1, 2],\n  \"c\": x\n}");
+    jr_c js;
+    e$ret(jr$new(&js, content.buf, content.len, .strict_mode = true));
+    jr$foreach(k, v, &js)
+    {
+        (void)k;
+        (void)v;
+    }
+    tassert_er(js.error, "Unexpected token");
+    tassert_eq(js._impl.lexer.line + 1, 4);
+    tassert_eq(js._impl.lexer.col, 9);
+    return EOK;
+}
+
+test$case(json_reader_trusted_skip_and_tape)
+{
+    str_s content = str$s(
+        "{\"skip\": {\"a\": [1, {\"b\": \"}]\"}], \"c\": \"\\\"{\"},\n"
+        " \"arr\": [[1], [2, [3]], \"]\"], // comment with }\n"
+        " \"obj\": {\"x\": [\"[\", {}], /* ] */ \"y\": {\"z\": 7}},\n"
+        " \"last\": {\"k\": [10, 20]}\n"
+        "}"
+    );
+
+    jr_tape_c tape = { .allc = mem$ };
+    for (u32 mode = 0; mode < 4; mode++) {
+        jr_c js;
+        e$ret(jr$new(
+            &js,
+            content.buf,
+            content.len,
+            .trusted_input = (mode & 1),
+            .tape = (mode & 2) ? &tape : NULL
+        ));
+        if (mode & 2) {
+            tassert(js._impl.tape == &tape);
+            tassert_eq(arr$len(tape.scopes), 14);
+            tassert_eq(tape.scopes[0].start, 0);
+            tassert_eq(tape.scopes[0].end, content.len - 1);
+            tassert_eq(tape.scopes[0].n_nested, 13);
+        }
+
+        u32 n_keys = 0;
+        i32 k_sum = 0;
+        jr$foreach(k, v, &js)
+        {
+            n_keys++;
+            if (str$eq(k, "arr")) {
+                str_s scope = jr$get_scope_str_s(&js, JsonType__arr);
+                tassert_eq(scope, str$s("[[1], [2, [3]], \"]\"]"));
+            } else if (str$eq(k, "obj")) {
+                str_s scope = jr$get_scope_str_s(&js, JsonType__obj);
+                tassert_eq(scope, str$s("{\"x\": [\"[\", {}], /* ] */ \"y\": {\"z\": 7}}"));
+            } else if (str$eq(k, "last")) {
+                // stepping in after skips, tape must be in sync
+                jr$foreach(k2, v2, &js)
+                {
+                    tassert_eq(k2, str$s("k"));
+                    jr$foreach(n, &js)
+                    {
+                        i32 num = 0;
+                        e$ret(str$convert(n, &num));
+                        k_sum += num;
+                    }
+                    (void)v2;
+                }
+            }
+            // "skip" is not stepped in, skipped by jr$foreach
+            (void)v;
+        }
+        tassertf(js.error == EOK, "mode: %d error: %s", mode, js.error);
+        tassert_eq(n_keys, 4);
+        tassert_eq(k_sum, 30);
+    }
+
+    // tape is reused for the same content on request, and rebuilt for another
+    arr$(jr_tape_scope_s) scopes = tape.scopes;
+    jr_c js;
+    e$ret(jr$new(&js, content.buf, content.len, .tape = &tape, .tape_reuse = true));
+    tassert(tape.scopes == scopes);
+    tassert_eq(arr$len(tape.scopes), 14);
+    e$ret(jr$new(&js, "[[], {}]", 0, .tape = &tape, .tape_reuse = true));
+    tassert_eq(arr$len(tape.scopes), 3);
+    tassert_eq(tape.scopes[2].start, 5);
+    tassert_eq(tape.scopes[2].end, 6);
+
+    // the same buffer refilled with other content of the same length, tape is rebuilt
+    char buf[] = "{\"a\": [1, 22], \"b\": {}, \"c\": 33}";
+    e$ret(jr$new(&js, buf, 0, .tape = &tape));
+    tassert_eq(arr$len(tape.scopes), 3);
+    memcpy(buf, "{\"a\": {}, \"b\": [1, [2]], \"c\": 3}", sizeof(buf));
+    e$ret(jr$new(&js, buf, 0, .tape = &tape));
+    tassert_eq(arr$len(tape.scopes), 4);
+    u32 n_keys = 0;
+    jr$foreach(k, v, &js)
+    {
+        n_keys++;
+        if (str$eq(k, "b")) {
+            tassert_eq(jr$get_scope_str_s(&js, JsonType__arr), str$s("[1, [2]]"));
+        } else if (str$eq(k, "c")) {
+            tassert_eq(v, str$s("3"));
+        }
+    }
+    tassert_er(js.error, EOK);
+    tassert_eq(n_keys, 3);
+
+    // skipped scopes are not validated with tape or trusted_input
+    char* bad_skipped = "{\"skip\": {\"a\": @@@}, \"b\": 1}";
+    for (u32 mode = 0; mode < 3; mode++) {
+        jr_tape_c* t = (mode == 2) ? &tape : NULL;
+        e$ret(jr$new(&js, bad_skipped, 0, .trusted_input = (mode == 1), .tape = t));
+        jr$foreach(k, v, &js)
+        {
+            (void)k;
+            (void)v;
+        }
+        if (mode == 0) {
+            tassert_er(js.error, "Unexpected token");
+        } else {
+            tassert_er(js.error, EOK);
+        }
+    }
+
+    // broken structure, tape is not used, reader reports errors
+    e$ret(jr$new(&js, "[[1, 2}, 3]", 0, .tape = &tape));
+    tassert(js._impl.tape == NULL);
+    tassert(tape.content == NULL);
+    jr$foreach(v, &js) { (void)v; }
+    tassert(js.error != EOK);
+
+    // trusted input: unterminated scope is still an error
+    e$ret(jr$new(&js, "[[1, \"]\"", 0, .trusted_input = true));
+    jr$foreach(v, &js) { (void)v; }
+    tassert_er(js.error, "Unexpected end of JSON scope");
+
+    jr$tape_free(&tape);
+    tassert(tape.scopes == NULL);
+    return EOK;
+}
+
+test$case(json_reader_ndjson_stream)
+{
+    FILE* fh = tmpfile();
+    tassert(fh != NULL);
+    fputs("{\"id\": 1, \"name\": \"first\"}\n", fh);
+    fputs("\n", fh);
+    fputs("  \r\n", fh);
+    fputs("{\"id\": 2, \"name\": \"a longer record which needs window growth\"}\r\n", fh);
+    fputs("[3, 4]\n", fh);
+    fputs("{\"id\": 5, \"name\": \"no trailing new line\"}", fh);
+    rewind(fh);
+
+    jr_stream_c jrs;
+    jr_c js;
+    // tiny window, forces refills and growth
+    e$ret(jr$stream_new(&jrs, fh, mem$, .buf_size = 8, .strict_mode = true));
+
+    u32 n_records = 0;
+    u32 id_sum = 0;
+    u64 lines[4] = { 0 };
+    while (jr$stream_next(&jrs, &js)) {
+        tassert(n_records < arr$len(lines));
+        lines[n_records++] = jrs.line;
+        if (js.type == JsonType__arr) {
+            jr$foreach(v, &js)
+            {
+                u32 n = 0;
+                e$ret(str$convert(v, &n));
+                id_sum += n;
+            }
+        } else {
+            jr$foreach(k, v, &js)
+            {
+                if (str$eq(k, "id")) {
+                    u32 n = 0;
+                    e$ret(str$convert(v, &n));
+                    id_sum += n;
+                }
+            }
+        }
+        tassert_er(js.error, EOK);
+    }
+    tassert_er(jrs.error, EOK);
+    tassert_eq(n_records, 4);
+    tassert_eq(id_sum, 1 + 2 + 3 + 4 + 5);
+    tassert_eq(lines[0], 0);
+    tassert_eq(lines[1], 3);
+    tassert_eq(lines[2], 4);
+    tassert_eq(lines[3], 5);
+    tassert_eq(jrs.offset, 103);
+    jr$stream_free(&jrs);
+
+    // record is longer than max_record
+    rewind(fh);
+    e$ret(jr$stream_new(&jrs, fh, mem$, .buf_size = 8, .max_record = 32));
+    tassert(jr$stream_next(&jrs, &js));
+    tassert(!jr$stream_next(&jrs, &js));
+    tassert_er(jrs.error, "JSON record is too long");
+    jr$stream_free(&jrs);
+    fclose(fh);
+
+    // record errors are reported with absolute line/offset
+    fh = tmpfile();
+    fputs("[1]\n[2]\n[3, x]\n", fh);
+    rewind(fh);
+    e$ret(jr$stream_new(&jrs, fh, mem$, .strict_mode = true));
+    while (jr$stream_next(&jrs, &js)) {
+        jr$foreach(v, &js) { (void)v; }
+        if (js.error) { break; }
+    }
+    tassert_er(jrs.error, EOK);
+    tassert_er(js.error, "Unexpected token");
+    tassert_eq(jrs.line, 2);
+    tassert_eq(jrs.offset, 8);
+    mem$scope(tmem$, _)
+    {
+        char* msg = str.fmt(_, jr$stream_err_fmt(&jrs, &js));
+        tassert_eq(msg, "JSON Parsing Error (Unexpected token) at line: 3 col: 5 offset: 8\n");
+    }
+    jr$stream_free(&jrs);
+    fclose(fh);
+    return EOK;
+}
+
+static Exception
+_ndjson_sum_cb(jr_c* record, u64 offset, u32 worker_id, void* ctx)
+{
+    (void)worker_id;
+    (void)offset;
+    u64* sum = ctx;
+    jr$foreach(k, v, record)
+    {
+        if (str$eq(k, "n")) {
+            u64 n = 0;
+            e$ret(str$convert(v, &n));
+            if (n == 99999) { return "record 99999"; }
+            __atomic_fetch_add(sum, n, __ATOMIC_RELAXED);
+        }
+    }
+    return record->error;
+}
+
+test$case(json_reader_ndjson_parallel)
+{
+    sbuf_c buf = sbuf.create(1024 * 1024, mem$);
+    u64 expected = 0;
+    for (u32 i = 0; i < 20000; i++) {
+        e$ret(sbuf.appendf(&buf, "{\"n\": %u, \"pad\": \"%s\"}\n", i, "some padding text"));
+        expected += i;
+    }
+
+    for (u32 n_workers = 1; n_workers <= 8; n_workers *= 2) {
+        u64 sum = 0;
+        e$ret(jr$ndjson_parallel(
+            buf,
+            sbuf.len(&buf),
+            .fn = _ndjson_sum_cb,
+            .ctx = &sum,
+            .n_workers = n_workers
+        ));
+        tassert_eq(sum, expected);
+    }
+
+    // errors are reported, the first by content position
+    e$ret(sbuf.appendf(&buf, "{\"n\": 99999}\n{\"n\": 1, bad}\n"));
+    u64 sum = 0;
+    tassert_er(
+        jr$ndjson_parallel(buf, sbuf.len(&buf), .fn = _ndjson_sum_cb, .ctx = &sum, .n_workers = 4),
+        "record 99999"
+    );
+
+    // errors in different chunks, a later chunk must not cut off an earlier one
+    sbuf.clear(&buf);
+    u64 expected_prefix = 0;
+    for (u32 i = 0; i < 20000; i++) {
+        if (i == 4000) {
+            e$ret(sbuf.appendf(&buf, "{\"n\": 99999}\n"));
+        } else if (i == 17000) {
+            e$ret(sbuf.appendf(&buf, "{\"n\": 1, bad}\n"));
+        } else {
+            e$ret(sbuf.appendf(&buf, "{\"n\": %u, \"pad\": \"%s\"}\n", i, "some padding text"));
+        }
+        if (i < 4000) { expected_prefix += i; }
+    }
+    for (u32 n_workers = 1; n_workers <= 8; n_workers *= 2) {
+        sum = 0;
+        tassert_er(
+            jr$ndjson_parallel(
+                buf,
+                sbuf.len(&buf),
+                .fn = _ndjson_sum_cb,
+                .ctx = &sum,
+                .n_workers = n_workers
+            ),
+            "record 99999"
+        );
+        tassert(sum >= expected_prefix);
+    }
+    sbuf.destroy(&buf);
+    return EOK;
+}
+
+test$case(json_reader_typed_getters)
+{
+    char content[] = "{\"i\": -9223372036854775808, \"imax\": 9223372036854775807,"
+                     " \"big\": 9223372036854775808, \"f\": 1.5e3, \"f2\": -0.001,"
+                     " \"pi\": 3.141592653589793, \"tiny\": 2.2250738585072014e-308,"
+                     " \"long\": 12345678901234567890123, \"t\": true, \"n\": null,"
+                     " \"umax\": 18446744073709551615, \"ubig\": 18446744073709551616,"
+                     " \"s\": \"plain\", \"e\": \"a\\\"b\\\\c\\/d\\n\\u00e9\\u20AC\\ud83d\\ude00\"}";
+
+    jr_c js;
+    e$ret(jr$new(&js, content, 0, .strict_mode = true));
+    u32 n_checks = 0;
+    jr$foreach(k, v, &js)
+    {
+        (void)v;
+        i64 i = 0;
+        u64 u = 0;
+        f64 f = 0;
+        bool b = false;
+        char buf[32];
+        if (str$eq(k, "i")) {
+            e$ret(jr$get_i64(&js, &i));
+            tassert_eq(i, INT64_MIN);
+            tassert_er(jr$get_u64(&js, &u), Error.overflow);
+            e$ret(jr$get_f64(&js, &f));
+            tassert_eq(f, -9223372036854775808.0);
+        } else if (str$eq(k, "imax")) {
+            e$ret(jr$get_i64(&js, &i));
+            tassert_eq(i, INT64_MAX);
+        } else if (str$eq(k, "big")) {
+            tassert_er(jr$get_i64(&js, &i), Error.overflow);
+            e$ret(jr$get_u64(&js, &u));
+            tassert_eq(u, (u64)INT64_MAX + 1);
+        } else if (str$eq(k, "umax")) {
+            e$ret(jr$get_u64(&js, &u));
+            tassert_eq(u, UINT64_MAX);
+        } else if (str$eq(k, "ubig")) {
+            tassert_er(jr$get_u64(&js, &u), Error.overflow);
+        } else if (str$eq(k, "f")) {
+            tassert_er(jr$get_i64(&js, &i), Error.argument);
+            tassert_er(jr$get_u64(&js, &u), Error.argument);
+            e$ret(jr$get_f64(&js, &f));
+            tassert_eq(f, 1500.0);
+        } else if (str$eq(k, "f2")) {
+            e$ret(jr$get_f64(&js, &f));
+            tassert_eq(f, -0.001);
+        } else if (str$eq(k, "pi")) {
+            e$ret(jr$get_f64(&js, &f));
+            tassert_eq(f, 3.141592653589793);
+        } else if (str$eq(k, "tiny")) {
+            e$ret(jr$get_f64(&js, &f));
+            tassert(f > 0 && f < 1e-307);
+        } else if (str$eq(k, "long")) {
+            e$ret(jr$get_f64(&js, &f));
+            tassert(fabs(f - 12345678901234567890123.0) / f < 1e-12);
+        } else if (str$eq(k, "t")) {
+            tassert_er(jr$get_f64(&js, &f), "Expected number value");
+            e$ret(jr$get_bool(&js, &b));
+            tassert(b);
+        } else if (str$eq(k, "n")) {
+            tassert_er(jr$get_bool(&js, &b), "Expected bool value");
+            tassert_er(jr$get_str(&js, buf, sizeof(buf)), "Expected string value");
+        } else if (str$eq(k, "s")) {
+            e$ret(jr$get_str(&js, buf, sizeof(buf)));
+            tassert_eq(buf, "plain");
+            tassert_er(jr$get_str(&js, buf, 5), Error.overflow);
+            tassert_eq(buf, "");
+        } else if (str$eq(k, "e")) {
+            char* expected = "a\"b\\c/d\n\xc3\xa9\xe2\x82\xac\xf0\x9f\x98\x80";
+            e$ret(jr$get_str(&js, buf, sizeof(buf)));
+            tassert_eq(buf, expected);
+            mem$scope(tmem$, _)
+            {
+                char* a = NULL;
+                e$ret(jr$get_str_alloc(&js, &a, _));
+                tassert_eq(a, expected);
+            }
+            str_s inplace = { 0 };
+            e$ret(jr$get_str_inplace(&js, &inplace));
+            tassert_eq(inplace, str.sstr(expected));
+            tassert_eq(js.val, str.sstr(expected));
+        } else {
+            continue;
+        }
+        n_checks++;
+    }
+    tassert_er(js.error, EOK);
+    tassert_eq(n_checks, 14);
+
+    // number format validation
+    struct
+    {
+        char* json;
+        bool strict;
+        Exc err;
+        f64 val;
+    } nums[] = {
+        { "[0]", true, EOK, 0 },
+        { "[-0.0]", true, EOK, 0 },
+        { "[1E+2]", true, EOK, 100 },
+        { "[25e-1]", true, EOK, 2.5 },
+        { "[01]", true, Error.argument, 0 },
+        { "[1.]", true, Error.argument, 0 },
+        { "[1e]", true, Error.argument, 0 },
+        { "[1.2.3]", true, Error.argument, 0 },
+        { "[0x10]", true, Error.argument, 0 },
+        { "[1.]", false, EOK, 1 },
+        { "[+7]", false, EOK, 7 },
+        { "[-inf]", false, EOK, -INFINITY },
+        // correctly rounded long mantissas
+        { "[0.30000000000000004]", true, EOK, 0.30000000000000004 },
+        { "[8.988465674311579e-15]", true, EOK, 8.988465674311579e-15 },
+        { "[1.7976931348623157e308]", true, EOK, 1.7976931348623157e308 },
+        { "[4.9406564584124654e-324]", true, EOK, 4.9406564584124654e-324 },
+        { "[1e400]", true, Error.overflow, 0 },
+    };
+    for$each (it, nums) {
+        e$ret(jr$new(&js, it.json, 0, .strict_mode = it.strict));
+        jr$foreach(v, &js)
+        {
+            (void)v;
+            f64 f = -1;
+            tassertf(jr$get_f64(&js, &f) == it.err, "json: %s", it.json);
+            if (it.err == EOK) { tassertf(f == it.val, "json: %s f: %g", it.json, f); }
+        }
+        tassert_er(js.error, EOK);
+    }
+
+    // invalid escapes
+    char* bad[] = { "[\"\\x\"]", "[\"\\u12\"]", "[\"\\u12G4\"]", "[\"\\'\"]" };
+    for$each (b, bad) {
+        e$ret(jr$new(&js, b, 0, .strict_mode = true));
+        jr$foreach(v, &js)
+        {
+            (void)v;
+            char buf[16];
+            tassert_er(jr$get_str(&js, buf, sizeof(buf)), "Invalid string escape");
+        }
+    }
+
+    // lone surrogates are replaced by U+FFFD
+    e$ret(jr$new(&js, "[\"\\ud800x\\udc00\"]", 0, .strict_mode = true));
+    jr$foreach(v, &js)
+    {
+        (void)v;
+        char buf[16];
+        e$ret(jr$get_str(&js, buf, sizeof(buf)));
+        tassert_eq(buf, "\xef\xbf\xbdx\xef\xbf\xbd");
+    }
+    tassert_er(js.error, EOK);
+    return EOK;
+}
+
+test$case(json_codegen_roundtrip)
+{
+    char* json = "{\"qty\": 33, \"side\": -1, \"flags\": 65535, \"count\": -70000, \"seq\": 12,"
+                 " \"ts\": 1700000000123, \"price\": 100.25, \"fee\": 0.5, \"unknown\": [1, {}],"
+                 " \"note\": \"caf\\u00e9\", \"raw\": \"x\\ty\", \"stock\": {\"id\": 8899,"
+                 " \"ticker\": \"UBER\", \"is_active\": true}, \"hedge\": {\"id\": -1,"
+                 " \"ticker\": \"ES\"}, \"is_open\": true, \"is_hidden\": null}";
+
+    mem$scope(tmem$, _)
+    {
+        jr_c jr;
+        json_order_s ord = { 0 };
+        e$ret(jr$new(&jr, json, 0, .strict_mode = true));
+        e$ret(json_order_s_json_decode(&jr, &ord, _));
+
+        tassert_eq(ord.qty, 33);
+        tassert_eq(ord.side, -1);
+        tassert_eq(ord.flags, 65535);
+        tassert_eq(ord.count, -70000);
+        tassert_eq(ord.seq, 12);
+        tassert_eq(ord.ts, 1700000000123);
+        tassert_eq(ord.price, 100.25);
+        tassert_eq(ord.fee, 0.5);
+        tassert_eq(ord.note, "caf\xc3\xa9");
+        tassert_eq(ord.raw, str.sstr("x\\ty"));
+        tassert_eq(ord.stock.id, 8899);
+        tassert_eq(ord.stock.ticker, "UBER");
+        tassert_eq(ord.stock.is_active, true);
+        tassert(ord.hedge != NULL);
+        tassert_eq(ord.hedge->id, -1);
+        tassert_eq(ord.hedge->ticker, "ES");
+        tassert_eq(ord.hedge->is_active, false);
+        tassert_eq(ord.is_open, true);
+        tassert_eq(ord.is_hidden, false);
+
+        sbuf_c buf = sbuf.create(1024, _);
+        jw_c jw;
+        ord.ts = UINT64_MAX; // above INT64_MAX
+        e$ret(jw$new(&jw, .buf = buf));
+        e$ret(json_order_s_json_encode(&jw, &ord));
+
+        json_order_s ord2 = { 0 };
+        e$ret(jr$new(&jr, buf, sbuf.len(&buf), .strict_mode = true));
+        e$ret(json_order_s_json_decode(&jr, &ord2, _));
+        tassert_eq(ord2.qty, ord.qty);
+        tassert_eq(ord2.count, ord.count);
+        tassert_eq(ord2.ts, UINT64_MAX);
+        tassert_eq(ord2.price, ord.price);
+        tassert_eq(ord2.note, ord.note);
+        tassert_eq(ord2.stock.ticker, "UBER");
+        tassert_eq(ord2.hedge->ticker, "ES");
+        tassert_eq(ord2.is_open, true);
+
+        // type and range errors
+        struct
+        {
+            char* json;
+            Exc err;
+        } bad[] = {
+            { "{\"qty\": -1}", Error.overflow },
+            { "{\"ts\": 18446744073709551616}", Error.overflow },
+            { "{\"side\": 128}", Error.overflow },
+            { "{\"qty\": \"1\"}", "Expected number value" },
+            { "{\"is_open\": 1}", "Expected bool value" },
+            { "{\"stock\": {\"ticker\": \"TOOLONGTICKER\"}}", Error.overflow },
+            { "{\"note\": 1}", "Expected string value" },
+        };
+        for$each (it, bad) {
+            json_order_s o = { 0 };
+            e$ret(jr$new(&jr, it.json, 0, .strict_mode = true));
+            tassertf(json_order_s_json_decode(&jr, &o, _) == it.err, "json: %s", it.json);
+        }
+    }
+    return EOK;
+}
+
+test$case(json_writer_escape_compact_and_nested)
+{
+    mem$scope(tmem$, _)
+    {
+        jw_c jb;
+        sbuf_c buf = sbuf.create(16, _);
+        tassert_er(EOK, jw$new(&jb, .buf = buf, .compact = true, .indent = 4));
+
+        jw$scope(&jb, JsonType__obj)
+        {
+            jw$key("nested");
+            jw$scope(&jb, JsonType__arr)
+            {
+                jw$scope(&jb, JsonType__arr) { jw$val(1); }
+                jw$scope(&jb, JsonType__arr) { jw$val(-2); }
+                jw$scope(&jb, JsonType__obj) {}
+                jw$bool(true);
+            }
+            jw$key("k\"%d", 1);
+            jw$val("q\"b\\s\n\t\x01/é");
+            jw$key("long string \t key");
+            jw$val(str$s("0123456789\"0123456789"));
+            jw$key(fmt$("c%d\t"), 2);
+            jw$val(2);
+            jw$key("f");
+            jw$scope(&jb, JsonType__arr)
+            {
+                jw$val(0.1);
+                jw$val(1.5);
+                jw$val(1e22);
+                jw$val(-0.0);
+                jw$val(123456789012.0);
+                jw$val(0.1f);
+                jw$val(3.14159274f);
+                jw$val(2.2250738585072014e-308);
+                jw$val((char)'"');
+            }
+        }
+        tassert_er(EOK, jw$validate(&jb));
+        buf = jb.buf;
+        io.printf("\nJSON (buf): \n%s\n", buf);
+
+        char* expected = "{\"nested\":[[1],[-2],{},true],\"k\\\"1\":\"q\\\"b\\\\s\\n\\t\\u0001/é\","
+                         "\"long string \\t key\":\"0123456789\\\"0123456789\","
+                         "\"c2\\t\":2,"
+                         "\"f\":[0.1,1.5,1e+22,-0,123456789012,0.1,3.1415927,"
+                         "2.2250738585072014e-308,\"\\\"\"]}";
+        tassert_eq(buf, expected);
+
+        // formatted keys have no length limit
+        char long_key[600];
+        memset(long_key, '"', sizeof(long_key) - 1);
+        long_key[sizeof(long_key) - 1] = '\0';
+        sbuf_c kbuf = sbuf.create(16, _);
+        tassert_er(EOK, jw$new(&jb, .buf = kbuf, .compact = true));
+        jw$scope(&jb, JsonType__obj)
+        {
+            jw$key("%s%d", long_key, 7);
+            jw$val(1);
+        }
+        tassert_er(EOK, jw$validate(&jb));
+        tassert_eq(sbuf.len(&jb.buf), (sizeof(long_key) - 1) * 2 + strlen("{\"7\":1}"));
+        tassert(str.ends_with(jb.buf, "\\\"7\":1}"));
+
+        // escaped strings larger than internal buffer, round trip via jr$
+        sbuf_c big = sbuf.create(64, _);
+        for (u32 i = 0; i < 3 * CEX_JSON_WRITER_BUF_SIZE; i++) {
+            char c[2] = { (char)(1 + i % 127), 0 };
+            e$ret(sbuf.append(&big, c));
+        }
+        sbuf_rope_c rope = sbuf.rope.create(0, _);
+        tassert_er(EOK, jw$new(&jb, .rope = &rope));
+        jw$scope(&jb, JsonType__arr)
+        {
+            for (u32 i = 0; i < 3; i++) { jw$val(big); }
+        }
+        tassert_er(EOK, jw$validate(&jb));
+
+        jr_c js;
+        char* json = sbuf.rope.flatten(&rope);
+        tassert_er(EOK, jr$new(&js, json, 0, .strict_mode = true));
+        u32 cnt = 0;
+        jr$foreach(v, &js)
+        {
+            (void)v;
+            char* out = NULL;
+            e$ret(jr$get_str_alloc(&js, &out, _));
+            tassert_eq(out, big);
+            cnt++;
+        }
+        tassert_er(EOK, js.error);
+        tassert_eq(cnt, 3);
+    }
+    return EOK;
+}
+
 test$main();
@@ -378,6 +378,16 @@ test$case(os_cmd_run)
     return EOK;
 }
 
+test$case(os_cmd_run_not_existing)
+{
+    os_cmd_c c = { 0 };
+    char* args[] = { TBUILDDIR "not_existing_app", NULL };
+    tassert_er(Error.os, os.cmd.run(args, arr$len(args), &c));
+    tassert_er(Error.os, os$cmd(TBUILDDIR "not_existing_app", "arg"));
+    tassert_er(Error.os, os$cmd("alskdislkdfjslkfjk"));
+    return EOK;
+}
+
 test$case(os_cmd_run_macro_space_in_args)
 {
     mem$scope(tmem$, _)
@@ -453,6 +463,278 @@ test$case(os_cmd_env_inheritance_cmd_run_not_found)
     return EOK;
 }
 
+test$case(os_cmd_pool_output_capture)
+{
+    mem$scope(tmem$, _)
+    {
+        os_cmd_pool_c pool;
+        os_cmd_pool_opts_s opts = { .n_jobs = 3, .keep_output = true, .no_print = true };
+        tassert_er(EOK, os.cmd.pool_create(&pool, &opts, _));
+        tassert_eq(pool.opts.n_jobs, 3);
+
+        for (u32 i = 0; i < 10; i++) {
+            char* args[] = { test_app("write_lines", _),
+                             (i % 2) ? "stderr" : "stdout",
+                             str.fmt(_, "%d", 100 + i * 100),
+                             NULL };
+            tassert_er(EOK, os.cmd.pool_add(&pool, args, arr$len(args)));
+            tassert(pool.n_running <= 3);
+        }
+        tassert_er(EOK, os.cmd.pool_join(&pool));
+        tassert_eq(pool.n_running, 0);
+        tassert_eq(pool.n_failed, 0);
+        tassert_eq(arr$len(pool.jobs), 10);
+
+        for$each (job, pool.jobs) {
+            u32 i = job.args[2] ? (atoi(job.args[2]) / 100 - 1) : 0;
+            tassert_eq(job.is_done, true);
+            tassert_eq(job.ret_code, 0);
+            tassert_er(EOK, job.err);
+            tassert_eq(job.args[3], NULL);
+            tassert(job.output != NULL);
+            arr$(char*) lines = str.split_lines(job.output, _);
+            tassert_eq(arr$len(lines), 100 + i * 100);
+            tassert_eq(lines[arr$len(lines) - 1], str.fmt(_, "%09d", 100 + i * 100 - 1));
+        }
+        os.cmd.pool_destroy(&pool);
+        tassert(pool.jobs == NULL);
+    }
+    return EOK;
+}
+
+test$case(os_cmd_pool_fail_fast)
+{
+    mem$scope(tmem$, _)
+    {
+        os_cmd_pool_c pool;
+        os_cmd_pool_opts_s opts = { .n_jobs = 1, .keep_output = true, .no_print = true };
+        tassert_er(EOK, os.cmd.pool_create(&pool, &opts, _));
+
+        char* args_fail[] = { test_app("write_arg", _), NULL };
+        char* args_ok[] = { test_app("write_arg", _), "hello world", NULL };
+        tassert_er(EOK, os.cmd.pool_add(&pool, args_fail, arr$len(args_fail)));
+        // waits for free slot, previous job failed -> no launch
+        tassert_er(Error.runtime, os.cmd.pool_add(&pool, args_ok, arr$len(args_ok)));
+        tassert_er(Error.runtime, os.cmd.pool_join(&pool));
+        tassert_eq(arr$len(pool.jobs), 1);
+        tassert_eq(pool.n_failed, 1);
+        tassert_eq(pool.jobs[0].ret_code, 1);
+        tassert_er(Error.runtime, pool.jobs[0].err);
+        tassert(str.starts_with(pool.jobs[0].output, "Usage:"));
+
+        tassert_er(Error.argument, os.cmd.pool_add(&pool, args_ok, 2));
+        char* args_noexec[] = { TBUILDDIR "not_existing_app", NULL };
+        tassert_er(Error.runtime, os.cmd.pool_add(&pool, args_noexec, arr$len(args_noexec)));
+        tassert_er(Error.argument, os.cmd.pool_add(&pool, NULL, 0));
+        os.cmd.pool_destroy(&pool);
+    }
+    return EOK;
+}
+
+test$case(os_cmd_pool_keep_going)
+{
+    mem$scope(tmem$, _)
+    {
+        os_cmd_pool_c pool;
+        os_cmd_pool_opts_s opts = { .n_jobs = 2, .keep_going = true, .no_print = true };
+        tassert_er(EOK, os.cmd.pool_create(&pool, &opts, _));
+
+        char* args_fail[] = { test_app("write_arg", _), NULL };
+        char* args_ok[] = { test_app("write_arg", _), "hello world", NULL };
+        char* args_noexec[] = { TBUILDDIR "not_existing_app", NULL };
+        tassert_er(EOK, os.cmd.pool_add(&pool, args_fail, arr$len(args_fail)));
+        tassert_er(EOK, os.cmd.pool_add(&pool, args_noexec, arr$len(args_noexec)));
+        for (u32 i = 0; i < 5; i++) {
+            tassert_er(EOK, os.cmd.pool_add(&pool, args_ok, arr$len(args_ok)));
+        }
+        // launch error is the first failure, it happens before the first job finishes
+        tassert_er(Error.os, os.cmd.pool_join(&pool));
+        tassert_eq(arr$len(pool.jobs), 7);
+        tassert_eq(pool.n_failed, 2);
+        tassert_eq(pool.jobs[0].ret_code, 1);
+        tassert_er(Error.runtime, pool.jobs[0].err);
+        tassert_eq(pool.jobs[1].ret_code, -1);
+        tassert_er(Error.os, pool.jobs[1].err);
+        for (u32 i = 2; i < arr$len(pool.jobs); i++) {
+            tassert_eq(pool.jobs[i].ret_code, 0);
+            tassert_eq(pool.jobs[i].output, NULL); // no opts.keep_output
+        }
+        os.cmd.pool_destroy(&pool);
+    }
+    return EOK;
+}
+
+test$case(os_cmd_pool_parallel_and_destroy)
+{
+    mem$scope(tmem$, _)
+    {
+        os_cmd_pool_c pool;
+        tassert_er(EOK, os.cmd.pool_create(&pool, &(os_cmd_pool_opts_s){ .n_jobs = 4 }, _));
+
+        char* args[] = { test_app("sleep", _), "1", NULL };
+        f64 t = os.timer();
+        for (u32 i = 0; i < 4; i++) {
+            tassert_er(EOK, os.cmd.pool_add(&pool, args, arr$len(args)));
+        }
+        tassert_eq(pool.n_running, 4);
+        tassert_er(EOK, os.cmd.pool_join(&pool));
+        tassert(os.timer() - t < 2.5);
+
+        // running jobs are terminated
+        t = os.timer();
+        for (u32 i = 0; i < 2; i++) {
+            tassert_er(EOK, os.cmd.pool_add(&pool, args, arr$len(args)));
+        }
+        tassert_eq(pool.n_running, 2);
+        os.cmd.pool_destroy(&pool);
+        tassert(os.timer() - t < 0.9);
+    }
+    return EOK;
+}
+
+static Exception
+_test_cmd_on_data(os_cmd_c* cmd, bool is_stderr, str_s data, void* user_ctx)
+{
+    (void)cmd;
+    (void)is_stderr;
+    usize* total = user_ctx;
+    *total += data.len;
+    if (*total > 10000) { return "enough data"; }
+    return EOK;
+}
+
+test$case(os_cmd_communicate_many)
+{
+    mem$scope(tmem$, _)
+    {
+        os_cmd_c cmds[12] = { 0 };
+        os_cmd_io_s ios[12] = { 0 };
+        sbuf_c outs[12] = { 0 };
+        sbuf_c errs[12] = { 0 };
+        for (u32 i = 0; i < arr$len(cmds); i++) {
+            // stderr only output would deadlock on os.cmd.read_all() (stdout is not read)
+            char* args[] = { test_app("write_lines", _),
+                             (i % 2) ? "stderr" : "stdout",
+                             str.fmt(_, "%d", 10000 * (i + 1)),
+                             NULL };
+            tassert_er(EOK, os.cmd.create(&cmds[i], args, arr$len(args), NULL));
+            outs[i] = sbuf.create(1024, _);
+            errs[i] = sbuf.create(1024, _);
+            ios[i] = (os_cmd_io_s){ .cmd = &cmds[i], .out = &outs[i], .err = &errs[i] };
+        }
+
+        tassert_er(EOK, os.cmd.communicate(ios, arr$len(ios)));
+        for (u32 i = 0; i < arr$len(cmds); i++) {
+            tassert_er(EOK, ios[i].result);
+            tassert_eq(ios[i].ret_code, 0);
+            tassert(cmds[i]._subpr.stdout_file == NULL); // joined
+            sbuf_c output = (i % 2) ? errs[i] : outs[i];
+            sbuf_c empty = (i % 2) ? outs[i] : errs[i];
+            tassert_eq(sbuf.len(&empty), 0);
+            arr$(char*) lines = str.split_lines(output, _);
+            tassert_eq(arr$len(lines), 10000 * (i + 1));
+            tassert_eq(lines[arr$len(lines) - 1], str.fmt(_, "%09d", 10000 * (i + 1) - 1));
+        }
+    }
+    return EOK;
+}
+
+test$case(os_cmd_communicate_stdin)
+{
+    mem$scope(tmem$, _)
+    {
+        // stdin and stdout are both bigger than pipe buffer, requires non-blocking I/O
+        sbuf_c input = sbuf.create(1024, _);
+        for (u32 i = 0; i < 20000; i++) { tassert_er(EOK, sbuf.appendf(&input, "line %05d\n", i)); }
+        tassert_er(EOK, sbuf.append(&input, "end\n"));
+
+        os_cmd_c c = { 0 };
+        char* args[] = { test_app("echo_server", _), NULL };
+        tassert_er(EOK, os.cmd.create(&c, args, arr$len(args), NULL));
+        sbuf_c out = sbuf.create(1024, _);
+        os_cmd_io_s io = { .cmd = &c, .stdin_data = str.sstr(input), .out = &out };
+        tassert_er(EOK, os.cmd.communicate(&io, 1));
+        tassert_eq(io.ret_code, 0);
+
+        arr$(char*) lines = str.split_lines(out, _);
+        tassert_eq(arr$len(lines), 20000 + 2);
+        tassert_eq(lines[0], "welcome to echo server");
+        tassert_eq(lines[1], "out: line 00000");
+        tassert_eq(lines[20000], "out: line 19999");
+        tassert_eq(lines[20001], "exit: end");
+
+        // not all stdin is consumed by child
+        tassert_er(EOK, os.cmd.create(&c, args, arr$len(args), NULL));
+        sbuf.clear(&out);
+        io = (os_cmd_io_s){ .cmd = &c, .stdin_data = str$s("end\nline 1\n"), .out = &out };
+        tassert_er(EOK, os.cmd.communicate(&io, 1));
+        tassert_eq(out, "welcome to echo server\nexit: end\n");
+
+#ifndef _WIN32
+        // child exits before reading the whole stdin (EPIPE), SIGPIPE handler is not touched
+        struct sigaction sa_prev = { 0 };
+        sigaction(SIGPIPE, NULL, &sa_prev);
+        tassert(sa_prev.sa_handler == SIG_DFL);
+        tassert_er(EOK, os.cmd.create(&c, args, arr$len(args), NULL));
+        sbuf.clear(&out);
+        sbuf.clear(&input);
+        tassert_er(EOK, sbuf.append(&input, "end\n"));
+        for (u32 i = 0; i < 20000; i++) { tassert_er(EOK, sbuf.appendf(&input, "line %05d\n", i)); }
+        io = (os_cmd_io_s){ .cmd = &c, .stdin_data = str.sstr(input), .out = &out };
+        tassert_er(EOK, os.cmd.communicate(&io, 1));
+        tassert_eq(out, "welcome to echo server\nexit: end\n");
+        sigaction(SIGPIPE, NULL, &sa_prev);
+        tassert(sa_prev.sa_handler == SIG_DFL);
+        sigset_t mask;
+        pthread_sigmask(SIG_BLOCK, NULL, &mask);
+        tassert(!sigismember(&mask, SIGPIPE));
+#endif
+
+        // no stdin data -> child gets EOF
+        tassert_er(EOK, os.cmd.create(&c, args, arr$len(args), NULL));
+        io = (os_cmd_io_s){ .cmd = &c };
+        tassert_er(Error.runtime, os.cmd.communicate(&io, 1));
+        tassert_eq(io.ret_code, 1);
+    }
+    return EOK;
+}
+
+test$case(os_cmd_communicate_timeout_and_callback)
+{
+    mem$scope(tmem$, _)
+    {
+        os_cmd_c cmds[3] = { 0 };
+        char* args_sleep[] = { test_app("sleep", _), "10", NULL };
+        char* args_lines[] = { test_app("write_lines", _), "stdout", "100000", NULL };
+        char* args_combined[] = { test_app("write_lines", _), "stderr", "10", NULL };
+        tassert_er(EOK, os.cmd.create(&cmds[0], args_sleep, arr$len(args_sleep), NULL));
+        tassert_er(EOK, os.cmd.create(&cmds[1], args_lines, arr$len(args_lines), NULL));
+        os_cmd_flags_s flags = { .combine_stdouterr = true };
+        tassert_er(EOK, os.cmd.create(&cmds[2], args_combined, arr$len(args_combined), &flags));
+
+        usize total = 0;
+        sbuf_c out = sbuf.create(1024, _);
+        os_cmd_io_s ios[] = {
+            { .cmd = &cmds[0], .timeout_ms = 200 },
+            { .cmd = &cmds[1], .on_data = _test_cmd_on_data, .user_ctx = &total },
+            { .cmd = &cmds[2], .out = &out },
+        };
+        f64 t = os.timer();
+        tassert_er(Error.timeout, os.cmd.communicate(ios, arr$len(ios)));
+        tassert(os.timer() - t < 5);
+        tassert_er(Error.timeout, ios[0].result);
+        tassert_er("enough data", ios[1].result);
+        tassert(total > 10000);
+        tassert_er(EOK, ios[2].result);
+        tassert_eq(sbuf.len(&out), 100);
+
+        tassert_er(Error.argument, os.cmd.communicate(NULL, 0));
+        os_cmd_io_s io_bad = { .cmd = &cmds[0] }; // already joined
+        tassert_er(Error.argument, os.cmd.communicate(&io_bad, 1));
+    }
+    return EOK;
+}
+
 #else
 test$case(os_cmd_not_supported_by_platform)
 {
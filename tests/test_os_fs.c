@@ -83,6 +83,131 @@ test$case(test_os_dir_walk_print)
     return EOK;
 }
 
+typedef struct test_walk_ctx_s
+{
+    u32 n_files[64];
+    u32 n_dirs[64];
+    u64 total_size[64];
+} test_walk_ctx_s;
+
+static Exception
+test_walk_counter(char* path, os_fs_stat_s ftype, u32 thread_idx, void* user_ctx)
+{
+    test_walk_ctx_s* ctx = user_ctx;
+    uassert(thread_idx < 64);
+    uassert(ftype.is_valid);
+    if (ftype.is_file) {
+        ctx->n_files[thread_idx]++;
+        ctx->total_size[thread_idx] += ftype.size;
+    }
+    if (ftype.is_directory) { ctx->n_dirs[thread_idx]++; }
+    if (str.ends_with(path, "stop_here.txt")) { return Error.skip; }
+    return EOK;
+}
+
+static Exception
+test_walk_types(char* path, os_fs_stat_s ftype, u32 thread_idx, void* user_ctx)
+{
+    (void)thread_idx;
+    bool* with_stat = user_ctx;
+    os_fs_stat_s expected = os.fs.stat(path);
+    tassert(expected.is_valid);
+    tassert_eq(ftype.is_file, expected.is_file);
+    tassert_eq(ftype.is_directory, expected.is_directory);
+    tassert_eq(ftype.is_symlink, expected.is_symlink);
+    tassert_eq(ftype.is_other, expected.is_other);
+    if (*with_stat) { tassert_eq(ftype.size, expected.size); }
+    return EOK;
+}
+
+test$case(test_os_walk_parallel)
+{
+    mem$scope(tmem$, _)
+    {
+        // 3 levels tree: 4 * 4 dirs, each with 5 files
+        u32 n_dirs = 0;
+        u32 n_files = 0;
+        for (u32 i = 0; i < 4; i++) {
+            for (u32 j = 0; j < 4; j++) {
+                for (u32 k = 0; k < 5; k++) {
+                    char* f = str.fmt(_, "%s/d%d/d%d/f%d.txt", TBUILDDIR, i, j, k);
+                    tassert_er(EOK, os.fs.mkpath(f));
+                    tassert_er(EOK, io.file.save(f, "12345"));
+                    n_files++;
+                }
+                n_dirs++;
+            }
+            n_dirs++;
+        }
+
+        u32 threads[] = { 1, 2, 8, 0 };
+        for$each (n_threads, threads) {
+            test_walk_ctx_s ctx = { 0 };
+            os_fs_walk_opts_s opts = {
+                .n_threads = n_threads,
+                .is_recursive = true,
+                .with_stat = true,
+            };
+            tassert_er(EOK, os.fs.walk(TBUILDDIR, &opts, test_walk_counter, &ctx));
+            u32 total_files = 0;
+            u32 total_dirs = 0;
+            u64 total_size = 0;
+            for (u32 i = 0; i < 64; i++) {
+                if (n_threads > 0 && i >= n_threads) { tassert_eq(ctx.n_files[i], 0); }
+                total_files += ctx.n_files[i];
+                total_dirs += ctx.n_dirs[i];
+                total_size += ctx.total_size[i];
+            }
+            tassert_eq(total_files, n_files);
+            tassert_eq(total_dirs, n_dirs);
+            tassert_eq(total_size, n_files * 5);
+
+            // non recursive
+            memset(&ctx, 0, sizeof(ctx));
+            opts.is_recursive = false;
+            tassert_er(EOK, os.fs.walk(TBUILDDIR, &opts, test_walk_counter, &ctx));
+            tassert_eq(ctx.n_dirs[0], 4);
+            tassert_eq(ctx.n_files[0], 0);
+        }
+
+#ifndef _WIN32
+        // dangling symlinks don't stop the walk
+        tassert_eq(0, symlink("not_existing_target", TBUILDDIR "dangling_link"));
+        test_walk_ctx_s dctx = { 0 };
+        os_fs_walk_opts_s dopts = { .n_threads = 1 };
+        tassert_er(EOK, os.fs.walk(TBUILDDIR, &dopts, test_walk_counter, &dctx));
+        tassert_eq(dctx.n_dirs[0], 4);
+        tassert_eq(0, unlink(TBUILDDIR "dangling_link"));
+#endif
+
+        // callback errors stop walking
+        tassert_er(EOK, io.file.save(TBUILDDIR "d2/d1/stop_here.txt", "1"));
+        os_fs_walk_opts_s opts = { .n_threads = 4, .is_recursive = true };
+        test_walk_ctx_s ctx = { 0 };
+        tassert_er(Error.skip, os.fs.walk(TBUILDDIR, &opts, test_walk_counter, &ctx));
+        opts.n_threads = 1;
+        tassert_er(Error.skip, os.fs.walk(TBUILDDIR, &opts, test_walk_counter, &ctx));
+
+        tassert_er(Error.not_found, os.fs.walk(TBUILDDIR "not_exist", &opts, test_walk_counter, &ctx));
+        opts.n_threads = 4;
+        tassert_er(Error.not_found, os.fs.walk(TBUILDDIR "not_exist", &opts, test_walk_counter, &ctx));
+        tassert_er(
+            Error.argument,
+            os.fs.walk(TBUILDDIR "d2/d1/stop_here.txt", &opts, test_walk_counter, &ctx)
+        );
+
+        // d_type based types are the same as os.fs.stat() (including symlinks)
+        bool with_stat = true;
+        opts = (os_fs_walk_opts_s){ .n_threads = 1, .is_recursive = true, .with_stat = true };
+        tassert_er(EOK, os.fs.walk("tests/data/dir1", &opts, test_walk_types, &with_stat));
+        opts.n_threads = 3;
+        tassert_er(EOK, os.fs.walk("tests/data/dir1", &opts, test_walk_types, &with_stat));
+        with_stat = false;
+        tassert_er(EOK, os.fs.walk("tests/data/dir1", NULL, test_walk_types, &with_stat));
+    }
+    return EOK;
+}
+
 test$case(test_os_find)
 {
 
@@ -803,6 +928,86 @@ test$case(test_os_copy_tree_sanity_checks)
 }
 
 
+test$case(test_os_copy_tree_parallel)
+{
+    mem$scope(tmem$, _)
+    {
+        for (u32 i = 0; i < 6; i++) {
+            for (u32 k = 0; k < 4; k++) {
+                char* f = str.fmt(_, "%s/in/d%d/sub/f%d.txt", TBUILDDIR, i, k);
+                tassert_er(EOK, os.fs.mkpath(f));
+                tassert_er(EOK, io.file.save(f, str.fmt(_, "content %d/%d", i, k)));
+            }
+        }
+        tassert_er(EOK, os.fs.mkpath(TBUILDDIR "in/empty/"));
+
+        tassert_er(Error.ok, os.fs.copy_tree_parallel(TBUILDDIR "in", TBUILDDIR "out", 4));
+        tassert_er(Error.exists, os.fs.copy_tree_parallel(TBUILDDIR "in", TBUILDDIR "out", 4));
+        tassert_er(Error.argument, os.fs.copy_tree_parallel(TBUILDDIR "in/d1/sub/f1.txt", TBUILDDIR "o", 4));
+
+        tassert(os.path.exists(TBUILDDIR "out/empty/"));
+        for (u32 i = 0; i < 6; i++) {
+            for (u32 k = 0; k < 4; k++) {
+                char* f = str.fmt(_, "%s/out/d%d/sub/f%d.txt", TBUILDDIR, i, k);
+                tassert_eq(io.file.load(f, _), str.fmt(_, "content %d/%d", i, k));
+            }
+        }
+        tassert_eq(arr$len(os.fs.find(TBUILDDIR "out/*.txt", true, _)), 24);
+    }
+    return EOK;
+}
+
+#ifndef _WIN32
+test$case(test_os_copy_file_sparse_and_metadata)
+{
+    // sparse file: 1 page of data at 4MB, with total size 8MB
+    int fd = open(TBUILDDIR "sparse.bin", O_CREAT | O_WRONLY | O_TRUNC, 0640);
+    tassert(fd >= 0);
+    char data[4096];
+    memset(data, 'x', sizeof(data));
+    tassert_eq(pwrite(fd, data, sizeof(data), 4 * 1024 * 1024), sizeof(data));
+    tassert_eq(0, ftruncate(fd, 8 * 1024 * 1024));
+    close(fd);
+
+    struct timespec times[2] = { { .tv_sec = 1000000000 }, { .tv_sec = 1000000000 } };
+    tassert_eq(0, utimensat(AT_FDCWD, TBUILDDIR "sparse.bin", times, 0));
+    tassert_eq(0, chmod(TBUILDDIR "sparse.bin", 0751));
+
+    tassert_er(EOK, os.fs.copy(TBUILDDIR "sparse.bin", TBUILDDIR "sparse_copy.bin"));
+
+    struct stat src_st, dst_st;
+    tassert_eq(0, stat(TBUILDDIR "sparse.bin", &src_st));
+    tassert_eq(0, stat(TBUILDDIR "sparse_copy.bin", &dst_st));
+    tassert_eq(dst_st.st_size, 8 * 1024 * 1024);
+    tassert_eq(dst_st.st_mode & 07777, 0751);
+    tassert_eq(dst_st.st_mtime, 1000000000);
+    if (src_st.st_blocks * 512 < src_st.st_size) {
+        // filesystem supports holes, the copy must keep them
+        tassert_le(dst_st.st_blocks, src_st.st_blocks);
+    }
+
+    io_mmap_s src_data, dst_data;
+    tassert_er(EOK, io.file.mmap(TBUILDDIR "sparse.bin", &src_data, NULL));
+    tassert_er(EOK, io.file.mmap(TBUILDDIR "sparse_copy.bin", &dst_data, NULL));
+    tassert_eq(src_data.data.len, dst_data.data.len);
+    tassert(memcmp(src_data.data.buf, dst_data.data.buf, src_data.data.len) == 0);
+    tassert_eq(dst_data.data.buf[4 * 1024 * 1024], 'x');
+    tassert_eq(dst_data.data.buf[4 * 1024 * 1024 - 1], '\0');
+    io.file.munmap(&src_data);
+    io.file.munmap(&dst_data);
+
+    // fully sparse file (hole till the end)
+    fd = open(TBUILDDIR "hole.bin", O_CREAT | O_WRONLY | O_TRUNC, 0644);
+    tassert(fd >= 0);
+    tassert_eq(0, ftruncate(fd, 1024 * 1024));
+    close(fd);
+    tassert_er(EOK, os.fs.copy(TBUILDDIR "hole.bin", TBUILDDIR "hole_copy.bin"));
+    tassert_eq(0, stat(TBUILDDIR "hole_copy.bin", &dst_st));
+    tassert_eq(dst_st.st_size, 1024 * 1024);
+    return EOK;
+}
+#endif
+
 test$case(test_os_path_abs)
 {
     tassert_eq(os.path.abs(NULL, mem$), NULL);
@@ -521,4 +521,98 @@ test$case(test_sbuf_shrink_test)
     return EOK;
 }
 
+test$case(test_sbuf_rope)
+{
+    sbuf_rope_c r = sbuf.rope.create(0, mem$);
+    tassert_eq(r.chunk_size, CEX_SBUF_ROPE_CHUNK);
+    tassert(r.first == NULL);
+    tassert_eq(sbuf.rope.len(&r), 0);
+    tassert_er(EOK, sbuf.rope.validate(&r));
+    tassert_eq(sbuf.rope.flatten(&r), "");
+
+    tassert_er(EOK, sbuf.rope.append(&r, "hello"));
+    tassert_er(EOK, sbuf.rope.appendf(&r, " %s %d %S", "world", 42, str$s("slice")));
+    tassert_eq(sbuf.rope.len(&r), strlen("hello world 42 slice"));
+    tassert(r.first == r.last);
+    tassert_eq(sbuf.rope.flatten(&r), "hello world 42 slice");
+
+    sbuf.rope.clear(&r);
+    tassert_eq(sbuf.rope.len(&r), 0);
+    tassert_eq(sbuf.rope.flatten(&r), "");
+
+    tassert_er(Error.argument, sbuf.rope.append(&r, NULL));
+    tassert_er(Error.argument, sbuf.rope.validate(&r));
+    tassert_er(Error.argument, sbuf.rope.append(&r, "sticky"));
+    tassert_eq(sbuf.rope.len(&r), 0);
+    tassert(sbuf.rope.flatten(&r) == NULL);
+
+    sbuf.rope.destroy(&r);
+    tassert(r.first == NULL);
+    tassert(r.allocator == NULL);
+    return EOK;
+}
+
+test$case(test_sbuf_rope_chunks)
+{
+    mem$scope(tmem$, _)
+    {
+        // NOTE: chunk size is clamped to minimal CEX_SPRINTF_MIN*2
+        sbuf_rope_c r = sbuf.rope.create(10, _);
+        tassert_eq(r.chunk_size, CEX_SPRINTF_MIN * 2);
+
+        sbuf_c expected = sbuf.create(1024, _);
+        for (u32 i = 0; i < 1000; i++) {
+            tassert_er(EOK, sbuf.rope.appendf(&r, "%05d,", i));
+            tassert_er(EOK, sbuf.rope.append(&r, "abc;"));
+            tassert_er(EOK, sbuf.appendf(&expected, "%05d,abc;", i));
+        }
+        tassert_eq(sbuf.rope.len(&r), sbuf.len(&expected));
+        tassert(r.first != r.last);
+
+        // all chunks are filled completely (bytes are never moved, just split across chunks)
+        u64 total = 0;
+        for$iter (str_s, it, sbuf.rope.iter(&r, &it.iterator)) {
+            if (it.val.buf != r.last->data) { tassert_eq(it.val.len, r.chunk_size); }
+            tassert_eq(it.val.buf[it.val.len], '\0');
+            tassert(str.slice.eq(it.val, str.sub(expected, total, total + it.val.len)));
+            total += it.val.len;
+        }
+        tassert_eq(total, sbuf.rope.len(&r));
+
+        // long appendf spanning several chunks
+        char* long_str = str.fmt(_, "%0*d", 5000, 7);
+        tassert_er(EOK, sbuf.rope.appendf(&r, "%s", long_str));
+        tassert_er(EOK, sbuf.appendf(&expected, "%s", long_str));
+
+        char* first_chunk = r.first->data;
+        char* flat = sbuf.rope.flatten(&r);
+        tassert(flat != first_chunk);
+        tassert_eq(flat, expected);
+        tassert(r.first == r.last);
+        tassert(sbuf.rope.flatten(&r) == flat); // flattened only once
+
+        // appending after flatten doesn't move data
+        tassert_er(EOK, sbuf.rope.append(&r, "tail"));
+        tassert(r.first->data == flat);
+        tassert(r.first != r.last);
+        tassert_eq(sbuf.rope.len(&r), sbuf.len(&expected) + 4);
+
+        FILE* fh;
+        char* fname = "tests/build/test_sbuf_rope.txt";
+        tassert_er(EOK, io.fopen(&fh, fname, "w"));
+        tassert_er(EOK, sbuf.rope.fwrite(&r, fh));
+        io.fclose(&fh);
+
+        char* content = io.file.load(fname, _);
+        tassert(content != NULL);
+        tassert_eq(str.len(content), sbuf.rope.len(&r));
+        tassert(str.starts_with(content, expected));
+        tassert(str.ends_with(content, "tail"));
+        tassert_er(EOK, os.fs.remove(fname));
+
+        sbuf.rope.destroy(&r);
+    }
+    return EOK;
+}
+
 test$main();
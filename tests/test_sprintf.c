@@ -424,4 +424,114 @@ test$case(stb_sprintf_strings)
     return EOK;
 }
 
+#define CHECK_FMT(format, ...)                                                                     \
+    {                                                                                              \
+        char* _exp = str.fmt(_, format, ##__VA_ARGS__);                                            \
+        char* _act = str.fmt(_, fmt$(format), ##__VA_ARGS__);                                      \
+        tassert_eq(_act, _exp);                                                                    \
+        int _ret = cexsp__snprintf(buf, arr$len(buf), fmt$(format), ##__VA_ARGS__);                \
+        tassert_eq(buf, _exp);                                                                     \
+        tassert_eq(_ret, str.len(_exp));                                                           \
+    }
+
+test$case(fmt_precompiled_format)
+{
+    char buf[4096];
+    mem$scope(tmem$, _)
+    {
+        for (u32 i = 0; i < 3; i++) {
+            // first call compiles format, next calls use cached ops
+            CHECK_FMT("");
+            CHECK_FMT("no conversions");
+            CHECK_FMT("%d", -100006789);
+            CHECK_FMT("a %c %s     %d", 'a', "b", i);
+            CHECK_FMT("%-8.3s|%+2d|% 3i|%-4d|%+d", "abcdefgh", 5, 6, -7, 0);
+            CHECK_FMT("%10.5d:%10.5d %u %04u", 3, 4, 20u, 20u);
+            CHECK_FMT("%o %x %X %#o %#x %#X", 10u, 30u, 60u, 10u, 30u, 60u);
+            CHECK_FMT("%lld %llu %zu %ld %hhd %hd", -1ll, 2llu, (usize)3, 4l, 5, 6);
+            CHECK_FMT("%'d %$d %$$d %_$d %b", 12345678, 2536000, 2536000, 2536000, 256);
+            CHECK_FMT("%f %.2f %e %g %10.3f %-10.3f|", 3.14, 2.5, 1e10, 0.0001, 3.1415, -1.5);
+            CHECK_FMT("%*d|%-*d|%.*f|%*.*s|", 5, 1, 5, 2, 3, 1.23456, 6, 2, "abcdef");
+            CHECK_FMT("%S|%.3S|%10S|%-10S|", str$s("slice"), str$s("slice"), str$s("a"), str$s("b"));
+            CHECK_FMT("100%% %s %%", "done");
+            CHECK_FMT("%p", (void*)buf);
+            CHECK_FMT("trailing literal %d after", 1);
+        }
+
+        // literal runs longer than internal buffer are split across callback calls
+        char* long_str = str.fmt(_, fmt$("%0*d"), 2000, 7);
+        tassert_eq(str.len(long_str), 2000);
+        CHECK_FMT(
+            "0123456789012345678901234567890123456789012345678901234567890123456789012345678901234"
+            "0123456789012345678901234567890123456789012345678901234567890123456789012345678901234"
+            "0123456789012345678901234567890123456789012345678901234567890123456789012345678901234"
+            "0123456789012345678901234567890123456789012345678901234567890123456789012345678901234"
+            "0123456789012345678901234567890123456789012345678901234567890123456789012345678901234"
+            "0123456789012345678901234567890123456789012345678901234567890123456789012345678901234"
+            "0123456789012345678901234567890123456789012345678901234567890123456789012345678901234"
+            " %s %d end",
+            long_str,
+            3
+        );
+
+        // more conversions than CEX_SPRINTF_OPS falls back to the regular format
+        CHECK_FMT(
+            "%d %d %d %d %d %d %d %d %d %d %d %d %d %d %d",
+            1,
+            2,
+            3,
+            4,
+            5,
+            6,
+            7,
+            8,
+            9,
+            10,
+            11,
+            12,
+            13,
+            14,
+            15
+        );
+
+        sbuf_c sb = sbuf.create(10, _);
+        for (u32 i = 0; i < 100; i++) {
+            tassert_er(EOK, sbuf.appendf(&sb, fmt$("%d,%S;"), i, str$s("x")));
+        }
+        tassert(str.starts_with(sb, "0,x;1,x;2,x;"));
+        tassert(str.ends_with(sb, "98,x;99,x;"));
+    }
+
+    return EOK;
+}
+
+test$case(fmt_precompiled_cache)
+{
+    cexsp__fmt f = { 0 };
+    char* format = "foo %d bar %s";
+    char* r = cexsp__fmt_compile(&f, format);
+    tassert(r == (char*)&f);
+    tassert_eq(f.state, 2);
+    tassert_eq(f.n_ops, 3);
+    tassert(f.format == format);
+    tassert_eq(f.ops[0].lit_len, 4);
+    tassert_eq(f.ops[0].conv_off, 5);
+    tassert_eq(f.ops[1].lit_off, 6);
+    tassert_eq(f.ops[1].lit_len, 5);
+    tassert_eq(f.ops[2].conv_off, UINT16_MAX);
+    tassert_eq(f.ops[2].lit_len, 0);
+    tassert(cexsp__fmt_compile(&f, format) == r);
+    tassert_eq(str.len(r), 7); // magic is zero terminated, safe for strlen()
+
+    cexsp__fmt fb = { 0 };
+    char* format_bad = "%d %";
+    tassert(cexsp__fmt_compile(&fb, format_bad) == format_bad);
+    tassert_eq(fb.state, 3);
+    tassert(cexsp__fmt_compile(&fb, format_bad) == format_bad);
+
+    // log$ formats are pre-compiled by default
+    for (u32 i = 0; i < 3; i++) { log$info("pre-compiled log format: %d %S\n", i, str$s("ok")); }
+    return EOK;
+}
+
 test$main();
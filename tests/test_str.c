@@ -2712,6 +2712,136 @@ test$case(test_str_convert_macro_f64)
     return EOK;
 }
 
+test$case(test_str_parse_many_i64)
+{
+    i64 buf[8] = { 0 };
+    usize n = 0;
+    usize consumed = 0;
+
+    str_s s = str$s("1,-2, 3 ,+4,0x1F,9223372036854775807\n-9223372036854775807,7");
+    tassert_er(EOK, str.convert.parse_many_i64(s, ',', buf, arr$len(buf), &n, &consumed));
+    tassert_eq(n, 8);
+    tassert_eq(consumed, s.len);
+    tassert_eq(buf[0], 1);
+    tassert_eq(buf[1], -2);
+    tassert_eq(buf[2], 3);
+    tassert_eq(buf[3], 4);
+    tassert_eq(buf[4], 31);
+    tassert_eq(buf[5], INT64_MAX);
+    tassert_eq(buf[6], -INT64_MAX);
+    tassert_eq(buf[7], 7);
+
+    // Must match single value conversion
+    for$iter (str_s, it, str.slice.iter_split(s, ",\n", &it.iterator)) {
+        i64 v = 0;
+        tassert_er(EOK, str.convert.to_i64s(it.val, &v));
+        tassert_eq(v, buf[it.idx.i]);
+    }
+
+    // Trailing separator / CRLF rows
+    s = str$s("10\t20\r\n30\t40\r\n");
+    tassert_er(EOK, str.convert.parse_many_i64(s, '\t', buf, arr$len(buf), &n, &consumed));
+    tassert_eq(n, 4);
+    tassert_eq(consumed, s.len);
+    tassert_eq(buf[0], 10);
+    tassert_eq(buf[3], 40);
+
+    // Capacity limited, resuming from consumed
+    s = str$s("1,2,3,4,5");
+    tassert_er(EOK, str.convert.parse_many_i64(s, ',', buf, 2, &n, &consumed));
+    tassert_eq(n, 2);
+    tassert_eq(consumed, 4);
+    s = str.slice.sub(s, consumed, 0);
+    tassert_er(EOK, str.convert.parse_many_i64(s, ',', buf, arr$len(buf), &n, &consumed));
+    tassert_eq(n, 3);
+    tassert_eq(buf[0], 3);
+    tassert_eq(buf[2], 5);
+
+    // Error reports offset of the bad token
+    s = str$s("1,2,x3,4");
+    tassert_er(Error.argument, str.convert.parse_many_i64(s, ',', buf, arr$len(buf), &n, &consumed));
+    tassert_eq(n, 2);
+    tassert_eq(consumed, 4);
+
+    s = str$s("1,,3");
+    tassert_er(Error.argument, str.convert.parse_many_i64(s, ',', buf, arr$len(buf), &n, &consumed));
+    tassert_eq(n, 1);
+    tassert_eq(consumed, 2);
+
+    s = str$s("1,99999999999999999999");
+    tassert_er(Error.overflow, str.convert.parse_many_i64(s, ',', buf, arr$len(buf), &n, &consumed));
+    tassert_eq(n, 1);
+    tassert_eq(consumed, 2);
+
+    s = str$s("12 3");
+    tassert_er(Error.argument, str.convert.parse_many_i64(s, ',', buf, arr$len(buf), &n, &consumed));
+    tassert_eq(n, 0);
+    tassert_eq(consumed, 0);
+
+    // Empty / NULL
+    tassert_er(EOK, str.convert.parse_many_i64(str$s(""), ',', buf, arr$len(buf), &n, &consumed));
+    tassert_eq(n, 0);
+    tassert_eq(consumed, 0);
+    tassert_er(
+        Error.argument,
+        str.convert.parse_many_i64((str_s){ 0 }, ',', buf, arr$len(buf), &n, &consumed)
+    );
+    return EOK;
+}
+
+test$case(test_str_parse_many_f64)
+{
+    f64 buf[16] = { 0 };
+    usize n = 0;
+    usize consumed = 0;
+
+    str_s s = str$s("1.5;-2.25; 0.1 ;1e10;-3.5E-3;.5;2.;nan;-inf;12345678901234567890.5\n7");
+    tassert_er(EOK, str.convert.parse_many_f64(s, ';', buf, arr$len(buf), &n, &consumed));
+    tassert_eq(n, 11);
+    tassert_eq(consumed, s.len);
+    tassert_eq(buf[0], 1.5);
+    tassert_eq(buf[1], -2.25);
+    tassert_eq(buf[2], 0.1);
+    tassert_eq(buf[3], 1e10);
+    tassert_eq(buf[4], -3.5e-3);
+    tassert_eq(buf[5], 0.5);
+    tassert_eq(buf[6], 2.0);
+    tassert(isnan(buf[7]));
+    tassert_eq(buf[8], -INFINITY);
+    tassert_eq_almost(buf[9], 12345678901234567890.5, 1e5);
+    tassert_eq(buf[10], 7.0);
+
+    // Must match single value conversion
+    for$iter (str_s, it, str.slice.iter_split(s, ";\n", &it.iterator)) {
+        if (it.idx.i == 7) { continue; } // nan != nan
+        f64 v = 0;
+        tassert_er(EOK, str.convert.to_f64s(it.val, &v));
+        tassert_eq_almost(v, buf[it.idx.i], 1e-9);
+    }
+
+    // Generic macro
+    s = str$s("1,2,3");
+    tassert_er(EOK, str$parse_many(s, ',', buf, arr$len(buf), &n, &consumed));
+    tassert_eq(n, 3);
+    tassert_eq(buf[2], 3.0);
+    i64 ibuf[4];
+    tassert_er(EOK, str$parse_many(s, ',', ibuf, arr$len(ibuf), &n, &consumed));
+    tassert_eq(n, 3);
+    tassert_eq(ibuf[2], 3);
+
+    s = str$s("1.0,2.0e,3");
+    tassert_er(Error.argument, str.convert.parse_many_f64(s, ',', buf, arr$len(buf), &n, &consumed));
+    tassert_eq(n, 1);
+    tassert_eq(consumed, 4);
+
+    s = str$s("1.0,1e309");
+    tassert_er(Error.overflow, str.convert.parse_many_f64(s, ',', buf, arr$len(buf), &n, &consumed));
+    tassert_eq(n, 1);
+    tassert_eq(consumed, 4);
+
+    return EOK;
+}
+
 test$case(test_str_sub_slice)
 {
     char buf[] = { 1, 2, 3, 4 };
@@ -3205,4 +3335,202 @@ test$case(test_str_sub_slice)
     return EOK;
 }
 
+test$case(test_str_split_into)
+{
+    mem$scope(tmem$, _)
+    {
+        char* cases[] = { "123,456,789", ",", "a,,b,", "", "no-sep", ",a", "a;b,c;" };
+        for$each (c, cases) {
+            str_s src = str.sstr(c);
+            arr$(str_s) tokens = arr$new(tokens, _);
+            tassert_er(EOK, str.slice.split_into(src, ",;", &tokens));
+
+            arr$(str_s) expected = arr$new(expected, _);
+            for$iter (str_s, it, str.slice.iter_split(src, ",;", &it.iterator)) {
+                arr$push(expected, it.val);
+            }
+            tassert_eq(arr$len(tokens), arr$len(expected));
+            for$each (t, tokens) {
+                tassert(t.buf >= src.buf && t.buf + t.len <= src.buf + src.len); // zero-copy
+            }
+            for (usize i = 0; i < arr$len(tokens); i++) {
+                tassert(str.slice.eq(tokens[i], expected[i]));
+            }
+
+            // packed and regular splits produce the same tokens
+            arr$(char*) res = str.split(c, ",;", _);
+            arr$(char*) packed = str.split_packed(c, ",;", _);
+            tassert_eq(arr$len(res), arr$len(tokens));
+            tassert_eq(arr$len(packed), arr$len(tokens));
+            for (usize i = 0; i < arr$len(tokens); i++) {
+                tassert(str.slice.eq(tokens[i], str.sstr(res[i])));
+                tassert(str.slice.eq(tokens[i], str.sstr(packed[i])));
+                if (i > 0) { tassert(packed[i] == packed[i - 1] + str.len(packed[i - 1]) + 1); }
+            }
+        }
+
+        arr$(str_s) tokens = arr$new(tokens, _);
+        tassert_er(EOK, str.slice.split_into(str$s("a,b"), ",", &tokens));
+        tassert_er(EOK, str.slice.split_into(str$s("c"), ",", &tokens)); // appends
+        tassert_eq(arr$len(tokens), 3);
+        tassert_eq(tokens[2], str$s("c"));
+
+        tassert_er(Error.argument, str.slice.split_into((str_s){ 0 }, ",", &tokens));
+        tassert_er(Error.argument, str.slice.split_into(str$s("a"), NULL, &tokens));
+        tassert_er(Error.argument, str.slice.split_into(str$s("a"), "", &tokens));
+        tassert_er(Error.argument, str.slice.split_into(str$s("a"), ",", NULL));
+        tassert(str.split_packed(NULL, ",", _) == NULL);
+        tassert(str.split_packed("a", NULL, _) == NULL);
+    }
+
+    // heap allocated packed split is released by 2 frees
+    arr$(char*) packed = str.split_packed("foo bar baz", " ", mem$);
+    tassert_eq(arr$len(packed), 3);
+    tassert_eq(packed[2], "baz");
+    mem$free(mem$, packed[0]);
+    arr$free(packed);
+
+    return EOK;
+}
+
+test$case(test_str_join_many)
+{
+    mem$scope(tmem$, _)
+    {
+        arr$(char*) parts = arr$new(parts, _);
+        sbuf_c expected = sbuf.create(1024, _);
+        for (u32 i = 0; i < 10000; i++) {
+            char* p = str.fmt(_, "path/to/file_%d.c", i);
+            arr$push(parts, p);
+            if (i > 0) { tassert_er(EOK, sbuf.append(&expected, " ")); }
+            tassert_er(EOK, sbuf.append(&expected, p));
+        }
+        char* joined = str.join(parts, arr$len(parts), " ", _);
+        tassert_eq(joined, expected);
+
+        // empty items keep separators
+        tassert_eq(str$join(_, ",", "", "a", "", "b", ""), ",a,,b,");
+        tassert(str.join(parts, 0, ",", _) == NULL);
+        parts[5] = NULL;
+        tassert(str.join(parts, arr$len(parts), ",", _) == NULL);
+
+        tassert_eq(str.replace("aXbXXc", "X", "--", _), "a--b----c");
+        tassert_eq(str.replace("aXXbXXXXc", "XX", "", _), "abc");
+        tassert_eq(str.replace("nothing", "X", "--", _), "nothing");
+    }
+    return EOK;
+}
+
+test$case(test_str_utf8_validate)
+{
+    tassert_er(EOK, str.utf8.validate(str$s("")));
+    tassert_er(EOK, str.utf8.validate(str$s("plain ascii text which is longer than 16 bytes")));
+    tassert_er(EOK, str.utf8.validate(str$s("Привет, мир! Γειά σου κόσμε! 你好 😀")));
+    tassert_er(EOK, str.utf8.validate(str$s("\xF4\x8F\xBF\xBF"))); // U+10FFFF
+    tassert_er(Error.argument, str.utf8.validate((str_s){ 0 }));
+
+    char* bad[] = {
+        "\x80",                // lone continuation
+        "\xC0\xAF",            // overlong '/'
+        "\xC1\xBF",            // overlong
+        "\xE0\x80\xAF",        // overlong 3 byte
+        "\xF0\x80\x80\xAF",    // overlong 4 byte
+        "\xED\xA0\x80",        // surrogate U+D800
+        "\xF4\x90\x80\x80",    // > U+10FFFF
+        "\xF5\x80\x80\x80",    // invalid lead
+        "\xD0",                // truncated
+        "\xE2\x82",            // truncated
+        "\xE2\x28\xA1",        // bad continuation
+        "\xFF",                // invalid byte
+    };
+    for$each (b, bad) {
+        tassert_er(Error.integrity, str.utf8.validate(str.sstr(b)));
+        char* padded = str.fmt(mem$, "0123456789abcdefghijklmnopq%sxyz", b);
+        tassert_er(Error.integrity, str.utf8.validate(str.sstr(padded)));
+        tassert_eq(str.utf8.len(str.sstr(padded)), -1);
+        mem$free(mem$, padded);
+    }
+
+    tassert_eq(str.utf8.len(str$s("")), 0);
+    tassert_eq(str.utf8.len(str$s("abc")), 3);
+    tassert_eq(str.utf8.len(str$s("Привет, мир! 😀 and some more ascii")), 34);
+    tassert_eq(str.utf8.len((str_s){ 0 }), -1);
+    return EOK;
+}
+
+test$case(test_str_utf8_iter)
+{
+    str_s s = str$s("aП€😀\xFF!");
+    u32 expected[] = { 'a', 0x41F, 0x20AC, 0x1F600, 0xFFFD, '!' };
+    usize offsets[] = { 0, 1, 3, 6, 10, 11 };
+    u32 n = 0;
+    for$iter (u32, it, str.utf8.iter(s, &it.iterator)) {
+        tassert(n < arr$len(expected));
+        tassert_eq(it.val, expected[n]);
+        tassert_eq(it.idx.i, offsets[n]);
+        n++;
+    }
+    tassert_eq(n, arr$len(expected));
+
+    n = 0;
+    for$iter (u32, it, str.utf8.iter(str$s(""), &it.iterator)) { n++; }
+    for$iter (u32, it, str.utf8.iter((str_s){ 0 }, &it.iterator)) { n++; }
+    tassert_eq(n, 0);
+    return EOK;
+}
+
+test$case(test_str_utf8_case)
+{
+    mem$scope(tmem$, _)
+    {
+        str_s s = str$s("Hello WORLD, long ASCII prefix! ПРИВЕТ Мир, ΓΕΙΆ ΣΟΥ, ÀÉÎÕÜ ŁÓDŹ Ÿ ß 😀\xFF");
+        char* lower = str.utf8.lower(s, _);
+        tassert_eq(lower, "hello world, long ascii prefix! привет мир, γειά σου, àéîõü łódź ÿ ß 😀\xFF");
+        char* upper = str.utf8.upper(s, _);
+        tassert_eq(upper, "HELLO WORLD, LONG ASCII PREFIX! ПРИВЕТ МИР, ΓΕΙΆ ΣΟΥ, ÀÉÎÕÜ ŁÓDŹ Ÿ ß 😀\xFF");
+        tassert_eq(str.utf8.upper(str$s("ёлка ς άλφα"), _), "ЁЛКА Σ ΆΛΦΑ");
+        tassert_eq(str.utf8.lower(str$s(""), _), "");
+        tassert(str.utf8.lower((str_s){ 0 }, _) == NULL);
+
+        // ASCII fast path matches the scalar str.lower()
+        char* ascii = "The Quick Brown Fox Jumps Over The Lazy Dog @[`{ 0123456789";
+        tassert_eq(str.utf8.lower(str.sstr(ascii), _), str.lower(ascii, _));
+        tassert_eq(str.utf8.upper(str.sstr(ascii), _), str.upper(ascii, _));
+
+        tassert_eq(str.utf8.cmpi(str$s("Привет Мир"), str$s("пРИВЕТ мИР")), 0);
+        tassert_eq(str.utf8.cmpi(str$s("ASCII PREFIX 12345 Ёж"), str$s("ascii prefix 12345 ёЖ")), 0);
+        tassert(str.utf8.cmpi(str$s("abc"), str$s("ABD")) < 0);
+        tassert(str.utf8.cmpi(str$s("абв"), str$s("АБ")) > 0);
+        tassert(str.utf8.cmpi(str$s("ab"), str$s("abc")) < 0);
+        tassert(str.utf8.cmpi(str$s("a\xFF"), str$s("a😀")) > 0);
+        tassert_eq(str.utf8.cmpi(str$s(""), str$s("")), 0);
+        tassert(str.utf8.cmpi((str_s){ 0 }, str$s("")) < 0);
+    }
+    return EOK;
+}
+
+test$case(test_str_utf8_to_utf16)
+{
+    u16 buf[16];
+    usize len = 0;
+    tassert_er(EOK, str.utf8.to_utf16(str$s("aП€😀"), NULL, 0, &len));
+    tassert_eq(len, 5);
+    tassert_er(EOK, str.utf8.to_utf16(str$s("aП€😀"), buf, arr$len(buf), &len));
+    tassert_eq(len, 5);
+    u16 expected[] = { 'a', 0x41F, 0x20AC, 0xD83D, 0xDE00, 0 };
+    for (u32 i = 0; i < arr$len(expected); i++) { tassert_eq(buf[i], expected[i]); }
+
+    tassert_er(Error.overflow, str.utf8.to_utf16(str$s("aП€😀"), buf, 5, &len));
+    tassert_eq(buf[0], 0);
+    tassert_er(EOK, str.utf8.to_utf16(str$s("aП€😀"), buf, 6, &len));
+    tassert_er(Error.integrity, str.utf8.to_utf16(str$s("a\xC0\xAF"), buf, arr$len(buf), &len));
+    tassert_eq(len, 0);
+    tassert_er(EOK, str.utf8.to_utf16(str$s(""), buf, arr$len(buf), &len));
+    tassert_eq(len, 0);
+    tassert_eq(buf[0], 0);
+    tassert_er(Error.argument, str.utf8.to_utf16((str_s){ 0 }, buf, arr$len(buf), &len));
+    tassert_er(Error.argument, str.utf8.to_utf16(str$s("a"), buf, 0, &len));
+    return EOK;
+}
+
 test$main();
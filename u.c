@@ -0,0 +1,6 @@
+#define CEX_IMPLEMENTATION
+#include "/root/repo/cex.h"
+#ifndef _CEX_IO_HAS_URING
+#error no uring
+#endif
+int main(void){return 0;}